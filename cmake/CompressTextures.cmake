@@ -0,0 +1,50 @@
+# Offline GPU texture compression
+#
+# Adds a `compress_textures` target that writes a BC7 .ktx2 for each listed image into the build
+# tree's textures/, the copy src/CMakeLists.txt makes next to the executable; the source tree is never
+# written. Texture::loadFromFile and TextureUploadQueue pick up the .ktx2 sibling whenever the driver
+# can sample its format and fall back to the original image otherwise, so the target is optional.
+#
+# Requires KTX-Software (toktx and ktx) on PATH. Images are first encoded to UASTC with a full mip
+# chain, then transcoded to raw BC7 blocks because the runtime loader does not carry a Basis transcoder.
+# --lower_left_maps_to_s0t0 stores rows bottom-up to match stbi_set_flip_vertically_on_load.
+# --assign_oetf linear keeps the BC7_UNORM format: toktx otherwise tags PNGs as sRGB, the loader would
+# pick an sRGB internal format, and the texels would no longer match the linear GL_RGBA upload of the image.
+
+find_program(TOKTX_EXECUTABLE toktx)
+find_program(KTX_EXECUTABLE ktx)
+
+set(BREAKING_WALLS_COMPRESSED_TEXTURES
+    Explosion.png
+    brick_brown.png
+    spritesheet-characters-default.png
+    title.png
+)
+
+if (TOKTX_EXECUTABLE AND KTX_EXECUTABLE)
+    set(_compressed_outputs "")
+    foreach(_image IN LISTS BREAKING_WALLS_COMPRESSED_TEXTURES)
+        get_filename_component(_name "${_image}" NAME_WE)
+        set(_source "${CMAKE_SOURCE_DIR}/textures/${_image}")
+        set(_uastc "${CMAKE_BINARY_DIR}/ktx2/${_name}.uastc.ktx2")
+        set(_output "${CMAKE_BINARY_DIR}/bin/textures/${_name}.ktx2")
+
+        add_custom_command(
+            OUTPUT "${_output}"
+            COMMAND "${CMAKE_COMMAND}" -E make_directory "${CMAKE_BINARY_DIR}/ktx2" "${CMAKE_BINARY_DIR}/bin/textures"
+            COMMAND "${TOKTX_EXECUTABLE}" --t2 --encode uastc --genmipmap --lower_left_maps_to_s0t0
+                    --assign_oetf linear "${_uastc}" "${_source}"
+            COMMAND "${KTX_EXECUTABLE}" transcode --target bc7 "${_uastc}" "${_output}"
+            DEPENDS "${_source}"
+            COMMENT "Compressing textures/${_image} to BC7"
+            VERBATIM
+        )
+        list(APPEND _compressed_outputs "${_output}")
+    endforeach()
+
+    add_custom_target(compress_textures DEPENDS ${_compressed_outputs})
+else()
+    add_custom_target(compress_textures
+        COMMAND "${CMAKE_COMMAND}" -E echo "compress_textures: toktx and ktx (KTX-Software) were not found on PATH"
+    )
+endif()
@@ -1,9 +1,11 @@
 #version 430 core
 
+#include "frame_uniforms.glsl"
+
 in vec2 TexCoord;
+flat in vec4 Tint;
 
 uniform sampler2D SpriteTex;
-uniform vec4 TintColor;
 uniform int UseRedAsAlpha;
 uniform int uOITPass;
 uniform float uOITWeightScale;
@@ -17,8 +19,8 @@ void main()
 
     float coverage = (UseRedAsAlpha != 0) ? texColor.r : texColor.a;
     vec3 baseRgb = (UseRedAsAlpha != 0) ? vec3(1.0) : texColor.rgb;
-    vec3 rgb = baseRgb * TintColor.rgb;
-    float alpha = coverage * TintColor.a;
+    vec3 rgb = baseRgb * Tint.rgb;
+    float alpha = coverage * Tint.a;
 
     // Alpha testing - discard transparent pixels
     if (alpha < 0.1)
@@ -1,34 +1,39 @@
 #version 430 core
 
+#include "frame_uniforms.glsl"
+
 layout(points) in;
 layout(triangle_strip, max_vertices = 8) out;
 
-uniform float Size2;           // Half the width/height of the quad
-uniform vec2 SizeXY;           // Optional non-square half-size override (x, y)
-uniform mat4 ProjectionMatrix;
-uniform mat4 ViewMatrix;
+in VS_OUT
+{
+    vec2 halfSize;
+    vec4 texRect;
+    vec4 tint;
+} gs_in[];
+
 uniform int UseWorldAxes;
 uniform vec3 RightAxisWS;
 uniform vec3 UpAxisWS;
 uniform int DoubleSided;
-uniform vec4 TexRect;          // UV rect: uMin, vMin, uMax, vMax in UV space
 uniform int FlipX;
 uniform int FlipY;
 
 out vec2 TexCoord;
+flat out vec4 Tint;
 
 void main()
 {
     // gl_in[0].gl_Position is in view space (from vertex shader)
     vec4 viewPos = gl_in[0].gl_Position;
 
-    float sizeX = (SizeXY.x > 0.0) ? SizeXY.x : Size2;
-    float sizeY = (SizeXY.y > 0.0) ? SizeXY.y : Size2;
+    float sizeX = gs_in[0].halfSize.x;
+    float sizeY = gs_in[0].halfSize.y;
 
-    float uMin = TexRect.x;
-    float vMin = TexRect.y;
-    float uMax = TexRect.z;
-    float vMax = TexRect.w;
+    float uMin = gs_in[0].texRect.x;
+    float vMin = gs_in[0].texRect.y;
+    float uMax = gs_in[0].texRect.z;
+    float vMax = gs_in[0].texRect.w;
 
     float uLeft = (FlipX != 0) ? uMax : uMin;
     float uRight = (FlipX != 0) ? uMin : uMax;
@@ -40,8 +45,8 @@ void main()
     vec3 upVS = vec3(0.0, 1.0, 0.0);
     if (UseWorldAxes != 0)
     {
-        rightVS = normalize(mat3(ViewMatrix) * RightAxisWS);
-        upVS = normalize(mat3(ViewMatrix) * UpAxisWS);
+        rightVS = normalize(mat3(uView) * RightAxisWS);
+        upVS = normalize(mat3(uView) * UpAxisWS);
     }
 
     vec3 pBL = rightVS * (-sizeX) + upVS * (-sizeY);
@@ -50,19 +55,23 @@ void main()
     vec3 pTR = rightVS * ( sizeX) + upVS * ( sizeY);
 
     // Front face
-    gl_Position = ProjectionMatrix * (viewPos + vec4(pBL, 0.0));
+    gl_Position = uProjection * (viewPos + vec4(pBL, 0.0));
+    Tint = gs_in[0].tint;
     TexCoord = vec2(uLeft, vBottom);
     EmitVertex();
 
-    gl_Position = ProjectionMatrix * (viewPos + vec4(pBR, 0.0));
+    gl_Position = uProjection * (viewPos + vec4(pBR, 0.0));
+    Tint = gs_in[0].tint;
     TexCoord = vec2(uRight, vBottom);
     EmitVertex();
 
-    gl_Position = ProjectionMatrix * (viewPos + vec4(pTL, 0.0));
+    gl_Position = uProjection * (viewPos + vec4(pTL, 0.0));
+    Tint = gs_in[0].tint;
     TexCoord = vec2(uLeft, vTop);
     EmitVertex();
 
-    gl_Position = ProjectionMatrix * (viewPos + vec4(pTR, 0.0));
+    gl_Position = uProjection * (viewPos + vec4(pTR, 0.0));
+    Tint = gs_in[0].tint;
     TexCoord = vec2(uRight, vTop);
     EmitVertex();
 
@@ -71,19 +80,23 @@ void main()
     if (DoubleSided != 0)
     {
         // Back face with reversed winding
-        gl_Position = ProjectionMatrix * (viewPos + vec4(pBL, 0.0));
+        gl_Position = uProjection * (viewPos + vec4(pBL, 0.0));
+        Tint = gs_in[0].tint;
         TexCoord = vec2(uLeft, vBottom);
         EmitVertex();
 
-        gl_Position = ProjectionMatrix * (viewPos + vec4(pTL, 0.0));
+        gl_Position = uProjection * (viewPos + vec4(pTL, 0.0));
+        Tint = gs_in[0].tint;
         TexCoord = vec2(uLeft, vTop);
         EmitVertex();
 
-        gl_Position = ProjectionMatrix * (viewPos + vec4(pBR, 0.0));
+        gl_Position = uProjection * (viewPos + vec4(pBR, 0.0));
+        Tint = gs_in[0].tint;
         TexCoord = vec2(uRight, vBottom);
         EmitVertex();
 
-        gl_Position = ProjectionMatrix * (viewPos + vec4(pTR, 0.0));
+        gl_Position = uProjection * (viewPos + vec4(pTR, 0.0));
+        Tint = gs_in[0].tint;
         TexCoord = vec2(uRight, vTop);
         EmitVertex();
 
@@ -1,12 +1,48 @@
 #version 430 core
 
+#include "frame_uniforms.glsl"
+
 layout(location = 0) in vec3 aPos;
 
+// Per-instance attributes, only read when uInstanced != 0 (see BillboardBatch)
+layout(location = 1) in vec3 aInstanceCenter;
+layout(location = 2) in vec2 aInstanceHalfSize;
+layout(location = 3) in vec4 aInstanceTexRect;
+layout(location = 4) in vec4 aInstanceTint;
+
+uniform int uInstanced;
+
+// Single-sprite path
 uniform mat4 ModelViewMatrix;
+uniform float Size2;           // Half the width/height of the quad
+uniform vec2 SizeXY;           // Optional non-square half-size override (x, y)
+uniform vec4 TexRect;          // UV rect: uMin, vMin, uMax, vMax in UV space
+uniform vec4 TintColor;
+
+out VS_OUT
+{
+    vec2 halfSize;
+    vec4 texRect;
+    vec4 tint;
+} vs_out;
 
 void main()
 {
     // Output view-space position; the geometry shader expands this point to a
     // quad and applies the projection matrix itself.
-    gl_Position = ModelViewMatrix * vec4(aPos, 1.0);
+    if (uInstanced != 0)
+    {
+        gl_Position = uView * vec4(aInstanceCenter + aPos, 1.0);
+        vs_out.halfSize = aInstanceHalfSize;
+        vs_out.texRect = aInstanceTexRect;
+        vs_out.tint = aInstanceTint;
+    }
+    else
+    {
+        gl_Position = ModelViewMatrix * vec4(aPos, 1.0);
+        vs_out.halfSize = vec2((SizeXY.x > 0.0) ? SizeXY.x : Size2,
+                               (SizeXY.y > 0.0) ? SizeXY.y : Size2);
+        vs_out.texRect = TexRect;
+        vs_out.tint = TintColor;
+    }
 }
@@ -0,0 +1,12 @@
+// Per-frame camera/scene data, written once per frame into a std140 uniform buffer.
+// Must match GLSDLHelper::FrameUniforms and GLSDLHelper::FRAME_UNIFORMS_BINDING.
+layout (std140, binding = 0) uniform FrameUniforms
+{
+    mat4 uView;
+    mat4 uProjection;
+    mat4 uViewProjection;
+    vec3 uCameraPos;
+    float uTime;
+    vec2 uViewportSize;
+    vec2 uInvViewportSize;
+};
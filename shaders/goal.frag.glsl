@@ -1,8 +1,9 @@
 #version 430 core
 
+#include "frame_uniforms.glsl"
+
 uniform vec3 uColor;
 uniform float uIntensity;
-uniform float uTime;
 
 layout(location = 0) out vec4 FragColor;
 
@@ -1,10 +1,10 @@
 #version 430 core
 
-layout(location = 0) in vec3 aPosition;
+#include "frame_uniforms.glsl"
 
-uniform mat4 uMVP;
+layout(location = 0) in vec3 aPosition;
 
 void main()
 {
-    gl_Position = uMVP * vec4(aPosition, 1.0);
+    gl_Position = uViewProjection * vec4(aPosition, 1.0);
 }
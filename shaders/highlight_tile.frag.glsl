@@ -1,10 +1,11 @@
 #version 430 core
 
+#include "frame_uniforms.glsl"
+
 in vec2 vLocal;
 
 uniform vec3 uCellColor;
 uniform float uHighlightStrength;
-uniform float uTime;
 
 layout(location = 0) out vec4 FragColor;
 
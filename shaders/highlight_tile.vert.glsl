@@ -1,6 +1,7 @@
 #version 430 core
 
-uniform mat4 uMVP;
+#include "frame_uniforms.glsl"
+
 uniform vec3 uTileCenter;
 uniform vec2 uTileHalfSize;
 
@@ -21,6 +22,6 @@ void main()
     vec3 worldPos = vec3(uTileCenter.x + local.x * uTileHalfSize.x,
                          uTileCenter.y,
                          uTileCenter.z + local.y * uTileHalfSize.y);
-    gl_Position = uMVP * vec4(worldPos, 1.0);
+    gl_Position = uViewProjection * vec4(worldPos, 1.0);
     vLocal = local;
 }
@@ -0,0 +1,63 @@
+#version 430
+
+// Builds the hierarchical-Z pyramid for OcclusionCuller: every texel holds the farthest depth
+// of the texels it covers one level down, so a box nearer than that texel is never hidden by it
+layout (local_size_x = 8, local_size_y = 8) in;
+
+// Passes of one OcclusionCuller::buildPyramid, in order
+const uint STAGE_COPY = 0u;
+const uint STAGE_REDUCE = 1u;
+
+uniform uint uStage = 0u;
+
+// STAGE_COPY: the depth pre-pass target
+layout (binding = 0) uniform sampler2D uDepth;
+
+// STAGE_REDUCE: level n - 1 in, level n out; STAGE_COPY writes level 0 through uDst
+layout (binding = 0, r32f) uniform readonly image2D uSrc;
+layout (binding = 1, r32f) uniform writeonly image2D uDst;
+
+void main()
+{
+    ivec2 dst = ivec2(gl_GlobalInvocationID.xy);
+    ivec2 dstSize = imageSize(uDst);
+    if (dst.x >= dstSize.x || dst.y >= dstSize.y)
+    {
+        return;
+    }
+
+    if (uStage == STAGE_COPY)
+    {
+        imageStore(uDst, dst, vec4(texelFetch(uDepth, dst, 0).r));
+        return;
+    }
+
+    ivec2 srcSize = imageSize(uSrc);
+    ivec2 base = dst * 2;
+    ivec2 last = srcSize - 1;
+
+    float depth = max(max(imageLoad(uSrc, min(base, last)).r,
+                          imageLoad(uSrc, min(base + ivec2(1, 0), last)).r),
+                      max(imageLoad(uSrc, min(base + ivec2(0, 1), last)).r,
+                          imageLoad(uSrc, min(base + ivec2(1, 1), last)).r));
+
+    // Odd source sizes leave a third row/column for the last texel of the level
+    bool extraX = (srcSize.x & 1) != 0 && dst.x == dstSize.x - 1;
+    bool extraY = (srcSize.y & 1) != 0 && dst.y == dstSize.y - 1;
+    if (extraX)
+    {
+        depth = max(depth, imageLoad(uSrc, min(base + ivec2(2, 0), last)).r);
+        depth = max(depth, imageLoad(uSrc, min(base + ivec2(2, 1), last)).r);
+    }
+    if (extraY)
+    {
+        depth = max(depth, imageLoad(uSrc, min(base + ivec2(0, 2), last)).r);
+        depth = max(depth, imageLoad(uSrc, min(base + ivec2(1, 2), last)).r);
+    }
+    if (extraX && extraY)
+    {
+        depth = max(depth, imageLoad(uSrc, min(base + ivec2(2, 2), last)).r);
+    }
+
+    imageStore(uDst, dst, vec4(depth));
+}
@@ -1,21 +1,50 @@
 #version 430 core
 
+#include "frame_uniforms.glsl"
+
 in vec3 vColor;
 in vec3 vWorldPos;
 in vec2 vTexCoord;
+in vec4 vLightClip;
+in vec4 vReflectionClip;
 
 uniform sampler2D uSpriteSheet;
 uniform int uHasTexture;
-uniform float uTime;
 uniform vec2 uPlayerXZ;
 uniform vec2 uMazeOriginXZ;
 uniform float uCellSize;
 uniform int uHighlightEnabled;
+uniform int uLightPass;
+
+// Cached light-space depth of the maze walls; only sampled while uStaticShadows != 0
+layout (binding = 1) uniform sampler2DShadow uStaticShadowMap;
+uniform int uStaticShadows;
+
+// Mirrored player, drawn at reduced resolution; only sampled while uReflections != 0
+layout (binding = 2) uniform sampler2D uReflectionTex;
+uniform int uReflections;
 
 layout (location = 0) out vec4 FragColor;
 
+float staticShadowLight()
+{
+    vec3 coord = vLightClip.xyz / vLightClip.w * 0.5 + 0.5;
+    if (any(lessThan(coord, vec3(0.0))) || any(greaterThan(coord, vec3(1.0))))
+    {
+        return 1.0;
+    }
+    return texture(uStaticShadowMap, vec3(coord.xy, coord.z - 0.0015));
+}
+
 void main()
 {
+    // Depth-only pass; the light-space depth is all that is kept
+    if (uLightPass != 0)
+    {
+        FragColor = vec4(1.0);
+        return;
+    }
+
     vec3 color = vColor;
 
     // Apply sprite sheet texture to walls (vertical surfaces have y > floor level)
@@ -83,5 +112,21 @@ void main()
         }
     }
 
+    if (uReflections != 0 && vWorldPos.y <= 0.1)
+    {
+        // Projecting the floor point with the reflection's own camera reuses an older image in place
+        vec2 reflectionUV = vReflectionClip.xy / vReflectionClip.w * 0.5 + 0.5;
+        if (all(greaterThanEqual(reflectionUV, vec2(0.0))) && all(lessThanEqual(reflectionUV, vec2(1.0))))
+        {
+            vec4 reflection = texture(uReflectionTex, reflectionUV);
+            color = mix(color, reflection.rgb, reflection.a * 0.3);
+        }
+    }
+
+    if (uStaticShadows != 0)
+    {
+        color *= mix(0.6, 1.0, staticShadowLight());
+    }
+
     FragColor = vec4(color, 1.0);
 }
@@ -1,19 +1,58 @@
 #version 430 core
 
+#include "frame_uniforms.glsl"
+
 layout (location = 0) in vec3 aPosition;
 layout (location = 1) in vec3 aColor;
 
-uniform mat4 uMVP;
+// Per-instance data, only read when uInstanced != 0
+layout (location = 2) in vec4 aInstanceOffsetCollected;   // xyz = world offset, w = collected/hidden flag
+layout (location = 3) in vec3 aInstanceTint;
+layout (location = 4) in vec3 aInstanceScale;             // wall boxes only
+
+// 0 = world-space vertices, 1 = pickup cubes, 2 = wall boxes (unit cube scaled per instance)
+uniform int uInstanced;
+// 1 while rendering the static shadow layer: project with the light instead of the camera
+uniform int uLightPass;
+uniform mat4 uLightViewProjection;
+// Camera the reflection target was last drawn with; differs from uViewProjection on reprojected frames
+uniform mat4 uReflectionViewProjection;
 
 out vec3 vColor;
 out vec3 vWorldPos;
 out vec2 vTexCoord;
+out vec4 vLightClip;
+out vec4 vReflectionClip;
 
 void main()
 {
+    vec3 worldPos = aPosition;
     vColor = aColor;
-    vWorldPos = aPosition;
+    if (uInstanced != 0)
+    {
+        // Collected instances stay in the buffer until their slot is reused; push them outside the clip volume
+        if (aInstanceOffsetCollected.w > 0.5)
+        {
+            gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+            vColor = vec3(0.0);
+            vWorldPos = vec3(0.0);
+            vTexCoord = vec2(0.0);
+            vLightClip = vec4(0.0, 0.0, 0.0, 1.0);
+            vReflectionClip = vec4(0.0, 0.0, 0.0, 1.0);
+            return;
+        }
+        if (uInstanced == 2)
+        {
+            worldPos *= aInstanceScale;
+        }
+        worldPos += aInstanceOffsetCollected.xyz;
+        vColor *= aInstanceTint;
+    }
+
+    vWorldPos = worldPos;
     // Generate texture coordinates from world position for sprite sheet mapping
-    vTexCoord = aPosition.xz * 0.15;
-    gl_Position = uMVP * vec4(aPosition, 1.0);
+    vTexCoord = worldPos.xz * 0.15;
+    vLightClip = uLightViewProjection * vec4(worldPos, 1.0);
+    vReflectionClip = uReflectionViewProjection * vec4(worldPos, 1.0);
+    gl_Position = (uLightPass != 0) ? vLightClip : uViewProjection * vec4(worldPos, 1.0);
 }
@@ -0,0 +1,114 @@
+#version 430
+
+#include "frame_uniforms.glsl"
+
+// One invocation per maze cluster: frustum, level and Hi-Z test, then the cluster's indirect draw
+layout (local_size_x = 64) in;
+
+// Matches OcclusionCuller::Cluster
+struct Cluster
+{
+    vec4 aabbMin;   // w = maze level
+    vec4 aabbMax;
+    uvec4 draw;     // x = first wall instance, y = wall instance count
+};
+
+// Matches ChunkGeometryPool::DrawElementsIndirectCommand
+struct DrawCommand
+{
+    uint count;
+    uint instanceCount;
+    uint firstIndex;
+    int baseVertex;
+    uint baseInstance;
+};
+
+layout (std430, binding = 0) readonly buffer Clusters
+{
+    Cluster clusters[];
+};
+
+layout (std430, binding = 1) writeonly buffer Commands
+{
+    DrawCommand commands[];
+};
+
+layout (binding = 0) uniform sampler2D uHiZ;
+
+uniform uint uClusterCount = 0u;
+uniform uint uIndexCount = 0u;
+// Clusters below this level are covered by the floor the camera is above
+uniform uint uMinLevel = 0u;
+uniform int uHiZLevels = 1;
+
+bool isVisible(Cluster cluster)
+{
+    if (uint(cluster.aabbMin.w) < uMinLevel)
+    {
+        return false;
+    }
+
+    vec3 ndcMin = vec3(1e30);
+    vec3 ndcMax = vec3(-1e30);
+    for (int i = 0; i < 8; ++i)
+    {
+        vec3 corner = vec3((i & 1) != 0 ? cluster.aabbMax.x : cluster.aabbMin.x,
+                           (i & 2) != 0 ? cluster.aabbMax.y : cluster.aabbMin.y,
+                           (i & 4) != 0 ? cluster.aabbMax.z : cluster.aabbMin.z);
+        vec4 clip = uViewProjection * vec4(corner, 1.0);
+
+        // Straddles the camera plane: no usable screen rect, keep it
+        if (clip.w <= 1e-4)
+        {
+            return true;
+        }
+        vec3 ndc = clip.xyz / clip.w;
+        ndcMin = min(ndcMin, ndc);
+        ndcMax = max(ndcMax, ndc);
+    }
+
+    if (any(lessThan(ndcMax.xy, vec2(-1.0))) || any(greaterThan(ndcMin.xy, vec2(1.0))) || ndcMin.z > 1.0)
+    {
+        return false;
+    }
+
+    // Rect in level-0 texels, grown by one so the low-resolution depth can not clip box edges
+    vec2 baseSize = vec2(textureSize(uHiZ, 0));
+    vec2 rectMin = clamp(ndcMin.xy * 0.5 + 0.5, 0.0, 1.0) * baseSize - 1.0;
+    vec2 rectMax = clamp(ndcMax.xy * 0.5 + 0.5, 0.0, 1.0) * baseSize + 1.0;
+
+    // Level where the rect is at most one texel wide, so its four corner texels cover it
+    vec2 extent = rectMax - rectMin;
+    int level = clamp(int(ceil(log2(max(max(extent.x, extent.y), 1.0)))), 0, uHiZLevels - 1);
+
+    ivec2 levelSize = textureSize(uHiZ, level);
+    float scale = 1.0 / float(1 << level);
+    ivec2 texelMin = clamp(ivec2(floor(rectMin * scale)), ivec2(0), levelSize - 1);
+    ivec2 texelMax = clamp(ivec2(floor(rectMax * scale)), ivec2(0), levelSize - 1);
+
+    float farthest = max(max(texelFetch(uHiZ, texelMin, level).r,
+                             texelFetch(uHiZ, ivec2(texelMax.x, texelMin.y), level).r),
+                         max(texelFetch(uHiZ, ivec2(texelMin.x, texelMax.y), level).r,
+                             texelFetch(uHiZ, texelMax, level).r));
+
+    float nearest = ndcMin.z * 0.5 + 0.5;
+    return nearest <= farthest;
+}
+
+void main()
+{
+    uint index = gl_GlobalInvocationID.x;
+    if (index >= uClusterCount)
+    {
+        return;
+    }
+
+    Cluster cluster = clusters[index];
+    bool visible = cluster.draw.y > 0u && isVisible(cluster);
+
+    commands[index].count = uIndexCount;
+    commands[index].instanceCount = visible ? cluster.draw.y : 0u;
+    commands[index].firstIndex = 0u;
+    commands[index].baseVertex = 0;
+    commands[index].baseInstance = cluster.draw.x;
+}
@@ -1,6 +1,32 @@
 #version 430
 
-layout( local_size_x = 1000 ) in;
+#include "frame_uniforms.glsl"
+
+// ParticleSystem injects the vendor's preferred size after #version
+#ifndef PARTICLE_GROUP_SIZE
+#define PARTICLE_GROUP_SIZE 64
+#endif
+
+layout( local_size_x = PARTICLE_GROUP_SIZE ) in;
+
+// Passes of one ParticleSystem::update, in order
+const uint STAGE_EMIT = 0u;
+const uint STAGE_PREPARE = 1u;
+const uint STAGE_SIMULATE = 2u;
+const uint STAGE_FINISH = 3u;
+
+uniform uint uStage = 2u;
+uniform uint uCapacity = 0u;
+// Half of AliveList holding the live particles at the start of this update
+uniform uint uAliveSlot = 0u;
+
+uniform uint uEmitCount = 0u;
+uniform uint uEmitSeed = 0u;
+uniform vec3 uEmitCenter = vec3(0);
+uniform vec3 uEmitExtent = vec3(1);
+uniform vec3 uEmitVelocity = vec3(0);
+// 0 never expires
+uniform float uEmitLife = 0.0;
 
 uniform float Gravity1 = 1000.0;
 uniform vec3 BlackHolePos1 = vec3(5,0,0);
@@ -12,47 +38,128 @@ uniform vec3 BlackHolePos2 = vec3(-5,0,0);
 uniform float ParticleInvMass = 1.0 / 0.1;
 uniform float DeltaT = 0.0005;
 uniform float MaxDist = 45.0;
-uniform uint ParticleCount = 0u;
+uniform float uLifeStep = 0.0;
 
 layout(std430, binding=0) buffer Pos {
   vec4 Position[];
 };
+// w is the remaining life in seconds, 0 for particles that never expire
 layout(std430, binding=1) buffer Vel {
   vec4 Velocity[];
 };
+layout(std430, binding=2) buffer AliveList {
+  uint Alive[];
+};
+layout(std430, binding=3) buffer DeadList {
+  uint Dead[];
+};
+// Matches ParticleSystem::Counters; dispatchArgs and drawArgs are the indirect commands
+layout(std430, binding=4) buffer Counters {
+  uint aliveCount[2];
+  int deadCount;
+  uint pad0;
+  uint dispatchArgs[3];
+  uint pad1;
+  uint drawArgs[4];
+};
 
-void main() {
-  uint idx = gl_GlobalInvocationID.x;
-  if (idx >= ParticleCount) {
+vec3 hash3(uint n) {
+  float fn = float(n);
+  return vec3(fract(sin(fn * 12.9898) * 43758.5453),
+              fract(sin(fn * 78.2331) * 15731.7431),
+              fract(sin(fn * 45.1643) * 31337.1337));
+}
+
+void emit(uint idx) {
+  if (idx >= uEmitCount) {
     return;
   }
 
-  vec3 p = Position[idx].xyz;
+  // Pop a free particle; threads that find the list empty give their claim back
+  int slot = atomicAdd(deadCount, -1);
+  if (slot <= 0) {
+    atomicAdd(deadCount, 1);
+    return;
+  }
+
+  uint p = Dead[uint(slot - 1)];
+  Position[p] = vec4(uEmitCenter + (hash3(uEmitSeed + idx) - 0.5) * uEmitExtent, 1.0);
+  Velocity[p] = vec4(uEmitVelocity, uEmitLife);
+
+  uint a = atomicAdd(aliveCount[uAliveSlot], 1u);
+  Alive[uAliveSlot * uCapacity + a] = p;
+}
+
+void simulate(uint idx) {
+  uint inSlot = uAliveSlot;
+  uint outSlot = 1u - uAliveSlot;
+  if (idx >= aliveCount[inSlot]) {
+    return;
+  }
+
+  uint p = Alive[inSlot * uCapacity + idx];
+  vec4 v = Velocity[p];
+
+  if (v.w > 0.0) {
+    v.w -= uLifeStep;
+    if (v.w <= 0.0) {
+      int d = atomicAdd(deadCount, 1);
+      Dead[uint(d)] = p;
+      return;
+    }
+  }
+
+  vec3 pos = Position[p].xyz;
 
   // Force from black hole #1
-  vec3 d = BlackHolePos1 - p;
+  vec3 d = BlackHolePos1 - pos;
   float dist = length(d);
   vec3 force = (Gravity1 / dist) * normalize(d);
 
   // Force from black hole #2
-  d = BlackHolePos2 - p;
+  d = BlackHolePos2 - pos;
   dist = length(d);
   force += (Gravity2 / dist) * normalize(d);
 
   // Reset particles that get too far from the attractors
   if( dist > MaxDist ) {
     vec3 center = 0.5 * (BlackHolePos1 + BlackHolePos2);
-    float fi = float(idx);
-    float jitterX = fract(sin(fi * 12.9898) * 43758.5453) - 0.5;
-    float jitterY = fract(sin(fi * 78.2331) * 15731.7431) * 0.35;
-    float jitterZ = fract(sin(fi * 45.1643) * 31337.1337) - 0.5;
-    Position[idx] = vec4(center + vec3(jitterX, jitterY, jitterZ), 1);
-    Velocity[idx] = vec4(0, 0, 0, 0);
+    vec3 jitter = hash3(p) - vec3(0.5, 0.0, 0.5);
+    jitter.y *= 0.35;
+    Position[p] = vec4(center + jitter, 1);
+    Velocity[p] = vec4(0, 0, 0, v.w);
   } else {
     // Apply simple Euler integrator
     vec3 a = force * ParticleInvMass;
-    Position[idx] = vec4(
-        p + Velocity[idx].xyz * DeltaT + 0.5 * a * DeltaT * DeltaT, 1.0);
-    Velocity[idx] = vec4( Velocity[idx].xyz + a * DeltaT, 0.0);
+    Position[p] = vec4(
+        pos + v.xyz * DeltaT + 0.5 * a * DeltaT * DeltaT, 1.0);
+    Velocity[p] = vec4( v.xyz + a * DeltaT, v.w);
+  }
+
+  uint a = atomicAdd(aliveCount[outSlot], 1u);
+  Alive[outSlot * uCapacity + a] = p;
+}
+
+void main() {
+  uint idx = gl_GlobalInvocationID.x;
+
+  if (uStage == STAGE_EMIT) {
+    emit(idx);
+  } else if (uStage == STAGE_PREPARE) {
+    // One thread: size the simulate dispatch and empty the list it compacts into
+    if (idx == 0u) {
+      dispatchArgs[0] = (aliveCount[uAliveSlot] + gl_WorkGroupSize.x - 1u) / gl_WorkGroupSize.x;
+      dispatchArgs[1] = 1u;
+      dispatchArgs[2] = 1u;
+      aliveCount[1u - uAliveSlot] = 0u;
+    }
+  } else if (uStage == STAGE_SIMULATE) {
+    simulate(idx);
+  } else if (idx == 0u) {
+    // STAGE_FINISH: draw the survivors
+    drawArgs[0] = aliveCount[1u - uAliveSlot];
+    drawArgs[1] = 1u;
+    drawArgs[2] = 0u;
+    drawArgs[3] = 0u;
   }
 }
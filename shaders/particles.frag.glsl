@@ -1,9 +1,28 @@
 #version 430 core
 
+#include "frame_uniforms.glsl"
+
 uniform vec4 Color;
+uniform int uOITPass = 0;
+uniform float uOITWeightScale = 1.0;
+
 layout (location = 0) out vec4 FragColor;
+layout (location = 1) out float OutReveal;
 
 void main()
 {
-    FragColor = Color;
+    if (uOITPass != 0)
+    {
+        // Same weighting as billboard.frag.glsl, so both blend into one OIT layer consistently
+        float depthWeight = max(0.05, 1.0 - clamp(gl_FragCoord.z, 0.0, 1.0));
+        float weight = max(0.01, Color.a * depthWeight * uOITWeightScale);
+
+        FragColor = vec4(Color.rgb * Color.a * weight, Color.a * weight);
+        OutReveal = Color.a;
+    }
+    else
+    {
+        FragColor = Color;
+        OutReveal = 0.0;
+    }
 }
@@ -1,9 +1,29 @@
 #version 430 core
 
+#include "frame_uniforms.glsl"
+
 layout (location = 0) in vec4 VertexPosition;
-uniform mat4 MVP;
+
+// ParticleSystem draws: gl_VertexID walks the live half of the alive list
+uniform int uPooled = 0;
+uniform uint uAliveBase = 0u;
+
+layout(std430, binding = 0) readonly buffer Pos
+{
+    vec4 Position[];
+};
+
+layout(std430, binding = 2) readonly buffer AliveList
+{
+    uint Alive[];
+};
 
 void main()
 {
-    gl_Position = MVP * VertexPosition;
+    vec4 position = VertexPosition;
+    if (uPooled != 0)
+    {
+        position = Position[Alive[uAliveBase + uint(gl_VertexID)]];
+    }
+    gl_Position = uViewProjection * position;
 }
@@ -0,0 +1,131 @@
+#version 430 core
+
+// Single full-screen post pass; the host compiles one variant per enabled effect set:
+//   POST_OIT          resolve weighted-blended OIT over the scene
+//   POST_MOTION_BLUR  blur along the screen-space camera velocity
+//   POST_TONEMAP      compress highlights above the shoulder instead of clipping them
+
+#include "frame_uniforms.glsl"
+
+in vec2 vTexCoord;
+
+layout (location = 0) out vec4 FragColor;
+
+layout (binding = 0) uniform sampler2D uSceneTex;
+layout (binding = 1) uniform sampler2D uOITAccumTex;
+layout (binding = 2) uniform sampler2D uOITRevealTex;
+// Read only while the OIT layer is downscaled: the opaque depth at full and at OIT resolution
+layout (binding = 3) uniform sampler2D uSceneDepthTex;
+layout (binding = 4) uniform sampler2D uOITDepthTex;
+
+// The scene occupies the bottom-left render size of a larger target
+uniform vec2 uSceneUVScale;
+// Last texel centre inside that region, so blur taps never read stale texels
+uniform vec2 uSceneUVMax;
+
+#ifdef POST_MOTION_BLUR
+uniform vec2 uBlurVelocity;     // Window UV the scene moved over the blur interval
+const int kBlurTaps = 8;
+#endif
+
+#ifdef POST_OIT
+// Scene pixels per OIT texel along each side, and the last OIT texel the scene covers
+uniform int uOITDownscale = 1;
+uniform ivec2 uOITTexelMax;
+// Keeps the weight of a texel at exactly the right depth finite
+const float kOITDepthEpsilon = 1e-4;
+
+// Depth-aware (joint bilateral) upsampling: the bilinear weights of the four nearest OIT texels, each
+// scaled down by how far its depth is from this pixel's, so a texel across a wall edge contributes
+// next to nothing and the transparent layer does not bleed over the silhouette
+void oitUpsample(vec2 sceneUV, out vec4 accum, out float reveal)
+{
+    ivec2 pixel = ivec2(sceneUV * vec2(textureSize(uSceneTex, 0)));
+    float depth = texelFetch(uSceneDepthTex, pixel, 0).r;
+
+    vec2 oitPos = (vec2(pixel) + 0.5) / float(uOITDownscale) - 0.5;
+    ivec2 base = ivec2(floor(oitPos));
+    vec2 f = oitPos - vec2(base);
+
+    accum = vec4(0.0);
+    reveal = 0.0;
+    float total = 0.0;
+    for (int i = 0; i < 4; ++i)
+    {
+        ivec2 offset = ivec2(i & 1, i >> 1);
+        ivec2 texel = clamp(base + offset, ivec2(0), uOITTexelMax);
+        vec2 bilinear = mix(1.0 - f, f, vec2(offset));
+        float weight = bilinear.x * bilinear.y /
+                       (kOITDepthEpsilon + abs(texelFetch(uOITDepthTex, texel, 0).r - depth));
+        accum += texelFetch(uOITAccumTex, texel, 0) * weight;
+        reveal += texelFetch(uOITRevealTex, texel, 0).r * weight;
+        total += weight;
+    }
+    accum /= total;
+    reveal /= total;
+}
+#endif
+
+#ifdef POST_TONEMAP
+uniform float uExposure;
+const float kShoulder = 0.8;
+#endif
+
+vec3 sceneAt(vec2 uv)
+{
+    vec2 sceneUV = min(uv * uSceneUVScale, uSceneUVMax);
+    vec3 color = texture(uSceneTex, sceneUV).rgb;
+
+#ifdef POST_OIT
+    vec4 accum;
+    float reveal;
+    if (uOITDownscale > 1)
+    {
+        oitUpsample(sceneUV, accum, reveal);
+    }
+    else
+    {
+        accum = texture(uOITAccumTex, sceneUV);
+        reveal = texture(uOITRevealTex, sceneUV).r;
+    }
+    reveal = clamp(reveal, 0.0, 1.0);
+    color = mix(accum.rgb / max(accum.a, 1e-5), color, reveal);
+#endif
+
+    return color;
+}
+
+#ifdef POST_TONEMAP
+vec3 tonemap(vec3 color)
+{
+    color *= uExposure;
+
+    // Identity below the shoulder keeps the LDR look; above it, roll off towards 1
+    vec3 over = max(color - vec3(kShoulder), vec3(0.0));
+    vec3 range = vec3(1.0 - kShoulder);
+    return min(color, vec3(kShoulder)) + range * over / (over + range);
+}
+#endif
+
+void main()
+{
+    vec2 uv = clamp(vTexCoord, vec2(0.0), vec2(1.0));
+
+#ifdef POST_MOTION_BLUR
+    vec3 color = vec3(0.0);
+    for (int i = 0; i < kBlurTaps; ++i)
+    {
+        float t = float(i) / float(kBlurTaps - 1) - 0.5;
+        color += sceneAt(clamp(uv + uBlurVelocity * t, vec2(0.0), vec2(1.0)));
+    }
+    color /= float(kBlurTaps);
+#else
+    vec3 color = sceneAt(uv);
+#endif
+
+#ifdef POST_TONEMAP
+    color = tonemap(color);
+#endif
+
+    FragColor = vec4(color, 1.0);
+}
@@ -0,0 +1,97 @@
+#version 430
+
+// Fills an R8 texture for ProceduralTexture::generate, one invocation per texel. The CPU fallback in
+// ProceduralTexture::fill draws the same patterns; noise matches in character, not texel for texel
+layout (local_size_x = 8, local_size_y = 8) in;
+
+// ProceduralTexture::Pattern
+const uint PATTERN_NOISE = 0u;
+const uint PATTERN_GRADIENT = 1u;
+const uint PATTERN_CHECKER = 2u;
+
+uniform uint uPattern = 0u;
+// Noise: texels per unit of noise space; checker: texels per cell
+uniform float uScale = 64.0;
+// Seed-derived shift of the noise domain, so each seed samples a different part of it
+uniform vec2 uOffset = vec2(0.0);
+uniform int uOctaves = 4;
+uniform float uPersistence = 0.5;
+uniform float uLacunarity = 2.0;
+
+layout (binding = 0, r8) uniform writeonly image2D uDst;
+
+// 2D simplex noise after Gustavson and McEwan's permutation-polynomial version; roughly [-1, 1]
+vec3 permute(vec3 x)
+{
+    return mod(((x * 34.0) + 1.0) * x, 289.0);
+}
+
+float simplex(vec2 v)
+{
+    const vec4 C = vec4(0.211324865405187, 0.366025403784439, -0.577350269189626, 0.024390243902439);
+    vec2 i = floor(v + dot(v, C.yy));
+    vec2 x0 = v - i + dot(i, C.xx);
+    vec2 i1 = (x0.x > x0.y) ? vec2(1.0, 0.0) : vec2(0.0, 1.0);
+    vec4 x12 = x0.xyxy + C.xxzz;
+    x12.xy -= i1;
+
+    i = mod(i, 289.0);
+    vec3 p = permute(permute(i.y + vec3(0.0, i1.y, 1.0)) + i.x + vec3(0.0, i1.x, 1.0));
+
+    vec3 m = max(0.5 - vec3(dot(x0, x0), dot(x12.xy, x12.xy), dot(x12.zw, x12.zw)), 0.0);
+    m = m * m;
+    m = m * m;
+
+    vec3 x = 2.0 * fract(p * C.www) - 1.0;
+    vec3 h = abs(x) - 0.5;
+    vec3 a0 = x - floor(x + 0.5);
+    m *= 1.79284291400159 - 0.85373472095314 * (a0 * a0 + h * h);
+
+    vec3 g;
+    g.x = a0.x * x0.x + h.x * x0.y;
+    g.yz = a0.yz * x12.xz + h.yz * x12.yw;
+    return 130.0 * dot(m, g);
+}
+
+// Octaves summed and normalised by their total amplitude, like simplex2() in deps/noise
+float fbm(vec2 p)
+{
+    float sum = 0.0;
+    float amplitude = 1.0;
+    float total = 0.0;
+    for (int octave = 0; octave < uOctaves; ++octave)
+    {
+        sum += simplex(p) * amplitude;
+        total += amplitude;
+        amplitude *= uPersistence;
+        p *= uLacunarity;
+    }
+    return total > 0.0 ? sum / total : 0.0;
+}
+
+void main()
+{
+    ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+    ivec2 size = imageSize(uDst);
+    if (texel.x >= size.x || texel.y >= size.y)
+    {
+        return;
+    }
+
+    float value;
+    if (uPattern == PATTERN_GRADIENT)
+    {
+        value = (float(texel.y) + 0.5) / float(size.y);
+    }
+    else if (uPattern == PATTERN_CHECKER)
+    {
+        ivec2 cell = texel / max(int(uScale), 1);
+        value = float((cell.x + cell.y) & 1);
+    }
+    else
+    {
+        value = fbm(vec2(texel) / uScale + uOffset) * 0.5 + 0.5;
+    }
+
+    imageStore(uDst, texel, vec4(clamp(value, 0.0, 1.0)));
+}
@@ -1,5 +1,7 @@
 #version 430 core
 
+#include "frame_uniforms.glsl"
+
 in vec2 vTexCoord;
 
 layout (location = 0) out vec4 FragColor;
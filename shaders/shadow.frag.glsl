@@ -1,11 +1,16 @@
 #version 430 core
 
+#include "frame_uniforms.glsl"
+
 // Shadow volume rendering fragment shader
 
 in vec2 vShadowCoord;
 
 layout (location = 0) out vec4 FragColor;
 
+// Darkening at the center of the blob when blended straight over the scene
+uniform float uShadowStrength;
+
 void main()
 {
     // Calculate soft shadow intensity using distance from quad center
@@ -15,6 +20,6 @@ void main()
     // Exponential falloff for soft edges
     float shadowIntensity = exp(-distFromCenter * distFromCenter * 3.0);
     
-    // Output shadow intensity in red channel (composite.frag reads .r)
-    FragColor = vec4(shadowIntensity, 0.0, 0.0, 1.0);
+    // Intensity in red for composite.frag; alpha drives GL_ZERO / GL_ONE_MINUS_SRC_ALPHA blending onto the scene
+    FragColor = vec4(shadowIntensity, 0.0, 0.0, shadowIntensity * uShadowStrength);
 }
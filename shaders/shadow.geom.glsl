@@ -1,20 +1,21 @@
 #version 430 core
 
+#include "frame_uniforms.glsl"
+
 // Geometry shader to project billboard sprite shadows onto the spherical terrain.
 
 layout (points) in;
 layout (triangle_strip, max_vertices = 4) out;
 
+// Billboard center (world space) from uSpritePos or the pickup instance; w = 0 casts nothing
+in vec4 vSprite[];
+
 // Billboard sprite setup
-uniform vec3 uSpritePos;           // Billboard center position (world space)
 uniform float uSpriteHalfSize;     // Half-size used when rendering the billboard
 uniform vec3 uLightDir;            // Direction from sun toward the scene
 uniform float uGroundY;            // Ground plane height (legacy, kept for compatibility)
 uniform vec3 uSphereCenter;        // Sphere center (world space)
 uniform float uSphereRadius;       // Sphere radius
-uniform mat4 uViewMatrix;          // Camera view matrix
-uniform mat4 uProjectionMatrix;    // Camera projection matrix
-uniform vec2 uInvResolution;       // 1.0 / screen resolution
 
 out vec2 vShadowCoord;
 
@@ -87,13 +88,18 @@ vec3 snapToSphere(vec3 pos, vec3 sphereCenter, float sphereRadius)
 
 void main()
 {
+    if (vSprite[0].w < 0.5)
+    {
+        return;
+    }
+
     // Get camera right/up axes in world space from inverse view matrix.
-    mat3 invView = mat3(inverse(uViewMatrix));
+    mat3 invView = mat3(inverse(uView));
     vec3 camRight = normalize(invView[0]);
     vec3 camUp = normalize(invView[1]);
 
     // Estimate billboard feet point in world space.
-    vec3 feetPos = uSpritePos - camUp * (uSpriteHalfSize * 0.95);
+    vec3 feetPos = vSprite[0].xyz - camUp * (uSpriteHalfSize * 0.95);
 
     vec3 lightDir = normalize(uLightDir);
     vec3 projectedCenter = projectToGround(feetPos, lightDir, uGroundY);
@@ -118,22 +124,22 @@ void main()
     vec3 bottomRightWorld= snapToSphere(projectedCenter - tangentSide * shadowWidth - tangentForward * shadowLength, uSphereCenter, uSphereRadius);
 
     // Top-left
-    gl_Position = uProjectionMatrix * uViewMatrix * vec4(topLeftWorld, 1.0);
+    gl_Position = uViewProjection * vec4(topLeftWorld, 1.0);
     vShadowCoord = vec2(0.0, 1.0);
     EmitVertex();
 
     // Top-right
-    gl_Position = uProjectionMatrix * uViewMatrix * vec4(topRightWorld, 1.0);
+    gl_Position = uViewProjection * vec4(topRightWorld, 1.0);
     vShadowCoord = vec2(1.0, 1.0);
     EmitVertex();
 
     // Bottom-left
-    gl_Position = uProjectionMatrix * uViewMatrix * vec4(bottomLeftWorld, 1.0);
+    gl_Position = uViewProjection * vec4(bottomLeftWorld, 1.0);
     vShadowCoord = vec2(0.0, 0.0);
     EmitVertex();
 
     // Bottom-right
-    gl_Position = uProjectionMatrix * uViewMatrix * vec4(bottomRightWorld, 1.0);
+    gl_Position = uViewProjection * vec4(bottomRightWorld, 1.0);
     vShadowCoord = vec2(1.0, 0.0);
     EmitVertex();
 
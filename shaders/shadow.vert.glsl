@@ -1,11 +1,29 @@
 #version 430 core
 
+#include "frame_uniforms.glsl"
+
 // Shadow volume rendering vertex shader - simple pass-through
 // All actual projection work happens in geometry shader
 
+// Pickup instance buffer, only read when uInstanced != 0
+layout (location = 2) in vec4 aInstanceOffsetCollected;   // xyz = world position, w = collected flag
+
+uniform int uInstanced;
+uniform vec3 uSpritePos;
+
+out vec4 vSprite;   // xyz = billboard center, w = 0 when nothing should be cast
+
 void main()
 {
     // Geometry shader will handle all positioning and projection
     // Vertex shader just needs to pass through one vertex
     gl_Position = vec4(0.0, 0.0, 0.0, 1.0);
+    if (uInstanced != 0)
+    {
+        vSprite = vec4(aInstanceOffsetCollected.xyz, aInstanceOffsetCollected.w > 0.5 ? 0.0 : 1.0);
+    }
+    else
+    {
+        vSprite = vec4(uSpritePos, 1.0);
+    }
 }
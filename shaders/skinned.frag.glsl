@@ -1,10 +1,10 @@
 #version 430 core
 
+#include "frame_uniforms.glsl"
+
 in vec3 vWorldNormal;
 in vec3 vWorldPos;
 
-uniform vec3 uCameraPos;
-uniform float uTime;
 uniform int uShadowPass;
 
 layout(location = 0) out vec4 FragColor;
@@ -1,5 +1,9 @@
 #version 430 core
 
+#include "frame_uniforms.glsl"
+
+// GLTFModel::PackedVertex: the normal arrives as snorm 10:10:10, weights as unorm8, and the unorm16
+// UV covers the mesh's UV bounds (MeshBuffers::texCoordRange) rather than 0..1
 layout(location = 0) in vec3 aPosition;
 layout(location = 1) in vec2 aTexCoord;
 layout(location = 2) in vec3 aNormal;
@@ -7,11 +11,58 @@ layout(location = 3) in ivec4 aBoneIds;
 layout(location = 4) in vec4 aBoneWeights;
 
 uniform mat4 uModel;
-uniform mat4 uView;
-uniform mat4 uProjection;
 uniform mat4 uBones[200];
 uniform uint uBoneCount;
 uniform int  uHasTexCoord;
+// First vertex of this mesh in the compute-skinned buffer; -1 skins here from uBones
+uniform int  uSkinnedBase = -1;
+
+// Position/normal pairs written by skinning.cs.glsl
+layout(std430, binding = 3) readonly buffer SkinnedVertices
+{
+    vec4 skinnedVertices[];
+};
+
+// Instanced path: each character's palette comes from Palettes instead of uBones
+uniform int  uInstanced = 0;
+// Meshes per instance and the mesh being drawn, to index Instances
+uniform uint uInstanceStride = 1u;
+uniform uint uInstanceMesh = 0u;
+// First instance of the detail level being drawn; gl_InstanceID restarts at 0 per draw
+uniform uint uInstanceBase = 0u;
+
+struct InstanceData
+{
+    mat4  model;
+    uvec2 paletteBase;
+    float paletteBlend;
+    float padding;
+};
+
+layout(std430, binding = 4) readonly buffer Palettes
+{
+    mat4 palettes[];
+};
+
+layout(std430, binding = 5) readonly buffer Instances
+{
+    InstanceData instances[];
+};
+
+mat4 boneMatrix(int id)
+{
+    if (uInstanced == 0)
+    {
+        return uBones[id];
+    }
+    InstanceData inst = instances[(uInstanceBase + uint(gl_InstanceID)) * uInstanceStride + uInstanceMesh];
+    mat4 first = palettes[inst.paletteBase.x + uint(id)];
+    if (inst.paletteBlend <= 0.0)
+    {
+        return first;
+    }
+    return first * (1.0 - inst.paletteBlend) + palettes[inst.paletteBase.y + uint(id)] * inst.paletteBlend;
+}
 
 out vec3 vWorldNormal;
 out vec3 vWorldPos;
@@ -21,7 +72,13 @@ void main()
     float wt = aBoneWeights.x + aBoneWeights.y + aBoneWeights.z + aBoneWeights.w;
     vec4 skinnedPos;
     vec3 skinnedNorm;
-    if (wt > 0.001 && uBoneCount > 1u)
+    if (uSkinnedBase >= 0)
+    {
+        int i = (uSkinnedBase + gl_VertexID) * 2;
+        skinnedPos  = vec4(skinnedVertices[i].xyz, 1.0);
+        skinnedNorm = skinnedVertices[i + 1].xyz;
+    }
+    else if (wt > 0.001 && uBoneCount > 1u)
     {
         skinnedPos  = vec4(0.0);
         skinnedNorm = vec3(0.0);
@@ -30,8 +87,9 @@ void main()
             int   id = aBoneIds[i];
             float w  = aBoneWeights[i];
             if (w <= 0.0 || id < 0 || uint(id) >= uBoneCount) continue;
-            skinnedPos  += w * (uBones[id] * vec4(aPosition, 1.0));
-            skinnedNorm += w * (mat3(uBones[id]) * aNormal);
+            mat4  bone = boneMatrix(id);
+            skinnedPos  += w * (bone * vec4(aPosition, 1.0));
+            skinnedNorm += w * (mat3(bone) * aNormal);
         }
     }
     else
@@ -39,10 +97,15 @@ void main()
         skinnedPos  = vec4(aPosition, 1.0);
         skinnedNorm = aNormal;
     }
-    vec4 worldPos  = uModel * skinnedPos;
-    vWorldNormal = normalize(transpose(inverse(mat3(uModel))) * normalize(skinnedNorm));
+    mat4 model = uModel;
+    if (uInstanced != 0)
+    {
+        model = instances[(uInstanceBase + uint(gl_InstanceID)) * uInstanceStride + uInstanceMesh].model * uModel;
+    }
+    vec4 worldPos  = model * skinnedPos;
+    vWorldNormal = normalize(transpose(inverse(mat3(model))) * normalize(skinnedNorm));
     vWorldPos    = worldPos.xyz;
-    gl_Position  = uProjection * uView * worldPos;
+    gl_Position  = uViewProjection * worldPos;
 }
 
 
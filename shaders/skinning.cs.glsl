@@ -0,0 +1,78 @@
+#version 430 core
+
+// Skins each vertex of a model once per frame; skinned.vert.glsl and any
+// other consumer read the result instead of blending bones per draw.
+layout(local_size_x = 64) in;
+
+struct SkinSourceVertex
+{
+    vec4  position;
+    vec4  normal;
+    ivec4 boneIds;
+    vec4  boneWeights;
+};
+
+layout(std430, binding = 0) readonly buffer SourceVertices
+{
+    SkinSourceVertex sourceVertices[];
+};
+
+layout(std430, binding = 1) readonly buffer Bones
+{
+    mat4 bones[];
+};
+
+layout(std430, binding = 2) writeonly buffer SkinnedVertices
+{
+    vec4 skinnedVertices[];
+};
+
+uniform uint uVertexCount = 0u;
+uniform uint uBoneCount = 0u;
+// Offsets of two palettes in Bones (baked animation frames); blend 0 uses only the first
+uniform uvec2 uPaletteBase = uvec2(0u);
+uniform float uPaletteBlend = 0.0;
+
+mat4 boneMatrix(int id)
+{
+    mat4 bone = bones[uPaletteBase.x + uint(id)];
+    if (uPaletteBlend > 0.0)
+    {
+        bone = bone * (1.0 - uPaletteBlend) + bones[uPaletteBase.y + uint(id)] * uPaletteBlend;
+    }
+    return bone;
+}
+
+void main()
+{
+    uint idx = gl_GlobalInvocationID.x;
+    if (idx >= uVertexCount)
+    {
+        return;
+    }
+
+    SkinSourceVertex v = sourceVertices[idx];
+
+    mat4 skin = mat4(0.0);
+    float totalWeight = 0.0;
+    for (int i = 0; i < 4; ++i)
+    {
+        int   id = v.boneIds[i];
+        float w  = v.boneWeights[i];
+        if (w <= 0.0 || id < 0 || uint(id) >= uBoneCount) continue;
+        skin += w * boneMatrix(id);
+        totalWeight += w;
+    }
+
+    vec3 position = v.position.xyz;
+    vec3 normal   = v.normal.xyz;
+    if (totalWeight > 1e-6)
+    {
+        skin *= 1.0 / totalWeight;
+        position = (skin * vec4(position, 1.0)).xyz;
+        normal   = mat3(skin) * normal;
+    }
+
+    skinnedVertices[idx * 2u]      = vec4(position, 1.0);
+    skinnedVertices[idx * 2u + 1u] = vec4(normal, 0.0);
+}
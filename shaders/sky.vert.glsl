@@ -1,5 +1,7 @@
 #version 430 core
 
+#include "frame_uniforms.glsl"
+
 out vec2 vNDC;
 
 void main()
@@ -0,0 +1,362 @@
+#include "AssetPack.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+std::string AssetPack::sRoot;
+std::uint64_t AssetPack::sStamp = 0;
+const std::uint8_t *AssetPack::sMappedData = nullptr;
+std::size_t AssetPack::sMappedSize = 0;
+#if defined(_WIN32)
+void *AssetPack::sFileHandle = nullptr;
+void *AssetPack::sMappingHandle = nullptr;
+#else
+int AssetPack::sFileDescriptor = -1;
+#endif
+std::unordered_map<std::string, std::span<const std::uint8_t>> AssetPack::sIndex;
+
+namespace
+{
+    std::size_t alignUp(std::size_t value) noexcept
+    {
+        return (value + AssetPack::DATA_ALIGNMENT - 1) & ~(AssetPack::DATA_ALIGNMENT - 1);
+    }
+}
+
+bool AssetPack::mount(const std::string &packPath, const std::string &root) noexcept
+{
+    unmount();
+
+    std::error_code ec;
+    if (!std::filesystem::exists(packPath, ec))
+    {
+        return false;
+    }
+
+    if (!mapFile(packPath))
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "AssetPack: cannot map %s", packPath.c_str());
+        return false;
+    }
+
+    Header header{};
+    if (sMappedSize < sizeof(Header))
+    {
+        unmount();
+        return false;
+    }
+    std::memcpy(&header, sMappedData, sizeof(Header));
+
+    const std::size_t namesBegin = sizeof(Header) + static_cast<std::size_t>(header.entryCount) * sizeof(TocEntry);
+    if (header.magic != MAGIC || header.containerVersion != CONTAINER_VERSION ||
+        namesBegin + header.namesSize > sMappedSize)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "AssetPack: %s is not a version %u pack, ignoring it",
+                    packPath.c_str(), CONTAINER_VERSION);
+        unmount();
+        return false;
+    }
+
+    const auto *names = reinterpret_cast<const char *>(sMappedData + namesBegin);
+    sIndex.reserve(header.entryCount);
+    for (std::uint32_t i = 0; i < header.entryCount; ++i)
+    {
+        TocEntry entry{};
+        std::memcpy(&entry, sMappedData + sizeof(Header) + i * sizeof(TocEntry), sizeof(TocEntry));
+
+        if (entry.offset > sMappedSize || entry.size > sMappedSize - entry.offset ||
+            static_cast<std::uint64_t>(entry.nameOffset) + entry.nameLength > header.namesSize)
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "AssetPack: %s is truncated, ignoring it", packPath.c_str());
+            unmount();
+            return false;
+        }
+
+        sIndex.emplace(std::string(names + entry.nameOffset, entry.nameLength),
+                       std::span<const std::uint8_t>(sMappedData + entry.offset, static_cast<std::size_t>(entry.size)));
+    }
+
+    sRoot = normalize(std::filesystem::absolute(root, ec).generic_string());
+    if (!sRoot.empty() && sRoot.back() != '/')
+    {
+        sRoot.push_back('/');
+    }
+
+    const auto writeTime = std::filesystem::last_write_time(packPath, ec);
+    sStamp = (static_cast<std::uint64_t>(sMappedSize) << 32) ^
+             static_cast<std::uint64_t>(writeTime.time_since_epoch().count());
+
+    SDL_Log("AssetPack: mounted %s (%zu files, %zu bytes)", packPath.c_str(), sIndex.size(), sMappedSize);
+    return true;
+}
+
+void AssetPack::unmount() noexcept
+{
+    sIndex.clear();
+    sRoot.clear();
+    sStamp = 0;
+    unmapFile();
+}
+
+std::span<const std::uint8_t> AssetPack::find(std::string_view path) noexcept
+{
+    if (sIndex.empty())
+    {
+        return {};
+    }
+
+    std::string key = normalize(path);
+    if (!sRoot.empty() && key.starts_with(sRoot))
+    {
+        key.erase(0, sRoot.size());
+    }
+
+    if (const auto it = sIndex.find(key); it != sIndex.cend())
+    {
+        return it->second;
+    }
+    return {};
+}
+
+std::string AssetPack::normalize(std::string_view path)
+{
+    std::string result(path);
+    std::replace(result.begin(), result.end(), '\\', '/');
+    while (result.starts_with("./"))
+    {
+        result.erase(0, 2);
+    }
+    return result;
+}
+
+std::size_t AssetPack::write(const std::string &packPath, const std::string &root,
+                             const std::vector<std::string> &directories) noexcept
+{
+    namespace fs = std::filesystem;
+
+    struct Source
+    {
+        fs::path path;
+        std::string name;
+        std::uint64_t size;
+    };
+
+    std::vector<Source> sources;
+    try
+    {
+        for (const auto &directory : directories)
+        {
+            const fs::path base = fs::path(root) / directory;
+            for (const auto &item : fs::recursive_directory_iterator(base))
+            {
+                if (item.is_regular_file())
+                {
+                    sources.push_back(Source{item.path(), normalize(fs::relative(item.path(), root).generic_string()),
+                                             static_cast<std::uint64_t>(item.file_size())});
+                }
+            }
+        }
+    }
+    catch (const std::exception &e)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "AssetPack: cannot list %s: %s", root.c_str(), e.what());
+        return 0;
+    }
+
+    // Sorted so the same inputs always produce the same pack
+    std::sort(sources.begin(), sources.end(), [](const Source &a, const Source &b)
+              { return a.name < b.name; });
+
+    std::vector<TocEntry> toc(sources.size());
+    std::string names;
+    for (std::size_t i = 0; i < sources.size(); ++i)
+    {
+        toc[i].nameOffset = static_cast<std::uint32_t>(names.size());
+        toc[i].nameLength = static_cast<std::uint32_t>(sources[i].name.size());
+        toc[i].size = sources[i].size;
+        names += sources[i].name;
+    }
+
+    std::size_t offset = alignUp(sizeof(Header) + toc.size() * sizeof(TocEntry) + names.size());
+    for (TocEntry &entry : toc)
+    {
+        entry.offset = offset;
+        offset = alignUp(offset + static_cast<std::size_t>(entry.size));
+    }
+
+    const std::string tempPath = packPath + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "AssetPack: cannot write %s", tempPath.c_str());
+            return 0;
+        }
+
+        const Header header{MAGIC, CONTAINER_VERSION, static_cast<std::uint32_t>(toc.size()),
+                            static_cast<std::uint32_t>(names.size())};
+        out.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+        out.write(reinterpret_cast<const char *>(toc.data()), static_cast<std::streamsize>(toc.size() * sizeof(TocEntry)));
+        out.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+        std::vector<char> bytes;
+        for (std::size_t i = 0; i < sources.size(); ++i)
+        {
+            const auto padding = static_cast<std::streamsize>(toc[i].offset) - static_cast<std::streamsize>(out.tellp());
+            for (std::streamsize p = 0; p < padding; ++p)
+            {
+                out.put('\0');
+            }
+
+            std::ifstream in(sources[i].path, std::ios::binary);
+            bytes.resize(static_cast<std::size_t>(sources[i].size));
+            in.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            if (!in)
+            {
+                SDL_LogError(SDL_LOG_CATEGORY_ERROR, "AssetPack: cannot read %s", sources[i].path.string().c_str());
+                return 0;
+            }
+            out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        }
+
+        if (!out)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "AssetPack: write to %s failed", tempPath.c_str());
+            return 0;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, packPath, ec);
+    if (ec)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "AssetPack: rename to %s failed: %s", packPath.c_str(), ec.message().c_str());
+        return 0;
+    }
+
+    SDL_Log("AssetPack: wrote %zu files, %zu bytes to %s", sources.size(), offset, packPath.c_str());
+    return sources.size();
+}
+
+#if defined(_WIN32)
+
+bool AssetPack::mapFile(const std::string &path) noexcept
+{
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    sFileHandle = file;
+    sMappingHandle = mapping;
+    sMappedData = static_cast<const std::uint8_t *>(view);
+    sMappedSize = static_cast<std::size_t>(size.QuadPart);
+    return true;
+}
+
+void AssetPack::unmapFile() noexcept
+{
+    if (sMappedData)
+    {
+        UnmapViewOfFile(sMappedData);
+        sMappedData = nullptr;
+    }
+    if (sMappingHandle)
+    {
+        CloseHandle(static_cast<HANDLE>(sMappingHandle));
+        sMappingHandle = nullptr;
+    }
+    if (sFileHandle)
+    {
+        CloseHandle(static_cast<HANDLE>(sFileHandle));
+        sFileHandle = nullptr;
+    }
+    sMappedSize = 0;
+}
+
+#else
+
+bool AssetPack::mapFile(const std::string &path) noexcept
+{
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || info.st_size <= 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void *view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (view == MAP_FAILED)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    sFileDescriptor = fd;
+    sMappedData = static_cast<const std::uint8_t *>(view);
+    sMappedSize = static_cast<std::size_t>(info.st_size);
+    return true;
+}
+
+void AssetPack::unmapFile() noexcept
+{
+    if (sMappedData)
+    {
+        munmap(const_cast<std::uint8_t *>(sMappedData), sMappedSize);
+        sMappedData = nullptr;
+    }
+    if (sFileDescriptor >= 0)
+    {
+        ::close(sFileDescriptor);
+        sFileDescriptor = -1;
+    }
+    sMappedSize = 0;
+}
+
+#endif
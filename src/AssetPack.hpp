@@ -0,0 +1,82 @@
+#ifndef ASSET_PACK_HPP
+#define ASSET_PACK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/// @brief One read-only archive of the shipped asset files, memory-mapped at startup
+/// @details File layout: Header, entryCount TocEntry records, the name bytes, then each file's data
+/// starting on a DATA_ALIGNMENT boundary. Names are paths relative to the resource root with '/'
+/// separators, so a loader keeps asking for the path it would have opened and find() maps it into
+/// the pack. A missing pack, or a file not in it, leaves the loose file on disk to be read as before.
+/// The index is immutable once mounted; lookups are safe from any thread.
+class AssetPack
+{
+public:
+    static constexpr std::uint32_t MAGIC = 0x4B505742u; // "BWPK"
+    static constexpr std::uint32_t CONTAINER_VERSION = 1u;
+    /// Alignment of every file's data, so SIMD decoders and block formats can read it in place
+    static constexpr std::size_t DATA_ALIGNMENT = 64;
+    static constexpr std::string_view DEFAULT_FILENAME = "assets.bwpak";
+
+    /// @brief Map packPath; paths under root (the directory of the resource JSON) resolve into it
+    /// @details Call before any loader runs; mounting again replaces the previous pack.
+    static bool mount(const std::string &packPath, const std::string &root) noexcept;
+    static void unmount() noexcept;
+
+    [[nodiscard]] static bool isMounted() noexcept { return sMappedData != nullptr; }
+
+    /// @brief Zero-copy view of a packed file, by absolute or root-relative path; empty if not packed
+    [[nodiscard]] static std::span<const std::uint8_t> find(std::string_view path) noexcept;
+
+    /// Size and write time of the mounted pack, for caches keyed on their source; 0 when unmounted
+    [[nodiscard]] static std::uint64_t getStamp() noexcept { return sStamp; }
+
+    /// @brief Write every regular file under root/directory for each directory into packPath
+    /// @return Number of files packed, or 0 on failure
+    static std::size_t write(const std::string &packPath, const std::string &root,
+                             const std::vector<std::string> &directories) noexcept;
+
+private:
+    struct Header
+    {
+        std::uint32_t magic;
+        std::uint32_t containerVersion;
+        std::uint32_t entryCount;
+        std::uint32_t namesSize;
+    };
+
+    struct TocEntry
+    {
+        std::uint64_t offset;
+        std::uint64_t size;
+        std::uint32_t nameOffset;
+        std::uint32_t nameLength;
+    };
+
+    [[nodiscard]] static std::string normalize(std::string_view path);
+
+    static bool mapFile(const std::string &path) noexcept;
+    static void unmapFile() noexcept;
+
+    static std::string sRoot;
+    static std::uint64_t sStamp;
+    static const std::uint8_t *sMappedData;
+    static std::size_t sMappedSize;
+#if defined(_WIN32)
+    static void *sFileHandle;
+    static void *sMappingHandle;
+#else
+    static int sFileDescriptor;
+#endif
+
+    // Keys are normalized relative paths; values point into the mapping
+    static std::unordered_map<std::string, std::span<const std::uint8_t>> sIndex;
+};
+
+#endif // ASSET_PACK_HPP
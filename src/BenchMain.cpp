@@ -0,0 +1,608 @@
+// Microbenchmarks for the world-generation, streaming and collision hot paths
+// Every benchmark uses fixed seeds and fixed inputs, so two runs on one machine measure the same work.
+// Usage: breakingwalls_bench [name filter] [model.glb]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <SDL3/SDL.h>
+
+#include <MazeBuilder/maze_builder.h>
+
+#include "GLTFModel.hpp"
+#include "JobSystem.hpp"
+#include "Level.hpp"
+#include "RenderWindow.hpp"
+#include "ResourceIdentifiers.hpp"
+#include "ResourceManager.hpp"
+#include "WallBroadphase.hpp"
+#include "World.hpp"
+
+namespace
+{
+    // Counted in the replaced global operator new below, across all threads
+    std::atomic<std::uint64_t> gAllocations{0};
+
+    constexpr int kWarmupRepetitions = 1;
+    constexpr int kRepetitions = 7;
+    constexpr std::uint32_t kSeed = 0xB3A7C0DEu;
+    constexpr std::string_view kDefaultModel = "models/stylized-character.glb";
+
+    /// @brief Times only the sections between start() and stop(), and counts their allocations
+    class Stopwatch
+    {
+    public:
+        void start() noexcept
+        {
+            mAllocationsAtStart = gAllocations.load(std::memory_order_relaxed);
+            mStart = std::chrono::steady_clock::now();
+        }
+
+        void stop() noexcept
+        {
+            mElapsed += std::chrono::steady_clock::now() - mStart;
+            mAllocations += gAllocations.load(std::memory_order_relaxed) - mAllocationsAtStart;
+        }
+
+        [[nodiscard]] double nanoseconds() const noexcept { return std::chrono::duration<double, std::nano>(mElapsed).count(); }
+        [[nodiscard]] std::uint64_t allocations() const noexcept { return mAllocations; }
+
+    private:
+        std::chrono::steady_clock::time_point mStart;
+        std::chrono::steady_clock::duration mElapsed{0};
+        std::uint64_t mAllocationsAtStart{0};
+        std::uint64_t mAllocations{0};
+    };
+
+    /// What one repetition did: operations timed and work items they covered (walls, pickups, bones...)
+    struct Work
+    {
+        std::size_t ops{0};
+        std::size_t items{0};
+    };
+
+    class BenchRunner
+    {
+    public:
+        explicit BenchRunner(std::string filter) : mFilter{std::move(filter)}
+        {
+            std::printf("%-44s %12s %12s %14s %16s\n", "benchmark", "ns/op", "allocs/op", "ops/s", "items/s");
+        }
+
+        /// @brief Run body kWarmupRepetitions + kRepetitions times and print the median repetition
+        void run(const std::string &name, const std::function<Work(Stopwatch &)> &body)
+        {
+            if (!mFilter.empty() && name.find(mFilter) == std::string::npos)
+            {
+                return;
+            }
+
+            struct Repetition
+            {
+                double nsPerOp;
+                double allocsPerOp;
+                double itemsPerOp;
+            };
+            std::vector<Repetition> repetitions;
+
+            for (int i = 0; i < kWarmupRepetitions + kRepetitions; ++i)
+            {
+                Stopwatch stopwatch;
+                const Work work = body(stopwatch);
+                if (work.ops == 0)
+                {
+                    std::printf("%-44s %12s\n", name.c_str(), "skipped");
+                    return;
+                }
+                if (i >= kWarmupRepetitions)
+                {
+                    const auto ops = static_cast<double>(work.ops);
+                    repetitions.push_back(Repetition{stopwatch.nanoseconds() / ops,
+                                                     static_cast<double>(stopwatch.allocations()) / ops,
+                                                     static_cast<double>(work.items) / ops});
+                }
+            }
+
+            std::ranges::sort(repetitions, {}, &Repetition::nsPerOp);
+            const Repetition &median = repetitions[repetitions.size() / 2];
+            const double opsPerSecond = median.nsPerOp > 0.0 ? 1.0e9 / median.nsPerOp : 0.0;
+            std::printf("%-44s %12.1f %12.2f %14.0f %16.0f\n", name.c_str(), median.nsPerOp, median.allocsPerOp,
+                        opsPerSecond, opsPerSecond * median.itemsPerOp);
+        }
+
+    private:
+        std::string mFilter;
+    };
+
+    std::string withRadius(std::string_view name, int radius)
+    {
+        return std::string(name) + " r=" + std::to_string(radius);
+    }
+}
+
+/// @brief Drives World's private chunk pipeline one stage at a time
+class WorldBench
+{
+public:
+    using ChunkCoord = World::ChunkCoord;
+    using ChunkMazeGrid = World::ChunkMazeGrid;
+
+    explicit WorldBench(World &world) : mWorld{world}
+    {
+        // Each generated maze is new work, never a cache hit
+        mWorld.setMazeCacheBudget(0);
+        mWorld.setChunkIntegrationBudget(std::chrono::hours(1));
+    }
+
+    /// Chunks in the square of the given radius around a fixed, far-off center
+    [[nodiscard]] static std::vector<ChunkCoord> square(int radius)
+    {
+        constexpr ChunkCoord center{1000, 1000};
+        std::vector<ChunkCoord> coords;
+        for (int dz = -radius; dz <= radius; ++dz)
+        {
+            for (int dx = -radius; dx <= radius; ++dx)
+            {
+                coords.push_back(ChunkCoord{center.x + dx, center.z + dz});
+            }
+        }
+        return coords;
+    }
+
+    [[nodiscard]] ChunkMazeGrid generate(const ChunkCoord &coord) const { return mWorld.generateMazeForChunk(coord); }
+
+    void buildWalls(const ChunkMazeGrid &grid, const ChunkCoord &coord, std::vector<Sphere> &out) const
+    {
+        mWorld.buildMazeWallSpheres(grid, coord, out);
+    }
+
+    void buildPickups(const ChunkMazeGrid &grid, const ChunkCoord &coord, std::vector<World::PickupSphere> &out) const
+    {
+        mWorld.buildPickupSpheres(grid, out, coord);
+    }
+
+    /// @brief Queue coords and run processCompletedChunks until every one is integrated
+    /// @details Only processCompletedChunks is timed; waiting for the generation jobs is not.
+    std::size_t load(const std::vector<ChunkCoord> &coords, Stopwatch *stopwatch)
+    {
+        mWorld.mCenterChunk = coords[coords.size() / 2];
+        for (const auto &coord : coords)
+        {
+            mWorld.loadChunk(coord, World::chunkPriority(coord, mWorld.mCenterChunk));
+        }
+        mWorld.dispatchChunkRequests();
+
+        while (!mWorld.mChunkRequestQueue.empty() || !mWorld.mIntegrationQueue.empty() || hasPendingChunks())
+        {
+            waitForPendingChunks();
+            if (stopwatch)
+            {
+                stopwatch->start();
+            }
+            mWorld.processCompletedChunks();
+            if (stopwatch)
+            {
+                stopwatch->stop();
+            }
+        }
+
+        return mWorld.mLoadedChunks.size();
+    }
+
+    /// @brief Unload every loaded chunk, timing each unloadChunk call when stopwatch is set
+    std::size_t unloadAll(Stopwatch *stopwatch)
+    {
+        const std::vector<ChunkCoord> loaded(mWorld.mLoadedChunks.begin(), mWorld.mLoadedChunks.end());
+        for (const auto &coord : loaded)
+        {
+            if (stopwatch)
+            {
+                stopwatch->start();
+            }
+            mWorld.unloadChunk(coord);
+            if (stopwatch)
+            {
+                stopwatch->stop();
+            }
+        }
+
+        return loaded.size();
+    }
+
+    /// @brief Queue up to count wall shapes of the loaded chunks for breaking
+    std::size_t queueWallBreaks(std::size_t count)
+    {
+        // Smallest keys first, so the same walls break on every run
+        std::vector<std::uint64_t> keys;
+        const auto &shapes = mWorld.mSpheres.column<World::SPHERE_SHAPE>();
+        keys.reserve(shapes.size());
+        for (const b2ShapeId &shapeId : shapes)
+        {
+            if (b2Shape_IsValid(shapeId))
+            {
+                keys.push_back(b2StoreShapeId(shapeId));
+            }
+        }
+        std::ranges::sort(keys);
+        keys.resize(std::min(count, keys.size()));
+
+        for (const std::uint64_t key : keys)
+        {
+            mWorld.mWallBreakQueue.push_back(b2LoadShapeId(key));
+        }
+        return keys.size();
+    }
+
+    void breakQueuedWalls() { mWorld.breakQueuedWalls(); }
+
+    /// @brief Wall AABBs (minX, minZ, maxX, maxZ) of generated chunk mazes, laid out like the raster maze
+    [[nodiscard]] std::vector<glm::vec4> wallBoxes(const std::vector<ChunkCoord> &coords) const
+    {
+        constexpr float kWallThickness = 0.3f;
+        constexpr float kHalfThickness = kWallThickness * 0.5f;
+        constexpr float cell = World::CELL_SIZE;
+
+        std::vector<glm::vec4> boxes;
+        for (const auto &coord : coords)
+        {
+            const ChunkMazeGrid grid = generate(coord);
+            for (int row = 0; row < World::MAZE_ROWS; ++row)
+            {
+                for (int col = 0; col < World::MAZE_COLS; ++col)
+                {
+                    const float x0 = coord.x * World::CHUNK_SIZE + col * cell;
+                    const float z0 = coord.z * World::CHUNK_SIZE + row * cell;
+                    if (grid.hasWall(row, col, ChunkMazeGrid::WALL_EAST))
+                    {
+                        boxes.emplace_back(x0 + cell - kHalfThickness, z0, x0 + cell + kHalfThickness, z0 + cell);
+                    }
+                    if (grid.hasWall(row, col, ChunkMazeGrid::WALL_SOUTH))
+                    {
+                        boxes.emplace_back(x0, z0 + cell - kHalfThickness, x0 + cell, z0 + cell + kHalfThickness);
+                    }
+                }
+            }
+        }
+        return boxes;
+    }
+
+    [[nodiscard]] static constexpr float cellSize() noexcept { return World::CELL_SIZE; }
+    [[nodiscard]] static constexpr std::size_t cellsPerChunk() noexcept { return World::MAZE_ROWS * World::MAZE_COLS; }
+
+private:
+    [[nodiscard]] bool hasPendingChunks() const
+    {
+        std::lock_guard<std::mutex> lock(mWorld.mCompletedChunksMutex);
+        return !mWorld.mPendingChunks.empty();
+    }
+
+    void waitForPendingChunks() const
+    {
+        std::lock_guard<std::mutex> lock(mWorld.mCompletedChunksMutex);
+        for (auto &[coord, pending] : mWorld.mPendingChunks)
+        {
+            if (pending.future.valid())
+            {
+                pending.future.wait();
+            }
+        }
+    }
+
+    World &mWorld;
+};
+
+void *operator new(std::size_t size)
+{
+    gAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *memory = std::malloc(size == 0 ? 1 : size))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace
+{
+    void runLevelBenchmarks(BenchRunner &runner)
+    {
+        // Maze sizes of the level data that seeds every chunk
+        for (const unsigned int size : {10u, 20u, 40u})
+        {
+            runner.run("Level::load " + std::to_string(size) + "x" + std::to_string(size), [size](Stopwatch &stopwatch)
+                       {
+                std::vector<mazes::configurator> configs;
+                configs.push_back(mazes::configurator().rows(size).columns(size).seed(kSeed));
+                constexpr std::size_t kLoads = 16;
+                Level level;
+                stopwatch.start();
+                for (std::size_t i = 0; i < kLoads; ++i)
+                {
+                    level.load(configs);
+                }
+                stopwatch.stop();
+                return Work{kLoads, kLoads * size * size}; });
+        }
+    }
+
+    void runChunkBenchmarks(BenchRunner &runner, WorldBench &bench)
+    {
+        constexpr int kGridRadius = 3;
+        const auto coords = WorldBench::square(kGridRadius);
+
+        runner.run("World::generateMazeForChunk", [&](Stopwatch &stopwatch)
+                   {
+            stopwatch.start();
+            for (const auto &coord : coords)
+            {
+                const auto grid = bench.generate(coord);
+                (void)grid;
+            }
+            stopwatch.stop();
+            return Work{coords.size(), coords.size() * WorldBench::cellsPerChunk()}; });
+
+        std::vector<WorldBench::ChunkMazeGrid> grids;
+        grids.reserve(coords.size());
+        for (const auto &coord : coords)
+        {
+            grids.push_back(bench.generate(coord));
+        }
+
+        runner.run("World::buildMazeWallSpheres", [&](Stopwatch &stopwatch)
+                   {
+            std::vector<Sphere> spheres;
+            std::size_t items = 0;
+            for (std::size_t i = 0; i < coords.size(); ++i)
+            {
+                spheres.clear();
+                stopwatch.start();
+                bench.buildWalls(grids[i], coords[i], spheres);
+                stopwatch.stop();
+                items += spheres.size();
+            }
+            return Work{coords.size(), items}; });
+
+        runner.run("World::buildPickupSpheres", [&](Stopwatch &stopwatch)
+                   {
+            std::vector<World::PickupSphere> pickups;
+            std::size_t items = 0;
+            for (std::size_t i = 0; i < coords.size(); ++i)
+            {
+                pickups.clear();
+                stopwatch.start();
+                bench.buildPickups(grids[i], coords[i], pickups);
+                stopwatch.stop();
+                items += pickups.size();
+            }
+            return Work{coords.size(), items}; });
+    }
+
+    void runStreamingBenchmarks(BenchRunner &runner, WorldBench &bench, World &world)
+    {
+        for (const int radius : {1, 2, 3})
+        {
+            const auto coords = WorldBench::square(radius);
+
+            runner.run(withRadius("World::processCompletedChunks", radius), [&](Stopwatch &stopwatch)
+                       {
+                const std::size_t loaded = bench.load(coords, &stopwatch);
+                const std::size_t walls = world.getSpheres().size();
+                bench.unloadAll(nullptr);
+                return Work{loaded, walls}; });
+
+            runner.run(withRadius("World::unloadChunk", radius), [&](Stopwatch &stopwatch)
+                       {
+                bench.load(coords, nullptr);
+                const std::size_t walls = world.getSpheres().size();
+                const std::size_t unloaded = bench.unloadAll(&stopwatch);
+                return Work{unloaded, walls}; });
+
+            runner.run(withRadius("World::breakQueuedWalls", radius), [&](Stopwatch &stopwatch)
+                       {
+                bench.load(coords, nullptr);
+                const std::size_t queued = bench.queueWallBreaks(64 * coords.size());
+                stopwatch.start();
+                bench.breakQueuedWalls();
+                stopwatch.stop();
+                bench.unloadAll(nullptr);
+                return Work{queued, queued}; });
+
+            runner.run(withRadius("World::collectNearbyPickups", radius), [&](Stopwatch &stopwatch)
+                       {
+                bench.load(coords, nullptr);
+                const auto &pickups = world.getPickupSpheres();
+                if (pickups.empty())
+                {
+                    bench.unloadAll(nullptr);
+                    return Work{};
+                }
+
+                glm::vec2 boundsMin{pickups.front().position.x, pickups.front().position.z};
+                glm::vec2 boundsMax = boundsMin;
+                for (const auto &pickup : pickups)
+                {
+                    boundsMin = glm::min(boundsMin, glm::vec2(pickup.position.x, pickup.position.z));
+                    boundsMax = glm::max(boundsMax, glm::vec2(pickup.position.x, pickup.position.z));
+                }
+
+                constexpr std::size_t kQueries = 4096;
+                std::mt19937 rng{kSeed};
+                std::uniform_real_distribution<float> x{boundsMin.x, boundsMax.x};
+                std::uniform_real_distribution<float> z{boundsMin.y, boundsMax.y};
+                std::vector<glm::vec3> positions(kQueries);
+                for (auto &position : positions)
+                {
+                    position = glm::vec3(x(rng), 0.0f, z(rng));
+                }
+
+                std::size_t collected = 0;
+                stopwatch.start();
+                for (const auto &position : positions)
+                {
+                    collected += world.collectNearbyPickups(position) != 0 ? 1u : 0u;
+                }
+                stopwatch.stop();
+
+                bench.unloadAll(nullptr);
+                return Work{kQueries, collected}; });
+        }
+    }
+
+    void runCollisionBenchmarks(BenchRunner &runner, WorldBench &bench)
+    {
+        for (const int radius : {1, 2, 3})
+        {
+            const auto boxes = bench.wallBoxes(WorldBench::square(radius));
+            WallBroadphase broadphase;
+            broadphase.build(boxes, WorldBench::cellSize());
+
+            glm::vec2 boundsMin{boxes.front().x, boxes.front().y};
+            glm::vec2 boundsMax{boxes.front().z, boxes.front().w};
+            for (const auto &box : boxes)
+            {
+                boundsMin = glm::min(boundsMin, glm::vec2(box.x, box.y));
+                boundsMax = glm::max(boundsMax, glm::vec2(box.z, box.w));
+            }
+
+            // Same radius and pass count as GameState::resolvePlayerWallCollisions
+            runner.run(withRadius("resolvePlayerWallCollisions", radius), [&](Stopwatch &stopwatch)
+                       {
+                constexpr std::size_t kQueries = 16384;
+                constexpr float kPlayerRadius = 0.42f;
+                constexpr int kIterations = 6;
+
+                std::mt19937 rng{kSeed};
+                std::uniform_real_distribution<float> x{boundsMin.x, boundsMax.x};
+                std::uniform_real_distribution<float> z{boundsMin.y, boundsMax.y};
+                std::vector<glm::vec3> positions(kQueries);
+                for (auto &position : positions)
+                {
+                    position = glm::vec3(x(rng), 0.0f, z(rng));
+                }
+
+                WallBroadphase::ResolveScratch scratch;
+                stopwatch.start();
+                for (auto &position : positions)
+                {
+                    broadphase.resolveCircle(position, kPlayerRadius, kIterations, scratch);
+                }
+                stopwatch.stop();
+                return Work{kQueries, kQueries}; });
+        }
+    }
+
+    void runAnimationBenchmarks(BenchRunner &runner, const std::string &modelPath)
+    {
+        GLTFModel model;
+        if (!model.importFile(modelPath))
+        {
+            std::printf("%-44s %12s (%s)\n", "GLTFModel bone transforms", "skipped", modelPath.c_str());
+            return;
+        }
+
+        // A null compute shader evaluates the pose and bone palette on the CPU and stops before any GL call
+        runner.run("GLTFModel bone transforms", [&](Stopwatch &stopwatch)
+                   {
+            constexpr std::size_t kPoses = 1024;
+            constexpr float kFrameTime = 1.0f / 60.0f;
+            stopwatch.start();
+            for (std::size_t i = 0; i < kPoses; ++i)
+            {
+                model.updateSkinning(nullptr, static_cast<float>(i) * kFrameTime);
+            }
+            stopwatch.stop();
+            return Work{kPoses, kPoses * std::max<std::size_t>(model.getBoneCount(), 1)}; });
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const std::string filter = argc > 1 ? argv[1] : "";
+    const std::string modelPath = argc > 2 ? argv[2] : std::string(kDefaultModel);
+
+    // Only events and timers: no video subsystem, so no window or GL context is ever created
+    if (!SDL_Init(SDL_INIT_EVENTS))
+    {
+        std::cerr << "SDL_Init failed: " << SDL_GetError() << std::endl;
+
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        // World keeps references to the render-side managers but only touches them from rendering paths
+        RenderWindow window{nullptr};
+        FontManager fonts;
+        TextureManager textures;
+        ShaderManager shaders;
+        LevelsManager levels;
+
+        // Same level as LoadingState so chunk seeds match the game
+        std::vector<mazes::configurator> levelConfigs;
+        levelConfigs.push_back(mazes::configurator().rows(20).columns(20));
+        levels.load(Levels::ID::LEVEL_ONE, std::cref(levelConfigs), false);
+
+        World world{window, fonts, textures, shaders, levels};
+        world.init();
+
+        SDL_Log("breakingwalls_bench: %d repetitions (median shown), %u job workers", kRepetitions,
+                JobSystem::instance()->getWorkerCount());
+
+        BenchRunner runner{filter};
+        WorldBench bench{world};
+
+        runLevelBenchmarks(runner);
+        runChunkBenchmarks(runner, bench);
+        runStreamingBenchmarks(runner, bench, world);
+        runCollisionBenchmarks(runner, bench);
+        runAnimationBenchmarks(runner, modelPath);
+
+        world.destroyWorld();
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        SDL_Quit();
+
+        return EXIT_FAILURE;
+    }
+
+    SDL_Quit();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,109 @@
+#include "BillboardBatch.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+#include "GLStateCache.hpp"
+#include "Shader.hpp"
+
+void BillboardBatch::add(const Key &key, const BillboardInstance &instance)
+{
+    if (key.texture == 0)
+    {
+        return;
+    }
+
+    // A handful of groups per frame, so a linear search beats hashing
+    auto it = std::find(mGroups.begin(), mGroups.end(), key);
+    if (it == mGroups.end())
+    {
+        mGroups.push_back(key);
+        it = std::prev(mGroups.end());
+    }
+
+    mEntries.push_back({static_cast<std::uint32_t>(std::distance(mGroups.begin(), it)), 0.0f, instance});
+}
+
+void BillboardBatch::flush(Shader &billboardShader, const glm::mat4 &view)
+{
+    mLastDrawCalls = 0;
+    mLastInstanceCount = mEntries.size();
+
+    if (mEntries.empty())
+    {
+        clear();
+        return;
+    }
+
+    const bool oitPass = GLSDLHelper::isBillboardOITPass();
+
+    if (oitPass)
+    {
+        // Weighted blended OIT is order-independent: only group by draw state
+        std::stable_sort(mEntries.begin(), mEntries.end(),
+                         [](const Entry &a, const Entry &b)
+                         { return a.group < b.group; });
+    }
+    else
+    {
+        // View space looks down -Z, so smaller z is farther away
+        mGroupDepth.assign(mGroups.size(), std::numeric_limits<float>::max());
+        for (auto &entry : mEntries)
+        {
+            entry.viewDepth = (view * glm::vec4(entry.instance.center, 1.0f)).z;
+            mGroupDepth[entry.group] = std::min(mGroupDepth[entry.group], entry.viewDepth);
+        }
+
+        std::sort(mEntries.begin(), mEntries.end(),
+                  [this](const Entry &a, const Entry &b)
+                  {
+                      if (a.group != b.group)
+                      {
+                          const float da = mGroupDepth[a.group];
+                          const float db = mGroupDepth[b.group];
+                          return (da != db) ? da < db : a.group < b.group;
+                      }
+                      return a.viewDepth < b.viewDepth;
+                  });
+    }
+
+    const GLStateCache::Snapshot savedState = GLStateCache::save();
+    GLStateCache::enable(GL_BLEND);
+    GLStateCache::disable(GL_CULL_FACE);
+    GLStateCache::enable(GL_DEPTH_TEST);
+    GLStateCache::depthFunc(GL_LESS);
+
+    std::size_t runStart = 0;
+    while (runStart < mEntries.size())
+    {
+        const std::uint32_t group = mEntries[runStart].group;
+        std::size_t runEnd = runStart;
+        mScratch.clear();
+        while (runEnd < mEntries.size() && mEntries[runEnd].group == group)
+        {
+            mScratch.push_back(mEntries[runEnd].instance);
+            ++runEnd;
+        }
+
+        const Key &key = mGroups[group];
+        if (!oitPass)
+        {
+            GLStateCache::blendFunc(GL_SRC_ALPHA, key.blend == BlendMode::ADDITIVE ? GL_ONE : GL_ONE_MINUS_SRC_ALPHA);
+        }
+
+        GLSDLHelper::renderBillboardInstances(billboardShader, key.texture, mScratch.data(), mScratch.size(),
+                                              key.flipX, key.flipY, key.useRedAsAlpha, key.doubleSided);
+        ++mLastDrawCalls;
+        runStart = runEnd;
+    }
+
+    GLStateCache::restore(savedState);
+    clear();
+}
+
+void BillboardBatch::clear() noexcept
+{
+    mGroups.clear();
+    mEntries.clear();
+}
@@ -0,0 +1,68 @@
+#ifndef BILLBOARD_BATCH_HPP
+#define BILLBOARD_BATCH_HPP
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "GLSDLHelper.hpp"
+
+class Shader;
+
+/// @brief Collects billboard sprites for a frame and draws them with one instanced call per texture/state
+/// @details Outside the OIT pass, sprites are sorted back-to-front within each group and groups are
+/// ordered by their farthest sprite, which keeps alpha edges correct for the common single-texture case.
+class BillboardBatch
+{
+public:
+    enum class BlendMode : std::uint8_t
+    {
+        ALPHA,
+        ADDITIVE
+    };
+
+    /// Everything that forces a separate draw call
+    struct Key
+    {
+        GLuint texture{0};
+        BlendMode blend{BlendMode::ALPHA};
+        bool flipX{false};
+        bool flipY{false};
+        bool useRedAsAlpha{false};
+        bool doubleSided{false};
+
+        [[nodiscard]] bool operator==(const Key &) const noexcept = default;
+    };
+
+    void add(const Key &key, const BillboardInstance &instance);
+
+    /// Draw and clear everything added since the last flush
+    void flush(Shader &billboardShader, const glm::mat4 &view);
+
+    void clear() noexcept;
+
+    [[nodiscard]] bool empty() const noexcept { return mEntries.empty(); }
+    [[nodiscard]] std::size_t getLastDrawCalls() const noexcept { return mLastDrawCalls; }
+    [[nodiscard]] std::size_t getLastInstanceCount() const noexcept { return mLastInstanceCount; }
+
+private:
+    struct Entry
+    {
+        std::uint32_t group{0};
+        float viewDepth{0.0f};
+        BillboardInstance instance;
+    };
+
+    std::vector<Key> mGroups;
+    std::vector<Entry> mEntries;
+    std::vector<float> mGroupDepth;
+    std::vector<BillboardInstance> mScratch;
+
+    std::size_t mLastDrawCalls{0};
+    std::size_t mLastInstanceCount{0};
+};
+
+#endif // BILLBOARD_BATCH_HPP
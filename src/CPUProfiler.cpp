@@ -0,0 +1,171 @@
+#include "CPUProfiler.hpp"
+
+#if defined(BREAKING_WALLS_PROFILE)
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <SDL3/SDL.h>
+
+namespace
+{
+    struct ZoneEvent
+    {
+        const char *name;
+        std::uint64_t startNs;
+        /// For a counter sample, the bits of its double value
+        std::uint64_t endNs;
+        bool counter;
+    };
+
+    /// @brief Single-writer ring; the owning thread publishes each event with one release store
+    struct ThreadRing
+    {
+        std::array<ZoneEvent, CPUProfiler::RING_CAPACITY> events{};
+        std::atomic<std::uint64_t> head{0};
+        std::atomic<const char *> name{nullptr};
+        std::uint32_t threadIndex{0};
+    };
+
+    // Rings are never freed so a dump can read threads that already exited
+    std::mutex sRingsMutex;
+    std::vector<std::unique_ptr<ThreadRing>> sRings;
+    const std::uint64_t sEpochNs = CPUProfiler::now();
+
+    ThreadRing &localRing() noexcept
+    {
+        thread_local ThreadRing *ring = nullptr;
+        if (!ring)
+        {
+            auto owned = std::make_unique<ThreadRing>();
+            std::lock_guard<std::mutex> lock(sRingsMutex);
+            owned->threadIndex = static_cast<std::uint32_t>(sRings.size());
+            ring = owned.get();
+            sRings.push_back(std::move(owned));
+        }
+        return *ring;
+    }
+
+    void writeEscaped(std::FILE *file, const char *text) noexcept
+    {
+        for (const char *c = text; *c != '\0'; ++c)
+        {
+            if (*c == '"' || *c == '\\')
+            {
+                std::fputc('\\', file);
+            }
+            std::fputc(*c, file);
+        }
+    }
+} // namespace
+
+void CPUProfiler::record(const char *name, std::uint64_t startNs, std::uint64_t endNs, bool isCounter) noexcept
+{
+    ThreadRing &ring = localRing();
+    const std::uint64_t head = ring.head.load(std::memory_order_relaxed);
+    ring.events[head % RING_CAPACITY] = {name, startNs, endNs, isCounter};
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+void CPUProfiler::counter(const char *name, double value) noexcept
+{
+    record(name, now(), std::bit_cast<std::uint64_t>(value), true);
+}
+
+void CPUProfiler::setThreadName(const char *name) noexcept
+{
+    localRing().name.store(name, std::memory_order_release);
+}
+
+bool CPUProfiler::dumpChromeTrace(const std::string &path) noexcept
+{
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    if (!file)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "CPUProfiler: Cannot open %s for writing", path.c_str());
+        return false;
+    }
+
+    std::vector<ThreadRing *> rings;
+    {
+        std::lock_guard<std::mutex> lock(sRingsMutex);
+        rings.reserve(sRings.size());
+        for (const auto &ring : sRings)
+        {
+            rings.push_back(ring.get());
+        }
+    }
+
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+    bool first = true;
+    std::size_t written = 0;
+    std::vector<ZoneEvent> copy;
+    copy.reserve(RING_CAPACITY);
+
+    for (ThreadRing *ring : rings)
+    {
+        const char *threadName = ring->name.load(std::memory_order_acquire);
+        std::fprintf(file, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"",
+                     first ? "" : ",\n", ring->threadIndex);
+        if (threadName)
+        {
+            writeEscaped(file, threadName);
+        }
+        else
+        {
+            std::fprintf(file, "thread %u", ring->threadIndex);
+        }
+        std::fputs("\"}}", file);
+        first = false;
+
+        // Copy without stopping the writer, then drop whatever it may have overwritten meanwhile
+        const std::uint64_t headBefore = ring->head.load(std::memory_order_acquire);
+        const std::uint64_t begin = (headBefore > RING_CAPACITY) ? headBefore - RING_CAPACITY : 0;
+        copy.clear();
+        for (std::uint64_t i = begin; i < headBefore; ++i)
+        {
+            copy.push_back(ring->events[i % RING_CAPACITY]);
+        }
+        const std::uint64_t headAfter = ring->head.load(std::memory_order_acquire);
+        // Slot headAfter % RING_CAPACITY, the oldest one still in range, may be mid-write right now
+        const std::uint64_t safeBegin = (headAfter >= RING_CAPACITY) ? headAfter - RING_CAPACITY + 1 : 0;
+
+        for (std::uint64_t i = std::max(begin, safeBegin); i < headBefore; ++i)
+        {
+            const ZoneEvent &event = copy[static_cast<std::size_t>(i - begin)];
+            if (!event.name)
+            {
+                continue;
+            }
+            const double startUs = static_cast<double>(event.startNs - std::min(event.startNs, sEpochNs)) * 1e-3;
+            if (event.counter)
+            {
+                // Counter tracks are per process, so samples from any thread land on the same plot
+                std::fputs(",\n{\"ph\":\"C\",\"name\":\"", file);
+                writeEscaped(file, event.name);
+                std::fprintf(file, "\",\"pid\":1,\"ts\":%.3f,\"args\":{\"value\":%.3f}}",
+                             startUs, std::bit_cast<double>(event.endNs));
+                ++written;
+                continue;
+            }
+            const double durationUs = static_cast<double>(event.endNs - event.startNs) * 1e-3;
+            std::fputs(",\n{\"ph\":\"X\",\"name\":\"", file);
+            writeEscaped(file, event.name);
+            std::fprintf(file, "\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                         ring->threadIndex, startUs, durationUs);
+            ++written;
+        }
+    }
+
+    std::fputs("\n]}\n", file);
+    const bool ok = std::fclose(file) == 0;
+    SDL_Log("CPUProfiler: Wrote %zu events from %zu threads to %s", written, rings.size(), path.c_str());
+    return ok;
+}
+
+#endif // BREAKING_WALLS_PROFILE
@@ -0,0 +1,84 @@
+#ifndef CPU_PROFILER_HPP
+#define CPU_PROFILER_HPP
+
+/// @file CPUProfiler.hpp
+/// @brief Scoped CPU timing zones recorded into per-thread rings and exported as Chrome trace JSON
+/// @details Configure with -DBREAKING_WALLS_PROFILE=ON to compile zones in. Without it
+/// BW_PROFILE_ZONE expands to nothing and no profiler code is built.
+///
+/// Each thread appends to its own fixed ring with a single atomic store per zone, so recording
+/// never locks. dumpChromeTrace() reads every ring (from any thread) and writes a file that
+/// chrome://tracing and ui.perfetto.dev open directly. Old zones are overwritten once a ring fills.
+/// Counter samples (BW_PROFILE_COUNTER) share the rings and show up as plotted tracks.
+
+#if defined(BREAKING_WALLS_PROFILE)
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#define BW_PROFILE_CONCAT_INNER(a, b) a##b
+#define BW_PROFILE_CONCAT(a, b) BW_PROFILE_CONCAT_INNER(a, b)
+
+/// Time the rest of the enclosing scope; name must be a string literal
+#define BW_PROFILE_ZONE(name) const CPUProfiler::Zone BW_PROFILE_CONCAT(bwProfileZone, __LINE__){name}
+/// Label the calling thread in exported traces; name must outlive the program (a literal)
+#define BW_PROFILE_THREAD(name) CPUProfiler::setThreadName(name)
+/// Sample a value plotted as a counter track; name must be a string literal
+#define BW_PROFILE_COUNTER(name, value) CPUProfiler::counter(name, static_cast<double>(value))
+
+class CPUProfiler
+{
+public:
+    /// Zones kept per thread before the oldest are overwritten (~2 s of a busy 60 Hz frame)
+    static constexpr std::size_t RING_CAPACITY = 1u << 15;
+
+    class Zone
+    {
+    public:
+        explicit Zone(const char *name) noexcept
+            : mName{name}, mStart{now()}
+        {
+        }
+
+        ~Zone() noexcept { record(mName, mStart, now()); }
+
+        Zone(const Zone &) = delete;
+        Zone &operator=(const Zone &) = delete;
+
+    private:
+        const char *mName;
+        std::uint64_t mStart;
+    };
+
+    static void setThreadName(const char *name) noexcept;
+
+    /// Record one counter sample, exported as a Chrome trace "C" event
+    static void counter(const char *name, double value) noexcept;
+
+    /// @brief Write every recorded zone as Chrome trace event JSON
+    /// @return true when the file was written
+    static bool dumpChromeTrace(const std::string &path) noexcept;
+
+    [[nodiscard]] static std::uint64_t now() noexcept
+    {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                              std::chrono::steady_clock::now().time_since_epoch())
+                                              .count());
+    }
+
+private:
+    static void record(const char *name, std::uint64_t startNs, std::uint64_t endNs, bool isCounter = false) noexcept;
+};
+
+#else
+
+#define BW_PROFILE_ZONE(name) ((void)0)
+#define BW_PROFILE_THREAD(name) ((void)0)
+#define BW_PROFILE_COUNTER(name, value) ((void)0)
+
+#endif // BREAKING_WALLS_PROFILE
+
+#endif // CPU_PROFILER_HPP
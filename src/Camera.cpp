@@ -4,6 +4,8 @@
 #include <glm/gtx/transform.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <cmath>
+
 const float Camera::scMaxYawValue = 119.0f;
 const float Camera::scMaxPitchValue = 89.0f;
 const float Camera::scMaxFieldOfView = 89.0f;
@@ -20,6 +22,7 @@ Camera::Camera(const glm::vec3 &position,
 void Camera::move(const glm::vec3 &velocity, float dt)
 {
     mPosition = mPosition + (velocity * dt);
+    mViewDirty = true;
 }
 
 void Camera::rotate(float yaw, float pitch, bool holdPitch, bool holdYaw)
@@ -46,18 +49,97 @@ void Camera::rotate(float yaw, float pitch, bool holdPitch, bool holdYaw)
     updateVectors();
 }
 
-glm::mat4 Camera::getLookAt() const
+const glm::mat4 &Camera::getLookAt() const
 {
-    if (mMode == CameraMode::THIRD_PERSON)
+    updateViewCache();
+    return mView;
+}
+
+const glm::mat4 &Camera::getPerspective(const float aspectRatio) const
+{
+    updateProjectionCache(aspectRatio);
+    return mProjection;
+}
+
+const glm::mat4 &Camera::getViewProjection(const float aspectRatio) const
+{
+    updateCombinedCache(aspectRatio);
+    return mViewProjection;
+}
+
+const glm::mat4 &Camera::getInverseViewProjection(const float aspectRatio) const
+{
+    updateCombinedCache(aspectRatio);
+    return mInverseViewProjection;
+}
+
+const Frustum &Camera::getFrustum(const float aspectRatio) const
+{
+    updateCombinedCache(aspectRatio);
+    return mFrustum;
+}
+
+std::uint64_t Camera::getViewVersion() const
+{
+    updateViewCache();
+    return mViewVersion;
+}
+
+std::uint64_t Camera::getProjectionVersion(const float aspectRatio) const
+{
+    updateProjectionCache(aspectRatio);
+    return mProjectionVersion;
+}
+
+void Camera::updateViewCache() const
+{
+    if (!mViewDirty)
     {
-        return getThirdPersonLookAt();
+        return;
+    }
+    mViewDirty = false;
+
+    const glm::mat4 view = (mMode == CameraMode::THIRD_PERSON)
+                               ? getThirdPersonLookAt()
+                               : glm::lookAt(mPosition, mPosition + mTarget, mUp);
+    if (mViewVersion == 0 || view != mView)
+    {
+        mView = view;
+        ++mViewVersion;
     }
-    return glm::lookAt(mPosition, mPosition + mTarget, mUp);
 }
 
-glm::mat4 Camera::getPerspective(const float aspectRatio) const
+void Camera::updateProjectionCache(float aspectRatio) const
 {
-    return glm::perspective(glm::radians(mFieldOfView), aspectRatio, mNear, mFar);
+    if (!mProjectionDirty && aspectRatio == mProjectionAspect)
+    {
+        return;
+    }
+    mProjectionDirty = false;
+    mProjectionAspect = aspectRatio;
+
+    const glm::mat4 projection = glm::perspective(glm::radians(mFieldOfView), aspectRatio, mNear, mFar);
+    if (mProjectionVersion == 0 || projection != mProjection)
+    {
+        mProjection = projection;
+        ++mProjectionVersion;
+    }
+}
+
+void Camera::updateCombinedCache(float aspectRatio) const
+{
+    updateViewCache();
+    updateProjectionCache(aspectRatio);
+    if (mCombinedViewVersion == mViewVersion && mCombinedProjectionVersion == mProjectionVersion)
+    {
+        return;
+    }
+    mCombinedViewVersion = mViewVersion;
+    mCombinedProjectionVersion = mProjectionVersion;
+
+    mViewProjection = mProjection * mView;
+    mInverseViewProjection = glm::inverse(mViewProjection);
+    mFrustum = Frustum(mViewProjection);
 }
 
 glm::mat4 Camera::getInfPerspective(const float aspectRatio) const
@@ -69,8 +151,7 @@ glm::vec3 Camera::getFrustumEyeRay(float ar, int x, int y) const
 {
     // Transform from NDC space to world space using inverse view-projection
     glm::vec3 actualPos = getActualPosition();
-    glm::mat4 invViewProj = glm::inverse(getPerspective(ar) * getLookAt());
-    glm::vec4 eyeVec = invViewProj * glm::vec4(static_cast<float>(x), static_cast<float>(y), 1.0f, 1.0f);
+    glm::vec4 eyeVec = getInverseViewProjection(ar) * glm::vec4(static_cast<float>(x), static_cast<float>(y), 1.0f, 1.0f);
     eyeVec /= eyeVec.w;
 
     // Return ray direction from camera position to the frustum corner point
@@ -87,6 +168,8 @@ void Camera::updateFieldOfView(float dy)
             mFieldOfView = 1.0f;
         else if (mFieldOfView >= scMaxFieldOfView)
             mFieldOfView = scMaxFieldOfView;
+
+        mProjectionDirty = true;
     }
 }
 
@@ -98,6 +181,7 @@ glm::vec3 Camera::getPosition() const
 void Camera::setPosition(const glm::vec3 &position)
 {
     mPosition = position;
+    mViewDirty = true;
 }
 
 glm::vec3 Camera::getTarget() const
@@ -108,6 +192,7 @@ glm::vec3 Camera::getTarget() const
 void Camera::setTarget(const glm::vec3 &target)
 {
     mTarget = target;
+    mViewDirty = true;
 }
 
 glm::vec3 Camera::getUp() const
@@ -130,6 +215,7 @@ void Camera::setUp(const glm::vec3 &up)
         if (glm::length(newRight) > 0.0001f)
             mRight = glm::normalize(newRight);
         // else keep the previous mRight (avoids zero vector at poles)
+        mViewDirty = true;
     }
 }
 
@@ -141,6 +227,7 @@ glm::vec3 Camera::getRight() const
 void Camera::setRight(const glm::vec3 &right)
 {
     mRight = right;
+    mViewDirty = true;
 }
 
 float Camera::getNear() const
@@ -151,6 +238,7 @@ float Camera::getNear() const
 void Camera::setNear(float near)
 {
     mNear = near;
+    mProjectionDirty = true;
 }
 
 float Camera::getFar() const
@@ -161,6 +249,7 @@ float Camera::getFar() const
 void Camera::setFar(float far)
 {
     mFar = far;
+    mProjectionDirty = true;
 }
 
 float Camera::getFieldOfView() const noexcept
@@ -171,6 +260,7 @@ float Camera::getFieldOfView() const noexcept
 void Camera::setFieldOfView(float fov) noexcept
 {
     mFieldOfView = glm::clamp(fov, 1.0f, scMaxFieldOfView);
+    mProjectionDirty = true;
 }
 
 float Camera::getYaw() const
@@ -207,6 +297,32 @@ void Camera::setYawPitch(float yaw, float pitch, bool clampPitch, bool wrapYaw)
     updateVectors();
 }
 
+void Camera::beginFixedStep() noexcept
+{
+    mStepStartPosition = mPosition;
+    mStepStartYaw = mYaw;
+    mStepStartPitch = mPitch;
+}
+
+Camera Camera::getInterpolated(float alpha) const
+{
+    Camera blended = *this;
+    if (alpha >= 1.0f)
+    {
+        return blended;
+    }
+
+    alpha = glm::clamp(alpha, 0.0f, 1.0f);
+
+    // Blend yaw along the short way round so a wrap at +/-max does not spin the view
+    const float yawDelta = std::remainder(mYaw - mStepStartYaw, 360.0f);
+    blended.mPosition = glm::mix(mStepStartPosition, mPosition, alpha);
+    blended.mYaw = mStepStartYaw + yawDelta * alpha;
+    blended.mPitch = glm::mix(mStepStartPitch, mPitch, alpha);
+    blended.updateVectors();
+    return blended;
+}
+
 void Camera::rotateAroundAxis(const glm::vec3 &axis, float degrees)
 {
     const float radians = glm::radians(degrees * sSensitivity);
@@ -231,6 +347,7 @@ void Camera::rotateAroundAxis(const glm::vec3 &axis, float degrees)
     }
     if (!mUseCustomUpVector)
         mUp = glm::normalize(glm::cross(mRight, mTarget));
+    mViewDirty = true;
 }
 
 void Camera::updateVectors()
@@ -253,6 +370,7 @@ void Camera::updateVectors()
     {
         mUp = glm::normalize(glm::cross(mRight, mTarget));
     }
+    mViewDirty = true;
 }
 
 // ============================================================================
@@ -292,6 +410,7 @@ void Camera::updateThirdPersonPosition()
     }
 
     mPosition = mFollowTarget - forwardFlat * mThirdPersonDistance + upAxis * mThirdPersonHeight;
+    mViewDirty = true;
 }
 
 glm::vec3 Camera::getActualPosition() const
@@ -1,10 +1,13 @@
 #ifndef CAMERA_HPP
 #define CAMERA_HPP
 
+#include <cstdint>
 #include <memory>
 
 #include <glm/glm.hpp>
 
+#include "Frustum.hpp"
+
 /// @brief Camera perspective mode (matches Options enum)
 enum class CameraMode : unsigned int
 {
@@ -15,6 +18,9 @@ enum class CameraMode : unsigned int
 /// @brief 3D camera with spherical coordinate system (yaw/pitch)
 /// @details Provides perspective matrix, look-at matrix, and frustum ray generation for raytracing
 /// Supports both first-person and third-person camera modes
+/// View and projection matrices, their product, its inverse and the frustum planes are cached: setters
+/// only mark them dirty and they are rebuilt once on the next read. The version counters advance only
+/// when a rebuilt matrix actually differs, so consumers can compare versions to skip derived work.
 class Camera
 {
 public:
@@ -36,11 +42,26 @@ public:
     /// Also syncs mYaw/mPitch so subsequent updateVectors() calls remain consistent.
     void rotateAroundAxis(const glm::vec3 &axis, float degrees);
 
-    /// Get the look-at matrix
-    [[nodiscard]] glm::mat4 getLookAt() const;
+    /// Get the look-at matrix (cached until the pose changes)
+    [[nodiscard]] const glm::mat4 &getLookAt() const;
+
+    /// Get the perspective projection matrix (cached for the last aspect ratio)
+    [[nodiscard]] const glm::mat4 &getPerspective(const float aspectRatio) const;
+
+    /// Projection * view for the given aspect ratio
+    [[nodiscard]] const glm::mat4 &getViewProjection(const float aspectRatio) const;
+
+    /// Inverse of getViewProjection(), maps NDC back to world space
+    [[nodiscard]] const glm::mat4 &getInverseViewProjection(const float aspectRatio) const;
+
+    /// Culling planes of getViewProjection()
+    [[nodiscard]] const Frustum &getFrustum(const float aspectRatio) const;
 
-    /// Get the perspective projection matrix
-    [[nodiscard]] glm::mat4 getPerspective(const float aspectRatio) const;
+    /// Advances whenever the cached view matrix changes
+    [[nodiscard]] std::uint64_t getViewVersion() const;
+
+    /// Advances whenever the cached projection matrix changes (including a new aspect ratio)
+    [[nodiscard]] std::uint64_t getProjectionVersion(const float aspectRatio) const;
 
     /// Get infinite perspective projection matrix
     [[nodiscard]] glm::mat4 getInfPerspective(const float aspectRatio) const;
@@ -79,30 +100,36 @@ public:
     /// Force camera yaw/pitch and refresh basis vectors
     void setYawPitch(float yaw, float pitch, bool clampPitch = true, bool wrapYaw = true);
 
+    /// Remember the pose at the start of a fixed simulation step for render interpolation
+    void beginFixedStep() noexcept;
+
+    /// Copy of this camera blended from the step-start pose (alpha 0) to the current one (alpha 1)
+    [[nodiscard]] Camera getInterpolated(float alpha) const;
+
     // ========================================================================
     // Third-person camera support
     // ========================================================================
 
     /// Set camera mode (first person or third person)
-    void setMode(CameraMode mode) noexcept { mMode = mode; }
+    void setMode(CameraMode mode) noexcept { mMode = mode; mViewDirty = true; }
 
     /// Get current camera mode
     [[nodiscard]] CameraMode getMode() const noexcept { return mMode; }
 
     /// Set the target position to follow (for third person)
-    void setFollowTarget(const glm::vec3 &targetPos) noexcept { mFollowTarget = targetPos; }
+    void setFollowTarget(const glm::vec3 &targetPos) noexcept { mFollowTarget = targetPos; mViewDirty = true; }
 
     /// Get the follow target position
     [[nodiscard]] glm::vec3 getFollowTarget() const noexcept { return mFollowTarget; }
 
     /// Set third person camera distance
-    void setThirdPersonDistance(float distance) noexcept { mThirdPersonDistance = distance; }
+    void setThirdPersonDistance(float distance) noexcept { mThirdPersonDistance = distance; mViewDirty = true; }
 
     /// Get third person camera distance
     [[nodiscard]] float getThirdPersonDistance() const noexcept { return mThirdPersonDistance; }
 
     /// Set third person camera height offset
-    void setThirdPersonHeight(float height) noexcept { mThirdPersonHeight = height; }
+    void setThirdPersonHeight(float height) noexcept { mThirdPersonHeight = height; mViewDirty = true; }
 
     /// Get third person camera height offset
     [[nodiscard]] float getThirdPersonHeight() const noexcept { return mThirdPersonHeight; }
@@ -139,9 +166,32 @@ private:
     float mThirdPersonDistance{20.0f}; ///< Distance behind target
     float mThirdPersonHeight{15.0f};    ///< Height above target
 
+    // Pose at the start of the current fixed step
+    glm::vec3 mStepStartPosition{0.0f};
+    float mStepStartYaw{0.0f};
+    float mStepStartPitch{0.0f};
+
+    // Derived matrices, rebuilt lazily by the const getters
+    mutable glm::mat4 mView{1.0f};
+    mutable glm::mat4 mProjection{1.0f};
+    mutable glm::mat4 mViewProjection{1.0f};
+    mutable glm::mat4 mInverseViewProjection{1.0f};
+    mutable Frustum mFrustum;
+    mutable float mProjectionAspect{0.0f};
+    mutable std::uint64_t mViewVersion{0};
+    mutable std::uint64_t mProjectionVersion{0};
+    mutable std::uint64_t mCombinedViewVersion{0};
+    mutable std::uint64_t mCombinedProjectionVersion{0};
+    mutable bool mViewDirty{true};
+    mutable bool mProjectionDirty{true};
+
 private:
     /// Update target, right, and up vectors based on yaw/pitch Euler angles
     void updateVectors();
+
+    void updateViewCache() const;
+    void updateProjectionCache(float aspectRatio) const;
+    void updateCombinedCache(float aspectRatio) const;
 };
 
 #endif // CAMERA_HPP
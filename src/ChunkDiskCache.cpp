@@ -0,0 +1,439 @@
+#include "ChunkDiskCache.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+ChunkDiskCache::~ChunkDiskCache()
+{
+    close();
+}
+
+bool ChunkDiskCache::open(const std::string &path, std::uint32_t payloadVersion, std::uint64_t contentHash) noexcept
+{
+    close();
+
+    mPath = path;
+    mPayloadVersion = payloadVersion;
+    mContentHash = contentHash;
+
+    std::error_code ec;
+    if (!std::filesystem::exists(mPath, ec))
+    {
+        SDL_Log("ChunkDiskCache: no cache at %s, starting empty", mPath.c_str());
+        return true;
+    }
+
+    if (!mapFile())
+    {
+        return true;
+    }
+
+    if (mMappedSize < sizeof(Header))
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "ChunkDiskCache: %s is truncated, ignoring", mPath.c_str());
+        unmapFile();
+        return true;
+    }
+
+    Header header{};
+    std::memcpy(&header, mMappedData, sizeof(Header));
+
+    if (header.magic != MAGIC || header.containerVersion != CONTAINER_VERSION ||
+        header.payloadVersion != mPayloadVersion || header.contentHash != mContentHash)
+    {
+        SDL_Log("ChunkDiskCache: %s is stale (version or level hash changed), regenerating", mPath.c_str());
+        unmapFile();
+        return true;
+    }
+
+    const std::size_t indexBytes = static_cast<std::size_t>(header.entryCount) * sizeof(IndexEntry);
+    if (mMappedSize < sizeof(Header) + indexBytes)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "ChunkDiskCache: %s index is truncated, ignoring", mPath.c_str());
+        unmapFile();
+        return true;
+    }
+
+    mIndex.reserve(header.entryCount);
+    const std::uint8_t *indexBase = mMappedData + sizeof(Header);
+    for (std::uint32_t i = 0; i < header.entryCount; ++i)
+    {
+        IndexEntry entry{};
+        std::memcpy(&entry, indexBase + i * sizeof(IndexEntry), sizeof(IndexEntry));
+
+        if (entry.offset > mMappedSize || entry.size > mMappedSize - entry.offset)
+        {
+            continue;
+        }
+
+        mIndex.emplace(packKey(entry.x, entry.z),
+                       std::span<const std::uint8_t>(mMappedData + entry.offset, static_cast<std::size_t>(entry.size)));
+    }
+
+    SDL_Log("ChunkDiskCache: mapped %zu chunks from %s", mIndex.size(), mPath.c_str());
+    return true;
+}
+
+std::span<const std::uint8_t> ChunkDiskCache::find(int x, int z) const noexcept
+{
+    if (auto it = mIndex.find(packKey(x, z)); it != mIndex.end())
+    {
+        return it->second;
+    }
+    return {};
+}
+
+void ChunkDiskCache::store(int x, int z, std::vector<std::uint8_t> blob) noexcept
+{
+    if (!isOpen() || blob.empty())
+    {
+        return;
+    }
+
+    const std::uint64_t key = packKey(x, z);
+    if (mIndex.find(key) != mIndex.end())
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mPendingMutex);
+    if (mSpilled.find(key) != mSpilled.end())
+    {
+        return;
+    }
+
+    auto &pending = mPending[key];
+    mPendingBytes = mPendingBytes - pending.size() + blob.size();
+    pending = std::move(blob);
+    if (mPendingBytes > MAX_PENDING_BYTES)
+    {
+        spillPending();
+    }
+}
+
+void ChunkDiskCache::spillPending() noexcept
+{
+    const std::string spillPath = mPath + ".spill";
+    try
+    {
+        if (!mSpill.is_open())
+        {
+            std::error_code ec;
+            std::filesystem::create_directories(std::filesystem::path(mPath).parent_path(), ec);
+            // Offsets in mSpilled stay valid only while the file is appended to
+            mSpill.open(spillPath, std::ios::binary | (mSpilled.empty() ? std::ios::trunc : std::ios::app));
+            if (mSpilled.empty())
+            {
+                mSpillSize = 0;
+            }
+        }
+
+        for (const auto &[key, bytes] : mPending)
+        {
+            mSpill.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            if (!mSpill)
+            {
+                break;
+            }
+            mSpilled[key] = SpillEntry{mSpillSize, bytes.size()};
+            mSpillSize += bytes.size();
+        }
+    }
+    catch (const std::exception &e)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "ChunkDiskCache: spill failed: %s", e.what());
+    }
+
+    // Dropped rather than kept when the spill fails: the cache is only an optimisation and memory stays bounded
+    if (!mSpill)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "ChunkDiskCache: cannot write %s, dropping new chunks",
+                    spillPath.c_str());
+    }
+    mPending.clear();
+    mPendingBytes = 0;
+}
+
+void ChunkDiskCache::removeSpill() noexcept
+{
+    const bool spilled = mSpill.is_open() || !mSpilled.empty();
+    if (mSpill.is_open())
+    {
+        mSpill.close();
+    }
+    mSpill.clear();
+    if (spilled)
+    {
+        std::error_code ec;
+        std::filesystem::remove(mPath + ".spill", ec);
+    }
+    mSpilled.clear();
+    mSpillSize = 0;
+}
+
+bool ChunkDiskCache::flush() noexcept
+{
+    if (!isOpen())
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mPendingMutex);
+    if (mPending.empty() && mSpilled.empty())
+    {
+        return true;
+    }
+
+    // Spilled blobs are copied from the spill file rather than read back into memory
+    struct Blob
+    {
+        std::uint64_t key;
+        std::span<const std::uint8_t> bytes;
+        const SpillEntry *spill{nullptr};
+
+        [[nodiscard]] std::uint64_t size() const noexcept { return spill ? spill->size : bytes.size(); }
+    };
+
+    std::vector<Blob> blobs;
+    blobs.reserve(mIndex.size() + mSpilled.size() + mPending.size());
+    for (const auto &[key, bytes] : mIndex)
+    {
+        blobs.push_back(Blob{key, bytes});
+    }
+    for (const auto &[key, entry] : mSpilled)
+    {
+        blobs.push_back(Blob{key, {}, &entry});
+    }
+    for (const auto &[key, bytes] : mPending)
+    {
+        blobs.push_back(Blob{key, std::span<const std::uint8_t>(bytes.data(), bytes.size())});
+    }
+
+    const std::string tempPath = mPath + ".tmp";
+
+    try
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(std::filesystem::path(mPath).parent_path(), ec);
+
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "ChunkDiskCache: cannot write %s", tempPath.c_str());
+            return false;
+        }
+
+        const Header header{MAGIC, CONTAINER_VERSION, mPayloadVersion,
+                            static_cast<std::uint32_t>(blobs.size()), mContentHash};
+        out.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+
+        std::uint64_t offset = sizeof(Header) + blobs.size() * sizeof(IndexEntry);
+        for (const auto &blob : blobs)
+        {
+            const IndexEntry entry{static_cast<std::int32_t>(blob.key >> 32),
+                                   static_cast<std::int32_t>(blob.key & 0xFFFFFFFFull),
+                                   offset, blob.size()};
+            out.write(reinterpret_cast<const char *>(&entry), sizeof(IndexEntry));
+            offset += blob.size();
+        }
+
+        std::ifstream spillIn;
+        if (!mSpilled.empty())
+        {
+            mSpill.flush();
+            spillIn.open(mPath + ".spill", std::ios::binary);
+        }
+        std::vector<char> copyBuffer;
+        for (const auto &blob : blobs)
+        {
+            if (!blob.spill)
+            {
+                out.write(reinterpret_cast<const char *>(blob.bytes.data()), static_cast<std::streamsize>(blob.bytes.size()));
+                continue;
+            }
+
+            copyBuffer.resize(static_cast<std::size_t>(blob.spill->size));
+            spillIn.seekg(static_cast<std::streamoff>(blob.spill->offset));
+            spillIn.read(copyBuffer.data(), static_cast<std::streamsize>(copyBuffer.size()));
+            if (!spillIn)
+            {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "ChunkDiskCache: cannot read back %s.spill", mPath.c_str());
+                return false;
+            }
+            out.write(copyBuffer.data(), static_cast<std::streamsize>(copyBuffer.size()));
+        }
+
+        out.close();
+        if (!out)
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "ChunkDiskCache: short write to %s", tempPath.c_str());
+            return false;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "ChunkDiskCache: flush failed: %s", e.what());
+        return false;
+    }
+
+    // The blobs span the old mapping, so only release it once the temp file is complete
+    const std::size_t entryCount = blobs.size();
+    blobs.clear();
+    mIndex.clear();
+    unmapFile();
+    mPending.clear();
+    mPendingBytes = 0;
+    removeSpill();
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, mPath, ec);
+    if (ec)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "ChunkDiskCache: rename to %s failed: %s",
+                    mPath.c_str(), ec.message().c_str());
+        return false;
+    }
+
+    SDL_Log("ChunkDiskCache: wrote %zu chunks to %s", entryCount, mPath.c_str());
+    return true;
+}
+
+void ChunkDiskCache::close() noexcept
+{
+    mIndex.clear();
+    unmapFile();
+
+    std::lock_guard<std::mutex> lock(mPendingMutex);
+    mPending.clear();
+    mPendingBytes = 0;
+    removeSpill();
+    mPath.clear();
+}
+
+std::uint64_t ChunkDiskCache::packKey(int x, int z) noexcept
+{
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) |
+           static_cast<std::uint64_t>(static_cast<std::uint32_t>(z));
+}
+
+#if defined(_WIN32)
+
+bool ChunkDiskCache::mapFile() noexcept
+{
+    HANDLE file = CreateFileA(mPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    mFileHandle = file;
+    mMappingHandle = mapping;
+    mMappedData = static_cast<const std::uint8_t *>(view);
+    mMappedSize = static_cast<std::size_t>(size.QuadPart);
+    return true;
+}
+
+void ChunkDiskCache::unmapFile() noexcept
+{
+    if (mMappedData)
+    {
+        UnmapViewOfFile(mMappedData);
+        mMappedData = nullptr;
+    }
+    if (mMappingHandle)
+    {
+        CloseHandle(static_cast<HANDLE>(mMappingHandle));
+        mMappingHandle = nullptr;
+    }
+    if (mFileHandle)
+    {
+        CloseHandle(static_cast<HANDLE>(mFileHandle));
+        mFileHandle = nullptr;
+    }
+    mMappedSize = 0;
+}
+
+#else
+
+bool ChunkDiskCache::mapFile() noexcept
+{
+    const int fd = ::open(mPath.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || info.st_size <= 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void *view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (view == MAP_FAILED)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    mFileDescriptor = fd;
+    mMappedData = static_cast<const std::uint8_t *>(view);
+    mMappedSize = static_cast<std::size_t>(info.st_size);
+    return true;
+}
+
+void ChunkDiskCache::unmapFile() noexcept
+{
+    if (mMappedData)
+    {
+        munmap(const_cast<std::uint8_t *>(mMappedData), mMappedSize);
+        mMappedData = nullptr;
+    }
+    if (mFileDescriptor >= 0)
+    {
+        ::close(mFileDescriptor);
+        mFileDescriptor = -1;
+    }
+    mMappedSize = 0;
+}
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef CHUNK_DISK_CACHE_HPP
+#define CHUNK_DISK_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// @brief Persistent store of generated chunk blobs, memory-mapped read-only at open
+/// @details File layout: Header, then entryCount IndexEntry records, then the blobs.
+/// The file is ignored when its magic, container version, payload version or content hash differ.
+/// Lookups only touch the immutable mapping and are safe from any thread.
+/// New blobs are kept in memory up to MAX_PENDING_BYTES, then appended to a spill file beside the cache;
+/// flush() merges the mapping, the spill file and what is still in memory into a fresh file.
+class ChunkDiskCache
+{
+public:
+    static constexpr std::uint32_t MAGIC = 0x43435742u; // "BWCC"
+    static constexpr std::uint32_t CONTAINER_VERSION = 1u;
+    /// New blobs held in memory before they are spilled to disk
+    static constexpr std::size_t MAX_PENDING_BYTES = 8u * 1024u * 1024u;
+
+    ChunkDiskCache() = default;
+    ~ChunkDiskCache();
+
+    ChunkDiskCache(const ChunkDiskCache &) = delete;
+    ChunkDiskCache &operator=(const ChunkDiskCache &) = delete;
+
+    /// @brief Map an existing cache file, or start empty if it is missing or stale
+    /// @param payloadVersion Caller's serialization version
+    /// @param contentHash Hash of the inputs that determine chunk content (e.g. level data)
+    bool open(const std::string &path, std::uint32_t payloadVersion, std::uint64_t contentHash) noexcept;
+
+    /// @brief Zero-copy view of a mapped blob; empty if the chunk is not on disk
+    [[nodiscard]] std::span<const std::uint8_t> find(int x, int z) const noexcept;
+
+    /// @brief Queue a blob for the next flush(), spilling the queue to disk once it passes MAX_PENDING_BYTES
+    void store(int x, int z, std::vector<std::uint8_t> blob) noexcept;
+
+    /// @brief Write mapped and newly stored blobs to disk through a temp file and rename
+    bool flush() noexcept;
+
+    void close() noexcept;
+
+    [[nodiscard]] bool isOpen() const noexcept { return !mPath.empty(); }
+    [[nodiscard]] std::size_t getMappedEntryCount() const noexcept { return mIndex.size(); }
+
+private:
+    struct Header
+    {
+        std::uint32_t magic;
+        std::uint32_t containerVersion;
+        std::uint32_t payloadVersion;
+        std::uint32_t entryCount;
+        std::uint64_t contentHash;
+    };
+
+    struct IndexEntry
+    {
+        std::int32_t x;
+        std::int32_t z;
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+
+    /// Where a spilled blob sits in the spill file
+    struct SpillEntry
+    {
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+
+    static std::uint64_t packKey(int x, int z) noexcept;
+
+    /// Append mPending to the spill file and empty it; mPendingMutex must be held
+    void spillPending() noexcept;
+    /// Delete the spill file and forget its entries; mPendingMutex must be held
+    void removeSpill() noexcept;
+
+    bool mapFile() noexcept;
+    void unmapFile() noexcept;
+
+    std::string mPath;
+    std::uint32_t mPayloadVersion{0};
+    std::uint64_t mContentHash{0};
+
+    const std::uint8_t *mMappedData{nullptr};
+    std::size_t mMappedSize{0};
+#if defined(_WIN32)
+    void *mFileHandle{nullptr};
+    void *mMappingHandle{nullptr};
+#else
+    int mFileDescriptor{-1};
+#endif
+
+    // Key is packKey(x, z); values point into the mapping
+    std::unordered_map<std::uint64_t, std::span<const std::uint8_t>> mIndex;
+
+    std::mutex mPendingMutex;
+    std::unordered_map<std::uint64_t, std::vector<std::uint8_t>> mPending;
+    std::size_t mPendingBytes{0};
+    std::ofstream mSpill;
+    std::uint64_t mSpillSize{0};
+    std::unordered_map<std::uint64_t, SpillEntry> mSpilled;
+};
+
+#endif // CHUNK_DISK_CACHE_HPP
@@ -0,0 +1,144 @@
+#include "ChunkGeometryPool.hpp"
+
+#include <SDL3/SDL.h>
+
+#include "RenderStats.hpp"
+
+void ChunkGeometryPool::init(GLuint instanceBuffer, GLuint indirectBuffer, std::size_t slotCount,
+                             std::size_t instancesPerSlot, std::size_t instanceStride) noexcept
+{
+    mInstanceBuffer = instanceBuffer;
+    mIndirectBuffer = indirectBuffer;
+    mInstancesPerSlot = instancesPerSlot;
+    mInstanceStride = instanceStride;
+
+    mSlots.assign(slotCount, Slot{});
+    mFreeSlots.clear();
+    for (std::size_t i = 0; i < slotCount; ++i)
+    {
+        mFreeSlots.push_back(static_cast<int>(i));
+    }
+    mCommands.clear();
+    mCommands.reserve(slotCount);
+    mCommandsDirty = true;
+
+    glBindBuffer(GL_ARRAY_BUFFER, mInstanceBuffer);
+    RenderStats::bufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(slotCount * instancesPerSlot * instanceStride),
+                            nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, mIndirectBuffer);
+    RenderStats::bufferData(GL_DRAW_INDIRECT_BUFFER, static_cast<GLsizeiptr>(slotCount * sizeof(DrawElementsIndirectCommand)),
+                            nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+    mGpuBytes.set(slotCount * (instancesPerSlot * instanceStride + sizeof(DrawElementsIndirectCommand)));
+}
+
+int ChunkGeometryPool::attach(const void *instances, std::size_t instanceCount) noexcept
+{
+    if (mFreeSlots.empty())
+    {
+        return INVALID_SLOT;
+    }
+
+    if (instanceCount > mInstancesPerSlot)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "ChunkGeometryPool: %zu instances truncated to slot size %zu",
+                    instanceCount, mInstancesPerSlot);
+        instanceCount = mInstancesPerSlot;
+    }
+
+    const int slot = mFreeSlots.front();
+    mFreeSlots.pop_front();
+
+    if (instanceCount > 0)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, mInstanceBuffer);
+        RenderStats::bufferSubData(GL_ARRAY_BUFFER,
+                                   static_cast<GLintptr>(static_cast<std::size_t>(slot) * mInstancesPerSlot * mInstanceStride),
+                                   static_cast<GLsizeiptr>(instanceCount * mInstanceStride),
+                                   instances);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    mSlots[static_cast<std::size_t>(slot)] = {static_cast<GLuint>(instanceCount), true};
+    mCommandsDirty = true;
+    return slot;
+}
+
+void ChunkGeometryPool::detach(int slot) noexcept
+{
+    if (slot < 0 || static_cast<std::size_t>(slot) >= mSlots.size() || !mSlots[static_cast<std::size_t>(slot)].resident)
+    {
+        return;
+    }
+
+    mSlots[static_cast<std::size_t>(slot)] = Slot{};
+    mFreeSlots.push_back(slot);
+    mCommandsDirty = true;
+}
+
+void ChunkGeometryPool::updateInstance(int slot, std::size_t instance, std::size_t byteOffset,
+                                       const void *data, std::size_t byteCount) noexcept
+{
+    if (slot < 0 || static_cast<std::size_t>(slot) >= mSlots.size() || !mSlots[static_cast<std::size_t>(slot)].resident ||
+        instance >= mSlots[static_cast<std::size_t>(slot)].instanceCount || byteOffset + byteCount > mInstanceStride)
+    {
+        return;
+    }
+
+    const std::size_t first = static_cast<std::size_t>(slot) * mInstancesPerSlot + instance;
+    glBindBuffer(GL_ARRAY_BUFFER, mInstanceBuffer);
+    RenderStats::bufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(first * mInstanceStride + byteOffset),
+                               static_cast<GLsizeiptr>(byteCount), data);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void ChunkGeometryPool::clear() noexcept
+{
+    for (std::size_t i = 0; i < mSlots.size(); ++i)
+    {
+        detach(static_cast<int>(i));
+    }
+}
+
+void ChunkGeometryPool::draw(GLsizei indexCount, GLenum indexType) noexcept
+{
+    // Commands only change when a chunk attaches or detaches
+    if (mCommandsDirty || indexCount != mCommandIndexCount)
+    {
+        mCommands.clear();
+        for (std::size_t i = 0; i < mSlots.size(); ++i)
+        {
+            const Slot &slot = mSlots[i];
+            if (!slot.resident || slot.instanceCount == 0)
+            {
+                continue;
+            }
+
+            mCommands.push_back({static_cast<GLuint>(indexCount), slot.instanceCount, 0u, 0,
+                                 static_cast<GLuint>(i * mInstancesPerSlot)});
+        }
+
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, mIndirectBuffer);
+        if (!mCommands.empty())
+        {
+            RenderStats::bufferSubData(GL_DRAW_INDIRECT_BUFFER, 0,
+                                       static_cast<GLsizeiptr>(mCommands.size() * sizeof(DrawElementsIndirectCommand)),
+                                       mCommands.data());
+        }
+        mCommandIndexCount = indexCount;
+        mCommandsDirty = false;
+    }
+    else
+    {
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, mIndirectBuffer);
+    }
+
+    if (!mCommands.empty())
+    {
+        RenderStats::multiDrawElementsIndirect(GL_TRIANGLES, indexType, nullptr, static_cast<GLsizei>(mCommands.size()), 0);
+    }
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
@@ -0,0 +1,78 @@
+#ifndef CHUNK_GEOMETRY_POOL_HPP
+#define CHUNK_GEOMETRY_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "MemoryStats.hpp"
+
+/// @brief Fixed-size slots of one GPU instance buffer that streamed chunks attach to and detach from
+/// @details The buffer is allocated once in init(); attaching a chunk only writes its slot. Freed slots
+/// go to the back of a ring, so a slot the GPU may still be reading is the last one to be overwritten.
+/// Every resident slot is drawn by a single glMultiDrawElementsIndirect call.
+class ChunkGeometryPool
+{
+public:
+    static constexpr int INVALID_SLOT = -1;
+
+    /// Layout fixed by GL for the indirect buffer
+    struct DrawElementsIndirectCommand
+    {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint firstIndex;
+        GLint baseVertex;
+        GLuint baseInstance;
+    };
+
+    /// @param instanceBuffer Buffer the instance attributes of the draw VAO point at
+    /// @param indirectBuffer Buffer holding the per-slot draw commands
+    void init(GLuint instanceBuffer, GLuint indirectBuffer, std::size_t slotCount,
+              std::size_t instancesPerSlot, std::size_t instanceStride) noexcept;
+
+    /// @brief Copy a chunk's instances into a free slot
+    /// @return Slot index, or INVALID_SLOT if every slot is taken
+    [[nodiscard]] int attach(const void *instances, std::size_t instanceCount) noexcept;
+    void detach(int slot) noexcept;
+    /// @brief Overwrite byteCount bytes at byteOffset inside one instance of a resident slot
+    /// @details The slot keeps its instance count and draw command, so a wall can be hidden through a flag
+    /// in its instance without re-uploading the chunk or rebuilding the indirect commands
+    void updateInstance(int slot, std::size_t instance, std::size_t byteOffset,
+                        const void *data, std::size_t byteCount) noexcept;
+    /// Drop all resident chunks; the buffers stay allocated
+    void clear() noexcept;
+
+    /// @brief Draw every resident slot with the bound VAO and element buffer
+    void draw(GLsizei indexCount, GLenum indexType) noexcept;
+
+    [[nodiscard]] bool isInitialized() const noexcept { return !mSlots.empty(); }
+    [[nodiscard]] std::size_t getSlotCount() const noexcept { return mSlots.size(); }
+    [[nodiscard]] std::size_t getResidentCount() const noexcept { return mSlots.size() - mFreeSlots.size(); }
+    [[nodiscard]] std::size_t getInstancesPerSlot() const noexcept { return mInstancesPerSlot; }
+
+private:
+    struct Slot
+    {
+        GLuint instanceCount{0};
+        bool resident{false};
+    };
+
+    GLuint mInstanceBuffer{0};
+    GLuint mIndirectBuffer{0};
+    /// Both buffers are sized once by init(); they belong to the VBO manager but are reported here
+    MemoryStats::Allocation mGpuBytes{MemoryStats::Category::GPU_VERTEX_BUFFERS};
+    std::size_t mInstancesPerSlot{0};
+    std::size_t mInstanceStride{0};
+
+    std::vector<Slot> mSlots;
+    std::deque<int> mFreeSlots;
+    std::vector<DrawElementsIndirectCommand> mCommands;
+    GLsizei mCommandIndexCount{0};
+    bool mCommandsDirty{true};
+};
+
+#endif // CHUNK_GEOMETRY_POOL_HPP
@@ -0,0 +1,80 @@
+#include "DynamicResolution.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void DynamicResolution::configure(const Settings &settings) noexcept
+{
+    mSettings = settings;
+    mSettings.minScale = std::max(mSettings.minScale, 0.1f);
+    mSettings.maxScale = std::max(mSettings.maxScale, mSettings.minScale);
+    mScale = clampScale(mScale);
+}
+
+void DynamicResolution::reset(float scale) noexcept
+{
+    mScale = clampScale(scale);
+    mSmoothedMs = 0.0f;
+    mHasSample = false;
+    mCooldown = mSettings.cooldownFrames;
+    mFramesUnderBudget = 0;
+}
+
+bool DynamicResolution::update(std::optional<float> gpuFrameMs) noexcept
+{
+    if (mCooldown > 0)
+    {
+        --mCooldown;
+        // Samples still describe the old size until the cooldown has passed
+        if (mCooldown > 0)
+        {
+            return false;
+        }
+        mHasSample = false;
+    }
+
+    if (!gpuFrameMs)
+    {
+        return false;
+    }
+
+    mSmoothedMs = mHasSample ? mSmoothedMs + (*gpuFrameMs - mSmoothedMs) * mSettings.smoothing : *gpuFrameMs;
+    mHasSample = true;
+
+    const float target = std::max(mSettings.targetMs, 0.1f);
+    float newScale = mScale;
+
+    if (mSmoothedMs > target * mSettings.shrinkThreshold)
+    {
+        mFramesUnderBudget = 0;
+        const float fit = mScale * std::sqrt(target / mSmoothedMs);
+        newScale = std::min(fit, mScale - mSettings.step);
+    }
+    else if (mSmoothedMs < target * mSettings.growThreshold)
+    {
+        if (++mFramesUnderBudget >= mSettings.cooldownFrames)
+        {
+            mFramesUnderBudget = 0;
+            newScale = mScale + mSettings.step;
+        }
+    }
+    else
+    {
+        mFramesUnderBudget = 0;
+    }
+
+    newScale = clampScale(newScale);
+    if (std::fabs(newScale - mScale) < 1e-4f)
+    {
+        return false;
+    }
+
+    mScale = newScale;
+    mCooldown = mSettings.cooldownFrames;
+    return true;
+}
+
+float DynamicResolution::clampScale(float scale) const noexcept
+{
+    return std::clamp(scale, mSettings.minScale, mSettings.maxScale);
+}
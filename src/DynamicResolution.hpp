@@ -0,0 +1,55 @@
+#ifndef DYNAMIC_RESOLUTION_HPP
+#define DYNAMIC_RESOLUTION_HPP
+
+#include <optional>
+
+/// @brief Picks the scene render scale from measured GPU frame time
+/// @details Fed one GPU frame time per rendered frame. A smoothed time above the budget drops the scale
+/// at once (pixel cost goes with scale squared, so the drop is sized by the square root of the overshoot);
+/// the scale only climbs back one step at a time after the time has stayed well under budget. Every change
+/// is followed by a cooldown so the timings of the new size are measured before the next decision.
+class DynamicResolution
+{
+public:
+    struct Settings
+    {
+        float minScale{0.5f};
+        float maxScale{1.0f};
+        /// GPU time the scene may take per frame
+        float targetMs{12.0f};
+        /// Grow only while the smoothed time is below this fraction of targetMs
+        float growThreshold{0.75f};
+        /// Shrink once the smoothed time is above this fraction of targetMs
+        float shrinkThreshold{1.0f};
+        float step{0.05f};
+        /// Frames to wait after a change; also how long the time must stay low before growing
+        int cooldownFrames{30};
+        /// Weight of the newest sample in the moving average
+        float smoothing{0.15f};
+    };
+
+    void configure(const Settings &settings) noexcept;
+
+    /// Jump to scale (clamped to the bounds) and forget the timing history
+    void reset(float scale) noexcept;
+
+    /// @brief Feed last frame's GPU time; frames without a sample only count down the cooldown
+    /// @return true when the scale changed
+    bool update(std::optional<float> gpuFrameMs) noexcept;
+
+    [[nodiscard]] float getScale() const noexcept { return mScale; }
+    [[nodiscard]] float getSmoothedMs() const noexcept { return mSmoothedMs; }
+    [[nodiscard]] const Settings &getSettings() const noexcept { return mSettings; }
+
+private:
+    [[nodiscard]] float clampScale(float scale) const noexcept;
+
+    Settings mSettings;
+    float mScale{1.0f};
+    float mSmoothedMs{0.0f};
+    bool mHasSample{false};
+    int mCooldown{0};
+    int mFramesUnderBudget{0};
+};
+
+#endif // DYNAMIC_RESOLUTION_HPP
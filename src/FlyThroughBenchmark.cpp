@@ -0,0 +1,419 @@
+#include "FlyThroughBenchmark.hpp"
+
+#include "buildinfo.h"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <functional>
+
+std::vector<FlyThroughBenchmark::Frame> FlyThroughBenchmark::sFrames;
+std::vector<float> FlyThroughBenchmark::sScales;
+std::string FlyThroughBenchmark::sReportBase;
+std::chrono::steady_clock::time_point FlyThroughBenchmark::sOrigin;
+std::chrono::steady_clock::time_point FlyThroughBenchmark::sFrameStart;
+std::size_t FlyThroughBenchmark::sScaleIndex = 0;
+std::size_t FlyThroughBenchmark::sSegment = 0;
+float FlyThroughBenchmark::sSegmentTime = 0.0f;
+float FlyThroughBenchmark::sPathParameter = 0.0f;
+float FlyThroughBenchmark::sBreakCredit = 0.0f;
+bool FlyThroughBenchmark::sOnPath = false;
+bool FlyThroughBenchmark::sAwaitingGpu = false;
+std::size_t FlyThroughBenchmark::sGpuMissed = 0;
+bool FlyThroughBenchmark::sRunning = false;
+bool FlyThroughBenchmark::sFinished = false;
+bool FlyThroughBenchmark::sResult = false;
+
+namespace
+{
+    /// One stretch of the path; zoom and speed are interpolated across it
+    struct Segment
+    {
+        const char *name;
+        float seconds;
+        float zoomFrom;
+        float zoomTo;
+        /// World units per second along the path
+        float speed;
+        float wallBreaksPerSecond;
+        /// Warmup frames are written to the CSV but left out of the percentiles
+        bool measured;
+    };
+
+    // Flown in order at every render scale. The warmup absorbs the scale change and shader first use
+    constexpr std::array<Segment, 6> kSegments{{
+        {"warmup", 2.0f, 1.0f, 1.0f, 6.0f, 0.0f, false},
+        {"zoom-far", 4.0f, 1.0f, 1.0f, 6.0f, 0.0f, true},
+        {"zoom-sweep", 4.0f, 1.0f, 0.0f, 6.0f, 0.0f, true},
+        {"zoom-near", 4.0f, 0.0f, 0.0f, 6.0f, 0.0f, true},
+        {"sprint", 8.0f, 0.35f, 0.35f, 24.0f, 0.0f, true},
+        {"wall-break", 6.0f, 0.5f, 0.5f, 12.0f, 6.0f, true},
+    }};
+
+    /// The path keeps this share of the maze half extents clear of the outer wall
+    constexpr float kPathExtent = 0.85f;
+
+    /// Lissajous figure over the maze, unit extents; crosses the centre and reaches every quadrant
+    glm::vec2 pathPoint(float u) noexcept
+    {
+        return {std::sin(3.0f * u), std::sin(2.0f * u + 0.785398f)};
+    }
+
+    glm::vec2 pathTangent(float u) noexcept
+    {
+        return {3.0f * std::cos(3.0f * u), 2.0f * std::cos(2.0f * u + 0.785398f)};
+    }
+
+    double toMilliseconds(std::chrono::steady_clock::duration duration) noexcept
+    {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    struct Percentiles
+    {
+        std::size_t samples{0};
+        float p50{0.0f};
+        float p95{0.0f};
+        float p99{0.0f};
+        float max{0.0f};
+    };
+
+    /// Nearest-rank percentiles; values is sorted in place
+    Percentiles percentiles(std::vector<float> &values)
+    {
+        Percentiles result;
+        result.samples = values.size();
+        if (values.empty())
+        {
+            return result;
+        }
+
+        std::ranges::sort(values);
+        const auto rank = [&values](double p)
+        {
+            const auto index = static_cast<std::size_t>(std::ceil(p * static_cast<double>(values.size())));
+            return values[std::clamp<std::size_t>(index, 1, values.size()) - 1];
+        };
+        result.p50 = rank(0.50);
+        result.p95 = rank(0.95);
+        result.p99 = rank(0.99);
+        result.max = values.back();
+        return result;
+    }
+
+    void writePercentiles(std::ofstream &out, const char *name, std::vector<float> &values, const char *suffix)
+    {
+        const Percentiles p = percentiles(values);
+        out << "\"" << name << "\": {\"samples\": " << p.samples << ", \"p50\": " << p.p50 << ", \"p95\": " << p.p95
+            << ", \"p99\": " << p.p99 << ", \"max\": " << p.max << "}" << suffix;
+    }
+}
+
+void FlyThroughBenchmark::start(std::string reportBase, std::vector<float> renderScales)
+{
+    sReportBase = std::move(reportBase);
+    sScales = renderScales.empty() ? std::vector<float>{1.0f} : std::move(renderScales);
+    sFrames.clear();
+    // About 30 s of path per scale at 60 Hz; reserved so recording never reallocates mid-run
+    sFrames.reserve(sScales.size() * 2400);
+    sOrigin = std::chrono::steady_clock::now();
+    sFrameStart = sOrigin;
+    sScaleIndex = 0;
+    sSegment = 0;
+    sSegmentTime = 0.0f;
+    sPathParameter = 0.0f;
+    sBreakCredit = 0.0f;
+    sOnPath = false;
+    sAwaitingGpu = false;
+    sGpuMissed = 0;
+    sFinished = false;
+    sResult = false;
+    sRunning = true;
+}
+
+std::optional<std::uint32_t> FlyThroughBenchmark::getMazeSeed() noexcept
+{
+    return sRunning ? std::optional<std::uint32_t>{MAZE_SEED} : std::nullopt;
+}
+
+std::optional<FlyThroughBenchmark::Pose> FlyThroughBenchmark::advance(float dt, glm::vec2 halfExtents) noexcept
+{
+    if (!sRunning || sScaleIndex >= sScales.size())
+    {
+        return std::nullopt;
+    }
+
+    sSegmentTime += dt;
+    while (sSegmentTime >= kSegments[sSegment].seconds)
+    {
+        sSegmentTime -= kSegments[sSegment].seconds;
+        if (++sSegment == kSegments.size())
+        {
+            // Every scale flies the same path from its start
+            sSegment = 0;
+            sSegmentTime = 0.0f;
+            sPathParameter = 0.0f;
+            sBreakCredit = 0.0f;
+            if (++sScaleIndex == sScales.size())
+            {
+                return std::nullopt;
+            }
+            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "FlyThroughBenchmark: render scale %.2f", sScales[sScaleIndex]);
+        }
+    }
+
+    const Segment &segment = kSegments[sSegment];
+    const float t = sSegmentTime / segment.seconds;
+    const glm::vec2 extent = glm::max(halfExtents, glm::vec2(1.0f)) * kPathExtent;
+
+    // Step the parameter by arc length so the speed is in world units whatever the curve does
+    const glm::vec2 tangent = pathTangent(sPathParameter) * extent;
+    const float tangentLength = std::max(glm::length(tangent), 0.1f * glm::length(extent));
+    sPathParameter += segment.speed * dt / tangentLength;
+
+    Pose pose;
+    pose.offset = pathPoint(sPathParameter) * extent;
+    pose.heading = tangent / tangentLength;
+    pose.zoom = segment.zoomFrom + (segment.zoomTo - segment.zoomFrom) * t;
+    pose.renderScale = sScales[sScaleIndex];
+
+    sBreakCredit += segment.wallBreaksPerSecond * dt;
+    pose.wallBreaks = static_cast<std::size_t>(sBreakCredit);
+    sBreakCredit -= static_cast<float>(pose.wallBreaks);
+
+    sOnPath = true;
+    return pose;
+}
+
+void FlyThroughBenchmark::beginFrame() noexcept
+{
+    if (sRunning)
+    {
+        sFrameStart = std::chrono::steady_clock::now();
+    }
+}
+
+void FlyThroughBenchmark::endFrame() noexcept
+{
+    if (!sRunning)
+    {
+        return;
+    }
+
+    // GPUProfiler::beginFrame earlier in this frame collected the previous frame's queries
+    if (sAwaitingGpu && !sFrames.empty())
+    {
+        Frame &previous = sFrames.back();
+        previous.gpuMs = GPUProfiler::getLastFrameMs();
+        if (!previous.gpuMs)
+        {
+            ++sGpuMissed;
+        }
+        for (std::size_t pass = 0; pass < GPUProfiler::PASS_COUNT; ++pass)
+        {
+            previous.passMs[pass] = GPUProfiler::getLastPassMs(static_cast<GPUProfiler::Pass>(pass));
+        }
+    }
+
+    sAwaitingGpu = sOnPath;
+    if (sOnPath)
+    {
+        Frame frame{};
+        frame.scaleIndex = static_cast<std::uint16_t>(sScaleIndex);
+        frame.segment = static_cast<std::uint16_t>(sSegment);
+        frame.cpuMs = static_cast<float>(toMilliseconds(std::chrono::steady_clock::now() - sFrameStart));
+        sFrames.push_back(frame);
+    }
+    sOnPath = false;
+}
+
+bool FlyThroughBenchmark::hasTimedOut() noexcept
+{
+    return sRunning && std::chrono::steady_clock::now() - sOrigin >= TIMEOUT;
+}
+
+bool FlyThroughBenchmark::finish()
+{
+    if (!sRunning)
+    {
+        return sResult;
+    }
+    sRunning = false;
+
+    if (sFinished)
+    {
+        return sResult;
+    }
+    sFinished = true;
+
+    const bool complete = sScaleIndex >= sScales.size();
+    if (!complete)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FlyThroughBenchmark: ended at scale %zu of %zu",
+                     sScaleIndex + 1, sScales.size());
+    }
+
+    const bool csvWritten = writeCsv();
+    const bool jsonWritten = writeJson(complete);
+    sResult = complete && csvWritten && jsonWritten;
+    return sResult;
+}
+
+std::vector<float> FlyThroughBenchmark::parseScales(std::string_view text)
+{
+    std::vector<float> scales;
+    while (!text.empty())
+    {
+        const std::size_t comma = text.find(',');
+        const std::string_view entry = text.substr(0, comma);
+
+        float scale = 0.0f;
+        const auto [end, error] = std::from_chars(entry.data(), entry.data() + entry.size(), scale);
+        if (error != std::errc{} || end != entry.data() + entry.size() || !(scale > 0.0f))
+        {
+            return {};
+        }
+        scales.push_back(scale);
+
+        text = comma == std::string_view::npos ? std::string_view{} : text.substr(comma + 1);
+    }
+    return scales;
+}
+
+bool FlyThroughBenchmark::writeCsv()
+{
+    const std::string path = sReportBase + ".csv";
+    std::ofstream out(path, std::ios::trunc);
+    if (!out)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FlyThroughBenchmark: cannot write %s", path.c_str());
+        return false;
+    }
+
+    out << "scale,segment,frame,cpu_ms,gpu_ms";
+    for (std::size_t pass = 0; pass < GPUProfiler::PASS_COUNT; ++pass)
+    {
+        out << "," << GPUProfiler::getPassName(static_cast<GPUProfiler::Pass>(pass));
+    }
+    out << "\n";
+
+    // Missing GPU samples (query not ready, pass not drawn) stay empty rather than zero
+    const auto field = [&out](const std::optional<float> &value)
+    {
+        out << ",";
+        if (value)
+        {
+            out << *value;
+        }
+    };
+
+    for (std::size_t i = 0; i < sFrames.size(); ++i)
+    {
+        const Frame &frame = sFrames[i];
+        out << sScales[frame.scaleIndex] << "," << kSegments[frame.segment].name << "," << i << "," << frame.cpuMs;
+        field(frame.gpuMs);
+        for (const auto &passMs : frame.passMs)
+        {
+            field(passMs);
+        }
+        out << "\n";
+    }
+
+    return static_cast<bool>(out);
+}
+
+bool FlyThroughBenchmark::writeJson(bool complete)
+{
+    const std::string path = sReportBase + ".json";
+    std::ofstream out(path, std::ios::trunc);
+    if (!out)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FlyThroughBenchmark: cannot write %s", path.c_str());
+        return false;
+    }
+
+    // One summary per scale over all measured segments ("all"), then one per segment
+    const auto writeSummary = [&out](const char *name, const std::function<bool(const Frame &)> &include, const char *suffix)
+    {
+        std::vector<float> cpu;
+        std::vector<float> gpu;
+        std::size_t gpuMissed = 0;
+        std::array<std::vector<float>, GPUProfiler::PASS_COUNT> passes;
+        for (const Frame &frame : sFrames)
+        {
+            if (!include(frame))
+            {
+                continue;
+            }
+            cpu.push_back(frame.cpuMs);
+            if (frame.gpuMs)
+            {
+                gpu.push_back(*frame.gpuMs);
+            }
+            else
+            {
+                ++gpuMissed;
+            }
+            for (std::size_t pass = 0; pass < GPUProfiler::PASS_COUNT; ++pass)
+            {
+                if (frame.passMs[pass])
+                {
+                    passes[pass].push_back(*frame.passMs[pass]);
+                }
+            }
+        }
+
+        out << "        {\"segment\": \"" << name << "\", ";
+        writePercentiles(out, "cpuMs", cpu, ", ");
+        writePercentiles(out, "gpuMs", gpu, ", ");
+        out << "\"gpuMissed\": " << gpuMissed << ", ";
+        out << "\"passes\": {";
+        for (std::size_t pass = 0; pass < GPUProfiler::PASS_COUNT; ++pass)
+        {
+            writePercentiles(out, GPUProfiler::getPassName(static_cast<GPUProfiler::Pass>(pass)), passes[pass],
+                             pass + 1 < GPUProfiler::PASS_COUNT ? ", " : "");
+        }
+        out << "}}" << suffix;
+    };
+
+    out << "{\n";
+    out << "  \"version\": \"" << bw::buildinfo::Version << "\",\n";
+    out << "  \"complete\": " << (complete ? "true" : "false") << ",\n";
+    out << "  \"mazeSeed\": " << MAZE_SEED << ",\n";
+    out << "  \"frames\": " << sFrames.size() << ",\n";
+    out << "  \"gpuMissed\": " << sGpuMissed << ",\n";
+    out << "  \"scales\": [\n";
+
+    for (std::size_t scale = 0; scale < sScales.size(); ++scale)
+    {
+        out << "    {\"renderScale\": " << sScales[scale] << ", \"summaries\": [\n";
+        writeSummary("all", [scale](const Frame &frame)
+                     { return frame.scaleIndex == scale && kSegments[frame.segment].measured; },
+                     ",\n");
+        for (std::size_t segment = 0; segment < kSegments.size(); ++segment)
+        {
+            if (!kSegments[segment].measured)
+            {
+                continue;
+            }
+            writeSummary(kSegments[segment].name, [scale, segment](const Frame &frame)
+                         { return frame.scaleIndex == scale && frame.segment == segment; },
+                         segment + 1 < kSegments.size() ? ",\n" : "\n");
+        }
+        out << "    ]}" << (scale + 1 < sScales.size() ? ",\n" : "\n");
+    }
+
+    out << "  ]\n}\n";
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "FlyThroughBenchmark: %zu frames at %zu scales, reports in %s.{csv,json}",
+                sFrames.size(), sScales.size(), sReportBase.c_str());
+    if (sGpuMissed > 0)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "FlyThroughBenchmark: GPU timings missing for %zu of %zu frames",
+                    sGpuMissed, sFrames.size());
+    }
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,116 @@
+#ifndef FLY_THROUGH_BENCHMARK_HPP
+#define FLY_THROUGH_BENCHMARK_HPP
+
+#include "GPUProfiler.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// @brief Frame-time regression run: a fixed maze seed and a canned player and camera path
+/// @details Started by `breakingwalls <config.json> --flythrough-benchmark[=report] [--render-scales=1,0.75]`.
+/// Splash and menu advance on their own as in a startup benchmark; GameState then follows advance()
+/// instead of input, flying the whole path once per render scale. The main loop brackets each frame
+/// with beginFrame()/endFrame(), and finish() writes <report>.csv (one row per frame) and
+/// <report>.json (p50/p95/p99/max of CPU, GPU and every GPU pass, per scale and path segment).
+///
+/// GPUProfiler is forced on for the run. Its timings arrive one frame late and are filed under the
+/// frame that drew them; a frame whose queries were not ready by then is not waited for, so as not to
+/// stall the CPU timing, but counted as gpuMissed in the report. CPU time runs from the start of the frame to just before the buffer swap.
+class FlyThroughBenchmark
+{
+public:
+    static constexpr std::string_view FLAG = "--flythrough-benchmark";
+    static constexpr std::string_view SCALES_FLAG = "--render-scales";
+    /// Report base name; .csv and .json are appended
+    static constexpr std::string_view DEFAULT_REPORT = "flythrough_benchmark";
+    /// Raster maze seed for every run, so builds are compared on the same walls
+    static constexpr std::uint32_t MAZE_SEED = 0xB3A7C0DEu;
+    /// A run that has not finished by then writes what it has and quits
+    static constexpr std::chrono::seconds TIMEOUT{600};
+
+    /// Where GameState puts the player and camera for one fixed step
+    struct Pose
+    {
+        /// Player offset from the maze centre in the XZ plane
+        glm::vec2 offset{0.0f};
+        /// Unit direction of travel in the XZ plane
+        glm::vec2 heading{0.0f, -1.0f};
+        /// Bird's-eye distance from the closest zoom (0) to the whole-maze zoom (1)
+        float zoom{1.0f};
+        float renderScale{1.0f};
+        /// Walls around the player to break this step
+        std::size_t wallBreaks{0};
+    };
+
+    /// @brief Arm the run; call first thing in main()
+    /// @param renderScales Scales the path is flown at, in order; empty flies it once at 1
+    static void start(std::string reportBase, std::vector<float> renderScales);
+
+    [[nodiscard]] static bool isRunning() noexcept { return sRunning; }
+
+    /// MAZE_SEED while running, otherwise nullopt (a random maze)
+    [[nodiscard]] static std::optional<std::uint32_t> getMazeSeed() noexcept;
+
+    /// @brief Move along the path by one fixed step
+    /// @param halfExtents Half the maze width and depth; the path stays inside them
+    /// @return nullopt once the path has been flown at every scale
+    [[nodiscard]] static std::optional<Pose> advance(float dt, glm::vec2 halfExtents) noexcept;
+
+    /// Call at the top of every main-loop iteration
+    static void beginFrame() noexcept;
+    /// Call after the frame is submitted and before the swap
+    static void endFrame() noexcept;
+
+    [[nodiscard]] static bool hasTimedOut() noexcept;
+
+    /// @brief Stop the run and write both reports; later calls return the first result
+    /// @return true if every scale was flown to the end and both reports were written
+    static bool finish();
+
+    /// @brief Parse a comma-separated scale list such as "1,0.75,0.5"
+    /// @return Empty when any entry is not a positive number
+    [[nodiscard]] static std::vector<float> parseScales(std::string_view text);
+
+private:
+    struct Frame
+    {
+        std::uint16_t scaleIndex;
+        std::uint16_t segment;
+        float cpuMs;
+        std::optional<float> gpuMs;
+        std::array<std::optional<float>, GPUProfiler::PASS_COUNT> passMs;
+    };
+
+    [[nodiscard]] static bool writeCsv();
+    [[nodiscard]] static bool writeJson(bool complete);
+
+    static std::vector<Frame> sFrames;
+    static std::vector<float> sScales;
+    static std::string sReportBase;
+    static std::chrono::steady_clock::time_point sOrigin;
+    static std::chrono::steady_clock::time_point sFrameStart;
+    static std::size_t sScaleIndex;
+    static std::size_t sSegment;
+    static float sSegmentTime;
+    static float sPathParameter;
+    static float sBreakCredit;
+    /// A pose was handed out since the last endFrame, so this frame shows the path
+    static bool sOnPath;
+    /// The last recorded frame still waits for its GPU timings
+    static bool sAwaitingGpu;
+    /// Recorded frames whose GPU timings were not ready when collected
+    static std::size_t sGpuMissed;
+    static bool sRunning;
+    static bool sFinished;
+    static bool sResult;
+};
+
+#endif // FLY_THROUGH_BENCHMARK_HPP
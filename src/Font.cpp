@@ -1,23 +1,471 @@
 #include "Font.hpp"
 
 #include <dearimgui/imgui.h>
+#include <dearimgui/imgui_internal.h>
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+/// Glyphs of one font as stb_truetype rasterized them, plus the stb state for anything not cached yet
+struct FontGlyphSource
+{
+    /// Width 0 means nothing to draw (space); pixels are Alpha8 rows of width bytes
+    struct Glyph
+    {
+        std::uint32_t codepoint;
+        float advanceX;
+        float x0;
+        float y0;
+        float x1;
+        float y1;
+        std::uint16_t width;
+        std::uint16_t height;
+        std::uint32_t pixelOffset;
+    };
+
+    /// Every cached glyph of one baked size and rasterizer density, sorted by code point
+    struct Size
+    {
+        float size;
+        float density;
+        std::vector<Glyph> glyphs;
+    };
+
+    std::uint64_t sourceHash{0};
+    /// stb_truetype's per-source data; swapped into ImFontConfig::FontLoaderData around each delegated call
+    void *trueTypeData{nullptr};
+    std::vector<Size> sizes;
+    std::vector<unsigned char> pixels;
+    /// Glyphs were rasterized since the cache was read
+    bool dirty{false};
+};
+
+namespace
+{
+    /// Basic Latin and Latin-1 Supplement, ImGui's default range and all the UI ever draws
+    constexpr ImWchar kFirstCodepoint = 0x0020;
+    constexpr ImWchar kLastCodepoint = 0x00FF;
+    /// Printable ASCII: every menu, HUD and popup string, so it is baked at load
+    constexpr ImWchar kLastBakedCodepoint = 0x007E;
+
+    struct GlyphCacheHeader
+    {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint64_t sourceHash;
+        std::uint32_t sizeCount;
+        std::uint32_t pixelBytes;
+    };
+
+    struct GlyphCacheSize
+    {
+        float size;
+        float density;
+        std::uint32_t glyphCount;
+    };
+
+    /// Source whose AddFont() is in progress; the loader takes it over in its first FontSrcInit
+    FontGlyphSource *sPendingSource = nullptr;
+
+    [[nodiscard]] std::uint64_t hashBytes(const void *data, std::size_t size, std::uint64_t seed) noexcept
+    {
+        std::uint64_t value = seed;
+        const auto *bytes = static_cast<const unsigned char *>(data);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            value ^= bytes[i];
+            value *= 0x100000001b3ull;
+        }
+        return value;
+    }
+
+    [[nodiscard]] const ImFontLoader &trueTypeLoader()
+    {
+        return *ImFontAtlasGetFontLoaderForStbTruetype();
+    }
+
+    [[nodiscard]] FontGlyphSource &glyphSource(ImFontConfig *src)
+    {
+        return *static_cast<FontGlyphSource *>(src->FontLoaderData);
+    }
+
+    /// Run a stb_truetype loader callback with its own data in FontLoaderData
+    template <typename Call>
+    bool withTrueType(ImFontConfig *src, Call &&call)
+    {
+        FontGlyphSource &source = glyphSource(src);
+        src->FontLoaderData = source.trueTypeData;
+        const bool result = call();
+        source.trueTypeData = src->FontLoaderData;
+        src->FontLoaderData = &source;
+        return result;
+    }
+
+    [[nodiscard]] bool acceptsCodepoint(ImWchar codepoint) noexcept
+    {
+        return codepoint >= kFirstCodepoint && codepoint <= kLastCodepoint;
+    }
+
+    [[nodiscard]] float bakedDensity(const ImFontConfig *src, const ImFontBaked *baked) noexcept
+    {
+        return src->RasterizerDensity * baked->RasterizerDensity;
+    }
+
+    [[nodiscard]] FontGlyphSource::Size *findSize(FontGlyphSource &source, float size, float density) noexcept
+    {
+        for (FontGlyphSource::Size &entry : source.sizes)
+        {
+            if (entry.size == size && entry.density == density)
+            {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] const FontGlyphSource::Glyph *findGlyph(const FontGlyphSource::Size &size, ImWchar codepoint) noexcept
+    {
+        const auto found = std::lower_bound(size.glyphs.begin(), size.glyphs.end(), codepoint,
+                                            [](const FontGlyphSource::Glyph &glyph, ImWchar value) {
+                                                return glyph.codepoint < value;
+                                            });
+        return found != size.glyphs.end() && found->codepoint == codepoint ? &*found : nullptr;
+    }
+
+    /// Copy a glyph stb_truetype just packed back out of the atlas texture into the cache
+    void recordGlyph(FontGlyphSource &source, ImFontAtlas *atlas, const ImFontConfig *src, const ImFontBaked *baked,
+                     const ImFontGlyph &glyph)
+    {
+        const float density = bakedDensity(src, baked);
+        FontGlyphSource::Size *size = findSize(source, baked->Size, density);
+        if (size == nullptr)
+        {
+            source.sizes.push_back(FontGlyphSource::Size{baked->Size, density, {}});
+            size = &source.sizes.back();
+        }
+
+        const auto codepoint = static_cast<ImWchar>(glyph.Codepoint);
+        const auto slot = std::lower_bound(size->glyphs.begin(), size->glyphs.end(), codepoint,
+                                           [](const FontGlyphSource::Glyph &entry, ImWchar value) {
+                                               return entry.codepoint < value;
+                                           });
+        if (slot != size->glyphs.end() && slot->codepoint == codepoint)
+        {
+            return;
+        }
+
+        FontGlyphSource::Glyph cached{codepoint, glyph.AdvanceX, glyph.X0, glyph.Y0, glyph.X1, glyph.Y1, 0, 0,
+                                      static_cast<std::uint32_t>(source.pixels.size())};
+        if (glyph.Visible)
+        {
+            const ImTextureRect *rect = ImFontAtlasPackGetRect(atlas, glyph.PackId);
+            ImTextureData *texture = atlas->TexData;
+            cached.width = rect->w;
+            cached.height = rect->h;
+            source.pixels.resize(source.pixels.size() + static_cast<std::size_t>(rect->w) * rect->h);
+            unsigned char *out = source.pixels.data() + cached.pixelOffset;
+
+            // RGBA32 atlases store coverage as white with alpha, so the alpha byte is the Alpha8 value
+            for (int y = 0; y < rect->h; ++y)
+            {
+                const auto *row = static_cast<const unsigned char *>(texture->GetPixelsAt(rect->x, rect->y + y));
+                for (int x = 0; x < rect->w; ++x)
+                {
+                    *out++ = texture->Format == ImTextureFormat_Alpha8 ? row[x] : row[x * 4 + 3];
+                }
+            }
+        }
+        size->glyphs.insert(slot, cached);
+        source.dirty = true;
+    }
+
+    bool cachedFontSrcInit(ImFontAtlas *atlas, ImFontConfig *src)
+    {
+        // Only the first init comes from AddFont(); atlas rebuilds re-init with the source still attached
+        if (src->FontLoaderData == nullptr)
+        {
+            if (sPendingSource == nullptr)
+            {
+                return false;
+            }
+            src->FontLoaderData = sPendingSource;
+        }
+        return withTrueType(src, [&] { return trueTypeLoader().FontSrcInit(atlas, src); });
+    }
+
+    void cachedFontSrcDestroy(ImFontAtlas *atlas, ImFontConfig *src)
+    {
+        if (src->FontLoaderData == nullptr)
+        {
+            return;
+        }
+        withTrueType(src, [&] {
+            trueTypeLoader().FontSrcDestroy(atlas, src);
+            return true;
+        });
+    }
+
+    bool cachedFontSrcContainsGlyph(ImFontAtlas *atlas, ImFontConfig *src, ImWchar codepoint)
+    {
+        return acceptsCodepoint(codepoint) &&
+               withTrueType(src, [&] { return trueTypeLoader().FontSrcContainsGlyph(atlas, src, codepoint); });
+    }
+
+    bool cachedFontBakedInit(ImFontAtlas *atlas, ImFontConfig *src, ImFontBaked *baked, void *loaderData)
+    {
+        // Vertical metrics are a table lookup; the cached glyph offsets already include the ascent
+        return withTrueType(src, [&] { return trueTypeLoader().FontBakedInit(atlas, src, baked, loaderData); });
+    }
+
+    bool cachedFontBakedLoadGlyph(ImFontAtlas *atlas, ImFontConfig *src, ImFontBaked *baked, void *loaderData,
+                                  ImWchar codepoint, ImFontGlyph *outGlyph, float *outAdvanceX)
+    {
+        if (!acceptsCodepoint(codepoint))
+        {
+            return false;
+        }
+
+        FontGlyphSource &source = glyphSource(src);
+        const FontGlyphSource::Size *size = findSize(source, baked->Size, bakedDensity(src, baked));
+        if (const FontGlyphSource::Glyph *cached = size ? findGlyph(*size, codepoint) : nullptr)
+        {
+            if (outAdvanceX != nullptr)
+            {
+                *outAdvanceX = cached->advanceX;
+                return true;
+            }
+
+            outGlyph->Codepoint = codepoint;
+            outGlyph->AdvanceX = cached->advanceX;
+            if (cached->width > 0)
+            {
+                const ImFontAtlasRectId packId = ImFontAtlasPackAddRect(atlas, cached->width, cached->height);
+                if (packId == ImFontAtlasRectId_Invalid)
+                {
+                    return false;
+                }
+                ImTextureRect *rect = ImFontAtlasPackGetRect(atlas, packId);
+                outGlyph->X0 = cached->x0;
+                outGlyph->Y0 = cached->y0;
+                outGlyph->X1 = cached->x1;
+                outGlyph->Y1 = cached->y1;
+                outGlyph->Visible = true;
+                outGlyph->PackId = packId;
+                ImFontAtlasBakedSetFontGlyphBitmap(atlas, baked, src, outGlyph, rect,
+                                                   source.pixels.data() + cached->pixelOffset, ImTextureFormat_Alpha8,
+                                                   cached->width);
+            }
+            return true;
+        }
+
+        const bool loaded = withTrueType(src, [&] {
+            return trueTypeLoader().FontBakedLoadGlyph(atlas, src, baked, loaderData, codepoint, outGlyph, outAdvanceX);
+        });
+        if (loaded && outGlyph != nullptr)
+        {
+            recordGlyph(source, atlas, src, baked, *outGlyph);
+        }
+        return loaded;
+    }
+
+    [[nodiscard]] const ImFontLoader *cachedFontLoader()
+    {
+        static const ImFontLoader loader = [] {
+            ImFontLoader cached;
+            cached.Name = "glyph_cache";
+            cached.FontSrcInit = cachedFontSrcInit;
+            cached.FontSrcDestroy = cachedFontSrcDestroy;
+            cached.FontSrcContainsGlyph = cachedFontSrcContainsGlyph;
+            cached.FontBakedInit = cachedFontBakedInit;
+            cached.FontBakedLoadGlyph = cachedFontBakedLoadGlyph;
+            cached.FontBakedSrcLoaderDataSize = trueTypeLoader().FontBakedSrcLoaderDataSize;
+            return cached;
+        }();
+        return &loader;
+    }
+} // namespace
+
+std::string Font::sCacheDirectory;
+
+Font::Font() = default;
+
+Font::~Font() = default;
+
+void Font::setCacheDirectory(const std::string &directory)
+{
+    sCacheDirectory = directory;
+    if (!sCacheDirectory.empty() && sCacheDirectory.back() != '/' && sCacheDirectory.back() != '\\')
+    {
+        sCacheDirectory += '/';
+    }
+}
+
+bool Font::hasCacheDirectory() noexcept
+{
+    return !sCacheDirectory.empty();
+}
 
 /// @brief Load font from memory (compressed TTF data)
 /// @param compressedData Pointer to the compressed TTF data in memory
 /// @param compressedSize Size of the compressed data in bytes
 /// @param pixelSize Desired pixel size for the font 28.f by default
 /// @return true if the font was loaded successfully, false otherwise
+/// @details The TTF is still decompressed and parsed (both cheap) so sizes missing from the cache
+/// can be rasterized; cached glyphs skip rasterization entirely.
 bool Font::loadFromMemoryCompressedTTF(const void *compressedData, std::size_t compressedSize, float pixelSize)
 {
+    // Glyph placement can change between ImGui releases, so its version is part of the key
+    mSource = std::make_unique<FontGlyphSource>();
+    mSource->sourceHash = hashBytes(compressedData, compressedSize, 0xcbf29ce484222325ull ^ IMGUI_VERSION_NUM);
+    readGlyphCache();
+
+    ImFontConfig config;
+    config.FontLoader = cachedFontLoader();
+
+    sPendingSource = mSource.get();
     mFont = ImGui::GetIO().Fonts->AddFontFromMemoryCompressedTTF(compressedData, static_cast<int>(compressedSize),
-                                                                 pixelSize);
+                                                                 pixelSize, &config);
+    sPendingSource = nullptr;
 
     IM_ASSERT(mFont != nullptr);
 
     return mFont != nullptr;
 }
 
+void Font::bakeGlyphs() const
+{
+    if (mFont == nullptr)
+    {
+        return;
+    }
+
+    // Frames rasterize at the framebuffer scale, so bake at the same density or the bake goes unused
+    const ImGuiIO &io = ImGui::GetIO();
+    const float density = io.DisplayFramebufferScale.x > 0.0f ? io.DisplayFramebufferScale.x : 1.0f;
+    ImFontBaked *baked = mFont->GetFontBaked(mFont->LegacySize, density);
+    for (ImWchar codepoint = kFirstCodepoint; codepoint <= kLastBakedCodepoint; ++codepoint)
+    {
+        baked->FindGlyph(codepoint);
+    }
+}
+
+void Font::storeGlyphCache() const
+{
+    if (!mSource || !mSource->dirty || sCacheDirectory.empty())
+    {
+        return;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(sCacheDirectory, error);
+
+    // Write to a temp file and rename, so a crash mid-write never leaves a truncated cache behind
+    const std::string path = cachePath();
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        const GlyphCacheHeader header{CACHE_MAGIC, CACHE_VERSION, mSource->sourceHash,
+                                      static_cast<std::uint32_t>(mSource->sizes.size()),
+                                      static_cast<std::uint32_t>(mSource->pixels.size())};
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        for (const FontGlyphSource::Size &size : mSource->sizes)
+        {
+            const GlyphCacheSize record{size.size, size.density, static_cast<std::uint32_t>(size.glyphs.size())};
+            file.write(reinterpret_cast<const char *>(&record), sizeof(record));
+            file.write(reinterpret_cast<const char *>(size.glyphs.data()),
+                       static_cast<std::streamsize>(size.glyphs.size() * sizeof(FontGlyphSource::Glyph)));
+        }
+        file.write(reinterpret_cast<const char *>(mSource->pixels.data()),
+                   static_cast<std::streamsize>(mSource->pixels.size()));
+        if (!file)
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Font: could not write glyph cache '%s'", tempPath.c_str());
+            return;
+        }
+    }
+    std::filesystem::rename(tempPath, path, error);
+    if (error)
+    {
+        std::filesystem::remove(tempPath, error);
+        return;
+    }
+    mSource->dirty = false;
+    SDL_Log("Font: stored glyph cache %s (%zu KiB)", path.c_str(), mSource->pixels.size() / 1024);
+}
+
 ImFont *Font::get() const
 {
     return mFont;
 }
+
+std::string Font::cachePath() const
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bwf", static_cast<unsigned long long>(mSource->sourceHash));
+    return sCacheDirectory + name;
+}
+
+void Font::readGlyphCache()
+{
+    if (sCacheDirectory.empty())
+    {
+        return;
+    }
+
+    std::ifstream file(cachePath(), std::ios::binary);
+    GlyphCacheHeader header{};
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) || header.magic != CACHE_MAGIC ||
+        header.version != CACHE_VERSION || header.sourceHash != mSource->sourceHash)
+    {
+        return;
+    }
+
+    std::vector<FontGlyphSource::Size> sizes;
+    sizes.reserve(header.sizeCount);
+    for (std::uint32_t i = 0; i < header.sizeCount; ++i)
+    {
+        GlyphCacheSize record{};
+        if (!file.read(reinterpret_cast<char *>(&record), sizeof(record)) || record.glyphCount > kLastCodepoint + 1u)
+        {
+            return;
+        }
+        FontGlyphSource::Size &size = sizes.emplace_back(FontGlyphSource::Size{record.size, record.density, {}});
+        size.glyphs.resize(record.glyphCount);
+        if (!file.read(reinterpret_cast<char *>(size.glyphs.data()),
+                       static_cast<std::streamsize>(size.glyphs.size() * sizeof(FontGlyphSource::Glyph))))
+        {
+            return;
+        }
+    }
+
+    std::vector<unsigned char> pixels(header.pixelBytes);
+    if (!file.read(reinterpret_cast<char *>(pixels.data()), static_cast<std::streamsize>(pixels.size())))
+    {
+        return;
+    }
+
+    // Glyph lookups binary-search and index straight into the pixels, so reject anything out of order or range
+    for (const FontGlyphSource::Size &size : sizes)
+    {
+        for (std::size_t g = 0; g < size.glyphs.size(); ++g)
+        {
+            const FontGlyphSource::Glyph &glyph = size.glyphs[g];
+            const std::size_t bytes = static_cast<std::size_t>(glyph.width) * glyph.height;
+            if ((g > 0 && size.glyphs[g - 1].codepoint >= glyph.codepoint) || glyph.pixelOffset > pixels.size() ||
+                bytes > pixels.size() - glyph.pixelOffset)
+            {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Font: ignoring damaged glyph cache %s", cachePath().c_str());
+                return;
+            }
+        }
+    }
+
+    mSource->sizes = std::move(sizes);
+    mSource->pixels = std::move(pixels);
+}
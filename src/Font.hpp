@@ -1,20 +1,56 @@
 #ifndef FONT_H
 #define FONT_H
 
+#include <cstddef>
+#include <cstdint>
 #include <cwchar>
+#include <memory>
+#include <string>
 
 struct ImFont;
+struct FontGlyphSource;
 
+/// @brief One ImGui font whose rasterized glyphs are kept in an on-disk glyph cache
+/// @details Glyphs come from a loader that serves bitmaps and metrics baked on an earlier launch
+/// straight into the ImFontAtlas, and hands anything it has not seen (new sizes, DPI scales,
+/// code points) to stb_truetype, recording the result for the next store. Only the Latin-1 block
+/// the UI draws is loaded at all; other code points render as the fallback glyph.
 class Font
 {
 public:
+    static constexpr std::uint32_t CACHE_MAGIC = 0x46475742u; // "BWGF"
+    static constexpr std::uint32_t CACHE_VERSION = 1u;
+
+    Font();
+    ~Font();
+
+    Font(const Font &) = delete;
+    Font &operator=(const Font &) = delete;
+
+    /// @brief Directory for glyph caches (created on first store); empty disables the cache
+    static void setCacheDirectory(const std::string &directory);
+    [[nodiscard]] static bool hasCacheDirectory() noexcept;
+
     // Load font from memory (compressed data)
     bool loadFromMemoryCompressedTTF(const void *compressedData, std::size_t compressedSize, float pixelSize = 28.f);
 
+    /// @brief Put printable ASCII at the load size into the atlas now instead of on first draw
+    void bakeGlyphs() const;
+
+    /// @brief Write the glyph cache if glyphs were rasterized since it was read
+    void storeGlyphCache() const;
+
     [[nodiscard]] ImFont *get() const;
 
 private:
+    [[nodiscard]] std::string cachePath() const;
+    void readGlyphCache();
+
+    static std::string sCacheDirectory;
+
     ImFont *mFont = nullptr;
+    /// Loader state the atlas points at, so a Font must outlive the ImGui context
+    std::unique_ptr<FontGlyphSource> mSource;
 };
 
 #endif // FONT_H
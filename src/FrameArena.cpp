@@ -0,0 +1,115 @@
+#include "FrameArena.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+namespace
+{
+    constexpr std::size_t kFrameArenaBytes = 256 * 1024;
+    constexpr std::size_t kScratchArenaBytes = 64 * 1024;
+    /// Overflow records kept without reallocating; more only happens while the arena is still growing
+    constexpr std::size_t kOverflowReserve = 32;
+    constexpr std::size_t kGrowGranularity = 16 * 1024;
+
+    std::size_t alignUp(std::size_t value, std::size_t alignment) noexcept
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+FrameArena::Scope::Scope() noexcept
+    : mArena{scratch()}, mOffset{mArena.mOffset}, mOverflowCount{mArena.mOverflow.size()}
+{
+}
+
+FrameArena::Scope::~Scope()
+{
+    mArena.rewind(mOffset, mOverflowCount);
+}
+
+FrameArena::FrameArena(std::size_t initialBytes)
+    : mBlock{std::make_unique<std::byte[]>(initialBytes)}, mCapacity{initialBytes}
+{
+    mOverflow.reserve(kOverflowReserve);
+}
+
+FrameArena::~FrameArena()
+{
+    for (const Overflow &overflow : mOverflow)
+    {
+        ::operator delete(overflow.pointer, overflow.bytes, std::align_val_t{overflow.alignment});
+    }
+}
+
+FrameArena &FrameArena::frame() noexcept
+{
+    static FrameArena arena{kFrameArenaBytes};
+    return arena;
+}
+
+void FrameArena::beginFrame() noexcept
+{
+    frame().rewind(0, 0);
+}
+
+FrameArena &FrameArena::scratch() noexcept
+{
+    thread_local FrameArena arena{kScratchArenaBytes};
+    return arena;
+}
+
+void *FrameArena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    const auto base = reinterpret_cast<std::uintptr_t>(mBlock.get());
+    const std::size_t start = alignUp(base + mOffset, alignment) - base;
+
+    void *pointer = nullptr;
+    if (start + bytes <= mCapacity)
+    {
+        pointer = mBlock.get() + start;
+        mOffset = start + bytes;
+    }
+    else
+    {
+        pointer = ::operator new(bytes, std::align_val_t{alignment});
+        mOverflow.push_back({pointer, bytes, alignment});
+        mOverflowBytes += bytes;
+    }
+
+    // Alignment padding counts too, so a block grown to the peak really fits the same sequence
+    mPeak = std::max(mPeak, mOffset + mOverflowBytes);
+    mHighWater = std::max(mHighWater, mPeak);
+    return pointer;
+}
+
+void FrameArena::rewind(std::size_t offset, std::size_t overflowCount) noexcept
+{
+    while (mOverflow.size() > overflowCount)
+    {
+        const Overflow &overflow = mOverflow.back();
+        ::operator delete(overflow.pointer, overflow.bytes, std::align_val_t{overflow.alignment});
+        mOverflowBytes -= overflow.bytes;
+        mOverflow.pop_back();
+    }
+    mOffset = offset;
+
+    if (offset != 0 || !mOverflow.empty())
+    {
+        return;
+    }
+
+    // Empty: nothing points into the block, so it can be replaced by one that holds the last peak
+    if (mPeak > mCapacity)
+    {
+        const std::size_t capacity = alignUp(mPeak + mPeak / 4, kGrowGranularity);
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "FrameArena: growing %zu KB -> %zu KB",
+                    mCapacity / 1024, capacity / 1024);
+        mBlock = std::make_unique<std::byte[]>(capacity);
+        mCapacity = capacity;
+        ++mGrowCount;
+    }
+    mPeak = 0;
+}
@@ -0,0 +1,91 @@
+#ifndef FRAME_ARENA_HPP
+#define FRAME_ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+/// @brief Bump allocator for memory that dies at a known point: the end of the frame or of a scope
+/// @details Allocation advances an offset into one block and deallocation does nothing; the whole
+/// arena is rewound at once. A request that does not fit goes to the global heap and is freed on the
+/// rewind, and the next time the arena is empty its block grows to the peak it saw, so after a few
+/// frames steady-state use never leaves the block. Use it through std::pmr containers:
+///
+///     FrameArena::Scope scope;
+///     std::pmr::vector<ChunkCoord> coords{scope.resource()};
+///
+/// frame() belongs to the main thread and is rewound by beginFrame() at the top of the main loop, so
+/// anything built from it must not outlive the loop iteration. scratch() is per thread and rewound
+/// when the Scope that opened it closes; scopes nest.
+class FrameArena final : public std::pmr::memory_resource
+{
+public:
+    /// Rewinds the calling thread's scratch() arena to where it was when the scope opened
+    class Scope
+    {
+    public:
+        Scope() noexcept;
+        ~Scope();
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+        [[nodiscard]] std::pmr::memory_resource *resource() const noexcept { return &mArena; }
+
+    private:
+        FrameArena &mArena;
+        std::size_t mOffset;
+        std::size_t mOverflowCount;
+    };
+
+    explicit FrameArena(std::size_t initialBytes);
+    ~FrameArena() override;
+
+    FrameArena(const FrameArena &) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    /// Main-thread arena for per-frame containers
+    [[nodiscard]] static FrameArena &frame() noexcept;
+    /// Call once per main-loop iteration, before anything allocates from frame()
+    static void beginFrame() noexcept;
+
+    /// The calling thread's arena; allocate from it only inside a Scope
+    [[nodiscard]] static FrameArena &scratch() noexcept;
+
+    [[nodiscard]] std::size_t getCapacity() const noexcept { return mCapacity; }
+    /// Most bytes live at once, overflow included
+    [[nodiscard]] std::size_t getHighWater() const noexcept { return mHighWater; }
+    /// Times the block was regrown after an overflow; stops climbing once use is steady
+    [[nodiscard]] std::size_t getGrowCount() const noexcept { return mGrowCount; }
+
+private:
+    struct Overflow
+    {
+        void *pointer;
+        std::size_t bytes;
+        std::size_t alignment;
+    };
+
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *, std::size_t, std::size_t) noexcept override {}
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    /// Drop everything allocated after the mark; grows the block when that empties the arena
+    void rewind(std::size_t offset, std::size_t overflowCount) noexcept;
+
+    std::unique_ptr<std::byte[]> mBlock;
+    std::size_t mCapacity;
+    std::size_t mOffset{0};
+    std::vector<Overflow> mOverflow;
+    std::size_t mOverflowBytes{0};
+    /// Peak since the arena was last empty; the size the block grows to
+    std::size_t mPeak{0};
+    std::size_t mHighWater{0};
+    std::size_t mGrowCount{0};
+};
+
+#endif // FRAME_ARENA_HPP
@@ -0,0 +1,336 @@
+#include "FrameCapture.hpp"
+
+#include <SDL3/SDL.h>
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb/stb_image_write.h>
+
+#include <cstring>
+
+std::array<FrameCapture::Readback, FrameCapture::READBACK_SLOTS> FrameCapture::sReadbacks{};
+std::size_t FrameCapture::sOldest = 0;
+std::size_t FrameCapture::sInFlight = 0;
+bool FrameCapture::sRecording = false;
+std::shared_ptr<const FrameCapture::Session> FrameCapture::sSession;
+std::uint64_t FrameCapture::sNextIndex = 0;
+std::uint64_t FrameCapture::sCaptured = 0;
+std::uint64_t FrameCapture::sDropped = 0;
+std::mutex FrameCapture::sMutex;
+std::condition_variable FrameCapture::sWake;
+std::deque<FrameCapture::Frame> FrameCapture::sQueue;
+std::vector<std::vector<std::uint8_t>> FrameCapture::sFreePixels;
+bool FrameCapture::sStopEncoder = false;
+std::thread FrameCapture::sEncoder;
+std::atomic<std::uint64_t> FrameCapture::sWritten{0};
+std::shared_ptr<const FrameCapture::Session> FrameCapture::sRawSession;
+std::FILE *FrameCapture::sRawFile = nullptr;
+int FrameCapture::sRawWidth = 0;
+int FrameCapture::sRawHeight = 0;
+
+namespace
+{
+    /// Only stop() and shutdown() block, and a hung GPU must not hang them for good
+    constexpr GLuint64 kFenceTimeoutNs = 1'000'000'000ull;
+    /// stb's default level 8 is several times slower and barely smaller on game frames
+    constexpr int kPngCompressionLevel = 1;
+    constexpr int kBytesPerPixel = 4;
+} // namespace
+
+bool FrameCapture::start(const std::string &directory, Format format) noexcept
+{
+    if (sRecording)
+    {
+        return true;
+    }
+
+    if (!SDL_CreateDirectory(directory.c_str()))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FrameCapture: Cannot create %s: %s", directory.c_str(), SDL_GetError());
+        return false;
+    }
+
+    try
+    {
+        sSession = std::make_shared<const Session>(Session{directory, format});
+        if (!sEncoder.joinable())
+        {
+            sStopEncoder = false;
+            sEncoder = std::thread(&FrameCapture::encodeLoop);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FrameCapture: Cannot start recording: %s", e.what());
+        return false;
+    }
+
+    sNextIndex = 0;
+    sRecording = true;
+    SDL_Log("FrameCapture: Recording %s to %s", format == Format::PNG_SEQUENCE ? "PNG sequence" : "raw video",
+            directory.c_str());
+    return true;
+}
+
+void FrameCapture::stop() noexcept
+{
+    if (!sRecording)
+    {
+        return;
+    }
+    sRecording = false;
+    SDL_Log("FrameCapture: Stopped after %llu frames, %llu dropped", static_cast<unsigned long long>(sNextIndex),
+            static_cast<unsigned long long>(sDropped));
+}
+
+void FrameCapture::captureFrame(int width, int height) noexcept
+{
+    collectReadbacks(false);
+
+    if (!sRecording || width <= 0 || height <= 0)
+    {
+        return;
+    }
+
+    // Every buffer still waiting on the GPU means it is more than a ring behind; skip rather than stall
+    if (sInFlight == READBACK_SLOTS)
+    {
+        ++sDropped;
+        return;
+    }
+
+    Readback &readback = sReadbacks[(sOldest + sInFlight) % READBACK_SLOTS];
+    const auto bytes = static_cast<GLsizeiptr>(width) * height * kBytesPerPixel;
+    if (readback.buffer == 0)
+    {
+        glGenBuffers(1, &readback.buffer);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+    if (readback.capacity != bytes)
+    {
+        glBufferData(GL_PIXEL_PACK_BUFFER, bytes, nullptr, GL_STREAM_READ);
+        readback.capacity = bytes;
+    }
+
+    // The copy into the buffer is queued like a draw; nothing waits for it here
+    GLint previousReadFramebuffer = 0;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousReadFramebuffer);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    glPixelStorei(GL_PACK_ALIGNMENT, kBytesPerPixel);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(previousReadFramebuffer));
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    readback.width = width;
+    readback.height = height;
+    readback.index = sNextIndex++;
+    readback.session = sSession;
+    ++sInFlight;
+}
+
+void FrameCapture::collectReadbacks(bool block) noexcept
+{
+    while (sInFlight > 0)
+    {
+        Readback &readback = sReadbacks[sOldest];
+        const GLenum status = glClientWaitSync(readback.fence, block ? GL_SYNC_FLUSH_COMMANDS_BIT : 0,
+                                               block ? kFenceTimeoutNs : 0);
+        if (status == GL_TIMEOUT_EXPIRED)
+        {
+            return;
+        }
+
+        glDeleteSync(readback.fence);
+        readback.fence = nullptr;
+        if (status != GL_WAIT_FAILED)
+        {
+            deliver(readback);
+        }
+        readback.session.reset();
+        sOldest = (sOldest + 1) % READBACK_SLOTS;
+        --sInFlight;
+    }
+}
+
+void FrameCapture::deliver(Readback &readback) noexcept
+{
+    Frame frame;
+    {
+        std::lock_guard<std::mutex> lock(sMutex);
+        if (sQueue.size() >= MAX_QUEUED_FRAMES)
+        {
+            ++sDropped;
+            return;
+        }
+        if (!sFreePixels.empty())
+        {
+            frame.pixels = std::move(sFreePixels.back());
+            sFreePixels.pop_back();
+        }
+    }
+
+    try
+    {
+        // Same size as last time for the whole recording, so a pooled buffer never reallocates
+        frame.pixels.resize(static_cast<std::size_t>(readback.capacity));
+    }
+    catch (const std::exception &)
+    {
+        ++sDropped;
+        return;
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+    const void *mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, readback.capacity, GL_MAP_READ_BIT);
+    if (!mapped)
+    {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        ++sDropped;
+        return;
+    }
+    std::memcpy(frame.pixels.data(), mapped, frame.pixels.size());
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    frame.width = readback.width;
+    frame.height = readback.height;
+    frame.index = readback.index;
+    frame.session = readback.session;
+    {
+        std::lock_guard<std::mutex> lock(sMutex);
+        sQueue.push_back(std::move(frame));
+    }
+    ++sCaptured;
+    sWake.notify_one();
+}
+
+void FrameCapture::encodeLoop() noexcept
+{
+    // GL rows run bottom-up
+    stbi_flip_vertically_on_write(1);
+    stbi_write_png_compression_level = kPngCompressionLevel;
+
+    std::unique_lock<std::mutex> lock(sMutex);
+    while (true)
+    {
+        sWake.wait(lock, []()
+                   { return sStopEncoder || !sQueue.empty(); });
+        if (sQueue.empty())
+        {
+            break;
+        }
+
+        Frame frame = std::move(sQueue.front());
+        sQueue.pop_front();
+        lock.unlock();
+
+        writeFrame(frame);
+        sWritten.fetch_add(1, std::memory_order_relaxed);
+
+        lock.lock();
+        sFreePixels.push_back(std::move(frame.pixels));
+    }
+    lock.unlock();
+
+    closeRawVideo();
+}
+
+void FrameCapture::writeFrame(const Frame &frame) noexcept
+{
+    const Session &session = *frame.session;
+    if (session.format == Format::PNG_SEQUENCE)
+    {
+        char name[32];
+        SDL_snprintf(name, sizeof(name), "/frame_%06llu.png", static_cast<unsigned long long>(frame.index));
+        const std::string path = session.directory + name;
+        if (!stbi_write_png(path.c_str(), frame.width, frame.height, kBytesPerPixel, frame.pixels.data(),
+                            frame.width * kBytesPerPixel))
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "FrameCapture: Failed writing %s", path.c_str());
+        }
+        return;
+    }
+
+    // One raw file per recording, started by its first frame
+    if (sRawSession != frame.session)
+    {
+        closeRawVideo();
+        const std::string path = session.directory + "/frames.rgba";
+        sRawFile = std::fopen(path.c_str(), "wb");
+        if (!sRawFile)
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "FrameCapture: Cannot open %s", path.c_str());
+        }
+        sRawSession = frame.session;
+        sRawWidth = frame.width;
+        sRawHeight = frame.height;
+    }
+
+    if (!sRawFile)
+    {
+        return;
+    }
+    if (frame.width != sRawWidth || frame.height != sRawHeight)
+    {
+        // A raw stream has one frame size; resized frames would shear every frame after them
+        return;
+    }
+    // Flushed per frame: the file stays open until the next recording, and may be copied before that
+    std::fwrite(frame.pixels.data(), 1, frame.pixels.size(), sRawFile);
+    std::fflush(sRawFile);
+}
+
+void FrameCapture::closeRawVideo() noexcept
+{
+    if (sRawFile)
+    {
+        std::fclose(sRawFile);
+        sRawFile = nullptr;
+        SDL_Log("FrameCapture: Convert with: ffmpeg -f rawvideo -pix_fmt rgba -s %dx%d -r 60 -i %s/frames.rgba -vf vflip out.mp4",
+                sRawWidth, sRawHeight, sRawSession->directory.c_str());
+    }
+    sRawSession.reset();
+}
+
+FrameCapture::Stats FrameCapture::getStats() noexcept
+{
+    Stats stats;
+    stats.captured = sCaptured;
+    stats.dropped = sDropped;
+    stats.written = sWritten.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(sMutex);
+    stats.queued = sQueue.size();
+    return stats;
+}
+
+void FrameCapture::shutdown() noexcept
+{
+    stop();
+    collectReadbacks(true);
+
+    if (sEncoder.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(sMutex);
+            sStopEncoder = true;
+        }
+        sWake.notify_one();
+        sEncoder.join();
+    }
+
+    for (Readback &readback : sReadbacks)
+    {
+        if (readback.fence)
+        {
+            glDeleteSync(readback.fence);
+        }
+        if (readback.buffer != 0)
+        {
+            glDeleteBuffers(1, &readback.buffer);
+        }
+        readback = Readback{};
+    }
+    sOldest = 0;
+    sInFlight = 0;
+    sFreePixels.clear();
+}
@@ -0,0 +1,125 @@
+#ifndef FRAME_CAPTURE_HPP
+#define FRAME_CAPTURE_HPP
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <glad/glad.h>
+
+/// @brief Records presented frames without stalling the GPU
+/// @details captureFrame() reads the default framebuffer into one of READBACK_SLOTS pixel pack
+/// buffers and fences it. Later calls map each buffer once its fence has signalled, normally
+/// READBACK_SLOTS - 1 frames on, copy the pixels into a pooled frame and hand that to an encoder
+/// thread. The encoder writes a PNG sequence or appends raw RGBA to one file. If every slot is still
+/// in flight, or the encoder is MAX_QUEUED_FRAMES behind, the frame is dropped and counted; it is
+/// never waited for.
+class FrameCapture
+{
+public:
+    static constexpr std::size_t READBACK_SLOTS = 3;
+    static constexpr std::size_t MAX_QUEUED_FRAMES = 8;
+
+    enum class Format
+    {
+        PNG_SEQUENCE,
+        /// Bottom-up RGBA frames back to back in frames.rgba; the encoder logs the ffmpeg line to convert it
+        RAW_VIDEO
+    };
+
+    struct Stats
+    {
+        /// Frames read back and handed to the encoder
+        std::uint64_t captured{0};
+        std::uint64_t written{0};
+        std::uint64_t dropped{0};
+        std::size_t queued{0};
+    };
+
+    /// @brief Start recording into directory, which is created if missing
+    static bool start(const std::string &directory, Format format) noexcept;
+
+    /// @brief Stop taking frames; the ones already read back are still written
+    static void stop() noexcept;
+
+    [[nodiscard]] static bool isRecording() noexcept { return sRecording; }
+
+    /// @brief Read back the default framebuffer; call after the last draw and before the swap
+    /// @details Also collects finished readbacks, so keep calling it for a few frames after stop()
+    static void captureFrame(int width, int height) noexcept;
+
+    [[nodiscard]] static Stats getStats() noexcept;
+
+    /// Write what is queued, join the encoder and delete the buffers; call while the GL context is current
+    static void shutdown() noexcept;
+
+private:
+    struct Session
+    {
+        std::string directory;
+        Format format;
+    };
+
+    struct Readback
+    {
+        GLuint buffer{0};
+        GLsizeiptr capacity{0};
+        GLsync fence{nullptr};
+        int width{0};
+        int height{0};
+        std::uint64_t index{0};
+        std::shared_ptr<const Session> session;
+    };
+
+    struct Frame
+    {
+        std::vector<std::uint8_t> pixels;
+        int width{0};
+        int height{0};
+        std::uint64_t index{0};
+        std::shared_ptr<const Session> session;
+    };
+
+    /// @param block Wait for every readback in flight instead of only taking finished ones
+    static void collectReadbacks(bool block) noexcept;
+    static void deliver(Readback &readback) noexcept;
+    static void encodeLoop() noexcept;
+    static void writeFrame(const Frame &frame) noexcept;
+    static void closeRawVideo() noexcept;
+
+    // GL thread
+    static std::array<Readback, READBACK_SLOTS> sReadbacks;
+    static std::size_t sOldest;
+    static std::size_t sInFlight;
+    static bool sRecording;
+    static std::shared_ptr<const Session> sSession;
+    static std::uint64_t sNextIndex;
+    static std::uint64_t sCaptured;
+    static std::uint64_t sDropped;
+
+    // Shared with the encoder under sMutex
+    static std::mutex sMutex;
+    static std::condition_variable sWake;
+    static std::deque<Frame> sQueue;
+    static std::vector<std::vector<std::uint8_t>> sFreePixels;
+    static bool sStopEncoder;
+    static std::thread sEncoder;
+    static std::atomic<std::uint64_t> sWritten;
+
+    // Encoder thread
+    static std::shared_ptr<const Session> sRawSession;
+    static std::FILE *sRawFile;
+    static int sRawWidth;
+    static int sRawHeight;
+};
+
+#endif // FRAME_CAPTURE_HPP
@@ -0,0 +1,214 @@
+#include "FramePacer.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+
+FramePacer::Settings FramePacer::sSettings{};
+std::array<FramePacer::InFlightFrame, FramePacer::RING_SIZE> FramePacer::sRing{};
+std::size_t FramePacer::sOldest = 0;
+std::size_t FramePacer::sInFlight = 0;
+GLint64 FramePacer::sInputGpuTimeNs = 0;
+FramePacer::History FramePacer::sLatency{};
+FramePacer::History FramePacer::sWait{};
+FramePacer::History FramePacer::sDelay{};
+bool FramePacer::sCreated = false;
+
+namespace
+{
+    /// A lost context or hung GPU must not freeze the loop; past this the frame is waited on next time
+    constexpr GLuint64 kFenceTimeoutNs = 100'000'000ull;
+    /// Headroom kept between the predicted finish and vsync when sleeping off slack
+    constexpr float kJustInTimeMarginMs = 2.0f;
+} // namespace
+
+void FramePacer::History::push(float valueMs) noexcept
+{
+    samplesMs[next] = valueMs;
+    next = (next + 1) % HISTORY_LENGTH;
+    count = std::min(count + 1, HISTORY_LENGTH);
+}
+
+float FramePacer::History::average() const noexcept
+{
+    if (count == 0)
+    {
+        return 0.0f;
+    }
+    float total = 0.0f;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        total += samplesMs[i];
+    }
+    return total / static_cast<float>(count);
+}
+
+float FramePacer::History::max() const noexcept
+{
+    float largest = 0.0f;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        largest = std::max(largest, samplesMs[i]);
+    }
+    return largest;
+}
+
+void FramePacer::configure(const Settings &settings) noexcept
+{
+    sSettings = settings;
+    sSettings.maxFramesInFlight = std::clamp<std::uint32_t>(settings.maxFramesInFlight, 1u, MAX_FRAMES_IN_FLIGHT);
+    // Slack is predicted from latency measured under the old limit, so start over
+    sDelay = History{};
+}
+
+void FramePacer::beginFrame() noexcept
+{
+    if (!sCreated)
+    {
+        for (InFlightFrame &frame : sRing)
+        {
+            glGenQueries(1, &frame.timestampQuery);
+        }
+        sCreated = true;
+    }
+
+    // Collect whatever finished without waiting, then block only for the frames over the limit
+    while (sInFlight > 0 && retireOldest(false))
+    {
+    }
+
+    float waitedMs = 0.0f;
+    if (sSettings.lowLatency)
+    {
+        const Uint64 waitStart = SDL_GetTicksNS();
+        while (sInFlight >= sSettings.maxFramesInFlight && retireOldest(true))
+        {
+        }
+        waitedMs = static_cast<float>(static_cast<double>(SDL_GetTicksNS() - waitStart) * 1e-6);
+
+        if (sSettings.justInTimeInput)
+        {
+            const std::uint64_t delayNs = justInTimeDelayNs();
+            if (delayNs > 0)
+            {
+                SDL_DelayPrecise(delayNs);
+            }
+            sDelay.push(static_cast<float>(static_cast<double>(delayNs) * 1e-6));
+        }
+    }
+    sWait.push(waitedMs);
+
+    // GPU clock when this frame's input is read; compared with the frame's completion timestamp
+    glGetInteger64v(GL_TIMESTAMP, &sInputGpuTimeNs);
+}
+
+void FramePacer::endFrame() noexcept
+{
+    if (!sCreated)
+    {
+        return;
+    }
+
+    // An unpaced GPU can fall further behind than the ring; that frame goes unmeasured
+    if (sInFlight == RING_SIZE && !retireOldest(false))
+    {
+        return;
+    }
+
+    InFlightFrame &frame = sRing[(sOldest + sInFlight) % RING_SIZE];
+    glQueryCounter(frame.timestampQuery, GL_TIMESTAMP);
+    frame.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    frame.inputGpuTimeNs = sInputGpuTimeNs;
+    ++sInFlight;
+
+    // Make sure the fence reaches the GPU now, not whenever the driver next flushes
+    glFlush();
+}
+
+bool FramePacer::retireOldest(bool block) noexcept
+{
+    InFlightFrame &frame = sRing[sOldest];
+    const GLenum status = glClientWaitSync(frame.fence, block ? GL_SYNC_FLUSH_COMMANDS_BIT : 0,
+                                           block ? kFenceTimeoutNs : 0);
+    if (status == GL_TIMEOUT_EXPIRED)
+    {
+        return false;
+    }
+
+    if (status != GL_WAIT_FAILED)
+    {
+        GLuint64 finishedNs = 0;
+        glGetQueryObjectui64v(frame.timestampQuery, GL_QUERY_RESULT, &finishedNs);
+        const auto gpuDoneNs = static_cast<GLint64>(finishedNs);
+        if (gpuDoneNs > frame.inputGpuTimeNs)
+        {
+            sLatency.push(static_cast<float>(static_cast<double>(gpuDoneNs - frame.inputGpuTimeNs) * 1e-6));
+        }
+    }
+
+    glDeleteSync(frame.fence);
+    frame.fence = nullptr;
+    sOldest = (sOldest + 1) % RING_SIZE;
+    --sInFlight;
+    return true;
+}
+
+std::uint64_t FramePacer::justInTimeDelayNs() noexcept
+{
+    int swapInterval = 0;
+    SDL_GL_GetSwapInterval(&swapInterval);
+    SDL_Window *window = SDL_GL_GetCurrentWindow();
+    if (swapInterval == 0 || window == nullptr || sLatency.count < HISTORY_LENGTH / 4)
+    {
+        return 0;
+    }
+
+    const SDL_DisplayMode *mode = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(window));
+    if (mode == nullptr || mode->refresh_rate <= 0.0f)
+    {
+        return 0;
+    }
+
+    // Worst recent input-to-GPU-done time predicts this frame; only what is left of the refresh is slept
+    const float periodMs = 1000.0f / mode->refresh_rate;
+    const float slackMs = periodMs - sLatency.max() - kJustInTimeMarginMs;
+    if (slackMs <= 0.0f)
+    {
+        return 0;
+    }
+    return static_cast<std::uint64_t>(std::min(slackMs, periodMs * 0.5f) * 1e6f);
+}
+
+FramePacer::Stats FramePacer::getStats() noexcept
+{
+    Stats stats;
+    stats.latencyAverageMs = sLatency.average();
+    stats.latencyMaxMs = sLatency.max();
+    stats.waitAverageMs = sWait.average();
+    stats.delayAverageMs = sDelay.average();
+    stats.framesInFlight = static_cast<std::uint32_t>(sInFlight);
+    stats.samples = sLatency.count;
+    return stats;
+}
+
+void FramePacer::shutdown() noexcept
+{
+    if (!sCreated)
+    {
+        return;
+    }
+
+    for (InFlightFrame &frame : sRing)
+    {
+        if (frame.fence != nullptr)
+        {
+            glDeleteSync(frame.fence);
+            frame.fence = nullptr;
+        }
+        glDeleteQueries(1, &frame.timestampQuery);
+        frame.timestampQuery = 0;
+    }
+    sOldest = 0;
+    sInFlight = 0;
+    sCreated = false;
+}
@@ -0,0 +1,94 @@
+#ifndef FRAME_PACER_HPP
+#define FRAME_PACER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <glad/glad.h>
+
+/// @brief Bounds how many frames the CPU may queue ahead of the GPU and measures input latency
+/// @details Every presented frame gets a fence and a GL_TIMESTAMP query. In low-latency mode the
+/// next frame does not start until at most maxFramesInFlight - 1 earlier frames are unfinished, so
+/// the driver's own 2-3 frame queue never fills and input is read close to when its frame draws.
+/// Latency is GPU completion time of a frame minus the GPU clock when its input was read, taken
+/// from fences that have already signalled so measuring never stalls.
+class FramePacer
+{
+public:
+    static constexpr std::uint32_t MAX_FRAMES_IN_FLIGHT = 3;
+    static constexpr std::size_t HISTORY_LENGTH = 120;
+
+    struct Settings
+    {
+        bool lowLatency{false};
+        /// Sleep off the predicted slack before reading input so the frame finishes just ahead of vsync
+        bool justInTimeInput{false};
+        std::uint32_t maxFramesInFlight{1};
+    };
+
+    struct Stats
+    {
+        float latencyAverageMs{0.0f};
+        float latencyMaxMs{0.0f};
+        /// CPU time blocked on fences per frame
+        float waitAverageMs{0.0f};
+        /// Just-in-time sleep per frame
+        float delayAverageMs{0.0f};
+        std::uint32_t framesInFlight{0};
+        std::size_t samples{0};
+    };
+
+    /// Takes effect at the next beginFrame(); maxFramesInFlight is clamped to [1, MAX_FRAMES_IN_FLIGHT]
+    static void configure(const Settings &settings) noexcept;
+    [[nodiscard]] static const Settings &getSettings() noexcept { return sSettings; }
+
+    /// @brief Start a frame before input is read; waits for a free frame slot in low-latency mode
+    static void beginFrame() noexcept;
+
+    /// @brief Fence the presented frame; call right after the swap
+    static void endFrame() noexcept;
+
+    [[nodiscard]] static Stats getStats() noexcept;
+
+    /// Delete fences and queries; call while the GL context is still current
+    static void shutdown() noexcept;
+
+private:
+    /// One more slot than the deepest allowed queue, so an unpaced frame can still be measured
+    static constexpr std::size_t RING_SIZE = MAX_FRAMES_IN_FLIGHT + 1;
+
+    struct InFlightFrame
+    {
+        GLsync fence{nullptr};
+        GLuint timestampQuery{0};
+        GLint64 inputGpuTimeNs{0};
+    };
+
+    struct History
+    {
+        std::array<float, HISTORY_LENGTH> samplesMs{};
+        std::size_t next{0};
+        std::size_t count{0};
+
+        void push(float valueMs) noexcept;
+        [[nodiscard]] float average() const noexcept;
+        [[nodiscard]] float max() const noexcept;
+    };
+
+    /// @param block Wait for the oldest frame instead of only collecting finished ones
+    static bool retireOldest(bool block) noexcept;
+    [[nodiscard]] static std::uint64_t justInTimeDelayNs() noexcept;
+
+    static Settings sSettings;
+    static std::array<InFlightFrame, RING_SIZE> sRing;
+    static std::size_t sOldest;
+    static std::size_t sInFlight;
+    static GLint64 sInputGpuTimeNs;
+    static History sLatency;
+    static History sWait;
+    static History sDelay;
+    static bool sCreated;
+};
+
+#endif // FRAME_PACER_HPP
@@ -2,6 +2,9 @@
 
 #include <SDL3/SDL.h>
 
+#include <algorithm>
+#include <utility>
+
 FramebufferObject::FramebufferObject() = default;
 
 FramebufferObject::~FramebufferObject() noexcept
@@ -10,7 +13,7 @@ FramebufferObject::~FramebufferObject() noexcept
 }
 
 FramebufferObject::FramebufferObject(FramebufferObject &&other) noexcept
-    : mFBO{other.mFBO}, mRBO{other.mRBO}
+    : mFBO{other.mFBO}, mRBO{other.mRBO}, mGpuBytes{std::move(other.mGpuBytes)}
 {
     other.mFBO = 0;
     other.mRBO = 0;
@@ -23,6 +26,7 @@ FramebufferObject &FramebufferObject::operator=(FramebufferObject &&other) noexc
         cleanUp();
         mFBO = other.mFBO;
         mRBO = other.mRBO;
+        mGpuBytes = std::move(other.mGpuBytes);
         other.mFBO = 0;
         other.mRBO = 0;
     }
@@ -74,6 +78,16 @@ void FramebufferObject::bindRenderbuffer() const noexcept
     glBindRenderbuffer(GL_RENDERBUFFER, mRBO);
 }
 
+void FramebufferObject::allocateRenderbuffer(GLenum internalFormat, GLsizei width, GLsizei height) noexcept
+{
+    glBindRenderbuffer(GL_RENDERBUFFER, mRBO);
+    glRenderbufferStorage(GL_RENDERBUFFER, internalFormat, width, height);
+
+    // Every depth and depth-stencil format used here takes 32 bits per sample
+    constexpr std::size_t kBytesPerSample = 4;
+    mGpuBytes.set(static_cast<std::size_t>(std::max(width, 0)) * static_cast<std::size_t>(std::max(height, 0)) * kBytesPerSample);
+}
+
 void FramebufferObject::unbindRenderbuffer() noexcept
 {
     glBindRenderbuffer(GL_RENDERBUFFER, 0);
@@ -86,6 +100,7 @@ void FramebufferObject::cleanUp() noexcept
         glDeleteRenderbuffers(1, &mRBO);
         mRBO = 0;
     }
+    mGpuBytes.set(0);
     if (mFBO != 0)
     {
         glDeleteFramebuffers(1, &mFBO);
@@ -4,6 +4,8 @@
 #include <glad/glad.h>
 #include <string_view>
 
+#include "MemoryStats.hpp"
+
 /// @brief RAII wrapper for an OpenGL Framebuffer Object (FBO) with optional Renderbuffer (RBO).
 /// Manages the lifetime of a single FBO and optionally a depth/stencil RBO.
 class FramebufferObject
@@ -44,6 +46,10 @@ public:
     /// @brief Bind the associated renderbuffer.
     void bindRenderbuffer() const noexcept;
 
+    /// @brief Bind the renderbuffer and (re)allocate its storage, recording its size
+    /// @details Leaves the renderbuffer bound
+    void allocateRenderbuffer(GLenum internalFormat, GLsizei width, GLsizei height) noexcept;
+
     /// @brief Unbind any currently bound renderbuffer (bind 0).
     static void unbindRenderbuffer() noexcept;
 
@@ -53,6 +59,7 @@ public:
 private:
     GLuint mFBO{0};
     GLuint mRBO{0};
+    MemoryStats::Allocation mGpuBytes{MemoryStats::Category::GPU_RENDER_TARGETS};
 };
 
 #endif // FRAMEBUFFER_OBJECT_HPP
@@ -0,0 +1,65 @@
+#ifndef FRUSTUM_HPP
+#define FRUSTUM_HPP
+
+#include <glm/glm.hpp>
+
+#include <array>
+
+/// @brief View frustum planes extracted from a view-projection matrix, for AABB culling
+/// @details Planes point inward. A plane with a vanishing normal (the far plane of an
+/// infinite projection) is disabled so it never rejects anything.
+class Frustum
+{
+public:
+    Frustum() = default;
+
+    explicit Frustum(const glm::mat4 &viewProjection) noexcept
+    {
+        const glm::vec4 row0(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]);
+        const glm::vec4 row1(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]);
+        const glm::vec4 row2(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]);
+        const glm::vec4 row3(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+
+        mPlanes = {row3 + row0, row3 - row0, row3 + row1, row3 - row1, row3 + row2, row3 - row2};
+        for (glm::vec4 &plane : mPlanes)
+        {
+            const float length = glm::length(glm::vec3(plane));
+            plane = (length > 1e-6f) ? plane / length : glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        }
+    }
+
+    /// @brief False only when the box lies entirely outside one plane (conservative)
+    [[nodiscard]] bool intersects(const glm::vec3 &boxMin, const glm::vec3 &boxMax) const noexcept
+    {
+        for (const glm::vec4 &plane : mPlanes)
+        {
+            // Corner furthest along the plane normal
+            const glm::vec3 positive(plane.x >= 0.0f ? boxMax.x : boxMin.x,
+                                     plane.y >= 0.0f ? boxMax.y : boxMin.y,
+                                     plane.z >= 0.0f ? boxMax.z : boxMin.z);
+            if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief False only when the sphere lies entirely outside one plane (conservative)
+    [[nodiscard]] bool intersectsSphere(const glm::vec3 &center, float radius) const noexcept
+    {
+        for (const glm::vec4 &plane : mPlanes)
+        {
+            if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    std::array<glm::vec4, 6> mPlanes{};
+};
+
+#endif // FRUSTUM_HPP
@@ -2,10 +2,17 @@
 
 #include "Animation.hpp"
 #include "buildinfo.h"
+#include "FramePacer.hpp"
+#include "GLStateCache.hpp"
+#include "GPUProfiler.hpp"
+#include "RenderStats.hpp"
 #include "Shader.hpp"
+#include "StartupTimeline.hpp"
 
 #include <SDL3/SDL.h>
 
+#include <algorithm>
+#include <cstddef>
 #include <string>
 
 #include <glad/glad.h>
@@ -16,11 +23,49 @@
 // Static member initialization for billboard rendering
 GLuint GLSDLHelper::sBillboardVAO = 0;
 GLuint GLSDLHelper::sBillboardVBO = 0;
+GLuint GLSDLHelper::sBillboardBatchVAO = 0;
 bool GLSDLHelper::sBillboardInitialized = false;
 bool GLSDLHelper::sBillboardOITPass = false;
+GLuint GLSDLHelper::sFrameUniformBuffer = 0;
+GLint GLSDLHelper::sUniformOffsetAlignment = 0;
+StreamingBuffer GLSDLHelper::sFrameStream;
 
 namespace
 {
+    // Billboard uniforms are set per sprite, so resolve their handles once per shader
+    struct BillboardUniforms
+    {
+        const Shader *shader{nullptr};
+        Shader::UniformHandle modelViewMatrix, size2, sizeXY, useWorldAxes, rightAxisWS, upAxisWS, doubleSided, texRect;
+        Shader::UniformHandle spriteTex, tintColor, flipX, flipY, useRedAsAlpha, oitPass, oitWeightScale, instanced;
+    } sBillboardUniforms;
+
+    void resolveBillboardUniforms(Shader &shader)
+    {
+        if (sBillboardUniforms.shader == &shader)
+        {
+            return;
+        }
+
+        sBillboardUniforms.modelViewMatrix = shader.getUniformHandle("ModelViewMatrix");
+        sBillboardUniforms.size2 = shader.getUniformHandle("Size2");
+        sBillboardUniforms.sizeXY = shader.getUniformHandle("SizeXY");
+        sBillboardUniforms.useWorldAxes = shader.getUniformHandle("UseWorldAxes");
+        sBillboardUniforms.rightAxisWS = shader.getUniformHandle("RightAxisWS");
+        sBillboardUniforms.upAxisWS = shader.getUniformHandle("UpAxisWS");
+        sBillboardUniforms.doubleSided = shader.getUniformHandle("DoubleSided");
+        sBillboardUniforms.texRect = shader.getUniformHandle("TexRect");
+        sBillboardUniforms.spriteTex = shader.getUniformHandle("SpriteTex");
+        sBillboardUniforms.tintColor = shader.getUniformHandle("TintColor");
+        sBillboardUniforms.flipX = shader.getUniformHandle("FlipX");
+        sBillboardUniforms.flipY = shader.getUniformHandle("FlipY");
+        sBillboardUniforms.useRedAsAlpha = shader.getUniformHandle("UseRedAsAlpha");
+        sBillboardUniforms.oitPass = shader.getUniformHandle("uOITPass");
+        sBillboardUniforms.oitWeightScale = shader.getUniformHandle("uOITWeightScale");
+        sBillboardUniforms.instanced = shader.getUniformHandle("uInstanced");
+        sBillboardUniforms.shader = &shader;
+    }
+
     void configureSDLInputHints() noexcept
     {
         SDL_SetHint(SDL_HINT_JOYSTICK_HIDAPI_STEAM, "0");
@@ -232,6 +277,7 @@ namespace
 
 void GLSDLHelper::init(std::string_view title, int width, int height) noexcept
 {
+    StartupTimeline::mark("GLSDLHelper::init");
     configureSDLInputHints();
 
     auto initFunc = [this, title, width, height]()
@@ -286,6 +332,10 @@ void GLSDLHelper::init(std::string_view title, int width, int height) noexcept
             return;
         }
 
+        // Fresh context: nothing in the shadow state cache applies to it
+        GLStateCache::invalidate();
+        StartupTimeline::mark("GL context created");
+
         SDL_GL_SetSwapInterval(1);
 
 #if defined(BREAKING_WALLS_DEBUG)
@@ -358,6 +408,10 @@ void GLSDLHelper::destroyAndQuit() noexcept
 {
     // Cleanup billboard rendering resources
     cleanupBillboardRendering();
+    cleanupFrameUniforms();
+    cleanupStreaming();
+    GPUProfiler::shutdown();
+    FramePacer::shutdown();
 
     if (!this->getWindow() && !this->getGLContext())
     {
@@ -418,15 +472,15 @@ void GLSDLHelper::destroyAndQuit() noexcept
 void GLSDLHelper::enableRenderingFeatures() noexcept
 {
     glEnable(GL_MULTISAMPLE);
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_CULL_FACE);
+    GLStateCache::enable(GL_DEPTH_TEST);
+    GLStateCache::enable(GL_CULL_FACE);
 }
 
 GLuint GLSDLHelper::createAndBindVAO() noexcept
 {
     GLuint vao = 0;
     glGenVertexArrays(1, &vao);
-    glBindVertexArray(vao);
+    GLStateCache::bindVertexArray(vao);
     return vao;
 }
 
@@ -468,7 +522,7 @@ void GLSDLHelper::allocateSSBOBuffer(GLsizeiptr bufferSize, const void *data) no
         return;
     }
 
-    glBufferData(GL_SHADER_STORAGE_BUFFER, bufferSize, data, GL_DYNAMIC_DRAW);
+    RenderStats::bufferData(GL_SHADER_STORAGE_BUFFER, bufferSize, data, GL_DYNAMIC_DRAW);
 
     const GLenum err = glGetError();
     if (err != GL_NO_ERROR)
@@ -500,7 +554,7 @@ void GLSDLHelper::updateSSBOBuffer(GLintptr offset, GLsizeiptr size, const void
         return;
     }
 
-    glBufferSubData(GL_SHADER_STORAGE_BUFFER, offset, size, data);
+    RenderStats::bufferSubData(GL_SHADER_STORAGE_BUFFER, offset, size, data);
 
     const GLenum err = glGetError();
     if (err != GL_NO_ERROR)
@@ -518,6 +572,7 @@ void GLSDLHelper::deleteVAO(GLuint &vao) noexcept
 {
     if (vao != 0)
     {
+        GLStateCache::forgetVertexArray(vao);
         glDeleteVertexArrays(1, &vao);
         vao = 0;
     }
@@ -536,6 +591,7 @@ void GLSDLHelper::deleteTexture(GLuint &texture) noexcept
 {
     if (texture != 0)
     {
+        GLStateCache::forgetTexture(texture);
         glDeleteTextures(1, &texture);
         texture = 0;
     }
@@ -555,18 +611,40 @@ void GLSDLHelper::initializeBillboardRendering() noexcept
     glGenVertexArrays(1, &sBillboardVAO);
     glGenBuffers(1, &sBillboardVBO);
 
-    glBindVertexArray(sBillboardVAO);
+    GLStateCache::bindVertexArray(sBillboardVAO);
     glBindBuffer(GL_ARRAY_BUFFER, sBillboardVBO);
 
     // Single point at origin - the model matrix will position it
     float pointData[3] = {0.0f, 0.0f, 0.0f};
-    glBufferData(GL_ARRAY_BUFFER, sizeof(pointData), pointData, GL_STATIC_DRAW);
+    RenderStats::bufferData(GL_ARRAY_BUFFER, sizeof(pointData), pointData, GL_STATIC_DRAW);
 
     // Position attribute (location 0)
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void *)0);
     glEnableVertexAttribArray(0);
 
-    glBindVertexArray(0);
+    // Batch VAO: the same point plus per-instance sprite data (divisor 1) read from the frame stream;
+    // each draw selects its instances with baseInstance, so the attribute pointers never change
+    glGenVertexArrays(1, &sBillboardBatchVAO);
+
+    GLStateCache::bindVertexArray(sBillboardBatchVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, sBillboardVBO);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void *)0);
+    glEnableVertexAttribArray(0);
+
+    glBindBuffer(GL_ARRAY_BUFFER, getFrameStream().getBuffer());
+    constexpr GLsizei instanceStride = sizeof(BillboardInstance);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, instanceStride, (void *)offsetof(BillboardInstance, center));
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, instanceStride, (void *)offsetof(BillboardInstance, halfSize));
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, instanceStride, (void *)offsetof(BillboardInstance, texRect));
+    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, instanceStride, (void *)offsetof(BillboardInstance, tint));
+    for (GLuint attrib = 1; attrib <= 4; ++attrib)
+    {
+        glEnableVertexAttribArray(attrib);
+        glVertexAttribDivisor(attrib, 1);
+    }
+
+    GLStateCache::bindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
 
     sBillboardInitialized = true;
 }
@@ -580,6 +658,7 @@ void GLSDLHelper::cleanupBillboardRendering() noexcept
 
     if (sBillboardVAO != 0)
     {
+        GLStateCache::forgetVertexArray(sBillboardVAO);
         glDeleteVertexArrays(1, &sBillboardVAO);
         sBillboardVAO = 0;
     }
@@ -590,6 +669,13 @@ void GLSDLHelper::cleanupBillboardRendering() noexcept
         sBillboardVBO = 0;
     }
 
+    if (sBillboardBatchVAO != 0)
+    {
+        GLStateCache::forgetVertexArray(sBillboardBatchVAO);
+        glDeleteVertexArrays(1, &sBillboardBatchVAO);
+        sBillboardBatchVAO = 0;
+    }
+
     sBillboardInitialized = false;
 }
 
@@ -600,7 +686,6 @@ void GLSDLHelper::renderBillboardSprite(
     const glm::vec3 &worldPosition,
     float halfSize,
     const glm::mat4 &viewMatrix,
-    const glm::mat4 &projMatrix,
     int sheetWidth,
     int sheetHeight) noexcept
 {
@@ -615,27 +700,22 @@ void GLSDLHelper::renderBillboardSprite(
         return;
     }
 
-    // Save current OpenGL state
-    GLboolean depthTestEnabled;
-    GLboolean blendEnabled;
-    GLboolean cullFaceEnabled;
-    glGetBooleanv(GL_DEPTH_TEST, &depthTestEnabled);
-    glGetBooleanv(GL_BLEND, &blendEnabled);
-    glGetBooleanv(GL_CULL_FACE, &cullFaceEnabled);
+    // Save current OpenGL state (read from the shadow cache, no driver round-trip)
+    const GLStateCache::Snapshot savedState = GLStateCache::save();
 
     // Enable blending for transparency
-    glEnable(GL_BLEND);
+    GLStateCache::enable(GL_BLEND);
     if (!sBillboardOITPass)
     {
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        GLStateCache::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     }
 
     // Disable face culling for billboards
-    glDisable(GL_CULL_FACE);
+    GLStateCache::disable(GL_CULL_FACE);
 
     // Enable depth testing
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LESS);
+    GLStateCache::enable(GL_DEPTH_TEST);
+    GLStateCache::depthFunc(GL_LESS);
 
     // Bind and use the billboard shader
     billboardShader.bind();
@@ -659,7 +739,6 @@ void GLSDLHelper::renderBillboardSprite(
         worldPosition,
         halfSize,
         viewMatrix,
-        projMatrix,
         glm::vec4(1.0f),
         true,
         true,
@@ -668,18 +747,7 @@ void GLSDLHelper::renderBillboardSprite(
     checkForOpenGLError(__FILE__, __LINE__);
 
     // Restore previous OpenGL state
-    if (!blendEnabled)
-    {
-        glDisable(GL_BLEND);
-    }
-    if (cullFaceEnabled)
-    {
-        glEnable(GL_CULL_FACE);
-    }
-    if (!depthTestEnabled)
-    {
-        glDisable(GL_DEPTH_TEST);
-    }
+    GLStateCache::restore(savedState);
 }
 
 void GLSDLHelper::renderBillboardSpriteUV(
@@ -689,7 +757,6 @@ void GLSDLHelper::renderBillboardSpriteUV(
     const glm::vec3 &worldPosition,
     float halfSize,
     const glm::mat4 &viewMatrix,
-    const glm::mat4 &projMatrix,
     const glm::vec4 &tintColor,
     bool flipX,
     bool flipY,
@@ -711,6 +778,7 @@ void GLSDLHelper::renderBillboardSpriteUV(
     }
 
     billboardShader.bind();
+    resolveBillboardUniforms(billboardShader);
 
     const glm::mat4 modelMatrix = glm::translate(glm::mat4(1.0f), worldPosition);
     const glm::mat4 modelViewMatrix = viewMatrix * modelMatrix;
@@ -720,34 +788,167 @@ void GLSDLHelper::renderBillboardSpriteUV(
     const float uMax = std::max(uvRect.x, uvRect.z);
     const float vMax = std::max(uvRect.y, uvRect.w);
 
-    billboardShader.setUniform("ModelViewMatrix", modelViewMatrix);
-    billboardShader.setUniform("ProjectionMatrix", projMatrix);
-    billboardShader.setUniform("Size2", halfSize);
-    billboardShader.setUniform("SizeXY", halfSizeXY);
-    billboardShader.setUniform("UseWorldAxes", static_cast<GLint>(useWorldAxes ? 1 : 0));
-    billboardShader.setUniform("ViewMatrix", viewMatrix);
-    billboardShader.setUniform("RightAxisWS", glm::normalize(rightAxisWS));
-    billboardShader.setUniform("UpAxisWS", glm::normalize(upAxisWS));
-    billboardShader.setUniform("DoubleSided", static_cast<GLint>(doubleSided ? 1 : 0));
-    billboardShader.setUniform("TexRect", glm::vec4(uMin, vMin, uMax, vMax));
-    billboardShader.setUniform("SpriteTex", static_cast<GLint>(0));
-    billboardShader.setUniform("TintColor", tintColor);
-    billboardShader.setUniform("FlipX", static_cast<GLint>(flipX ? 1 : 0));
-    billboardShader.setUniform("FlipY", static_cast<GLint>(flipY ? 1 : 0));
-    billboardShader.setUniform("UseRedAsAlpha", static_cast<GLint>(useRedAsAlpha ? 1 : 0));
-    billboardShader.setUniform("uOITPass", static_cast<GLint>(sBillboardOITPass ? 1 : 0));
-    billboardShader.setUniform("uOITWeightScale", 6.0f);
-
-    GLint prevActiveTexture = GL_TEXTURE0;
-    glGetIntegerv(GL_ACTIVE_TEXTURE, &prevActiveTexture);
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, textureId);
-
-    glBindVertexArray(sBillboardVAO);
-    glDrawArrays(GL_POINTS, 0, 1);
-    glBindVertexArray(0);
-
-    glActiveTexture(static_cast<GLenum>(prevActiveTexture));
+    billboardShader.setUniform(sBillboardUniforms.instanced, 0);
+    billboardShader.setUniform(sBillboardUniforms.modelViewMatrix, modelViewMatrix);
+    billboardShader.setUniform(sBillboardUniforms.size2, halfSize);
+    billboardShader.setUniform(sBillboardUniforms.sizeXY, halfSizeXY);
+    billboardShader.setUniform(sBillboardUniforms.useWorldAxes, static_cast<GLint>(useWorldAxes ? 1 : 0));
+    billboardShader.setUniform(sBillboardUniforms.rightAxisWS, glm::normalize(rightAxisWS));
+    billboardShader.setUniform(sBillboardUniforms.upAxisWS, glm::normalize(upAxisWS));
+    billboardShader.setUniform(sBillboardUniforms.doubleSided, static_cast<GLint>(doubleSided ? 1 : 0));
+    billboardShader.setUniform(sBillboardUniforms.texRect, glm::vec4(uMin, vMin, uMax, vMax));
+    billboardShader.setUniform(sBillboardUniforms.spriteTex, static_cast<GLint>(0));
+    billboardShader.setUniform(sBillboardUniforms.tintColor, tintColor);
+    billboardShader.setUniform(sBillboardUniforms.flipX, static_cast<GLint>(flipX ? 1 : 0));
+    billboardShader.setUniform(sBillboardUniforms.flipY, static_cast<GLint>(flipY ? 1 : 0));
+    billboardShader.setUniform(sBillboardUniforms.useRedAsAlpha, static_cast<GLint>(useRedAsAlpha ? 1 : 0));
+    billboardShader.setUniform(sBillboardUniforms.oitPass, static_cast<GLint>(sBillboardOITPass ? 1 : 0));
+    billboardShader.setUniform(sBillboardUniforms.oitWeightScale, 6.0f);
+
+    const GLenum prevActiveTexture = GLStateCache::getActiveTexture();
+    GLStateCache::activeTexture(GL_TEXTURE0);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, textureId);
+
+    GLStateCache::bindVertexArray(sBillboardVAO);
+    RenderStats::drawArrays(GL_POINTS, 0, 1);
+    GLStateCache::bindVertexArray(0);
+
+    GLStateCache::activeTexture(prevActiveTexture);
+}
+
+void GLSDLHelper::renderBillboardInstances(
+    Shader &billboardShader,
+    GLuint textureId,
+    const BillboardInstance *instances,
+    std::size_t instanceCount,
+    bool flipX,
+    bool flipY,
+    bool useRedAsAlpha,
+    bool doubleSided) noexcept
+{
+    if (!sBillboardInitialized)
+    {
+        initializeBillboardRendering();
+    }
+
+    if (textureId == 0 || instances == nullptr || instanceCount == 0)
+    {
+        return;
+    }
+
+    billboardShader.bind();
+    resolveBillboardUniforms(billboardShader);
+
+    billboardShader.setUniform(sBillboardUniforms.instanced, 1);
+    billboardShader.setUniform(sBillboardUniforms.useWorldAxes, 0);
+    billboardShader.setUniform(sBillboardUniforms.doubleSided, static_cast<GLint>(doubleSided ? 1 : 0));
+    billboardShader.setUniform(sBillboardUniforms.spriteTex, static_cast<GLint>(0));
+    billboardShader.setUniform(sBillboardUniforms.flipX, static_cast<GLint>(flipX ? 1 : 0));
+    billboardShader.setUniform(sBillboardUniforms.flipY, static_cast<GLint>(flipY ? 1 : 0));
+    billboardShader.setUniform(sBillboardUniforms.useRedAsAlpha, static_cast<GLint>(useRedAsAlpha ? 1 : 0));
+    billboardShader.setUniform(sBillboardUniforms.oitPass, static_cast<GLint>(sBillboardOITPass ? 1 : 0));
+    billboardShader.setUniform(sBillboardUniforms.oitWeightScale, 6.0f);
+
+    // Stride-aligned so the offset is a whole instance index for baseInstance
+    constexpr auto stride = static_cast<GLsizeiptr>(sizeof(BillboardInstance));
+    const GLintptr offset = getFrameStream().write(instances, static_cast<GLsizeiptr>(instanceCount) * stride, stride);
+    if (offset == StreamingBuffer::INVALID_OFFSET)
+    {
+        return;
+    }
+
+    const GLenum prevActiveTexture = GLStateCache::getActiveTexture();
+    GLStateCache::activeTexture(GL_TEXTURE0);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, textureId);
+
+    GLStateCache::bindVertexArray(sBillboardBatchVAO);
+    RenderStats::drawArraysInstancedBaseInstance(GL_POINTS, 0, 1, static_cast<GLsizei>(instanceCount),
+                                                 static_cast<GLuint>(offset / stride));
+    GLStateCache::bindVertexArray(0);
+
+    GLStateCache::activeTexture(prevActiveTexture);
+}
+
+FrameUniforms GLSDLHelper::makeFrameUniforms(const glm::mat4 &view, const glm::mat4 &projection,
+                                             const glm::vec3 &cameraPosition, float timeSeconds,
+                                             int viewportWidth, int viewportHeight) noexcept
+{
+    FrameUniforms frame;
+    frame.view = view;
+    frame.projection = projection;
+    frame.viewProjection = projection * view;
+    frame.cameraPosition = cameraPosition;
+    frame.timeSeconds = timeSeconds;
+    frame.viewportSize = glm::vec2(static_cast<float>(std::max(1, viewportWidth)),
+                                   static_cast<float>(std::max(1, viewportHeight)));
+    frame.invViewportSize = 1.0f / frame.viewportSize;
+    return frame;
+}
+
+void GLSDLHelper::updateFrameUniforms(const FrameUniforms &frame) noexcept
+{
+    // Each update gets its own slice of the ring, so a second camera this frame never overwrites the first
+    if (sUniformOffsetAlignment == 0)
+    {
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &sUniformOffsetAlignment);
+        sUniformOffsetAlignment = std::max(sUniformOffsetAlignment, 1);
+    }
+
+    StreamingBuffer &stream = getFrameStream();
+    const GLintptr offset = stream.write(&frame, sizeof(FrameUniforms), sUniformOffsetAlignment);
+    if (offset != StreamingBuffer::INVALID_OFFSET)
+    {
+        glBindBufferRange(GL_UNIFORM_BUFFER, FRAME_UNIFORMS_BINDING, stream.getBuffer(), offset, sizeof(FrameUniforms));
+        return;
+    }
+
+    if (sFrameUniformBuffer == 0)
+    {
+        glGenBuffers(1, &sFrameUniformBuffer);
+    }
+
+    // Respecify the whole buffer so the driver can orphan last frame's copy instead of stalling
+    glBindBuffer(GL_UNIFORM_BUFFER, sFrameUniformBuffer);
+    RenderStats::bufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniforms), &frame, GL_STREAM_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_UNIFORMS_BINDING, sFrameUniformBuffer);
+}
+
+void GLSDLHelper::cleanupFrameUniforms() noexcept
+{
+    if (sFrameUniformBuffer != 0)
+    {
+        glDeleteBuffers(1, &sFrameUniformBuffer);
+        sFrameUniformBuffer = 0;
+    }
+}
+
+void GLSDLHelper::beginStreamingFrame() noexcept
+{
+    getFrameStream().beginFrame();
+}
+
+void GLSDLHelper::endStreamingFrame() noexcept
+{
+    if (sFrameStream.isInitialized())
+    {
+        sFrameStream.endFrame();
+    }
+}
+
+StreamingBuffer &GLSDLHelper::getFrameStream() noexcept
+{
+    if (!sFrameStream.isInitialized())
+    {
+        sFrameStream.init(FRAME_STREAM_REGION_BYTES);
+    }
+    return sFrameStream;
+}
+
+void GLSDLHelper::cleanupStreaming() noexcept
+{
+    sFrameStream.destroy();
+    sUniformOffsetAlignment = 0;
 }
 
 bool GLSDLHelper::isBillboardInitialized() noexcept
@@ -1,6 +1,7 @@
 #ifndef GLSDL_HELPER_HPP
 #define GLSDL_HELPER_HPP
 
+#include <cstddef>
 #include <mutex>
 #include <optional>
 #include <string_view>
@@ -9,14 +10,46 @@
 #include <glm/glm.hpp>
 #include <SDL3/SDL.h>
 
+#include "StreamingBuffer.hpp"
+
 struct AnimationRect;
 struct SDL_Window;
 
 class Shader;
 
+/// @brief Per-frame camera/scene data shared by every shader through one uniform buffer
+/// @details Layout matches the std140 FrameUniforms block in shaders/frame_uniforms.glsl
+struct FrameUniforms
+{
+    glm::mat4 view{1.0f};
+    glm::mat4 projection{1.0f};
+    glm::mat4 viewProjection{1.0f};
+    glm::vec3 cameraPosition{0.0f};
+    float timeSeconds{0.0f};
+    glm::vec2 viewportSize{1.0f};
+    glm::vec2 invViewportSize{1.0f};
+};
+
+static_assert(sizeof(FrameUniforms) == 224, "FrameUniforms must match the std140 block layout");
+
+/// @brief One screen-aligned sprite in an instanced billboard draw
+/// @details Read by billboard.vert.glsl as per-instance attributes 1-4
+struct BillboardInstance
+{
+    glm::vec3 center{0.0f};
+    glm::vec2 halfSize{0.5f};
+    glm::vec4 texRect{0.0f, 0.0f, 1.0f, 1.0f};
+    glm::vec4 tint{1.0f};
+};
+
 class GLSDLHelper
 {
 public:
+    /// Uniform buffer binding point declared by shaders/frame_uniforms.glsl
+    static constexpr GLuint FRAME_UNIFORMS_BINDING = 0;
+    /// Per-frame budget of the shared streaming ring (billboard instances, frame uniforms)
+    static constexpr GLsizeiptr FRAME_STREAM_REGION_BYTES = 1 << 20;
+
     void init(std::string_view title, int width, int height) noexcept;
 
     void destroyAndQuit() noexcept;
@@ -77,8 +110,7 @@ public:
     /// @param frameRect Current animation frame rectangle
     /// @param worldPosition 3D position in world space
     /// @param size Half-size of the billboard
-    /// @param viewMatrix Camera view matrix
-    /// @param projMatrix Camera projection matrix
+    /// @param viewMatrix Camera view matrix (projection comes from the frame uniform buffer)
     /// @param sheetWidth Total width of sprite sheet in pixels
     /// @param sheetHeight Total height of sprite sheet in pixels
     static void renderBillboardSprite(
@@ -88,10 +120,21 @@ public:
         const glm::vec3 &worldPosition,
         float halfSize,
         const glm::mat4 &viewMatrix,
-        const glm::mat4 &projMatrix,
         int sheetWidth,
         int sheetHeight) noexcept;
 
+    /// Draw many camera-facing sprites that share a texture in one instanced call
+    /// @details Blend/depth state is left to the caller (see BillboardBatch)
+    static void renderBillboardInstances(
+        Shader &billboardShader,
+        GLuint textureId,
+        const BillboardInstance *instances,
+        std::size_t instanceCount,
+        bool flipX,
+        bool flipY,
+        bool useRedAsAlpha,
+        bool doubleSided) noexcept;
+
     /// Render billboard using explicit UV rect (u0, v0, u1, v1) with tint and optional alpha-mask sampling
     static void renderBillboardSpriteUV(
         Shader &billboardShader,
@@ -100,7 +143,6 @@ public:
         const glm::vec3 &worldPosition,
         float halfSize,
         const glm::mat4 &viewMatrix,
-        const glm::mat4 &projMatrix,
         const glm::vec4 &tintColor,
         bool flipX,
         bool flipY,
@@ -111,11 +153,42 @@ public:
         const glm::vec3 &upAxisWS = glm::vec3(0.0f, 1.0f, 0.0f),
         bool doubleSided = false) noexcept;
 
+    // ========================================================================
+    // Per-frame uniform buffer
+    // ========================================================================
+
+    /// Build frame data from camera matrices; viewProjection and inverse viewport are derived
+    [[nodiscard]] static FrameUniforms makeFrameUniforms(const glm::mat4 &view, const glm::mat4 &projection,
+                                                         const glm::vec3 &cameraPosition, float timeSeconds,
+                                                         int viewportWidth, int viewportHeight) noexcept;
+
+    /// Upload frame data once and bind it at FRAME_UNIFORMS_BINDING for all subsequent draws
+    static void updateFrameUniforms(const FrameUniforms &frame) noexcept;
+
+    /// Release the frame uniform buffer
+    static void cleanupFrameUniforms() noexcept;
+
+    // ========================================================================
+    // Per-frame streaming ring
+    // ========================================================================
+
+    /// Start a frame's dynamic uploads; waits only if the GPU is still reading the region being reused
+    static void beginStreamingFrame() noexcept;
+
+    /// Fence the dynamic data written since beginStreamingFrame()
+    static void endStreamingFrame() noexcept;
+
+    /// Shared ring for data rewritten every frame; created on first use with a current GL context
+    [[nodiscard]] static StreamingBuffer &getFrameStream() noexcept;
+
+    static void cleanupStreaming() noexcept;
+
     /// Check if billboard rendering is initialized
     [[nodiscard]] static bool isBillboardInitialized() noexcept;
 
     /// Toggle billboard shader OIT output mode for weighted blended transparency passes
     static void setBillboardOITPass(bool enabled) noexcept;
+    [[nodiscard]] static bool isBillboardOITPass() noexcept { return sBillboardOITPass; }
 
 private:
     std::once_flag mInitializedFlag;
@@ -126,8 +199,14 @@ private:
     // Billboard sprite rendering resources
     static GLuint sBillboardVAO;
     static GLuint sBillboardVBO;
+    static GLuint sBillboardBatchVAO;
     static bool sBillboardInitialized;
     static bool sBillboardOITPass;
+
+    static GLuint sFrameUniformBuffer;
+    static GLint sUniformOffsetAlignment;
+
+    static StreamingBuffer sFrameStream;
 };
 
 #endif // GLSDL_HELPER_HPP
@@ -0,0 +1,258 @@
+#include "GLStateCache.hpp"
+
+#include <algorithm>
+
+#include "RenderStats.hpp"
+
+GLStateCache::State GLStateCache::sState{};
+GLStateCache::Stats GLStateCache::sStats{};
+
+void GLStateCache::invalidate() noexcept
+{
+    sState = State{};
+}
+
+GLStateCache::Tri *GLStateCache::capSlot(GLenum cap) noexcept
+{
+    switch (cap)
+    {
+    case GL_BLEND:
+        return &sState.blend;
+    case GL_DEPTH_TEST:
+        return &sState.depthTest;
+    case GL_CULL_FACE:
+        return &sState.cullFace;
+    case GL_STENCIL_TEST:
+        return &sState.stencilTest;
+    default:
+        return nullptr;
+    }
+}
+
+void GLStateCache::setEnabled(GLenum cap, bool enabled) noexcept
+{
+    Tri *slot = capSlot(cap);
+    const Tri wanted = enabled ? Tri::ON : Tri::OFF;
+    if (slot && *slot == wanted)
+    {
+        ++sStats.skipped;
+        return;
+    }
+
+    if (enabled)
+    {
+        glEnable(cap);
+    }
+    else
+    {
+        glDisable(cap);
+    }
+    ++sStats.issued;
+
+    if (slot)
+    {
+        *slot = wanted;
+    }
+}
+
+bool GLStateCache::isEnabled(GLenum cap) noexcept
+{
+    Tri *slot = capSlot(cap);
+    if (!slot)
+    {
+        ++sStats.queries;
+        return glIsEnabled(cap) == GL_TRUE;
+    }
+
+    if (*slot == Tri::UNKNOWN)
+    {
+        ++sStats.queries;
+        *slot = (glIsEnabled(cap) == GL_TRUE) ? Tri::ON : Tri::OFF;
+    }
+    return *slot == Tri::ON;
+}
+
+void GLStateCache::depthMask(bool writeDepth) noexcept
+{
+    const Tri wanted = writeDepth ? Tri::ON : Tri::OFF;
+    if (sState.depthMask == wanted)
+    {
+        ++sStats.skipped;
+        return;
+    }
+
+    glDepthMask(writeDepth ? GL_TRUE : GL_FALSE);
+    ++sStats.issued;
+    sState.depthMask = wanted;
+}
+
+void GLStateCache::depthFunc(GLenum func) noexcept
+{
+    if (sState.depthFunc == func)
+    {
+        ++sStats.skipped;
+        return;
+    }
+
+    glDepthFunc(func);
+    ++sStats.issued;
+    sState.depthFunc = func;
+}
+
+void GLStateCache::blendFunc(GLenum srcFactor, GLenum dstFactor) noexcept
+{
+    if (sState.blendSrc == srcFactor && sState.blendDst == dstFactor)
+    {
+        ++sStats.skipped;
+        return;
+    }
+
+    glBlendFunc(srcFactor, dstFactor);
+    ++sStats.issued;
+    sState.blendSrc = srcFactor;
+    sState.blendDst = dstFactor;
+}
+
+void GLStateCache::useProgram(GLuint program) noexcept
+{
+    if (sState.program == program)
+    {
+        ++sStats.skipped;
+        return;
+    }
+
+    glUseProgram(program);
+    ++sStats.issued;
+    RenderStats::countProgramBind();
+    sState.program = program;
+}
+
+void GLStateCache::bindVertexArray(GLuint vao) noexcept
+{
+    if (sState.vertexArray == vao)
+    {
+        ++sStats.skipped;
+        return;
+    }
+
+    glBindVertexArray(vao);
+    ++sStats.issued;
+    RenderStats::countVertexArrayBind();
+    sState.vertexArray = vao;
+}
+
+void GLStateCache::activeTexture(GLenum unit) noexcept
+{
+    if (sState.activeTexture == unit)
+    {
+        ++sStats.skipped;
+        return;
+    }
+
+    glActiveTexture(unit);
+    ++sStats.issued;
+    sState.activeTexture = unit;
+}
+
+void GLStateCache::bindTexture(GLenum target, GLuint texture) noexcept
+{
+    if (target != GL_TEXTURE_2D)
+    {
+        glBindTexture(target, texture);
+        ++sStats.issued;
+        RenderStats::countTextureBind();
+        return;
+    }
+
+    const std::size_t unit = static_cast<std::size_t>(getActiveTexture() - GL_TEXTURE0);
+    if (unit < MAX_TEXTURE_UNITS && sState.texture2D[unit] == texture)
+    {
+        ++sStats.skipped;
+        return;
+    }
+
+    glBindTexture(target, texture);
+    ++sStats.issued;
+    RenderStats::countTextureBind();
+    if (unit < MAX_TEXTURE_UNITS)
+    {
+        sState.texture2D[unit] = texture;
+    }
+}
+
+void GLStateCache::forgetProgram(GLuint program) noexcept
+{
+    // Deleting the current program leaves it in use until another is bound, so only the name is stale
+    if (sState.program == program)
+    {
+        sState.program = UNKNOWN_NAME;
+    }
+}
+
+void GLStateCache::forgetVertexArray(GLuint vao) noexcept
+{
+    // glDeleteVertexArrays reverts a bound VAO to 0
+    if (sState.vertexArray == vao)
+    {
+        sState.vertexArray = 0;
+    }
+}
+
+void GLStateCache::forgetTexture(GLuint texture) noexcept
+{
+    // glDeleteTextures reverts every unit it was bound to back to 0
+    std::replace(sState.texture2D.begin(), sState.texture2D.end(), texture, 0u);
+}
+
+GLStateCache::Snapshot GLStateCache::save() noexcept
+{
+    Snapshot snapshot;
+    snapshot.blend = isEnabled(GL_BLEND);
+    snapshot.depthTest = isEnabled(GL_DEPTH_TEST);
+    snapshot.cullFace = isEnabled(GL_CULL_FACE);
+    snapshot.stencilTest = isEnabled(GL_STENCIL_TEST);
+
+    if (sState.depthMask == Tri::UNKNOWN)
+    {
+        GLboolean mask = GL_TRUE;
+        glGetBooleanv(GL_DEPTH_WRITEMASK, &mask);
+        ++sStats.queries;
+        sState.depthMask = (mask == GL_TRUE) ? Tri::ON : Tri::OFF;
+    }
+    snapshot.depthMask = sState.depthMask == Tri::ON;
+
+    if (sState.depthFunc == UNKNOWN_ENUM)
+    {
+        GLint func = GL_LESS;
+        glGetIntegerv(GL_DEPTH_FUNC, &func);
+        ++sStats.queries;
+        sState.depthFunc = static_cast<GLenum>(func);
+    }
+    snapshot.depthFunc = sState.depthFunc;
+    snapshot.activeTexture = getActiveTexture();
+
+    return snapshot;
+}
+
+void GLStateCache::restore(const Snapshot &snapshot) noexcept
+{
+    setEnabled(GL_BLEND, snapshot.blend);
+    setEnabled(GL_DEPTH_TEST, snapshot.depthTest);
+    setEnabled(GL_CULL_FACE, snapshot.cullFace);
+    setEnabled(GL_STENCIL_TEST, snapshot.stencilTest);
+    depthMask(snapshot.depthMask);
+    depthFunc(snapshot.depthFunc);
+    activeTexture(snapshot.activeTexture);
+}
+
+GLenum GLStateCache::getActiveTexture() noexcept
+{
+    if (sState.activeTexture == UNKNOWN_ENUM)
+    {
+        GLint unit = GL_TEXTURE0;
+        glGetIntegerv(GL_ACTIVE_TEXTURE, &unit);
+        ++sStats.queries;
+        sState.activeTexture = static_cast<GLenum>(unit);
+    }
+    return sState.activeTexture;
+}
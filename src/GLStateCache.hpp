@@ -0,0 +1,112 @@
+#ifndef GL_STATE_CACHE_HPP
+#define GL_STATE_CACHE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <glad/glad.h>
+
+/// @brief Shadow copy of the GL state the draw helpers toggle most often
+/// @details Redundant glEnable/glBindTexture/glUseProgram calls are skipped, and
+/// save/restore reads the shadow instead of glGet* (which can stall the driver).
+/// State starts unknown and is queried lazily once; invalidate() drops the shadow
+/// when code outside the cache (ImGui, context changes) may have touched GL.
+class GLStateCache
+{
+public:
+    static constexpr std::size_t MAX_TEXTURE_UNITS = 16;
+
+    struct Stats
+    {
+        std::uint64_t issued{0};
+        std::uint64_t skipped{0};
+        std::uint64_t queries{0};
+    };
+
+    /// Captured by save(), re-applied by restore(); copying it issues no GL calls
+    struct Snapshot
+    {
+        bool blend{false};
+        bool depthTest{false};
+        bool cullFace{false};
+        bool stencilTest{false};
+        bool depthMask{true};
+        GLenum depthFunc{GL_LESS};
+        GLenum activeTexture{GL_TEXTURE0};
+    };
+
+    /// Forget everything so the next call of each kind hits GL unconditionally
+    static void invalidate() noexcept;
+
+    static void enable(GLenum cap) noexcept { setEnabled(cap, true); }
+    static void disable(GLenum cap) noexcept { setEnabled(cap, false); }
+    /// Tracked caps: GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE, GL_STENCIL_TEST; others pass through
+    static void setEnabled(GLenum cap, bool enabled) noexcept;
+    [[nodiscard]] static bool isEnabled(GLenum cap) noexcept;
+
+    static void depthMask(bool writeDepth) noexcept;
+    static void depthFunc(GLenum func) noexcept;
+    static void blendFunc(GLenum srcFactor, GLenum dstFactor) noexcept;
+
+    static void useProgram(GLuint program) noexcept;
+    static void bindVertexArray(GLuint vao) noexcept;
+    static void activeTexture(GLenum unit) noexcept;
+    /// Only GL_TEXTURE_2D bindings are shadowed; other targets pass through
+    static void bindTexture(GLenum target, GLuint texture) noexcept;
+
+    /// Call before glDelete* so a recycled name is never mistaken for the bound one
+    static void forgetProgram(GLuint program) noexcept;
+    static void forgetVertexArray(GLuint vao) noexcept;
+    static void forgetTexture(GLuint texture) noexcept;
+
+    [[nodiscard]] static GLenum getActiveTexture() noexcept;
+
+    [[nodiscard]] static Snapshot save() noexcept;
+    static void restore(const Snapshot &snapshot) noexcept;
+
+    [[nodiscard]] static const Stats &getStats() noexcept { return sStats; }
+    static void resetStats() noexcept { sStats = {}; }
+
+private:
+    enum class Tri : std::uint8_t
+    {
+        UNKNOWN,
+        OFF,
+        ON
+    };
+
+    // Sentinel for "binding not known"; no GL object name can take this value
+    static constexpr GLuint UNKNOWN_NAME = 0xFFFFFFFFu;
+    static constexpr GLenum UNKNOWN_ENUM = 0xFFFFFFFFu;
+
+    struct State
+    {
+        Tri blend{Tri::UNKNOWN};
+        Tri depthTest{Tri::UNKNOWN};
+        Tri cullFace{Tri::UNKNOWN};
+        Tri stencilTest{Tri::UNKNOWN};
+        Tri depthMask{Tri::UNKNOWN};
+        GLenum depthFunc{UNKNOWN_ENUM};
+        GLenum blendSrc{UNKNOWN_ENUM};
+        GLenum blendDst{UNKNOWN_ENUM};
+        GLuint program{UNKNOWN_NAME};
+        GLuint vertexArray{UNKNOWN_NAME};
+        GLenum activeTexture{UNKNOWN_ENUM};
+        std::array<GLuint, MAX_TEXTURE_UNITS> texture2D{unknownTextureUnits()};
+    };
+
+    [[nodiscard]] static constexpr std::array<GLuint, MAX_TEXTURE_UNITS> unknownTextureUnits() noexcept
+    {
+        std::array<GLuint, MAX_TEXTURE_UNITS> units{};
+        units.fill(UNKNOWN_NAME);
+        return units;
+    }
+
+    [[nodiscard]] static Tri *capSlot(GLenum cap) noexcept;
+
+    static State sState;
+    static Stats sStats;
+};
+
+#endif // GL_STATE_CACHE_HPP
@@ -15,15 +15,51 @@
 #include <algorithm>
 #include <cctype>
 #include <cmath>
+#include <cstdio>
 #include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <limits>
 #include <string>
 #include <utility>
 
+#include "AssetPack.hpp"
+#include "GLSDLHelper.hpp"
+#include "GLStateCache.hpp"
+#include "MeshOptimizer.hpp"
+#include "MeshSimplifier.hpp"
+#include "RenderStats.hpp"
 #include "Shader.hpp"
+#include "StreamingBuffer.hpp"
 
 namespace
 {
+    /// Packed vertices address bone ids as bytes
+    constexpr std::uint32_t kMaxPackedBoneId = 255;
+
+    std::uint32_t packSnorm10(const glm::vec3 &n) noexcept
+    {
+        const glm::ivec3 q = glm::ivec3(glm::round(glm::clamp(n, glm::vec3(-1.0f), glm::vec3(1.0f)) * 511.0f));
+        return (static_cast<std::uint32_t>(q.x) & 0x3FFu) | ((static_cast<std::uint32_t>(q.y) & 0x3FFu) << 10) |
+               ((static_cast<std::uint32_t>(q.z) & 0x3FFu) << 20);
+    }
+
+    std::uint16_t packUnorm16(float value) noexcept
+    {
+        return static_cast<std::uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+    }
+
+    GLint storageOffsetAlignment() noexcept
+    {
+        static GLint alignment = 0;
+        if (alignment == 0)
+        {
+            glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+            alignment = std::max(alignment, 1);
+        }
+        return alignment;
+    }
+
     void resolveRayTraceMaterial(const aiMaterial *material, glm::vec4 &albedoAndMaterial, glm::vec4 &materialParams) noexcept
     {
         glm::vec3 albedo(0.78f, 0.80f, 0.88f);
@@ -121,6 +157,31 @@ namespace
         return std::clamp(factor, 0.0f, 1.0f);
     }
 
+    /// @brief First key interval [i, i + 1] that ends after animationTime, clamped to the last interval
+    /// @details Starts from the interval found last time: keys are sorted, so every earlier interval ended
+    /// before animationTime too. A time before the cursor (the clip looped or restarted) rescans from key 0.
+    template <typename Key>
+    std::uint32_t seekKeyInterval(const Key *keys, std::uint32_t keyCount, float animationTime, std::uint32_t &cursor) noexcept
+    {
+        if (keyCount < 2)
+        {
+            return 0;
+        }
+
+        std::uint32_t index = std::min(cursor, keyCount - 2);
+        if (animationTime < keys[index].time)
+        {
+            index = 0;
+        }
+        while (index + 2 < keyCount && animationTime >= keys[index + 1].time)
+        {
+            ++index;
+        }
+
+        cursor = index;
+        return index;
+    }
+
     void collectMeshNodeTransforms(const aiNode *node,
                                    const glm::mat4 &parent,
                                    std::vector<glm::mat4> &meshNodeTransforms,
@@ -341,6 +402,121 @@ namespace
         return canonical;
     }
 
+    /// Appends plain-data values (glm types included), arrays of them and strings to a byte buffer
+    class CacheWriter
+    {
+    public:
+        template <typename T>
+        void pod(const T &value)
+        {
+            const auto *bytes = reinterpret_cast<const std::uint8_t *>(&value);
+            mBytes.insert(mBytes.end(), bytes, bytes + sizeof(T));
+        }
+
+        template <typename T>
+        void array(const std::vector<T> &values)
+        {
+            pod(static_cast<std::uint32_t>(values.size()));
+            const auto *bytes = reinterpret_cast<const std::uint8_t *>(values.data());
+            mBytes.insert(mBytes.end(), bytes, bytes + values.size() * sizeof(T));
+        }
+
+        void string(const std::string &value)
+        {
+            pod(static_cast<std::uint32_t>(value.size()));
+            mBytes.insert(mBytes.end(), value.begin(), value.end());
+        }
+
+        [[nodiscard]] const std::vector<std::uint8_t> &bytes() const noexcept { return mBytes; }
+
+    private:
+        std::vector<std::uint8_t> mBytes;
+    };
+
+    /// Reads what CacheWriter wrote; any overrun latches ok() to false and later reads return defaults
+    class CacheReader
+    {
+    public:
+        explicit CacheReader(std::span<const std::uint8_t> data) noexcept
+            : mData{data}
+        {
+        }
+
+        template <typename T>
+        T pod() noexcept
+        {
+            T value{};
+            if (take(sizeof(T)))
+            {
+                std::memcpy(&value, mData.data() + mOffset - sizeof(T), sizeof(T));
+            }
+            return value;
+        }
+
+        template <typename T>
+        void array(std::vector<T> &values)
+        {
+            const auto count = static_cast<std::size_t>(pod<std::uint32_t>());
+            values.clear();
+            if (count == 0 || !take(count * sizeof(T)))
+            {
+                return;
+            }
+            values.resize(count);
+            std::memcpy(values.data(), mData.data() + mOffset - count * sizeof(T), count * sizeof(T));
+        }
+
+        std::string string()
+        {
+            const auto length = static_cast<std::size_t>(pod<std::uint32_t>());
+            if (!take(length))
+            {
+                return {};
+            }
+            return std::string(reinterpret_cast<const char *>(mData.data() + mOffset - length), length);
+        }
+
+        /// Element count of a following list; one that could not fit in the remaining bytes fails the read
+        std::size_t count() noexcept
+        {
+            const auto value = static_cast<std::size_t>(pod<std::uint32_t>());
+            if (value > mData.size() - mOffset)
+            {
+                mOk = false;
+                return 0;
+            }
+            return value;
+        }
+
+        [[nodiscard]] bool ok() const noexcept { return mOk; }
+        [[nodiscard]] bool atEnd() const noexcept { return mOffset == mData.size(); }
+
+    private:
+        bool take(std::size_t bytes) noexcept
+        {
+            if (!mOk || bytes > mData.size() - mOffset)
+            {
+                mOk = false;
+                return false;
+            }
+            mOffset += bytes;
+            return true;
+        }
+
+        std::span<const std::uint8_t> mData;
+        std::size_t mOffset{0};
+        bool mOk{true};
+    };
+
+    /// Cache file header; the payload follows directly
+    struct ModelCacheHeader
+    {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint64_t sourceStamp;
+        std::uint64_t payloadSize;
+    };
+
     float mat4DifferenceScore(const glm::mat4 &a, const glm::mat4 &b) noexcept
     {
         float total = 0.0f;
@@ -355,6 +531,8 @@ namespace
     }
 }
 
+std::string GLTFModel::sCacheDirectory;
+
 GLTFModel::GLTFModel() = default;
 
 GLTFModel::~GLTFModel()
@@ -363,25 +541,103 @@ GLTFModel::~GLTFModel()
     mImporter.reset();  // Explicitly release the importer before other cleanup
 }
 
+void GLTFModel::setCacheDirectory(const std::string &directory)
+{
+    sCacheDirectory = directory;
+    if (!sCacheDirectory.empty() && sCacheDirectory.back() != '/' && sCacheDirectory.back() != '\\')
+    {
+        sCacheDirectory += '/';
+    }
+}
+
+bool GLTFModel::hasCacheDirectory() noexcept
+{
+    return !sCacheDirectory.empty();
+}
+
 bool GLTFModel::readFile(std::string_view filename)
 {
-    clearGpuBuffers();
-    mCpuMeshes.clear();
-    mBoneMapping.clear();
-    mCanonicalBoneMapping.clear();
-    mBoneOffsets.clear();
-    mBoneMeshNodeTransforms.clear();
-    mPreferredAnimationIndex = -1;
-    
+    if (!importFile(filename))
+    {
+        return false;
+    }
+    upload();
+    return true;
+}
+
+bool GLTFModel::importFile(std::string_view filename)
+{
+    const auto clearModelData = [this]() {
+        clearGpuBuffers();
+        mMeshNames.clear();
+        mTotalMeshBones = 0;
+        mBoneMapping.clear();
+        mCanonicalBoneMapping.clear();
+        mBoneOffsets.clear();
+        mBoneMeshNodeTransforms.clear();
+        mJoints.clear();
+        mAnimationBindings.clear();
+        mMappedPoseAnimations.clear();
+        mPreferredAnimationIndex = -1;
+        mGlobalInverseTransform = glm::mat4(1.0f);
+    };
+    clearModelData();
+
+    const std::string cachePath = cachePathFor(filename);
+    const std::uint64_t stamp = cachePath.empty() ? 0 : sourceStamp(filename);
+    const bool fromCache = stamp != 0 && readCache(cachePath, stamp);
+    if (!fromCache)
+    {
+        clearModelData();
+        const bool imported = importScene(filename);
+        // Everything later frames need has been copied out of the scene
+        mScene = nullptr;
+        mImporter.reset();
+        if (!imported)
+        {
+            clearModelData();
+            return false;
+        }
+        if (stamp != 0)
+        {
+            writeCache(cachePath, stamp);
+        }
+    }
+
+    SDL_Log("GLTFModel: %s '%.*s'", fromCache ? "loaded cached" : "imported", static_cast<int>(filename.size()),
+            filename.data());
+    return true;
+}
+
+void GLTFModel::upload()
+{
+    uploadMeshes();
+    computeBounds();
+    createSkinningBuffers();
+    mJointScratch.resize(mJoints.size());
+}
+
+bool GLTFModel::importScene(std::string_view filename)
+{
+    constexpr unsigned int importFlags = aiProcess_Triangulate |
+                                         aiProcess_GenSmoothNormals |
+                                         aiProcess_FlipUVs |
+                                         aiProcess_CalcTangentSpace |
+                                         aiProcess_JoinIdenticalVertices |
+                                         aiProcess_LimitBoneWeights;
+
     mImporter = std::make_unique<Assimp::Importer>();
-    mScene = mImporter->ReadFile(
-        filename.data(),
-        aiProcess_Triangulate |
-            aiProcess_GenSmoothNormals |
-            aiProcess_FlipUVs |
-            aiProcess_CalcTangentSpace |
-            aiProcess_JoinIdenticalVertices |
-            aiProcess_LimitBoneWeights);
+    if (const auto packed = AssetPack::find(filename); !packed.empty())
+    {
+        // Self-contained formats only (.glb); the extension tells Assimp which importer to use
+        const std::string hint = std::filesystem::path(std::string(filename)).extension().string();
+        mScene = mImporter->ReadFileFromMemory(packed.data(), packed.size(), importFlags,
+                                               hint.empty() ? "" : hint.c_str() + 1);
+    }
+    else
+    {
+        mScene = mImporter->ReadFile(filename.data(), importFlags);
+    }
 
     if (!mScene || !mScene->mRootNode || mScene->mNumMeshes == 0)
     {
@@ -397,11 +653,12 @@ bool GLTFModel::readFile(std::string_view filename)
     mGlobalInverseTransform = glm::inverse(rootTransform);
 
     buildMeshesFromScene(mScene);
+    compileSkeleton();
 
     if (!mBoneOffsets.empty() && mScene->mRootNode)
     {
-        std::unordered_map<std::string, glm::mat4> bindPoseNodeGlobals;
-        buildNodeTransformMap(0.0f, mScene->mRootNode, glm::mat4(1.0f), nullptr, bindPoseNodeGlobals);
+        std::vector<glm::mat4> bindPoseNodeGlobals;
+        sampleJoints(nullptr, 0.0f, bindPoseNodeGlobals);
 
         auto matrixError = [](const glm::mat4 &a, const glm::mat4 &b) noexcept
         {
@@ -425,13 +682,13 @@ bool GLTFModel::readFile(std::string_view filename)
             float bestErr = std::numeric_limits<float>::infinity();
             std::string bestNodeName;
 
-            for (const auto &entry : bindPoseNodeGlobals)
+            for (std::size_t j = 0; j < mJoints.size(); ++j)
             {
-                const float err = matrixError(entry.second, estimatedJointGlobal);
+                const float err = matrixError(bindPoseNodeGlobals[j], estimatedJointGlobal);
                 if (err < bestErr)
                 {
                     bestErr = err;
-                    bestNodeName = entry.first;
+                    bestNodeName = mJoints[j].name;
                 }
             }
 
@@ -479,6 +736,8 @@ bool GLTFModel::readFile(std::string_view filename)
         }
     }
 
+    bindSkeleton();
+
     // Score and select animation: prioritize temporal motion on mapped skeleton bones.
     float bestScore = -std::numeric_limits<float>::infinity();
     unsigned int bestMappedAnimatedChannels = 0;
@@ -561,13 +820,17 @@ bool GLTFModel::readFile(std::string_view filename)
         const float durationTicks = findAnimationDurationTicks(candidate);
         if (durationTicks > 0.0f && !mBoneOffsets.empty())
         {
-            std::vector<glm::mat4> bonesAtT0(mBoneOffsets.size(), glm::mat4(1.0f));
-            std::vector<glm::mat4> bonesAtT1(mBoneOffsets.size(), glm::mat4(1.0f));
-            std::vector<glm::mat4> bonesAtT2(mBoneOffsets.size(), glm::mat4(1.0f));
+            const AnimationBinding *binding = &mAnimationBindings[i];
+            std::vector<glm::mat4> bonesAtT0;
+            std::vector<glm::mat4> bonesAtT1;
+            std::vector<glm::mat4> bonesAtT2;
 
-            readNodeHierarchy(0.0f, mScene->mRootNode, glm::mat4(1.0f), candidate, bonesAtT0);
-            readNodeHierarchy(durationTicks * 0.37f, mScene->mRootNode, glm::mat4(1.0f), candidate, bonesAtT1);
-            readNodeHierarchy(durationTicks * 0.73f, mScene->mRootNode, glm::mat4(1.0f), candidate, bonesAtT2);
+            sampleJoints(binding, 0.0f, mJointScratch);
+            writeBonePalette(mJointScratch, bonesAtT0);
+            sampleJoints(binding, durationTicks * 0.37f, mJointScratch);
+            writeBonePalette(mJointScratch, bonesAtT1);
+            sampleJoints(binding, durationTicks * 0.73f, mJointScratch);
+            writeBonePalette(mJointScratch, bonesAtT2);
 
             float deformationScore = 0.0f;
             for (std::size_t boneIdx = 0; boneIdx < mBoneOffsets.size(); ++boneIdx)
@@ -612,12 +875,13 @@ bool GLTFModel::readFile(std::string_view filename)
         return false;
     }
 
-    std::uint32_t totalMeshBones = 0;
+    mMeshNames.reserve(mScene->mNumMeshes);
     for (unsigned int i = 0; i < mScene->mNumMeshes; ++i)
     {
-        if (mScene->mMeshes[i])
+        if (const aiMesh *mesh = mScene->mMeshes[i])
         {
-            totalMeshBones += mScene->mMeshes[i]->mNumBones;
+            mMeshNames.emplace_back(mesh->mName.C_Str());
+            mTotalMeshBones += mesh->mNumBones;
         }
     }
 
@@ -626,28 +890,25 @@ bool GLTFModel::readFile(std::string_view filename)
 
 void GLTFModel::render(Shader &shader,
                        const glm::mat4 &model,
-                       const glm::mat4 &view,
-                       const glm::mat4 &projection,
-                       float animationTimeSeconds) const
+                       float animationTimeSeconds,
+                       std::uint32_t lodLevel) const
 {
     if (!isLoaded())
     {
         return;
     }
 
+    resolveSkinUniforms(shader);
     shader.bind();
-    shader.setUniform("uView", view);
-    shader.setUniform("uProjection", projection);
 
-    std::vector<glm::mat4> transforms = computeBoneTransforms(animationTimeSeconds);
-    std::unordered_map<std::string, glm::mat4> animatedNodeTransforms;
-    const aiAnimation *activeAnimation = getActiveAnimation();
-    if (activeAnimation && mScene && mScene->mRootNode)
+    const PoseCache &pose = evaluatePose(animationTimeSeconds);
+
+    // Skinned meshes read this frame's compute output; the bone palette is only needed without it
+    if (pose.gpuSkinned)
     {
-        const float animationTime = computeAnimationTimeTicks(activeAnimation, animationTimeSeconds);
-        buildNodeTransformMap(animationTime, mScene->mRootNode, glm::mat4(1.0f), activeAnimation, animatedNodeTransforms);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, kSkinnedVertexBinding, mSkinnedVertexBuffer);
     }
-    if (!transforms.empty())
+    else if (const std::vector<glm::mat4> &transforms = poseBoneTransforms(); !transforms.empty())
     {
         const std::size_t clampedBoneCount = std::min<std::size_t>(transforms.size(), kMaxShaderBones);
         if (transforms.size() > kMaxShaderBones)
@@ -662,36 +923,228 @@ void GLTFModel::render(Shader &shader,
                 loggedBoneClampWarning = true;
             }
         }
-        shader.setUniform("uBones[0]", transforms.data(), static_cast<unsigned int>(clampedBoneCount));
-        shader.setUniform("uBoneCount", static_cast<GLuint>(clampedBoneCount));
+        shader.setUniform(mSkinUniforms.bones, transforms.data(), static_cast<unsigned int>(clampedBoneCount));
+        shader.setUniform(mSkinUniforms.boneCount, static_cast<GLuint>(clampedBoneCount));
     }
     else
     {
         glm::mat4 identity(1.0f);
-        shader.setUniform("uBones[0]", &identity, 1u);
-        shader.setUniform("uBoneCount", 1u);
+        shader.setUniform(mSkinUniforms.bones, &identity, 1u);
+        shader.setUniform(mSkinUniforms.boneCount, 1u);
     }
 
-    for (const MeshBuffers &mesh : mMeshes)
+    for (std::size_t i = 0; i < mMeshes.size(); ++i)
     {
-        glm::mat4 nodeTransform(1.0f);
-        if (!mesh.usesSkinning)
+        const MeshBuffers &mesh = mMeshes[i];
+        shader.setUniform(mSkinUniforms.model, model * pose.meshTransforms[i]);
+        shader.setUniform(mSkinUniforms.hasTexCoord, mesh.hasTexCoords ? 1 : 0);
+        shader.setUniform(mSkinUniforms.skinnedBase, pose.gpuSkinned ? mesh.skinBase : -1);
+        const MeshLod &lod = mesh.lods[std::min(lodLevel, mesh.lodCount - 1)];
+        GLStateCache::bindVertexArray(mesh.vao);
+        RenderStats::drawElements(GL_TRIANGLES, lod.indexCount, GL_UNSIGNED_INT, reinterpret_cast<const void *>(lod.firstIndex));
+    }
+
+    GLStateCache::bindVertexArray(0);
+}
+
+std::uint32_t GLTFModel::selectLod(const glm::mat4 &model, const LodView &view,
+                                   std::uint32_t previousLevel) const noexcept
+{
+    if (mLodCount <= 1 || mBoundsRadius <= 0.0f || view.viewportHeight <= 0.0f)
+    {
+        return 0;
+    }
+
+    const float pixels = getProjectedHeight(model, view);
+    std::uint32_t level = std::min(previousLevel, mLodCount - 1);
+    while (level + 1 < mLodCount && pixels < kLodPixelHeights[level] * (1.0f - kLodHysteresis))
+    {
+        ++level;
+    }
+    while (level > 0 && pixels > kLodPixelHeights[level - 1] * (1.0f + kLodHysteresis))
+    {
+        --level;
+    }
+    return level;
+}
+
+float GLTFModel::getProjectedHeight(const glm::mat4 &model, const LodView &view) const noexcept
+{
+    if (mBoundsRadius <= 0.0f || view.viewportHeight <= 0.0f)
+    {
+        return 0.0f;
+    }
+
+    const glm::vec4 sphere = getBoundingSphere(model);
+    const glm::vec4 clip = view.viewProjection * glm::vec4(glm::vec3(sphere), 1.0f);
+    // Inside the sphere or behind the camera: nothing to save, and no size to measure
+    if (clip.w <= sphere.w)
+    {
+        return std::numeric_limits<float>::max();
+    }
+    return sphere.w * view.projectionScaleY * view.viewportHeight / clip.w;
+}
+
+glm::vec4 GLTFModel::getBoundingSphere(const glm::mat4 &model) const noexcept
+{
+    const float scale = std::max({glm::length(glm::vec3(model[0])), glm::length(glm::vec3(model[1])),
+                                  glm::length(glm::vec3(model[2]))});
+    return glm::vec4(glm::vec3(model * glm::vec4(mBoundsCenter, 1.0f)), mBoundsRadius * scale);
+}
+
+void GLTFModel::renderInstanced(Shader &shader, std::span<const Instance> instances) const
+{
+    if (!isLoaded() || instances.empty())
+    {
+        return;
+    }
+
+    resolveSkinUniforms(shader);
+    shader.bind();
+
+    const std::size_t meshCount = mMeshes.size();
+    const std::size_t boneCount = mBoneOffsets.size();
+    // A baked model (with a clip to sample) always gets baked poses, so every instance reads the same buffer
+    const bool bakedPalettes = isBaked() && boneCount > 0 && getActiveBinding() != nullptr;
+
+    mInstanceScratch.resize(instances.size() * meshCount);
+    mInstancePaletteScratch.clear();
+
+    // Counting sort by level, so each level is one contiguous run of the instance buffer
+    mInstanceLodStarts.fill(0u);
+    for (const Instance &instance : instances)
+    {
+        ++mInstanceLodStarts[std::min(instance.lodLevel, mLodCount - 1) + 1];
+    }
+    for (std::uint32_t level = 1; level <= MAX_LODS; ++level)
+    {
+        mInstanceLodStarts[level] += mInstanceLodStarts[level - 1];
+    }
+    mInstanceOrderScratch.resize(instances.size());
+    {
+        std::array<std::uint32_t, MAX_LODS> next{};
+        std::copy_n(mInstanceLodStarts.begin(), MAX_LODS, next.begin());
+        for (std::size_t n = 0; n < instances.size(); ++n)
         {
-            nodeTransform = mesh.nodeTransform;
-            const auto it = animatedNodeTransforms.find(mesh.nodeName);
-            if (it != animatedNodeTransforms.end())
+            mInstanceOrderScratch[next[std::min(instances[n].lodLevel, mLodCount - 1)]++] = static_cast<std::uint32_t>(n);
+        }
+    }
+
+    for (std::size_t slot = 0; slot < instances.size(); ++slot)
+    {
+        const std::size_t n = mInstanceOrderScratch[slot];
+        const PoseCache &pose = evaluatePose(instances[n].animationTimeSeconds);
+
+        glm::uvec2 paletteBase(0u);
+        float paletteBlend = 0.0f;
+        if (bakedPalettes && pose.baked)
+        {
+            paletteBase = glm::uvec2(pose.boneFrame.first * static_cast<GLuint>(boneCount),
+                                     pose.boneFrame.second * static_cast<GLuint>(boneCount));
+            paletteBlend = pose.boneFrame.blend;
+        }
+        else
+        {
+            const std::vector<glm::mat4> &transforms = poseBoneTransforms();
+            paletteBase = glm::uvec2(static_cast<GLuint>(mInstancePaletteScratch.size()));
+            mInstancePaletteScratch.insert(mInstancePaletteScratch.end(), transforms.begin(), transforms.end());
+        }
+
+        for (std::size_t i = 0; i < meshCount; ++i)
+        {
+            InstanceData &entry = mInstanceScratch[slot * meshCount + i];
+            entry.model = instances[n].model * pose.meshTransforms[i];
+            entry.paletteBase = paletteBase;
+            entry.paletteBlend = paletteBlend;
+        }
+    }
+
+    bindStreamedStorage(kInstanceDataBinding, mInstanceScratch.data(),
+                        static_cast<GLsizeiptr>(mInstanceScratch.size() * sizeof(InstanceData)), mInstanceDataBuffer);
+    if (bakedPalettes)
+    {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, kInstancePaletteBinding, mBakedPaletteBuffer);
+    }
+    else
+    {
+        bindStreamedStorage(kInstancePaletteBinding, mInstancePaletteScratch.data(),
+                            static_cast<GLsizeiptr>(mInstancePaletteScratch.size() * sizeof(glm::mat4)),
+                            mInstancePaletteBuffer);
+    }
+
+    // uBones is unused here, so the palette is not held to the uniform array limit
+    shader.setUniform(mSkinUniforms.instanced, 1);
+    shader.setUniform(mSkinUniforms.instanceStride, static_cast<GLuint>(meshCount));
+    shader.setUniform(mSkinUniforms.boneCount, static_cast<GLuint>(std::max<std::size_t>(boneCount, 1)));
+    shader.setUniform(mSkinUniforms.skinnedBase, -1);
+    shader.setUniform(mSkinUniforms.model, glm::mat4(1.0f));
+
+    for (std::size_t i = 0; i < meshCount; ++i)
+    {
+        const MeshBuffers &mesh = mMeshes[i];
+        shader.setUniform(mSkinUniforms.instanceMesh, static_cast<GLuint>(i));
+        shader.setUniform(mSkinUniforms.hasTexCoord, mesh.hasTexCoords ? 1 : 0);
+        GLStateCache::bindVertexArray(mesh.vao);
+        for (std::uint32_t level = 0; level < mLodCount; ++level)
+        {
+            const std::uint32_t first = mInstanceLodStarts[level];
+            const std::uint32_t count = mInstanceLodStarts[level + 1] - first;
+            if (count == 0)
             {
-                nodeTransform = it->second;
+                continue;
             }
+            // gl_InstanceID restarts at 0 per draw, so the run's start goes in a uniform
+            const MeshLod &lod = mesh.lods[std::min(level, mesh.lodCount - 1)];
+            shader.setUniform(mSkinUniforms.instanceBase, static_cast<GLuint>(first));
+            RenderStats::drawElementsInstanced(GL_TRIANGLES, lod.indexCount, GL_UNSIGNED_INT,
+                                               reinterpret_cast<const void *>(lod.firstIndex), static_cast<GLsizei>(count));
         }
+    }
+
+    GLStateCache::bindVertexArray(0);
+    shader.setUniform(mSkinUniforms.instanceBase, 0u);
+    shader.setUniform(mSkinUniforms.instanced, 0);
+}
+
+void GLTFModel::resolveSkinUniforms(Shader &shader) const
+{
+    if (mSkinUniformShader == &shader)
+    {
+        return;
+    }
+
+    mSkinUniforms.bones = shader.getUniformHandle("uBones[0]");
+    mSkinUniforms.boneCount = shader.getUniformHandle("uBoneCount");
+    mSkinUniforms.model = shader.getUniformHandle("uModel");
+    mSkinUniforms.hasTexCoord = shader.getUniformHandle("uHasTexCoord");
+    mSkinUniforms.skinnedBase = shader.getUniformHandle("uSkinnedBase");
+    mSkinUniforms.instanced = shader.getUniformHandle("uInstanced");
+    mSkinUniforms.instanceStride = shader.getUniformHandle("uInstanceStride");
+    mSkinUniforms.instanceMesh = shader.getUniformHandle("uInstanceMesh");
+    mSkinUniforms.instanceBase = shader.getUniformHandle("uInstanceBase");
+    mSkinUniformShader = &shader;
+}
+
+void GLTFModel::bindStreamedStorage(GLuint binding, const void *data, GLsizeiptr bytes, GLuint &buffer) const noexcept
+{
+    StreamingBuffer &stream = GLSDLHelper::getFrameStream();
+    const GLintptr offset = stream.write(data, bytes, storageOffsetAlignment());
+    if (offset != StreamingBuffer::INVALID_OFFSET)
+    {
+        glBindBufferRange(GL_SHADER_STORAGE_BUFFER, binding, stream.getBuffer(), offset, bytes);
+        return;
+    }
 
-        shader.setUniform("uModel", model * nodeTransform);
-        shader.setUniform("uHasTexCoord", mesh.hasTexCoords ? 1 : 0);
-        glBindVertexArray(mesh.vao);
-        glDrawElements(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, nullptr);
+    if (buffer == 0)
+    {
+        glGenBuffers(1, &buffer);
     }
 
-    glBindVertexArray(0);
+    // Respecify the whole store so last frame's copy can be orphaned instead of stalling
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+    RenderStats::bufferData(GL_SHADER_STORAGE_BUFFER, bytes, data, GL_STREAM_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, buffer);
 }
 
 void GLTFModel::extractRayTraceTriangles(std::vector<RayTraceTriangle> &outTriangles,
@@ -704,7 +1157,9 @@ void GLTFModel::extractRayTraceTriangles(std::vector<RayTraceTriangle> &outTrian
         return;
     }
 
-    const std::vector<glm::mat4> boneTransforms = computeBoneTransforms(animationTimeSeconds);
+    evaluatePose(animationTimeSeconds);
+    skinOnCpu();
+    const std::vector<SkinnedVertex> &skinned = mPose.cpuVertices;
 
     std::size_t totalTriangleCount = 0;
     for (const CpuMeshData &mesh : mCpuMeshes)
@@ -757,17 +1212,25 @@ void GLTFModel::extractRayTraceTriangles(std::vector<RayTraceTriangle> &outTrian
             const Vertex &v1 = mesh.vertices[i1];
             const Vertex &v2 = mesh.vertices[i2];
 
-            const glm::mat4 skin0 = computeSkinMatrix(v0, boneTransforms);
-            const glm::mat4 skin1 = computeSkinMatrix(v1, boneTransforms);
-            const glm::mat4 skin2 = computeSkinMatrix(v2, boneTransforms);
-
-            const glm::vec3 localPos0 = glm::vec3(skin0 * glm::vec4(v0.position, 1.0f));
-            const glm::vec3 localPos1 = glm::vec3(skin1 * glm::vec4(v1.position, 1.0f));
-            const glm::vec3 localPos2 = glm::vec3(skin2 * glm::vec4(v2.position, 1.0f));
-
-            glm::vec3 localN0 = glm::vec3(skin0 * glm::vec4(v0.normal, 0.0f));
-            glm::vec3 localN1 = glm::vec3(skin1 * glm::vec4(v1.normal, 0.0f));
-            glm::vec3 localN2 = glm::vec3(skin2 * glm::vec4(v2.normal, 0.0f));
+            // Skinned corners come from the per-frame cache, so shared vertices are not blended again
+            glm::vec3 localPos0 = v0.position;
+            glm::vec3 localPos1 = v1.position;
+            glm::vec3 localPos2 = v2.position;
+            glm::vec3 localN0 = v0.normal;
+            glm::vec3 localN1 = v1.normal;
+            glm::vec3 localN2 = v2.normal;
+            if (mesh.usesSkinning)
+            {
+                const SkinnedVertex &s0 = skinned[mesh.skinBase + i0];
+                const SkinnedVertex &s1 = skinned[mesh.skinBase + i1];
+                const SkinnedVertex &s2 = skinned[mesh.skinBase + i2];
+                localPos0 = glm::vec3(s0.position);
+                localPos1 = glm::vec3(s1.position);
+                localPos2 = glm::vec3(s2.position);
+                localN0 = glm::vec3(s0.normal);
+                localN1 = glm::vec3(s1.normal);
+                localN2 = glm::vec3(s2.normal);
+            }
 
             if (glm::length(localN0) < 1e-6f || glm::length(localN1) < 1e-6f || glm::length(localN2) < 1e-6f)
             {
@@ -804,7 +1267,7 @@ void GLTFModel::extractRayTraceTriangles(std::vector<RayTraceTriangle> &outTrian
 
 bool GLTFModel::isLoaded() const noexcept
 {
-    return mScene != nullptr && !mMeshes.empty();
+    return !mMeshes.empty();
 }
 
 std::size_t GLTFModel::getBoneCount() const noexcept
@@ -815,16 +1278,12 @@ std::size_t GLTFModel::getBoneCount() const noexcept
 std::vector<std::string> GLTFModel::getAnimationNames() const
 {
     std::vector<std::string> names;
-    if (mScene && mScene->mNumAnimations > 0)
+    names.reserve(mAnimationBindings.size());
+    for (const AnimationBinding &binding : mAnimationBindings)
     {
-        names.reserve(mScene->mNumAnimations);
-        for (unsigned int i = 0; i < mScene->mNumAnimations; ++i)
+        if (binding.valid && !binding.name.empty())
         {
-            const auto *animation = mScene->mAnimations[i];
-            if (animation && animation->mName.length > 0)
-            {
-                names.push_back(animation->mName.C_Str());
-            }
+            names.push_back(binding.name);
         }
     }
     return names;
@@ -832,35 +1291,21 @@ std::vector<std::string> GLTFModel::getAnimationNames() const
 
 std::string GLTFModel::getActiveAnimationName() const
 {
-    if (mScene && mPreferredAnimationIndex >= 0 && mPreferredAnimationIndex < static_cast<int>(mScene->mNumAnimations))
+    if (mPreferredAnimationIndex >= 0 && mPreferredAnimationIndex < static_cast<int>(mAnimationBindings.size()))
     {
-        const auto *animation = mScene->mAnimations[mPreferredAnimationIndex];
-        if (animation && animation->mName.length > 0)
-        {
-            return animation->mName.C_Str();
-        }
+        return mAnimationBindings[static_cast<std::size_t>(mPreferredAnimationIndex)].name;
     }
     return {};
 }
 
 std::size_t GLTFModel::getAnimationCount() const noexcept
 {
-    if (!mScene)
-    {
-        return 0;
-    }
-
-    return static_cast<std::size_t>(mScene->mNumAnimations);
+    return mAnimationBindings.size();
 }
 
 bool GLTFModel::setPreferredAnimationIndex(int animationIndex) noexcept
 {
-    if (!mScene || mScene->mNumAnimations == 0)
-    {
-        return false;
-    }
-
-    if (animationIndex < 0 || animationIndex >= static_cast<int>(mScene->mNumAnimations))
+    if (animationIndex < 0 || animationIndex >= static_cast<int>(mAnimationBindings.size()))
     {
         return false;
     }
@@ -871,37 +1316,17 @@ bool GLTFModel::setPreferredAnimationIndex(int animationIndex) noexcept
 
 std::vector<std::string> GLTFModel::getMeshes() const
 {
-    std::vector<std::string> meshNames;
-    if (mScene && mScene->mNumMeshes > 0)
-    {
-        meshNames.reserve(mScene->mNumMeshes);
-        for (unsigned int i = 0; i < mScene->mNumMeshes; ++i)
-        {
-            const auto *mesh = mScene->mMeshes[i];
-            if (mesh)
-            {
-                meshNames.push_back(mesh->mName.C_Str());
-            }
-        }
-    }
-    return meshNames;
+    return mMeshNames;
+}
+
+std::uint32_t GLTFModel::getLodCount() const noexcept
+{
+    return mLodCount;
 }
 
 std::size_t GLTFModel::getTotalMeshBones() const noexcept
 {
-    std::size_t total = 0;
-    if (mScene)
-    {
-        for (unsigned int i = 0; i < mScene->mNumMeshes; ++i)
-        {
-            const auto *mesh = mScene->mMeshes[i];
-            if (mesh)
-            {
-                total += mesh->mNumBones;
-            }
-        }
-    }
-    return total;
+    return mTotalMeshBones;
 }
 
 void GLTFModel::VertexBoneData::addBoneData(std::uint32_t boneId, float weight) noexcept
@@ -933,12 +1358,32 @@ void GLTFModel::clearGpuBuffers() noexcept
         }
         if (mesh.vao != 0)
         {
+            GLStateCache::forgetVertexArray(mesh.vao);
             glDeleteVertexArrays(1, &mesh.vao);
             mesh.vao = 0;
         }
     }
     mMeshes.clear();
     mCpuMeshes.clear();
+    mMeshGpuBytes.set(0);
+    mCpuMeshBytes.set(0);
+    mBoundsCenter = glm::vec3(0.0f);
+    mBoundsRadius = 0.0f;
+    mLodCount = 1;
+
+    for (GLuint *buffer : {&mSkinSourceBuffer, &mSkinBoneBuffer, &mSkinnedVertexBuffer, &mInstanceDataBuffer,
+                           &mInstancePaletteBuffer})
+    {
+        if (*buffer != 0)
+        {
+            glDeleteBuffers(1, buffer);
+            *buffer = 0;
+        }
+    }
+    mSkinnedVertexCount = 0;
+    mSkinGpuBytes.set(0);
+    clearBakedAnimations();
+    mPose = PoseCache{};
 }
 
 void GLTFModel::buildMeshesFromScene(const aiScene *scene)
@@ -1034,8 +1479,10 @@ void GLTFModel::buildMeshesFromScene(const aiScene *scene)
             continue;
         }
 
+        optimizeMeshOrder(vertices, indices);
+
         MeshBuffers gpuMesh{};
-        gpuMesh.indexCount = static_cast<GLsizei>(indices.size());
+        std::vector<std::uint32_t> coarseIndices = buildLodChain(vertices, indices, gpuMesh);
         gpuMesh.nodeTransform = meshNodeTransform;
         gpuMesh.nodeName = meshIndex < meshNodeNames.size() ? meshNodeNames[meshIndex] : std::string{};
         gpuMesh.hasTexCoords = mesh->HasTextureCoords(0);
@@ -1048,46 +1495,12 @@ void GLTFModel::buildMeshesFromScene(const aiScene *scene)
                                                          boneData.weights[3] > 0.0f;
                                               });
         gpuMesh.usesSkinning = usesSkinning;
-
-        glGenVertexArrays(1, &gpuMesh.vao);
-        glGenBuffers(1, &gpuMesh.vbo);
-        glGenBuffers(1, &gpuMesh.ebo);
-
-        glBindVertexArray(gpuMesh.vao);
-
-        glBindBuffer(GL_ARRAY_BUFFER, gpuMesh.vbo);
-        glBufferData(GL_ARRAY_BUFFER,
-                     static_cast<GLsizeiptr>(vertices.size() * sizeof(Vertex)),
-                     vertices.data(),
-                     GL_STATIC_DRAW);
-
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gpuMesh.ebo);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-                     static_cast<GLsizeiptr>(indices.size() * sizeof(std::uint32_t)),
-                     indices.data(),
-                     GL_STATIC_DRAW);
-
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void *>(offsetof(Vertex, position)));
-
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void *>(offsetof(Vertex, texCoord)));
-
-        glEnableVertexAttribArray(2);
-        glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void *>(offsetof(Vertex, normal)));
-
-        glEnableVertexAttribArray(3);
-        glVertexAttribIPointer(3, 4, GL_INT, sizeof(Vertex), reinterpret_cast<void *>(offsetof(Vertex, boneIds)));
-
-        glEnableVertexAttribArray(4);
-        glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void *>(offsetof(Vertex, boneWeights)));
-
-        glBindVertexArray(0);
         mMeshes.push_back(gpuMesh);
 
         CpuMeshData cpuMesh{};
-        cpuMesh.vertices = vertices;
-        cpuMesh.indices = indices;
+        cpuMesh.vertices = std::move(vertices);
+        cpuMesh.indices = std::move(indices);
+        cpuMesh.coarseIndices = std::move(coarseIndices);
         cpuMesh.usesSkinning = usesSkinning;
         cpuMesh.nodeTransform = gpuMesh.nodeTransform;
         cpuMesh.nodeName = gpuMesh.nodeName;
@@ -1105,8 +1518,884 @@ void GLTFModel::buildMeshesFromScene(const aiScene *scene)
     }
 }
 
-void GLTFModel::loadBones(const aiMesh *mesh,
-                         std::vector<VertexBoneData> &vertexBones,
+void GLTFModel::uploadMeshes()
+{
+    std::size_t gpuBytes = 0;
+    std::size_t cpuBytes = 0;
+    std::vector<std::uint32_t> packedIndices;
+    for (std::size_t i = 0; i < mMeshes.size(); ++i)
+    {
+        MeshBuffers &gpuMesh = mMeshes[i];
+        const CpuMeshData &cpuMesh = mCpuMeshes[i];
+        mLodCount = std::max(mLodCount, gpuMesh.lodCount);
+
+        glGenVertexArrays(1, &gpuMesh.vao);
+        glGenBuffers(1, &gpuMesh.vbo);
+        glGenBuffers(1, &gpuMesh.ebo);
+
+        GLStateCache::bindVertexArray(gpuMesh.vao);
+
+        const std::vector<PackedVertex> packed = packVertices(cpuMesh.vertices, gpuMesh.texCoordRange);
+        glBindBuffer(GL_ARRAY_BUFFER, gpuMesh.vbo);
+        RenderStats::bufferData(GL_ARRAY_BUFFER,
+                                static_cast<GLsizeiptr>(packed.size() * sizeof(PackedVertex)),
+                                packed.data(),
+                                GL_STATIC_DRAW);
+
+        packedIndices.assign(cpuMesh.indices.begin(), cpuMesh.indices.end());
+        packedIndices.insert(packedIndices.end(), cpuMesh.coarseIndices.begin(), cpuMesh.coarseIndices.end());
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gpuMesh.ebo);
+        RenderStats::bufferData(GL_ELEMENT_ARRAY_BUFFER,
+                                static_cast<GLsizeiptr>(packedIndices.size() * sizeof(std::uint32_t)),
+                                packedIndices.data(),
+                                GL_STATIC_DRAW);
+
+        MeshBuffers::setupAttributes();
+
+        GLStateCache::bindVertexArray(0);
+
+        gpuBytes += packed.size() * sizeof(PackedVertex) + packedIndices.size() * sizeof(std::uint32_t);
+        cpuBytes += cpuMesh.vertices.capacity() * sizeof(Vertex) +
+                    (cpuMesh.indices.capacity() + cpuMesh.coarseIndices.capacity()) * sizeof(std::uint32_t);
+    }
+    mMeshGpuBytes.set(gpuBytes);
+    mCpuMeshBytes.set(cpuBytes);
+}
+
+std::string GLTFModel::cachePathFor(std::string_view filename)
+{
+    if (sCacheDirectory.empty())
+    {
+        return {};
+    }
+
+    // FNV-1a of the path: one cache file per source model
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    for (const char c : filename)
+    {
+        hash ^= static_cast<std::uint8_t>(c);
+        hash *= 0x100000001b3ull;
+    }
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bwm", static_cast<unsigned long long>(hash));
+    return sCacheDirectory + name;
+}
+
+std::uint64_t GLTFModel::sourceStamp(std::string_view filename) noexcept
+{
+    // A packed model changes only with the pack
+    if (const auto packed = AssetPack::find(filename); !packed.empty())
+    {
+        const std::uint64_t stamp = (AssetPack::getStamp() * 0x9E3779B97F4A7C15ull) ^ packed.size();
+        return stamp != 0 ? stamp : 1;
+    }
+
+    std::error_code error;
+    const std::filesystem::path path{std::string(filename)};
+    const auto size = std::filesystem::file_size(path, error);
+    if (error)
+    {
+        return 0;
+    }
+    const auto writeTime = std::filesystem::last_write_time(path, error);
+    if (error)
+    {
+        return 0;
+    }
+
+    const auto ticks = static_cast<std::uint64_t>(writeTime.time_since_epoch().count());
+    const std::uint64_t stamp = (ticks * 0x9E3779B97F4A7C15ull) ^ static_cast<std::uint64_t>(size);
+    return stamp != 0 ? stamp : 1;
+}
+
+bool GLTFModel::readCache(const std::string &path, std::uint64_t stamp)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+
+    ModelCacheHeader header{};
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) || header.magic != CACHE_MAGIC ||
+        header.version != CACHE_VERSION || header.sourceStamp != stamp)
+    {
+        return false;
+    }
+    std::vector<std::uint8_t> payload(static_cast<std::size_t>(header.payloadSize));
+    if (!file.read(reinterpret_cast<char *>(payload.data()), static_cast<std::streamsize>(payload.size())))
+    {
+        return false;
+    }
+
+    CacheReader in{payload};
+    mGlobalInverseTransform = in.pod<glm::mat4>();
+    mPreferredAnimationIndex = in.pod<std::int32_t>();
+    mTotalMeshBones = static_cast<std::size_t>(in.pod<std::uint64_t>());
+    mMeshNames.resize(in.count());
+    for (std::string &name : mMeshNames)
+    {
+        name = in.string();
+    }
+    in.array(mBoneOffsets);
+
+    mJoints.resize(in.count());
+    for (Joint &joint : mJoints)
+    {
+        joint.parent = in.pod<std::int32_t>();
+        joint.bone = in.pod<std::int32_t>();
+        joint.bindLocal = in.pod<glm::mat4>();
+        joint.name = in.string();
+    }
+
+    const std::size_t meshCount = in.count();
+    mMeshes.resize(meshCount);
+    mCpuMeshes.resize(meshCount);
+    for (std::size_t i = 0; i < meshCount && in.ok(); ++i)
+    {
+        MeshBuffers &mesh = mMeshes[i];
+        CpuMeshData &cpuMesh = mCpuMeshes[i];
+        mesh.usesSkinning = in.pod<std::uint8_t>() != 0;
+        mesh.hasTexCoords = in.pod<std::uint8_t>() != 0;
+        mesh.joint = in.pod<std::int32_t>();
+        mesh.nodeTransform = in.pod<glm::mat4>();
+        mesh.nodeName = in.string();
+        mesh.lodCount = std::clamp<std::uint32_t>(in.pod<std::uint32_t>(), 1, MAX_LODS);
+        for (MeshLod &lod : mesh.lods)
+        {
+            lod.firstIndex = static_cast<std::uintptr_t>(in.pod<std::uint64_t>());
+            lod.indexCount = in.pod<GLsizei>();
+        }
+
+        in.array(cpuMesh.vertices);
+        in.array(cpuMesh.indices);
+        in.array(cpuMesh.coarseIndices);
+        cpuMesh.rayTraceAlbedoAndMaterial = in.pod<glm::vec4>();
+        cpuMesh.rayTraceMaterialParams = in.pod<glm::vec4>();
+        cpuMesh.usesSkinning = mesh.usesSkinning;
+        cpuMesh.nodeTransform = mesh.nodeTransform;
+        cpuMesh.nodeName = mesh.nodeName;
+
+        // Ranges feed straight into draw calls, so a bad one must fail here rather than on the GPU
+        const std::size_t packedCount = cpuMesh.indices.size() + cpuMesh.coarseIndices.size();
+        const std::size_t vertexCount = cpuMesh.vertices.size();
+        const bool rangesValid = std::all_of(mesh.lods.begin(), mesh.lods.begin() + mesh.lodCount, [&](const MeshLod &lod) {
+            return lod.indexCount >= 0 && lod.firstIndex % sizeof(std::uint32_t) == 0 &&
+                   lod.firstIndex / sizeof(std::uint32_t) + static_cast<std::size_t>(lod.indexCount) <= packedCount;
+        });
+        const auto inRange = [vertexCount](std::uint32_t index) { return index < vertexCount; };
+        if (!rangesValid || !std::all_of(cpuMesh.indices.begin(), cpuMesh.indices.end(), inRange) ||
+            !std::all_of(cpuMesh.coarseIndices.begin(), cpuMesh.coarseIndices.end(), inRange))
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "GLTFModel: ignoring damaged model cache '%s'", path.c_str());
+            return false;
+        }
+    }
+
+    mAnimationBindings.resize(in.count());
+    for (AnimationBinding &binding : mAnimationBindings)
+    {
+        binding.name = in.string();
+        binding.valid = in.pod<std::uint8_t>() != 0;
+        binding.durationTicks = in.pod<float>();
+        binding.ticksPerSecond = in.pod<float>();
+        binding.mappedChannels = in.pod<std::uint32_t>();
+        binding.mappedTemporalChannels = in.pod<std::uint32_t>();
+        binding.channels.resize(in.count());
+        for (Channel &channel : binding.channels)
+        {
+            in.array(channel.positions);
+            in.array(channel.rotations);
+            in.array(channel.scalings);
+        }
+        in.array(binding.jointChannels);
+        binding.cursors.assign(mJoints.size(), KeyCursor{});
+        if (!in.ok())
+        {
+            break;
+        }
+    }
+    in.array(mMappedPoseAnimations);
+
+    bool skeletonValid = true;
+    for (std::size_t j = 0; j < mJoints.size(); ++j)
+    {
+        skeletonValid = skeletonValid && mJoints[j].parent < static_cast<std::int32_t>(j) &&
+                        mJoints[j].bone < static_cast<std::int32_t>(mBoneOffsets.size());
+    }
+    for (const AnimationBinding &binding : mAnimationBindings)
+    {
+        skeletonValid = skeletonValid && (!binding.valid || binding.jointChannels.size() == mJoints.size()) &&
+                        std::all_of(binding.jointChannels.begin(), binding.jointChannels.end(), [&](std::int32_t c) {
+                            return c < static_cast<std::int32_t>(binding.channels.size());
+                        });
+    }
+    for (std::uint32_t index : mMappedPoseAnimations)
+    {
+        skeletonValid = skeletonValid && index < mAnimationBindings.size();
+    }
+
+    if (!in.ok() || !in.atEnd() || mMeshes.empty() || !skeletonValid)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "GLTFModel: ignoring damaged model cache '%s'", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+void GLTFModel::writeCache(const std::string &path, std::uint64_t stamp) const
+{
+    CacheWriter out;
+    out.pod(mGlobalInverseTransform);
+    out.pod(static_cast<std::int32_t>(mPreferredAnimationIndex));
+    out.pod(static_cast<std::uint64_t>(mTotalMeshBones));
+    out.pod(static_cast<std::uint32_t>(mMeshNames.size()));
+    for (const std::string &name : mMeshNames)
+    {
+        out.string(name);
+    }
+    out.array(mBoneOffsets);
+
+    out.pod(static_cast<std::uint32_t>(mJoints.size()));
+    for (const Joint &joint : mJoints)
+    {
+        out.pod(joint.parent);
+        out.pod(joint.bone);
+        out.pod(joint.bindLocal);
+        out.string(joint.name);
+    }
+
+    out.pod(static_cast<std::uint32_t>(mMeshes.size()));
+    for (std::size_t i = 0; i < mMeshes.size(); ++i)
+    {
+        const MeshBuffers &mesh = mMeshes[i];
+        const CpuMeshData &cpuMesh = mCpuMeshes[i];
+        out.pod(static_cast<std::uint8_t>(mesh.usesSkinning ? 1 : 0));
+        out.pod(static_cast<std::uint8_t>(mesh.hasTexCoords ? 1 : 0));
+        out.pod(mesh.joint);
+        out.pod(mesh.nodeTransform);
+        out.string(mesh.nodeName);
+        out.pod(mesh.lodCount);
+        for (const MeshLod &lod : mesh.lods)
+        {
+            out.pod(static_cast<std::uint64_t>(lod.firstIndex));
+            out.pod(lod.indexCount);
+        }
+
+        out.array(cpuMesh.vertices);
+        out.array(cpuMesh.indices);
+        out.array(cpuMesh.coarseIndices);
+        out.pod(cpuMesh.rayTraceAlbedoAndMaterial);
+        out.pod(cpuMesh.rayTraceMaterialParams);
+    }
+
+    out.pod(static_cast<std::uint32_t>(mAnimationBindings.size()));
+    for (const AnimationBinding &binding : mAnimationBindings)
+    {
+        out.string(binding.name);
+        out.pod(static_cast<std::uint8_t>(binding.valid ? 1 : 0));
+        out.pod(binding.durationTicks);
+        out.pod(binding.ticksPerSecond);
+        out.pod(static_cast<std::uint32_t>(binding.mappedChannels));
+        out.pod(static_cast<std::uint32_t>(binding.mappedTemporalChannels));
+        out.pod(static_cast<std::uint32_t>(binding.channels.size()));
+        for (const Channel &channel : binding.channels)
+        {
+            out.array(channel.positions);
+            out.array(channel.rotations);
+            out.array(channel.scalings);
+        }
+        out.array(binding.jointChannels);
+    }
+    out.array(mMappedPoseAnimations);
+
+    std::error_code error;
+    std::filesystem::create_directories(sCacheDirectory, error);
+
+    // Write to a temp file and rename, so a crash mid-write never leaves a truncated cache behind
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        const ModelCacheHeader header{CACHE_MAGIC, CACHE_VERSION, stamp, out.bytes().size()};
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(out.bytes().data()), static_cast<std::streamsize>(out.bytes().size()));
+        if (!file)
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "GLTFModel: could not write model cache '%s'", tempPath.c_str());
+            return;
+        }
+    }
+    std::filesystem::rename(tempPath, path, error);
+    if (error)
+    {
+        std::filesystem::remove(tempPath, error);
+        return;
+    }
+    SDL_Log("GLTFModel: stored model cache %s (%zu KiB)", path.c_str(), out.bytes().size() / 1024);
+}
+
+std::vector<std::uint32_t> GLTFModel::buildLodChain(const std::vector<Vertex> &vertices,
+                                                    const std::vector<std::uint32_t> &indices,
+                                                    MeshBuffers &mesh) const
+{
+    std::vector<std::uint32_t> packed;
+    mesh.lods[0] = MeshLod{0, static_cast<GLsizei>(indices.size())};
+    mesh.lodCount = 1;
+    if (indices.size() / 3 < kLodMinTriangles)
+    {
+        return packed;
+    }
+
+    std::vector<glm::vec3> positions(vertices.size());
+    std::transform(vertices.begin(), vertices.end(), positions.begin(), [](const Vertex &v) { return v.position; });
+
+    // Each level simplifies the one before it, which is far cheaper than starting from full detail again
+    std::vector<std::uint32_t> previous = indices;
+    for (std::uint32_t level = 1; level < MAX_LODS; ++level)
+    {
+        const auto target = static_cast<std::size_t>(static_cast<float>(indices.size() / 3) * kLodIndexRatios[level]) * 3;
+        std::vector<std::uint32_t> simplified = MeshSimplifier::simplify(positions, previous, target, kLodMaxError);
+        // A level that barely drops triangles only costs memory; the error bound has been reached
+        if (simplified.empty() || simplified.size() * 10 > previous.size() * 9)
+        {
+            break;
+        }
+        const std::vector<std::uint32_t> clusters = MeshOptimizer::optimizeVertexCache(simplified, vertices.size());
+        MeshOptimizer::optimizeOverdraw(simplified, positions, clusters);
+
+        mesh.lods[level] = MeshLod{(indices.size() + packed.size()) * sizeof(std::uint32_t),
+                                   static_cast<GLsizei>(simplified.size())};
+        mesh.lodCount = level + 1;
+        packed.insert(packed.end(), simplified.begin(), simplified.end());
+        previous = std::move(simplified);
+    }
+
+    return packed;
+}
+
+void GLTFModel::optimizeMeshOrder(std::vector<Vertex> &vertices, std::vector<std::uint32_t> &indices)
+{
+    std::vector<glm::vec3> positions(vertices.size());
+    std::transform(vertices.begin(), vertices.end(), positions.begin(), [](const Vertex &v) { return v.position; });
+
+    const std::vector<std::uint32_t> clusters = MeshOptimizer::optimizeVertexCache(indices, vertices.size());
+    MeshOptimizer::optimizeOverdraw(indices, positions, clusters);
+
+    const std::vector<std::uint32_t> remap = MeshOptimizer::optimizeVertexFetch(indices, vertices.size());
+    std::vector<Vertex> reordered(vertices.size());
+    for (std::size_t v = 0; v < vertices.size(); ++v)
+    {
+        reordered[remap[v]] = vertices[v];
+    }
+    vertices = std::move(reordered);
+    for (std::uint32_t &index : indices)
+    {
+        index = remap[index];
+    }
+}
+
+std::vector<GLTFModel::PackedVertex> GLTFModel::packVertices(const std::vector<Vertex> &vertices,
+                                                             glm::vec4 &texCoordRange)
+{
+    glm::vec2 uvMin(std::numeric_limits<float>::max());
+    glm::vec2 uvMax(std::numeric_limits<float>::lowest());
+    for (const Vertex &vertex : vertices)
+    {
+        uvMin = glm::min(uvMin, vertex.texCoord);
+        uvMax = glm::max(uvMax, vertex.texCoord);
+    }
+    const glm::vec2 uvScale = glm::max(uvMax - uvMin, glm::vec2(1e-6f));
+    texCoordRange = glm::vec4(uvMin, uvScale);
+
+    bool clippedBones = false;
+    std::vector<PackedVertex> packed(vertices.size());
+    for (std::size_t v = 0; v < vertices.size(); ++v)
+    {
+        const Vertex &vertex = vertices[v];
+        PackedVertex &out = packed[v];
+        out.position = vertex.position;
+        out.normal = packSnorm10(vertex.normal);
+        const glm::vec2 uv = (vertex.texCoord - uvMin) / uvScale;
+        out.texCoord = {packUnorm16(uv.x), packUnorm16(uv.y)};
+
+        // Round the weights, then hand the rounding error to the largest so they still sum to one
+        int sum = 0;
+        std::uint32_t largest = 0;
+        for (std::uint32_t i = 0; i < kMaxBonesPerVertex; ++i)
+        {
+            float weight = vertex.boneWeights[i];
+            std::uint32_t id = static_cast<std::uint32_t>(std::max(vertex.boneIds[i], 0));
+            if (id > kMaxPackedBoneId)
+            {
+                clippedBones = clippedBones || weight > 0.0f;
+                id = 0;
+                weight = 0.0f;
+            }
+            out.boneIds[i] = static_cast<std::uint8_t>(id);
+            out.boneWeights[i] = static_cast<std::uint8_t>(std::lround(std::clamp(weight, 0.0f, 1.0f) * 255.0f));
+            sum += out.boneWeights[i];
+            if (out.boneWeights[i] > out.boneWeights[largest])
+            {
+                largest = i;
+            }
+        }
+        if (sum > 0)
+        {
+            out.boneWeights[largest] = static_cast<std::uint8_t>(std::clamp(out.boneWeights[largest] + 255 - sum, 0, 255));
+        }
+    }
+
+    if (clippedBones)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_RENDER,
+                    "GLTFModel: bone ids above %u dropped from packed vertices; raster skinning may be incomplete",
+                    static_cast<unsigned int>(kMaxPackedBoneId));
+    }
+    return packed;
+}
+
+void GLTFModel::MeshBuffers::setupAttributes() noexcept
+{
+    constexpr auto stride = static_cast<GLsizei>(sizeof(PackedVertex));
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void *>(offsetof(PackedVertex, position)));
+
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_UNSIGNED_SHORT, GL_TRUE, stride, reinterpret_cast<void *>(offsetof(PackedVertex, texCoord)));
+
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, reinterpret_cast<void *>(offsetof(PackedVertex, normal)));
+
+    glEnableVertexAttribArray(3);
+    glVertexAttribIPointer(3, 4, GL_UNSIGNED_BYTE, stride, reinterpret_cast<void *>(offsetof(PackedVertex, boneIds)));
+
+    glEnableVertexAttribArray(4);
+    glVertexAttribPointer(4, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, reinterpret_cast<void *>(offsetof(PackedVertex, boneWeights)));
+}
+
+void GLTFModel::computeBounds() noexcept
+{
+    glm::vec3 boundsMin(std::numeric_limits<float>::max());
+    glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+    for (const CpuMeshData &mesh : mCpuMeshes)
+    {
+        for (const Vertex &vertex : mesh.vertices)
+        {
+            const glm::vec3 p = glm::vec3(mesh.nodeTransform * glm::vec4(vertex.position, 1.0f));
+            boundsMin = glm::min(boundsMin, p);
+            boundsMax = glm::max(boundsMax, p);
+        }
+    }
+    if (boundsMin.x > boundsMax.x)
+    {
+        return;
+    }
+
+    mBoundsCenter = (boundsMin + boundsMax) * 0.5f;
+    mBoundsRadius = glm::length(boundsMax - boundsMin) * 0.5f;
+
+    std::size_t fullTriangles = 0;
+    std::size_t coarsestTriangles = 0;
+    for (const MeshBuffers &mesh : mMeshes)
+    {
+        fullTriangles += static_cast<std::size_t>(mesh.lods[0].indexCount) / 3;
+        coarsestTriangles += static_cast<std::size_t>(mesh.lods[mesh.lodCount - 1].indexCount) / 3;
+    }
+    SDL_Log("GLTFModel: %u detail levels, %zu -> %zu triangles", mLodCount, fullTriangles, coarsestTriangles);
+}
+
+void GLTFModel::createSkinningBuffers()
+{
+    std::vector<SkinSourceVertex> sources;
+    for (std::size_t i = 0; i < mCpuMeshes.size(); ++i)
+    {
+        CpuMeshData &cpuMesh = mCpuMeshes[i];
+        if (!cpuMesh.usesSkinning)
+        {
+            continue;
+        }
+
+        cpuMesh.skinBase = sources.size();
+        mMeshes[i].skinBase = static_cast<GLint>(sources.size());
+        for (const Vertex &vertex : cpuMesh.vertices)
+        {
+            sources.push_back({glm::vec4(vertex.position, 1.0f), glm::vec4(vertex.normal, 0.0f),
+                               vertex.boneIds, vertex.boneWeights});
+        }
+    }
+
+    mSkinnedVertexCount = static_cast<GLuint>(sources.size());
+    if (sources.empty())
+    {
+        return;
+    }
+
+    glGenBuffers(1, &mSkinSourceBuffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mSkinSourceBuffer);
+    RenderStats::bufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(sources.size() * sizeof(SkinSourceVertex)),
+                            sources.data(), GL_STATIC_DRAW);
+
+    glGenBuffers(1, &mSkinnedVertexBuffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mSkinnedVertexBuffer);
+    RenderStats::bufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(sources.size() * sizeof(SkinnedVertex)),
+                            nullptr, GL_DYNAMIC_COPY);
+
+    glGenBuffers(1, &mSkinBoneBuffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mSkinBoneBuffer);
+    RenderStats::bufferData(GL_SHADER_STORAGE_BUFFER,
+                            static_cast<GLsizeiptr>(std::max<std::size_t>(mBoneOffsets.size(), 1) * sizeof(glm::mat4)),
+                            nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    mSkinGpuBytes.set(sources.size() * (sizeof(SkinSourceVertex) + sizeof(SkinnedVertex)) +
+                      std::max<std::size_t>(mBoneOffsets.size(), 1) * sizeof(glm::mat4));
+}
+
+void GLTFModel::updateSkinning(Shader *computeShader, float animationTimeSeconds) const
+{
+    if (!isLoaded())
+    {
+        return;
+    }
+
+    const PoseCache &pose = evaluatePose(animationTimeSeconds);
+    if (pose.gpuSkinned || !computeShader || !computeShader->isLinked() || mSkinnedVertexCount == 0 ||
+        mBoneOffsets.empty())
+    {
+        return;
+    }
+
+    if (mSkinComputeShader != computeShader)
+    {
+        mSkinComputeUniforms.vertexCount = computeShader->getUniformHandle("uVertexCount");
+        mSkinComputeUniforms.boneCount = computeShader->getUniformHandle("uBoneCount");
+        mSkinComputeUniforms.paletteBase = computeShader->getUniformHandle("uPaletteBase");
+        mSkinComputeUniforms.paletteBlend = computeShader->getUniformHandle("uPaletteBlend");
+        mSkinComputeShader = computeShader;
+    }
+
+    const auto boneCount = static_cast<GLuint>(mBoneOffsets.size());
+    glm::uvec2 paletteBase(0u);
+    float paletteBlend = 0.0f;
+
+    if (pose.baked)
+    {
+        // Baked palettes are already on the GPU; only the two frame offsets change per character
+        paletteBase = glm::uvec2(pose.boneFrame.first * boneCount, pose.boneFrame.second * boneCount);
+        paletteBlend = pose.boneFrame.blend;
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, mBakedPaletteBuffer);
+    }
+    else
+    {
+        const std::vector<glm::mat4> &transforms = poseBoneTransforms();
+        const auto bytes = static_cast<GLsizeiptr>(transforms.size() * sizeof(glm::mat4));
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, mSkinBoneBuffer);
+        RenderStats::bufferData(GL_SHADER_STORAGE_BUFFER, bytes, transforms.data(), GL_STREAM_DRAW);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, mSkinBoneBuffer);
+    }
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, mSkinSourceBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, mSkinnedVertexBuffer);
+
+    computeShader->bind();
+    computeShader->setUniform(mSkinComputeUniforms.vertexCount, mSkinnedVertexCount);
+    computeShader->setUniform(mSkinComputeUniforms.boneCount, boneCount);
+    computeShader->setUniform(mSkinComputeUniforms.paletteBase, paletteBase);
+    computeShader->setUniform(mSkinComputeUniforms.paletteBlend, paletteBlend);
+    RenderStats::dispatchCompute((mSkinnedVertexCount + kSkinningGroupSize - 1) / kSkinningGroupSize, 1, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    mPose.gpuSkinned = true;
+}
+
+const GLTFModel::PoseCache &GLTFModel::evaluatePose(float timeSeconds) const
+{
+    if (mPose.valid && mPose.animationTimeSeconds == timeSeconds && mPose.animationIndex == mPreferredAnimationIndex)
+    {
+        return mPose;
+    }
+
+    mPose.animationTimeSeconds = timeSeconds;
+    mPose.animationIndex = mPreferredAnimationIndex;
+    mPose.valid = true;
+    mPose.gpuSkinned = false;
+    mPose.cpuSkinned = false;
+    mPose.baked = false;
+    mPose.paletteReady = false;
+    mPose.meshTransforms.resize(mMeshes.size());
+
+    const AnimationBinding *active = getActiveBinding();
+    const AnimationBinding *boneBinding = mBoneOffsets.empty() ? nullptr : selectBoneBinding(active, timeSeconds);
+
+    if (isBaked())
+    {
+        // O(1) in the skeleton: pick two frames, blend the few mesh transforms; palettes stay on the GPU
+        if (active)
+        {
+            const BakedFrame frame = findBakedFrame(*active, timeSeconds);
+            const std::size_t meshCount = mMeshes.size();
+            for (std::size_t i = 0; i < meshCount; ++i)
+            {
+                const glm::mat4 &a = mBakedMeshTransforms[frame.first * meshCount + i];
+                const glm::mat4 &b = mBakedMeshTransforms[frame.second * meshCount + i];
+                mPose.meshTransforms[i] = a * (1.0f - frame.blend) + b * frame.blend;
+            }
+        }
+        else
+        {
+            writeMeshTransforms({}, mPose.meshTransforms.data());
+        }
+
+        if (boneBinding)
+        {
+            mPose.baked = true;
+            mPose.boneFrame = findBakedFrame(*boneBinding, timeSeconds);
+            return mPose;
+        }
+    }
+    else if (active)
+    {
+        sampleJoints(active, toAnimationTicks(*active, timeSeconds), mJointScratch);
+        writeMeshTransforms(mJointScratch, mPose.meshTransforms.data());
+    }
+    else
+    {
+        writeMeshTransforms({}, mPose.meshTransforms.data());
+    }
+
+    if (mBoneOffsets.empty())
+    {
+        mPose.boneTransforms.assign(1, glm::mat4(1.0f));
+    }
+    else if (active && boneBinding == active && !isBaked())
+    {
+        // Usually the palette follows the active clip and reuses the pass above
+        writeBonePalette(mJointScratch, mPose.boneTransforms);
+    }
+    else
+    {
+        sampleJoints(boneBinding, boneBinding ? toAnimationTicks(*boneBinding, timeSeconds) : 0.0f, mJointScratch);
+        writeBonePalette(mJointScratch, mPose.boneTransforms);
+    }
+    mPose.paletteReady = true;
+
+    return mPose;
+}
+
+const std::vector<glm::mat4> &GLTFModel::poseBoneTransforms() const
+{
+    if (!mPose.paletteReady && mPose.baked)
+    {
+        const std::size_t boneCount = mBoneOffsets.size();
+        const BakedFrame &frame = mPose.boneFrame;
+        mPose.boneTransforms.resize(boneCount);
+        for (std::size_t b = 0; b < boneCount; ++b)
+        {
+            const glm::mat4 &first = mBakedPalettes[frame.first * boneCount + b];
+            const glm::mat4 &second = mBakedPalettes[frame.second * boneCount + b];
+            mPose.boneTransforms[b] = first * (1.0f - frame.blend) + second * frame.blend;
+        }
+        mPose.paletteReady = true;
+    }
+    return mPose.boneTransforms;
+}
+
+void GLTFModel::writeMeshTransforms(const std::vector<glm::mat4> &globals, glm::mat4 *out) const noexcept
+{
+    for (const MeshBuffers &mesh : mMeshes)
+    {
+        if (mesh.usesSkinning)
+        {
+            *out = glm::mat4(1.0f);
+        }
+        else if (mesh.joint >= 0 && static_cast<std::size_t>(mesh.joint) < globals.size())
+        {
+            *out = globals[static_cast<std::size_t>(mesh.joint)];
+        }
+        else
+        {
+            *out = mesh.nodeTransform;
+        }
+        ++out;
+    }
+}
+
+void GLTFModel::bakeAnimations(float samplesPerSecond)
+{
+    clearBakedAnimations();
+    if (!isLoaded() || samplesPerSecond <= 0.0f || mAnimationBindings.empty())
+    {
+        return;
+    }
+
+    const std::size_t meshCount = mMeshes.size();
+    std::vector<glm::mat4> palette;
+    std::uint32_t totalFrames = 0;
+
+    mBakedClips.resize(mAnimationBindings.size());
+    for (std::size_t c = 0; c < mAnimationBindings.size(); ++c)
+    {
+        const AnimationBinding &binding = mAnimationBindings[c];
+        if (!binding.valid)
+        {
+            continue;
+        }
+
+        // One extra frame lands on the clip's end so the last interval blends into the final key
+        const float durationSeconds = binding.durationTicks / binding.ticksPerSecond;
+        const auto frameCount = static_cast<std::uint32_t>(std::ceil(durationSeconds * samplesPerSecond)) + 1;
+
+        mBakedClips[c] = {totalFrames, frameCount};
+        totalFrames += frameCount;
+
+        for (std::uint32_t f = 0; f < frameCount; ++f)
+        {
+            const float ticks = std::min(static_cast<float>(f) / samplesPerSecond * binding.ticksPerSecond,
+                                         binding.durationTicks);
+            sampleJoints(&binding, ticks, mJointScratch);
+
+            if (!mBoneOffsets.empty())
+            {
+                writeBonePalette(mJointScratch, palette);
+                mBakedPalettes.insert(mBakedPalettes.end(), palette.begin(), palette.end());
+            }
+
+            const std::size_t meshOffset = mBakedMeshTransforms.size();
+            mBakedMeshTransforms.resize(meshOffset + meshCount);
+            writeMeshTransforms(mJointScratch, mBakedMeshTransforms.data() + meshOffset);
+        }
+    }
+
+    if (!mBakedPalettes.empty())
+    {
+        glGenBuffers(1, &mBakedPaletteBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, mBakedPaletteBuffer);
+        RenderStats::bufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(mBakedPalettes.size() * sizeof(glm::mat4)),
+                                mBakedPalettes.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        mBakedGpuBytes.set(mBakedPalettes.size() * sizeof(glm::mat4));
+    }
+    mAnimationBytes.set((mBakedPalettes.capacity() + mBakedMeshTransforms.capacity() + mBoneOffsets.capacity()) * sizeof(glm::mat4) +
+                        mBakedClips.capacity() * sizeof(BakedClip) + mJoints.capacity() * sizeof(Joint));
+
+    mBakeRate = samplesPerSecond;
+    mPose.valid = false;
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "GLTFModel: baked %zu clips into %u frames at %.0f Hz (%zu KiB of palettes)",
+                mAnimationBindings.size(), totalFrames, static_cast<double>(samplesPerSecond),
+                (mBakedPalettes.size() * sizeof(glm::mat4)) / 1024);
+}
+
+bool GLTFModel::isBaked() const noexcept
+{
+    return mBakeRate > 0.0f;
+}
+
+GLTFModel::BakedFrame GLTFModel::findBakedFrame(const AnimationBinding &binding, float timeSeconds) const noexcept
+{
+    const auto clipIndex = static_cast<std::size_t>(&binding - mAnimationBindings.data());
+    const BakedClip &clip = mBakedClips[clipIndex];
+    if (clip.frameCount == 0)
+    {
+        return {};
+    }
+
+    const float position = toAnimationTicks(binding, timeSeconds) / binding.ticksPerSecond * mBakeRate;
+    const std::uint32_t last = clip.frameCount - 1;
+    const auto frame = std::min(static_cast<std::uint32_t>(std::max(position, 0.0f)), last);
+
+    BakedFrame out;
+    out.first = clip.firstFrame + frame;
+    out.second = clip.firstFrame + std::min(frame + 1, last);
+    out.blend = std::clamp(position - static_cast<float>(frame), 0.0f, 1.0f);
+    return out;
+}
+
+void GLTFModel::clearBakedAnimations() noexcept
+{
+    if (mBakedPaletteBuffer != 0)
+    {
+        glDeleteBuffers(1, &mBakedPaletteBuffer);
+        mBakedPaletteBuffer = 0;
+    }
+    mBakedClips.clear();
+    mBakedPalettes.clear();
+    mBakedMeshTransforms.clear();
+    mBakedGpuBytes.set(0);
+    mAnimationBytes.set(0);
+    mBakeRate = 0.0f;
+    mPose.valid = false;
+}
+
+void GLTFModel::skinOnCpu() const
+{
+    if (mPose.cpuSkinned)
+    {
+        return;
+    }
+
+    const std::vector<glm::mat4> &bones = poseBoneTransforms();
+    mPose.cpuVertices.resize(mSkinnedVertexCount);
+
+    for (const CpuMeshData &mesh : mCpuMeshes)
+    {
+        if (!mesh.usesSkinning)
+        {
+            continue;
+        }
+
+        SkinnedVertex *out = mPose.cpuVertices.data() + mesh.skinBase;
+        for (const Vertex &vertex : mesh.vertices)
+        {
+            // Blend the palette column by column: four independent vec4 multiply-adds per influence
+            // that the compiler can keep in vector registers, instead of building a mat4 per corner
+            glm::vec4 c0(0.0f);
+            glm::vec4 c1(0.0f);
+            glm::vec4 c2(0.0f);
+            glm::vec4 c3(0.0f);
+            float totalWeight = 0.0f;
+
+            for (int i = 0; i < 4; ++i)
+            {
+                const int boneId = vertex.boneIds[i];
+                const float weight = vertex.boneWeights[i];
+                if (weight <= 0.0f || boneId < 0 || static_cast<std::size_t>(boneId) >= bones.size())
+                {
+                    continue;
+                }
+
+                const glm::mat4 &bone = bones[static_cast<std::size_t>(boneId)];
+                c0 += bone[0] * weight;
+                c1 += bone[1] * weight;
+                c2 += bone[2] * weight;
+                c3 += bone[3] * weight;
+                totalWeight += weight;
+            }
+
+            if (totalWeight <= 1e-6f)
+            {
+                out->position = glm::vec4(vertex.position, 1.0f);
+                out->normal = glm::vec4(vertex.normal, 0.0f);
+            }
+            else
+            {
+                const float invWeight = 1.0f / totalWeight;
+                const glm::vec3 &p = vertex.position;
+                const glm::vec3 &n = vertex.normal;
+                out->position = (c0 * p.x + c1 * p.y + c2 * p.z + c3) * invWeight;
+                out->normal = (c0 * n.x + c1 * n.y + c2 * n.z) * invWeight;
+            }
+            ++out;
+        }
+    }
+
+    mPose.cpuSkinned = true;
+}
+
+void GLTFModel::loadBones(const aiMesh *mesh,
+                         std::vector<VertexBoneData> &vertexBones,
                          const glm::mat4 &meshNodeTransform)
 {
     for (unsigned int i = 0; i < mesh->mNumBones; ++i)
@@ -1183,213 +2472,197 @@ const std::uint32_t *GLTFModel::findBoneIndex(std::string_view nodeName) const
     return nullptr;
 }
 
-std::vector<glm::mat4> GLTFModel::computeBoneTransforms(float timeSeconds) const
+void GLTFModel::compileSkeleton()
 {
-    if (!mScene || mBoneOffsets.empty())
+    mJoints.clear();
+    if (!mScene || !mScene->mRootNode)
     {
-        return std::vector<glm::mat4>(std::max<std::size_t>(mBoneOffsets.size(), 1), glm::mat4(1.0f));
+        return;
     }
 
-    if (!mScene->HasAnimations())
+    // Depth-first with an explicit stack; children are pushed in reverse so they keep Assimp's order
+    std::vector<std::pair<const aiNode *, std::int32_t>> pending{{mScene->mRootNode, -1}};
+    while (!pending.empty())
     {
-        std::vector<glm::mat4> transforms(mBoneOffsets.size(), glm::mat4(1.0f));
-        readNodeHierarchy(0.0f, mScene->mRootNode, glm::mat4(1.0f), nullptr, transforms);
-        return transforms;
+        const auto [node, parent] = pending.back();
+        pending.pop_back();
+        if (!node)
+        {
+            continue;
+        }
+
+        Joint joint{};
+        joint.parent = parent;
+        joint.bindLocal = toGlm(node->mTransformation);
+        joint.name = node->mName.C_Str();
+        mJoints.push_back(std::move(joint));
+
+        const auto index = static_cast<std::int32_t>(mJoints.size() - 1);
+        for (unsigned int i = node->mNumChildren; i > 0; --i)
+        {
+            pending.emplace_back(node->mChildren[i - 1], index);
+        }
     }
 
-    const aiAnimation *animation = getActiveAnimation();
+    // Later joints win, as the name-keyed transform map they replace did
+    for (MeshBuffers &mesh : mMeshes)
+    {
+        for (std::size_t j = 0; j < mJoints.size(); ++j)
+        {
+            if (mJoints[j].name == mesh.nodeName)
+            {
+                mesh.joint = static_cast<std::int32_t>(j);
+            }
+        }
+    }
 
-    if (!animation)
+    mJointScratch.resize(mJoints.size());
+}
+
+void GLTFModel::bindSkeleton()
+{
+    for (Joint &joint : mJoints)
+    {
+        const std::uint32_t *boneIndex = findBoneIndex(joint.name);
+        joint.bone = (boneIndex && *boneIndex < mBoneOffsets.size()) ? static_cast<std::int32_t>(*boneIndex) : -1;
+    }
+
+    mAnimationBindings.clear();
+    mMappedPoseAnimations.clear();
+    if (!mScene)
     {
-        std::vector<glm::mat4> transforms(mBoneOffsets.size(), glm::mat4(1.0f));
-        readNodeHierarchy(0.0f, mScene->mRootNode, glm::mat4(1.0f), nullptr, transforms);
-        return transforms;
+        return;
     }
 
-    auto countMappedChannels = [this](const aiAnimation *anim, bool requireTemporal) -> unsigned int
+    mAnimationBindings.resize(mScene->mNumAnimations);
+    for (unsigned int i = 0; i < mScene->mNumAnimations; ++i)
     {
-        if (!anim)
+        const aiAnimation *animation = mScene->mAnimations[i];
+        AnimationBinding &binding = mAnimationBindings[i];
+        binding.valid = animation != nullptr;
+        if (!animation)
         {
-            return 0;
+            continue;
         }
+        binding.name = animation->mName.C_Str();
 
-        unsigned int count = 0;
-        for (unsigned int i = 0; i < anim->mNumChannels; ++i)
+        binding.durationTicks = findAnimationDurationTicks(animation);
+        if (animation->mTicksPerSecond > 0.0)
         {
-            const aiNodeAnim *channel = anim->mChannels[i];
-            if (!channel)
-            {
-                continue;
-            }
+            binding.ticksPerSecond = static_cast<float>(animation->mTicksPerSecond);
+        }
 
-            const bool temporal =
-                (channel->mNumPositionKeys > 1) ||
-                (channel->mNumRotationKeys > 1) ||
-                (channel->mNumScalingKeys > 1);
-            if (requireTemporal && !temporal)
+        for (unsigned int c = 0; c < animation->mNumChannels; ++c)
+        {
+            const aiNodeAnim *channel = animation->mChannels[c];
+            if (!channel || findBoneIndex(channel->mNodeName.C_Str()) == nullptr)
             {
                 continue;
             }
 
-            if (findBoneIndex(channel->mNodeName.C_Str()) != nullptr)
+            ++binding.mappedChannels;
+            if (channel->mNumPositionKeys > 1 || channel->mNumRotationKeys > 1 || channel->mNumScalingKeys > 1)
             {
-                ++count;
+                ++binding.mappedTemporalChannels;
             }
         }
 
-        return count;
-    };
-
-    if (countMappedChannels(animation, true) == 0)
-    {
-        std::vector<const aiAnimation *> mappedPoseAnimations;
-        mappedPoseAnimations.reserve(mScene->mNumAnimations);
-
-        for (unsigned int i = 0; i < mScene->mNumAnimations; ++i)
+        // Only channels that drive a joint are ever sampled, so only those are copied
+        binding.jointChannels.assign(mJoints.size(), -1);
+        for (std::size_t j = 0; j < mJoints.size(); ++j)
         {
-            const aiAnimation *candidate = mScene->mAnimations[i];
-            if (countMappedChannels(candidate, false) > 0)
+            if (const aiNodeAnim *channel = findNodeAnim(animation, mJoints[j].name))
             {
-                mappedPoseAnimations.push_back(candidate);
+                binding.jointChannels[j] = static_cast<std::int32_t>(binding.channels.size());
+                binding.channels.push_back(copyChannel(*channel));
             }
         }
+        binding.cursors.assign(mJoints.size(), KeyCursor{});
 
-        if (!mappedPoseAnimations.empty())
+        if (binding.mappedChannels > 0)
         {
-            if (mappedPoseAnimations.size() > 1)
-            {
-                const int poseIndex = static_cast<int>(std::floor(timeSeconds * 4.0f)) % static_cast<int>(mappedPoseAnimations.size());
-                animation = mappedPoseAnimations[static_cast<std::size_t>(poseIndex)];
-            }
-            else
-            {
-                animation = mappedPoseAnimations.front();
-            }
+            mMappedPoseAnimations.push_back(i);
         }
     }
-
-    const float animationTime = computeAnimationTimeTicks(animation, timeSeconds);
-
-    std::vector<glm::mat4> transforms(mBoneOffsets.size(), glm::mat4(1.0f));
-    readNodeHierarchy(animationTime, mScene->mRootNode, glm::mat4(1.0f), animation, transforms);
-
-    return transforms;
 }
 
-const aiAnimation *GLTFModel::getActiveAnimation() const
+void GLTFModel::sampleJoints(const AnimationBinding *binding, float animationTime, std::vector<glm::mat4> &globals) const
 {
-    if (!mScene || !mScene->HasAnimations())
-    {
-        return nullptr;
-    }
+    globals.resize(mJoints.size());
 
-    if (mPreferredAnimationIndex >= 0 && mPreferredAnimationIndex < static_cast<int>(mScene->mNumAnimations))
+    for (std::size_t j = 0; j < mJoints.size(); ++j)
     {
-        return mScene->mAnimations[static_cast<unsigned int>(mPreferredAnimationIndex)];
-    }
+        const Joint &joint = mJoints[j];
+        glm::mat4 local = joint.bindLocal;
 
-    return mScene->mAnimations[0];
-}
+        if (const std::int32_t channelIndex = binding ? binding->jointChannels[j] : -1; channelIndex >= 0)
+        {
+            const Channel &channel = binding->channels[static_cast<std::size_t>(channelIndex)];
+            KeyCursor &cursor = binding->cursors[j];
+            const glm::vec3 scaling = interpolateVector(animationTime, channel.scalings, cursor.scaling, glm::vec3(1.0f));
+            const glm::quat rotation = interpolateRotation(animationTime, channel.rotations, cursor.rotation);
+            const glm::vec3 translation = interpolateVector(animationTime, channel.positions, cursor.position, glm::vec3(0.0f));
 
-float GLTFModel::computeAnimationTimeTicks(const aiAnimation *animation, float timeSeconds) const
-{
-    if (!animation)
-    {
-        return 0.0f;
-    }
+            local = glm::translate(glm::mat4(1.0f), translation) * glm::mat4_cast(rotation) *
+                    glm::scale(glm::mat4(1.0f), scaling);
+        }
 
-    const float duration = findAnimationDurationTicks(animation);
-    float ticksPerSecond = animation->mTicksPerSecond > 0.0 ? static_cast<float>(animation->mTicksPerSecond) : 0.0f;
-    if (ticksPerSecond <= 0.0f)
-    {
-        ticksPerSecond = 25.0f;
+        globals[j] = (joint.parent >= 0) ? globals[static_cast<std::size_t>(joint.parent)] * local : local;
     }
-
-    const float timeInTicks = timeSeconds * ticksPerSecond;
-    return (duration > 0.0f) ? std::fmod(timeInTicks, duration) : timeInTicks;
 }
 
-void GLTFModel::buildNodeTransformMap(float animationTime,
-                                      const aiNode *node,
-                                      const glm::mat4 &parentTransform,
-                                      const aiAnimation *animation,
-                                      std::unordered_map<std::string, glm::mat4> &nodeTransforms) const
+void GLTFModel::writeBonePalette(const std::vector<glm::mat4> &globals, std::vector<glm::mat4> &transforms) const
 {
-    if (!node)
-    {
-        return;
-    }
-
-    const std::string nodeName = node->mName.C_Str();
-    glm::mat4 nodeTransformation = toGlm(node->mTransformation);
-
-    const aiNodeAnim *nodeAnim = findNodeAnim(animation, nodeName);
-    if (nodeAnim)
-    {
-        const glm::vec3 scaling = interpolateScaling(animationTime, nodeAnim);
-        const glm::quat rotation = interpolateRotation(animationTime, nodeAnim);
-        const glm::vec3 translation = interpolatePosition(animationTime, nodeAnim);
-
-        const glm::mat4 scalingM = glm::scale(glm::mat4(1.0f), scaling);
-        const glm::mat4 rotationM = glm::mat4_cast(rotation);
-        const glm::mat4 translationM = glm::translate(glm::mat4(1.0f), translation);
-
-        nodeTransformation = translationM * rotationM * scalingM;
-    }
+    transforms.assign(mBoneOffsets.size(), glm::mat4(1.0f));
 
-    const glm::mat4 globalTransformation = parentTransform * nodeTransformation;
-    nodeTransforms[nodeName] = globalTransformation;
-
-    for (unsigned int i = 0; i < node->mNumChildren; ++i)
+    for (std::size_t j = 0; j < mJoints.size(); ++j)
     {
-        buildNodeTransformMap(animationTime, node->mChildren[i], globalTransformation, animation, nodeTransforms);
+        const std::int32_t bone = mJoints[j].bone;
+        if (bone >= 0)
+        {
+            const auto boneIndex = static_cast<std::size_t>(bone);
+            transforms[boneIndex] = mGlobalInverseTransform * globals[j] * mBoneOffsets[boneIndex];
+        }
     }
 }
 
-void GLTFModel::readNodeHierarchy(float animationTime,
-                                  const aiNode *node,
-                                  const glm::mat4 &parentTransform,
-                                  const aiAnimation *animation,
-                                  std::vector<glm::mat4> &transforms) const
+const GLTFModel::AnimationBinding *GLTFModel::selectBoneBinding(const AnimationBinding *active,
+                                                                float timeSeconds) const noexcept
 {
-    if (!node)
+    if (!active || active->mappedTemporalChannels > 0 || mMappedPoseAnimations.empty())
     {
-        return;
+        return active;
     }
 
-    const std::string nodeName = node->mName.C_Str();
-    glm::mat4 nodeTransformation = toGlm(node->mTransformation);
-
-    const aiNodeAnim *nodeAnim = findNodeAnim(animation, nodeName);
-    if (nodeAnim)
+    // The active clip holds the skeleton still; cycle through clips that at least pose it
+    std::size_t poseIndex = 0;
+    if (mMappedPoseAnimations.size() > 1)
     {
-        const glm::vec3 scaling = interpolateScaling(animationTime, nodeAnim);
-        const glm::quat rotation = interpolateRotation(animationTime, nodeAnim);
-        const glm::vec3 translation = interpolatePosition(animationTime, nodeAnim);
-
-        const glm::mat4 scalingM = glm::scale(glm::mat4(1.0f), scaling);
-        const glm::mat4 rotationM = glm::mat4_cast(rotation);
-        const glm::mat4 translationM = glm::translate(glm::mat4(1.0f), translation);
-
-        nodeTransformation = translationM * rotationM * scalingM;
+        poseIndex = static_cast<std::size_t>(static_cast<int>(std::floor(timeSeconds * 4.0f)) %
+                                             static_cast<int>(mMappedPoseAnimations.size()));
     }
+    return &mAnimationBindings[mMappedPoseAnimations[poseIndex]];
+}
 
-    const glm::mat4 globalTransformation = parentTransform * nodeTransformation;
-
-    const std::uint32_t *boneIndexPtr = findBoneIndex(nodeName);
-    if (boneIndexPtr)
+const GLTFModel::AnimationBinding *GLTFModel::getActiveBinding() const noexcept
+{
+    if (mAnimationBindings.empty())
     {
-        const std::uint32_t boneIndex = *boneIndexPtr;
-        if (boneIndex < transforms.size() && boneIndex < mBoneOffsets.size())
-        {
-            transforms[boneIndex] = mGlobalInverseTransform * globalTransformation * mBoneOffsets[boneIndex];
-        }
+        return nullptr;
     }
 
-    for (unsigned int i = 0; i < node->mNumChildren; ++i)
-    {
-        readNodeHierarchy(animationTime, node->mChildren[i], globalTransformation, animation, transforms);
-    }
+    const std::size_t index =
+        (mPreferredAnimationIndex >= 0 && static_cast<std::size_t>(mPreferredAnimationIndex) < mAnimationBindings.size())
+            ? static_cast<std::size_t>(mPreferredAnimationIndex)
+            : 0;
+    const AnimationBinding &binding = mAnimationBindings[index];
+    return binding.valid ? &binding : nullptr;
+}
+
+float GLTFModel::toAnimationTicks(const AnimationBinding &binding, float timeSeconds) noexcept
+{
+    const float timeInTicks = timeSeconds * binding.ticksPerSecond;
+    return (binding.durationTicks > 0.0f) ? std::fmod(timeInTicks, binding.durationTicks) : timeInTicks;
 }
 
 const aiNodeAnim *GLTFModel::findNodeAnim(const aiAnimation *animation, std::string_view nodeName) const
@@ -1411,149 +2684,71 @@ const aiNodeAnim *GLTFModel::findNodeAnim(const aiAnimation *animation, std::str
     return nullptr;
 }
 
-std::uint32_t GLTFModel::findScaling(float animationTime, const aiNodeAnim *nodeAnim) const
+GLTFModel::Channel GLTFModel::copyChannel(const aiNodeAnim &nodeAnim)
 {
-    for (std::uint32_t i = 0; i + 1 < nodeAnim->mNumScalingKeys; ++i)
+    Channel channel;
+    channel.positions.reserve(nodeAnim.mNumPositionKeys);
+    for (unsigned int k = 0; k < nodeAnim.mNumPositionKeys; ++k)
     {
-        if (animationTime < static_cast<float>(nodeAnim->mScalingKeys[i + 1].mTime))
-        {
-            return i;
-        }
-    }
-
-    return nodeAnim->mNumScalingKeys > 1 ? nodeAnim->mNumScalingKeys - 2 : 0;
-}
-
-std::uint32_t GLTFModel::findRotation(float animationTime, const aiNodeAnim *nodeAnim) const
-{
-    for (std::uint32_t i = 0; i + 1 < nodeAnim->mNumRotationKeys; ++i)
-    {
-        if (animationTime < static_cast<float>(nodeAnim->mRotationKeys[i + 1].mTime))
-        {
-            return i;
-        }
+        const aiVectorKey &key = nodeAnim.mPositionKeys[k];
+        channel.positions.push_back({static_cast<float>(key.mTime), glm::vec3(key.mValue.x, key.mValue.y, key.mValue.z)});
     }
-
-    return nodeAnim->mNumRotationKeys > 1 ? nodeAnim->mNumRotationKeys - 2 : 0;
-}
-
-std::uint32_t GLTFModel::findPosition(float animationTime, const aiNodeAnim *nodeAnim) const
-{
-    for (std::uint32_t i = 0; i + 1 < nodeAnim->mNumPositionKeys; ++i)
+    channel.rotations.reserve(nodeAnim.mNumRotationKeys);
+    for (unsigned int k = 0; k < nodeAnim.mNumRotationKeys; ++k)
     {
-        if (animationTime < static_cast<float>(nodeAnim->mPositionKeys[i + 1].mTime))
-        {
-            return i;
-        }
+        const aiQuatKey &key = nodeAnim.mRotationKeys[k];
+        channel.rotations.push_back(
+            {static_cast<float>(key.mTime), glm::normalize(glm::quat(key.mValue.w, key.mValue.x, key.mValue.y, key.mValue.z))});
     }
-
-    return nodeAnim->mNumPositionKeys > 1 ? nodeAnim->mNumPositionKeys - 2 : 0;
-}
-
-glm::vec3 GLTFModel::interpolateScaling(float animationTime, const aiNodeAnim *nodeAnim) const
-{
-    if (nodeAnim->mNumScalingKeys == 1)
+    channel.scalings.reserve(nodeAnim.mNumScalingKeys);
+    for (unsigned int k = 0; k < nodeAnim.mNumScalingKeys; ++k)
     {
-        const aiVector3D v = nodeAnim->mScalingKeys[0].mValue;
-        return glm::vec3(v.x, v.y, v.z);
+        const aiVectorKey &key = nodeAnim.mScalingKeys[k];
+        channel.scalings.push_back({static_cast<float>(key.mTime), glm::vec3(key.mValue.x, key.mValue.y, key.mValue.z)});
     }
-
-    const std::uint32_t index = findScaling(animationTime, nodeAnim);
-    const std::uint32_t nextIndex = index + 1;
-
-    const aiVector3D &start = nodeAnim->mScalingKeys[index].mValue;
-    const aiVector3D &end = nodeAnim->mScalingKeys[nextIndex].mValue;
-
-    const float factor = normalizedKeyLerp(
-        animationTime,
-        static_cast<float>(nodeAnim->mScalingKeys[index].mTime),
-        static_cast<float>(nodeAnim->mScalingKeys[nextIndex].mTime));
-
-    const aiVector3D delta = end - start;
-    const aiVector3D out = start + factor * delta;
-    return glm::vec3(out.x, out.y, out.z);
+    return channel;
 }
 
-glm::quat GLTFModel::interpolateRotation(float animationTime, const aiNodeAnim *nodeAnim) const
+glm::vec3 GLTFModel::interpolateVector(float animationTime, const std::vector<VectorKey> &keys, std::uint32_t &cursor,
+                                       const glm::vec3 &fallback) noexcept
 {
-    if (nodeAnim->mNumRotationKeys == 1)
+    if (keys.empty())
     {
-        const aiQuaternion &q = nodeAnim->mRotationKeys[0].mValue;
-        return glm::normalize(glm::quat(q.w, q.x, q.y, q.z));
+        return fallback;
     }
-
-    const std::uint32_t index = findRotation(animationTime, nodeAnim);
-    const std::uint32_t nextIndex = index + 1;
-
-    const aiQuaternion &start = nodeAnim->mRotationKeys[index].mValue;
-    const aiQuaternion &end = nodeAnim->mRotationKeys[nextIndex].mValue;
-
-    const float factor = normalizedKeyLerp(
-        animationTime,
-        static_cast<float>(nodeAnim->mRotationKeys[index].mTime),
-        static_cast<float>(nodeAnim->mRotationKeys[nextIndex].mTime));
-
-    aiQuaternion out;
-    aiQuaternion::Interpolate(out, start, end, factor);
-    out.Normalize();
-
-    return glm::normalize(glm::quat(out.w, out.x, out.y, out.z));
-}
-
-glm::vec3 GLTFModel::interpolatePosition(float animationTime, const aiNodeAnim *nodeAnim) const
-{
-    if (nodeAnim->mNumPositionKeys == 1)
+    if (keys.size() == 1)
     {
-        const aiVector3D v = nodeAnim->mPositionKeys[0].mValue;
-        return glm::vec3(v.x, v.y, v.z);
+        return keys[0].value;
     }
 
-    const std::uint32_t index = findPosition(animationTime, nodeAnim);
-    const std::uint32_t nextIndex = index + 1;
-
-    const aiVector3D &start = nodeAnim->mPositionKeys[index].mValue;
-    const aiVector3D &end = nodeAnim->mPositionKeys[nextIndex].mValue;
+    const std::uint32_t index = seekKeyInterval(keys.data(), static_cast<std::uint32_t>(keys.size()), animationTime, cursor);
+    const VectorKey &start = keys[index];
+    const VectorKey &end = keys[index + 1];
 
-    const float factor = normalizedKeyLerp(
-        animationTime,
-        static_cast<float>(nodeAnim->mPositionKeys[index].mTime),
-        static_cast<float>(nodeAnim->mPositionKeys[nextIndex].mTime));
-
-    const aiVector3D delta = end - start;
-    const aiVector3D out = start + factor * delta;
-    return glm::vec3(out.x, out.y, out.z);
+    const float factor = normalizedKeyLerp(animationTime, start.time, end.time);
+    return start.value + factor * (end.value - start.value);
 }
 
-glm::mat4 GLTFModel::computeSkinMatrix(const Vertex &vertex, const std::vector<glm::mat4> &boneTransforms) const
+glm::quat GLTFModel::interpolateRotation(float animationTime, const std::vector<RotationKey> &keys,
+                                         std::uint32_t &cursor) noexcept
 {
-    glm::mat4 skin(0.0f);
-    float totalWeight = 0.0f;
-
-    for (int i = 0; i < 4; ++i)
+    if (keys.empty())
     {
-        const int boneId = vertex.boneIds[i];
-        const float weight = vertex.boneWeights[i];
-
-        if (weight <= 0.0f)
-        {
-            continue;
-        }
-
-        if (boneId >= 0 && static_cast<std::size_t>(boneId) < boneTransforms.size())
-        {
-            skin += boneTransforms[static_cast<std::size_t>(boneId)] * weight;
-            totalWeight += weight;
-        }
+        return glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
     }
-
-    if (totalWeight <= 1e-6f)
+    if (keys.size() == 1)
     {
-        return glm::mat4(1.0f);
+        return keys[0].value;
     }
 
-    skin *= (1.0f / totalWeight);
+    const std::uint32_t index = seekKeyInterval(keys.data(), static_cast<std::uint32_t>(keys.size()), animationTime, cursor);
+    const RotationKey &start = keys[index];
+    const RotationKey &end = keys[index + 1];
 
-    return skin;
+    const float factor = normalizedKeyLerp(animationTime, start.time, end.time);
+    // Shortest arc, as aiQuaternion::Interpolate took
+    const glm::quat target = glm::dot(start.value, end.value) < 0.0f ? -end.value : end.value;
+    return glm::normalize(glm::slerp(start.value, target, factor));
 }
 
 glm::mat4 GLTFModel::toGlm(const aiMatrix4x4 &matrix)
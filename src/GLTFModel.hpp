@@ -5,9 +5,11 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -15,6 +17,9 @@
 
 #include <assimp/matrix4x4.h>
 
+#include "MemoryStats.hpp"
+#include "Shader.hpp"
+
 namespace Assimp
 {
     class Importer;
@@ -22,12 +27,9 @@ namespace Assimp
 
 struct aiAnimation;
 struct aiMesh;
-struct aiNode;
 struct aiNodeAnim;
 struct aiScene;
 
-class Shader;
-
 class GLTFModel
 {
 public:
@@ -43,6 +45,24 @@ public:
         glm::vec4 materialParams{0.0f, 1.0f, 0.0f, 0.0f};
     };
 
+    /// One character drawn by renderInstanced()
+    struct Instance
+    {
+        glm::mat4 model{1.0f};
+        float animationTimeSeconds{0.0f};
+        /// Detail level from selectLod(); clamped per mesh to the levels it has
+        std::uint32_t lodLevel{0};
+    };
+
+    /// Camera terms selectLod() projects the model's bounds with
+    struct LodView
+    {
+        glm::mat4 viewProjection{1.0f};
+        /// projection[1][1]: pixels per unit of height at distance 1 is this * viewportHeight / 2
+        float projectionScaleY{1.0f};
+        float viewportHeight{0.0f};
+    };
+
     explicit GLTFModel();
     ~GLTFModel();
 
@@ -52,12 +72,58 @@ public:
     GLTFModel(GLTFModel &&) = delete;
     GLTFModel &operator=(GLTFModel &&) = delete;
 
+    static constexpr float DEFAULT_BAKE_RATE = 30.0f;
+    /// Full-detail mesh plus up to three simplified levels built at load
+    static constexpr std::uint32_t MAX_LODS = 4;
+
+    static constexpr std::uint32_t CACHE_MAGIC = 0x4D4D5742u; // "BWMM"
+    static constexpr std::uint32_t CACHE_VERSION = 1u;
+
+    /// @brief Load a model, from the binary cache when it is newer than the source file
+    /// @details A cache miss runs the Assimp import and then writes the cache. Either way the importer and
+    /// its scene are released before returning: meshes, skeleton and clips live in this object's own arrays.
     bool readFile(std::string_view filename);
+    /// @brief The CPU half of readFile(): cache read or Assimp import, no GL calls on a model never uploaded
+    /// @details Safe on a worker thread; call upload() on the GL thread afterwards.
+    bool importFile(std::string_view filename);
+    /// @brief The GL half of readFile(): create the mesh and skinning buffers from the imported arrays
+    void upload();
+    /// @brief Directory for binary model caches (created on first store); empty disables the cache
+    static void setCacheDirectory(const std::string &directory);
+    [[nodiscard]] static bool hasCacheDirectory() noexcept;
+    /// @brief Sample every clip at samplesPerSecond into one shared bone-palette buffer
+    /// @details Optional. Once baked a pose is two frame indices and a blend factor, so any number of
+    /// characters sharing this model skip the joint hierarchy and the compute skinning pass reads the
+    /// palettes straight from the GPU copy. Needs the GL context.
+    void bakeAnimations(float samplesPerSecond = DEFAULT_BAKE_RATE);
+    [[nodiscard]] bool isBaked() const noexcept;
+    /// @brief Skin every vertex once for this frame's pose
+    /// @details Runs computeShader over the bind-pose vertices into the model's skinned-vertex buffer.
+    /// render() and extractRayTraceTriangles() at the same animationTimeSeconds then reuse that pose
+    /// instead of blending bone matrices per draw or per triangle corner. With a null computeShader
+    /// only the bone palette is cached and the vertex shader keeps skinning.
+    void updateSkinning(Shader *computeShader, float animationTimeSeconds) const;
+    /// Camera matrices come from the frame uniform buffer bound by the caller
     void render(Shader &shader,
                 const glm::mat4 &model,
-                const glm::mat4 &view,
-                const glm::mat4 &projection,
-                float animationTimeSeconds) const;
+                float animationTimeSeconds,
+                std::uint32_t lodLevel = 0) const;
+    /// @brief Pick the detail level from the projected screen height of the bind-pose bounds
+    /// @details previousLevel is the level this character drew with last frame; a level only changes once
+    /// the size is clearly past its threshold, so characters near a boundary do not flicker between levels.
+    [[nodiscard]] std::uint32_t selectLod(const glm::mat4 &model, const LodView &view,
+                                          std::uint32_t previousLevel) const noexcept;
+    /// @brief Screen height in pixels of the bind-pose bounds placed by model
+    /// @return The largest float when the camera is inside the bounds or they are behind it; 0 without bounds
+    [[nodiscard]] float getProjectedHeight(const glm::mat4 &model, const LodView &view) const noexcept;
+    /// @brief Bind-pose bounding sphere placed by model: xyz centre, w radius
+    [[nodiscard]] glm::vec4 getBoundingSphere(const glm::mat4 &model) const noexcept;
+    /// @brief Draw all instances with one instanced draw call per mesh
+    /// @details Every instance's palette goes into one storage buffer the vertex shader indexes by
+    /// gl_InstanceID; a baked model only writes frame offsets and reads the baked palettes in place.
+    /// Poses are evaluated through the same cache as render(), so draw the single character first.
+    /// Instances are grouped by lodLevel, one draw per mesh and level present.
+    void renderInstanced(Shader &shader, std::span<const Instance> instances) const;
     void extractRayTraceTriangles(std::vector<RayTraceTriangle> &outTriangles,
                                   const glm::mat4 &model,
                                   float animationTimeSeconds,
@@ -73,11 +139,30 @@ public:
 
     [[nodiscard]] std::vector<std::string> getMeshes() const;
     [[nodiscard]] std::size_t getTotalMeshBones() const noexcept;
+    /// Most detail levels any mesh has, 1 when nothing could be simplified
+    [[nodiscard]] std::uint32_t getLodCount() const noexcept;
 
 private:
     static constexpr std::uint32_t kMaxBonesPerVertex = 4;
     static constexpr std::uint32_t kMaxShaderBones = 200;
+    /// SSBO binding skinned.vert.glsl reads pre-skinned vertices from
+    static constexpr GLuint kSkinnedVertexBinding = 3;
+    static constexpr GLuint kSkinningGroupSize = 64;
+    /// SSBO bindings of the instanced path in skinned.vert.glsl
+    static constexpr GLuint kInstancePaletteBinding = 4;
+    static constexpr GLuint kInstanceDataBinding = 5;
+    /// Fraction of the full index count each level aims for
+    static constexpr std::array<float, MAX_LODS> kLodIndexRatios{1.0f, 0.5f, 0.25f, 0.125f};
+    /// Collapses may move the surface by at most this fraction of the mesh extent
+    static constexpr float kLodMaxError = 0.04f;
+    /// Meshes below this many triangles keep only the full level
+    static constexpr std::size_t kLodMinTriangles = 128;
+    /// Screen height in pixels under which level i gives way to level i + 1
+    static constexpr std::array<float, MAX_LODS - 1> kLodPixelHeights{220.0f, 110.0f, 50.0f};
+    /// Fraction past a threshold the size must move before the level switches
+    static constexpr float kLodHysteresis = 0.15f;
 
+    /// Full-precision vertex kept on the CPU for skinning sources, ray tracing and simplification
     struct Vertex
     {
         glm::vec3 position{0.0f};
@@ -87,23 +172,60 @@ private:
         glm::vec4 boneWeights{0.0f};
     };
 
+    /// Raster vertex as uploaded, 28 bytes instead of Vertex's 64
+    struct PackedVertex
+    {
+        glm::vec3 position{0.0f};
+        /// Signed normalized 10:10:10:2, xyz
+        std::uint32_t normal{0};
+        /// Unsigned normalized 16-bit over the mesh's UV bounds, see MeshBuffers::texCoordRange
+        std::array<std::uint16_t, 2> texCoord{};
+        std::array<std::uint8_t, kMaxBonesPerVertex> boneIds{};
+        /// Unsigned normalized 8-bit, summing to 255
+        std::array<std::uint8_t, kMaxBonesPerVertex> boneWeights{};
+    };
+    static_assert(sizeof(PackedVertex) == 28, "PackedVertex must stay tightly packed");
+
+    /// Index range of one detail level inside the mesh's element buffer
+    struct MeshLod
+    {
+        /// Byte offset into the element buffer
+        std::uintptr_t firstIndex{0};
+        GLsizei indexCount{0};
+    };
+
     struct MeshBuffers
     {
         GLuint vao{0};
         GLuint vbo{0};
+        /// All levels back to back; every level indexes the same vertices
         GLuint ebo{0};
-        GLsizei indexCount{0};
+        std::array<MeshLod, MAX_LODS> lods{};
+        std::uint32_t lodCount{1};
+        /// Decodes PackedVertex::texCoord: uv = xy + unorm * zw
+        glm::vec4 texCoordRange{0.0f, 0.0f, 1.0f, 1.0f};
         bool usesSkinning{false};
         bool hasTexCoords{false};
+        /// First vertex of this mesh in the skinned-vertex buffers, -1 when not skinned
+        GLint skinBase{-1};
+        /// Skeleton joint of the node that owns the mesh, -1 if it was not found
+        std::int32_t joint{-1};
         glm::mat4 nodeTransform{1.0f};
         std::string nodeName;
+
+        /// Attribute layout of PackedVertex for skinned.vert.glsl, against the bound VAO and vertex buffer
+        static void setupAttributes() noexcept;
     };
 
     struct CpuMeshData
     {
         std::vector<Vertex> vertices;
+        /// Full-detail triangles
         std::vector<std::uint32_t> indices;
+        /// Simplified levels, packed after indices in the element buffer
+        std::vector<std::uint32_t> coarseIndices;
         bool usesSkinning{false};
+        std::size_t skinBase{0};
         glm::mat4 nodeTransform{1.0f};
         std::string nodeName;
         glm::vec4 rayTraceAlbedoAndMaterial{0.8f, 0.82f, 0.9f, 0.0f};
@@ -118,51 +240,260 @@ private:
         void addBoneData(std::uint32_t boneId, float weight) noexcept;
     };
 
+    /// Bind-pose vertex as skinning.cs.glsl reads it (std430)
+    struct SkinSourceVertex
+    {
+        glm::vec4 position{0.0f};
+        glm::vec4 normal{0.0f};
+        glm::ivec4 boneIds{0, 0, 0, 0};
+        glm::vec4 boneWeights{0.0f};
+    };
+
+    /// Output of one skinned vertex; matches the compute shader's vec4 pair
+    struct SkinnedVertex
+    {
+        glm::vec4 position{0.0f, 0.0f, 0.0f, 1.0f};
+        glm::vec4 normal{0.0f, 1.0f, 0.0f, 0.0f};
+    };
+
+    /// Per instance and mesh entry of an instanced draw (std430)
+    struct InstanceData
+    {
+        glm::mat4 model{1.0f};
+        /// First palette entry of the two frames to blend; both equal when the palette is not baked
+        glm::uvec2 paletteBase{0u, 0u};
+        float paletteBlend{0.0f};
+        float padding{0.0f};
+    };
+
+    /// Node of the compiled skeleton; joints are stored depth-first so a parent always precedes its children
+    struct Joint
+    {
+        std::int32_t parent{-1};
+        /// Bone palette slot this node drives, -1 for plain nodes
+        std::int32_t bone{-1};
+        glm::mat4 bindLocal{1.0f};
+        std::string name;
+    };
+
+    /// Key interval each channel sampled last; a clip playing forward only ever steps these ahead
+    struct KeyCursor
+    {
+        std::uint32_t position{0};
+        std::uint32_t rotation{0};
+        std::uint32_t scaling{0};
+    };
+
+    struct VectorKey
+    {
+        float time{0.0f};
+        glm::vec3 value{0.0f};
+    };
+
+    struct RotationKey
+    {
+        float time{0.0f};
+        glm::quat value{1.0f, 0.0f, 0.0f, 0.0f};
+    };
+
+    /// Keys of one joint, copied out of the importer's aiNodeAnim
+    struct Channel
+    {
+        std::vector<VectorKey> positions;
+        std::vector<RotationKey> rotations;
+        std::vector<VectorKey> scalings;
+    };
+
+    /// One animation clip resolved against the compiled skeleton at load time
+    struct AnimationBinding
+    {
+        std::string name;
+        /// False for a null clip in the source file; kept so clip indices match the file
+        bool valid{false};
+        float durationTicks{0.0f};
+        float ticksPerSecond{25.0f};
+        /// Channels whose node resolves to a bone (any keys / more than one key)
+        unsigned int mappedChannels{0};
+        unsigned int mappedTemporalChannels{0};
+        /// Channels of the joints this clip animates
+        std::vector<Channel> channels;
+        /// Per joint: index into channels, or -1 to keep the bind transform
+        std::vector<std::int32_t> jointChannels;
+        mutable std::vector<KeyCursor> cursors;
+    };
+
+    /// Two frames of the baked buffers (absolute indices) and how far to blend from the first to the second
+    struct BakedFrame
+    {
+        std::uint32_t first{0};
+        std::uint32_t second{0};
+        float blend{0.0f};
+    };
+
+    struct BakedClip
+    {
+        std::uint32_t firstFrame{0};
+        std::uint32_t frameCount{0};
+    };
+
+    /// Everything derived from one animation time, shared by every consumer within a frame
+    struct PoseCache
+    {
+        float animationTimeSeconds{0.0f};
+        int animationIndex{-1};
+        bool valid{false};
+        bool gpuSkinned{false};
+        bool cpuSkinned{false};
+        /// The palette comes from boneFrame of the baked buffers rather than boneTransforms
+        bool baked{false};
+        bool paletteReady{false};
+        BakedFrame boneFrame;
+        std::vector<glm::mat4> boneTransforms;
+        /// Node transform applied to each mesh (identity for skinned meshes)
+        std::vector<glm::mat4> meshTransforms;
+        std::vector<SkinnedVertex> cpuVertices;
+    };
+
     void clearGpuBuffers() noexcept;
+    void resolveSkinUniforms(Shader &shader) const;
+    /// Copy data into this frame's stream and bind it as an SSBO; buffer is respecified when the stream is full
+    void bindStreamedStorage(GLuint binding, const void *data, GLsizeiptr bytes, GLuint &buffer) const noexcept;
+    /// Assimp import into the CPU-side arrays; the caller uploads and releases the importer afterwards
+    bool importScene(std::string_view filename);
     void buildMeshesFromScene(const aiScene *scene);
+    /// Create every mesh's vertex array and buffers from mCpuMeshes
+    void uploadMeshes();
+    [[nodiscard]] static std::string cachePathFor(std::string_view filename);
+    /// File size and write time of the source, so an edited model invalidates its cache; 0 if unknown
+    [[nodiscard]] static std::uint64_t sourceStamp(std::string_view filename) noexcept;
+    [[nodiscard]] bool readCache(const std::string &path, std::uint64_t stamp);
+    void writeCache(const std::string &path, std::uint64_t stamp) const;
+    /// Reorder triangles for the post-transform cache and overdraw, then vertices into first-use order
+    static void optimizeMeshOrder(std::vector<Vertex> &vertices, std::vector<std::uint32_t> &indices);
+    /// Quantize to the raster layout; texCoordRange receives the UV decode terms
+    [[nodiscard]] static std::vector<PackedVertex> packVertices(const std::vector<Vertex> &vertices,
+                                                                glm::vec4 &texCoordRange);
+    /// @brief Simplify indices into mesh.lods; returns the simplified levels as packed after indices
+    [[nodiscard]] std::vector<std::uint32_t> buildLodChain(const std::vector<Vertex> &vertices,
+                                                           const std::vector<std::uint32_t> &indices,
+                                                           MeshBuffers &mesh) const;
+    /// Bind-pose bounds of all meshes, placed by their node transforms
+    void computeBounds() noexcept;
+    void createSkinningBuffers();
+    /// @return The pose for timeSeconds, recomputed only when the time changed since the last call
+    const PoseCache &evaluatePose(float timeSeconds) const;
+    /// Bone palette of the cached pose; a baked pose blends its two frames on first use
+    const std::vector<glm::mat4> &poseBoneTransforms() const;
+    /// Fallback for consumers that need positions on the CPU: each skinned vertex is blended once
+    void skinOnCpu() const;
+    /// Node transform of every mesh from joint globals sampled for the active clip
+    void writeMeshTransforms(const std::vector<glm::mat4> &globals, glm::mat4 *out) const noexcept;
+    [[nodiscard]] BakedFrame findBakedFrame(const AnimationBinding &binding, float timeSeconds) const noexcept;
+    void clearBakedAnimations() noexcept;
     void loadBones(const struct aiMesh *mesh,
                    std::vector<VertexBoneData> &vertexBones,
                    const glm::mat4 &meshNodeTransform);
 
-    [[nodiscard]] std::vector<glm::mat4> computeBoneTransforms(float timeSeconds) const;
-    [[nodiscard]] const aiAnimation *getActiveAnimation() const;
-    [[nodiscard]] float computeAnimationTimeTicks(const aiAnimation *animation, float timeSeconds) const;
-    void buildNodeTransformMap(float animationTime,
-                               const aiNode *node,
-                               const glm::mat4 &parentTransform,
-                               const aiAnimation *animation,
-                               std::unordered_map<std::string, glm::mat4> &nodeTransforms) const;
-    void readNodeHierarchy(float animationTime,
-                           const aiNode *node,
-                           const glm::mat4 &parentTransform,
-                           const aiAnimation *animation,
-                           std::vector<glm::mat4> &transforms) const;
+    /// Flatten the aiNode tree into mJoints and point each mesh at its node's joint
+    void compileSkeleton();
+    /// Resolve joint bones and every clip's channels; needs the final bone name mappings
+    void bindSkeleton();
+
+    /// @brief Global transform of every joint at animationTime; a null binding gives the bind pose
+    /// @details One linear pass over mJoints: no hashing, no string compares, no allocation once globals is sized
+    void sampleJoints(const AnimationBinding *binding, float animationTime, std::vector<glm::mat4> &globals) const;
+    void writeBonePalette(const std::vector<glm::mat4> &globals, std::vector<glm::mat4> &transforms) const;
+    /// The clip the bone palette follows: the active one, or a mapped pose clip when it animates no bones
+    [[nodiscard]] const AnimationBinding *selectBoneBinding(const AnimationBinding *active, float timeSeconds) const noexcept;
+    [[nodiscard]] const AnimationBinding *getActiveBinding() const noexcept;
+    [[nodiscard]] static float toAnimationTicks(const AnimationBinding &binding, float timeSeconds) noexcept;
 
     [[nodiscard]] const aiNodeAnim *findNodeAnim(const aiAnimation *animation, std::string_view nodeName) const;
     [[nodiscard]] const std::uint32_t *findBoneIndex(std::string_view nodeName) const;
-    [[nodiscard]] std::uint32_t findScaling(float animationTime, const aiNodeAnim *nodeAnim) const;
-    [[nodiscard]] std::uint32_t findRotation(float animationTime, const aiNodeAnim *nodeAnim) const;
-    [[nodiscard]] std::uint32_t findPosition(float animationTime, const aiNodeAnim *nodeAnim) const;
+    [[nodiscard]] static Channel copyChannel(const aiNodeAnim &nodeAnim);
 
-    [[nodiscard]] glm::vec3 interpolateScaling(float animationTime, const aiNodeAnim *nodeAnim) const;
-    [[nodiscard]] glm::quat interpolateRotation(float animationTime, const aiNodeAnim *nodeAnim) const;
-    [[nodiscard]] glm::vec3 interpolatePosition(float animationTime, const aiNodeAnim *nodeAnim) const;
-    [[nodiscard]] glm::mat4 computeSkinMatrix(const Vertex &vertex, const std::vector<glm::mat4> &boneTransforms) const;
+    /// Keys are sampled from cursor on; an empty track gives fallback
+    [[nodiscard]] static glm::vec3 interpolateVector(float animationTime, const std::vector<VectorKey> &keys,
+                                                     std::uint32_t &cursor, const glm::vec3 &fallback) noexcept;
+    [[nodiscard]] static glm::quat interpolateRotation(float animationTime, const std::vector<RotationKey> &keys,
+                                                       std::uint32_t &cursor) noexcept;
 
     [[nodiscard]] static glm::mat4 toGlm(const aiMatrix4x4 &matrix);
 
 private:
+    static std::string sCacheDirectory;
+
+    /// Only alive during importScene()
     std::unique_ptr<Assimp::Importer> mImporter;
     const aiScene *mScene{nullptr};
     glm::mat4 mGlobalInverseTransform{1.0f};
 
     std::vector<MeshBuffers> mMeshes;
     std::vector<CpuMeshData> mCpuMeshes;
+    /// Source mesh names and raw bone count, kept for diagnostics after the scene is gone
+    std::vector<std::string> mMeshNames;
+    std::size_t mTotalMeshBones{0};
+    /// Bind-pose bounding sphere in model space, for selectLod() and culling
+    glm::vec3 mBoundsCenter{0.0f};
+    float mBoundsRadius{0.0f};
+    std::uint32_t mLodCount{1};
     std::unordered_map<std::string, std::uint32_t> mBoneMapping;
     std::unordered_map<std::string, std::uint32_t> mCanonicalBoneMapping;
     std::vector<glm::mat4> mBoneOffsets;
     std::vector<glm::mat4> mBoneMeshNodeTransforms;
     int mPreferredAnimationIndex{-1};
+
+    std::vector<Joint> mJoints;
+    std::vector<AnimationBinding> mAnimationBindings;
+    /// Clips with at least one channel on a bone, for models whose active clip moves no bones
+    std::vector<std::uint32_t> mMappedPoseAnimations;
+    mutable std::vector<glm::mat4> mJointScratch;
+
+    /// Parallel to mAnimationBindings; frames of all clips are packed back to back
+    std::vector<BakedClip> mBakedClips;
+    /// Frame-major: mBoneOffsets.size() palette entries / mMeshes.size() mesh transforms per frame
+    std::vector<glm::mat4> mBakedPalettes;
+    std::vector<glm::mat4> mBakedMeshTransforms;
+    float mBakeRate{0.0f};
+    GLuint mBakedPaletteBuffer{0};
+
+    // Handles are resolved the first time a given shader renders this model
+    struct SkinUniforms
+    {
+        Shader::UniformHandle bones, boneCount, model, hasTexCoord, skinnedBase;
+        Shader::UniformHandle instanced, instanceStride, instanceMesh, instanceBase;
+    };
+    mutable const Shader *mSkinUniformShader{nullptr};
+    mutable SkinUniforms mSkinUniforms;
+
+    struct SkinComputeUniforms
+    {
+        Shader::UniformHandle vertexCount, boneCount, paletteBase, paletteBlend;
+    };
+    mutable const Shader *mSkinComputeShader{nullptr};
+    mutable SkinComputeUniforms mSkinComputeUniforms;
+
+    GLuint mSkinSourceBuffer{0};
+    GLuint mSkinBoneBuffer{0};
+    GLuint mSkinnedVertexBuffer{0};
+    GLuint mSkinnedVertexCount{0};
+    mutable PoseCache mPose;
+
+    mutable std::vector<InstanceData> mInstanceScratch;
+    /// Instance indices ordered by detail level, and where each level's run starts
+    mutable std::vector<std::uint32_t> mInstanceOrderScratch;
+    mutable std::array<std::uint32_t, MAX_LODS + 1> mInstanceLodStarts{};
+    mutable std::vector<glm::mat4> mInstancePaletteScratch;
+    mutable GLuint mInstanceDataBuffer{0};
+    mutable GLuint mInstancePaletteBuffer{0};
+
+    MemoryStats::Allocation mMeshGpuBytes{MemoryStats::Category::GPU_VERTEX_BUFFERS};
+    /// Skinning sources, skinned output and the bone palette
+    MemoryStats::Allocation mSkinGpuBytes{MemoryStats::Category::GPU_STORAGE_BUFFERS};
+    MemoryStats::Allocation mBakedGpuBytes{MemoryStats::Category::GPU_STORAGE_BUFFERS};
+    MemoryStats::Allocation mCpuMeshBytes{MemoryStats::Category::CPU_MODEL_MESHES};
+    /// Baked frames and the skeleton they were sampled from; set by bakeAnimations()
+    MemoryStats::Allocation mAnimationBytes{MemoryStats::Category::CPU_MODEL_ANIMATION};
 };
 
 #endif // GLTF_MODEL_HPP
@@ -0,0 +1,202 @@
+#include "GPUProfiler.hpp"
+
+#include <algorithm>
+
+std::array<std::array<GLuint, GPUProfiler::PASS_COUNT>, GPUProfiler::FRAME_SETS> GPUProfiler::sQueries{};
+std::array<std::array<bool, GPUProfiler::PASS_COUNT>, GPUProfiler::FRAME_SETS> GPUProfiler::sIssued{};
+std::array<GPUProfiler::History, GPUProfiler::PASS_COUNT> GPUProfiler::sHistory{};
+std::size_t GPUProfiler::sFrameSet = 0;
+std::optional<float> GPUProfiler::sLastFrameMs;
+std::array<std::optional<float>, GPUProfiler::PASS_COUNT> GPUProfiler::sLastPassMs{};
+bool GPUProfiler::sEnabled = false;
+bool GPUProfiler::sCreated = false;
+bool GPUProfiler::sInPass = false;
+
+GPUProfiler::Scope::Scope(Pass pass) noexcept
+    : mActive{sEnabled && !sInPass}
+{
+    if (mActive)
+    {
+        begin(pass);
+    }
+}
+
+GPUProfiler::Scope::~Scope() noexcept
+{
+    if (mActive)
+    {
+        end();
+    }
+}
+
+void GPUProfiler::beginFrame() noexcept
+{
+    sLastFrameMs.reset();
+    sLastPassMs.fill(std::nullopt);
+    if (!sEnabled)
+    {
+        return;
+    }
+
+    if (!sCreated)
+    {
+        for (auto &set : sQueries)
+        {
+            glGenQueries(static_cast<GLsizei>(set.size()), set.data());
+        }
+        sCreated = true;
+    }
+
+    // The other set was written last frame; take whatever the GPU has finished
+    const std::size_t readSet = (sFrameSet + 1) % FRAME_SETS;
+    float frameMs = 0.0f;
+    bool frameComplete = true;
+    bool frameIssued = false;
+    for (std::size_t pass = 0; pass < PASS_COUNT; ++pass)
+    {
+        if (!sIssued[readSet][pass])
+        {
+            continue;
+        }
+        frameIssued = true;
+
+        GLuint available = GL_FALSE;
+        glGetQueryObjectuiv(sQueries[readSet][pass], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available == GL_FALSE)
+        {
+            // Dropped rather than waited for; the query object is simply reused
+            frameComplete = false;
+            continue;
+        }
+
+        GLuint64 elapsedNs = 0;
+        glGetQueryObjectui64v(sQueries[readSet][pass], GL_QUERY_RESULT, &elapsedNs);
+
+        const auto elapsedMs = static_cast<float>(static_cast<double>(elapsedNs) * 1e-6);
+        frameMs += elapsedMs;
+        sLastPassMs[pass] = elapsedMs;
+
+        History &history = sHistory[pass];
+        history.samplesMs[history.next] = elapsedMs;
+        history.next = (history.next + 1) % HISTORY_LENGTH;
+        history.count = std::min(history.count + 1, HISTORY_LENGTH);
+    }
+
+    if (frameIssued && frameComplete)
+    {
+        sLastFrameMs = frameMs;
+    }
+
+    sIssued[readSet].fill(false);
+    sFrameSet = readSet;
+}
+
+void GPUProfiler::begin(Pass pass) noexcept
+{
+    if (!sCreated)
+    {
+        return;
+    }
+
+    const auto index = static_cast<std::size_t>(pass);
+    // A pass drawn twice in a frame keeps its first timing
+    if (sIssued[sFrameSet][index])
+    {
+        return;
+    }
+
+    glBeginQuery(GL_TIME_ELAPSED, sQueries[sFrameSet][index]);
+    sIssued[sFrameSet][index] = true;
+    sInPass = true;
+}
+
+void GPUProfiler::end() noexcept
+{
+    if (!sInPass)
+    {
+        return;
+    }
+
+    glEndQuery(GL_TIME_ELAPSED);
+    sInPass = false;
+}
+
+GPUProfiler::PassStats GPUProfiler::getPassStats(Pass pass) noexcept
+{
+    const History &history = sHistory[static_cast<std::size_t>(pass)];
+
+    PassStats stats;
+    stats.samples = history.count;
+    if (history.count == 0)
+    {
+        return stats;
+    }
+
+    float total = 0.0f;
+    for (std::size_t i = 0; i < history.count; ++i)
+    {
+        total += history.samplesMs[i];
+        stats.maxMs = std::max(stats.maxMs, history.samplesMs[i]);
+    }
+    stats.averageMs = total / static_cast<float>(history.count);
+    return stats;
+}
+
+std::optional<float> GPUProfiler::getLastFrameMs() noexcept
+{
+    return sLastFrameMs;
+}
+
+std::optional<float> GPUProfiler::getLastPassMs(Pass pass) noexcept
+{
+    return sLastPassMs[static_cast<std::size_t>(pass)];
+}
+
+const char *GPUProfiler::getPassName(Pass pass) noexcept
+{
+    switch (pass)
+    {
+    case Pass::OCCLUSION:
+        return "Occlusion cull";
+    case Pass::MAZE:
+        return "Maze";
+    case Pass::GOAL_PATH:
+        return "Goal path";
+    case Pass::BILLBOARDS:
+        return "Billboards";
+    case Pass::PICKUPS:
+        return "Pickups";
+    case Pass::SKINNED_MODEL:
+        return "Skinned model";
+    case Pass::PARTICLES:
+        return "Particles";
+    case Pass::SHADOW:
+        return "Shadow";
+    case Pass::REFLECTION:
+        return "Reflection";
+    case Pass::POST_PROCESS:
+        return "Post process";
+    default:
+        return "?";
+    }
+}
+
+void GPUProfiler::shutdown() noexcept
+{
+    if (!sCreated)
+    {
+        return;
+    }
+
+    for (auto &set : sQueries)
+    {
+        glDeleteQueries(static_cast<GLsizei>(set.size()), set.data());
+        set.fill(0);
+    }
+    for (auto &set : sIssued)
+    {
+        set.fill(false);
+    }
+    sCreated = false;
+    sInPass = false;
+}
@@ -0,0 +1,100 @@
+#ifndef GPU_PROFILER_HPP
+#define GPU_PROFILER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include <glad/glad.h>
+
+/// @brief GL_TIME_ELAPSED timings of each render pass with rolling averages and maxima
+/// @details Queries are double buffered: frame N writes one set while the set written in
+/// frame N-1 is read back, and only once GL reports it available, so reading never stalls.
+/// Passes must not nest (GL allows one active GL_TIME_ELAPSED query at a time).
+class GPUProfiler
+{
+public:
+    enum class Pass : std::uint8_t
+    {
+        OCCLUSION,
+        MAZE,
+        GOAL_PATH,
+        BILLBOARDS,
+        PICKUPS,
+        SKINNED_MODEL,
+        PARTICLES,
+        SHADOW,
+        REFLECTION,
+        POST_PROCESS,
+        COUNT
+    };
+
+    static constexpr std::size_t PASS_COUNT = static_cast<std::size_t>(Pass::COUNT);
+    static constexpr std::size_t HISTORY_LENGTH = 120;
+
+    struct PassStats
+    {
+        float averageMs{0.0f};
+        float maxMs{0.0f};
+        std::size_t samples{0};
+    };
+
+    /// Times the enclosing block as one pass
+    class Scope
+    {
+    public:
+        explicit Scope(Pass pass) noexcept;
+        ~Scope() noexcept;
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        bool mActive{false};
+    };
+
+    /// @brief Collect last frame's results and switch query sets; call once before drawing
+    static void beginFrame() noexcept;
+
+    /// Disabled profiling issues no GL calls; history is kept so re-enabling resumes the averages
+    static void setEnabled(bool enabled) noexcept { sEnabled = enabled; }
+    [[nodiscard]] static bool isEnabled() noexcept { return sEnabled; }
+
+    [[nodiscard]] static PassStats getPassStats(Pass pass) noexcept;
+
+    /// @brief Sum of every pass in the set collected by the latest beginFrame (one frame behind)
+    /// @return nullopt when disabled or when any pass of that frame was not ready, so a partial sum is never reported
+    [[nodiscard]] static std::optional<float> getLastFrameMs() noexcept;
+    /// One pass of the set collected by the latest beginFrame; nullopt when it was not drawn or not ready
+    [[nodiscard]] static std::optional<float> getLastPassMs(Pass pass) noexcept;
+    [[nodiscard]] static const char *getPassName(Pass pass) noexcept;
+
+    /// Delete the query objects; call while the GL context is still current
+    static void shutdown() noexcept;
+
+private:
+    static constexpr std::size_t FRAME_SETS = 2;
+
+    struct History
+    {
+        std::array<float, HISTORY_LENGTH> samplesMs{};
+        std::size_t next{0};
+        std::size_t count{0};
+    };
+
+    static void begin(Pass pass) noexcept;
+    static void end() noexcept;
+
+    static std::array<std::array<GLuint, PASS_COUNT>, FRAME_SETS> sQueries;
+    static std::array<std::array<bool, PASS_COUNT>, FRAME_SETS> sIssued;
+    static std::array<History, PASS_COUNT> sHistory;
+    static std::size_t sFrameSet;
+    static std::optional<float> sLastFrameMs;
+    static std::array<std::optional<float>, PASS_COUNT> sLastPassMs;
+    static bool sEnabled;
+    static bool sCreated;
+    static bool sInPass;
+};
+
+#endif // GPU_PROFILER_HPP
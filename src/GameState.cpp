@@ -11,27 +11,35 @@
 #include <cstring>
 #include <cstdint>
 #include <limits>
+#include <optional>
 #include <queue>
 #include <ranges>
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glad/glad.h>
 
+#include "FlyThroughBenchmark.hpp"
 #include "Font.hpp"
 #include "GLSDLHelper.hpp"
+#include "GLStateCache.hpp"
+#include "GPUProfiler.hpp"
+#include "InputRecorder.hpp"
 #include "Level.hpp"
 #include "MusicPlayer.hpp"
 #include "Options.hpp"
 #include "Player.hpp"
 #include "ResourceManager.hpp"
+#include "RollbackSession.hpp"
 #include "Shader.hpp"
 #include "SoundPlayer.hpp"
 #include "Sphere.hpp"
+#include "StartupTimeline.hpp"
 #include "StateStack.hpp"
 #include "Texture.hpp"
 #include "VertexArrayObject.hpp"
@@ -48,22 +56,13 @@ namespace
     constexpr float kRasterZoomStep = 0.85f;
     constexpr float kRasterWallScreenMarginPx = 20.0f;
 
-    std::pair<int, int> computeRenderResolution(int windowWidth, int windowHeight, std::size_t targetPixels, float minScale) noexcept
+    std::pair<int, int> computeRenderResolution(int windowWidth, int windowHeight, float scale) noexcept
     {
         if (windowWidth <= 0 || windowHeight <= 0)
         {
             return {1, 1};
         }
 
-        const std::size_t windowPixels = static_cast<std::size_t>(windowWidth) * static_cast<std::size_t>(windowHeight);
-        float scale = 1.0f;
-
-        if (windowPixels > targetPixels)
-        {
-            scale = std::sqrt(static_cast<float>(targetPixels) / static_cast<float>(windowPixels));
-            scale = std::max(scale, minScale);
-        }
-
         const int renderWidth = std::max(1, static_cast<int>(std::lround(static_cast<float>(windowWidth) * scale)));
         const int renderHeight = std::max(1, static_cast<int>(std::lround(static_cast<float>(windowHeight) * scale)));
         return {renderWidth, renderHeight};
@@ -97,16 +96,64 @@ namespace
         outScreenPos.y = (1.0f - (ndc.y * 0.5f + 0.5f)) * static_cast<float>(windowHeight);
         return true;
     }
+
+    /// Player circle against the maze walls; fits through a corridor (cellSize - wallThickness ≈ 2.2)
+    constexpr float kPlayerRadius = 0.42f;
+    /// Multiple passes handle corner pile-ups
+    constexpr int kWallResolveIterations = 6;
+    /// Well under the wall thickness (0.20), so a substep can never skip past a wall
+    constexpr float kMaxSubstepDist = 0.07f;
+
+    bool rollbackNetcodeEnabled(const State::Context &context) noexcept
+    {
+        if (auto *optionsManager = context.getOptionsManager(); optionsManager != nullptr)
+        {
+            try
+            {
+                return optionsManager->get(GUIOptions::ID::DE_FACTO).getRollbackNetcode();
+            }
+            catch (const std::exception &)
+            {
+            }
+        }
+        return false;
+    }
+
+    /// Benchmarks and input recordings each pin the maze so runs see the same walls, and so do the
+    /// peers of a rollback match, which all resolve movement against it
+    std::optional<std::uint32_t> runMazeSeed(const State::Context &context) noexcept
+    {
+        if (auto seed = FlyThroughBenchmark::getMazeSeed())
+        {
+            return seed;
+        }
+        if (auto seed = InputRecorder::getMazeSeed())
+        {
+            return seed;
+        }
+        if (rollbackNetcodeEnabled(context))
+        {
+            return RollbackSession::MAZE_SEED;
+        }
+        return std::nullopt;
+    }
 }
 
 GameState::GameState(StateStack &stack, Context context)
-    : State{stack, context}, mWorld{*context.getRenderWindow(), *context.getFontManager(), *context.getTextureManager(), *context.getShaderManager(), *context.getLevelsManager()}, mPlayer{*context.getPlayer()}, mGameMusic{nullptr}, mDisplayShader{nullptr}, mCompositeShader{nullptr}, mOITResolveShader{nullptr}, mGameIsPaused{false}
+    : State{stack, context}, mWorld{*context.getRenderWindow(), *context.getFontManager(), *context.getTextureManager(), *context.getShaderManager(), *context.getLevelsManager()}, mPlayer{*context.getPlayer()}, mGameMusic{nullptr}, mDisplayShader{nullptr}, mGameIsPaused{false}
       // Initialize camera at maze spawn position (will be updated after first chunk loads)
       ,
       mCamera{}
 {
     mPlayer.setActive(true);
     mWorld.init(); // This now initializes both 2D physics and 3D path tracer scene
+    mWorld.setTextureAtlas(context.getTextureAtlas());
+
+    if (char *prefPath = SDL_GetPrefPath("Flips And Ale", "Breaking Walls"); prefPath != nullptr)
+    {
+        mWorld.enableChunkDiskCache(std::string(prefPath) + "chunk_cache.bin");
+        SDL_free(prefPath);
+    }
 
     // Initialize player animator with character index 0
     mPlayer.initializeAnimator(0);
@@ -116,10 +163,8 @@ GameState::GameState(StateStack &stack, Context context)
     try
     {
         mDisplayShader = &shaders.get(Shaders::ID::GLSL_FULLSCREEN_QUAD);
-        mCompositeShader = &shaders.get(Shaders::ID::GLSL_COMPOSITE_SCENE);
         mHighlightTileShader = &shaders.get(Shaders::ID::GLSL_HIGHLIGHT_TILE);
-        mOITResolveShader = &shaders.get(Shaders::ID::GLSL_OIT_RESOLVE);
-        mMotionBlurShader = &shaders.get(Shaders::ID::GLSL_MOTION_BLUR);
+        mPostProcess.init(shaders.get(Shaders::ID::GLSL_POST_PROCESS));
         mShadersInitialized = true;
     }
     catch (const std::exception &e)
@@ -142,10 +187,8 @@ GameState::GameState(StateStack &stack, Context context)
     try
     {
         mDisplayTex = &textures.get(Textures::ID::RUNNER_BREAK_PLANE);
-        mNoiseTexture = &textures.get(Textures::ID::NOISE2D);
-        mTestAlbedoTexture = &textures.get(Textures::ID::SDL_LOGO);
-        mMotionBlurTex = &textures.get(Textures::ID::MOTION_BLUR_COLOR);
-        mPrevFrameTex = &textures.get(Textures::ID::PREV_FRAME);
+        mTestAlbedoHandle = textures.acquire(Textures::ID::SDL_LOGO);
+        mTestAlbedoTexture = mTestAlbedoHandle.get();
         if (mTestAlbedoTexture)
         {
             SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION,
@@ -159,7 +202,6 @@ GameState::GameState(StateStack &stack, Context context)
     {
         SDL_LogError(SDL_LOG_CATEGORY_ERROR, "GameState: Failed to get texture resources: %s", e.what());
         mDisplayTex = nullptr;
-        mNoiseTexture = nullptr;
         mTestAlbedoTexture = nullptr;
     }
 
@@ -170,17 +212,8 @@ GameState::GameState(StateStack &stack, Context context)
         mGameMusic = &music.get(Music::ID::GAME_MUSIC);
         if (mGameMusic)
         {
-
-            // Start the music - the periodic health check in update() will handle restarts if needed
-            bool wasPlaying = mGameMusic->isPlaying();
-
-            if (!wasPlaying)
-            {
-                mGameMusic->play();
-
-                // Check immediately after
-                bool nowPlaying = mGameMusic->isPlaying();
-            }
+            // Crossfades from the menu track; the music mixer restarts a stream that stops by itself
+            mGameMusic->play();
         }
     }
     catch (const std::exception &e)
@@ -259,13 +292,18 @@ GameState::GameState(StateStack &stack, Context context)
         {
             mVAOManager->get(VAOs::ID::FULLSCREEN_QUAD).bind();
         }
-        initializeMotionBlur();
         GLSDLHelper::initializeBillboardRendering();
 
         // Initialize World rendering (shaders, textures, particles, FBOs)
         mWorld.initRendering(mVAOManager, mFBOManager, context.getVBOManager(), context.getModelsManager(), mWindowWidth, mWindowHeight, mPlayer);
+        syncRenderOptions(true);
+        World::setRasterMazeSeed(runMazeSeed(context));
         mWorld.buildMazeGeometry(mPlayer);
 
+        // Link the variants every frame picks between now rather than on the first fast frame
+        mPostProcess.prepare(PostProcess::TONEMAP);
+        mPostProcess.prepare(PostProcess::TONEMAP | PostProcess::MOTION_BLUR);
+
         // Camera setup (previously inside buildRasterMazeGeometry)
         mCamera.setFieldOfView(kRasterBirdsEyeFovDeg);
         updateRasterBirdsEyeZoomLimits();
@@ -276,12 +314,8 @@ GameState::GameState(StateStack &stack, Context context)
         mLastCameraPitch = mCamera.getPitch();
 
         // Respawn the player at the centre of the first open cell of the raster maze.
-        // The maze is centred at the origin; cell (0,0) corner is at (-halfW, 0, -halfD).
         {
-            const float halfW = 0.5f * static_cast<float>(kSimpleMazeCols) * kSimpleCellSize;
-            const float halfD = 0.5f * static_cast<float>(kSimpleMazeRows) * kSimpleCellSize;
-            // True cell-centre of cell (0,0): half a cell-width in from each corner.
-            const glm::vec3 rasterSpawn(-halfW + kSimpleCellSize * 0.5f, 1.0f, -halfD + kSimpleCellSize * 0.5f);
+            const glm::vec3 rasterSpawn = getMazeSpawn();
             mPlayer.setPosition(rasterSpawn);
             mWorld.createPlayerBody(rasterSpawn); // safe: destroys any prior body first
             mCamera.setFollowTarget(rasterSpawn);
@@ -291,10 +325,41 @@ GameState::GameState(StateStack &stack, Context context)
 
         SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "GameState: Pure raster maze mode ready");
     }
+
+    // Opt-in: overlap Box2D stepping and chunk streaming with GPU submission.
+    // Input recording keeps the world on the main loop's fixed steps so a replay advances it the same
+    // way, and rollback saves and restores it between steps
+    const bool fixedStepWorld = InputRecorder::isRecording() || InputRecorder::isReplaying() || rollbackNetcodeEnabled(context);
+    if (auto *optionsManager = context.getOptionsManager(); optionsManager != nullptr && !fixedStepWorld)
+    {
+        try
+        {
+            if (optionsManager->get(GUIOptions::ID::DE_FACTO).getThreadedSimulation())
+            {
+                mWorld.startSimulationThread();
+            }
+        }
+        catch (const std::exception &e)
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "GameState: threaded simulation unavailable: %s", e.what());
+        }
+    }
+
+    InputRecorder::beginSession();
+    StartupTimeline::mark("GameState constructed");
+}
+
+void GameState::prewarm(Context context) noexcept
+{
+    // A fly-through benchmark or input replay runs over the same maze every time
+    World::setRasterMazeSeed(runMazeSeed(context));
+    World::prewarmMazeGeometry();
 }
 
 GameState::~GameState()
 {
+    // Leaving the game ends the recorded session
+    InputRecorder::finish();
     configureCursorLock(false);
     cleanupJoystickAndHaptics();
 
@@ -309,20 +374,131 @@ GameState::~GameState()
 
 void GameState::draw() const noexcept
 {
-    mWorld.drawScene(mCamera, mPlayer, mWindowWidth, mWindowHeight,
+    StartupTimeline::mark(StartupTimeline::FIRST_GAME_FRAME);
+
+    // A paused game gets no steps, so blending would keep replaying the last one
+    const float alpha = mGameIsPaused ? 1.0f : getInterpolationAlpha();
+    mPlayer.setRenderAlpha(alpha);
+    mRenderCamera = mCamera.getInterpolated(alpha);
+
+    // Frozen under a pause or menu: the scene target still holds the last frame, so only the post pass reruns
+    if (isCovered() && mSceneSnapshotValid)
+    {
+        FramebufferObject::unbind();
+        glDrawBuffer(GL_BACK);
+        glViewport(0, 0, mWindowWidth, mWindowHeight);
+        if (applyPostProcess())
+        {
+            renderPlayerTileGradientHighlight();
+            renderScoreBillboards();
+            return;
+        }
+        mSceneSnapshotValid = false;
+    }
+
+    // The sample read back this frame was rendered at the previous scale; the controller's cooldown absorbs that lag
+    if (mDynamicResolutionEnabled && mDynamicResolution.update(GPUProfiler::getLastFrameMs()))
+    {
+        applyRenderScale(mDynamicResolution.getScale());
+    }
+
+    // The post pass reads the scene target directly, so it doubles as the upscale when the scene is scaled
+    const bool scaled = mRenderWidth != mWindowWidth || mRenderHeight != mWindowHeight;
+    const bool offscreen = (scaled || mPostProcess.isInitialized()) && mWorld.beginSceneTarget(mRenderWidth, mRenderHeight);
+    mWorld.drawScene(mRenderCamera, mPlayer,
+                     offscreen ? mRenderWidth : mWindowWidth, offscreen ? mRenderHeight : mWindowHeight,
                      mModelAnimTimeSeconds, mPlayerPlanarSpeedForFx);
-    renderMotionBlur();
+    mSceneSnapshotValid = false;
+    if (offscreen)
+    {
+        GPUProfiler::Scope timer{GPUProfiler::Pass::POST_PROCESS};
+        mSceneSnapshotValid = applyPostProcess();
+        if (!mSceneSnapshotValid)
+        {
+            mWorld.resolveSceneTarget(mRenderWidth, mRenderHeight, mWindowWidth, mWindowHeight);
+        }
+    }
     renderPlayerTileGradientHighlight();
     renderScoreBillboards();
 }
 
 void GameState::updateRenderResolution() noexcept
 {
-    const auto [newRenderWidth, newRenderHeight] =
-        computeRenderResolution(mWindowWidth, mWindowHeight, kTargetRenderPixels, kMinRenderScale);
+    const float maxScale = std::clamp(mRenderQuality, kMinRenderScale, kMaxRenderScale);
+
+    // Budget against the display's refresh interval; vsync caps presentation there anyway
+    float refreshRate = 60.0f;
+    if (auto *window = getContext().getRenderWindow(); window != nullptr && window->getSDLWindow() != nullptr)
+    {
+        if (const SDL_DisplayMode *mode = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(window->getSDLWindow()));
+            mode != nullptr && mode->refresh_rate > 0.0f)
+        {
+            refreshRate = mode->refresh_rate;
+        }
+    }
+
+    DynamicResolution::Settings settings;
+    settings.minScale = std::min(kMinRenderScale, maxScale);
+    settings.maxScale = maxScale;
+    settings.targetMs = kGpuFrameBudgetFraction * 1000.0f / refreshRate;
+    mDynamicResolution.configure(settings);
+    mDynamicResolution.reset(maxScale);
+
+    // Before the targets are sized, so a new size allocates the OIT layer once at its new downscale
+    mWorld.configureOIT(mOITDownscale);
+
+    // Allocate once for the largest size the controller may pick; smaller scales render into a viewport.
+    // Needed at scale 1 too since the post pass always reads the scene from it
+    mWorld.ensureSceneTargets(static_cast<int>(std::ceil(static_cast<float>(mWindowWidth) * maxScale)),
+                              static_cast<int>(std::ceil(static_cast<float>(mWindowHeight) * maxScale)));
+
+    applyRenderScale(maxScale);
+
+    // Sized from the window, not the render scale, so dynamic resolution steps never reallocate it
+    mWorld.configureReflections(mReflectionScale, mReflectionHalfRate, mWindowWidth, mWindowHeight);
+}
+
+void GameState::syncRenderOptions(bool force) noexcept
+{
+    auto *optionsManager = getContext().getOptionsManager();
+    if (!optionsManager)
+    {
+        return;
+    }
+
+    try
+    {
+        const auto &options = optionsManager->get(GUIOptions::ID::DE_FACTO);
+        if (force || options.getRenderQuality() != mRenderQuality ||
+            options.getDynamicResolution() != mDynamicResolutionEnabled ||
+            options.getReflectionScale() != mReflectionScale ||
+            options.getReflectionHalfRate() != mReflectionHalfRate ||
+            options.getOITDownscale() != mOITDownscale)
+        {
+            mRenderQuality = options.getRenderQuality();
+            mDynamicResolutionEnabled = options.getDynamicResolution();
+            mReflectionScale = options.getReflectionScale();
+            mReflectionHalfRate = options.getReflectionHalfRate();
+            mOITDownscale = options.getOITDownscale();
+            updateRenderResolution();
+        }
+    }
+    catch (const std::exception &)
+    {
+        if (force)
+        {
+            updateRenderResolution();
+        }
+    }
+}
+
+void GameState::applyRenderScale(float scale) const noexcept
+{
+    const auto [newRenderWidth, newRenderHeight] = computeRenderResolution(mWindowWidth, mWindowHeight, scale);
 
     mRenderWidth = newRenderWidth;
     mRenderHeight = newRenderHeight;
+    mSceneSnapshotValid = false;
 }
 
 void GameState::handleWindowResize() noexcept
@@ -416,11 +592,16 @@ void GameState::renderScoreBillboards() const noexcept
 
     ImGui::End();
 
-    // Render floating score popups in world space using ImGui overlays
+    // Render floating score popups in world space into one shared ImGui draw list
+    // (a window per popup cost a Begin/End, layout pass and draw command each)
     const float aspectRatio = static_cast<float>(std::max(1, mWindowWidth)) /
                               static_cast<float>(std::max(1, mWindowHeight));
-    const glm::mat4 view = mCamera.getLookAt();
-    const glm::mat4 proj = mCamera.getPerspective(aspectRatio);
+    const glm::mat4 view = mRenderCamera.getLookAt();
+    const glm::mat4 proj = mRenderCamera.getPerspective(aspectRatio);
+
+    ImDrawList *popupDrawList = ImGui::GetBackgroundDrawList();
+    ImFont *popupFont = (scoreFont && scoreFont->get()) ? scoreFont->get() : ImGui::GetFont();
+    const float popupFontSize = (scoreFont && scoreFont->get()) ? popupFont->LegacySize : ImGui::GetFontSize();
 
     for (size_t i = 0; i < mActiveScorePopups.size(); ++i)
     {
@@ -438,89 +619,83 @@ void GameState::renderScoreBillboards() const noexcept
                                           ? ImVec4(0.1f, 1.0f, 0.2f, alpha)
                                           : ImVec4(1.0f, 0.15f, 0.15f, alpha);
 
-            char label[64];
-            snprintf(label, sizeof(label), "##popup%zu", i);
-            ImGui::SetNextWindowPos(screenPos, ImGuiCond_Always, ImVec2(0.5f, 0.5f));
-            ImGui::SetNextWindowBgAlpha(0.0f);
-            ImGui::Begin(label, nullptr,
-                         ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoInputs |
-                             ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoNav);
-
-            if (scoreFont && scoreFont->get())
-                ImGui::PushFont(scoreFont->get());
+            char label[32];
+            snprintf(label, sizeof(label), "%s%d", (value >= 0) ? "+" : "", value);
 
-            ImGui::TextColored(popupColor, "%s%d", (value >= 0) ? "+" : "", value);
-
-            if (scoreFont && scoreFont->get())
-                ImGui::PopFont();
-
-            ImGui::End();
+            const ImVec2 textSize = popupFont->CalcTextSizeA(popupFontSize, FLT_MAX, 0.0f, label);
+            popupDrawList->AddText(popupFont, popupFontSize,
+                                   ImVec2(screenPos.x - textSize.x * 0.5f, screenPos.y - textSize.y * 0.5f),
+                                   ImGui::ColorConvertFloat4ToU32(popupColor), label);
         }
     }
 }
 
-void GameState::initializeMotionBlur() noexcept
+bool GameState::applyPostProcess() const noexcept
 {
-    // Resize managed render textures to current window dimensions
-    mMotionBlurTex->loadRenderTarget(std::max(1, mWindowWidth), std::max(1, mWindowHeight),
-                                     Texture::RenderTargetFormat::RGBA16F, 0);
-    mPrevFrameTex->loadRenderTarget(std::max(1, mWindowWidth), std::max(1, mWindowHeight),
-                                   Texture::RenderTargetFormat::RGBA16F, 0);
-
-    // Motion blur FBO is managed by FBOManager (loaded in LoadingState)
+    if (!mPostProcess.isInitialized() || !mVAOManager)
+    {
+        return false;
+    }
 
-    mMotionBlurInitialized = true;
-}
+    const glm::ivec2 targetSize = mWorld.getSceneTargetSize();
+    PostProcess::Inputs inputs;
+    inputs.sceneTexture = mWorld.getSceneColorTexture();
+    inputs.renderWidth = mRenderWidth;
+    inputs.renderHeight = mRenderHeight;
+    inputs.targetWidth = targetSize.x;
+    inputs.targetHeight = targetSize.y;
+
+    const World::OITTargets oit = mWorld.getOITTargets();
+    inputs.oitAccumTexture = oit.accum;
+    inputs.oitRevealTexture = oit.reveal;
+    inputs.oitDownscale = oit.downscale;
+    inputs.oitDepthTexture = oit.depth;
+    inputs.sceneDepthTexture = oit.sceneDepth;
+
+    std::uint32_t features = PostProcess::TONEMAP;
+    if (mWorld.hasTransparentLayer())
+    {
+        features |= PostProcess::OIT;
+    }
 
-void GameState::renderMotionBlur() const noexcept
-{
-    const glm::vec2 playerVel = mWorld.getPlayerVelocity();
-    const float speed = glm::length(playerVel);
+    if (!mGameIsPaused && mPlayerPlanarSpeedForFx >= kMotionBlurMinSpeed)
+    {
+        const float aspectRatio = static_cast<float>(std::max(1, mWindowWidth)) /
+                                  static_cast<float>(std::max(1, mWindowHeight));
+        const glm::mat4 &view = mRenderCamera.getLookAt();
+        const glm::mat4 &viewProjection = mRenderCamera.getViewProjection(aspectRatio);
+
+        // Follow a floor point ahead of the camera: the camera moves with the player, so that point
+        // slides across the screen by the player's displacement over the shutter interval
+        const glm::vec3 eye = glm::vec3(glm::inverse(view)[3]);
+        glm::vec3 forward(-view[0][2], 0.0f, -view[2][2]);
+        forward = (glm::length(forward) > 1e-4f) ? glm::normalize(forward) : glm::vec3(0.0f, 0.0f, -1.0f);
+        glm::vec3 anchor = eye + forward * kMotionBlurAnchorDistance;
+        anchor.y = mPlayer.getPosition().y;
+
+        const glm::vec4 now = viewProjection * glm::vec4(anchor, 1.0f);
+        const glm::vec4 before = viewProjection * glm::vec4(anchor + mPlayerVelocityForFx * kMotionBlurShutterSeconds, 1.0f);
+        if (now.w > 1e-4f && before.w > 1e-4f)
+        {
+            glm::vec2 velocity = (glm::vec2(now) / now.w - glm::vec2(before) / before.w) * 0.5f;
+            const float length = glm::length(velocity);
+            if (length > kMotionBlurMaxUV)
+            {
+                velocity *= kMotionBlurMaxUV / length;
+            }
+            inputs.blurVelocity = velocity;
+            features |= PostProcess::MOTION_BLUR;
+        }
+    }
 
-    // Only apply motion blur when moving fast enough
-    if (speed < 2.0f)
-        return;
+    // Keep the scene target bound if there is nothing to draw with, so the caller can fall back to the blit
+    if (!mPostProcess.prepare(PostProcess::effectiveFeatures(features, inputs)))
+    {
+        return false;
+    }
 
-    const GLsizei w = std::max(1, mWindowWidth);
-    const GLsizei h = std::max(1, mWindowHeight);
-
-    const GLuint motionBlurTex = mMotionBlurTex->get();
-    const GLuint prevFrameTex = mPrevFrameTex->get();
-
-    // Blit default framebuffer into motion blur texture via FBO (no CPU stall)
-    FramebufferObject::unbind(GL_READ_FRAMEBUFFER);
-    mFBOManager->get(FBOs::ID::MOTION_BLUR).bind(GL_DRAW_FRAMEBUFFER);
-    glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, motionBlurTex, 0);
-    glBlitFramebuffer(0, 0, w, h, 0, 0, w, h, GL_COLOR_BUFFER_BIT, GL_NEAREST);
-
-    // Apply motion blur as fullscreen pass back to default framebuffer
-    FramebufferObject::unbind();
-    glDisable(GL_DEPTH_TEST);
-    glDepthMask(GL_FALSE);
-
-    mMotionBlurShader->bind();
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, motionBlurTex);
-    mMotionBlurShader->setUniform("uCurrentFrame", 0);
-    glActiveTexture(GL_TEXTURE1);
-    glBindTexture(GL_TEXTURE_2D, prevFrameTex);
-    mMotionBlurShader->setUniform("uPrevFrame", 1);
-    mMotionBlurShader->setUniform("uVelocity", playerVel);
-    mMotionBlurShader->setUniform("uBlurStrength", std::min(speed * 0.1f, 1.5f));
-
-    mVAOManager->get(VAOs::ID::FULLSCREEN_QUAD).bind();
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-
-    // Store result as previous frame via FBO blit
-    FramebufferObject::unbind(GL_READ_FRAMEBUFFER);
-    mFBOManager->get(FBOs::ID::MOTION_BLUR).bind(GL_DRAW_FRAMEBUFFER);
-    glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, prevFrameTex, 0);
-    glBlitFramebuffer(0, 0, w, h, 0, 0, w, h, GL_COLOR_BUFFER_BIT, GL_NEAREST);
-
-    FramebufferObject::unbind();
-    glEnable(GL_DEPTH_TEST);
-    glDepthMask(GL_TRUE);
-    glActiveTexture(GL_TEXTURE0);
+    mWorld.endSceneTarget(mWindowWidth, mWindowHeight);
+    return mPostProcess.apply(features, inputs, mVAOManager->get(VAOs::ID::FULLSCREEN_QUAD));
 }
 
 void GameState::renderPlayerTileGradientHighlight() const noexcept
@@ -536,7 +711,7 @@ void GameState::renderPlayerTileGradientHighlight() const noexcept
     const float mazeDepth = mWorld.getRasterMazeDepth();
     const float mazeOriginX = mazeCenter.x - 0.5f * mazeWidth;
     const float mazeOriginZ = mazeCenter.z - 0.5f * mazeDepth;
-    const glm::vec3 playerPos = mPlayer.getPosition();
+    const glm::vec3 playerPos = mPlayer.getRenderPosition();
 
     const int col = static_cast<int>(std::floor((playerPos.x - mazeOriginX) / kSimpleCellSize));
     const int row = static_cast<int>(std::floor((playerPos.z - mazeOriginZ) / kSimpleCellSize));
@@ -553,8 +728,8 @@ void GameState::renderPlayerTileGradientHighlight() const noexcept
 
     const float aspectRatio = static_cast<float>(std::max(1, mWindowWidth)) /
                               static_cast<float>(std::max(1, mWindowHeight));
-    const glm::mat4 view = mCamera.getLookAt();
-    const glm::mat4 proj = mCamera.getPerspective(aspectRatio);
+    const glm::mat4 view = mRenderCamera.getLookAt();
+    const glm::mat4 proj = mRenderCamera.getPerspective(aspectRatio);
     ImDrawList *drawList = ImGui::GetForegroundDrawList();
     if (!drawList)
     {
@@ -636,50 +811,20 @@ void GameState::applyRasterBirdsEyeCamera() noexcept
 
 void GameState::resolvePlayerWallCollisions(glm::vec3 &pos) const noexcept
 {
-    // Treat the player as a circle in the XZ plane and push it out of each wall AABB.
-    // wall AABB packed as glm::vec4(minX, minZ, maxX, maxZ).
-    constexpr float kPlayerRadius = 0.42f; // fits through a corridor (cellSize - wallThickness ≈ 2.2)
-    constexpr int kIterations = 6;         // multiple passes handle corner pile-ups
-
-    for (int iter = 0; iter < kIterations; ++iter)
-    {
-        for (const auto &wall : mWorld.getMazeWallAABBs())
-        {
-            const float closestX = glm::clamp(pos.x, wall.x, wall.z);
-            const float closestZ = glm::clamp(pos.z, wall.y, wall.w);
-            const float dx = pos.x - closestX;
-            const float dz = pos.z - closestZ;
-            const float distSq = dx * dx + dz * dz;
-
-            if (distSq >= kPlayerRadius * kPlayerRadius)
-                continue; // no overlap
+    resolveMazeWalls(mWorld, pos, mWallResolveScratch);
+}
 
-            if (distSq > 0.0f)
-            {
-                const float dist = std::sqrt(distSq);
-                const float push = kPlayerRadius - dist;
-                pos.x += (dx / dist) * push;
-                pos.z += (dz / dist) * push;
-            }
-            else
-            {
-                // Centre inside the AABB — push along the axis of least penetration
-                const float ox = std::min(pos.x - wall.x, wall.z - pos.x);
-                const float oz = std::min(pos.z - wall.y, wall.w - pos.z);
-                if (ox < oz)
-                    pos.x += (pos.x < (wall.x + wall.z) * 0.5f) ? -(ox + kPlayerRadius) : (ox + kPlayerRadius);
-                else
-                    pos.z += (pos.z < (wall.y + wall.w) * 0.5f) ? -(oz + kPlayerRadius) : (oz + kPlayerRadius);
-            }
-        }
-    }
+void GameState::resolveMazeWalls(const World &world, glm::vec3 &pos, WallBroadphase::ResolveScratch &scratch) noexcept
+{
+    // Treat the player as a circle in the XZ plane and push it out of each wall AABB.
+    world.getMazeWallBroadphase().resolveCircle(pos, kPlayerRadius, kWallResolveIterations, scratch);
 
     // Hard clamp to maze outer boundary as a safety net.
-    const float mazeW = mWorld.getRasterMazeWidth();
-    const float mazeD = mWorld.getRasterMazeDepth();
+    const float mazeW = world.getRasterMazeWidth();
+    const float mazeD = world.getRasterMazeDepth();
     if (mazeW > 0.0f && mazeD > 0.0f)
     {
-        const glm::vec3 mazeCenter = mWorld.getRasterMazeCenter();
+        const glm::vec3 mazeCenter = world.getRasterMazeCenter();
         const float limitW = mazeW * 0.5f - kPlayerRadius;
         const float limitD = mazeD * 0.5f - kPlayerRadius;
         pos.x = glm::clamp(pos.x, mazeCenter.x - limitW, mazeCenter.x + limitW);
@@ -687,19 +832,51 @@ void GameState::resolvePlayerWallCollisions(glm::vec3 &pos) const noexcept
     }
 }
 
+void GameState::movePlayerThroughMaze(const World &world, glm::vec3 &pos, const glm::vec2 &delta,
+                                      WallBroadphase::ResolveScratch &scratch) noexcept
+{
+    // After each substep the resolver sees the player approaching the wall face-on, not already past
+    // it, so it always pushes back correctly.
+    const float totalDist = glm::length(delta);
+    const int numSteps = std::max(1, static_cast<int>(std::ceil(totalDist / kMaxSubstepDist)));
+    const glm::vec2 step = delta / static_cast<float>(numSteps);
+    for (int i = 0; i < numSteps; ++i)
+    {
+        pos.x += step.x;
+        pos.z += step.y;
+        resolveMazeWalls(world, pos, scratch);
+    }
+}
+
+glm::vec3 GameState::getMazeSpawn() noexcept
+{
+    // The maze is centred at the origin; cell (0,0) corner is at (-halfW, 0, -halfD).
+    const float halfW = 0.5f * static_cast<float>(kSimpleMazeCols) * kSimpleCellSize;
+    const float halfD = 0.5f * static_cast<float>(kSimpleMazeRows) * kSimpleCellSize;
+    // True cell-centre of cell (0,0): half a cell-width in from each corner.
+    return glm::vec3(-halfW + kSimpleCellSize * 0.5f, 1.0f, -halfD + kSimpleCellSize * 0.5f);
+}
+
+void GameState::setMoveCapture(bool enabled) noexcept
+{
+    mMoveCapture = enabled;
+    mMoveIntent = glm::vec2(0.0f);
+}
+
+glm::vec2 GameState::takeMoveIntent() noexcept
+{
+    return std::exchange(mMoveIntent, glm::vec2(0.0f));
+}
+
 void GameState::cleanupResources() noexcept
 {
     // Scene rendering resources are now managed by World
 
-    // Motion blur textures are managed by TextureManager — no manual cleanup needed
-
     mDisplayTex = nullptr;
-    mNoiseTexture = nullptr;
 
     // Shaders are now managed by ShaderManager - don't delete them here
     mDisplayShader = nullptr;
-    mCompositeShader = nullptr;
-    mOITResolveShader = nullptr;
+    mPostProcess.destroy();
 
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "GameState: OpenGL resources cleaned up");
 }
@@ -718,6 +895,14 @@ void GameState::updateSounds() noexcept
 
 bool GameState::update(float dt, unsigned int subSteps) noexcept
 {
+    // A startup benchmark ends once the first game frame is out
+    if (StartupTimeline::isRunning() && StartupTimeline::reached(StartupTimeline::FIRST_GAME_FRAME))
+    {
+        StartupTimeline::finish();
+        requestStateClear();
+        return false;
+    }
+
     // If GameState is updating, it is currently active (PauseState would block update propagation).
     // Ensure local paused flag is cleared when returning from pause/menu flows.
     mGameIsPaused = false;
@@ -725,6 +910,10 @@ bool GameState::update(float dt, unsigned int subSteps) noexcept
     // Keep render targets synchronized with physical pixel size even if a resize
     // event was dropped or coalesced by the platform.
     handleWindowResize();
+    syncRenderOptions();
+
+    mPlayer.beginFixedStep();
+    mCamera.beginFixedStep();
 
     const glm::vec3 playerPosBeforeUpdate = mPlayer.getPosition();
 
@@ -733,32 +922,17 @@ bool GameState::update(float dt, unsigned int subSteps) noexcept
         mModelAnimTimeSeconds += dt;
     }
 
-    // Periodic music health check
-    static float musicCheckTimer = 0.0f;
-    musicCheckTimer += dt;
-
-    if (musicCheckTimer >= 5.0f) // Check every 5 seconds
+    const auto prevPickupCount = mWorld.getPickupSpheres().size();
+    // A rollback session steps the world itself, once per simulated frame
+    if (!mMoveCapture)
     {
-        musicCheckTimer = 0.0f;
-
-        if (mGameMusic)
-        {
-            if (!mGameMusic->isPlaying())
-            {
-                SDL_LogWarn(SDL_LOG_CATEGORY_AUDIO,
-                            "GameState: Music stopped unexpectedly! Attempting restart...");
-                mGameMusic->play();
-            }
-        }
+        mWorld.update(dt);
     }
 
-    const auto prevPickupCount = mWorld.getPickupSpheres().size();
-    mWorld.update(dt);
-
     // Pre-read relative mouse delta BEFORE handleRealtimeInput consumes the accumulator.
     // This lets handleBirdsEyeInput receive the actual mouse movement for this frame.
     float relMouseX = 0.0f, relMouseY = 0.0f;
-    SDL_GetRelativeMouseState(&relMouseX, &relMouseY);
+    InputRecorder::getRelativeMouseState(&relMouseX, &relMouseY);
 
     // Run Player logic for gravity / animation state / jump – but discard the
     // camera-relative XZ position change it produces (broken for straight-down camera).
@@ -772,21 +946,37 @@ bool GameState::update(float dt, unsigned int subSteps) noexcept
         mPlayer.setPosition(afterGravityPos);
     }
 
-    // Apply top-down XZ movement from keyboard, mouse, and touch.
-    handleBirdsEyeInput(dt, relMouseX, relMouseY);
-    // Joystick left-stick XZ movement.
-    updateJoystickInput(dt);
-
-    // Resolve against static maze wall geometry (circle vs AABB, multi-pass).
+    if (FlyThroughBenchmark::isRunning())
     {
-        glm::vec3 pos = mPlayer.getPosition();
-        resolvePlayerWallCollisions(pos);
-        mPlayer.setPosition(pos);
+        // The scripted path flies through walls, so there is nothing to resolve
+        if (!followFlyThrough(dt))
+        {
+            FlyThroughBenchmark::finish();
+            requestStateClear();
+            return false;
+        }
     }
+    else
+    {
+        // Apply top-down XZ movement from keyboard, mouse, and touch.
+        handleBirdsEyeInput(dt, relMouseX, relMouseY);
+        // Joystick left-stick XZ movement.
+        updateJoystickInput(dt);
 
-    // Sphere chunk streaming is for the path-tracer mode; skip it in the
-    // raster maze to avoid triggering background work items every frame.
-    // mWorld.update() still runs processCompletedChunks() internally.
+        // Resolve against static maze wall geometry (circle vs AABB, multi-pass).
+        if (!mMoveCapture)
+        {
+            glm::vec3 pos = mPlayer.getPosition();
+            resolvePlayerWallCollisions(pos);
+            mPlayer.setPosition(pos);
+        }
+    }
+
+    // Stream chunks around the player and ahead along its path; this only queues work when the
+    // player or the projected path crosses a chunk boundary, and the walls reach the GPU through
+    // World's chunk slot pool.
+    const glm::vec3 streamVelocity = dt > 0.0f ? (mPlayer.getPosition() - playerPosBeforeUpdate) / dt : glm::vec3(0.0f);
+    mWorld.updateSphereChunks(mPlayer.getPosition(), streamVelocity);
 
     // If new pickups appeared (new chunks loaded), mark GPU buffer dirty
     if (mWorld.getPickupSpheres().size() != prevPickupCount)
@@ -801,7 +991,8 @@ bool GameState::update(float dt, unsigned int subSteps) noexcept
     // Update player animation
     mPlayer.updateAnimation(dt);
 
-    // Collect nearby pickups for scoring
+    // Collect nearby pickups for scoring; a rollback session collects them inside its steps
+    if (!mMoveCapture)
     {
         int pointsGained = mWorld.collectNearbyPickups(mPlayer.getPosition(), 3.5f);
         if (pointsGained != 0)
@@ -844,10 +1035,12 @@ bool GameState::update(float dt, unsigned int subSteps) noexcept
         {
             const glm::vec2 lastXZ(mLastFxPlayerPosition.x, mLastFxPlayerPosition.z);
             mPlayerPlanarSpeedForFx = glm::distance(lastXZ, nowXZ) / dt;
+            mPlayerVelocityForFx = glm::vec3(nowXZ.x - lastXZ.x, 0.0f, nowXZ.y - lastXZ.y) / dt;
         }
         else
         {
             mPlayerPlanarSpeedForFx = glm::distance(beforeXZ, nowXZ) / dt;
+            mPlayerVelocityForFx = glm::vec3(nowXZ.x - beforeXZ.x, 0.0f, nowXZ.y - beforeXZ.y) / dt;
             mHasLastFxPosition = true;
         }
 
@@ -1076,7 +1269,7 @@ void GameState::handleBirdsEyeInput(float dt, float relMouseX, float relMouseY)
     // --- Keyboard (WASD + arrow keys) ---
     {
         int numKeys = 0;
-        const bool *keys = SDL_GetKeyboardState(&numKeys);
+        const bool *keys = InputRecorder::getKeyboardState(&numKeys);
         if (keys)
         {
             if (keys[SDL_SCANCODE_W] || keys[SDL_SCANCODE_UP])
@@ -1125,23 +1318,15 @@ void GameState::handleBirdsEyeInput(float dt, float relMouseX, float relMouseY)
         }
     }
 
-    // Advance in substeps no larger than kMaxSubstepDist (well under wall
-    // thickness = 0.20) so the player can never skip past a wall in one frame.
-    // After each substep the resolver sees the player approaching the wall
-    // face-on, not already past it, so it always pushes back correctly.
-    constexpr float kMaxSubstepDist = 0.07f;
-    const float totalDist = std::sqrt(delta.x * delta.x + delta.z * delta.z);
-    const int numSteps = std::max(1, static_cast<int>(std::ceil(totalDist / kMaxSubstepDist)));
-    const float sx = delta.x / static_cast<float>(numSteps);
-    const float sz = delta.z / static_cast<float>(numSteps);
-
-    glm::vec3 pos = mPlayer.getPosition();
-    for (int i = 0; i < numSteps; ++i)
+    if (mMoveCapture)
     {
-        pos.x += sx;
-        pos.z += sz;
-        resolvePlayerWallCollisions(pos);
+        mMoveIntent += glm::vec2(delta.x, delta.z);
+        return;
     }
+
+    // Advance in substeps no larger than kMaxSubstepDist so the player can never skip past a wall in one frame.
+    glm::vec3 pos = mPlayer.getPosition();
+    movePlayerThroughMaze(mWorld, pos, glm::vec2(delta.x, delta.z), mWallResolveScratch);
     mPlayer.setPosition(pos);
 
     // Update facing direction to match the movement direction (top-down view).
@@ -1150,17 +1335,52 @@ void GameState::handleBirdsEyeInput(float dt, float relMouseX, float relMouseY)
     mPlayer.setFacingDirection(facingDeg);
 }
 
+bool GameState::followFlyThrough(float dt) noexcept
+{
+    const glm::vec3 mazeCenter = mWorld.getRasterMazeCenter();
+    const glm::vec2 halfExtents(mWorld.getRasterMazeWidth() * 0.5f, mWorld.getRasterMazeDepth() * 0.5f);
+    const auto pose = FlyThroughBenchmark::advance(dt, halfExtents);
+    if (!pose)
+    {
+        return false;
+    }
+
+    glm::vec3 pos = mPlayer.getPosition();
+    pos.x = mazeCenter.x + pose->offset.x;
+    pos.z = mazeCenter.z + pose->offset.y;
+    mPlayer.setPosition(pos);
+    mPlayer.setFacingDirection(glm::degrees(std::atan2(pose->heading.x, -pose->heading.y)));
+
+    mRasterBirdsEyeDistance = glm::mix(mRasterBirdsEyeMinDistance, mRasterBirdsEyeMaxDistance, pose->zoom);
+
+    if (pose->wallBreaks > 0)
+    {
+        mWorld.breakChunkWalls(pos, pose->wallBreaks);
+    }
+
+    // Fixed scale per pass; the controller would otherwise chase the numbers being measured
+    mDynamicResolutionEnabled = false;
+    const auto [width, height] = computeRenderResolution(mWindowWidth, mWindowHeight, pose->renderScale);
+    if (width != mRenderWidth || height != mRenderHeight)
+    {
+        mWorld.ensureSceneTargets(width, height);
+        applyRenderScale(pose->renderScale);
+    }
+    return true;
+}
+
 void GameState::updateJoystickInput(float dt) noexcept
 {
-    if (!mJoystick || dt <= 0.0f || mPlayer.isFrozen())
+    // A replay carries the recorded stick even when no joystick is attached now
+    if ((!mJoystick && !InputRecorder::isReplaying()) || dt <= 0.0f || mPlayer.isFrozen())
     {
         return;
     }
 
     constexpr int kLeftStickXAxis = 0;
     constexpr int kLeftStickYAxis = 1;
-    const Sint16 axisXRaw = SDL_GetJoystickAxis(mJoystick, kLeftStickXAxis);
-    const Sint16 axisYRaw = SDL_GetJoystickAxis(mJoystick, kLeftStickYAxis);
+    const Sint16 axisXRaw = InputRecorder::getJoystickAxis(mJoystick, kLeftStickXAxis);
+    const Sint16 axisYRaw = InputRecorder::getJoystickAxis(mJoystick, kLeftStickYAxis);
     const float axisXNorm = std::clamp(static_cast<float>(axisXRaw) / 32767.0f, -1.0f, 1.0f);
     const float axisYNorm = std::clamp(static_cast<float>(axisYRaw) / 32767.0f, -1.0f, 1.0f);
 
@@ -1174,20 +1394,15 @@ void GameState::updateJoystickInput(float dt) noexcept
     const float normZ = (axisYNorm / magnitude) * std::clamp(scale, 0.0f, 1.0f) * mJoystickStrafeSpeed * dt;
 
     // Left-stick X → world +X (screen-right), left-stick Y → world +Z (screen-down).
-    // Substep to prevent tunneling through thin walls (same approach as mouse input).
-    constexpr float kMaxSubstepDist = 0.07f;
-    const float totalDist = std::sqrt(normX * normX + normZ * normZ);
-    const int numSteps = std::max(1, static_cast<int>(std::ceil(totalDist / kMaxSubstepDist)));
-    const float sx = normX / static_cast<float>(numSteps);
-    const float sz = normZ / static_cast<float>(numSteps);
-
-    glm::vec3 playerPos = mPlayer.getPosition();
-    for (int i = 0; i < numSteps; ++i)
+    if (mMoveCapture)
     {
-        playerPos.x += sx;
-        playerPos.z += sz;
-        resolvePlayerWallCollisions(playerPos);
+        mMoveIntent += glm::vec2(normX, normZ);
+        return;
     }
+
+    // Substep to prevent tunneling through thin walls (same approach as mouse input).
+    glm::vec3 playerPos = mPlayer.getPosition();
+    movePlayerThroughMaze(mWorld, playerPos, glm::vec2(normX, normZ), mWallResolveScratch);
     mPlayer.setPosition(playerPos);
 }
 
@@ -2,7 +2,9 @@
 #define GAME_STATE_HPP
 
 #include "Camera.hpp"
+#include "DynamicResolution.hpp"
 #include "GLTFModel.hpp"
+#include "PostProcess.hpp"
 #include "State.hpp"
 #include "World.hpp"
 
@@ -10,6 +12,7 @@
 #include <glm/glm.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <random>
 #include <string>
 #include <vector>
@@ -32,6 +35,10 @@ public:
     explicit GameState(StateStack &stack, Context context);
     ~GameState() override;
 
+    /// @brief Start the CPU-only part of construction (maze generation and vertex building) on workers
+    /// @details Called through StateStack::prewarmState while the menu is up
+    static void prewarm(Context context) noexcept;
+
     void draw() const noexcept override;
     bool update(float dt, unsigned int subSteps) noexcept override;
     bool handleEvent(const SDL_Event &event) noexcept override;
@@ -49,10 +56,30 @@ public:
     /// Get render scale relative to window size
     float getRenderScale() const noexcept;
 
+    /// @brief Hand the local player's movement to a rollback session instead of applying it
+    /// @details While on, update() sums the planar move the input asks for into takeMoveIntent() and
+    /// leaves the player's position, the world step and pickup collection to the session.
+    void setMoveCapture(bool enabled) noexcept;
+    /// Planar move asked for since the last call, before wall collisions
+    [[nodiscard]] glm::vec2 takeMoveIntent() noexcept;
+
+    /// Centre of the maze's first cell, where every player starts
+    [[nodiscard]] static glm::vec3 getMazeSpawn() noexcept;
+
+    /// Move a player through the maze walls in substeps short enough that no wall is skipped
+    static void movePlayerThroughMaze(const World &world, glm::vec3 &pos, const glm::vec2 &delta,
+                                      WallBroadphase::ResolveScratch &scratch) noexcept;
+
 private:
-    /// Recompute internal render resolution from current window size
+    /// Recompute internal render resolution bounds from current window size and options
     void updateRenderResolution() noexcept;
 
+    /// Pick up render quality / dynamic resolution changes made in the settings menu
+    void syncRenderOptions(bool force = false) noexcept;
+
+    /// Set the scene size from a scale of the window; the composite targets already fit the maximum
+    void applyRenderScale(float scale) const noexcept;
+
     /// Check and handle window resize events
     void handleWindowResize() noexcept;
 
@@ -68,11 +95,9 @@ private:
     /// Render scoring billboards (pickup values) using ImGui
     void renderScoreBillboards() const noexcept;
 
-    /// Apply motion blur effect using the compute pipeline
-    void renderMotionBlur() const noexcept;
-
-    /// Initialize motion blur compute resources
-    void initializeMotionBlur() noexcept;
+    /// @brief Run the merged post pass from the scene target into the window
+    /// @return false (scene target still bound) when no post variant is available
+    bool applyPostProcess() const noexcept;
 
     /// Check if camera moved and reset accumulation if needed
     bool checkCameraMovement() const noexcept;
@@ -97,11 +122,16 @@ private:
 
     /// Push the player out of any overlapping maze wall AABBs (circle vs AABB, XZ plane).
     void resolvePlayerWallCollisions(glm::vec3 &pos) const noexcept;
+    static void resolveMazeWalls(const World &world, glm::vec3 &pos, WallBroadphase::ResolveScratch &scratch) noexcept;
 
     /// Apply birds-eye top-down XZ movement from keyboard, mouse, and touch.
     /// relMouseX/Y must be pre-read from SDL_GetRelativeMouseState before calling handleRealtimeInput.
     void handleBirdsEyeInput(float dt, float relMouseX, float relMouseY) noexcept;
 
+    /// @brief Place the player, zoom and render scale from the fly-through benchmark path
+    /// @return false once the path is finished
+    bool followFlyThrough(float dt) noexcept;
+
     /// Trigger a short haptic rumble pulse (used for input testing).
     void triggerHapticTest(float strength, float seconds) noexcept;
 
@@ -113,21 +143,20 @@ private:
     SoundPlayer *mSoundPlayer{nullptr};
 
     Camera mCamera;
+    mutable Camera mRenderCamera; // mCamera blended by the interpolation alpha for this frame
 
     // Shader references from context (post-process / UI only)
     Shader *mDisplayShader{nullptr};
-    Shader *mCompositeShader{nullptr};
     Shader *mHighlightTileShader{nullptr};
-    Shader *mOITResolveShader{nullptr};
-    Shader *mMotionBlurShader{nullptr};
+
+    PostProcess mPostProcess;
 
     Texture *mDisplayTex{nullptr};
-    Texture *mNoiseTexture{nullptr};
     Texture *mTestAlbedoTexture{nullptr};
-    Texture *mMotionBlurTex{nullptr};
-    Texture *mPrevFrameTex{nullptr};
+    /// Keeps the lazily loaded test albedo resident while the game runs
+    TextureManager::Handle mTestAlbedoHandle;
 
-    // VAO/FBO managers needed for post-process (motion blur)
+    // VAO/FBO managers needed for post-process
     VAOManager *mVAOManager{nullptr};
     FBOManager *mFBOManager{nullptr};
 
@@ -145,18 +174,35 @@ private:
     bool mShadersInitialized{false};
     mutable int mWindowWidth{1280};
     mutable int mWindowHeight{720};
-    int mRenderWidth{1280};
-    int mRenderHeight{720};
+    mutable int mRenderWidth{1280};
+    mutable int mRenderHeight{720};
     int mPreviewRenderWidth{640};
     int mPreviewRenderHeight{360};
 
-    static constexpr std::size_t kTargetRenderPixels = 960ull * 540ull;
     static constexpr float kMinRenderScale = 0.60f;
+    static constexpr float kMaxRenderScale = 2.00f;
+    /// Share of the display refresh interval the scene passes may use on the GPU
+    static constexpr float kGpuFrameBudgetFraction = 0.80f;
+    /// Planar speed where motion blur starts, the shutter interval it smears over, and its cap in window UV
+    static constexpr float kMotionBlurMinSpeed = 2.0f;
+    static constexpr float kMotionBlurShutterSeconds = 1.0f / 30.0f;
+    static constexpr float kMotionBlurMaxUV = 0.04f;
+    static constexpr float kMotionBlurAnchorDistance = 6.0f;
+
+    mutable DynamicResolution mDynamicResolution;
+    bool mDynamicResolutionEnabled{false};
+    float mRenderQuality{1.0f};
+    float mReflectionScale{0.5f};
+    bool mReflectionHalfRate{true};
+    int mOITDownscale{2};
 
     mutable float mModelAnimTimeSeconds{0.0f};
     mutable bool mHasLastFxPosition{false};
     mutable glm::vec3 mLastFxPlayerPosition{0.0f};
     mutable float mPlayerPlanarSpeedForFx{0.0f};
+    mutable glm::vec3 mPlayerVelocityForFx{0.0f};
+    /// The scene target still holds the last post-processed frame, so a covered draw can reuse it
+    mutable bool mSceneSnapshotValid{false};
 
     SDL_Joystick *mJoystick{nullptr};
     bool mJoystickRumbleSupported{false};
@@ -175,8 +221,11 @@ private:
     float mRasterBirdsEyeMinDistance{4.0f};
     float mRasterBirdsEyeMaxDistance{20.0f};
 
-    // Motion blur resources
-    bool mMotionBlurInitialized{false};
+    // Wall collision scratch (reused every substep)
+    mutable WallBroadphase::ResolveScratch mWallResolveScratch;
+
+    bool mMoveCapture{false};
+    glm::vec2 mMoveIntent{0.0f};
 
     // Score display
     mutable std::vector<std::pair<glm::vec3, int>> mActiveScorePopups;   // position, value
@@ -0,0 +1,167 @@
+#include "HotReload.hpp"
+
+#include "AssetPack.hpp"
+#include "CPUProfiler.hpp"
+#include "ResourceManager.hpp"
+#include "Shader.hpp"
+#include "Texture.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <system_error>
+
+std::vector<HotReload::ShaderWatch> HotReload::sShaders;
+std::vector<HotReload::TextureWatch> HotReload::sTextures;
+float HotReload::sAccumulator = 0.0f;
+
+void HotReload::watchShader(Shaders::ID id, const Shader &shader)
+{
+    ShaderWatch watch{id, {}};
+    for (const auto &path : shader.getSourceFiles())
+    {
+        // Shared includes are read once per stage; one watch per file is enough
+        if (std::ranges::none_of(watch.files, [&path](const WatchedFile &file) { return file.path == path; }))
+        {
+            watch.files.push_back(stamp(path));
+        }
+    }
+
+    if (!watch.files.empty())
+    {
+        sShaders.push_back(std::move(watch));
+    }
+}
+
+void HotReload::watchTexture(Textures::ID id, std::string path)
+{
+    // The runtime samples the offline-compressed copy when there is one, so edits to the image would not show
+    std::error_code error;
+    if (std::filesystem::exists(Texture::compressedPathFor(path), error))
+    {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "HotReload: %s has a compressed copy, not watched", path.c_str());
+        return;
+    }
+
+    sTextures.push_back(TextureWatch{id, stamp(std::move(path))});
+}
+
+void HotReload::clear() noexcept
+{
+    sShaders.clear();
+    sTextures.clear();
+    sAccumulator = 0.0f;
+}
+
+std::size_t HotReload::poll(ShaderManager &shaders, TextureManager &textures, float dt) noexcept
+{
+    sAccumulator += dt;
+    if (sAccumulator < POLL_INTERVAL || AssetPack::isMounted())
+    {
+        return 0;
+    }
+    sAccumulator = 0.0f;
+
+    BW_PROFILE_ZONE("HotReload::poll");
+
+    std::size_t reloaded = 0;
+    for (auto &watch : sShaders)
+    {
+        // Every file is restamped, so several saved together cost one rebuild
+        bool changed = false;
+        for (auto &file : watch.files)
+        {
+            changed = hasChanged(file) || changed;
+        }
+        if (changed && reloadShader(shaders, watch))
+        {
+            ++reloaded;
+        }
+    }
+
+    for (auto &watch : sTextures)
+    {
+        if (hasChanged(watch.file) && reloadTexture(textures, watch))
+        {
+            ++reloaded;
+        }
+    }
+
+    return reloaded;
+}
+
+HotReload::WatchedFile HotReload::stamp(std::string path)
+{
+    std::error_code error;
+    const auto writeTime = std::filesystem::last_write_time(path, error);
+    return WatchedFile{std::move(path), error ? std::filesystem::file_time_type::min() : writeTime};
+}
+
+bool HotReload::hasChanged(WatchedFile &file) noexcept
+{
+    std::error_code error;
+    const auto writeTime = std::filesystem::last_write_time(file.path, error);
+
+    // A file mid-save can be briefly missing; it counts once it is back with a new time
+    if (error || writeTime == file.writeTime)
+    {
+        return false;
+    }
+    file.writeTime = writeTime;
+    return true;
+}
+
+bool HotReload::reloadShader(ShaderManager &shaders, ShaderWatch &watch) noexcept
+{
+    if (shaders.getLoadState(watch.id) != ShaderManager::LoadState::LOADED)
+    {
+        return false;
+    }
+
+    Shader &shader = shaders.get(watch.id);
+    if (!shader.reload())
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "HotReload: shader %s failed to rebuild, keeping the previous program",
+                     watch.files.front().path.c_str());
+        return false;
+    }
+
+    // An edit may have added or removed includes
+    for (const auto &path : shader.getSourceFiles())
+    {
+        if (std::ranges::none_of(watch.files, [&path](const WatchedFile &file) { return file.path == path; }))
+        {
+            watch.files.push_back(stamp(path));
+        }
+    }
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "HotReload: reloaded shader %s", watch.files.front().path.c_str());
+    return true;
+}
+
+bool HotReload::reloadTexture(TextureManager &textures, const TextureWatch &watch) noexcept
+{
+    if (textures.getLoadState(watch.id) != TextureManager::LoadState::LOADED)
+    {
+        return false;
+    }
+
+    Texture::DecodedImage image;
+    if (!Texture::decodeFile(watch.file.path, image))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "HotReload: failed to decode %s, keeping the previous texture",
+                     watch.file.path.c_str());
+        return false;
+    }
+
+    // Same GL name when the size is unchanged, so anything holding it keeps sampling the new pixels
+    Texture &texture = textures.get(watch.id);
+    if (!texture.updateFromMemory(image.pixels.get(), image.width, image.height))
+    {
+        return false;
+    }
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "HotReload: reloaded texture %s (%dx%d)", watch.file.path.c_str(),
+                image.width, image.height);
+    return true;
+}
@@ -0,0 +1,66 @@
+#ifndef HOT_RELOAD_HPP
+#define HOT_RELOAD_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "ResourceIdentifiers.hpp"
+
+class Shader;
+
+/// @brief Reloads shaders and textures whose files change on disk while the game runs
+/// @details Watches are keyed by resource id, not pointer, so a resource freed or replaced in its
+/// manager is simply skipped. poll() compares write times every POLL_INTERVAL and rebuilds only the
+/// resources that read a changed file: a shader through Shader::reload() (which keeps the old program
+/// when the edit does not compile), a texture in place through Texture::updateFromMemory(). Nothing
+/// is watched while an AssetPack is mounted, since the packed bytes cannot change.
+class HotReload
+{
+public:
+    /// Seconds between write-time scans
+    static constexpr float POLL_INTERVAL = 0.5f;
+
+    /// Watch every file the shader read, includes too; call after its stages are attached
+    static void watchShader(Shaders::ID id, const Shader &shader);
+    static void watchTexture(Textures::ID id, std::string path);
+    /// Forget every watch, before the managers are cleared
+    static void clear() noexcept;
+
+    /// @brief Reload what changed since the last scan; GL thread only
+    /// @return Number of resources reloaded
+    static std::size_t poll(ShaderManager &shaders, TextureManager &textures, float dt) noexcept;
+
+private:
+    struct WatchedFile
+    {
+        std::string path;
+        std::filesystem::file_time_type writeTime;
+    };
+
+    struct ShaderWatch
+    {
+        Shaders::ID id;
+        std::vector<WatchedFile> files;
+    };
+
+    struct TextureWatch
+    {
+        Textures::ID id;
+        WatchedFile file;
+    };
+
+    [[nodiscard]] static WatchedFile stamp(std::string path);
+    /// True once per change; updates the stored write time
+    [[nodiscard]] static bool hasChanged(WatchedFile &file) noexcept;
+
+    static bool reloadShader(ShaderManager &shaders, ShaderWatch &watch) noexcept;
+    static bool reloadTexture(TextureManager &textures, const TextureWatch &watch) noexcept;
+
+    static std::vector<ShaderWatch> sShaders;
+    static std::vector<TextureWatch> sTextures;
+    static float sAccumulator;
+};
+
+#endif // HOT_RELOAD_HPP
@@ -1,18 +1,76 @@
 #include "HttpClient.hpp"
 
-#include <regex>
-#include <sstream>
-#include <unordered_map>
+#include "JSONUtils.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
 
 #include <SFML/Network.hpp>
 
 namespace
 {
     constexpr unsigned short DefaultPort = 80;
+    constexpr std::size_t ReceiveChunkSize = 4096;
+    /// Keeps a misbehaving server from growing the response without bound
+    constexpr std::size_t MaxResponseSize = 1u << 20;
+
+    std::string toLower(std::string text)
+    {
+        std::transform(text.begin(), text.end(), text.begin(),
+                       [](unsigned char c)
+                       { return static_cast<char>(std::tolower(c)); });
+        return text;
+    }
+
+    /// Value of a header in a lowercased header block, or empty
+    std::string headerValue(const std::string &headers, const std::string &name)
+    {
+        const std::string key = "\r\n" + name + ":";
+        const auto start = headers.find(key);
+        if (start == std::string::npos)
+        {
+            return {};
+        }
+        const auto valueStart = headers.find_first_not_of(" \t", start + key.size());
+        const auto valueEnd = headers.find("\r\n", start + key.size());
+        if (valueStart == std::string::npos || valueStart >= valueEnd)
+        {
+            return {};
+        }
+        return headers.substr(valueStart, valueEnd - valueStart);
+    }
+}
+
+HttpClient::~HttpClient()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+        mDrainUntil = std::chrono::steady_clock::now() +
+                      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                          std::chrono::duration<float>(SHUTDOWN_DRAIN_SECONDS));
+    }
+    mWake.notify_all();
+    mWatchWake.notify_all();
+    // The I/O thread finishes its fire-and-forget posts first; only then is the held-open watch cut short
+    if (mIoThread.joinable())
+    {
+        mIoThread.join();
+    }
+    mAborting.store(true, std::memory_order_relaxed);
+    if (mWatchThread.joinable())
+    {
+        mWatchThread.join();
+    }
+    mConnection.disconnect();
+    mWatchConnection.disconnect();
 }
 
 void HttpClient::setServerURL(const std::string &url) noexcept
 {
+    // The I/O thread reads host and port when it takes a request
+    std::lock_guard<std::mutex> lock(mMutex);
     mServerURL = url;
     parseServerURL();
 }
@@ -24,101 +82,436 @@ std::string HttpClient::getServerURL() const noexcept
 
 void HttpClient::parseServerURL() noexcept
 {
-    using std::ostringstream;
-    using std::regex;
-    using std::smatch;
-    using std::stoi;
-    using std::string;
+    if (const auto endpoint = JSONUtils::parseServerUrl(mServerURL))
+    {
+        mHost.assign(endpoint->host);
+        mPort = endpoint->port;
+    }
+    else
+    {
+        mHost = mNetworkData.empty() ? "" : mNetworkData;
+        mPort = DefaultPort;
+    }
+
+    if (mHost == "localhost")
+    {
+        mHost = "127.0.0.1";
+    }
+}
+
+HttpClient::RequestId HttpClient::getAsync(const std::string &path)
+{
+    return enqueue(Request{0, false, path, {}, {}, {}, false});
+}
+
+HttpClient::RequestId HttpClient::postAsync(
+    const std::string &path,
+    const std::string &body,
+    const std::string &contentType)
+{
+    return enqueue(Request{0, true, path, body, contentType, {}, false});
+}
+
+HttpClient::RequestId HttpClient::postAndForget(
+    const std::string &path,
+    std::string body,
+    const std::string &contentType,
+    const std::string &contentEncoding)
+{
+    return enqueue(Request{0, true, path, std::move(body), contentType, contentEncoding, true});
+}
+
+HttpClient::RequestId HttpClient::watchAsync(const std::string &path)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mWatchPending)
+    {
+        return mWatch.id;
+    }
+
+    mWatch = Request{takeId(), false, path, {}, {}, {}, false};
+    mWatchPending = true;
+    if (!mWatchThread.joinable())
+    {
+        mWatchThread = std::thread(&HttpClient::watchLoop, this);
+    }
+    mWatchWake.notify_one();
+    return mWatch.id;
+}
+
+bool HttpClient::isPending(RequestId id) const noexcept
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mHasRunning && mRunning.id == id)
+    {
+        return true;
+    }
+    return std::any_of(mQueue.begin(), mQueue.end(), [id](const Request &queued)
+                       { return queued.id == id; });
+}
+
+void HttpClient::pollCompletions(std::vector<Completion> &out)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto &completion : mCompleted)
+    {
+        out.push_back(std::move(completion));
+    }
+    mCompleted.clear();
+}
+
+HttpClient::RequestId HttpClient::takeId() noexcept
+{
+    const RequestId id = mNextId++;
+    if (mNextId == 0)
+    {
+        mNextId = 1;
+    }
+    return id;
+}
+
+HttpClient::RequestId HttpClient::enqueue(Request request)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
 
-    // Parse URL to extract host and port
-    regex url_regex(R"(^https?://([^:/]+)(?::(\d+))?(?:/.*)?$)");
-    smatch matches;
+    if (mHasRunning && mRunning.sameAs(request))
+    {
+        return mRunning.id;
+    }
+    for (const auto &queued : mQueue)
+    {
+        if (queued.sameAs(request))
+        {
+            return queued.id;
+        }
+    }
+
+    request.id = takeId();
+    const RequestId id = request.id;
+    mQueue.push_back(std::move(request));
+
+    // Started on first use so a game that never goes online never spawns it
+    if (!mIoThread.joinable())
+    {
+        mIoThread = std::thread(&HttpClient::ioLoop, this);
+    }
+    mWake.notify_one();
+    return id;
+}
 
-    if (regex_match(mServerURL, matches, url_regex))
+void HttpClient::ioLoop()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true)
     {
-        mHost = matches[1].str();
-        if (mHost == "localhost")
+        mWake.wait(lock, [this]
+                   { return mStopping || !mQueue.empty(); });
+        float timeoutSeconds = RESPONSE_TIMEOUT_SECONDS;
+        if (mStopping)
+        {
+            // Nobody polls for a Completion any more, but fire-and-forget posts such as the last
+            // telemetry batch still go out until the drain deadline
+            std::erase_if(mQueue, [](const Request &request)
+                          { return !request.discardResult; });
+            const auto remaining =
+                std::chrono::duration<float>(mDrainUntil - std::chrono::steady_clock::now()).count();
+            if (mQueue.empty() || remaining <= 0.0f)
+            {
+                return;
+            }
+            timeoutSeconds = std::min(timeoutSeconds, remaining);
+        }
+
+        mRunning = std::move(mQueue.front());
+        mQueue.pop_front();
+        mHasRunning = true;
+        const std::string host = mHost;
+        const unsigned short port = mPort;
+        lock.unlock();
+
+        // Fire-and-forget posts neither wait out nor extend the backoff, which is for requests a caller waits on
+        const bool backsOff = !mRunning.discardResult;
+        Completion completion;
+        completion.id = mRunning.id;
+        int status = 0;
+        bool failed = false;
+        if (host.empty())
+        {
+            // No server configured: nothing to wait for
+        }
+        else if (backsOff && std::chrono::steady_clock::now() < mRetryAt)
         {
-            mHost = "127.0.0.1";
+            // Server was unreachable recently; fail without touching the network until the backoff ends
         }
-        if (matches.size() > 2 && matches[2].matched)
+        else if (execute(mConnection, mRunning, host, port, timeoutSeconds, status, completion.body))
         {
-            try
+            if (backsOff)
             {
-                mPort = static_cast<unsigned short>(stoi(matches[2].str()));
+                mBackoff = std::chrono::milliseconds{0};
             }
-            catch (const std::exception &e)
+            completion.ok = status >= 200 && status < 300;
+        }
+        else
+        {
+            failed = true;
+            if (backsOff)
             {
-                mPort = 80;
+                mBackoff = std::min(MAX_BACKOFF, std::max(MIN_BACKOFF, mBackoff * 2));
+                mRetryAt = std::chrono::steady_clock::now() + mBackoff;
             }
         }
+
+        lock.lock();
+        mHasRunning = false;
+        if (mStopping && (failed || host.empty()))
+        {
+            // A server that is down now is not tried again for each queued post while the game waits to exit
+            mQueue.clear();
+        }
+        if (!mRunning.discardResult)
+        {
+            mCompleted.push_back(std::move(completion));
+        }
     }
-    else
+}
+
+void HttpClient::watchLoop()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true)
     {
-        mHost = mNetworkData.empty() ? "" : mNetworkData;
-        if (mHost == "localhost")
+        mWatchWake.wait(lock, [this]
+                        { return mStopping || mWatchPending; });
+        if (mStopping)
+        {
+            return;
+        }
+
+        const Request request = mWatch;
+        const std::string host = mHost;
+        const unsigned short port = mPort;
+        lock.unlock();
+
+        // No backoff here: the caller falls back to polling on a failure and decides when to retry
+        Completion completion;
+        completion.id = request.id;
+        int status = 0;
+        if (!host.empty() &&
+            execute(mWatchConnection, request, host, port, LONG_POLL_TIMEOUT_SECONDS, status, completion.body))
         {
-            mHost = "127.0.0.1";
+            completion.ok = status >= 200 && status < 300;
         }
-        mPort = 80;
+
+        lock.lock();
+        mWatchPending = false;
+        mCompleted.push_back(std::move(completion));
     }
 }
 
-std::string HttpClient::get(const std::string &path)
+bool HttpClient::execute(Connection &connection, const Request &request, const std::string &host, unsigned short port,
+                         float timeoutSeconds, int &outStatus, std::string &outBody)
 {
-    try
+    if (connection.connected && (host != connection.host || port != connection.port))
     {
-        sf::Http http(mHost, mPort);
+        connection.disconnect();
+    }
 
-        sf::Http::Request request(path, sf::Http::Request::Method::Get);
-        request.setHttpVersion(1, 0);
-        request.setField("Connection", "close");
+    // A kept-alive connection may have been closed by the server while idle; that costs one retry
+    const bool reused = connection.connected;
+    if (exchange(connection, request, host, port, timeoutSeconds, outStatus, outBody))
+    {
+        return true;
+    }
+    connection.disconnect();
+    return reused && !mAborting.load(std::memory_order_relaxed) &&
+           exchange(connection, request, host, port, timeoutSeconds, outStatus, outBody);
+}
 
-        sf::Http::Response response = http.sendRequest(request, sf::seconds(0.5f));
-        const auto status = response.getStatus();
+bool HttpClient::exchange(Connection &connection, const Request &request, const std::string &host, unsigned short port,
+                          float timeoutSeconds, int &outStatus, std::string &outBody)
+{
+    outBody.clear();
 
-        if (status != sf::Http::Response::Status::Ok)
+    if (!connection.connected)
+    {
+        const auto address = sf::IpAddress::resolve(host);
+        if (!address)
+        {
+            return false;
+        }
+        connection.socket.setBlocking(true);
+        if (connection.socket.connect(*address, port, sf::seconds(CONNECT_TIMEOUT_SECONDS)) != sf::Socket::Status::Done)
         {
-            return response.getBody();
+            connection.socket.disconnect();
+            return false;
         }
+        connection.selector.clear();
+        connection.selector.add(connection.socket);
+        connection.connected = true;
+        connection.host = host;
+        connection.port = port;
+    }
 
-        return response.getBody();
+    std::string message;
+    message.reserve(160 + request.path.size() + request.body.size());
+    message += request.post ? "POST " : "GET ";
+    message += request.path;
+    message += " HTTP/1.1\r\nHost: ";
+    message += host;
+    if (port != DefaultPort)
+    {
+        message += ":" + std::to_string(port);
     }
-    catch (const std::exception &)
+    message += "\r\nConnection: keep-alive\r\nAccept: application/json\r\n";
+    if (request.post)
     {
-        return {};
+        message += "Content-Type: " + request.contentType + "\r\n";
+        if (!request.contentEncoding.empty())
+        {
+            message += "Content-Encoding: " + request.contentEncoding + "\r\n";
+        }
+        message += "Content-Length: " + std::to_string(request.body.size()) + "\r\n";
     }
-}
+    message += "\r\n";
+    message += request.body;
 
-std::string HttpClient::post(
-    const std::string &path,
-    const std::string &body,
-    const std::string &contentType)
-{
-    try
+    std::size_t sent = 0;
+    if (connection.socket.send(message.data(), message.size(), sent) != sf::Socket::Status::Done || sent != message.size())
+    {
+        return false;
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() +
+                          std::chrono::duration<float>(timeoutSeconds);
+    std::string response;
+    bool closed = false;
+    // Appends whatever arrives before the deadline; false on timeout, error or shutdown
+    const auto receiveMore = [&]() -> bool
+    {
+        if (closed || response.size() > MaxResponseSize)
+        {
+            return false;
+        }
+        // Waits in slices so a long-poll held by the server does not hold up the destructor
+        while (true)
+        {
+            const auto remaining = std::chrono::duration<float>(deadline - std::chrono::steady_clock::now()).count();
+            if (remaining <= 0.0f || mAborting.load(std::memory_order_relaxed))
+            {
+                return false;
+            }
+            if (connection.selector.wait(sf::seconds(std::min(remaining, RECEIVE_SLICE_SECONDS))))
+            {
+                break;
+            }
+        }
+        char chunk[ReceiveChunkSize];
+        std::size_t received = 0;
+        const auto status = connection.socket.receive(chunk, sizeof(chunk), received);
+        if (status == sf::Socket::Status::Disconnected)
+        {
+            closed = true;
+            return false;
+        }
+        if (status != sf::Socket::Status::Done && status != sf::Socket::Status::Partial)
+        {
+            return false;
+        }
+        response.append(chunk, received);
+        return true;
+    };
+
+    std::size_t headerEnd = std::string::npos;
+    while ((headerEnd = response.find("\r\n\r\n")) == std::string::npos)
+    {
+        if (!receiveMore())
+        {
+            return false;
+        }
+    }
+
+    // "HTTP/1.1 200 OK"
+    const auto statusStart = response.find(' ');
+    if (statusStart == std::string::npos || statusStart > headerEnd)
     {
-        sf::Http http(mHost, mPort);
+        return false;
+    }
+    outStatus = std::atoi(response.c_str() + statusStart + 1);
 
-        sf::Http::Request request(path, sf::Http::Request::Method::Post);
-        request.setHttpVersion(1, 0);
-        request.setField("Connection", "close");
-        request.setField("Content-Type", contentType);
-        request.setField("Content-Length", std::to_string(body.size()));
-        request.setBody(body);
+    const std::string headers = toLower(response.substr(0, headerEnd + 2));
+    const bool keepAlive = headerValue(headers, "connection") != "close" &&
+                           headers.compare(0, 8, "http/1.0") != 0;
+    std::size_t bodyStart = headerEnd + 4;
 
-        sf::Http::Response response = http.sendRequest(request, sf::seconds(0.5f));
-        const auto status = response.getStatus();
-        if (status != sf::Http::Response::Status::Ok &&
-            status != sf::Http::Response::Status::Created)
+    if (headerValue(headers, "transfer-encoding").find("chunked") != std::string::npos)
+    {
+        std::size_t cursor = bodyStart;
+        while (true)
+        {
+            std::size_t lineEnd = std::string::npos;
+            while ((lineEnd = response.find("\r\n", cursor)) == std::string::npos)
+            {
+                if (!receiveMore())
+                {
+                    return false;
+                }
+            }
+            const auto size = std::strtoul(response.c_str() + cursor, nullptr, 16);
+            const std::size_t dataStart = lineEnd + 2;
+            while (response.size() < dataStart + size + 2)
+            {
+                if (!receiveMore())
+                {
+                    return false;
+                }
+            }
+            if (size == 0)
+            {
+                break;
+            }
+            outBody.append(response, dataStart, size);
+            cursor = dataStart + size + 2;
+        }
+    }
+    else if (const std::string length = headerValue(headers, "content-length"); !length.empty())
+    {
+        const std::size_t bodySize = std::strtoul(length.c_str(), nullptr, 10);
+        while (response.size() < bodyStart + bodySize)
+        {
+            if (!receiveMore())
+            {
+                return false;
+            }
+        }
+        outBody.assign(response, bodyStart, bodySize);
+    }
+    else
+    {
+        // No framing: the body runs until the server closes
+        while (receiveMore())
+        {
+        }
+        if (!closed)
         {
-            return response.getBody();
+            return false;
         }
+        outBody.assign(response, bodyStart, std::string::npos);
+    }
 
-        return response.getBody();
+    if (!keepAlive || closed)
+    {
+        connection.disconnect();
     }
-    catch (const std::exception &)
+    return true;
+}
+
+void HttpClient::Connection::disconnect() noexcept
+{
+    if (connected)
     {
-        return {};
+        selector.clear();
+        socket.disconnect();
+        connected = false;
     }
 }
 
@@ -126,3 +519,13 @@ std::string_view HttpClient::getHostURL() const noexcept
 {
     return mHost.empty() ? std::string_view{} : std::string_view(mHost);
 }
+
+void HttpClient::setRelayAddress(const std::string &address) noexcept
+{
+    mRelayAddress = address;
+}
+
+std::string HttpClient::getRelayAddress() const noexcept
+{
+    return mRelayAddress;
+}
@@ -1,9 +1,26 @@
 #ifndef HTTP_CLIENT_HPP
 #define HTTP_CLIENT_HPP
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
+
+#include <SFML/Network.hpp>
 
 /// @brief HTTP client for communicating with Corners maze building server
+/// @details Requests are queued to one I/O thread that keeps an HTTP/1.1 connection to the server
+/// open between them. A request identical to one still queued or running shares its id instead of
+/// going out twice. While the server is unreachable the thread backs off exponentially and fails
+/// requests at once. Results come back through pollCompletions(), called from the game's update.
+///
+/// A long-poll from watchAsync() runs on a second thread and connection, so a request the server
+/// holds open never delays the others.
 class HttpClient
 {
 public:
@@ -14,35 +31,176 @@ public:
         // format: [Int32:packetType]
         LOBBY_STATUS,
         // format: [Int32:packetType] [Int32:playerCount] [Int32:minPlayers] [Int32:isReady]
-        LOBBY_READY
+        LOBBY_READY,
+        // format: [Int32:packetType] [Uint8:playerId] [String:name] [Uint16:listenPort]
+        PLAYER_HELLO,
+        // format: [Int32:packetType] [Uint8:count] count x ([Uint8:slot] [Uint16:sequence] [Uint16:senderMillis] [snapshot])
+        RELAY_SNAPSHOT,
+        // format: [Int32:packetType] [Uint8:count] count x ([Uint8:slot] [String:name]), the recipient left out
+        RELAY_ROSTER,
+        // format: [Int32:packetType] [Uint16:count] count x ([Uint32:size] [size bytes: one whole packet]); one per TCP flush
+        MESSAGE_BATCH,
+        // format: [Int32:packetType] [Uint32:senderMillis]; answered at once with PONG
+        PING,
+        // format: [Int32:packetType] [Uint32:senderMillis] echoed from the PING
+        PONG,
+        // format: [Int32:packetType] [Uint8:playerIndex] [Uint8:players] players x [Uint32:confirmedFrame]
+        // [Uint32:firstFrame] [Uint8:count] count x ([Int16:moveX] [Int16:moveZ]); players are indexed by
+        // name order, the same on every peer of a rollback match
+        ROLLBACK_INPUT
     };
 
+    using RequestId = std::uint32_t;
+
+    struct Completion
+    {
+        RequestId id{0};
+        /// Response body, also for an error status; empty when no response arrived
+        std::string body;
+        /// A 2xx response arrived
+        bool ok{false};
+    };
+
+    HttpClient() = default;
+    ~HttpClient();
+
+    HttpClient(const HttpClient &) = delete;
+    HttpClient &operator=(const HttpClient &) = delete;
+
     void setServerURL(const std::string &url) noexcept;
     [[nodiscard]] std::string getServerURL() const noexcept;
 
-    /// @brief Issue a GET request and return the response body (empty on failure)
+    /// @brief Queue a GET request
     /// @param path Absolute path on server (e.g. "/mazes/networks/data")
-    std::string get(const std::string &path);
+    /// @return Id its Completion will carry; an identical request in flight returns that one's id
+    RequestId getAsync(const std::string &path);
 
-    /// @brief Issue a POST request and return the response body (empty on failure)
+    /// @brief Queue a POST request
     /// @param path Absolute path on server (e.g. "/mazes/networks/data")
     /// @param body Request payload
     /// @param contentType MIME type for payload
-    std::string post(
+    RequestId postAsync(
         const std::string &path,
         const std::string &body,
         const std::string &contentType = "application/json");
 
+    /// @brief Queue a POST nobody waits on, such as a telemetry batch; no Completion is kept for it
+    /// @details Not held back by the backoff; the destructor still sends queued ones for up to SHUTDOWN_DRAIN_SECONDS
+    /// @param contentEncoding Sent as Content-Encoding when not empty, e.g. "deflate" for a zlib body
+    /// @return Id for isPending(); no Completion ever carries it
+    RequestId postAndForget(
+        const std::string &path,
+        std::string body,
+        const std::string &contentType,
+        const std::string &contentEncoding = {});
+
+    /// @brief Queue a long-poll GET, which the server may hold for up to LONG_POLL_TIMEOUT_SECONDS
+    /// @return Id its Completion will carry; while one is in flight that one's id is returned
+    RequestId watchAsync(const std::string &path);
+
+    /// @brief Move every finished request into out, without blocking
+    void pollCompletions(std::vector<Completion> &out);
+
+    /// @return True while the request is queued or running on the I/O thread; false once it got a response or failed
+    [[nodiscard]] bool isPending(RequestId id) const noexcept;
+
     std::string_view getHostURL() const noexcept;
 
+    /// @brief Relay server as "host:port"; empty keeps the full peer mesh
+    void setRelayAddress(const std::string &address) noexcept;
+    [[nodiscard]] std::string getRelayAddress() const noexcept;
+
+    /// Longest a watch waits for its answer; the server should reply with no change well before this
+    static constexpr float LONG_POLL_TIMEOUT_SECONDS = 35.0f;
+    /// Longest the destructor keeps sending queued fire-and-forget posts
+    static constexpr float SHUTDOWN_DRAIN_SECONDS = 2.0f;
+
 private:
+    static constexpr float CONNECT_TIMEOUT_SECONDS = 0.5f;
+    static constexpr float RESPONSE_TIMEOUT_SECONDS = 2.0f;
+    /// How often a waiting receive checks for shutdown
+    static constexpr float RECEIVE_SLICE_SECONDS = 0.25f;
+    static constexpr std::chrono::milliseconds MIN_BACKOFF{500};
+    static constexpr std::chrono::milliseconds MAX_BACKOFF{30000};
+
+    struct Request
+    {
+        RequestId id{0};
+        bool post{false};
+        std::string path;
+        std::string body;
+        std::string contentType;
+        std::string contentEncoding;
+        /// Drop the Completion instead of queueing it for pollCompletions()
+        bool discardResult{false};
+
+        [[nodiscard]] bool sameAs(const Request &other) const noexcept
+        {
+            return post == other.post && path == other.path && body == other.body && contentType == other.contentType &&
+                   contentEncoding == other.contentEncoding && discardResult == other.discardResult;
+        }
+    };
+
+    /// A kept-alive connection, owned by the thread that uses it
+    struct Connection
+    {
+        sf::TcpSocket socket;
+        sf::SocketSelector selector;
+        bool connected{false};
+        std::string host;
+        unsigned short port{0};
+
+        void disconnect() noexcept;
+    };
+
     /// @brief Parse server URL and extract host and port
     void parseServerURL() noexcept;
 
+    /// Next request id; the mutex must be held
+    RequestId takeId() noexcept;
+    RequestId enqueue(Request request);
+    void ioLoop();
+    void watchLoop();
+    /// @brief Run one request on a kept-alive connection, reconnecting once if the server dropped it
+    /// @return false when no response arrived; outStatus then is meaningless
+    bool execute(Connection &connection, const Request &request, const std::string &host, unsigned short port,
+                 float timeoutSeconds, int &outStatus, std::string &outBody);
+    bool exchange(Connection &connection, const Request &request, const std::string &host, unsigned short port,
+                  float timeoutSeconds, int &outStatus, std::string &outBody);
+
     std::string mNetworkData;
     std::string mServerURL;
     std::string mHost;
-    unsigned short mPort;
+    unsigned short mPort{80};
+    std::string mRelayAddress;
+
+    mutable std::mutex mMutex;
+    std::condition_variable mWake;
+    std::deque<Request> mQueue;
+    /// The request the I/O thread is running, for deduplication
+    Request mRunning;
+    bool mHasRunning{false};
+    std::vector<Completion> mCompleted;
+    RequestId mNextId{1};
+    bool mStopping{false};
+    /// When the I/O thread stops draining fire-and-forget posts after mStopping is set
+    std::chrono::steady_clock::time_point mDrainUntil{};
+    /// Set once the I/O thread has stopped; read without the lock so a held-open watch gives up
+    std::atomic<bool> mAborting{false};
+    std::thread mIoThread;
+
+    std::condition_variable mWatchWake;
+    Request mWatch;
+    bool mWatchPending{false};
+    std::thread mWatchThread;
+
+    // Owned by the I/O thread
+    Connection mConnection;
+    std::chrono::milliseconds mBackoff{0};
+    std::chrono::steady_clock::time_point mRetryAt{};
+
+    // Owned by the watch thread
+    Connection mWatchConnection;
 };
 
 #endif // HTTP_CLIENT_HPP
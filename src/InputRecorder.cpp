@@ -0,0 +1,494 @@
+#include "InputRecorder.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <type_traits>
+
+InputRecorder::Mode InputRecorder::sMode = InputRecorder::Mode::OFF;
+std::string InputRecorder::sPath;
+std::uint32_t InputRecorder::sMazeSeed = 0;
+bool InputRecorder::sSessionActive = false;
+bool InputRecorder::sSessionUsed = false;
+bool InputRecorder::sFinished = false;
+bool InputRecorder::sResult = false;
+std::uint32_t InputRecorder::sStepCount = 0;
+std::vector<std::uint8_t> InputRecorder::sStepData;
+std::size_t InputRecorder::sStepCursor = 0;
+std::uint32_t InputRecorder::sRecordedSteps = 0;
+std::vector<InputRecorder::RecordedEvent> InputRecorder::sEvents;
+std::size_t InputRecorder::sEventCursor = 0;
+std::array<bool, SDL_SCANCODE_COUNT> InputRecorder::sKeys{};
+std::vector<std::uint16_t> InputRecorder::sChangedKeys;
+SDL_MouseButtonFlags InputRecorder::sButtons = 0;
+float InputRecorder::sRelativeX = 0.0f;
+float InputRecorder::sRelativeY = 0.0f;
+std::array<Sint16, InputRecorder::RECORDED_AXES> InputRecorder::sAxes{};
+std::uint8_t InputRecorder::sStepFlags = 0;
+bool InputRecorder::sKeysRead = false;
+bool InputRecorder::sButtonsRead = false;
+bool InputRecorder::sRelativeRead = false;
+
+namespace
+{
+    constexpr std::uint32_t kMagic = 0x52495742u; // "BWIR"
+    /// Bump when the step encoding, the fixed step length or SDL_Event changes
+    constexpr std::uint32_t kVersion = 1;
+
+    // Step flags; a step without any is stored as the flags byte alone
+    constexpr std::uint8_t kKeysChanged = 1u << 0;
+    constexpr std::uint8_t kButtonsChanged = 1u << 1;
+    constexpr std::uint8_t kRelativeMotion = 1u << 2;
+    /// Shifted left by the axis index
+    constexpr std::uint8_t kAxisChanged = 1u << 3;
+
+    template <typename T>
+    void append(std::vector<std::uint8_t> &out, const T &value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto *bytes = reinterpret_cast<const std::uint8_t *>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    template <typename T>
+    bool consume(const std::vector<std::uint8_t> &in, std::size_t &cursor, T &value) noexcept
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (in.size() - cursor < sizeof(T))
+        {
+            return false;
+        }
+        std::memcpy(&value, in.data() + cursor, sizeof(T));
+        cursor += sizeof(T);
+        return true;
+    }
+}
+
+void InputRecorder::startRecording(std::string path)
+{
+    sMode = Mode::RECORD;
+    sPath = std::move(path);
+    sMazeSeed = std::random_device{}();
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "InputRecorder: recording to %s (maze seed %u)", sPath.c_str(), sMazeSeed);
+}
+
+bool InputRecorder::startReplay(std::string path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "InputRecorder: cannot read %s", path.c_str());
+        return false;
+    }
+    const std::vector<std::uint8_t> file{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+
+    std::size_t cursor = 0;
+    std::uint32_t magic = 0;
+    std::uint32_t version = 0;
+    std::uint32_t eventSize = 0;
+    std::uint32_t stepBytes = 0;
+    std::uint32_t eventCount = 0;
+    const bool headerRead = consume(file, cursor, magic) && consume(file, cursor, version) &&
+                            consume(file, cursor, eventSize) && consume(file, cursor, sMazeSeed) &&
+                            consume(file, cursor, sRecordedSteps) && consume(file, cursor, stepBytes) &&
+                            consume(file, cursor, eventCount);
+    if (!headerRead || magic != kMagic || version != kVersion || eventSize != sizeof(SDL_Event))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "InputRecorder: %s is not a recording of this build", path.c_str());
+        return false;
+    }
+    if (file.size() - cursor < stepBytes)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "InputRecorder: %s is truncated", path.c_str());
+        return false;
+    }
+    sStepData.assign(file.begin() + static_cast<std::ptrdiff_t>(cursor),
+                     file.begin() + static_cast<std::ptrdiff_t>(cursor + stepBytes));
+    cursor += stepBytes;
+
+    sEvents.clear();
+    sEvents.reserve(eventCount);
+    for (std::uint32_t i = 0; i < eventCount; ++i)
+    {
+        RecordedEvent recorded{};
+        if (!consume(file, cursor, recorded.step) || !consume(file, cursor, recorded.event))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "InputRecorder: %s is truncated", path.c_str());
+            return false;
+        }
+        sEvents.push_back(recorded);
+    }
+
+    sMode = Mode::REPLAY;
+    sPath = std::move(path);
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "InputRecorder: replaying %s, %u steps and %zu events (maze seed %u)",
+                sPath.c_str(), sRecordedSteps, sEvents.size(), sMazeSeed);
+    return true;
+}
+
+std::optional<std::uint32_t> InputRecorder::getMazeSeed() noexcept
+{
+    if (sMode == Mode::OFF)
+    {
+        return std::nullopt;
+    }
+    return sMazeSeed;
+}
+
+void InputRecorder::beginSession() noexcept
+{
+    if (sMode == Mode::OFF || sSessionUsed)
+    {
+        return;
+    }
+    sSessionUsed = true;
+    sSessionActive = true;
+    sStepCount = 0;
+    sStepCursor = 0;
+    sEventCursor = 0;
+    sKeys.fill(false);
+    sButtons = 0;
+    sAxes.fill(0);
+    if (sMode == Mode::RECORD)
+    {
+        sStepData.clear();
+        sEvents.clear();
+    }
+}
+
+bool InputRecorder::beginStep() noexcept
+{
+    if (!sSessionActive)
+    {
+        return true;
+    }
+
+    if (sMode == Mode::RECORD && sStepCount > 0)
+    {
+        flushStep();
+    }
+
+    sStepFlags = 0;
+    sChangedKeys.clear();
+    sRelativeX = 0.0f;
+    sRelativeY = 0.0f;
+    sKeysRead = false;
+    sButtonsRead = false;
+    sRelativeRead = false;
+
+    if (sMode == Mode::REPLAY && !loadStep())
+    {
+        finish();
+        return false;
+    }
+
+    ++sStepCount;
+    return true;
+}
+
+void InputRecorder::recordEvent(const SDL_Event &event) noexcept
+{
+    if (sMode != Mode::RECORD || !sSessionActive || sStepCount == 0 || !isReplayedType(event))
+    {
+        return;
+    }
+    sEvents.push_back({sStepCount - 1, event});
+}
+
+bool InputRecorder::nextReplayEvent(SDL_Event &event) noexcept
+{
+    if (sMode != Mode::REPLAY || !sSessionActive || sStepCount == 0)
+    {
+        return false;
+    }
+    const std::uint32_t step = sStepCount - 1;
+    while (sEventCursor < sEvents.size() && sEvents[sEventCursor].step < step)
+    {
+        ++sEventCursor;
+    }
+    if (sEventCursor == sEvents.size() || sEvents[sEventCursor].step != step)
+    {
+        return false;
+    }
+    event = sEvents[sEventCursor++].event;
+    return true;
+}
+
+bool InputRecorder::isReplayedType(const SDL_Event &event) noexcept
+{
+    switch (event.type)
+    {
+    case SDL_EVENT_KEY_DOWN:
+    case SDL_EVENT_KEY_UP:
+    case SDL_EVENT_MOUSE_BUTTON_DOWN:
+    case SDL_EVENT_MOUSE_BUTTON_UP:
+    case SDL_EVENT_MOUSE_WHEEL:
+    case SDL_EVENT_FINGER_DOWN:
+    case SDL_EVENT_FINGER_MOTION:
+    case SDL_EVENT_FINGER_UP:
+    case SDL_EVENT_JOYSTICK_BUTTON_DOWN:
+    case SDL_EVENT_JOYSTICK_BUTTON_UP:
+    case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+    case SDL_EVENT_GAMEPAD_BUTTON_UP:
+        return true;
+    default:
+        return false;
+    }
+}
+
+const bool *InputRecorder::getKeyboardState(int *numKeys) noexcept
+{
+    if (!sSessionActive)
+    {
+        return SDL_GetKeyboardState(numKeys);
+    }
+
+    if (sMode == Mode::RECORD && !sKeysRead)
+    {
+        int liveCount = 0;
+        const bool *live = SDL_GetKeyboardState(&liveCount);
+        const int count = live ? std::min(liveCount, static_cast<int>(SDL_SCANCODE_COUNT)) : 0;
+        for (int code = 0; code < count; ++code)
+        {
+            if (live[code] != sKeys[static_cast<std::size_t>(code)])
+            {
+                sKeys[static_cast<std::size_t>(code)] = live[code];
+                sChangedKeys.push_back(static_cast<std::uint16_t>(code));
+            }
+        }
+        if (!sChangedKeys.empty())
+        {
+            sStepFlags |= kKeysChanged;
+        }
+    }
+    sKeysRead = true;
+
+    if (numKeys)
+    {
+        *numKeys = static_cast<int>(SDL_SCANCODE_COUNT);
+    }
+    return sKeys.data();
+}
+
+SDL_MouseButtonFlags InputRecorder::getMouseButtons() noexcept
+{
+    if (!sSessionActive)
+    {
+        return SDL_GetMouseState(nullptr, nullptr);
+    }
+
+    if (sMode == Mode::RECORD && !sButtonsRead)
+    {
+        const SDL_MouseButtonFlags live = SDL_GetMouseState(nullptr, nullptr);
+        if (live != sButtons)
+        {
+            sButtons = live;
+            sStepFlags |= kButtonsChanged;
+        }
+    }
+    sButtonsRead = true;
+    return sButtons;
+}
+
+void InputRecorder::getRelativeMouseState(float *x, float *y) noexcept
+{
+    if (!sSessionActive)
+    {
+        SDL_GetRelativeMouseState(x, y);
+        return;
+    }
+
+    float motionX = 0.0f;
+    float motionY = 0.0f;
+    if (!sRelativeRead)
+    {
+        if (sMode == Mode::RECORD)
+        {
+            SDL_GetRelativeMouseState(&sRelativeX, &sRelativeY);
+            if (sRelativeX != 0.0f || sRelativeY != 0.0f)
+            {
+                sStepFlags |= kRelativeMotion;
+            }
+        }
+        motionX = sRelativeX;
+        motionY = sRelativeY;
+        sRelativeRead = true;
+    }
+
+    if (x)
+    {
+        *x = motionX;
+    }
+    if (y)
+    {
+        *y = motionY;
+    }
+}
+
+Sint16 InputRecorder::getJoystickAxis(SDL_Joystick *joystick, int axis) noexcept
+{
+    if (!sSessionActive || axis < 0 || static_cast<std::size_t>(axis) >= RECORDED_AXES)
+    {
+        return joystick ? SDL_GetJoystickAxis(joystick, axis) : Sint16{0};
+    }
+
+    auto &value = sAxes[static_cast<std::size_t>(axis)];
+    if (sMode == Mode::RECORD)
+    {
+        const Sint16 live = joystick ? SDL_GetJoystickAxis(joystick, axis) : Sint16{0};
+        if (live != value)
+        {
+            value = live;
+            sStepFlags |= static_cast<std::uint8_t>(kAxisChanged << axis);
+        }
+    }
+    return value;
+}
+
+void InputRecorder::flushStep()
+{
+    sStepData.push_back(sStepFlags);
+    if (sStepFlags & kKeysChanged)
+    {
+        append(sStepData, static_cast<std::uint16_t>(sChangedKeys.size()));
+        for (const std::uint16_t code : sChangedKeys)
+        {
+            append(sStepData, code);
+        }
+    }
+    if (sStepFlags & kButtonsChanged)
+    {
+        append(sStepData, static_cast<std::uint32_t>(sButtons));
+    }
+    if (sStepFlags & kRelativeMotion)
+    {
+        append(sStepData, sRelativeX);
+        append(sStepData, sRelativeY);
+    }
+    for (std::size_t axis = 0; axis < RECORDED_AXES; ++axis)
+    {
+        if (sStepFlags & (kAxisChanged << axis))
+        {
+            append(sStepData, sAxes[axis]);
+        }
+    }
+}
+
+bool InputRecorder::loadStep() noexcept
+{
+    if (sStepCount >= sRecordedSteps)
+    {
+        return false;
+    }
+
+    std::uint8_t flags = 0;
+    if (!consume(sStepData, sStepCursor, flags))
+    {
+        return false;
+    }
+    if (flags & kKeysChanged)
+    {
+        std::uint16_t count = 0;
+        if (!consume(sStepData, sStepCursor, count))
+        {
+            return false;
+        }
+        for (std::uint16_t i = 0; i < count; ++i)
+        {
+            std::uint16_t code = 0;
+            if (!consume(sStepData, sStepCursor, code) || code >= SDL_SCANCODE_COUNT)
+            {
+                return false;
+            }
+            sKeys[code] = !sKeys[code];
+        }
+    }
+    if (flags & kButtonsChanged)
+    {
+        std::uint32_t buttons = 0;
+        if (!consume(sStepData, sStepCursor, buttons))
+        {
+            return false;
+        }
+        sButtons = static_cast<SDL_MouseButtonFlags>(buttons);
+    }
+    if ((flags & kRelativeMotion) &&
+        (!consume(sStepData, sStepCursor, sRelativeX) || !consume(sStepData, sStepCursor, sRelativeY)))
+    {
+        return false;
+    }
+    for (std::size_t axis = 0; axis < RECORDED_AXES; ++axis)
+    {
+        if ((flags & (kAxisChanged << axis)) && !consume(sStepData, sStepCursor, sAxes[axis]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool InputRecorder::write() noexcept
+{
+    std::vector<std::uint8_t> file;
+    file.reserve(32 + sStepData.size() + sEvents.size() * sizeof(RecordedEvent));
+    append(file, kMagic);
+    append(file, kVersion);
+    append(file, static_cast<std::uint32_t>(sizeof(SDL_Event)));
+    append(file, sMazeSeed);
+    append(file, sStepCount);
+    append(file, static_cast<std::uint32_t>(sStepData.size()));
+    append(file, static_cast<std::uint32_t>(sEvents.size()));
+    file.insert(file.end(), sStepData.begin(), sStepData.end());
+    for (const RecordedEvent &recorded : sEvents)
+    {
+        append(file, recorded.step);
+        append(file, recorded.event);
+    }
+
+    std::ofstream out(sPath, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "InputRecorder: cannot write %s", sPath.c_str());
+        return false;
+    }
+    out.write(reinterpret_cast<const char *>(file.data()), static_cast<std::streamsize>(file.size()));
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "InputRecorder: wrote %u steps and %zu events (%zu bytes) to %s",
+                sStepCount, sEvents.size(), file.size(), sPath.c_str());
+    return static_cast<bool>(out);
+}
+
+bool InputRecorder::finish() noexcept
+{
+    if (sFinished || sMode == Mode::OFF)
+    {
+        return sResult;
+    }
+    sFinished = true;
+
+    if (sMode == Mode::RECORD)
+    {
+        if (sStepCount > 0)
+        {
+            flushStep();
+        }
+        sResult = sSessionUsed && write();
+        if (!sSessionUsed)
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "InputRecorder: no game was started, nothing recorded");
+        }
+    }
+    else
+    {
+        sResult = sSessionUsed && sStepCount >= sRecordedSteps;
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "InputRecorder: replayed %u of %u steps", sStepCount, sRecordedSteps);
+    }
+
+    sMode = Mode::OFF;
+    sSessionActive = false;
+    return sResult;
+}
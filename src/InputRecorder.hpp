@@ -0,0 +1,121 @@
+#ifndef INPUT_RECORDER_HPP
+#define INPUT_RECORDER_HPP
+
+#include <SDL3/SDL.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// @brief Records the input of one game session and plays it back, so a slow stretch can be reproduced
+/// @details Started by `breakingwalls <config.json> --record-input[=file]` or `--replay-input[=file]`.
+/// A session starts when the first GameState is constructed and is cut into fixed steps, one per
+/// processInput() call of the main loop. Each step stores what gameplay polled (keyboard, mouse buttons,
+/// relative mouse motion, joystick axes), delta-encoded against the step before, plus the discrete input
+/// events dispatched during it. Polled state is captured the first time it is read in a step, so every
+/// reader sees the same values when live and when replayed.
+///
+/// A recording also fixes the raster maze seed. While replaying, splash and menu advance on their own,
+/// live input events are dropped and the game quits after the last recorded step.
+class InputRecorder
+{
+public:
+    static constexpr std::string_view RECORD_FLAG = "--record-input";
+    static constexpr std::string_view REPLAY_FLAG = "--replay-input";
+    static constexpr std::string_view DEFAULT_FILE = "input_recording.bwir";
+
+    /// @brief Arm recording; the file is written when the session ends
+    static void startRecording(std::string path);
+    /// @brief Load a recording to play back
+    /// @return false if the file is missing or was written by an incompatible build
+    [[nodiscard]] static bool startReplay(std::string path);
+
+    [[nodiscard]] static bool isRecording() noexcept { return sMode == Mode::RECORD; }
+    [[nodiscard]] static bool isReplaying() noexcept { return sMode == Mode::REPLAY; }
+
+    /// Seed of the recorded maze while recording or replaying, otherwise nullopt (a random maze)
+    [[nodiscard]] static std::optional<std::uint32_t> getMazeSeed() noexcept;
+
+    /// Call when a gameplay session starts; only the first session is recorded
+    static void beginSession() noexcept;
+
+    /// @brief Start the next fixed step; call at the top of processInput()
+    /// @return false once a replay has run out of steps
+    [[nodiscard]] static bool beginStep() noexcept;
+
+    /// @brief Add a polled event to the current step; ignored unless recording
+    static void recordEvent(const SDL_Event &event) noexcept;
+    /// @brief Next recorded event of the current step while replaying
+    /// @return false when the step has no more events
+    [[nodiscard]] static bool nextReplayEvent(SDL_Event &event) noexcept;
+    /// Input that is recorded and replayed; quit and window events always come from the live queue
+    [[nodiscard]] static bool isReplayedType(const SDL_Event &event) noexcept;
+
+    /// Stand-ins for the SDL polling calls; they fall through to SDL outside a session
+    [[nodiscard]] static const bool *getKeyboardState(int *numKeys) noexcept;
+    [[nodiscard]] static SDL_MouseButtonFlags getMouseButtons() noexcept;
+    /// Motion since the last step, returned once; later reads in the same step return zero
+    static void getRelativeMouseState(float *x, float *y) noexcept;
+    [[nodiscard]] static Sint16 getJoystickAxis(SDL_Joystick *joystick, int axis) noexcept;
+
+    /// @brief Write the recording or stop the replay; later calls return the first result
+    /// @return true if the recording was written or the replay reached its last step
+    static bool finish() noexcept;
+
+private:
+    enum class Mode : std::uint8_t
+    {
+        OFF,
+        RECORD,
+        REPLAY
+    };
+
+    /// Axes past this many are read live
+    static constexpr std::size_t RECORDED_AXES = 4;
+
+    struct RecordedEvent
+    {
+        std::uint32_t step;
+        SDL_Event event;
+    };
+
+    /// Encode the captures of the step that just ended
+    static void flushStep();
+    /// Apply the changes stored for the next step; false at the end of the data
+    [[nodiscard]] static bool loadStep() noexcept;
+    [[nodiscard]] static bool write() noexcept;
+
+    static Mode sMode;
+    static std::string sPath;
+    static std::uint32_t sMazeSeed;
+    static bool sSessionActive;
+    static bool sSessionUsed;
+    static bool sFinished;
+    static bool sResult;
+
+    /// Steps begun in this session; the current step is sStepCount - 1
+    static std::uint32_t sStepCount;
+    static std::vector<std::uint8_t> sStepData;
+    static std::size_t sStepCursor;
+    static std::uint32_t sRecordedSteps;
+    static std::vector<RecordedEvent> sEvents;
+    static std::size_t sEventCursor;
+
+    // State as of the current step, and what was read during it
+    static std::array<bool, SDL_SCANCODE_COUNT> sKeys;
+    static std::vector<std::uint16_t> sChangedKeys;
+    static SDL_MouseButtonFlags sButtons;
+    static float sRelativeX;
+    static float sRelativeY;
+    static std::array<Sint16, RECORDED_AXES> sAxes;
+    static std::uint8_t sStepFlags;
+    static bool sKeysRead;
+    static bool sButtonsRead;
+    static bool sRelativeRead;
+};
+
+#endif // INPUT_RECORDER_HPP
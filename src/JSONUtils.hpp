@@ -3,8 +3,12 @@
 
 #include <algorithm>
 #include <cctype>
+#include <charconv>
+#include <cstdint>
 #include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 #include <SDL3/SDL.h>
@@ -18,9 +22,166 @@
 /// @file JsonUtils.hpp
 /// @brief Utility functions for JSON handling
 
+/// @brief Non-allocating JSON tokenizer over a string_view
+/// @details Tokens are views into the input, which must outlive them. String tokens are the raw text
+/// between the quotes, escapes left in place. Values are not validated beyond what the reader needs.
+class JsonTokenizer
+{
+public:
+    enum class Token : std::uint8_t
+    {
+        OBJECT_BEGIN,
+        OBJECT_END,
+        ARRAY_BEGIN,
+        ARRAY_END,
+        COLON,
+        COMMA,
+        STRING,
+        NUMBER,
+        /// true, false or null
+        LITERAL,
+        END,
+        INVALID
+    };
+
+    explicit JsonTokenizer(std::string_view json) noexcept : mJson{json} {}
+
+    Token next() noexcept
+    {
+        while (mPos < mJson.size() && std::isspace(static_cast<unsigned char>(mJson[mPos])))
+        {
+            ++mPos;
+        }
+        if (mPos >= mJson.size())
+        {
+            mText = {};
+            return Token::END;
+        }
+
+        const std::size_t start = mPos;
+        switch (mJson[mPos])
+        {
+        case '{':
+            return punctuation(Token::OBJECT_BEGIN);
+        case '}':
+            return punctuation(Token::OBJECT_END);
+        case '[':
+            return punctuation(Token::ARRAY_BEGIN);
+        case ']':
+            return punctuation(Token::ARRAY_END);
+        case ':':
+            return punctuation(Token::COLON);
+        case ',':
+            return punctuation(Token::COMMA);
+        case '"':
+            for (++mPos; mPos < mJson.size() && mJson[mPos] != '"'; ++mPos)
+            {
+                if (mJson[mPos] == '\\')
+                {
+                    ++mPos;
+                }
+            }
+            if (mPos >= mJson.size())
+            {
+                mText = {};
+                return Token::INVALID;
+            }
+            mText = mJson.substr(start + 1, mPos - start - 1);
+            ++mPos;
+            return Token::STRING;
+        default:
+            while (mPos < mJson.size() && !isDelimiter(mJson[mPos]))
+            {
+                ++mPos;
+            }
+            mText = mJson.substr(start, mPos - start);
+            return (mText.front() == '-' || std::isdigit(static_cast<unsigned char>(mText.front())))
+                       ? Token::NUMBER
+                       : Token::LITERAL;
+        }
+    }
+
+    /// Text of the last token
+    [[nodiscard]] std::string_view text() const noexcept { return mText; }
+
+    /// @brief Skip the rest of a value whose first token was just read
+    /// @return false when the value is malformed or cut off
+    bool skipValue(Token first) noexcept
+    {
+        if (first != Token::OBJECT_BEGIN && first != Token::ARRAY_BEGIN)
+        {
+            return first == Token::STRING || first == Token::NUMBER || first == Token::LITERAL;
+        }
+
+        std::size_t depth = 1;
+        while (depth > 0)
+        {
+            switch (next())
+            {
+            case Token::OBJECT_BEGIN:
+            case Token::ARRAY_BEGIN:
+                ++depth;
+                break;
+            case Token::OBJECT_END:
+            case Token::ARRAY_END:
+                --depth;
+                break;
+            case Token::END:
+            case Token::INVALID:
+                return false;
+            default:
+                break;
+            }
+        }
+        return true;
+    }
+
+private:
+    Token punctuation(Token token) noexcept
+    {
+        mText = mJson.substr(mPos, 1);
+        ++mPos;
+        return token;
+    }
+
+    static bool isDelimiter(char c) noexcept
+    {
+        return c == ',' || c == ':' || c == '}' || c == ']' || c == '{' || c == '[' || c == '"' ||
+               std::isspace(static_cast<unsigned char>(c));
+    }
+
+    std::string_view mJson;
+    std::size_t mPos{0};
+    std::string_view mText;
+};
+
 class JSONUtils
 {
 public:
+    /// One discovery entry, viewing into the response it was parsed from
+    struct PeerRecord
+    {
+        std::string_view name;
+        std::string_view ip;
+        std::uint16_t port{0};
+    };
+
+    /// Maze fields of a level config object; absent ones stay empty
+    struct MazeConfigFields
+    {
+        std::optional<int> rows;
+        std::optional<int> columns;
+        std::optional<int> seed;
+        std::optional<std::string_view> algo;
+    };
+
+    /// Host and port of an "http(s)://host[:port][/path]" URL, viewing into it
+    struct ServerEndpoint
+    {
+        std::string_view host;
+        std::uint16_t port{80};
+    };
+
     [[nodiscard]] std::string getValue(const std::string &key, const std::unordered_map<std::string, std::string> &resourceMap) const
     {
         auto it = resourceMap.find(key);
@@ -34,12 +195,13 @@ public:
     // Extract the actual filename from JSON string format (remove quotes and array brackets)
     [[nodiscard]] static std::string extractJsonValue(const std::string &jsonStr)
     {
-        if (jsonStr.empty())
-        {
-            return "";
-        }
+        return std::string(extractJsonView(jsonStr));
+    }
 
-        std::string result = jsonStr;
+    /// @brief extractJsonValue without the copy: a view into jsonStr
+    [[nodiscard]] static std::string_view extractJsonView(std::string_view jsonStr) noexcept
+    {
+        std::string_view result = jsonStr;
 
         // Remove array brackets if present
         if (result.length() >= 2 && result.front() == '[' && result.back() == ']')
@@ -55,7 +217,7 @@ public:
 
         // If it's still an array, just take the first element
         size_t commaPos = result.find(',');
-        if (commaPos != std::string::npos)
+        if (commaPos != std::string_view::npos)
         {
             result = result.substr(0, commaPos);
             // Remove quotes from the first element
@@ -68,6 +230,147 @@ public:
         return result;
     }
 
+    /// @brief Call onPeer with every object carrying "player_name", "ip" and a numeric "port"
+    /// @details Objects may sit at any depth, so a bare array and an array wrapped in an object both work.
+    /// Nothing is allocated; the records view into json.
+    /// @return Number of records passed to onPeer; parsing stops at the first malformed token
+    template <typename OnPeer>
+    static std::size_t parsePeerRecords(std::string_view json, OnPeer &&onPeer) noexcept
+    {
+        JsonTokenizer tokens{json};
+        std::size_t count = 0;
+        walkPeerRecords(tokens, tokens.next(), onPeer, count, 0);
+        return count;
+    }
+
+    /// @brief Read one lobby watch answer: {"version": N, "joined": [peers], "left": [peers]}
+    /// @details Peers are objects as parsePeerRecords() reads them, viewing into json.
+    /// @return The roster version the delta brings us to; nullopt when json is not such an object
+    template <typename OnJoined, typename OnLeft>
+    static std::optional<std::uint64_t> parseLobbyDelta(std::string_view json, OnJoined &&onJoined, OnLeft &&onLeft) noexcept
+    {
+        using Token = JsonTokenizer::Token;
+
+        JsonTokenizer tokens{json};
+        if (tokens.next() != Token::OBJECT_BEGIN)
+        {
+            return std::nullopt;
+        }
+
+        std::optional<std::uint64_t> version;
+        std::size_t count = 0;
+        const bool wellFormed = forEachMember(tokens, [&](std::string_view key, Token value)
+                                              {
+            if (value == Token::NUMBER && key == "version")
+            {
+                std::uint64_t number = 0;
+                if (parseNumber(tokens.text(), number))
+                {
+                    version = number;
+                }
+                return true;
+            }
+            if (key == "joined")
+            {
+                return walkPeerRecords(tokens, value, onJoined, count, 0);
+            }
+            if (key == "left")
+            {
+                return walkPeerRecords(tokens, value, onLeft, count, 0);
+            }
+            return tokens.skipValue(value); });
+
+        return wellFormed ? version : std::nullopt;
+    }
+
+    /// @brief Read rows, columns, seed and algo from one flat JSON object
+    [[nodiscard]] static MazeConfigFields parseMazeConfig(std::string_view json) noexcept
+    {
+        using mazes::args;
+
+        MazeConfigFields fields;
+        JsonTokenizer tokens{json};
+        if (tokens.next() != JsonTokenizer::Token::OBJECT_BEGIN)
+        {
+            return fields;
+        }
+
+        forEachMember(tokens, [&fields, &tokens](std::string_view key, JsonTokenizer::Token value)
+                      {
+            if (value == JsonTokenizer::Token::STRING && key == args::ALGO_ID_WORD_STR)
+            {
+                fields.algo = tokens.text();
+                return true;
+            }
+            int number = 0;
+            if (value == JsonTokenizer::Token::NUMBER && parseNumber(tokens.text(), number))
+            {
+                if (key == args::ROW_WORD_STR)
+                {
+                    fields.rows = number;
+                }
+                else if (key == args::COLUMN_WORD_STR)
+                {
+                    fields.columns = number;
+                }
+                else if (key == args::SEED_WORD_STR)
+                {
+                    fields.seed = number;
+                }
+                return true;
+            }
+            return tokens.skipValue(value); });
+
+        return fields;
+    }
+
+    /// @brief Split a server URL without a regex; "localhost" is left for the caller to map
+    [[nodiscard]] static std::optional<ServerEndpoint> parseServerUrl(std::string_view url) noexcept
+    {
+        std::size_t schemeLength = 0;
+        if (url.substr(0, 7) == "http://")
+        {
+            schemeLength = 7;
+        }
+        else if (url.substr(0, 8) == "https://")
+        {
+            schemeLength = 8;
+        }
+        else
+        {
+            return std::nullopt;
+        }
+
+        const std::string_view authority = url.substr(schemeLength, url.find('/', schemeLength) - schemeLength);
+        const std::size_t colon = authority.find(':');
+
+        ServerEndpoint endpoint;
+        endpoint.host = authority.substr(0, colon);
+        if (endpoint.host.empty())
+        {
+            return std::nullopt;
+        }
+        if (colon != std::string_view::npos && !parseNumber(authority.substr(colon + 1), endpoint.port))
+        {
+            return std::nullopt;
+        }
+        return endpoint;
+    }
+
+    /// @brief Whole-text integer parse, false on anything else or overflow
+    template <typename T>
+    static bool parseNumber(std::string_view text, T &out) noexcept
+    {
+        T value{};
+        const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (error != std::errc{} || end != text.data() + text.size())
+        {
+            return false;
+        }
+        out = value;
+        return true;
+    }
+
     /// @brief Resolve full path for a resource by combining base directory with relative path
     /// @param basePath Base directory path (may or may not have trailing slash)
     /// @param relativePath Relative file path (may or may not have leading slash)
@@ -114,42 +417,6 @@ public:
         return result;
     }
 
-    /// @brief Look up and resolve a resource path from configuration
-    /// @param key Resource key to look up
-    /// @param resources Resource map
-    /// @param resourcePathPrefix Base directory path
-    /// @return Full resolved path, or empty string if key not found
-    [[nodiscard]] static std::string getResourcePath(
-        const std::string &key,
-        const std::unordered_map<std::string, std::string> &resources,
-        const std::string &resourcePathPrefix)
-    {
-        auto it = resources.find(key);
-        if (it == resources.end())
-        {
-            return "";
-        }
-
-        const std::string extractedValue = extractJsonValue(it->second);
-        return resolveResourcePath(resourcePathPrefix, extractedValue);
-    }
-
-    /// @brief Look up a raw (non-file-path) resource value from configuration
-    /// @param key Resource key to look up
-    /// @param resources Resource map
-    /// @return Extracted resource value, or empty string if key not found
-    [[nodiscard]] static std::string getResourceValue(
-        const std::string &key,
-        const std::unordered_map<std::string, std::string> &resources)
-    {
-        if (auto it = resources.find(key); it != resources.cend())
-        {
-            return extractJsonValue(it->second);
-        }
-
-        return "";
-    }
-
     static void loadConfiguration(const std::string &configPath, std::unordered_map<std::string, std::string> &resourceMap)
     {
         using std::runtime_error;
@@ -169,121 +436,140 @@ public:
     /// @return Configured mazes::configurator object
     static mazes::configurator jsonToConfigurator(const std::string &jsonValue)
     {
-        using mazes::args;
         using mazes::configurator;
         using mazes::to_algo_from_sv;
 
         configurator config;
+        const MazeConfigFields fields = parseMazeConfig(jsonValue);
 
-        // Extract rows
-        if (auto rowsValue = extractJsonIntField(jsonValue, args::ROW_WORD_STR))
+        if (fields.rows)
         {
-            config.rows(static_cast<unsigned int>(rowsValue.value()));
+            config.rows(static_cast<unsigned int>(*fields.rows));
         }
 
-        // Extract columns
-        if (auto columnsValue = extractJsonIntField(jsonValue, args::COLUMN_WORD_STR))
+        if (fields.columns)
         {
-            config.columns(static_cast<unsigned int>(columnsValue.value()));
+            config.columns(static_cast<unsigned int>(*fields.columns));
         }
 
-        // Extract seed
-        if (auto seedValue = extractJsonIntField(jsonValue, args::SEED_WORD_STR))
+        if (fields.seed)
         {
-            config.seed(static_cast<unsigned int>(seedValue.value()));
+            config.seed(static_cast<unsigned int>(*fields.seed));
         }
 
-        // Extract algo
-        if (auto algoValue = extractJsonStringField(jsonValue, args::ALGO_ID_WORD_STR))
+        if (fields.algo)
         {
-            config.algo_id(to_algo_from_sv(algoValue.value()));
+            config.algo_id(to_algo_from_sv(*fields.algo));
         }
 
         return config;
     }
 
 private:
-    /// @brief Extract an integer field from JSON string
-    /// @param jsonValue The JSON string to parse
-    /// @param fieldName The field name to extract
-    /// @return Optional containing the integer value if found and valid
-    [[nodiscard]] static std::optional<int> extractJsonIntField(const std::string &jsonValue, const std::string &fieldName)
-    {
-        std::string searchKey = "\"" + fieldName + "\"";
-        auto fieldPos = jsonValue.find(searchKey);
+    static constexpr int MAX_DEPTH = 16;
 
-        if (fieldPos == std::string::npos)
-        {
-            return std::nullopt;
-        }
-
-        auto colonPos = jsonValue.find(':', fieldPos);
-        if (colonPos == std::string::npos)
-        {
-            return std::nullopt;
-        }
-
-        auto commaPos = jsonValue.find(',', colonPos);
-        if (commaPos == std::string::npos)
-        {
-            commaPos = jsonValue.find('}', colonPos);
-        }
-
-        if (commaPos == std::string::npos)
-        {
-            return std::nullopt;
-        }
-
-        auto value = jsonValue.substr(colonPos + 1, commaPos - colonPos - 1);
-
-        // Remove whitespace
-        value.erase(std::remove_if(value.begin(), value.end(), ::isspace), value.end());
+    /// @brief Walk the members of an object whose '{' was just read
+    /// @param onMember Called with each key and the first token of its value; it consumes the value
+    /// @return false on a malformed object or when onMember returns false
+    template <typename OnMember>
+    static bool forEachMember(JsonTokenizer &tokens, OnMember &&onMember) noexcept
+    {
+        using Token = JsonTokenizer::Token;
 
-        try
+        Token token = tokens.next();
+        while (token != Token::OBJECT_END)
         {
-            return std::stoi(value);
-        }
-        catch (...)
-        {
-            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to parse %s from: %s\n",
-                         fieldName.c_str(), value.c_str());
-            return std::nullopt;
+            if (token != Token::STRING)
+            {
+                return false;
+            }
+            const std::string_view key = tokens.text();
+            if (tokens.next() != Token::COLON || !onMember(key, tokens.next()))
+            {
+                return false;
+            }
+            token = tokens.next();
+            if (token == Token::COMMA)
+            {
+                token = tokens.next();
+            }
+            else if (token != Token::OBJECT_END)
+            {
+                return false;
+            }
         }
+        return true;
     }
 
-    /// @brief Extract a string field from JSON string
-    /// @param jsonValue The JSON string to parse
-    /// @param fieldName The field name to extract
-    /// @return Optional containing the string value if found
-    [[nodiscard]] static std::optional<std::string> extractJsonStringField(const std::string &jsonValue, const std::string &fieldName)
+    template <typename OnPeer>
+    static bool walkPeerRecords(JsonTokenizer &tokens, JsonTokenizer::Token first, OnPeer &onPeer,
+                                std::size_t &count, int depth) noexcept
     {
-        std::string searchKey = "\"" + fieldName + "\"";
-        auto fieldPos = jsonValue.find(searchKey);
+        using Token = JsonTokenizer::Token;
 
-        if (fieldPos == std::string::npos)
+        if (depth > MAX_DEPTH)
         {
-            return std::nullopt;
+            return false;
         }
 
-        auto colonPos = jsonValue.find(':', fieldPos);
-        if (colonPos == std::string::npos)
+        if (first == Token::ARRAY_BEGIN)
         {
-            return std::nullopt;
+            Token token = tokens.next();
+            while (token != Token::ARRAY_END)
+            {
+                if (!walkPeerRecords(tokens, token, onPeer, count, depth + 1))
+                {
+                    return false;
+                }
+                token = tokens.next();
+                if (token == Token::COMMA)
+                {
+                    token = tokens.next();
+                }
+                else if (token != Token::ARRAY_END)
+                {
+                    return false;
+                }
+            }
+            return true;
         }
 
-        auto quoteStart = jsonValue.find('"', colonPos);
-        if (quoteStart == std::string::npos)
+        if (first != Token::OBJECT_BEGIN)
         {
-            return std::nullopt;
+            return tokens.skipValue(first);
         }
 
-        auto quoteEnd = jsonValue.find('"', quoteStart + 1);
-        if (quoteEnd == std::string::npos)
+        PeerRecord peer;
+        bool hasName = false;
+        bool hasIp = false;
+        bool hasPort = false;
+        const bool wellFormed = forEachMember(tokens, [&](std::string_view key, Token value)
+                                              {
+            if (value == Token::STRING && key == "player_name")
+            {
+                peer.name = tokens.text();
+                hasName = true;
+                return true;
+            }
+            if (value == Token::STRING && key == "ip")
+            {
+                peer.ip = tokens.text();
+                hasIp = true;
+                return true;
+            }
+            if (value == Token::NUMBER && key == "port")
+            {
+                hasPort = parseNumber(tokens.text(), peer.port);
+                return true;
+            }
+            return walkPeerRecords(tokens, value, onPeer, count, depth + 1); });
+
+        if (wellFormed && hasName && hasIp && hasPort)
         {
-            return std::nullopt;
+            onPeer(peer);
+            ++count;
         }
-
-        return jsonValue.substr(quoteStart + 1, quoteEnd - quoteStart - 1);
+        return wellFormed;
     }
 };
 
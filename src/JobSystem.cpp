@@ -0,0 +1,285 @@
+#include "JobSystem.hpp"
+
+#include "CPUProfiler.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <exception>
+#include <system_error>
+
+thread_local int JobSystem::sWorkerIndex = -1;
+
+namespace
+{
+#if defined(__EMSCRIPTEN_PTHREADS__)
+    /// Workers past the page's pre-spawned pthread pool (PTHREAD_POOL_SIZE in src/CMakeLists.txt)
+    /// only start once the main thread yields to the browser, so stay well inside it
+    constexpr unsigned int kWebMaxWorkers = 4;
+#endif
+
+    /// @brief Leave one hardware thread for the main/render loop
+    unsigned int defaultWorkerCount() noexcept
+    {
+        const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        if (hardwareThreads <= 1)
+        {
+            return 2;
+        }
+#if defined(__EMSCRIPTEN_PTHREADS__)
+        return std::min(hardwareThreads - 1, kWebMaxWorkers);
+#else
+        return hardwareThreads - 1;
+#endif
+    }
+}
+
+JobSystem::JobSystem(unsigned int numWorkers)
+    : mCooperative{false}, mShouldStop{false}, mNextQueue{0}, mQueuedJobs{0}
+{
+    const unsigned int workerCount = (numWorkers == 0) ? defaultWorkerCount() : numWorkers;
+
+    mQueues.reserve(workerCount);
+    for (unsigned int i = 0; i < workerCount; ++i)
+    {
+        mQueues.push_back(std::make_unique<WorkerQueue>());
+    }
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    // Built without -pthread: std::thread cannot start at all
+    const unsigned int threadCount = 0;
+#else
+    const unsigned int threadCount = workerCount;
+#endif
+
+    mWorkers.reserve(threadCount);
+    try
+    {
+        for (unsigned int i = 0; i < threadCount; ++i)
+        {
+            mWorkers.emplace_back([this, i]()
+                                  { workerLoop(i); });
+        }
+    }
+    catch (const std::system_error &e)
+    {
+        // A pthreads web build on a page without cross-origin isolation has no SharedArrayBuffer.
+        // Workers that did start steal from the queues of those that did not
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "JobSystem: started %zu of %u worker threads: %s",
+                    mWorkers.size(), workerCount, e.what());
+    }
+
+    if (mWorkers.empty())
+    {
+        // One queue is enough when only the main loop drains it
+        mQueues.resize(1);
+        mCooperative = true;
+        SDL_Log("JobSystem: no worker threads, running jobs cooperatively on the main loop");
+        return;
+    }
+
+    SDL_Log("JobSystem: started %zu worker threads", mWorkers.size());
+}
+
+JobSystem::~JobSystem()
+{
+    shutdown();
+}
+
+void JobSystem::schedule(Job job) noexcept
+{
+    if (!job || mShouldStop.load(std::memory_order_acquire) || mQueues.empty())
+    {
+        return;
+    }
+
+    // Workers push to their own deque so nested jobs stay cache-local
+    const auto queueCount = static_cast<unsigned int>(mQueues.size());
+    const unsigned int target = (sWorkerIndex >= 0)
+                                    ? static_cast<unsigned int>(sWorkerIndex)
+                                    : mNextQueue.fetch_add(1, std::memory_order_relaxed) % queueCount;
+
+    {
+        std::lock_guard<std::mutex> lock(mQueues[target]->mutex);
+        mQueues[target]->jobs.push_back(std::move(job));
+    }
+
+    mQueuedJobs.fetch_add(1, std::memory_order_release);
+
+    // Taking the sleep lock orders this notify after any waiter's predicate check
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+    }
+    mWakeCondition.notify_one();
+}
+
+bool JobSystem::runPendingJob() noexcept
+{
+    Job job;
+
+    const bool found = (sWorkerIndex >= 0)
+                           ? (popLocal(static_cast<unsigned int>(sWorkerIndex), job) ||
+                              steal(static_cast<unsigned int>(sWorkerIndex), job))
+                           : steal(static_cast<unsigned int>(mQueues.size()), job);
+
+    if (found)
+    {
+        execute(job);
+    }
+
+    return found;
+}
+
+std::size_t JobSystem::runPendingJobs(std::chrono::microseconds budget) noexcept
+{
+    BW_PROFILE_ZONE("JobSystem::runPendingJobs");
+
+    const auto deadline = std::chrono::steady_clock::now() + budget;
+    std::size_t executed = 0;
+    while (runPendingJob())
+    {
+        ++executed;
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            break;
+        }
+    }
+    return executed;
+}
+
+void JobSystem::shutdown() noexcept
+{
+    if (mShouldStop.exchange(true, std::memory_order_acq_rel))
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+    }
+    mWakeCondition.notify_all();
+
+    for (auto &worker : mWorkers)
+    {
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+
+    mWorkers.clear();
+
+    // Destroying abandoned tasks sets broken_promise on their futures
+    for (auto &queue : mQueues)
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->jobs.clear();
+    }
+    mQueuedJobs.store(0, std::memory_order_release);
+}
+
+unsigned int JobSystem::getWorkerCount() const noexcept
+{
+    return mCooperative ? 0u : static_cast<unsigned int>(mQueues.size());
+}
+
+int JobSystem::getCurrentWorkerIndex() noexcept
+{
+    return sWorkerIndex;
+}
+
+std::pmr::memory_resource *JobSystem::getTaskResource() noexcept
+{
+    // Blocks up to the size of a chunk result; freed blocks are reused by the next submission
+    static auto *resource = new std::pmr::synchronized_pool_resource(std::pmr::pool_options{16, 4096});
+    return resource;
+}
+
+void JobSystem::workerLoop(unsigned int index) noexcept
+{
+    sWorkerIndex = static_cast<int>(index);
+    BW_PROFILE_THREAD("Job worker");
+
+    while (true)
+    {
+        Job job;
+
+        if (popLocal(index, job) || steal(index, job))
+        {
+            execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mSleepMutex);
+        mWakeCondition.wait(lock, [this]()
+                            { return mShouldStop.load(std::memory_order_acquire) ||
+                                     mQueuedJobs.load(std::memory_order_acquire) > 0; });
+
+        if (mShouldStop.load(std::memory_order_acquire))
+        {
+            break;
+        }
+    }
+
+    sWorkerIndex = -1;
+}
+
+bool JobSystem::popLocal(unsigned int index, Job &outJob) noexcept
+{
+    auto &queue = *mQueues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.jobs.empty())
+    {
+        return false;
+    }
+
+    outJob = std::move(queue.jobs.back());
+    queue.jobs.pop_back();
+    mQueuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+bool JobSystem::steal(unsigned int thiefIndex, Job &outJob) noexcept
+{
+    const auto queueCount = static_cast<unsigned int>(mQueues.size());
+
+    for (unsigned int offset = 1; offset <= queueCount; ++offset)
+    {
+        const unsigned int victim = (thiefIndex + offset) % queueCount;
+        if (victim == thiefIndex)
+        {
+            continue;
+        }
+
+        auto &queue = *mQueues[victim];
+        std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+        if (!lock.owns_lock() || queue.jobs.empty())
+        {
+            continue;
+        }
+
+        outJob = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        mQueuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+
+    return false;
+}
+
+void JobSystem::execute(Job &job) noexcept
+{
+    try
+    {
+        job();
+    }
+    catch (const std::exception &e)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "JobSystem: job threw exception: %s", e.what());
+    }
+    catch (...)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "JobSystem: job threw unknown exception");
+    }
+}
@@ -0,0 +1,139 @@
+#ifndef JOB_SYSTEM_HPP
+#define JOB_SYSTEM_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <MazeBuilder/singleton_base.h>
+
+/// @brief Engine-wide worker pool with one work-stealing deque per thread
+/// @details Workers pop their own deque LIFO and steal FIFO from siblings when empty.
+/// Jobs submitted from outside the pool are distributed round-robin across the deques.
+/// Where no thread can be started (a web build without pthreads, or a browser page without
+/// SharedArrayBuffer) the pool runs cooperatively: jobs queue up and the main loop executes
+/// them in time-boxed slices through runPendingJobs().
+class JobSystem : public mazes::singleton_base<JobSystem>
+{
+    friend class mazes::singleton_base<JobSystem>;
+
+public:
+    using Job = std::function<void()>;
+
+    /// @param numWorkers Worker count, 0 sizes the pool from std::thread::hardware_concurrency()
+    explicit JobSystem(unsigned int numWorkers = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+    JobSystem(JobSystem &&) = delete;
+    JobSystem &operator=(JobSystem &&) = delete;
+
+    /// @brief Queue a fire-and-forget job
+    void schedule(Job job) noexcept;
+
+    /// @brief Queue a job and return a future for its result
+    template <typename Func>
+    auto submit(Func &&func) -> std::future<std::invoke_result_t<std::decay_t<Func>>>
+    {
+        using Result = std::invoke_result_t<std::decay_t<Func>>;
+
+        struct Task
+        {
+            std::decay_t<Func> func;
+            std::promise<Result> promise;
+        };
+
+        // std::function requires copyable targets, so share the move-only task. The task and its
+        // promise state come from the task pool instead of the global heap
+        std::pmr::polymorphic_allocator<Task> allocator{getTaskResource()};
+        auto task = std::allocate_shared<Task>(
+            allocator, Task{std::forward<Func>(func), std::promise<Result>{std::allocator_arg, allocator}});
+        auto future = task->promise.get_future();
+        schedule([task]()
+                 {
+                     try
+                     {
+                         if constexpr (std::is_void_v<Result>)
+                         {
+                             task->func();
+                             task->promise.set_value();
+                         }
+                         else
+                         {
+                             task->promise.set_value(task->func());
+                         }
+                     }
+                     catch (...)
+                     {
+                         task->promise.set_exception(std::current_exception());
+                     }
+                 });
+        return future;
+    }
+
+    /// @brief Pool for state shared between a job and its submitter, such as futures and cancel flags
+    /// @details Thread-safe. It is never destroyed, since a future can outlive the job system
+    [[nodiscard]] static std::pmr::memory_resource *getTaskResource() noexcept;
+
+    /// @brief Run one queued job on the calling thread if any is available
+    /// @return true when a job was executed
+    bool runPendingJob() noexcept;
+
+    /// @brief Run queued jobs on the calling thread until none is left or budget has passed
+    /// @return Jobs executed; one job longer than the budget still runs to completion
+    std::size_t runPendingJobs(std::chrono::microseconds budget) noexcept;
+
+    /// @brief True when there are no worker threads, so queued jobs only run when someone calls runPendingJob(s)
+    [[nodiscard]] bool isCooperative() const noexcept { return mCooperative; }
+
+    /// @brief Jobs queued and not yet picked up
+    [[nodiscard]] int getQueuedJobCount() const noexcept { return mQueuedJobs.load(std::memory_order_acquire); }
+
+    /// @brief Stop accepting work, drain the deques and join all workers
+    void shutdown() noexcept;
+
+    /// @brief Worker deques in the pool, 0 when cooperative
+    [[nodiscard]] unsigned int getWorkerCount() const noexcept;
+
+    /// @brief Index of the calling worker thread, or -1 when called from outside the pool
+    [[nodiscard]] static int getCurrentWorkerIndex() noexcept;
+
+private:
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    void workerLoop(unsigned int index) noexcept;
+    bool popLocal(unsigned int index, Job &outJob) noexcept;
+    bool steal(unsigned int thiefIndex, Job &outJob) noexcept;
+    void execute(Job &job) noexcept;
+
+    std::vector<std::unique_ptr<WorkerQueue>> mQueues;
+    std::vector<std::thread> mWorkers;
+
+    bool mCooperative;
+    std::atomic<bool> mShouldStop;
+    std::atomic<unsigned int> mNextQueue;
+    std::atomic<int> mQueuedJobs;
+
+    std::mutex mSleepMutex;
+    std::condition_variable mWakeCondition;
+
+    static thread_local int sWorkerIndex;
+};
+
+#endif // JOB_SYSTEM_HPP
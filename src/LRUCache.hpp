@@ -0,0 +1,152 @@
+#ifndef LRU_CACHE_HPP
+#define LRU_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+/// @brief Counters reported by LRUCache::getStats
+struct LRUCacheStats
+{
+    std::uint64_t hits{0};
+    std::uint64_t misses{0};
+    std::uint64_t evictions{0};
+    std::size_t entries{0};
+    std::size_t bytes{0};
+    std::size_t budgetBytes{0};
+};
+
+/// @brief Least-recently-used cache bounded by an approximate byte budget
+/// @details Not thread-safe; callers guard it with their own mutex.
+/// Entry cost is sizeof(Key) + sizeof(Value) + bookkeeping unless a custom cost function is given.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LRUCache
+{
+public:
+    using CostFunction = std::function<std::size_t(const Value &)>;
+
+    explicit LRUCache(std::size_t budgetBytes, CostFunction cost = {})
+        : mBudgetBytes{budgetBytes}, mCost{std::move(cost)}
+    {
+    }
+
+    /// @brief Look up a value and mark it most recently used
+    std::optional<Value> get(const Key &key)
+    {
+        auto it = mIndex.find(key);
+        if (it == mIndex.end())
+        {
+            ++mMisses;
+            return std::nullopt;
+        }
+
+        ++mHits;
+        mEntries.splice(mEntries.begin(), mEntries, it->second);
+        return it->second->value;
+    }
+
+    /// @brief Insert or replace a value, evicting least recently used entries past the budget
+    void put(const Key &key, Value value)
+    {
+        const std::size_t cost = entryCost(value);
+
+        if (auto it = mIndex.find(key); it != mIndex.end())
+        {
+            mBytes -= it->second->cost;
+            it->second->value = std::move(value);
+            it->second->cost = cost;
+            mBytes += cost;
+            mEntries.splice(mEntries.begin(), mEntries, it->second);
+        }
+        else
+        {
+            mEntries.push_front(Entry{key, std::move(value), cost});
+            mIndex.emplace(key, mEntries.begin());
+            mBytes += cost;
+        }
+
+        evictToBudget();
+    }
+
+    bool erase(const Key &key)
+    {
+        auto it = mIndex.find(key);
+        if (it == mIndex.end())
+        {
+            return false;
+        }
+
+        mBytes -= it->second->cost;
+        mEntries.erase(it->second);
+        mIndex.erase(it);
+        return true;
+    }
+
+    void clear() noexcept
+    {
+        mEntries.clear();
+        mIndex.clear();
+        mBytes = 0;
+    }
+
+    void setBudget(std::size_t budgetBytes)
+    {
+        mBudgetBytes = budgetBytes;
+        evictToBudget();
+    }
+
+    [[nodiscard]] LRUCacheStats getStats() const noexcept
+    {
+        return LRUCacheStats{mHits, mMisses, mEvictions, mIndex.size(), mBytes, mBudgetBytes};
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return mIndex.size(); }
+
+private:
+    struct Entry
+    {
+        Key key;
+        Value value;
+        std::size_t cost;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    std::size_t entryCost(const Value &value) const
+    {
+        // List node plus hash-map node overhead, roughly four pointers
+        constexpr std::size_t kBookkeeping = 4 * sizeof(void *);
+        const std::size_t payload = mCost ? mCost(value) : sizeof(Value);
+        return sizeof(Key) + sizeof(std::size_t) + payload + kBookkeeping;
+    }
+
+    void evictToBudget()
+    {
+        // Always keep the newest entry, even if it alone exceeds the budget
+        while (mBytes > mBudgetBytes && mEntries.size() > 1)
+        {
+            const Entry &victim = mEntries.back();
+            mBytes -= victim.cost;
+            mIndex.erase(victim.key);
+            mEntries.pop_back();
+            ++mEvictions;
+        }
+    }
+
+    EntryList mEntries;
+    std::unordered_map<Key, typename EntryList::iterator, Hash> mIndex;
+
+    std::size_t mBudgetBytes;
+    std::size_t mBytes{0};
+    CostFunction mCost;
+
+    std::uint64_t mHits{0};
+    std::uint64_t mMisses{0};
+    std::uint64_t mEvictions{0};
+};
+
+#endif // LRU_CACHE_HPP
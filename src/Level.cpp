@@ -1,8 +1,18 @@
 #include "Level.hpp"
 
+#include "CPUProfiler.hpp"
+#include "JobSystem.hpp"
+
 #include <MazeBuilder/configurator.h>
 #include <MazeBuilder/create.h>
-#include <MazeBuilder/create2.h>
+
+#include <SDL3/SDL.h>
+
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <future>
+#include <thread>
 
 /// @brief Loads a level using internal library
 /// @param configs Vector of configurator references
@@ -10,28 +20,91 @@
 /// @return True if the level was loaded successfully, false otherwise
 bool Level::load(const std::vector<mazes::configurator> &configs, bool appendResults) noexcept
 {
-    if (appendResults)
+    BW_PROFILE_ZONE("Level::load");
+
+    auto &jobs = *JobSystem::instance();
+
+    std::vector<std::future<std::string>> pending;
+    pending.reserve(configs.size());
+    for (const auto &config : configs)
+    {
+        pending.push_back(jobs.submit([&config]()
+                                      {
+            BW_PROFILE_ZONE("Level::create");
+            return mazes::create(config); }));
+    }
+
+    std::vector<std::string> results;
+    results.reserve(pending.size());
+    for (auto &future : pending)
     {
-        std::string newData = mazes::create2(configs);
-        if (newData.empty())
+        // May run on a worker itself (the load graph's level task), so help instead of blocking one
+        while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
         {
-            return false;
+            if (!jobs.runPendingJob())
+            {
+                std::this_thread::yield();
+            }
         }
 
-        if (!mData.empty())
+        try
+        {
+            results.push_back(future.get());
+        }
+        catch (const std::exception &e)
         {
-            mData += "\n\n";
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Level: Failed to create maze: %s", e.what());
+            results.emplace_back();
         }
-        mData += newData;
     }
-    else
+
+    if (!appendResults)
     {
-        mData = mazes::create2(configs);
+        mData.clear();
+        mLevels.clear();
     }
-    return mData.empty() ? false : true;
+
+    // Size the joined string once instead of growing it maze by maze
+    std::size_t total = mData.size();
+    for (const auto &maze : results)
+    {
+        if (!maze.empty())
+        {
+            total += SEPARATOR.size() + maze.size();
+        }
+    }
+    mData.reserve(total);
+
+    bool generated = false;
+    for (const auto &maze : results)
+    {
+        if (maze.empty())
+        {
+            continue;
+        }
+        if (!mData.empty())
+        {
+            mData += SEPARATOR;
+        }
+        mLevels.push_back(Span{mData.size(), maze.size()});
+        mData += maze;
+        generated = true;
+    }
+
+    mDataHash = std::hash<std::string_view>{}(mData);
+    return generated;
 }
 
 const std::string &Level::getData() const noexcept
 {
     return mData;
 }
+
+std::string_view Level::getLevel(std::size_t index) const noexcept
+{
+    if (index >= mLevels.size())
+    {
+        return {};
+    }
+    return std::string_view{mData}.substr(mLevels[index].offset, mLevels[index].size);
+}
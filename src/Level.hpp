@@ -1,8 +1,10 @@
 #ifndef LEVEL_HPP
 #define LEVEL_HPP
 
+#include <cstddef>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace mazes
@@ -10,10 +12,17 @@ namespace mazes
     class configurator;
 }
 
+/// @brief Maze text generated from one or more configurators, one level per configurator
+/// @details Levels are separated by a blank line in getData() and can be reached on their own through
+/// getLevel(), so a consumer keyed on one level does not rescan the whole string.
 class Level
 {
 public:
+    /// Between levels in getData()
+    static constexpr std::string_view SEPARATOR = "\n\n";
+
     /// @brief Loads a level using internal library
+    /// @details Each configurator's maze is generated on its own job; the results are joined in order.
     /// @param configs Vector of configurator references
     /// @param appendResults Whether to append results to existing data
     /// @return True if the level was loaded successfully, false otherwise
@@ -22,8 +31,24 @@ public:
     /// Access generated maze text for downstream world generation.
     [[nodiscard]] const std::string &getData() const noexcept;
 
+    [[nodiscard]] std::size_t getLevelCount() const noexcept { return mLevels.size(); }
+
+    /// One configurator's maze inside getData(); empty past getLevelCount()
+    [[nodiscard]] std::string_view getLevel(std::size_t index) const noexcept;
+
+    /// std::hash of getData(), computed once per load for seeding
+    [[nodiscard]] std::size_t getDataHash() const noexcept { return mDataHash; }
+
 private:
+    struct Span
+    {
+        std::size_t offset{0};
+        std::size_t size{0};
+    };
+
     std::string mData;
+    std::vector<Span> mLevels;
+    std::size_t mDataHash{0};
 };
 
 #endif // LEVEL_HPP
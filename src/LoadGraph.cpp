@@ -0,0 +1,169 @@
+#include "LoadGraph.hpp"
+
+#include "CPUProfiler.hpp"
+#include "JobSystem.hpp"
+#include "StartupTimeline.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <exception>
+#include <string>
+#include <thread>
+#include <utility>
+
+LoadGraph::~LoadGraph()
+{
+    wait();
+}
+
+LoadGraph::TaskId LoadGraph::addWorker(const char *name, float weight, WorkerJob job,
+                                       std::initializer_list<TaskId> dependencies)
+{
+    return add(name, weight, false, std::move(job), {}, dependencies);
+}
+
+LoadGraph::TaskId LoadGraph::addMain(const char *name, float weight, MainStep step,
+                                     std::initializer_list<TaskId> dependencies)
+{
+    return add(name, weight, true, {}, std::move(step), dependencies);
+}
+
+LoadGraph::TaskId LoadGraph::add(const char *name, float weight, bool onMain, WorkerJob job, MainStep step,
+                                 std::initializer_list<TaskId> dependencies)
+{
+    Task &task = mTasks.emplace_back();
+    task.name = name;
+    task.weight = weight;
+    task.onMain = onMain;
+    task.job = std::move(job);
+    task.step = std::move(step);
+    task.dependencies.assign(dependencies.begin(), dependencies.end());
+
+    mTotalWeight += weight;
+    mRemaining.fetch_add(1, std::memory_order_relaxed);
+    return mTasks.size() - 1;
+}
+
+bool LoadGraph::isReady(const Task &task) const noexcept
+{
+    for (const TaskId dependency : task.dependencies)
+    {
+        if (mTasks[dependency].status.load(std::memory_order_acquire) != Status::DONE)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void LoadGraph::startWorkers() noexcept
+{
+    for (Task &task : mTasks)
+    {
+        if (task.onMain || task.status.load(std::memory_order_acquire) != Status::PENDING || !isReady(task))
+        {
+            continue;
+        }
+
+        task.status.store(Status::RUNNING, std::memory_order_relaxed);
+        mRunningWorkers.fetch_add(1, std::memory_order_relaxed);
+        JobSystem::instance()->schedule([this, &task]()
+                                        {
+            {
+                BW_PROFILE_ZONE("LoadGraph::workerTask");
+                try
+                {
+                    task.job();
+                }
+                catch (const std::exception &e)
+                {
+                    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "LoadGraph: task %s failed: %s", task.name, e.what());
+                }
+            }
+            if (StartupTimeline::isRunning())
+            {
+                StartupTimeline::mark(std::string("load: ") + task.name);
+            }
+            mDoneWeight.fetch_add(task.weight, std::memory_order_relaxed);
+            mRemaining.fetch_sub(1, std::memory_order_relaxed);
+            task.status.store(Status::DONE, std::memory_order_release);
+            mRunningWorkers.fetch_sub(1, std::memory_order_release); });
+    }
+}
+
+void LoadGraph::pump(std::chrono::microseconds budget) noexcept
+{
+    BW_PROFILE_ZONE("LoadGraph::pump");
+
+    const auto start = std::chrono::steady_clock::now();
+    bool ranStep = false;
+    bool progressed = true;
+
+    // A finished main task can unblock workers and other main tasks, so keep passing while that happens
+    while (progressed)
+    {
+        progressed = false;
+        startWorkers();
+
+        for (Task &task : mTasks)
+        {
+            if (!task.onMain || task.status.load(std::memory_order_relaxed) == Status::DONE || !isReady(task))
+            {
+                continue;
+            }
+            if (ranStep && std::chrono::steady_clock::now() - start >= budget)
+            {
+                return;
+            }
+
+            task.status.store(Status::RUNNING, std::memory_order_relaxed);
+            bool finished = true;
+            try
+            {
+                finished = task.step();
+            }
+            catch (const std::exception &e)
+            {
+                SDL_LogError(SDL_LOG_CATEGORY_ERROR, "LoadGraph: task %s failed: %s", task.name, e.what());
+            }
+            ranStep = true;
+
+            if (finished)
+            {
+                if (StartupTimeline::isRunning())
+                {
+                    StartupTimeline::mark(std::string("load: ") + task.name);
+                }
+                mDoneWeight.fetch_add(task.weight, std::memory_order_relaxed);
+                mRemaining.fetch_sub(1, std::memory_order_relaxed);
+                task.status.store(Status::DONE, std::memory_order_release);
+                progressed = true;
+            }
+        }
+    }
+}
+
+bool LoadGraph::isDone() const noexcept
+{
+    return mRemaining.load(std::memory_order_acquire) == 0;
+}
+
+float LoadGraph::getCompletion() const noexcept
+{
+    if (mTotalWeight <= 0.0f)
+    {
+        return 1.0f;
+    }
+    return mDoneWeight.load(std::memory_order_relaxed) / mTotalWeight;
+}
+
+void LoadGraph::wait() noexcept
+{
+    while (mRunningWorkers.load(std::memory_order_acquire) > 0)
+    {
+        if (!JobSystem::instance()->runPendingJob())
+        {
+            std::this_thread::yield();
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef LOAD_GRAPH_HPP
+#define LOAD_GRAPH_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <vector>
+
+/// @brief Loading work as a dependency graph of weighted tasks with thread affinity
+/// @details Worker tasks run on the JobSystem as soon as their dependencies finish. Main tasks need the
+/// GL context and run inside pump() on the calling thread, in time slices: a main step returns false to
+/// be called again next pump (polling a link or an upload queue), true once it is finished.
+/// Completion is the finished share of the task weights, so a progress bar moves with the real cost.
+/// Add every task before the first pump().
+class LoadGraph
+{
+public:
+    using TaskId = std::size_t;
+    using WorkerJob = std::function<void()>;
+    using MainStep = std::function<bool()>;
+
+    LoadGraph() = default;
+    ~LoadGraph();
+
+    LoadGraph(const LoadGraph &) = delete;
+    LoadGraph &operator=(const LoadGraph &) = delete;
+
+    TaskId addWorker(const char *name, float weight, WorkerJob job, std::initializer_list<TaskId> dependencies = {});
+    TaskId addMain(const char *name, float weight, MainStep step, std::initializer_list<TaskId> dependencies = {});
+
+    /// @brief Start ready worker tasks and run ready main steps until budget is spent (at least one step)
+    void pump(std::chrono::microseconds budget) noexcept;
+
+    [[nodiscard]] bool isDone() const noexcept;
+    /// @return Finished weight over total weight, 0.0 to 1.0
+    [[nodiscard]] float getCompletion() const noexcept;
+
+    /// Block until every started worker task has returned
+    void wait() noexcept;
+
+private:
+    enum class Status : std::uint8_t
+    {
+        PENDING,
+        RUNNING,
+        DONE
+    };
+
+    struct Task
+    {
+        const char *name;
+        float weight;
+        bool onMain;
+        WorkerJob job;
+        MainStep step;
+        std::vector<TaskId> dependencies;
+        std::atomic<Status> status{Status::PENDING};
+    };
+
+    TaskId add(const char *name, float weight, bool onMain, WorkerJob job, MainStep step,
+               std::initializer_list<TaskId> dependencies);
+    [[nodiscard]] bool isReady(const Task &task) const noexcept;
+    void startWorkers() noexcept;
+
+    // Deque so tasks stay put while workers hold references
+    std::deque<Task> mTasks;
+    float mTotalWeight{0.0f};
+    std::atomic<float> mDoneWeight{0.0f};
+    std::atomic<std::size_t> mRemaining{0};
+    std::atomic<int> mRunningWorkers{0};
+};
+
+#endif // LOAD_GRAPH_HPP
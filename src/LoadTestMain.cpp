@@ -0,0 +1,102 @@
+// Headless multiplayer load test: N simulated clients (NetLoadTest.hpp) in one process, no game code
+// Usage: breakingwalls_loadtest [peers] [seconds] [network_url|-] [relay host:port]
+
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <string>
+
+#include <SDL3/SDL.h>
+
+#include "NetLoadTest.hpp"
+
+namespace
+{
+    constexpr float kFixedTimeStep = 1.0f / 60.0f;
+    constexpr float kDefaultSeconds = 30.0f;
+}
+
+int main(int argc, char *argv[])
+{
+    NetLoadTest::Config config;
+    float seconds = kDefaultSeconds;
+    try
+    {
+        if (argc > 1)
+        {
+            config.peers = static_cast<std::size_t>(std::stoul(argv[1]));
+        }
+        if (argc > 2)
+        {
+            seconds = std::stof(argv[2]);
+        }
+        if (argc > 3 && std::string{argv[3]} != "-")
+        {
+            config.networkUrl = argv[3];
+        }
+        if (argc > 4)
+        {
+            config.relayAddress = argv[4];
+        }
+    }
+    catch (const std::exception &)
+    {
+        std::cerr << "Usage: " << argv[0] << " [peers] [seconds] [network_url|-] [relay host:port]" << std::endl;
+
+        return EXIT_FAILURE;
+    }
+
+    if (!SDL_Init(SDL_INIT_EVENTS))
+    {
+        std::cerr << "SDL_Init failed: " << SDL_GetError() << std::endl;
+
+        return EXIT_FAILURE;
+    }
+
+    int result = EXIT_SUCCESS;
+    {
+        NetLoadTest test{config};
+        if (!test.start())
+        {
+            result = EXIT_FAILURE;
+        }
+        else
+        {
+            // Every client ticks at the game's fixed step; a slow tick is reported, not skipped
+            const auto tickLength = std::chrono::duration<double>(kFixedTimeStep);
+            auto nextTick = std::chrono::steady_clock::now();
+            float elapsed = 0.0f;
+            float reportAccumulator = 0.0f;
+
+            while (seconds <= 0.0f || elapsed < seconds)
+            {
+                test.update(kFixedTimeStep);
+                elapsed += kFixedTimeStep;
+
+                reportAccumulator += kFixedTimeStep;
+                if (reportAccumulator >= NetLoadTest::REPORT_INTERVAL)
+                {
+                    reportAccumulator = 0.0f;
+                    test.report();
+                }
+
+                nextTick += std::chrono::duration_cast<std::chrono::steady_clock::duration>(tickLength);
+                const auto now = std::chrono::steady_clock::now();
+                if (nextTick > now)
+                {
+                    SDL_DelayNS(static_cast<Uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(nextTick - now).count()));
+                }
+                else
+                {
+                    nextTick = now;
+                }
+            }
+
+            test.report();
+        }
+    }
+
+    SDL_Quit();
+
+    return result;
+}
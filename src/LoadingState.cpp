@@ -4,14 +4,15 @@
 
 #include <atomic>
 #include <algorithm>
+#include <array>
 #include <cctype>
-#include <condition_variable>
-#include <deque>
 #include <filesystem>
 #include <functional>
-#include <thread>
+#include <future>
+#include <initializer_list>
 #include <mutex>
 #include <optional>
+#include <utility>
 
 #include <MazeBuilder/configurator.h>
 #include <MazeBuilder/create.h>
@@ -19,17 +20,28 @@
 #include <MazeBuilder/json_helper.h>
 #include <MazeBuilder/singleton_base.h>
 
+#include "AssetPack.hpp"
+#include "CPUProfiler.hpp"
 #include "Font.hpp"
 #include "GLTFModel.hpp"
+#include "HotReload.hpp"
+#include "JobSystem.hpp"
 #include "JSONUtils.hpp"
 #include "Level.hpp"
+#include "LoadGraph.hpp"
 #include "MusicPlayer.hpp"
 #include "Options.hpp"
+#include "ProceduralTexture.hpp"
+#include "ProgramBinaryCache.hpp"
 #include "ResourceIdentifiers.hpp"
+#include "ResourceConfig.hpp"
 #include "ResourceManager.hpp"
 #include "Shader.hpp"
+#include "StartupTimeline.hpp"
 #include "StateStack.hpp"
 #include "Texture.hpp"
+#include "TextureAtlas.hpp"
+#include "TextureUploadQueue.hpp"
 
 #include <fonts/Cousine_Regular.h>
 #include <fonts/Limelight_Regular.h>
@@ -37,12 +49,6 @@
 
 #include <dearimgui/backends/imgui_impl_opengl3.h>
 
-extern "C"
-{
-    float simplex2(float x, float y, int octaves, float persistence, float lacunarity);
-    float simplex3(float x, float y, float z, int octaves, float persistence, float lacunarity);
-}
-
 // Resource Keys
 namespace JSONKeys
 {
@@ -60,31 +66,33 @@ namespace JSONKeys
     constexpr std::string_view OGG_FILES = "ogg_files";
     constexpr std::string_view PLAYER_HITPOINTS_DEFAULT = "player_hitpoints_default";
     constexpr std::string_view PLAYER_SPEED_DEFAULT = "player_speed_default";
+    constexpr std::string_view RELAY_ADDRESS = "relay_address";
     constexpr std::string_view SDL_LOGO = "SDL_logo";
     constexpr std::string_view SFML_LOGO = "SFML_logo";
     constexpr std::string_view SHADER_BILLBOARD_VERTEX = "shader_billboard_vert_glsl";
     constexpr std::string_view SHADER_BILLBOARD_FRAGMENT = "shader_billboard_frag_glsl";
     constexpr std::string_view SHADER_BILLBOARD_GEOMETRY = "shader_billboard_geom_glsl";
     constexpr std::string_view SHADER_COMPOSITE_VERTEX = "shader_composite_vert_glsl";
-    constexpr std::string_view SHADER_COMPOSITE_FRAGMENT = "shader_composite_frag_glsl";
     constexpr std::string_view SHADER_HIGHLIGHT_TILE_VERTEX = "shader_highlight_tile_vert_glsl";
     constexpr std::string_view SHADER_HIGHLIGHT_TILE_FRAGMENT = "shader_highlight_tile_frag_glsl";
     constexpr std::string_view SHADER_GOAL_PATH_VERTEX = "shader_goal_path_vert_glsl";
     constexpr std::string_view SHADER_GOAL_PATH_FRAGMENT = "shader_goal_path_frag_glsl";
+    constexpr std::string_view SHADER_HIZ_COMPUTE = "shader_hiz_cs_glsl";
     constexpr std::string_view SHADER_MAZE_VERTEX = "shader_maze_vert_glsl";
     constexpr std::string_view SHADER_MAZE_FRAGMENT = "shader_maze_frag_glsl";
-    constexpr std::string_view SHADER_MOTION_BLUR_VERTEX = "shader_motion_blur_vert_glsl";
-    constexpr std::string_view SHADER_MOTION_BLUR_FRAGMENT = "shader_motion_blur_frag_glsl";
+    constexpr std::string_view SHADER_OCCLUSION_CULL_COMPUTE = "shader_occlusion_cull_cs_glsl";
     constexpr std::string_view SHADER_PARTICLES_COMPUTE = "shader_particles_cs_glsl";
     constexpr std::string_view SHADER_PARTICLES_VERTEX = "shader_particles_vert_glsl";
     constexpr std::string_view SHADER_PARTICLES_FRAGMENT = "shader_particles_frag_glsl";
-    constexpr std::string_view SHADER_OIT_RESOLVE_FRAGMENT = "shader_oit_resolve_frag_glsl";
+    constexpr std::string_view SHADER_POST_FRAGMENT = "shader_post_frag_glsl";
+    constexpr std::string_view SHADER_PROCEDURAL_COMPUTE = "shader_procedural_cs_glsl";
     constexpr std::string_view SHADER_SCREEN_VERTEX = "shader_screen_vert_glsl";
     constexpr std::string_view SHADER_SCREEN_FRAGMENT = "shader_screen_frag_glsl";
     constexpr std::string_view SHADER_SHADOW_VERTEX = "shader_shadow_vert_glsl";
     constexpr std::string_view SHADER_SHADOW_GEOMETRY = "shader_shadow_geom_glsl";
     constexpr std::string_view SHADER_SHADOW_FRAGMENT = "shader_shadow_frag_glsl";
     constexpr std::string_view SHADER_SKINNED_VERTEX = "shader_skinned_vert_glsl";
+    constexpr std::string_view SHADER_SKINNING_COMPUTE = "shader_skinning_cs_glsl";
     constexpr std::string_view SHADER_SKINNED_FRAGMENT = "shader_skinned_frag_glsl";
     constexpr std::string_view SHADER_SKY_VERTEX = "shader_sky_vert_glsl";
     constexpr std::string_view SHADER_SKY_FRAGMENT = "shader_sky_frag_glsl";
@@ -172,19 +180,12 @@ public:
     ResourceLoader(ResourceLoader &&) = delete;
     ResourceLoader &operator=(ResourceLoader &&) = delete;
 
-    /// @brief Initialize worker threads for concurrent resource loading
-    void initThreads(unsigned int numWorkers = 4) noexcept
+    /// @brief Start the shared job system used for concurrent resource loading
+    void initThreads() noexcept
     {
-        if (mWorkerThreads.size() > 0)
-        {
-            return;
-        }
-
-        for (unsigned int i = 0; i < numWorkers; ++i)
-        {
-            mWorkerThreads.emplace_back([this]()
-                                        { workerThreadFunc(); });
-        }
+        mShouldExit.store(false);
+        const auto &jobs = *mazes::singleton_base<JobSystem>::instance();
+        SDL_Log("ResourceLoader: using %u shared job workers", jobs.getWorkerCount());
     }
 
     /// @brief Queue resources for concurrent loading from the given path
@@ -196,9 +197,11 @@ public:
             return;
         }
 
+        // Let jobs from a previous load finish before resetting their outputs
+        waitForInFlightJobs();
+
         {
             std::unique_lock<std::mutex> lock(mQueueMutex);
-            mWorkQueue.clear();
             mResources.clear();
             mProcessedConfigs.clear();
             mTextureLoadRequests.clear();
@@ -242,17 +245,17 @@ public:
 
         {
             std::unique_lock<std::mutex> lock(mQueueMutex);
-
-            int index = 0;
-            for (const auto &[key, value] : resources)
-            {
-                mWorkQueue.emplace_back(key, value, index++);
-            }
-
-            mTotalWorkItems = static_cast<int>(mWorkQueue.size());
+            mTotalWorkItems = static_cast<int>(resources.size());
             mPendingWorkCount = mTotalWorkItems;
+        }
 
-            mCondVar.notify_all();
+        auto &jobs = *mazes::singleton_base<JobSystem>::instance();
+
+        int index = 0;
+        for (const auto &[key, value] : resources)
+        {
+            mInFlightJobs.push_back(jobs.submit([this, item = ResourceWorkItem(key, value, index++)]()
+                                                { runWorkItem(item); }));
         }
     }
 
@@ -305,45 +308,47 @@ public:
     }
 
 private:
-    /// @brief Worker thread function that processes work items from the queue
-    void workerThreadFunc() noexcept
+    /// @brief Job body that processes one work item and updates the completion count
+    void runWorkItem(const ResourceWorkItem &item) noexcept
     {
-        while (!mShouldExit.load())
         {
-            std::unique_lock<std::mutex> lock(mQueueMutex);
-
-            mCondVar.wait(lock, [this]()
-                          { return !mWorkQueue.empty() || mShouldExit.load(); });
-
-            if (mShouldExit.load())
-            {
-                break;
-            }
+            BW_PROFILE_ZONE("ResourceLoader::workItem");
+            processWorkItem(item);
+        }
 
-            std::optional<ResourceWorkItem> workItem;
+        std::unique_lock<std::mutex> lock(mQueueMutex);
+        --mPendingWorkCount;
+    }
 
-            if (!mWorkQueue.empty())
+    /// @brief Block until every job queued by load() has run
+    void waitForInFlightJobs() noexcept
+    {
+        auto &jobs = *mazes::singleton_base<JobSystem>::instance();
+        for (auto &job : mInFlightJobs)
+        {
+            if (!job.valid())
             {
-                workItem = mWorkQueue.front();
-                mWorkQueue.pop_front();
+                continue;
             }
 
-            lock.unlock();
-
-            if (workItem.has_value())
+            try
             {
-                processWorkItem(workItem.value());
-
-                lock.lock();
-                --mPendingWorkCount;
-
-                if (mPendingWorkCount <= 0)
+                // Without worker threads nothing else will ever run the job
+                if (jobs.isCooperative())
                 {
-                    mCondVar.notify_all();
+                    while (job.wait_for(std::chrono::seconds(0)) != std::future_status::ready && jobs.runPendingJob())
+                    {
+                    }
                 }
-                lock.unlock();
+                job.get();
+            }
+            catch (const std::exception &e)
+            {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "ResourceLoader: job abandoned: %s\n", e.what());
             }
         }
+
+        mInFlightJobs.clear();
     }
 
     /// @brief Process a single work item (resource loading and parsing)
@@ -492,30 +497,15 @@ private:
         }
     }
 
-    /// @brief Shut down all worker threads
+    /// @brief Cancel remaining work items and wait for running jobs
     void shutdown() noexcept
     {
-        {
-            std::unique_lock<std::mutex> lock(mQueueMutex);
-            mShouldExit.store(true);
-            mCondVar.notify_all();
-        }
-
-        for (auto &t : mWorkerThreads)
-        {
-            if (t.joinable())
-            {
-                t.join();
-            }
-        }
-
-        mWorkerThreads.clear();
+        mShouldExit.store(true);
+        waitForInFlightJobs();
     }
 
     mutable std::mutex mQueueMutex;
-    std::condition_variable mCondVar;
-    std::deque<ResourceWorkItem> mWorkQueue;
-    std::vector<std::thread> mWorkerThreads;
+    std::vector<std::future<void>> mInFlightJobs;
     std::atomic<bool> mShouldExit;
     int mPendingWorkCount;
     int mTotalWorkItems;
@@ -543,8 +533,11 @@ namespace
 /// @param context
 /// @param resourcePath ""
 LoadingState::LoadingState(StateStack &stack, Context context, std::string_view resourcePath)
-    : State(stack, context), mHasFinished{false}, mResourcePath{resourcePath}
+    : State(stack, context), mHasFinished{false}, mHasResources{false},
+      mTextureUploads{std::make_unique<TextureUploadQueue>()}, mSubmittedShaderCount{0}, mResourcePath{resourcePath},
+      mGraph{std::make_unique<LoadGraph>()}
 {
+    StartupTimeline::mark("LoadingState");
     resourceLoader().initThreads();
 
     // Start loading resources in background if path is provided
@@ -561,6 +554,7 @@ LoadingState::LoadingState(StateStack &stack, Context context, std::string_view
 
 LoadingState::~LoadingState()
 {
+    mGraph->wait();
 }
 
 void LoadingState::draw() const noexcept
@@ -568,7 +562,7 @@ void LoadingState::draw() const noexcept
     // Show resource loading progress in a simple ImGui window near bottom-left
     ImGuiIO &io = ImGui::GetIO();
     ImVec2 screenSize = io.DisplaySize;
-    float completion = resourceLoader().getCompletion();
+    float completion = mGraph->getCompletion();
     char buf[64];
     SDL_snprintf(buf, sizeof(buf), "Resource loading progress: %.0f%%", completion * 100.0f);
 
@@ -580,35 +574,39 @@ void LoadingState::draw() const noexcept
                  ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove |
                      ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
     ImGui::Text("%s", buf);
+    if (mSubmittedShaderCount > 0)
+    {
+        ImGui::Text("Shaders linked: %zu / %zu", mSubmittedShaderCount - mPendingShaders.size(), mSubmittedShaderCount);
+    }
+    if (mTextureUploads->getSubmittedCount() > 0)
+    {
+        ImGui::Text("Textures: %zu / %zu", mTextureUploads->getCompletedCount(), mTextureUploads->getSubmittedCount());
+    }
     ImGui::End();}
 
 bool LoadingState::update(float dt, unsigned int subSteps) noexcept
 {
-    if (!mHasFinished && resourceLoader().isDone())
+    if (mHasFinished)
     {
-        if (const auto resources = resourceLoader().getResources(); !resources.empty())
-        {
-            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Loading complete! Loaded %zu resources.", resources.size());
-
-            // Now actually load the getTextureManager() from the worker-collected texture requests
-            loadTexturesFromWorkerRequests();
-            // Handle window icon separately (special case, not managed by TextureManager)
-            loadWindowIcon(resources);
-            loadCursor(resources);
-            loadAudio();
-            loadModels();
-        }
+        return true;
+    }
+
+    mGraph->pump(LOAD_SLICE_BUDGET);
+
+    if (mGraph->isDone())
+    {
+        // Anything the driver has not finished yet is waited for here, right before the first state uses it
+        pollShaderLinks(true);
 
         mHasFinished = true;
+        StartupTimeline::mark("LoadingState done");
         requestStackPop();
         requestStackPush(States::ID::SPLASH);
+        return true;
     }
 
-    if (!mHasFinished)
-    {
-        setCompletion(resourceLoader().getCompletion());
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState::update - completion: %.0f%%", resourceLoader().getCompletion() * 100.f);
-    }
+    setCompletion(mGraph->getCompletion());
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState::update - completion: %.0f%%", mGraph->getCompletion() * 100.f);
 
     return true;
 }
@@ -637,23 +635,107 @@ void LoadingState::loadResources() noexcept
 {
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Loading resources from:\t%s", mResourcePath.c_str());
 
-    if (resourceLoader().isDone())
+    if (!resourceLoader().isDone())
     {
-        resourceLoader().load(mResourcePath);
-        loadFonts();
-        loadLevels();
-        loadShaders();
-        loadVAOs();
-        loadFBOs();
-        loadVBOs();
-        loadNetworkConfig();
+        return;
     }
+
+    // Weights are rough relative costs on a desktop; they only shape the progress display
+    LoadGraph &graph = *mGraph;
+
+    // Everything keyed by the JSON configuration waits for its values to be collected
+    // Shipped builds put every asset in one pack next to the JSON; loaders look there before the disk
+    const auto readConfig = graph.addWorker("read config", 1.0f, [this]()
+                                            {
+        resourceLoader().load(mResourcePath);
+        const std::string prefix = resourceLoader().getResourcePathPrefix();
+        AssetPack::mount(prefix + std::string(AssetPack::DEFAULT_FILENAME), prefix); });
+    // Parsed once here; every later task reads typed values and resolved paths from the context
+    const auto config = graph.addMain("collect config", 1.0f, [this]()
+                                      {
+        if (!resourceLoader().isDone())
+        {
+            return false;
+        }
+        getContext().getResourceConfig()->parse(resourceLoader().getResources(), resourceLoader().getResourcePathPrefix());
+        return true; }, {readConfig});
+
+    graph.addMain("fonts", 2.0f, [this]()
+                  { loadFonts(); return true; });
+    graph.addWorker("levels", 2.0f, [this]()
+                    { loadLevels(); });
+    graph.addMain("GL objects", 1.0f, [this]()
+                  { loadVAOs(); loadFBOs(); loadVBOs(); return true; });
+    graph.addMain("network config", 0.5f, [this]()
+                  { loadNetworkConfig(); return true; }, {config});
+
+    const auto shaders = graph.addMain("shader submit", 3.0f, [this]()
+                                       { loadShaders(); return true; }, {config});
+    graph.addMain("shader links", 3.0f, [this]()
+                  { pollShaderLinks(false); return mPendingShaders.empty(); }, {shaders});
+
+    graph.addWorker("audio", 3.0f, [this]()
+                    { loadAudio(); }, {config});
+
+    const auto modelImport = graph.addWorker("model import", 4.0f, [this]()
+                                             { importModel(); }, {config});
+    graph.addMain("model upload", 2.0f, [this]()
+                  { uploadModel(); return true; }, {modelImport});
+
+    const auto textures = graph.addMain("texture submit", 1.0f, [this]()
+                                        {
+        const ResourceConfig &config = *getContext().getResourceConfig();
+        if (!config.isLoaded())
+        {
+            return true;
+        }
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Loading complete! Loaded %zu resources.", config.size());
+        mHasResources = true;
+
+        // Image files decode on the job system; the upload task below pumps them in
+        submitTexturesFromWorkerRequests();
+        // Handle window icon separately (special case, not managed by TextureManager)
+        loadWindowIcon(config);
+        loadCursor(config);
+        return true; }, {config});
+    const auto uploads = graph.addMain("texture uploads", 4.0f, [this]()
+                                       {
+        mTextureUploads->pump(*getContext().getTextureManager(), TEXTURE_UPLOAD_BUDGET);
+        return mTextureUploads->isIdle(); }, {textures});
+    graph.addMain("procedural textures", 2.0f, [this]()
+                  {
+        // Procedural / render-target textures must always be created — GameState
+        // asserts their presence in the TextureManager at startup.
+        if (mHasResources)
+        {
+            try
+            {
+                loadProceduralTextures();
+            }
+            catch (const std::exception &e)
+            {
+                SDL_LogError(SDL_LOG_CATEGORY_ERROR, "LoadingState: Failed to create procedural textures: %s\n", e.what());
+            }
+        }
+        mTextureUploads->release();
+        buildTextureAtlas();
+        return true; }, {uploads});
 }
 
 void LoadingState::loadFonts() noexcept
 {
     auto &fonts = *getContext().getFontManager();
 
+    // Rasterized glyphs are stored on first launch and copied straight into the atlas afterwards
+    if (!Font::hasCacheDirectory())
+    {
+        if (char *prefPath = SDL_GetPrefPath("Flips And Ale", "Breaking Walls"); prefPath != nullptr)
+        {
+            Font::setCacheDirectory(std::string(prefPath) + "font_cache");
+            SDL_free(prefPath);
+        }
+    }
+
     fonts.load(Fonts::ID::LIMELIGHT,
                Limelight_Regular_compressed_data,
                Limelight_Regular_compressed_size);
@@ -668,6 +750,12 @@ void LoadingState::loadFonts() noexcept
 
     ImGuiIO &io = ImGui::GetIO();
     io.Fonts->Build();
+    for (const auto id : {Fonts::ID::LIMELIGHT, Fonts::ID::NUNITO_SANS, Fonts::ID::COUSINE_REGULAR})
+    {
+        const Font &font = fonts.get(id);
+        font.bakeGlyphs();
+        font.storeGlyphCache();
+    }
     ImGui_ImplOpenGL3_DestroyDeviceObjects();
     ImGui_ImplOpenGL3_CreateDeviceObjects();
     io.FontDefault = fonts.get(Fonts::ID::NUNITO_SANS).get();
@@ -676,18 +764,14 @@ void LoadingState::loadFonts() noexcept
 void LoadingState::loadAudio() noexcept
 {
     auto &music = *getContext().getMusicManager();
-    // Use the same resource path prefix that was computed by the ResourceLoader
-    auto resourcePathPrefix = resourceLoader().getResourcePathPrefix();
+    const ResourceConfig &config = *getContext().getResourceConfig();
 
-    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState::loadAudio - resourcePathPrefix: %s", resourcePathPrefix.c_str());
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState::loadAudio - resourcePathPrefix: %s", config.getPathPrefix().c_str());
 
     try
     {
-        const auto resources = resourceLoader().getResources();
-        const std::string loadingMusicPath = JSONUtils::getResourcePath(
-            std::string(JSONKeys::LOADING_MUSIC), resources, resourcePathPrefix);
-        const std::string gameMenuRemixedMusicPath = JSONUtils::getResourcePath(
-            std::string(JSONKeys::GAME_MENU_REMIXED_MUSIC), resources, resourcePathPrefix);
+        const std::string &loadingMusicPath = config.getPath(JSONKeys::LOADING_MUSIC);
+        const std::string &gameMenuRemixedMusicPath = config.getPath(JSONKeys::GAME_MENU_REMIXED_MUSIC);
 
         if (loadingMusicPath.empty() || gameMenuRemixedMusicPath.empty())
         {
@@ -720,13 +804,9 @@ void LoadingState::loadAudio() noexcept
     try
     {
         SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Loading sound effects...");
-        const auto resources = resourceLoader().getResources();
-        const std::string generatePath = JSONUtils::getResourcePath(
-            std::string(JSONKeys::SOUND_GENERATE), resources, resourcePathPrefix);
-        const std::string selectPath = JSONUtils::getResourcePath(
-            std::string(JSONKeys::SOUND_SELECT), resources, resourcePathPrefix);
-        const std::string throwPath = JSONUtils::getResourcePath(
-            std::string(JSONKeys::SOUND_THROW), resources, resourcePathPrefix);
+        const std::string &generatePath = config.getPath(JSONKeys::SOUND_GENERATE);
+        const std::string &selectPath = config.getPath(JSONKeys::SOUND_SELECT);
+        const std::string &throwPath = config.getPath(JSONKeys::SOUND_THROW);
 
         soundBuffers.load(SoundEffect::ID::GENERATE, generatePath);
 
@@ -761,50 +841,66 @@ void LoadingState::loadLevels() noexcept
     }
 }
 
-void LoadingState::loadModels() noexcept
+void LoadingState::importModel() noexcept
 {
-    auto &models = *getContext().getModelsManager();
-
     try
     {
-        const auto resources = resourceLoader().getResources();
-        const std::string modelPath = JSONUtils::getResourcePath(
-            std::string(JSONKeys::STYLIZED_CHARACTER_GLTF2_MODEL), resources, resourceLoader().getResourcePathPrefix());
+        mModelPath = getContext().getResourceConfig()->getPath(JSONKeys::STYLIZED_CHARACTER_GLTF2_MODEL);
 
-        if (modelPath.empty())
+        if (mModelPath.empty())
         {
             SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: model resource key not found in configuration");
+            return;
         }
-        else
-        {
-            models.load(Models::ID::STYLIZED_CHARACTER, modelPath);
-
-            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "%s", ("LoadingState: Found model path: " + modelPath).c_str());
-            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Loading model into manager...");
 
-            try
-            {
-                auto &model = models.get(Models::ID::STYLIZED_CHARACTER);
-                
-                // Break down the SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATIONging into smaller chunks for better debugging
-                const size_t meshCount = model.getMeshes().size();
-                const size_t boneCount = model.getBoneCount();
-                const size_t totalMeshBones = model.getTotalMeshBones();
-                const size_t animationCount = model.getAnimationNames().size();
-
-                SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "GLTFModel: loaded %s", modelPath.c_str());
-                SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "  Meshes: %zu", meshCount);
-                SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "  Bones (mapped): %zu", boneCount);
-                SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "  Mesh-bones (raw): %zu", totalMeshBones);
-                SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "  Animations: %zu", animationCount);
-
-                SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Model verified in manager");
-            }
-            catch (const std::exception &e)
+        // Imported meshes and animations are stored on first launch so later starts skip Assimp
+        if (!GLTFModel::hasCacheDirectory())
+        {
+            if (char *prefPath = SDL_GetPrefPath("Flips And Ale", "Breaking Walls"); prefPath != nullptr)
             {
-                SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Failed to verify model in manager: %s", e.what());
+                GLTFModel::setCacheDirectory(std::string(prefPath) + "model_cache");
+                SDL_free(prefPath);
             }
         }
+
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "%s", ("LoadingState: Found model path: " + mModelPath).c_str());
+        auto model = std::make_unique<GLTFModel>();
+        if (model->importFile(mModelPath))
+        {
+            mImportedModel = std::move(model);
+        }
+        else
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "LoadingState: Failed to import model: %s", mModelPath.c_str());
+        }
+    }
+    catch (const std::exception &e)
+    {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Failed to load models: %s", e.what());
+    }
+}
+
+void LoadingState::uploadModel() noexcept
+{
+    if (!mImportedModel)
+    {
+        return;
+    }
+
+    try
+    {
+        GLTFModel &model = *mImportedModel;
+        model.upload();
+        // Every character sharing the model then samples poses without walking the skeleton
+        model.bakeAnimations(GLTFModel::DEFAULT_BAKE_RATE);
+
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "GLTFModel: loaded %s", mModelPath.c_str());
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "  Meshes: %zu", model.getMeshes().size());
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "  Bones (mapped): %zu", model.getBoneCount());
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "  Mesh-bones (raw): %zu", model.getTotalMeshBones());
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "  Animations: %zu", model.getAnimationNames().size());
+
+        getContext().getModelsManager()->insert(Models::ID::STYLIZED_CHARACTER, std::move(mImportedModel));
     }
     catch (const std::exception &e)
     {
@@ -816,126 +912,84 @@ void LoadingState::loadShaders() noexcept
 {
     auto &shaders = *getContext().getShaderManager();
 
+    Shader::enableParallelCompile();
+
+    // Programs linked below are stored on first launch and loaded as driver binaries afterwards
+    if (!ProgramBinaryCache::isOpen())
+    {
+        if (char *prefPath = SDL_GetPrefPath("Flips And Ale", "Breaking Walls"); prefPath != nullptr)
+        {
+            ProgramBinaryCache::open(std::string(prefPath) + "shader_cache");
+            SDL_free(prefPath);
+        }
+    }
+
     try
     {
-        auto &&resources = resourceLoader().getResources();
-        const auto resourcePathPrefix = resourceLoader().getResourcePathPrefix();
+        const ResourceConfig &config = *getContext().getResourceConfig();
 
-        const auto shaderPath = [&](std::string_view key)
+        // Every program is submitted before any status is read back; with parallel compile the driver
+        // builds them in the background while update() polls and the worker threads load textures
+        const auto submit = [&](Shaders::ID id, const char *name,
+                                std::initializer_list<std::pair<Shader::ShaderType, std::string_view>> stages)
         {
-            return JSONUtils::getResourcePath(std::string(key), resources, resourcePathPrefix);
+            auto shader = std::make_unique<Shader>();
+            for (const auto &[type, key] : stages)
+            {
+                shader->compileAndAttachShader(type, config.getPath(key));
+            }
+            shader->submitLink();
+            HotReload::watchShader(id, *shader);
+            mPendingShaders.push_back(PendingShader{shader.get(), name});
+            shaders.insert(id, std::move(shader));
         };
 
-        auto displayShader = std::make_unique<Shader>();
-        displayShader->compileAndAttachShader(Shader::ShaderType::VERTEX, shaderPath(JSONKeys::SHADER_SCREEN_VERTEX));
-        displayShader->compileAndAttachShader(Shader::ShaderType::FRAGMENT, shaderPath(JSONKeys::SHADER_SCREEN_FRAGMENT));
-        displayShader->linkProgram();
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Program %u -> GLSL_FULLSCREEN_QUAD", displayShader->getProgramHandle());
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Display shader compiled and linked");
-
-        // Insert display shader into manager (using vertex ID as the combined shader program ID)
-        shaders.insert(Shaders::ID::GLSL_FULLSCREEN_QUAD, std::move(displayShader));
-
-        auto particlesDisplayShader = std::make_unique<Shader>();
-        particlesDisplayShader->compileAndAttachShader(Shader::ShaderType::VERTEX, shaderPath(JSONKeys::SHADER_PARTICLES_VERTEX));
-        particlesDisplayShader->compileAndAttachShader(Shader::ShaderType::FRAGMENT, shaderPath(JSONKeys::SHADER_PARTICLES_FRAGMENT));
-        particlesDisplayShader->linkProgram();
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Program %u -> GLSL_FULLSCREEN_QUAD_MVP", particlesDisplayShader->getProgramHandle());
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Particles display shader compiled and linked");
-        shaders.insert(Shaders::ID::GLSL_FULLSCREEN_QUAD_MVP, std::move(particlesDisplayShader));
-
-        auto compositeShader = std::make_unique<Shader>();
-        compositeShader->compileAndAttachShader(Shader::ShaderType::VERTEX, shaderPath(JSONKeys::SHADER_COMPOSITE_VERTEX));
-        compositeShader->compileAndAttachShader(Shader::ShaderType::FRAGMENT, shaderPath(JSONKeys::SHADER_COMPOSITE_FRAGMENT));
-        compositeShader->linkProgram();
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Program %u -> GLSL_COMPOSITE_SCENE", compositeShader->getProgramHandle());
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Composite shader compiled and linked");
-        shaders.insert(Shaders::ID::GLSL_COMPOSITE_SCENE, std::move(compositeShader));
-
-        auto oitResolveShader = std::make_unique<Shader>();
-        oitResolveShader->compileAndAttachShader(Shader::ShaderType::VERTEX, shaderPath(JSONKeys::SHADER_COMPOSITE_VERTEX));
-        oitResolveShader->compileAndAttachShader(Shader::ShaderType::FRAGMENT, shaderPath(JSONKeys::SHADER_OIT_RESOLVE_FRAGMENT));
-        oitResolveShader->linkProgram();
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Program %u -> GLSL_OIT_RESOLVE", oitResolveShader->getProgramHandle());
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: OIT resolve shader compiled and linked");
-        shaders.insert(Shaders::ID::GLSL_OIT_RESOLVE, std::move(oitResolveShader));
-
-        // Load shadow volume shader for character shadow rendering (vertex + geometry + fragment)
-        auto shadowShader = std::make_unique<Shader>();
-        shadowShader->compileAndAttachShader(Shader::ShaderType::VERTEX, shaderPath(JSONKeys::SHADER_SHADOW_VERTEX));
-        shadowShader->compileAndAttachShader(Shader::ShaderType::GEOMETRY, shaderPath(JSONKeys::SHADER_SHADOW_GEOMETRY));
-        shadowShader->compileAndAttachShader(Shader::ShaderType::FRAGMENT, shaderPath(JSONKeys::SHADER_SHADOW_FRAGMENT));
-        shadowShader->linkProgram();
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Program %u -> GLSL_SHADOW_VOLUME", shadowShader->getProgramHandle());
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Shadow shader compiled and linked");
-        shaders.insert(Shaders::ID::GLSL_SHADOW_VOLUME, std::move(shadowShader));
-
-        auto particlesComputeShader = std::make_unique<Shader>();
-        particlesComputeShader->compileAndAttachShader(Shader::ShaderType::COMPUTE, shaderPath(JSONKeys::SHADER_PARTICLES_COMPUTE));
-        particlesComputeShader->linkProgram();
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Program %u -> GLSL_PARTICLES_COMPUTE", particlesComputeShader->getProgramHandle());
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Compute shaders compiled and linked");
-        shaders.insert(Shaders::ID::GLSL_PARTICLES_COMPUTE, std::move(particlesComputeShader));
-
-        // Load billboard shader for character sprites (vertex + geometry + fragment)
-        auto billboardShader = std::make_unique<Shader>();
-        billboardShader->compileAndAttachShader(Shader::ShaderType::VERTEX, shaderPath(JSONKeys::SHADER_BILLBOARD_VERTEX));
-        billboardShader->compileAndAttachShader(Shader::ShaderType::GEOMETRY, shaderPath(JSONKeys::SHADER_BILLBOARD_GEOMETRY));
-        billboardShader->compileAndAttachShader(Shader::ShaderType::FRAGMENT, shaderPath(JSONKeys::SHADER_BILLBOARD_FRAGMENT));
-        billboardShader->linkProgram();
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Program %u -> GLSL_BILLBOARD_SPRITE", billboardShader->getProgramHandle());
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Billboard shader compiled and linked");
-        shaders.insert(Shaders::ID::GLSL_BILLBOARD_SPRITE, std::move(billboardShader));
-
-        auto skinnedShader = std::make_unique<Shader>();
-        skinnedShader->compileAndAttachShader(Shader::ShaderType::VERTEX, shaderPath(JSONKeys::SHADER_SKINNED_VERTEX));
-        skinnedShader->compileAndAttachShader(Shader::ShaderType::FRAGMENT, shaderPath(JSONKeys::SHADER_SKINNED_FRAGMENT));
-        skinnedShader->linkProgram();
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Program %u -> GLSL_SKINNED_MODEL", skinnedShader->getProgramHandle());
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Skinned shader compiled and linked");
-        shaders.insert(Shaders::ID::GLSL_SKINNED_MODEL, std::move(skinnedShader));
-
-        auto goalPathShader = std::make_unique<Shader>();
-        goalPathShader->compileAndAttachShader(Shader::ShaderType::VERTEX, shaderPath(JSONKeys::SHADER_GOAL_PATH_VERTEX));
-        goalPathShader->compileAndAttachShader(Shader::ShaderType::FRAGMENT, shaderPath(JSONKeys::SHADER_GOAL_PATH_FRAGMENT));
-        goalPathShader->linkProgram();
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Program %u -> GLSL_GOAL_PATH_STENCIL", goalPathShader->getProgramHandle());
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Goal path shader compiled and linked");
-        shaders.insert(Shaders::ID::GLSL_GOAL_PATH_STENCIL, std::move(goalPathShader));
-
-        auto highlightTileShader = std::make_unique<Shader>();
-        highlightTileShader->compileAndAttachShader(Shader::ShaderType::VERTEX, shaderPath(JSONKeys::SHADER_HIGHLIGHT_TILE_VERTEX));
-        highlightTileShader->compileAndAttachShader(Shader::ShaderType::FRAGMENT, shaderPath(JSONKeys::SHADER_HIGHLIGHT_TILE_FRAGMENT));
-        highlightTileShader->linkProgram();
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Program %u -> GLSL_HIGHLIGHT_TILE", highlightTileShader->getProgramHandle());
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Highlight tile shader compiled and linked");
-        shaders.insert(Shaders::ID::GLSL_HIGHLIGHT_TILE, std::move(highlightTileShader));
-
-        auto mazeShader = std::make_unique<Shader>();
-        mazeShader->compileAndAttachShader(Shader::ShaderType::VERTEX, shaderPath(JSONKeys::SHADER_MAZE_VERTEX));
-        mazeShader->compileAndAttachShader(Shader::ShaderType::FRAGMENT, shaderPath(JSONKeys::SHADER_MAZE_FRAGMENT));
-        mazeShader->linkProgram();
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Program %u -> GLSL_MAZE", mazeShader->getProgramHandle());
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Maze shader compiled and linked");
-        shaders.insert(Shaders::ID::GLSL_MAZE, std::move(mazeShader));
-
-        auto motionBlurShader = std::make_unique<Shader>();
-        motionBlurShader->compileAndAttachShader(Shader::ShaderType::VERTEX, shaderPath(JSONKeys::SHADER_MOTION_BLUR_VERTEX));
-        motionBlurShader->compileAndAttachShader(Shader::ShaderType::FRAGMENT, shaderPath(JSONKeys::SHADER_MOTION_BLUR_FRAGMENT));
-        motionBlurShader->linkProgram();
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Program %u -> GLSL_MOTION_BLUR", motionBlurShader->getProgramHandle());
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Motion blur shader compiled and linked");
-        shaders.insert(Shaders::ID::GLSL_MOTION_BLUR, std::move(motionBlurShader));
-
-        auto skyShader = std::make_unique<Shader>();
-        skyShader->compileAndAttachShader(Shader::ShaderType::VERTEX, shaderPath(JSONKeys::SHADER_SKY_VERTEX));
-        skyShader->compileAndAttachShader(Shader::ShaderType::FRAGMENT, shaderPath(JSONKeys::SHADER_SKY_FRAGMENT));
-        skyShader->linkProgram();
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Program %u -> GLSL_SKY", skyShader->getProgramHandle());
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Sky shader compiled and linked");
-        shaders.insert(Shaders::ID::GLSL_SKY, std::move(skyShader));
-
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: All shaders loaded successfully");
+        using Type = Shader::ShaderType;
+
+        submit(Shaders::ID::GLSL_FULLSCREEN_QUAD, "GLSL_FULLSCREEN_QUAD",
+               {{Type::VERTEX, JSONKeys::SHADER_SCREEN_VERTEX}, {Type::FRAGMENT, JSONKeys::SHADER_SCREEN_FRAGMENT}});
+        submit(Shaders::ID::GLSL_FULLSCREEN_QUAD_MVP, "GLSL_FULLSCREEN_QUAD_MVP",
+               {{Type::VERTEX, JSONKeys::SHADER_PARTICLES_VERTEX}, {Type::FRAGMENT, JSONKeys::SHADER_PARTICLES_FRAGMENT}});
+        // Base permutation only; PostProcess compiles the variants for the enabled effects from the same files
+        submit(Shaders::ID::GLSL_POST_PROCESS, "GLSL_POST_PROCESS",
+               {{Type::VERTEX, JSONKeys::SHADER_COMPOSITE_VERTEX}, {Type::FRAGMENT, JSONKeys::SHADER_POST_FRAGMENT}});
+
+        // Shadow volume shader for character shadow rendering (vertex + geometry + fragment)
+        submit(Shaders::ID::GLSL_SHADOW_VOLUME, "GLSL_SHADOW_VOLUME",
+               {{Type::VERTEX, JSONKeys::SHADER_SHADOW_VERTEX},
+                {Type::GEOMETRY, JSONKeys::SHADER_SHADOW_GEOMETRY},
+                {Type::FRAGMENT, JSONKeys::SHADER_SHADOW_FRAGMENT}});
+
+        submit(Shaders::ID::GLSL_PARTICLES_COMPUTE, "GLSL_PARTICLES_COMPUTE",
+               {{Type::COMPUTE, JSONKeys::SHADER_PARTICLES_COMPUTE}});
+
+        // Billboard shader for character sprites (vertex + geometry + fragment)
+        submit(Shaders::ID::GLSL_BILLBOARD_SPRITE, "GLSL_BILLBOARD_SPRITE",
+               {{Type::VERTEX, JSONKeys::SHADER_BILLBOARD_VERTEX},
+                {Type::GEOMETRY, JSONKeys::SHADER_BILLBOARD_GEOMETRY},
+                {Type::FRAGMENT, JSONKeys::SHADER_BILLBOARD_FRAGMENT}});
+
+        submit(Shaders::ID::GLSL_SKINNED_MODEL, "GLSL_SKINNED_MODEL",
+               {{Type::VERTEX, JSONKeys::SHADER_SKINNED_VERTEX}, {Type::FRAGMENT, JSONKeys::SHADER_SKINNED_FRAGMENT}});
+        submit(Shaders::ID::GLSL_SKINNING_COMPUTE, "GLSL_SKINNING_COMPUTE",
+               {{Type::COMPUTE, JSONKeys::SHADER_SKINNING_COMPUTE}});
+        submit(Shaders::ID::GLSL_GOAL_PATH_STENCIL, "GLSL_GOAL_PATH_STENCIL",
+               {{Type::VERTEX, JSONKeys::SHADER_GOAL_PATH_VERTEX}, {Type::FRAGMENT, JSONKeys::SHADER_GOAL_PATH_FRAGMENT}});
+        submit(Shaders::ID::GLSL_HIGHLIGHT_TILE, "GLSL_HIGHLIGHT_TILE",
+               {{Type::VERTEX, JSONKeys::SHADER_HIGHLIGHT_TILE_VERTEX}, {Type::FRAGMENT, JSONKeys::SHADER_HIGHLIGHT_TILE_FRAGMENT}});
+        submit(Shaders::ID::GLSL_MAZE, "GLSL_MAZE",
+               {{Type::VERTEX, JSONKeys::SHADER_MAZE_VERTEX}, {Type::FRAGMENT, JSONKeys::SHADER_MAZE_FRAGMENT}});
+        submit(Shaders::ID::GLSL_HIZ_COMPUTE, "GLSL_HIZ_COMPUTE",
+               {{Type::COMPUTE, JSONKeys::SHADER_HIZ_COMPUTE}});
+        submit(Shaders::ID::GLSL_OCCLUSION_CULL_COMPUTE, "GLSL_OCCLUSION_CULL_COMPUTE",
+               {{Type::COMPUTE, JSONKeys::SHADER_OCCLUSION_CULL_COMPUTE}});
+        submit(Shaders::ID::GLSL_PROCEDURAL_COMPUTE, "GLSL_PROCEDURAL_COMPUTE",
+               {{Type::COMPUTE, JSONKeys::SHADER_PROCEDURAL_COMPUTE}});
+        submit(Shaders::ID::GLSL_SKY, "GLSL_SKY",
+               {{Type::VERTEX, JSONKeys::SHADER_SKY_VERTEX}, {Type::FRAGMENT, JSONKeys::SHADER_SKY_FRAGMENT}});
+
+        mSubmittedShaderCount = mPendingShaders.size();
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Submitted %zu shader programs", mSubmittedShaderCount);
     }
     catch (const std::exception &e)
     {
@@ -943,6 +997,29 @@ void LoadingState::loadShaders() noexcept
     }
 }
 
+void LoadingState::pollShaderLinks(bool block) noexcept
+{
+    auto it = mPendingShaders.begin();
+    while (it != mPendingShaders.end())
+    {
+        if (!block && !it->shader->isLinkComplete())
+        {
+            ++it;
+            continue;
+        }
+
+        it->shader->finishLink();
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Program %u -> %s",
+                    it->shader->getProgramHandle(), it->name);
+        it = mPendingShaders.erase(it);
+    }
+
+    if (block && mSubmittedShaderCount > 0)
+    {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: All shaders loaded successfully");
+    }
+}
+
 void LoadingState::loadVAOs() noexcept
 {
     auto *vaoManager = getContext().getVAOManager();
@@ -958,11 +1035,12 @@ void LoadingState::loadVAOs() noexcept
         // it simply calls glGenVertexArrays to allocate the VAO name.
         vaoManager->load(VAOs::ID::FULLSCREEN_QUAD, "fullscreen_quad");
         vaoManager->load(VAOs::ID::SHADOW_QUAD, "shadow_quad");
-        vaoManager->load(VAOs::ID::WALK_PARTICLES, "walk_particles");
         vaoManager->load(VAOs::ID::RASTER_MAZE, "raster_maze");
         vaoManager->load(VAOs::ID::GOAL_PATH, "goal_path");
         vaoManager->load(VAOs::ID::PLAYER_TILE_HIGHLIGHT, "player_tile_highlight");
         vaoManager->load(VAOs::ID::PICKUP_SPHERES, "pickup_spheres");
+        vaoManager->load(VAOs::ID::MAZE_WALLS, "maze_walls");
+        vaoManager->load(VAOs::ID::MAZE_CHUNK_WALLS, "maze_chunk_walls");
 
         SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Loaded %d VAOs",
                     static_cast<int>(VAOs::ID::TOTAL_IDS));
@@ -984,18 +1062,16 @@ void LoadingState::loadFBOs() noexcept
 
     try
     {
+        // Depth for both comes from SCENE_DEPTH / OIT_DEPTH textures, which the OIT resolve samples
         fboManager->load(FBOs::ID::BILLBOARD, "billboard");
-        fboManager->get(FBOs::ID::BILLBOARD).createRenderbuffer();
-
         fboManager->load(FBOs::ID::OIT, "oit");
-        fboManager->get(FBOs::ID::OIT).createRenderbuffer();
 
         fboManager->load(FBOs::ID::SHADOW, "shadow");
 
         fboManager->load(FBOs::ID::REFLECTION, "reflection");
         fboManager->get(FBOs::ID::REFLECTION).createRenderbuffer();
-
-        fboManager->load(FBOs::ID::MOTION_BLUR, "motion_blur");
+        // Colour only: the cached sky is drawn without depth
+        fboManager->load(FBOs::ID::SKY, "sky");
 
         SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Loaded %d FBOs",
                     static_cast<int>(FBOs::ID::TOTAL_IDS));
@@ -1018,11 +1094,16 @@ void LoadingState::loadVBOs() noexcept
     try
     {
         vboManager->load(VBOs::ID::SHADOW, "shadow");
-        vboManager->load(VBOs::ID::WALK_PARTICLES_POS_SSBO, "walk_particles_pos");
-        vboManager->load(VBOs::ID::WALK_PARTICLES_VEL_SSBO, "walk_particles_vel");
         vboManager->load(VBOs::ID::RASTER_MAZE, "raster_maze");
         vboManager->load(VBOs::ID::GOAL_PATH, "goal_path");
         vboManager->load(VBOs::ID::PICKUP, "pickup");
+        vboManager->load(VBOs::ID::PICKUP_INSTANCES, "pickup_instances");
+        vboManager->load(VBOs::ID::MAZE_FLOOR_INDICES, "maze_floor_indices");
+        vboManager->load(VBOs::ID::MAZE_WALL_CUBE, "maze_wall_cube");
+        vboManager->load(VBOs::ID::MAZE_WALL_CUBE_INDICES, "maze_wall_cube_indices");
+        vboManager->load(VBOs::ID::MAZE_WALL_INSTANCES, "maze_wall_instances");
+        vboManager->load(VBOs::ID::MAZE_CHUNK_WALL_INSTANCES, "maze_chunk_wall_instances");
+        vboManager->load(VBOs::ID::MAZE_CHUNK_INDIRECT, "maze_chunk_indirect");
 
         SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Loaded %d VBOs",
                     static_cast<int>(VBOs::ID::TOTAL_IDS));
@@ -1039,9 +1120,9 @@ void LoadingState::loadNetworkConfig() noexcept
 
     try
     {
-        const auto resources = resourceLoader().getResources();
+        const ResourceConfig &config = *getContext().getResourceConfig();
 
-        const std::string url = JSONUtils::getResourceValue(std::string(JSONKeys::NETWORK_URL), resources);
+        const std::string &url = config.getValue(JSONKeys::NETWORK_URL);
         if (url.empty())
         {
             SDL_LogError(SDL_LOG_CATEGORY_ERROR, "LoadingState: NETWORK_URL resource key not found in configuration");
@@ -1051,6 +1132,14 @@ void LoadingState::loadNetworkConfig() noexcept
             httpClient.setServerURL(url);
             SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "%s", ("LoadingState: Found network URL: " + url).c_str());
         }
+
+        // Optional: without it multiplayer connects every peer to every other one
+        const std::string &relay = config.getValue(JSONKeys::RELAY_ADDRESS);
+        if (!relay.empty())
+        {
+            httpClient.setRelayAddress(relay);
+            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "%s", ("LoadingState: Found relay address: " + relay).c_str());
+        }
     }
     catch (const std::exception &e)
     {
@@ -1058,51 +1147,49 @@ void LoadingState::loadNetworkConfig() noexcept
     }
 }
 
-void LoadingState::loadTexturesFromWorkerRequests() const noexcept
+void LoadingState::submitTexturesFromWorkerRequests() noexcept
 {
-    auto &textures = *getContext().getTextureManager();
+    using Residency = TextureManager::Residency;
 
-    auto textureRequests = resourceLoader().getTextureLoadRequests();
+    // Shown by a single state, so they load when it acquires them instead of during the load screen
+    constexpr std::array<std::pair<Textures::ID, Residency>, 4> kLazyTextures{{
+        {Textures::ID::SPLASH_TITLE_IMAGE, Residency::ONE_SHOT},
+        {Textures::ID::FAA_LOGO, Residency::ONE_SHOT},
+        {Textures::ID::SFML_LOGO, Residency::ONE_SHOT},
+        {Textures::ID::SDL_LOGO, Residency::CACHED}}};
 
-    // Load each texture file independently so one missing file does not abort
-    // the rest of the load (including the mandatory procedural textures below).
-    for (const auto &request : textureRequests)
+    auto &textures = *getContext().getTextureManager();
+    textures.setBudget(LAZY_TEXTURE_BUDGET);
+
+    // Each file decodes and uploads independently, so one missing file does not abort
+    // the rest of the load (including the mandatory procedural textures).
+    for (auto &request : resourceLoader().getTextureLoadRequests())
     {
-        try
-        {
-            textures.load(request.id, std::string_view(request.path), 0u);
-            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Loaded texture: %s for ID: %d",
-                        request.path.c_str(), static_cast<int>(request.id));
-        }
-        catch (const std::exception &e)
+        const auto lazy = std::ranges::find(kLazyTextures, request.id, &std::pair<Textures::ID, Residency>::first);
+        if (lazy == kLazyTextures.end())
         {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
-                        "LoadingState: Skipping texture (file unavailable) id=%d path=%s: %s",
-                        static_cast<int>(request.id), request.path.c_str(), e.what());
+            HotReload::watchTexture(request.id, request.path);
+            mTextureUploads->submit(request.id, std::move(request.path), 0u);
+            continue;
         }
-    }
 
-    // Procedural / render-target textures must always be created — GameState
-    // asserts their presence in the TextureManager at startup.
-    try
-    {
-        loadProceduralTextures();
-    }
-    catch (const std::exception &e)
-    {
-        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "LoadingState: Failed to create procedural textures: %s\n", e.what());
+        textures.registerLazy(request.id,
+                              [path = std::move(request.path)]() -> std::unique_ptr<Texture>
+                              {
+                                  auto texture = std::make_unique<Texture>();
+                                  if (!texture->loadFromFile(path))
+                                  {
+                                      return nullptr;
+                                  }
+                                  return texture;
+                              },
+                              lazy->second);
     }
 }
 
-void LoadingState::loadWindowIcon(const std::unordered_map<std::string, std::string> &resources) const noexcept
+void LoadingState::loadWindowIcon(const ResourceConfig &config) const noexcept
 {
-    using std::string;
-
-    // Use the same resource path prefix that was computed by the ResourceLoader
-    auto resourcePathPrefix = resourceLoader().getResourcePathPrefix();
-
-    const string windowIconPath = JSONUtils::getResourcePath(
-        std::string(JSONKeys::WINDOW_ICON), resources, resourcePathPrefix);
+    const std::string &windowIconPath = config.getPath(JSONKeys::WINDOW_ICON);
 
     if (windowIconPath.empty())
     {
@@ -1111,7 +1198,10 @@ void LoadingState::loadWindowIcon(const std::unordered_map<std::string, std::str
         return;
     }
 
-    if (SDL_Surface *icon = SDL_LoadBMP(windowIconPath.c_str()); icon != nullptr)
+    const auto packedIcon = AssetPack::find(windowIconPath);
+    SDL_Surface *icon = packedIcon.empty() ? SDL_LoadBMP(windowIconPath.c_str())
+                                           : SDL_LoadBMP_IO(SDL_IOFromConstMem(packedIcon.data(), packedIcon.size()), true);
+    if (icon != nullptr)
     {
         if (auto *renderWindow = getContext().getRenderWindow(); renderWindow != nullptr)
         {
@@ -1128,14 +1218,9 @@ void LoadingState::loadWindowIcon(const std::unordered_map<std::string, std::str
     }
 }
 
-void LoadingState::loadCursor(const std::unordered_map<std::string, std::string> &resources) noexcept
+void LoadingState::loadCursor(const ResourceConfig &config) noexcept
 {
-    using std::string;
-
-    auto resourcePathPrefix = resourceLoader().getResourcePathPrefix();
-
-    const string cursorImagePath = JSONUtils::getResourcePath(
-        std::string(JSONKeys::CURSOR_ICON), resources, resourcePathPrefix);
+    const std::string &cursorImagePath = config.getPath(JSONKeys::CURSOR_ICON);
 
     if (cursorImagePath.empty())
     {
@@ -1143,7 +1228,10 @@ void LoadingState::loadCursor(const std::unordered_map<std::string, std::string>
         return;
     }
 
-    SDL_Surface *cursorSurface = SDL_LoadPNG(cursorImagePath.c_str());
+    const auto packedCursor = AssetPack::find(cursorImagePath);
+    SDL_Surface *cursorSurface = packedCursor.empty()
+                                     ? SDL_LoadPNG(cursorImagePath.c_str())
+                                     : SDL_LoadPNG_IO(SDL_IOFromConstMem(packedCursor.data(), packedCursor.size()), true);
     if (cursorSurface == nullptr)
     {
         SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Failed to load cursor image: %s - %s",
@@ -1172,25 +1260,43 @@ void LoadingState::loadCursor(const std::unordered_map<std::string, std::string>
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Cursor loaded from:\t%s", cursorImagePath.c_str());
 }
 
+void LoadingState::buildTextureAtlas() const noexcept
+{
+    TextureAtlas *atlas = getContext().getTextureAtlas();
+    if (!atlas)
+    {
+        return;
+    }
+
+    // Clamp-sampled images only; tiled surfaces (walls, level textures) need their own wrap mode.
+    // The logos load on demand, so they are not resident to pack.
+    constexpr std::array<Textures::ID, 2> kAtlasTextures{
+        Textures::ID::CHARACTER_SPRITE_SHEET,
+        Textures::ID::BALL_NORMAL};
+
+    const std::size_t packed = atlas->build(*getContext().getTextureManager(), kAtlasTextures);
+    SDL_Log("LoadingState: packed %zu of %zu textures into %zu atlas pages", packed, kAtlasTextures.size(),
+            atlas->getPageCount());
+}
+
 void LoadingState::loadProceduralTextures() const noexcept
 {
     auto &textures = *getContext().getTextureManager();
 
     try
     {
-        auto generator = [](std::vector<std::uint8_t> &buffer, int width, int height)
+        // Written by a compute shader straight into the texture when it has linked by now, otherwise per
+        // texel on the CPU; the texture is made once, so it is not worth holding the load for the link
+        auto &shaders = *getContext().getShaderManager();
+        Shader *generator = shaders.getLoadState(Shaders::ID::GLSL_PROCEDURAL_COMPUTE) == ShaderManager::LoadState::LOADED
+                                ? &shaders.get(Shaders::ID::GLSL_PROCEDURAL_COMPUTE)
+                                : nullptr;
+        auto noise = std::make_unique<Texture>();
+        if (!ProceduralTexture::load(generator, *noise, 256, 256, ProceduralTexture::Params{}, 2))
         {
-            for (int y = 0; y < height; ++y)
-            {
-                for (int x = 0; x < width; ++x)
-                {
-                    float value = simplex2(static_cast<float>(x) / 64.f, static_cast<float>(y) / 64.f, 4, 0.5f, 2.f);
-                    buffer[y * width + x] = static_cast<Uint8>((value + 1.f) * 127.5f); // Map from [-1,1] to [0,255]
-                }
-            }
-        };
-
-        textures.load(Textures::ID::NOISE2D, 256, 256, generator, 2);
+            throw std::runtime_error("LoadingState: Failed to create noise texture");
+        }
+        textures.insert(Textures::ID::NOISE2D, std::move(noise));
 
         // Seed manager-owned render targets used by GameState.
         // Keep insert-only manager semantics by creating each ID once here,
@@ -1205,7 +1311,15 @@ void LoadingState::loadProceduralTextures() const noexcept
 
         textures.load(Textures::ID::OIT_REVEAL, 1, 1, {}, 0);
         textures.get(Textures::ID::OIT_REVEAL)
-            .loadRenderTarget(1, 1, Texture::RenderTargetFormat::R16F, 0);
+            .loadRenderTarget(1, 1, Texture::RenderTargetFormat::R8, 0);
+
+        textures.load(Textures::ID::SCENE_DEPTH, 1, 1, {}, 0);
+        textures.get(Textures::ID::SCENE_DEPTH)
+            .loadRenderTarget(1, 1, Texture::RenderTargetFormat::DEPTH24_STENCIL8, 0);
+
+        textures.load(Textures::ID::OIT_DEPTH, 1, 1, {}, 0);
+        textures.get(Textures::ID::OIT_DEPTH)
+            .loadRenderTarget(1, 1, Texture::RenderTargetFormat::DEPTH24_STENCIL8, 0);
 
         textures.load(Textures::ID::SHADOW_MAP, 1, 1, {}, 0);
         textures.get(Textures::ID::SHADOW_MAP)
@@ -1215,16 +1329,12 @@ void LoadingState::loadProceduralTextures() const noexcept
         textures.get(Textures::ID::REFLECTION_COLOR)
             .loadRenderTarget(1, 1, Texture::RenderTargetFormat::RGBA16F, 0);
 
-        textures.load(Textures::ID::RUNNER_BREAK_PLANE, 1, 1, {}, 0);
-        textures.get(Textures::ID::RUNNER_BREAK_PLANE)
-            .loadRenderTarget(1, 1, Texture::RenderTargetFormat::RGBA16F, 0);
-
-        textures.load(Textures::ID::MOTION_BLUR_COLOR, 1, 1, {}, 0);
-        textures.get(Textures::ID::MOTION_BLUR_COLOR)
+        textures.load(Textures::ID::SKY_CACHE, 1, 1, {}, 0);
+        textures.get(Textures::ID::SKY_CACHE)
             .loadRenderTarget(1, 1, Texture::RenderTargetFormat::RGBA16F, 0);
 
-        textures.load(Textures::ID::PREV_FRAME, 1, 1, {}, 0);
-        textures.get(Textures::ID::PREV_FRAME)
+        textures.load(Textures::ID::RUNNER_BREAK_PLANE, 1, 1, {}, 0);
+        textures.get(Textures::ID::RUNNER_BREAK_PLANE)
             .loadRenderTarget(1, 1, Texture::RenderTargetFormat::RGBA16F, 0);
     }
     catch (const std::exception &e)
@@ -1,13 +1,21 @@
 #ifndef LOADING_STATE_HPP
 #define LOADING_STATE_HPP
 
+#include <chrono>
+#include <cstddef>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include "State.hpp"
 
+class GLTFModel;
+class LoadGraph;
+class Shader;
 class StateStack;
+class TextureUploadQueue;
 union SDL_Event;
 namespace Textures
 {
@@ -28,20 +36,30 @@ public:
     bool isFinished() const noexcept;
 
 private:
+    /// Build the task graph that update() pumps: worker tasks for file I/O, decoding and generation,
+    /// GL-thread tasks for everything that touches the context
     void loadResources() noexcept;
 
-    void loadTexturesFromWorkerRequests() const noexcept;
+    /// Queue every worker-collected texture file on mTextureUploads
+    void submitTexturesFromWorkerRequests() noexcept;
 
-    void loadWindowIcon(const std::unordered_map<std::string, std::string> &resources) const noexcept;
-    void loadCursor(const std::unordered_map<std::string, std::string> &resources) noexcept;
+    void loadWindowIcon(const ResourceConfig &config) const noexcept;
+    void loadCursor(const ResourceConfig &config) noexcept;
 
     void loadProceduralTextures() const noexcept;
+    /// Pack the UI images and sprite sheets into the shared TextureAtlas
+    void buildTextureAtlas() const noexcept;
 
     void loadAudio() noexcept;
     void loadFonts() noexcept;
     void loadLevels() noexcept;
-    void loadModels() noexcept;
+    /// Read the model cache or run the Assimp import; worker thread
+    void importModel() noexcept;
+    /// Upload and bake the imported model, then hand it to the models manager; GL thread
+    void uploadModel() noexcept;
     void loadShaders() noexcept;
+    /// Finish every submitted program whose link is done; with block, finish the rest too
+    void pollShaderLinks(bool block) noexcept;
     void loadVAOs() noexcept;
     void loadFBOs() noexcept;
     void loadVBOs() noexcept;
@@ -49,9 +67,35 @@ private:
 
     void setCompletion(float percent) noexcept;
 
+    struct PendingShader
+    {
+        Shader *shader;
+        const char *name;
+    };
+
+    /// GL upload time per frame; decoded images past it wait for the next frame
+    static constexpr std::chrono::microseconds TEXTURE_UPLOAD_BUDGET{4000};
+    /// GL-thread loading time per frame across all main tasks, so the progress display keeps drawing
+    static constexpr std::chrono::microseconds LOAD_SLICE_BUDGET{8000};
+    /// Resident bytes of textures loaded on first use before idle ones are evicted
+    static constexpr std::size_t LAZY_TEXTURE_BUDGET = 64u * 1024u * 1024u;
+
     bool mHasFinished;
+    bool mHasResources;
+    std::unique_ptr<TextureUploadQueue> mTextureUploads;
+
+    // Owned by the shader manager; linked in the background until pollShaderLinks() finishes them
+    std::vector<PendingShader> mPendingShaders;
+    std::size_t mSubmittedShaderCount;
+
+    // Written by the model import task, consumed by the upload task that depends on it
+    std::string mModelPath;
+    std::unique_ptr<GLTFModel> mImportedModel;
 
     const std::string mResourcePath;
+
+    // Declared last so it is destroyed first, waiting for worker tasks that use the members above
+    std::unique_ptr<LoadGraph> mGraph;
 };
 
 #endif // LOADING_STATE_HPP
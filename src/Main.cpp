@@ -6,10 +6,16 @@
 
 #include <exception>
 #include <iostream>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "buildinfo.h"
+#include "FlyThroughBenchmark.hpp"
+#include "InputRecorder.hpp"
 #include "PhysicsGame.hpp"
+#include "StartupTimeline.hpp"
 
 #include <MazeBuilder/maze_builder.h>
 
@@ -22,9 +28,106 @@ int main(int argc, char *argv[])
 {
     std::string configPath{};
 
-    if (argc != 2)
+    if (argc < 2 || argc > 4)
     {
-        std::cerr << "Usage: " << argv[0] << " <path_to_config.json>" << std::endl;
+        std::cerr << "Usage: " << argv[0] << " <path_to_config.json> [" << StartupTimeline::FLAG << "[=report.json]]"
+                  << " [" << FlyThroughBenchmark::FLAG << "[=report] [" << FlyThroughBenchmark::SCALES_FLAG << "=1,0.75]]"
+                  << " [" << InputRecorder::RECORD_FLAG << "[=file] | " << InputRecorder::REPLAY_FLAG << "[=file]]" << std::endl;
+
+        return EXIT_FAILURE;
+    }
+
+    // "--flag" or "--flag=value"; nullopt when arg is a different option
+    const auto optionValue = [](std::string_view arg, std::string_view flag, std::string_view fallback) -> std::optional<std::string>
+    {
+        if (arg == flag)
+        {
+            return std::string{fallback};
+        }
+        if (arg.size() > flag.size() + 1 && arg.starts_with(flag) && arg[flag.size()] == '=')
+        {
+            return std::string{arg.substr(flag.size() + 1)};
+        }
+        return std::nullopt;
+    };
+
+    std::optional<std::string> startupReport;
+    std::optional<std::string> flyThroughReport;
+    std::vector<float> renderScales;
+    std::optional<std::string> recordPath;
+    std::optional<std::string> replayPath;
+    for (int i = 2; i < argc; ++i)
+    {
+        const std::string_view arg{argv[i]};
+        if (auto report = optionValue(arg, StartupTimeline::FLAG, StartupTimeline::DEFAULT_REPORT))
+        {
+            startupReport = std::move(report);
+        }
+        else if (auto report = optionValue(arg, FlyThroughBenchmark::FLAG, FlyThroughBenchmark::DEFAULT_REPORT))
+        {
+            flyThroughReport = std::move(report);
+        }
+        else if (auto path = optionValue(arg, InputRecorder::RECORD_FLAG, InputRecorder::DEFAULT_FILE))
+        {
+            recordPath = std::move(path);
+        }
+        else if (auto path = optionValue(arg, InputRecorder::REPLAY_FLAG, InputRecorder::DEFAULT_FILE))
+        {
+            replayPath = std::move(path);
+        }
+        else if (auto scales = optionValue(arg, FlyThroughBenchmark::SCALES_FLAG, ""))
+        {
+            renderScales = FlyThroughBenchmark::parseScales(*scales);
+            if (renderScales.empty())
+            {
+                std::cerr << "Error: Render scales must be positive numbers separated by commas" << std::endl;
+
+                return EXIT_FAILURE;
+            }
+        }
+        else
+        {
+            std::cerr << "Error: Unknown option " << arg << std::endl;
+
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (startupReport && flyThroughReport)
+    {
+        std::cerr << "Error: Run one benchmark at a time" << std::endl;
+
+        return EXIT_FAILURE;
+    }
+
+    // Benchmarks drive the game themselves, so there is no input to record or replay
+    if ((recordPath || replayPath) && (startupReport || flyThroughReport || (recordPath && replayPath)))
+    {
+        std::cerr << "Error: Input recording and replay run alone, without a benchmark" << std::endl;
+
+        return EXIT_FAILURE;
+    }
+
+    const bool startupBenchmark = startupReport.has_value();
+    if (startupBenchmark)
+    {
+        StartupTimeline::start(std::move(*startupReport));
+    }
+
+    const bool flyThroughBenchmark = flyThroughReport.has_value();
+    if (flyThroughBenchmark)
+    {
+        FlyThroughBenchmark::start(std::move(*flyThroughReport), std::move(renderScales));
+    }
+
+    const bool inputRecording = recordPath || replayPath;
+    if (recordPath)
+    {
+        InputRecorder::startRecording(std::move(*recordPath));
+    }
+    else if (replayPath && !InputRecorder::startReplay(std::move(*replayPath)))
+    {
+        std::cerr << "Error: Cannot replay the input recording" << std::endl;
 
         return EXIT_FAILURE;
     }
@@ -52,5 +155,21 @@ int main(int argc, char *argv[])
         std::cerr << ex.what() << std::endl;
     }
 
+    // A run that never reached the first game frame fails, so a CI step can gate on the exit code
+    if (startupBenchmark && !StartupTimeline::finish())
+    {
+        return EXIT_FAILURE;
+    }
+    // Likewise for a fly-through closed before every scale was flown
+    if (flyThroughBenchmark && !FlyThroughBenchmark::finish())
+    {
+        return EXIT_FAILURE;
+    }
+    // And for a recording that was never written or a replay cut short
+    if (inputRecording && !InputRecorder::finish())
+    {
+        return EXIT_FAILURE;
+    }
+
     return EXIT_SUCCESS;
 }
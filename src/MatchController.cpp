@@ -0,0 +1,127 @@
+#include "MatchController.hpp"
+
+#include "JobSystem.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <thread>
+
+std::size_t BotPopulation::add(const glm::vec3 &position)
+{
+    const auto bot = static_cast<std::uint32_t>(size());
+
+    mPositionX.push_back(position.x);
+    mPositionZ.push_back(position.z);
+    mDesiredLane.push_back(position.z);
+    mLaneSwitchTimer.push_back(0.0f);
+    // Per-bot sway so a crowd does not weave in unison
+    mPhaseOffset.push_back(CounterRng::uniform(mSeed, bot, 0, 0.0f, 6.2831853f));
+    mPhaseBias.push_back(CounterRng::uniform(mSeed, bot, 1, 0.0f, 0.35f));
+    mRngCounter.push_back(2);
+    mTargetZ.push_back(position.z);
+    mForwardScale.push_back(1.0f);
+
+    return bot;
+}
+
+void BotPopulation::clear() noexcept
+{
+    mPositionX.clear();
+    mPositionZ.clear();
+    mDesiredLane.clear();
+    mLaneSwitchTimer.clear();
+    mPhaseOffset.clear();
+    mPhaseBias.clear();
+    mRngCounter.clear();
+    mTargetZ.clear();
+    mForwardScale.clear();
+}
+
+void BotPopulation::sample(const MatchWorldSnapshot &world, float dt, std::size_t begin, std::size_t end) noexcept
+{
+    const float strafeLimit = world.strafeLimit;
+    const float swayAmplitude = 0.06f * strafeLimit;
+
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        const auto stream = static_cast<std::uint32_t>(i);
+        std::uint32_t counter = mRngCounter[i];
+
+        float timer = std::max(0.0f, mLaneSwitchTimer[i] - dt);
+        if (timer <= 0.0f)
+        {
+            mDesiredLane[i] = CounterRng::uniform(mSeed, stream, counter++, -0.85f, 0.85f) * strafeLimit;
+            timer = CounterRng::uniform(mSeed, stream, counter++, 0.65f, 1.65f);
+        }
+        mLaneSwitchTimer[i] = timer;
+
+        const float microSway = std::sin(world.elapsedSeconds * (2.1f + mPhaseBias[i]) + mPhaseOffset[i]) * swayAmplitude;
+        mTargetZ[i] = std::clamp(mDesiredLane[i] + microSway, -strafeLimit, strafeLimit);
+        mForwardScale[i] = std::clamp(1.0f + CounterRng::uniform(mSeed, stream, counter++, -0.08f, 0.08f), 0.82f, 1.14f);
+
+        mRngCounter[i] = counter;
+    }
+}
+
+void BotPopulation::integrate(const MatchWorldSnapshot &world, float dt, std::size_t begin, std::size_t end) noexcept
+{
+    const float strafeLimit = world.strafeLimit;
+    const float maxStrafeStep = world.runnerSpeed * 0.85f * dt;
+
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        mPositionX[i] += world.runnerSpeed * std::clamp(mForwardScale[i], 0.65f, 1.25f) * dt;
+
+        const float dz = std::clamp(mTargetZ[i] - mPositionZ[i], -maxStrafeStep, maxStrafeStep);
+        mPositionZ[i] = std::clamp(mPositionZ[i] + dz, -strafeLimit, strafeLimit);
+    }
+}
+
+void BotPopulation::update(const MatchWorldSnapshot &world, float dt)
+{
+    const std::size_t count = size();
+    if (count <= BATCH_SIZE)
+    {
+        sample(world, dt, 0, count);
+        integrate(world, dt, 0, count);
+        return;
+    }
+
+    // Workers claim batches from a shared counter; the caller claims them too, so a busy pool only
+    // slows this down. A job that starts after the last batch finds none and never touches the bots.
+    struct Batches
+    {
+        std::atomic<std::size_t> next{0};
+        std::atomic<std::size_t> remaining{0};
+    };
+    const std::size_t batchCount = (count + BATCH_SIZE - 1) / BATCH_SIZE;
+    auto batches = std::make_shared<Batches>();
+    batches->remaining.store(batchCount, std::memory_order_relaxed);
+
+    const auto run = [this, batches, batchCount, count, world, dt]()
+    {
+        for (std::size_t batch = batches->next.fetch_add(1, std::memory_order_relaxed); batch < batchCount;
+             batch = batches->next.fetch_add(1, std::memory_order_relaxed))
+        {
+            const std::size_t begin = batch * BATCH_SIZE;
+            const std::size_t end = std::min(count, begin + BATCH_SIZE);
+            sample(world, dt, begin, end);
+            integrate(world, dt, begin, end);
+            batches->remaining.fetch_sub(1, std::memory_order_release);
+        }
+    };
+
+    auto &jobs = *JobSystem::instance();
+    const std::size_t helpers = std::min<std::size_t>(jobs.getWorkerCount(), batchCount - 1);
+    for (std::size_t i = 0; i < helpers; ++i)
+    {
+        jobs.schedule(run);
+    }
+
+    run();
+    while (batches->remaining.load(std::memory_order_acquire) > 0)
+    {
+        std::this_thread::yield();
+    }
+}
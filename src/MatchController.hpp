@@ -4,8 +4,10 @@
 #include <glm/glm.hpp>
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <random>
+#include <vector>
 
 struct MatchWorldSnapshot
 {
@@ -74,4 +76,75 @@ private:
     float mPhaseBias{0.17f};
 };
 
+/// @brief Stateless random numbers: a SplitMix64 hash of (seed, stream, counter)
+/// @details A stream needs nothing but a counter, so a bot's RNG is 4 bytes instead of a 5 KB
+/// std::mt19937, and any bot can be sampled on any thread without sharing state.
+struct CounterRng
+{
+    [[nodiscard]] static std::uint64_t hash(std::uint64_t seed, std::uint32_t stream, std::uint32_t counter) noexcept
+    {
+        std::uint64_t x = seed ^ ((static_cast<std::uint64_t>(stream) << 32) | counter);
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    /// Uniform in [lo, hi) from the top 24 bits of the hash
+    [[nodiscard]] static float uniform(std::uint64_t seed, std::uint32_t stream, std::uint32_t counter,
+                                       float lo, float hi) noexcept
+    {
+        const auto bits = static_cast<std::uint32_t>(hash(seed, stream, counter) >> 40);
+        return lo + (hi - lo) * (static_cast<float>(bits) * (1.0f / 16777216.0f));
+    }
+};
+
+/// @brief LaneAIController for a whole crowd, stored as structure-of-arrays
+/// @details Each field is one contiguous array indexed by bot, and sample() runs the lane logic over
+/// a range of bots with no virtual calls or allocation. update() samples and moves every bot, split
+/// into BATCH_SIZE ranges across the JobSystem once the crowd is large enough to pay for it.
+class BotPopulation
+{
+public:
+    /// Bots per job; a population this size or smaller runs on the calling thread
+    static constexpr std::size_t BATCH_SIZE = 64;
+    static constexpr float BOT_HEIGHT = 1.0f;
+
+    explicit BotPopulation(std::uint64_t seed = 1337u) noexcept : mSeed{seed} {}
+
+    /// @return Index of the new bot
+    std::size_t add(const glm::vec3 &position);
+    void clear() noexcept;
+
+    [[nodiscard]] std::size_t size() const noexcept { return mPositionX.size(); }
+    [[nodiscard]] bool empty() const noexcept { return mPositionX.empty(); }
+    [[nodiscard]] glm::vec3 getPosition(std::size_t bot) const noexcept
+    {
+        return {mPositionX[bot], BOT_HEIGHT, mPositionZ[bot]};
+    }
+
+    /// @brief Fill the command arrays for bots [begin, end)
+    void sample(const MatchWorldSnapshot &world, float dt, std::size_t begin, std::size_t end) noexcept;
+    /// @brief Move bots [begin, end) by their sampled commands
+    void integrate(const MatchWorldSnapshot &world, float dt, std::size_t begin, std::size_t end) noexcept;
+
+    /// @brief Sample and integrate every bot, in parallel batches when there are enough of them
+    void update(const MatchWorldSnapshot &world, float dt);
+
+private:
+    std::uint64_t mSeed;
+
+    std::vector<float> mPositionX;
+    std::vector<float> mPositionZ;
+    std::vector<float> mDesiredLane;
+    std::vector<float> mLaneSwitchTimer;
+    std::vector<float> mPhaseOffset;
+    std::vector<float> mPhaseBias;
+    std::vector<std::uint32_t> mRngCounter;
+
+    // Sampled commands, as PlayerCommand fields
+    std::vector<float> mTargetZ;
+    std::vector<float> mForwardScale;
+};
+
 #endif // MATCH_CONTROLLER_HPP
@@ -0,0 +1,167 @@
+#include "MemoryStats.hpp"
+
+#include "buildinfo.h"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <fstream>
+#include <utility>
+
+std::array<MemoryStats::Counter, MemoryStats::CATEGORY_COUNT> MemoryStats::sCounters{};
+
+namespace
+{
+    double toMegabytes(std::size_t bytes) noexcept
+    {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    }
+}
+
+MemoryStats::Allocation::Allocation(Allocation &&other) noexcept
+    : mCategory{other.mCategory}, mBytes{std::exchange(other.mBytes, 0)}
+{
+}
+
+MemoryStats::Allocation &MemoryStats::Allocation::operator=(Allocation &&other) noexcept
+{
+    if (this != &other)
+    {
+        set(0);
+        mCategory = other.mCategory;
+        mBytes = std::exchange(other.mBytes, 0);
+    }
+    return *this;
+}
+
+void MemoryStats::Allocation::set(std::size_t bytes) noexcept
+{
+    if (bytes != mBytes)
+    {
+        apply(mCategory, mBytes, bytes);
+        mBytes = bytes;
+    }
+}
+
+void MemoryStats::Allocation::set(Category category, std::size_t bytes) noexcept
+{
+    if (category != mCategory)
+    {
+        set(0);
+        mCategory = category;
+    }
+    set(bytes);
+}
+
+void MemoryStats::apply(Category category, std::size_t previous, std::size_t current) noexcept
+{
+    Counter &counter = sCounters[static_cast<std::size_t>(category)];
+    const auto delta = static_cast<std::int64_t>(current) - static_cast<std::int64_t>(previous);
+    const std::int64_t total = counter.bytes.fetch_add(delta, std::memory_order_relaxed) + delta;
+
+    if (previous == 0 && current != 0)
+    {
+        counter.live.fetch_add(1, std::memory_order_relaxed);
+    }
+    else if (previous != 0 && current == 0)
+    {
+        counter.live.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    std::int64_t highWater = counter.highWater.load(std::memory_order_relaxed);
+    while (total > highWater && !counter.highWater.compare_exchange_weak(highWater, total, std::memory_order_relaxed))
+    {
+    }
+}
+
+MemoryStats::Totals MemoryStats::getTotals(Category category) noexcept
+{
+    const Counter &counter = sCounters[static_cast<std::size_t>(category)];
+    Totals totals;
+    totals.bytes = static_cast<std::size_t>(std::max<std::int64_t>(0, counter.bytes.load(std::memory_order_relaxed)));
+    totals.highWaterBytes = static_cast<std::size_t>(counter.highWater.load(std::memory_order_relaxed));
+    totals.liveAllocations = static_cast<std::size_t>(std::max<std::int64_t>(0, counter.live.load(std::memory_order_relaxed)));
+    return totals;
+}
+
+const char *MemoryStats::getName(Category category) noexcept
+{
+    switch (category)
+    {
+    case Category::GPU_TEXTURES:
+        return "Textures";
+    case Category::GPU_RENDER_TARGETS:
+        return "Render targets";
+    case Category::GPU_VERTEX_BUFFERS:
+        return "Vertex buffers";
+    case Category::GPU_STORAGE_BUFFERS:
+        return "Storage buffers";
+    case Category::CPU_WORLD_SPHERES:
+        return "World spheres";
+    case Category::CPU_WORLD_BODIES:
+        return "World bodies";
+    case Category::CPU_CHUNK_MAZES:
+        return "Chunk mazes";
+    case Category::CPU_PICKUPS:
+        return "Pickups";
+    case Category::CPU_MODEL_MESHES:
+        return "Model meshes";
+    case Category::CPU_MODEL_ANIMATION:
+        return "Model animation";
+    case Category::CPU_AUDIO:
+        return "Audio";
+    default:
+        return "?";
+    }
+}
+
+bool MemoryStats::isGpu(Category category) noexcept
+{
+    return category <= Category::GPU_STORAGE_BUFFERS;
+}
+
+std::size_t MemoryStats::getTotalBytes(bool gpu) noexcept
+{
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < CATEGORY_COUNT; ++i)
+    {
+        const auto category = static_cast<Category>(i);
+        if (isGpu(category) == gpu)
+        {
+            total += getTotals(category).bytes;
+        }
+    }
+    return total;
+}
+
+bool MemoryStats::dump(const std::string &path) noexcept
+{
+    std::ofstream out(path, std::ios::trunc);
+    if (!out)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "MemoryStats: cannot write %s", path.c_str());
+        return false;
+    }
+
+    out << "{\n";
+    out << "  \"version\": \"" << bw::buildinfo::Version << "\",\n";
+    out << "  \"gpuBytes\": " << getTotalBytes(true) << ",\n";
+    out << "  \"cpuBytes\": " << getTotalBytes(false) << ",\n";
+    out << "  \"categories\": [\n";
+    for (std::size_t i = 0; i < CATEGORY_COUNT; ++i)
+    {
+        const auto category = static_cast<Category>(i);
+        const Totals totals = getTotals(category);
+        out << "    {\"name\": \"" << getName(category) << "\", \"gpu\": " << (isGpu(category) ? "true" : "false")
+            << ", \"bytes\": " << totals.bytes << ", \"highWaterBytes\": " << totals.highWaterBytes
+            << ", \"allocations\": " << totals.liveAllocations << "}" << (i + 1 < CATEGORY_COUNT ? ",\n" : "\n");
+
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MemoryStats: %-16s %9.2f MB (peak %9.2f MB, %zu allocations)",
+                    getName(category), toMegabytes(totals.bytes), toMegabytes(totals.highWaterBytes), totals.liveAllocations);
+    }
+    out << "  ]\n}\n";
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MemoryStats: GPU %.2f MB, CPU %.2f MB, dump in %s",
+                toMegabytes(getTotalBytes(true)), toMegabytes(getTotalBytes(false)), path.c_str());
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,99 @@
+#ifndef MEMORY_STATS_HPP
+#define MEMORY_STATS_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// @brief Live and high-water byte counts per subsystem, for both GPU objects and CPU data
+/// @details Owners hold an Allocation per resource and set() it whenever the backing size changes;
+/// the category totals are the sum of every live Allocation. Totals are atomics, so owners on the
+/// simulation thread or job workers report without locking. Counts are the sizes the owner asked for
+/// (texel and buffer bytes, container capacities), not driver or allocator overhead.
+///
+/// Shown in the debug overlay; F8 writes a JSON dump next to the other per-user data.
+class MemoryStats
+{
+public:
+    enum class Category : std::uint8_t
+    {
+        GPU_TEXTURES,
+        GPU_RENDER_TARGETS,
+        GPU_VERTEX_BUFFERS,
+        GPU_STORAGE_BUFFERS,
+        CPU_WORLD_SPHERES,
+        CPU_WORLD_BODIES,
+        CPU_CHUNK_MAZES,
+        CPU_PICKUPS,
+        CPU_MODEL_MESHES,
+        CPU_MODEL_ANIMATION,
+        CPU_AUDIO,
+        COUNT
+    };
+
+    static constexpr std::size_t CATEGORY_COUNT = static_cast<std::size_t>(Category::COUNT);
+
+    struct Totals
+    {
+        std::size_t bytes{0};
+        std::size_t highWaterBytes{0};
+        /// Allocations currently holding a non-zero size
+        std::size_t liveAllocations{0};
+    };
+
+    /// One tracked resource; its bytes count towards the category until reset or destroyed
+    class Allocation
+    {
+    public:
+        explicit Allocation(Category category) noexcept
+            : mCategory{category}
+        {
+        }
+
+        ~Allocation() noexcept { set(0); }
+
+        Allocation(const Allocation &) = delete;
+        Allocation &operator=(const Allocation &) = delete;
+
+        /// Ownership moves with the GL name or container it tracks
+        Allocation(Allocation &&other) noexcept;
+        Allocation &operator=(Allocation &&other) noexcept;
+
+        /// Replace the tracked size
+        void set(std::size_t bytes) noexcept;
+        /// Replace the tracked size and move it to another category
+        void set(Category category, std::size_t bytes) noexcept;
+        [[nodiscard]] std::size_t getBytes() const noexcept { return mBytes; }
+
+    private:
+        Category mCategory;
+        std::size_t mBytes{0};
+    };
+
+    [[nodiscard]] static Totals getTotals(Category category) noexcept;
+    [[nodiscard]] static const char *getName(Category category) noexcept;
+    [[nodiscard]] static bool isGpu(Category category) noexcept;
+
+    /// Sum of the GPU (or CPU) categories
+    [[nodiscard]] static std::size_t getTotalBytes(bool gpu) noexcept;
+
+    /// @brief Write every category with its high-water mark as JSON and log a summary
+    /// @return true when the file was written
+    static bool dump(const std::string &path) noexcept;
+
+private:
+    struct Counter
+    {
+        std::atomic<std::int64_t> bytes{0};
+        std::atomic<std::int64_t> highWater{0};
+        std::atomic<std::int64_t> live{0};
+    };
+
+    static void apply(Category category, std::size_t previous, std::size_t current) noexcept;
+
+    static std::array<Counter, CATEGORY_COUNT> sCounters;
+};
+
+#endif // MEMORY_STATS_HPP
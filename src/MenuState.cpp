@@ -9,22 +9,41 @@
 #include <cstdint>
 #include <cmath>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <dearimgui/imgui.h>
 
 #include <glm/gtc/matrix_transform.hpp>
 
+#include "FlyThroughBenchmark.hpp"
 #include "Font.hpp"
+#include "FramePacer.hpp"
 #include "GameState.hpp"
+#include "GLSDLHelper.hpp"
+#include "GLStateCache.hpp"
+#include "InputRecorder.hpp"
 #include "MusicPlayer.hpp"
 #include "Options.hpp"
 #include "Player.hpp"
+#include "RenderStats.hpp"
 #include "ResourceIdentifiers.hpp"
 #include "ResourceManager.hpp"
 #include "Shader.hpp"
 #include "SoundPlayer.hpp"
+#include "StartupTimeline.hpp"
 #include "StateStack.hpp"
+#include "Telemetry.hpp"
+
+namespace
+{
+    constexpr std::string_view kMenuFirstFrame = "MenuState first frame";
+
+    /// The preview is a backdrop behind ImGui panels; 30 Hz reads as smooth and halves its GPU cost at 60 Hz
+    constexpr std::uint64_t kParticleSceneIntervalNs = 1'000'000'000ull / 30ull;
+    /// Largest simulation step, so a redraw after a stall does not fling particles away
+    constexpr float kParticleSceneMaxStep = 0.05f;
+} // namespace
 
 MenuState::MenuState(StateStack &stack, Context context)
     : State(stack, context),
@@ -64,6 +83,18 @@ MenuState::MenuState(StateStack &stack, Context context)
     // initialize selection flags so UI shows correct selected item
     mItemSelectedFlags.fill(false);
     mItemSelectedFlags[static_cast<size_t>(mSelectedMenuItem)] = true;
+
+    // New game is the default selection, so get its maze generating while the menu is up
+    stack.prewarmState(States::ID::GAME);
+    // and its music buffered, so starting the game crossfades without a gap
+    try
+    {
+        context.getMusicManager()->get(Music::ID::GAME_MUSIC).prefetch();
+    }
+    catch (const std::exception &e)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "MenuState: Failed to prefetch game music: %s", e.what());
+    }
 }
 
 MenuState::~MenuState()
@@ -77,6 +108,7 @@ MenuState::~MenuState()
 
 void MenuState::draw() const noexcept
 {
+    StartupTimeline::mark(kMenuFirstFrame);
     initializeParticleScene();
 
     if (!mShowMainMenu)
@@ -155,8 +187,16 @@ void MenuState::draw() const noexcept
                 drawWidth = std::max(1.0f, drawWidth);
                 drawHeight = std::max(1.0f, drawHeight);
 
-                ensureParticleRenderTarget(static_cast<int>(drawWidth), static_cast<int>(drawHeight));
-                renderParticleScene();
+                // Redraw at a capped rate while the window has focus; a new target is filled even when paused
+                const bool targetRecreated =
+                    ensureParticleRenderTarget(static_cast<int>(drawWidth), static_cast<int>(drawHeight));
+                const std::uint64_t nowNs = SDL_GetTicksNS();
+                const bool due = mParticleSceneActive && nowNs - mParticleLastRenderNs >= kParticleSceneIntervalNs;
+                if (due || targetRecreated)
+                {
+                    renderParticleScene(due);
+                    mParticleLastRenderNs = nowNs;
+                }
 
                 if (mParticlesRenderTexture != 0 && imageSize.x > 1.0f && imageSize.y > 1.0f)
                 {
@@ -184,25 +224,40 @@ void MenuState::draw() const noexcept
     }
 }
 
-bool MenuState::update(float dt, unsigned int subSteps) noexcept
+std::uint32_t MenuState::getIdleTimeoutMs() const noexcept
 {
-    // Periodic music health check
-    static float musicCheckTimer = 0.0f;
-    musicCheckTimer += dt;
-
-    if (musicCheckTimer >= 5.0f) // Check every 5 seconds
+    // A closed menu is on its way to a menu action that update() has to carry out
+    if (!mShowMainMenu || mPendingMenuAction)
     {
-        musicCheckTimer = 0.0f;
+        return 0;
+    }
 
-        if (mMusic)
+    // The preview shows on every tab but settings, and stops redrawing while the window is unfocused
+    if (mActiveTab != MenuTab::SETTINGS && mParticleSceneActive)
+    {
+        const std::uint64_t sinceNs = SDL_GetTicksNS() - mParticleLastRenderNs;
+        if (sinceNs >= kParticleSceneIntervalNs)
         {
-            if (!mMusic->isPlaying())
-            {
-                SDL_LogWarn(SDL_LOG_CATEGORY_AUDIO,
-                            "MenuState: Music stopped unexpectedly! Attempting restart...");
-                mMusic->play();
-            }
+            return 0;
         }
+        // Rounded up, so the loop never wakes just before the preview is due
+        return static_cast<std::uint32_t>((kParticleSceneIntervalNs - sinceNs + 999'999ull) / 1'000'000ull);
+    }
+
+    return IDLE_REDRAW_MS;
+}
+
+bool MenuState::update(float dt, unsigned int subSteps) noexcept
+{
+    // A startup benchmark picks New Game as soon as the menu has been seen; a fly-through or input replay
+    // does not time the menu
+    const bool benchmarkAdvances = (StartupTimeline::isRunning() && StartupTimeline::reached(kMenuFirstFrame)) ||
+                                   FlyThroughBenchmark::isRunning() || InputRecorder::isReplaying();
+    if (benchmarkAdvances && !mPendingMenuAction)
+    {
+        mConfirmedMenuItem = MenuItem::NEW_GAME;
+        mPendingMenuAction = true;
+        mShowMainMenu = false;
     }
 
     if (mShowMainMenu)
@@ -284,6 +339,26 @@ bool MenuState::handleEvent(const SDL_Event &event) noexcept
         }
     }
 
+    switch (event.type)
+    {
+    case SDL_EVENT_WINDOW_FOCUS_LOST:
+    case SDL_EVENT_WINDOW_MINIMIZED:
+    case SDL_EVENT_WINDOW_OCCLUDED:
+        mParticleSceneActive = false;
+        break;
+    case SDL_EVENT_WINDOW_FOCUS_GAINED:
+    case SDL_EVENT_WINDOW_RESTORED:
+        if (!mParticleSceneActive)
+        {
+            // Resume from where it paused rather than stepping over the time spent away
+            mParticleSceneActive = true;
+            mParticleTime = 0.0f;
+        }
+        break;
+    default:
+        break;
+    }
+
     if (event.type == SDL_EVENT_KEY_DOWN)
     {
         if (event.key.scancode == SDL_SCANCODE_ESCAPE)
@@ -350,11 +425,24 @@ void MenuState::initializeSettingsUiFromOptions() const noexcept
         mSettingsUi.renderQuality = opts.getRenderQuality();
         mSettingsUi.sfxVolume = opts.getSfxVolume();
         mSettingsUi.vsync = opts.getVsync();
+        mSettingsUi.adaptiveVsync = opts.getAdaptiveVsync();
+        mSettingsUi.lowLatency = opts.getLowLatency();
+        mSettingsUi.justInTimeInput = opts.getJustInTimeInput();
+        mSettingsUi.maxFramesInFlight = opts.getMaxFramesInFlight();
         mSettingsUi.fullscreen = opts.getFullscreen();
         mSettingsUi.antialiasing = opts.getAntiAliasing();
+        mSettingsUi.dynamicResolution = opts.getDynamicResolution();
+        mSettingsUi.reflectionScale = opts.getReflectionScale();
+        mSettingsUi.reflectionHalfRate = opts.getReflectionHalfRate();
+        mSettingsUi.oitDownscale = opts.getOITDownscale();
+        mSettingsUi.telemetryEnabled = opts.getTelemetryEnabled();
+        mSettingsUi.telemetryIntervalSeconds = opts.getTelemetryIntervalSeconds();
         mSettingsUi.enableMusic = opts.getEnableMusic();
         mSettingsUi.enableSound = opts.getEnableSound();
         mSettingsUi.showDebugOverlay = opts.getShowDebugOverlay();
+        mSettingsUi.threadedSimulation = opts.getThreadedSimulation();
+        mSettingsUi.rollbackNetcode = opts.getRollbackNetcode();
+        mSettingsUi.interpolationDelay = opts.getInterpolationDelay();
     }
     catch (const std::exception &)
     {
@@ -466,13 +554,51 @@ void MenuState::drawSettingsTab() const noexcept
     ImGui::Separator();
     ImGui::TextUnformatted("Graphics");
     ImGui::Checkbox("VSync", &mSettingsUi.vsync);
+    ImGui::BeginDisabled(!mSettingsUi.vsync);
+    ImGui::Checkbox("Adaptive VSync", &mSettingsUi.adaptiveVsync);
+    ImGui::EndDisabled();
+    ImGui::Checkbox("Low-Latency Mode", &mSettingsUi.lowLatency);
+    ImGui::BeginDisabled(!mSettingsUi.lowLatency);
+    ImGui::SliderInt("Max Frames In Flight", &mSettingsUi.maxFramesInFlight, 1,
+                     static_cast<int>(FramePacer::MAX_FRAMES_IN_FLIGHT));
+    ImGui::Checkbox("Just-In-Time Input", &mSettingsUi.justInTimeInput);
+    ImGui::EndDisabled();
     ImGui::Checkbox("Fullscreen", &mSettingsUi.fullscreen);
     ImGui::Checkbox("Anti-Aliasing", &mSettingsUi.antialiasing);
+    ImGui::Checkbox("Dynamic Resolution", &mSettingsUi.dynamicResolution);
+    ImGui::SliderFloat("Reflection Scale", &mSettingsUi.reflectionScale, 0.0f, 1.0f,
+                       mSettingsUi.reflectionScale > 0.0f ? "%.2fx" : "Off");
+    ImGui::Checkbox("Half-Rate Reflections", &mSettingsUi.reflectionHalfRate);
+    {
+        int oitIndex = mSettingsUi.oitDownscale >= 4 ? 2 : (mSettingsUi.oitDownscale >= 2 ? 1 : 0);
+        if (ImGui::Combo("Transparency Resolution", &oitIndex, "Full\0Half\0Quarter\0"))
+        {
+            mSettingsUi.oitDownscale = 1 << oitIndex;
+        }
+    }
 
     ImGui::Spacing();
     ImGui::Separator();
     ImGui::TextUnformatted("Gameplay");
     ImGui::Checkbox("Show Debug Overlay", &mSettingsUi.showDebugOverlay);
+    // Read when a game starts; recording, replay and rollback keep the simulation on the main thread
+    ImGui::Checkbox("Threaded Simulation", &mSettingsUi.threadedSimulation);
+    // Read when a multiplayer match starts; every peer in the match needs the same setting
+    ImGui::Checkbox("Rollback Netcode", &mSettingsUi.rollbackNetcode);
+
+    ImGui::Spacing();
+    ImGui::Separator();
+    ImGui::TextUnformatted("Privacy");
+    ImGui::Checkbox("Share Performance Telemetry", &mSettingsUi.telemetryEnabled);
+    ImGui::BeginDisabled(!mSettingsUi.telemetryEnabled);
+    ImGui::SliderFloat("Telemetry Interval", &mSettingsUi.telemetryIntervalSeconds, Telemetry::MIN_INTERVAL_SECONDS,
+                       Telemetry::MAX_INTERVAL_SECONDS, "%.0f s");
+    ImGui::EndDisabled();
+
+    ImGui::Spacing();
+    ImGui::Separator();
+    ImGui::TextUnformatted("Network");
+    ImGui::SliderFloat("Interpolation Delay", &mSettingsUi.interpolationDelay, 0.0f, 0.5f, "%.2f s");
 
     ImGui::Spacing();
     ImGui::Separator();
@@ -534,9 +660,31 @@ void MenuState::drawSettingsPreviewPanel() const noexcept
 
     ImGui::Spacing();
     ImGui::Text("Graphics Flags");
-    ImGui::BulletText("VSync: %s", mSettingsUi.vsync ? "ON" : "OFF");
+    ImGui::BulletText("VSync: %s", mSettingsUi.vsync ? (mSettingsUi.adaptiveVsync ? "ADAPTIVE" : "ON") : "OFF");
+    if (mSettingsUi.lowLatency)
+    {
+        ImGui::BulletText("Low Latency: %d frame(s) in flight%s", mSettingsUi.maxFramesInFlight,
+                          mSettingsUi.justInTimeInput ? ", just-in-time input" : "");
+    }
+    else
+    {
+        ImGui::BulletText("Low Latency: OFF");
+    }
     ImGui::BulletText("Fullscreen: %s", mSettingsUi.fullscreen ? "ON" : "OFF");
     ImGui::BulletText("Anti-Aliasing: %s", mSettingsUi.antialiasing ? "ON" : "OFF");
+    ImGui::BulletText("Reflections: %.2fx%s", mSettingsUi.reflectionScale,
+                      mSettingsUi.reflectionHalfRate ? ", half rate" : "");
+    ImGui::BulletText("Transparency: 1/%d resolution", mSettingsUi.oitDownscale);
+    if (mSettingsUi.telemetryEnabled)
+    {
+        ImGui::BulletText("Telemetry: every %.0f s", mSettingsUi.telemetryIntervalSeconds);
+    }
+    else
+    {
+        ImGui::BulletText("Telemetry: OFF");
+    }
+    ImGui::BulletText("Simulation: %s", mSettingsUi.threadedSimulation ? "own thread (next game)" : "main thread");
+    ImGui::BulletText("Netcode: %s", mSettingsUi.rollbackNetcode ? "rollback (next match)" : "interpolation");
 
     ImGui::Spacing();
     ImGui::TextWrapped(
@@ -550,26 +698,52 @@ void MenuState::resetSettingsToDefaults() const noexcept
     mSettingsUi.renderQuality = 1.0f;
     mSettingsUi.sfxVolume = 90.0f;
     mSettingsUi.vsync = true;
+    mSettingsUi.adaptiveVsync = false;
+    mSettingsUi.lowLatency = false;
+    mSettingsUi.justInTimeInput = false;
+    mSettingsUi.maxFramesInFlight = 1;
     mSettingsUi.fullscreen = false;
     mSettingsUi.antialiasing = true;
+    mSettingsUi.dynamicResolution = true;
+    mSettingsUi.reflectionScale = 0.5f;
+    mSettingsUi.reflectionHalfRate = true;
+    mSettingsUi.oitDownscale = 2;
+    mSettingsUi.telemetryEnabled = false;
+    mSettingsUi.telemetryIntervalSeconds = 1.0f;
     mSettingsUi.enableMusic = true;
     mSettingsUi.enableSound = true;
     mSettingsUi.showDebugOverlay = false;
+    mSettingsUi.threadedSimulation = false;
+    mSettingsUi.rollbackNetcode = false;
+    mSettingsUi.interpolationDelay = 0.1f;
 }
 
 void MenuState::applySettingsFromUi() const noexcept
 {
     Options options;
-    options.withAntiAliasing(mSettingsUi.antialiasing)
+    options.withAdaptiveVsync(mSettingsUi.adaptiveVsync)
+        .withAntiAliasing(mSettingsUi.antialiasing)
+        .withDynamicResolution(mSettingsUi.dynamicResolution)
         .withEnableMusic(mSettingsUi.enableMusic)
         .withEnableSound(mSettingsUi.enableSound)
         .withFullscreen(mSettingsUi.fullscreen)
+        .withJustInTimeInput(mSettingsUi.justInTimeInput)
+        .withLowLatency(mSettingsUi.lowLatency)
+        .withReflectionHalfRate(mSettingsUi.reflectionHalfRate)
         .withShowDebugOverlay(mSettingsUi.showDebugOverlay)
+        .withThreadedSimulation(mSettingsUi.threadedSimulation)
+        .withRollbackNetcode(mSettingsUi.rollbackNetcode)
+        .withTelemetryEnabled(mSettingsUi.telemetryEnabled)
         .withVsync(mSettingsUi.vsync)
+        .withInterpolationDelay(mSettingsUi.interpolationDelay)
         .withMasterVolume(mSettingsUi.masterVolume)
         .withMusicVolume(mSettingsUi.musicVolume)
+        .withReflectionScale(mSettingsUi.reflectionScale)
         .withRenderQuality(mSettingsUi.renderQuality)
-        .withSfxVolume(mSettingsUi.sfxVolume);
+        .withSfxVolume(mSettingsUi.sfxVolume)
+        .withTelemetryIntervalSeconds(mSettingsUi.telemetryIntervalSeconds)
+        .withMaxFramesInFlight(mSettingsUi.maxFramesInFlight)
+        .withOITDownscale(mSettingsUi.oitDownscale);
 
     applySettings(options);
 }
@@ -579,7 +753,7 @@ void MenuState::applySettings(const Options &options) const noexcept
     if (auto *window = getContext().getRenderWindow(); window != nullptr)
     {
         window->setFullscreen(options.getFullscreen());
-        window->setVsync(options.getVsync());
+        window->setVsync(options.getVsync(), options.getAdaptiveVsync());
 
         if (SDL_Window *sdlWindow = window->getSDLWindow(); sdlWindow != nullptr)
         {
@@ -599,6 +773,10 @@ void MenuState::applySettings(const Options &options) const noexcept
         }
     }
 
+    FramePacer::configure(FramePacer::Settings{options.getLowLatency(), options.getJustInTimeInput(),
+                                               static_cast<std::uint32_t>(std::max(options.getMaxFramesInFlight(), 1))});
+    Telemetry::configure(Telemetry::Settings{options.getTelemetryEnabled(), options.getTelemetryIntervalSeconds()});
+
     if (auto *sounds = getContext().getSoundPlayer(); sounds != nullptr)
     {
         sounds->setEnabled(options.getEnableSound());
@@ -634,11 +812,24 @@ void MenuState::applySettings(const Options &options) const noexcept
                 .withRenderQuality(options.getRenderQuality())
                 .withSfxVolume(options.getSfxVolume())
                 .withVsync(options.getVsync())
+                .withAdaptiveVsync(options.getAdaptiveVsync())
+                .withLowLatency(options.getLowLatency())
+                .withJustInTimeInput(options.getJustInTimeInput())
+                .withMaxFramesInFlight(options.getMaxFramesInFlight())
                 .withFullscreen(options.getFullscreen())
                 .withAntiAliasing(options.getAntiAliasing())
+                .withDynamicResolution(options.getDynamicResolution())
+                .withReflectionScale(options.getReflectionScale())
+                .withReflectionHalfRate(options.getReflectionHalfRate())
+                .withOITDownscale(options.getOITDownscale())
+                .withTelemetryEnabled(options.getTelemetryEnabled())
+                .withTelemetryIntervalSeconds(options.getTelemetryIntervalSeconds())
                 .withEnableMusic(options.getEnableMusic())
                 .withEnableSound(options.getEnableSound())
-                .withShowDebugOverlay(options.getShowDebugOverlay());
+                .withShowDebugOverlay(options.getShowDebugOverlay())
+                .withThreadedSimulation(options.getThreadedSimulation())
+                .withRollbackNetcode(options.getRollbackNetcode())
+                .withInterpolationDelay(options.getInterpolationDelay());
         }
         catch (const std::exception &)
         {
@@ -688,77 +879,37 @@ void MenuState::initializeParticleScene() const noexcept
         return;
     }
 
-    std::vector<GLfloat> initPos;
-    initPos.reserve(static_cast<size_t>(mTotalParticles) * 4u);
-    std::vector<GLfloat> initVel(static_cast<size_t>(mTotalParticles) * 4u, 0.0f);
-
-    const GLfloat dx = 2.0f / static_cast<GLfloat>(mParticleGrid.x - 1);
-    const GLfloat dy = 2.0f / static_cast<GLfloat>(mParticleGrid.y - 1);
-    const GLfloat dz = 2.0f / static_cast<GLfloat>(mParticleGrid.z - 1);
-    const glm::mat4 centerTransform = glm::translate(glm::mat4(1.0f), glm::vec3(-1.0f, -1.0f, -1.0f));
-
-    for (int i = 0; i < mParticleGrid.x; ++i)
+    if (!mParticles.init(*mParticlesComputeShader, *mParticlesRenderShader, mTotalParticles))
     {
-        for (int j = 0; j < mParticleGrid.y; ++j)
-        {
-            for (int k = 0; k < mParticleGrid.z; ++k)
-            {
-                glm::vec4 p(dx * static_cast<GLfloat>(i),
-                            dy * static_cast<GLfloat>(j),
-                            dz * static_cast<GLfloat>(k),
-                            1.0f);
-                p = centerTransform * p;
-                initPos.push_back(p.x);
-                initPos.push_back(p.y);
-                initPos.push_back(p.z);
-                initPos.push_back(p.w);
-            }
-        }
+        SDL_LogError(SDL_LOG_CATEGORY_RENDER, "MenuState: Failed to create the particle pool");
+        return;
     }
-
-    const GLsizeiptr bufferSize = static_cast<GLsizeiptr>(static_cast<size_t>(mTotalParticles) * 4u * sizeof(GLfloat));
-
-    glGenBuffers(1, &mParticlesPosSSBO);
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mParticlesPosSSBO);
-    glBufferData(GL_SHADER_STORAGE_BUFFER, bufferSize, initPos.data(), GL_DYNAMIC_DRAW);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, mParticlesPosSSBO);
-
-    glGenBuffers(1, &mParticlesVelSSBO);
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mParticlesVelSSBO);
-    glBufferData(GL_SHADER_STORAGE_BUFFER, bufferSize, initVel.data(), GL_DYNAMIC_COPY);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, mParticlesVelSSBO);
-
-    glGenVertexArrays(1, &mParticlesVAO);
-    glBindVertexArray(mParticlesVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, mParticlesPosSSBO);
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
-    glEnableVertexAttribArray(0);
-    glBindVertexArray(0);
+    seedParticleGrid();
 
     glGenBuffers(1, &mParticlesAttractorVBO);
     glBindBuffer(GL_ARRAY_BUFFER, mParticlesAttractorVBO);
     const GLfloat attractorData[] = {
         mBlackHoleBase1.x, mBlackHoleBase1.y, mBlackHoleBase1.z, mBlackHoleBase1.w,
         mBlackHoleBase2.x, mBlackHoleBase2.y, mBlackHoleBase2.z, mBlackHoleBase2.w};
-    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(sizeof(attractorData)), attractorData, GL_DYNAMIC_DRAW);
+    RenderStats::bufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(sizeof(attractorData)), attractorData, GL_DYNAMIC_DRAW);
 
     glGenVertexArrays(1, &mParticlesAttractorVAO);
-    glBindVertexArray(mParticlesAttractorVAO);
+    GLStateCache::bindVertexArray(mParticlesAttractorVAO);
     glBindBuffer(GL_ARRAY_BUFFER, mParticlesAttractorVBO);
     glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
     glEnableVertexAttribArray(0);
-    glBindVertexArray(0);
+    GLStateCache::bindVertexArray(0);
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLStateCache::enable(GL_BLEND);
+    GLStateCache::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     mParticlesInitialized = true;
 }
 
-void MenuState::renderParticleScene() const noexcept
+void MenuState::renderParticleScene(bool simulate) const noexcept
 {
     if (!mParticlesInitialized || !mParticlesComputeShader || !mParticlesRenderShader || mTotalParticles == 0 ||
         mParticlesRenderFBO == 0 || mParticlesRenderTexture == 0 || mParticleRenderWidth <= 0 || mParticleRenderHeight <= 0)
@@ -772,44 +923,42 @@ void MenuState::renderParticleScene() const noexcept
     }
 
     const float now = static_cast<float>(SDL_GetTicks()) * 0.001f;
-    mParticleDeltaT = (mParticleTime == 0.0f) ? 0.0f : std::min(0.033f, now - mParticleTime);
-    mParticleTime = now;
-    mParticleResetAccumulator += mParticleDeltaT;
-
-    if (mParticleResetAccumulator >= mParticleResetIntervalSeconds)
+    if (simulate)
     {
-        resetParticleSimulation();
-        mParticleResetAccumulator = 0.0f;
-    }
+        mParticleDeltaT = (mParticleTime == 0.0f) ? 0.0f : std::min(kParticleSceneMaxStep, now - mParticleTime);
+        mParticleTime = now;
+        mParticleResetAccumulator += mParticleDeltaT;
 
-    mParticleAngle += mParticleSpeed * mParticleDeltaT;
-    if (mParticleAngle > 360.0f)
-    {
-        mParticleAngle -= 360.0f;
+        if (mParticleResetAccumulator >= mParticleResetIntervalSeconds)
+        {
+            resetParticleSimulation();
+            mParticleResetAccumulator = 0.0f;
+        }
+
+        mParticleAngle += mParticleSpeed * mParticleDeltaT;
+        if (mParticleAngle > 360.0f)
+        {
+            mParticleAngle -= 360.0f;
+        }
     }
 
     const glm::mat4 rotation = glm::rotate(glm::mat4(1.0f), glm::radians(mParticleAngle), glm::vec3(0.0f, 0.0f, 1.0f));
     const glm::vec3 attractor1 = glm::vec3(rotation * mBlackHoleBase1);
     const glm::vec3 attractor2 = glm::vec3(rotation * mBlackHoleBase2);
 
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, mParticlesPosSSBO);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, mParticlesVelSSBO);
-
-    mParticlesComputeShader->bind();
-    mParticlesComputeShader->setUniform("BlackHolePos1", attractor1);
-    mParticlesComputeShader->setUniform("BlackHolePos2", attractor2);
-    const float clampedMass = std::max(0.0001f, mParticleMass);
-    mParticlesComputeShader->setUniform("Gravity1", mParticleGravity1);
-    mParticlesComputeShader->setUniform("Gravity2", mParticleGravity2);
-    // mParticlesComputeShader->setUniform("ParticleMass", clampedMass);
-    mParticlesComputeShader->setUniform("ParticleInvMass", 1.0f / clampedMass);
-    mParticlesComputeShader->setUniform("DeltaT", std::max(0.0001f, mParticleDeltaT * mParticleDtScale));
-    mParticlesComputeShader->setUniform("MaxDist", mParticleMaxDist);
-    mParticlesComputeShader->setUniform("ParticleCount", mTotalParticles);
-
-    const GLuint groupsX = (mTotalParticles + 999u) / 1000u;
-    glDispatchCompute(groupsX, 1, 1);
-    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+    ParticleSystem::Forces forces;
+    forces.attractor1 = attractor1;
+    forces.attractor2 = attractor2;
+    forces.gravity1 = mParticleGravity1;
+    forces.gravity2 = mParticleGravity2;
+    forces.invMass = 1.0f / std::max(0.0001f, mParticleMass);
+    forces.deltaT = std::max(0.0001f, mParticleDeltaT * mParticleDtScale);
+    forces.maxDist = mParticleMaxDist;
+    forces.lifeStep = mParticleDeltaT;
+    if (simulate)
+    {
+        mParticles.update(forces);
+    }
 
     GLint previousFbo = 0;
     GLint previousViewport[4] = {0, 0, 0, 0};
@@ -821,42 +970,40 @@ void MenuState::renderParticleScene() const noexcept
     glClearColor(0.015f, 0.025f, 0.035f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    const glm::mat4 view = glm::lookAt(glm::vec3(2.0f, 0.0f, 20.0f),
+    const glm::vec3 eye(2.0f, 0.0f, 20.0f);
+    const glm::mat4 view = glm::lookAt(eye,
                                        glm::vec3(0.0f, 0.0f, 0.0f),
                                        glm::vec3(0.0f, 1.0f, 0.0f));
-    const glm::mat4 mvp = mParticleProjection * view;
+    GLSDLHelper::updateFrameUniforms(GLSDLHelper::makeFrameUniforms(view, mParticleProjection, eye, now,
+                                                                    mParticleRenderWidth, mParticleRenderHeight));
 
-    mParticlesRenderShader->bind();
-    mParticlesRenderShader->setUniform("MVP", mvp);
+    GLStateCache::enable(GL_DEPTH_TEST);
+    mParticles.draw(glm::vec4(0.92f, 0.98f, 1.0f, 0.16f), mParticlePointSize);
 
-    glEnable(GL_DEPTH_TEST);
-    glPointSize(mParticlePointSize);
-    mParticlesRenderShader->setUniform("Color", glm::vec4(0.92f, 0.98f, 1.0f, 0.16f));
-    glBindVertexArray(mParticlesVAO);
-    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(mTotalParticles));
+    mParticlesRenderShader->bind();
 
     const GLfloat attractorData[] = {
         attractor1.x, attractor1.y, attractor1.z, 1.0f,
         attractor2.x, attractor2.y, attractor2.z, 1.0f};
     glBindBuffer(GL_ARRAY_BUFFER, mParticlesAttractorVBO);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(sizeof(attractorData)), attractorData);
+    RenderStats::bufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(sizeof(attractorData)), attractorData);
 
     glPointSize(mAttractorPointSize);
     mParticlesRenderShader->setUniform("Color", glm::vec4(1.0f, 0.9f, 0.35f, 1.0f));
-    glBindVertexArray(mParticlesAttractorVAO);
-    glDrawArrays(GL_POINTS, 0, 2);
+    GLStateCache::bindVertexArray(mParticlesAttractorVAO);
+    RenderStats::drawArrays(GL_POINTS, 0, 2);
 
-    glUseProgram(0);
-    glBindVertexArray(0);
+    GLStateCache::useProgram(0);
+    GLStateCache::bindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
-    glDisable(GL_DEPTH_TEST);
+    GLStateCache::disable(GL_DEPTH_TEST);
 
     glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFbo));
     glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
 }
 
-void MenuState::ensureParticleRenderTarget(int width, int height) const noexcept
+bool MenuState::ensureParticleRenderTarget(int width, int height) const noexcept
 {
     width = std::max(1, width);
     height = std::max(1, height);
@@ -864,7 +1011,7 @@ void MenuState::ensureParticleRenderTarget(int width, int height) const noexcept
     if (mParticlesRenderFBO != 0 && mParticlesRenderTexture != 0 &&
         mParticleRenderWidth == width && mParticleRenderHeight == height)
     {
-        return;
+        return false;
     }
 
     if (mParticlesRenderDepthRBO != 0)
@@ -874,6 +1021,7 @@ void MenuState::ensureParticleRenderTarget(int width, int height) const noexcept
     }
     if (mParticlesRenderTexture != 0)
     {
+        GLStateCache::forgetTexture(mParticlesRenderTexture);
         glDeleteTextures(1, &mParticlesRenderTexture);
         mParticlesRenderTexture = 0;
     }
@@ -884,7 +1032,7 @@ void MenuState::ensureParticleRenderTarget(int width, int height) const noexcept
     }
 
     glGenTextures(1, &mParticlesRenderTexture);
-    glBindTexture(GL_TEXTURE_2D, mParticlesRenderTexture);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mParticlesRenderTexture);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -907,22 +1055,28 @@ void MenuState::ensureParticleRenderTarget(int width, int height) const noexcept
 
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
     glBindRenderbuffer(GL_RENDERBUFFER, 0);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, 0);
 
     mParticleRenderWidth = width;
     mParticleRenderHeight = height;
     updateParticleProjection();
+    return true;
 }
 
 void MenuState::resetParticleSimulation() const noexcept
 {
-    if (mTotalParticles == 0 || mParticlesPosSSBO == 0 || mParticlesVelSSBO == 0)
+    if (mTotalParticles == 0 || !mParticles.isInitialized())
     {
         return;
     }
 
-    std::vector<GLfloat> resetPositions;
-    resetPositions.reserve(static_cast<size_t>(mTotalParticles) * 4u);
+    seedParticleGrid();
+}
+
+void MenuState::seedParticleGrid() const noexcept
+{
+    std::vector<glm::vec4> positions;
+    positions.reserve(static_cast<size_t>(mTotalParticles));
 
     const GLfloat dx = 2.0f / static_cast<GLfloat>(mParticleGrid.x - 1);
     const GLfloat dy = 2.0f / static_cast<GLfloat>(mParticleGrid.y - 1);
@@ -939,49 +1093,24 @@ void MenuState::resetParticleSimulation() const noexcept
                             dy * static_cast<GLfloat>(j),
                             dz * static_cast<GLfloat>(k),
                             1.0f);
-                p = centerTransform * p;
-                resetPositions.push_back(p.x);
-                resetPositions.push_back(p.y);
-                resetPositions.push_back(p.z);
-                resetPositions.push_back(p.w);
+                positions.push_back(centerTransform * p);
             }
         }
     }
 
-    std::vector<GLfloat> resetVelocities(static_cast<size_t>(mTotalParticles) * 4u, 0.0f);
-    const GLsizeiptr bufferSize = static_cast<GLsizeiptr>(static_cast<size_t>(mTotalParticles) * 4u * sizeof(GLfloat));
-
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mParticlesPosSSBO);
-    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, bufferSize, resetPositions.data());
-
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mParticlesVelSSBO);
-    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, bufferSize, resetVelocities.data());
-
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    // The scene never expires particles; every reset refills the whole pool
+    mParticles.seed(positions);
 }
 
 void MenuState::cleanupParticleScene() noexcept
 {
-    if (mParticlesVAO != 0)
-    {
-        glDeleteVertexArrays(1, &mParticlesVAO);
-        mParticlesVAO = 0;
-    }
     if (mParticlesAttractorVAO != 0)
     {
+        GLStateCache::forgetVertexArray(mParticlesAttractorVAO);
         glDeleteVertexArrays(1, &mParticlesAttractorVAO);
         mParticlesAttractorVAO = 0;
     }
-    if (mParticlesPosSSBO != 0)
-    {
-        glDeleteBuffers(1, &mParticlesPosSSBO);
-        mParticlesPosSSBO = 0;
-    }
-    if (mParticlesVelSSBO != 0)
-    {
-        glDeleteBuffers(1, &mParticlesVelSSBO);
-        mParticlesVelSSBO = 0;
-    }
+    mParticles.destroy();
     if (mParticlesAttractorVBO != 0)
     {
         glDeleteBuffers(1, &mParticlesAttractorVBO);
@@ -994,6 +1123,7 @@ void MenuState::cleanupParticleScene() noexcept
     }
     if (mParticlesRenderTexture != 0)
     {
+        GLStateCache::forgetTexture(mParticlesRenderTexture);
         glDeleteTextures(1, &mParticlesRenderTexture);
         mParticlesRenderTexture = 0;
     }
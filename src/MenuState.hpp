@@ -1,9 +1,11 @@
 #ifndef MENU_STATE_HPP
 #define MENU_STATE_HPP
 
+#include "ParticleSystem.hpp"
 #include "State.hpp"
 
 #include <array>
+#include <cstdint>
 #include <memory>
 
 #include <glad/glad.h>
@@ -24,6 +26,12 @@ public:
     bool update(float dt, unsigned int subSteps) noexcept override;
     bool handleEvent(const SDL_Event &event) noexcept override;
 
+    /// The game underneath stays frozen only while the menu window is open
+    [[nodiscard]] bool blocksUpdates() const noexcept override { return mShowMainMenu; }
+
+    /// Paced by the particle preview while it runs; otherwise the menu only changes on input
+    [[nodiscard]] std::uint32_t getIdleTimeoutMs() const noexcept override;
+
 private:
     enum class MenuTab : unsigned int
     {
@@ -63,14 +71,27 @@ private:
         bool enableMusic{true};
         bool enableSound{true};
         bool vsync{true};
+        bool adaptiveVsync{false};
+        bool lowLatency{false};
+        bool justInTimeInput{false};
+        int maxFramesInFlight{1};
+        int oitDownscale{2};
+        bool telemetryEnabled{false};
+        float telemetryIntervalSeconds{1.0f};
         bool fullscreen{false};
         bool antialiasing{true};
+        bool dynamicResolution{true};
+        bool reflectionHalfRate{true};
         bool showDebugOverlay{false};
+        bool threadedSimulation{false};
+        bool rollbackNetcode{false};
         bool arcadeModeEnabled{true};
 
+        float interpolationDelay{0.1f};
         float masterVolume{50.0f};
         float musicVolume{75.0f};
         float renderQuality{1.0f};
+        float reflectionScale{0.5f};
         float sfxVolume{10.0f};
         float runnerSpeed{30.0f};
         float runnerStrafeLimit{35.0f};
@@ -84,10 +105,8 @@ private:
     mutable Shader *mParticlesComputeShader{nullptr};
     mutable Shader *mParticlesRenderShader{nullptr};
 
-    mutable GLuint mParticlesVAO{0};
+    mutable ParticleSystem mParticles;
     mutable GLuint mParticlesAttractorVAO{0};
-    mutable GLuint mParticlesPosSSBO{0};
-    mutable GLuint mParticlesVelSSBO{0};
     mutable GLuint mParticlesAttractorVBO{0};
     mutable GLuint mParticlesRenderFBO{0};
     mutable GLuint mParticlesRenderTexture{0};
@@ -114,15 +133,23 @@ private:
     mutable float mAttractorPointSize{5.0f};
     mutable float mParticleResetIntervalSeconds{10.0f};
     mutable float mParticleResetAccumulator{0.0f};
+    /// SDL_GetTicksNS() of the last preview redraw; the ImGui image shows that frame in between
+    mutable std::uint64_t mParticleLastRenderNs{0};
+    /// Cleared while the window is unfocused or minimized, which pauses the simulation
+    bool mParticleSceneActive{true};
     mutable glm::vec4 mBlackHoleBase1{5.0f, 0.0f, 0.0f, 1.0f};
     mutable glm::vec4 mBlackHoleBase2{-5.0f, 0.0f, 0.0f, 1.0f};
 
     void initializeParticleScene() const noexcept;
-    void renderParticleScene() const noexcept;
+    /// @param simulate Advance the particles first; false redraws the current state (fresh target while paused)
+    void renderParticleScene(bool simulate) const noexcept;
     void resetParticleSimulation() const noexcept;
+    /// Refill the particle pool with the starting lattice
+    void seedParticleGrid() const noexcept;
     void cleanupParticleScene() noexcept;
     void updateParticleProjection() const noexcept;
-    void ensureParticleRenderTarget(int width, int height) const noexcept;
+    /// @return true if the target was (re)created and holds no image yet
+    bool ensureParticleRenderTarget(int width, int height) const noexcept;
 
     void pushSynthwaveStyle() const noexcept;
     void popSynthwaveStyle() const noexcept;
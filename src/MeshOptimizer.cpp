@@ -0,0 +1,223 @@
+#include "MeshOptimizer.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    /// Dead-end jumps inside smaller clusters do not split them, so overdraw sorting keeps cache runs long
+    constexpr std::uint32_t kMinClusterTriangles = 64;
+    constexpr std::uint32_t kNoVertex = std::numeric_limits<std::uint32_t>::max();
+}
+
+std::vector<std::uint32_t> MeshOptimizer::optimizeVertexCache(std::span<std::uint32_t> indices, std::size_t vertexCount,
+                                                              std::uint32_t cacheSize)
+{
+    const std::size_t triangleCount = indices.size() / 3;
+    std::vector<std::uint32_t> clusterStarts{0};
+    if (triangleCount == 0 || vertexCount == 0)
+    {
+        return clusterStarts;
+    }
+
+    // Vertex -> triangle adjacency as one flat array
+    std::vector<std::uint32_t> liveTriangles(vertexCount, 0);
+    for (std::size_t i = 0; i < triangleCount * 3; ++i)
+    {
+        ++liveTriangles[indices[i]];
+    }
+    std::vector<std::uint32_t> adjacencyStart(vertexCount + 1, 0);
+    for (std::size_t v = 0; v < vertexCount; ++v)
+    {
+        adjacencyStart[v + 1] = adjacencyStart[v] + liveTriangles[v];
+    }
+    std::vector<std::uint32_t> adjacency(adjacencyStart.back());
+    {
+        std::vector<std::uint32_t> fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+        for (std::size_t t = 0; t < triangleCount; ++t)
+        {
+            for (std::size_t k = 0; k < 3; ++k)
+            {
+                adjacency[fill[indices[t * 3 + k]]++] = static_cast<std::uint32_t>(t);
+            }
+        }
+    }
+
+    std::vector<std::uint32_t> cacheTime(vertexCount, 0);
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<std::uint32_t> deadEnds;
+    std::vector<std::uint32_t> candidates;
+    std::vector<std::uint32_t> output;
+    output.reserve(triangleCount * 3);
+
+    std::uint32_t timestamp = cacheSize + 1;
+    std::uint32_t cursor = 0;
+    std::uint32_t clusterTriangles = 0;
+    std::uint32_t fan = indices[0];
+
+    while (fan != kNoVertex)
+    {
+        candidates.clear();
+        for (std::uint32_t a = adjacencyStart[fan]; a < adjacencyStart[fan + 1]; ++a)
+        {
+            const std::uint32_t t = adjacency[a];
+            if (emitted[t])
+            {
+                continue;
+            }
+            emitted[t] = true;
+            ++clusterTriangles;
+            for (std::size_t k = 0; k < 3; ++k)
+            {
+                const std::uint32_t v = indices[t * 3 + k];
+                output.push_back(v);
+                deadEnds.push_back(v);
+                candidates.push_back(v);
+                --liveTriangles[v];
+                if (timestamp - cacheTime[v] > cacheSize)
+                {
+                    cacheTime[v] = timestamp++;
+                }
+            }
+        }
+
+        // Next fan: the candidate still in cache with the most triangles left to emit
+        fan = kNoVertex;
+        int best = -1;
+        for (std::uint32_t v : candidates)
+        {
+            if (liveTriangles[v] == 0)
+            {
+                continue;
+            }
+            int priority = 0;
+            if (timestamp - cacheTime[v] + 2 * liveTriangles[v] <= cacheSize)
+            {
+                priority = static_cast<int>(timestamp - cacheTime[v]);
+            }
+            if (priority > best)
+            {
+                best = priority;
+                fan = v;
+            }
+        }
+
+        if (fan == kNoVertex)
+        {
+            // Dead end: back up through recent vertices, then scan forward for any vertex with work left
+            while (!deadEnds.empty() && fan == kNoVertex)
+            {
+                const std::uint32_t v = deadEnds.back();
+                deadEnds.pop_back();
+                if (liveTriangles[v] > 0)
+                {
+                    fan = v;
+                }
+            }
+            while (fan == kNoVertex && cursor < vertexCount)
+            {
+                if (liveTriangles[cursor] > 0)
+                {
+                    fan = cursor;
+                }
+                ++cursor;
+            }
+
+            if (fan != kNoVertex && clusterTriangles >= kMinClusterTriangles)
+            {
+                clusterStarts.push_back(static_cast<std::uint32_t>(output.size() / 3));
+                clusterTriangles = 0;
+            }
+        }
+    }
+
+    std::copy(output.begin(), output.end(), indices.begin());
+    return clusterStarts;
+}
+
+void MeshOptimizer::optimizeOverdraw(std::span<std::uint32_t> indices, std::span<const glm::vec3> positions,
+                                     std::span<const std::uint32_t> clusterStarts)
+{
+    const std::size_t triangleCount = indices.size() / 3;
+    if (clusterStarts.size() < 2 || triangleCount == 0)
+    {
+        return;
+    }
+
+    struct Cluster
+    {
+        std::uint32_t first{0};
+        std::uint32_t count{0};
+        glm::vec3 centroid{0.0f};
+        glm::vec3 normal{0.0f};
+        float outward{0.0f};
+    };
+
+    std::vector<Cluster> clusters(clusterStarts.size());
+    glm::vec3 meshCentroid{0.0f};
+    float meshArea = 0.0f;
+    for (std::size_t c = 0; c < clusters.size(); ++c)
+    {
+        Cluster &cluster = clusters[c];
+        cluster.first = clusterStarts[c];
+        const std::uint32_t end = c + 1 < clusters.size() ? clusterStarts[c + 1] : static_cast<std::uint32_t>(triangleCount);
+        cluster.count = end - cluster.first;
+
+        float area = 0.0f;
+        for (std::uint32_t t = cluster.first; t < end; ++t)
+        {
+            const glm::vec3 &a = positions[indices[t * 3 + 0]];
+            const glm::vec3 &b = positions[indices[t * 3 + 1]];
+            const glm::vec3 &p = positions[indices[t * 3 + 2]];
+            const glm::vec3 n = glm::cross(b - a, p - a);
+            const float triangleArea = glm::length(n);
+            cluster.centroid += (a + b + p) * (triangleArea / 3.0f);
+            cluster.normal += n;
+            area += triangleArea;
+        }
+        meshCentroid += cluster.centroid;
+        meshArea += area;
+        cluster.centroid = area > 0.0f ? cluster.centroid / area : positions[indices[cluster.first * 3]];
+    }
+    meshCentroid = meshArea > 0.0f ? meshCentroid / meshArea : glm::vec3(0.0f);
+
+    for (Cluster &cluster : clusters)
+    {
+        const float length = glm::length(cluster.normal);
+        cluster.outward = length > 0.0f ? glm::dot(cluster.centroid - meshCentroid, cluster.normal / length) : 0.0f;
+    }
+
+    std::stable_sort(clusters.begin(), clusters.end(),
+                     [](const Cluster &lhs, const Cluster &rhs) { return lhs.outward > rhs.outward; });
+
+    std::vector<std::uint32_t> sorted;
+    sorted.reserve(triangleCount * 3);
+    for (const Cluster &cluster : clusters)
+    {
+        const auto first = indices.begin() + static_cast<std::ptrdiff_t>(cluster.first) * 3;
+        sorted.insert(sorted.end(), first, first + static_cast<std::ptrdiff_t>(cluster.count) * 3);
+    }
+    std::copy(sorted.begin(), sorted.end(), indices.begin());
+}
+
+std::vector<std::uint32_t> MeshOptimizer::optimizeVertexFetch(std::span<const std::uint32_t> indices,
+                                                              std::size_t vertexCount)
+{
+    std::vector<std::uint32_t> remap(vertexCount, kNoVertex);
+    std::uint32_t next = 0;
+    for (std::uint32_t v : indices)
+    {
+        if (v < vertexCount && remap[v] == kNoVertex)
+        {
+            remap[v] = next++;
+        }
+    }
+    for (std::uint32_t &slot : remap)
+    {
+        if (slot == kNoVertex)
+        {
+            slot = next++;
+        }
+    }
+    return remap;
+}
@@ -0,0 +1,37 @@
+#ifndef MESH_OPTIMIZER_HPP
+#define MESH_OPTIMIZER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+/// @brief Reorder indexed triangle lists for the GPU's post-transform cache, overdraw and vertex fetch
+/// @details Index reordering follows Tipsify (Sander et al., "Fast Triangle Reordering for Vertex Locality
+/// and Reduced Overdraw"): triangles are emitted in fans around recently used vertices, and the runs
+/// between cache flushes are then sorted so the most outward-facing ones draw first. Vertex reordering
+/// lays vertices out in first-use order so the index stream walks memory forwards.
+class MeshOptimizer
+{
+public:
+    /// Post-transform cache size Tipsify plans for; small enough to suit every GPU generation
+    static constexpr std::uint32_t DEFAULT_CACHE_SIZE = 16;
+
+    /// @brief Reorder triangles in place for vertex cache reuse
+    /// @return Triangle offsets at which a cluster starts, for optimizeOverdraw(); always begins with 0
+    static std::vector<std::uint32_t> optimizeVertexCache(std::span<std::uint32_t> indices, std::size_t vertexCount,
+                                                          std::uint32_t cacheSize = DEFAULT_CACHE_SIZE);
+
+    /// @brief Sort the clusters from optimizeVertexCache() outward-facing first, keeping each cluster's order
+    static void optimizeOverdraw(std::span<std::uint32_t> indices, std::span<const glm::vec3> positions,
+                                 std::span<const std::uint32_t> clusterStarts);
+
+    /// @brief Vertex permutation in first-use order: new index = remap[old index]
+    /// @details Vertices the indices never reference go last, so the remap is always a full permutation.
+    [[nodiscard]] static std::vector<std::uint32_t> optimizeVertexFetch(std::span<const std::uint32_t> indices,
+                                                                        std::size_t vertexCount);
+};
+
+#endif // MESH_OPTIMIZER_HPP
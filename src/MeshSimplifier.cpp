@@ -0,0 +1,282 @@
+#include "MeshSimplifier.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <queue>
+#include <unordered_map>
+
+namespace
+{
+    /// Below this a collapsed triangle counts as degenerate
+    constexpr double kMinTriangleArea = 1e-12;
+    /// Reject collapses that turn a triangle's normal further than this (cosine)
+    constexpr double kMaxNormalDeviation = 0.2;
+
+    /// Symmetric 4x4 error quadric, upper triangle only
+    struct Quadric
+    {
+        std::array<double, 10> m{};
+
+        void addPlane(const glm::dvec3 &n, double d) noexcept
+        {
+            m[0] += n.x * n.x;
+            m[1] += n.x * n.y;
+            m[2] += n.x * n.z;
+            m[3] += n.x * d;
+            m[4] += n.y * n.y;
+            m[5] += n.y * n.z;
+            m[6] += n.y * d;
+            m[7] += n.z * n.z;
+            m[8] += n.z * d;
+            m[9] += d * d;
+        }
+
+        Quadric &operator+=(const Quadric &other) noexcept
+        {
+            for (std::size_t i = 0; i < m.size(); ++i)
+            {
+                m[i] += other.m[i];
+            }
+            return *this;
+        }
+
+        /// Sum of squared distances of p to the accumulated planes
+        [[nodiscard]] double evaluate(const glm::dvec3 &p) const noexcept
+        {
+            return m[0] * p.x * p.x + 2.0 * m[1] * p.x * p.y + 2.0 * m[2] * p.x * p.z + 2.0 * m[3] * p.x +
+                   m[4] * p.y * p.y + 2.0 * m[5] * p.y * p.z + 2.0 * m[6] * p.y + m[7] * p.z * p.z +
+                   2.0 * m[8] * p.z + m[9];
+        }
+    };
+
+    /// Candidate collapse from -> to; stale once either vertex changed after it was queued
+    struct Collapse
+    {
+        double cost{0.0};
+        std::uint32_t from{0};
+        std::uint32_t to{0};
+        std::uint32_t fromVersion{0};
+        std::uint32_t toVersion{0};
+
+        bool operator>(const Collapse &other) const noexcept { return cost > other.cost; }
+    };
+
+    [[nodiscard]] std::uint64_t edgeKey(std::uint32_t a, std::uint32_t b) noexcept
+    {
+        return a < b ? (static_cast<std::uint64_t>(a) << 32) | b : (static_cast<std::uint64_t>(b) << 32) | a;
+    }
+
+    [[nodiscard]] glm::dvec3 triangleNormal(const glm::dvec3 &a, const glm::dvec3 &b, const glm::dvec3 &c) noexcept
+    {
+        return glm::cross(b - a, c - a);
+    }
+}
+
+std::vector<std::uint32_t> MeshSimplifier::simplify(std::span<const glm::vec3> positions,
+                                                    std::span<const std::uint32_t> indices,
+                                                    std::size_t targetIndexCount, float maxError)
+{
+    std::vector<std::uint32_t> result(indices.begin(), indices.end());
+    const std::size_t vertexCount = positions.size();
+    const std::size_t triangleCount = indices.size() / 3;
+    if (vertexCount == 0 || triangleCount == 0 || targetIndexCount >= indices.size())
+    {
+        return result;
+    }
+
+    std::vector<std::array<std::uint32_t, 3>> triangles(triangleCount);
+    std::vector<std::vector<std::uint32_t>> vertexTriangles(vertexCount);
+    std::vector<Quadric> quadrics(vertexCount);
+    std::unordered_map<std::uint64_t, std::uint32_t> edgeUses;
+    edgeUses.reserve(indices.size());
+
+    glm::dvec3 boundsMin{positions[0]};
+    glm::dvec3 boundsMax{positions[0]};
+    for (const glm::vec3 &p : positions)
+    {
+        boundsMin = glm::min(boundsMin, glm::dvec3{p});
+        boundsMax = glm::max(boundsMax, glm::dvec3{p});
+    }
+    const double extent = std::max(glm::length(boundsMax - boundsMin), 1e-6);
+    const double maxCost = (static_cast<double>(maxError) * extent) * (static_cast<double>(maxError) * extent);
+
+    for (std::size_t t = 0; t < triangleCount; ++t)
+    {
+        auto &tri = triangles[t];
+        for (std::size_t k = 0; k < 3; ++k)
+        {
+            tri[k] = std::min<std::uint32_t>(indices[t * 3 + k], static_cast<std::uint32_t>(vertexCount - 1));
+            vertexTriangles[tri[k]].push_back(static_cast<std::uint32_t>(t));
+        }
+        ++edgeUses[edgeKey(tri[0], tri[1])];
+        ++edgeUses[edgeKey(tri[1], tri[2])];
+        ++edgeUses[edgeKey(tri[2], tri[0])];
+
+        const glm::dvec3 a{positions[tri[0]]};
+        const glm::dvec3 n = triangleNormal(a, glm::dvec3{positions[tri[1]]}, glm::dvec3{positions[tri[2]]});
+        const double length = glm::length(n);
+        if (length <= kMinTriangleArea)
+        {
+            continue;
+        }
+        const glm::dvec3 unit = n / length;
+        for (std::uint32_t v : tri)
+        {
+            quadrics[v].addPlane(unit, -glm::dot(unit, a));
+        }
+    }
+
+    std::vector<bool> locked(vertexCount, false);
+    for (const auto &[key, uses] : edgeUses)
+    {
+        if (uses != 2)
+        {
+            locked[static_cast<std::uint32_t>(key >> 32)] = true;
+            locked[static_cast<std::uint32_t>(key & 0xffffffffu)] = true;
+        }
+    }
+
+    std::vector<bool> triangleAlive(triangleCount, true);
+    std::vector<bool> vertexAlive(vertexCount, true);
+    std::vector<std::uint32_t> versions(vertexCount, 0);
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<>> queue;
+
+    auto push = [&](std::uint32_t from, std::uint32_t to) {
+        if (locked[from] || from == to)
+        {
+            return;
+        }
+        Quadric combined = quadrics[from];
+        combined += quadrics[to];
+        const double cost = std::max(combined.evaluate(glm::dvec3{positions[to]}), 0.0);
+        queue.push(Collapse{cost, from, to, versions[from], versions[to]});
+    };
+
+    for (const auto &tri : triangles)
+    {
+        for (std::size_t k = 0; k < 3; ++k)
+        {
+            const std::uint32_t a = tri[k];
+            const std::uint32_t b = tri[(k + 1) % 3];
+            push(a, b);
+            push(b, a);
+        }
+    }
+
+    // Moving from onto to must not fold any surviving triangle over
+    auto collapseKeepsOrientation = [&](std::uint32_t from, std::uint32_t to) {
+        for (std::uint32_t t : vertexTriangles[from])
+        {
+            if (!triangleAlive[t])
+            {
+                continue;
+            }
+            const auto &tri = triangles[t];
+            if (tri[0] == to || tri[1] == to || tri[2] == to)
+            {
+                continue;
+            }
+
+            std::array<glm::dvec3, 3> before{};
+            std::array<glm::dvec3, 3> after{};
+            for (std::size_t k = 0; k < 3; ++k)
+            {
+                before[k] = glm::dvec3{positions[tri[k]]};
+                after[k] = tri[k] == from ? glm::dvec3{positions[to]} : before[k];
+            }
+            const glm::dvec3 n0 = triangleNormal(before[0], before[1], before[2]);
+            const glm::dvec3 n1 = triangleNormal(after[0], after[1], after[2]);
+            const double l0 = glm::length(n0);
+            const double l1 = glm::length(n1);
+            if (l1 <= kMinTriangleArea)
+            {
+                return false;
+            }
+            if (l0 > kMinTriangleArea && glm::dot(n0, n1) < kMaxNormalDeviation * l0 * l1)
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    std::size_t liveIndices = triangleCount * 3;
+    std::vector<std::uint32_t> neighbours;
+
+    while (liveIndices > targetIndexCount && !queue.empty())
+    {
+        const Collapse collapse = queue.top();
+        queue.pop();
+
+        if (collapse.cost > maxCost)
+        {
+            break;
+        }
+        if (!vertexAlive[collapse.from] || !vertexAlive[collapse.to] || versions[collapse.from] != collapse.fromVersion ||
+            versions[collapse.to] != collapse.toVersion)
+        {
+            continue;
+        }
+        if (!collapseKeepsOrientation(collapse.from, collapse.to))
+        {
+            continue;
+        }
+
+        const std::uint32_t from = collapse.from;
+        const std::uint32_t to = collapse.to;
+        for (std::uint32_t t : vertexTriangles[from])
+        {
+            if (!triangleAlive[t])
+            {
+                continue;
+            }
+            auto &tri = triangles[t];
+            if (tri[0] == to || tri[1] == to || tri[2] == to)
+            {
+                triangleAlive[t] = false;
+                liveIndices -= 3;
+                continue;
+            }
+            std::replace(tri.begin(), tri.end(), from, to);
+            vertexTriangles[to].push_back(t);
+        }
+
+        vertexAlive[from] = false;
+        quadrics[to] += quadrics[from];
+        ++versions[to];
+
+        // Drop dead triangles from the survivor and re-queue its edges with the merged quadric
+        auto &survivorTriangles = vertexTriangles[to];
+        std::erase_if(survivorTriangles, [&](std::uint32_t t) { return !triangleAlive[t]; });
+        neighbours.clear();
+        for (std::uint32_t t : survivorTriangles)
+        {
+            for (std::uint32_t v : triangles[t])
+            {
+                if (v != to)
+                {
+                    neighbours.push_back(v);
+                }
+            }
+        }
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+        for (std::uint32_t n : neighbours)
+        {
+            push(to, n);
+            push(n, to);
+        }
+    }
+
+    result.clear();
+    result.reserve(liveIndices);
+    for (std::size_t t = 0; t < triangleCount; ++t)
+    {
+        if (triangleAlive[t])
+        {
+            result.insert(result.end(), triangles[t].begin(), triangles[t].end());
+        }
+    }
+    return result;
+}
@@ -0,0 +1,27 @@
+#ifndef MESH_SIMPLIFIER_HPP
+#define MESH_SIMPLIFIER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+/// @brief Quadric error edge-collapse simplification of indexed triangle lists
+/// @details Every collapse merges a vertex into one of its neighbours (half-edge collapse), so the
+/// simplified list indexes the original vertex buffer unchanged: no vertex is moved or created, and
+/// per-vertex data such as UVs and bone weights stays valid. Vertices on open edges (mesh borders and
+/// UV seams, where the importer splits vertices) are locked so levels never open cracks.
+class MeshSimplifier
+{
+public:
+    /// @brief Collapse edges until at most targetIndexCount indices remain or the next collapse costs too much
+    /// @param maxError Largest allowed distance of a collapsed vertex to its original surface, as a fraction of the mesh extent
+    /// @return The simplified triangle list; the input is returned unchanged when nothing could be collapsed
+    [[nodiscard]] static std::vector<std::uint32_t> simplify(std::span<const glm::vec3> positions,
+                                                             std::span<const std::uint32_t> indices,
+                                                             std::size_t targetIndexCount, float maxError);
+};
+
+#endif // MESH_SIMPLIFIER_HPP
@@ -4,68 +4,109 @@
 
 #include <glad/glad.h>
 
+#include <cmath>
 #include <cstdint>
-#include <regex>
 #include <sstream>
 #include <algorithm>
-#include <future>
 #include <chrono>
+#include <span>
 
 #include <dearimgui/imgui.h>
 
+#include "CPUProfiler.hpp"
+#include "FrameArena.hpp"
 #include "GameState.hpp"
 #include "HttpClient.hpp"
 #include "JSONUtils.hpp"
 #include "MusicPlayer.hpp"
+#include "Options.hpp"
+#include "RelayServer.hpp"
+#include "ResourceManager.hpp"
 #include "StateStack.hpp"
+#include "Telemetry.hpp"
 
 namespace
 {
-    constexpr float NETWORK_SEND_INTERVAL = 0.25f;
     constexpr float NETWORK_REGISTRATION_INTERVAL = 15.0f;
     constexpr float NETWORK_DISCOVERY_INTERVAL = 5.0f;
+    // A server without the lobby watch is asked again this rarely; discovery polling covers the wait
+    constexpr float LOBBY_WATCH_RETRY_INTERVAL = 60.0f;
+    // Least time between two watches, so a server that answers at once is not asked every frame
+    constexpr float LOBBY_WATCH_REARM_INTERVAL = 1.0f;
     constexpr float LOBBY_STATUS_INTERVAL = 1.0f;
 
-    bool parseJsonStringField(const std::string &src, std::string_view key, std::string &out)
+    // Remote interpolation: render delay = max(option, send interval + scale * jitter), eased toward
+    constexpr float JITTER_DELAY_SCALE = 2.0f;
+    constexpr float MAX_INTERPOLATION_DELAY = 0.5f;
+    constexpr float INTERPOLATION_DELAY_RATE = 0.2f; // seconds of delay change per second
+    constexpr float MAX_EXTRAPOLATION = 0.2f;
+    constexpr double CLOCK_SMOOTHING = 0.05;
+    constexpr float JITTER_SMOOTHING = 0.1f;
+
+    // A remote player silent this long (out of interest range, or gone) is no longer drawn
+    constexpr double REMOTE_STALE_SECONDS = 3.0;
+    // Mesh peers beyond RelayServer::INTEREST_RADIUS still hear from us at this weight, so that
+    // approaching each other is noticed without a relay to tell either side
+    constexpr float MESH_OUT_OF_RANGE_WEIGHT = 0.1f;
+    // Neither congestion nor interest may stretch the gap between snapshots to a peer past this,
+    // so a live player is never left silent for REMOTE_STALE_SECONDS
+    constexpr double MAX_SNAPSHOT_GAP_SECONDS = REMOTE_STALE_SECONDS * 0.5;
+
+    // Bounds one frame's TCP drain per socket so a flooding peer cannot stall the frame
+    constexpr std::size_t MAX_TCP_PACKETS_PER_FRAME = 256;
+
+    constexpr float PING_INTERVAL = 1.0f;
+
+    // Rollback matches run one session frame per main-loop fixed step, and collect pickups as GameState does
+    constexpr float ROLLBACK_STEP_SECONDS = 1.0f / 60.0f;
+    constexpr float ROLLBACK_PICKUP_RADIUS = 3.5f;
+
+    std::string makeRemoteKey(const std::string &source, std::uint8_t playerId)
     {
-        const std::regex fieldRegex(
-            std::string{"\""} + std::string(key) + std::string{"\"\\s*:\\s*\"([^\"]*)\""});
+        return source + "#" + std::to_string(playerId);
+    }
 
-        std::smatch match;
-        if (std::regex_search(src, match, fieldRegex) && match.size() > 1)
+    /// The leading Int32 packet type, without disturbing the packet's read position
+    std::int32_t peekPacketType(const sf::Packet &packet) noexcept
+    {
+        if (packet.getDataSize() < sizeof(std::uint32_t))
         {
-            out = match[1].str();
-            return true;
+            return -1;
         }
-
-        return false;
+        const auto *bytes = static_cast<const std::uint8_t *>(packet.getData());
+        return static_cast<std::int32_t>((static_cast<std::uint32_t>(bytes[0]) << 24) | (static_cast<std::uint32_t>(bytes[1]) << 16) |
+                                         (static_cast<std::uint32_t>(bytes[2]) << 8) | static_cast<std::uint32_t>(bytes[3]));
     }
 
-    bool parseJsonIntField(const std::string &src, std::string_view key, unsigned short &out)
+    /// Hand each packet of a MESSAGE_BATCH frame (read past its type) to fn; stops at a truncated entry
+    template <typename Fn>
+    void forEachBatched(const sf::Packet &frame, Fn &&fn)
     {
-        const std::regex fieldRegex(
-            std::string{"\""} + std::string(key) + std::string{"\"\\s*:\\s*(\\d+)"});
+        const auto *bytes = static_cast<const std::uint8_t *>(frame.getData());
+        std::size_t offset = frame.getReadPosition();
+        const std::size_t end = frame.getDataSize();
+        if (offset + 2 > end)
+        {
+            return;
+        }
 
-        std::smatch match;
-        if (std::regex_search(src, match, fieldRegex) && match.size() > 1)
+        const std::size_t count = (static_cast<std::size_t>(bytes[offset]) << 8) | bytes[offset + 1];
+        offset += 2;
+        for (std::size_t i = 0; i < count && offset + 4 <= end; ++i)
         {
-            try
-            {
-                out = static_cast<unsigned short>(std::stoul(match[1].str()));
-                return true;
-            }
-            catch (...)
+            const std::size_t size = (static_cast<std::size_t>(bytes[offset]) << 24) | (static_cast<std::size_t>(bytes[offset + 1]) << 16) |
+                                     (static_cast<std::size_t>(bytes[offset + 2]) << 8) | bytes[offset + 3];
+            offset += 4;
+            if (offset + size > end)
             {
-                return false;
+                return;
             }
-        }
-
-        return false;
-    }
 
-    std::string makePeerKey(const sf::IpAddress &ip, unsigned short port)
-    {
-        return ip.toString() + ":" + std::to_string(port);
+            sf::Packet message;
+            message.append(bytes + offset, size);
+            offset += size;
+            fn(message);
+        }
     }
 
     std::string makeResponseSnippet(const char *label, const std::string &response)
@@ -78,34 +119,125 @@ namespace
     }
 }
 
+/// @details Players move through the maze walls by their inputs alone, so each peer reproduces the
+/// others exactly. The world logs the walls and pickups it removes for restoring, so a state slot
+/// only holds positions and the world's marks.
+class MultiplayerGameState::MatchSimulation final : public IRollbackSimulation
+{
+public:
+    struct PlayerState
+    {
+        glm::vec3 position{0.0f};
+        float facing{0.0f};
+        bool moving{false};
+    };
+
+    MatchSimulation(GameState &game, std::size_t playerCount, std::size_t localPlayer)
+        : mGame{game}, mPlayerCount{playerCount}, mLocalPlayer{localPlayer}
+    {
+        for (std::size_t player = 0; player < mPlayerCount; ++player)
+        {
+            mCurrent.players[player].position = GameState::getMazeSpawn();
+        }
+        mGame.getWorld().setMatchHistoryEnabled(true);
+    }
+
+    ~MatchSimulation() override
+    {
+        mGame.getWorld().setMatchHistoryEnabled(false);
+    }
+
+    void saveState(std::size_t slot) override
+    {
+        mCurrent.world = mGame.getWorld().saveMatchSnapshot();
+        mSlots[slot] = mCurrent;
+    }
+
+    void loadState(std::size_t slot) override
+    {
+        mCurrent = mSlots[slot];
+        mGame.getWorld().restoreMatchSnapshot(mCurrent.world);
+    }
+
+    void confirmState(std::size_t slot) override
+    {
+        mGame.getWorld().confirmMatchSnapshot(mSlots[slot].world);
+    }
+
+    void advance(std::span<const RollbackInput> inputs) override
+    {
+        World &world = mGame.getWorld();
+        std::array<World::PickupQuery, RollbackSession::MAX_PLAYERS> queries{};
+        std::array<int, RollbackSession::MAX_PLAYERS> points{};
+
+        const std::size_t count = std::min(inputs.size(), mPlayerCount);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            PlayerState &player = mCurrent.players[i];
+            const glm::vec2 move = inputs[i].getMove();
+            player.moving = move.x != 0.0f || move.y != 0.0f;
+            if (player.moving)
+            {
+                GameState::movePlayerThroughMaze(world, player.position, move, mWallResolveScratch);
+                player.facing = glm::degrees(std::atan2(move.x, -move.y));
+            }
+            queries[i] = {player.position, ROLLBACK_PICKUP_RADIUS};
+        }
+
+        world.update(ROLLBACK_STEP_SECONDS);
+
+        // Everyone takes pickups from the shared world; only the local player's count toward the score
+        world.collectNearbyPickups(std::span<const World::PickupQuery>(queries.data(), count),
+                                   std::span<int>(points.data(), count));
+        world.addScore(points[mLocalPlayer]);
+    }
+
+    [[nodiscard]] const PlayerState &getPlayer(std::size_t player) const noexcept { return mCurrent.players[player]; }
+
+private:
+    struct MatchState
+    {
+        std::array<PlayerState, RollbackSession::MAX_PLAYERS> players{};
+        World::MatchSnapshot world;
+    };
+
+    GameState &mGame;
+    std::size_t mPlayerCount;
+    std::size_t mLocalPlayer;
+    MatchState mCurrent;
+    std::array<MatchState, RollbackSession::STATE_SLOTS> mSlots{};
+    WallBroadphase::ResolveScratch mWallResolveScratch;
+};
+
 MultiplayerGameState::MultiplayerGameState(StateStack &stack, Context context)
     : State(stack, context), mLocalGame(std::make_unique<GameState>(stack, context)), mMusic{nullptr}
 {
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MultiplayerGameState: Constructed");
+    if (auto *optionsManager = context.getOptionsManager(); optionsManager != nullptr)
+    {
+        try
+        {
+            mRollbackNetcode = optionsManager->get(GUIOptions::ID::DE_FACTO).getRollbackNetcode();
+        }
+        catch (const std::exception &)
+        {
+        }
+    }
     initializeNetwork();
     initializeOfflineBots();
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MultiplayerGameState: Initialized");
 }
 
+MultiplayerGameState::~MultiplayerGameState() = default;
+
 void MultiplayerGameState::draw() const noexcept
 {
     if (mLocalGame)
     {
+        mLocalGame->setInterpolationAlpha(getInterpolationAlpha());
+        // Other characters are drawn inside the scene pass so they share its camera, depth and render scale
+        renderPlayers();
         mLocalGame->draw();
-
-        if ((mLobbyReady && !mRemotePlayers.empty()) || (mOfflineAIMode && !mOfflineBots.empty()))
-        {
-            // Prepare for 3D rendering (clear depth after path tracer)
-            glClear(GL_DEPTH_BUFFER_BIT);
-            glDepthFunc(GL_LESS);
-            glDepthMask(GL_TRUE);
-            glEnable(GL_DEPTH_TEST);
-
-            if (mLobbyReady)
-            {
-                renderPlayers(mRemotePlayers);
-            }
-        }
     }
 
     // Draw lobby status overlay if not ready
@@ -132,11 +264,40 @@ void MultiplayerGameState::draw() const noexcept
 
         ImGui::End();
     }
+
+    // Shown with the FPS overlay, so send rates can be tuned against live numbers
+    bool showDebugOverlay = false;
+    if (auto *optionsManager = getContext().getOptionsManager(); optionsManager != nullptr)
+    {
+        try
+        {
+            showDebugOverlay = optionsManager->get(GUIOptions::ID::DE_FACTO).getShowDebugOverlay();
+        }
+        catch (const std::exception &)
+        {
+        }
+    }
+    if (showDebugOverlay)
+    {
+        drawNetStats();
+    }
 }
 
 bool MultiplayerGameState::update(float dt, unsigned int subSteps) noexcept
 {
     mOfflineElapsedSeconds += std::max(0.0f, dt);
+    mNetworkTime += std::max(0.0f, dt);
+
+    if (auto *optionsManager = getContext().getOptionsManager(); optionsManager != nullptr)
+    {
+        try
+        {
+            mInterpolationDelay = optionsManager->get(GUIOptions::ID::DE_FACTO).getInterpolationDelay();
+        }
+        catch (const std::exception &)
+        {
+        }
+    }
 
     mDebugAccumulator += dt;
     if (mDebugAccumulator >= 5.0f)
@@ -144,21 +305,12 @@ bool MultiplayerGameState::update(float dt, unsigned int subSteps) noexcept
         mDebugAccumulator = 0.0f;
         SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MultiplayerGameState: Update tick (peers=%zu, sockets=%zu, reg=%d, disc=%d)",
             mRemotePlayers.size(),
-            mPeerSockets.size(),
+            mPeerConnections.size(),
             mRegistrationInFlight ? 1 : 0,
             mDiscoveryInFlight ? 1 : 0);
     }
 
-    mPacketLogAccumulator += dt;
-    if (mPacketLogAccumulator >= 1.0f)
-    {
-        mPacketLogAccumulator = 0.0f;
-        if (mPacketCount > 0)
-        {
-            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MultiplayerGameState: Packets received/s=%zu", mPacketCount);
-        }
-        mPacketCount = 0;
-    }
+    publishNetStats(dt);
 
     if (mLocalGame)
     {
@@ -183,16 +335,22 @@ bool MultiplayerGameState::update(float dt, unsigned int subSteps) noexcept
 
         if (mRegistrationCompleteOnce)
         {
+            mLobbyWatchRetry -= dt;
+            if (!mLobbyWatchInFlight && mLobbyWatchRetry <= 0.0f)
+            {
+                startLobbyWatch();
+            }
+
+            // Polling is only the fallback while the server is not pushing lobby changes
             mDiscoveryAccumulator += dt;
-            if (mDiscoveryAccumulator >= NETWORK_DISCOVERY_INTERVAL)
+            if (!mLobbyPushActive && mDiscoveryAccumulator >= NETWORK_DISCOVERY_INTERVAL)
             {
                 mDiscoveryAccumulator = 0.0f;
                 startDiscovery();
             }
         }
 
-        pollRegistration();
-        pollDiscovery();
+        pollHttp();
 
         // Send lobby status periodically
         mLobbyStatusAccumulator += dt;
@@ -206,21 +364,40 @@ bool MultiplayerGameState::update(float dt, unsigned int subSteps) noexcept
 
     updateOfflineBots(dt);
 
-    pollNetwork();
+    pollNetwork(dt);
+
+    if (mRollbackNetcode && mLobbyReady && !mRollback)
+    {
+        startRollbackMatch();
+    }
 
-    // Update remote player animations
-    for (auto &[playerName, remoteState] : mRemotePlayers)
+    if (mRollback)
+    {
+        updateRollback();
+    }
+    else
     {
-        if (remoteState.initialized)
+        updateRemoteInterpolation(dt);
+
+        // Only send position updates if lobby is ready
+        if (mLobbyReady)
         {
-            remoteState.animator.update();
+            sendLocalState(dt);
         }
     }
 
-    // Only send position updates if lobby is ready
-    if (mLobbyReady)
+    mPingAccumulator += dt;
+    if (mNetworkReady && mPingAccumulator >= PING_INTERVAL)
+    {
+        mPingAccumulator = 0.0f;
+        sendPing();
+    }
+
+    // Everything queued this tick leaves together: one datagram per UDP peer, one frame per TCP one
+    if (mNetworkReady)
     {
-        sendLocalState(dt);
+        mTransport.flush();
+        flushTcp();
     }
 
     return true;
@@ -235,23 +412,9 @@ void MultiplayerGameState::initializeOfflineBots()
 
     for (int i = 0; i < mOfflineBotCount; ++i)
     {
-        const std::string name = "bot_" + std::to_string(i + 1);
-
-        SimulatedPlayerState bot;
-        bot.controller = std::make_unique<LaneAIController>(1337u + static_cast<std::uint32_t>(17 * i));
-        bot.renderState.position = anchor + glm::vec3(16.0f + static_cast<float>(i) * 13.0f,
-                                                      1.0f,
-                                                      ((i % 2 == 0) ? -1.0f : 1.0f) * 5.0f);
-        bot.renderState.facing = 0.0f;
-        bot.renderState.moving = true;
-        bot.renderState.animState = static_cast<std::uint8_t>(CharacterAnimState::WALK_FORWARD);
-        bot.renderState.animator.initialize(0);
-        bot.renderState.animator.setPosition(bot.renderState.position);
-        bot.renderState.animator.setRotation(bot.renderState.facing);
-        bot.renderState.animator.setState(CharacterAnimState::WALK_FORWARD, true);
-        bot.renderState.initialized = true;
-
-        mOfflineBots.emplace(name, std::move(bot));
+        mOfflineBots.add(anchor + glm::vec3(16.0f + static_cast<float>(i) * 13.0f,
+                                            1.0f,
+                                            ((i % 2 == 0) ? -1.0f : 1.0f) * 5.0f));
     }
 }
 
@@ -271,43 +434,71 @@ void MultiplayerGameState::updateOfflineBots(float dt) noexcept
     worldSnapshot.strafeLimit = mOfflineStrafeLimit;
     worldSnapshot.elapsedSeconds = mOfflineElapsedSeconds;
 
-    for (auto &[name, sim] : mOfflineBots)
-    {
-        if (!sim.active || !sim.controller)
-        {
-            continue;
-        }
+    mOfflineBots.update(worldSnapshot, dt);
+}
 
-        auto &state = sim.renderState;
-        PlayerCommand command = sim.controller->sample(worldSnapshot, state.position, dt);
+void MultiplayerGameState::renderPlayers() const noexcept
+{
+    if (!mLocalGame)
+    {
+        return;
+    }
 
-        state.position.x += worldSnapshot.runnerSpeed * std::clamp(command.forwardScale, 0.65f, 1.25f) * dt;
+    std::pmr::vector<World::CharacterInstance> characters{&FrameArena::frame()};
+    characters.reserve(mRemotePlayers.size() + mOfflineBots.size());
 
-        const float clampedTargetZ = std::clamp(command.targetZ, -worldSnapshot.strafeLimit, worldSnapshot.strafeLimit);
-        const float maxStrafeStep = worldSnapshot.runnerSpeed * 0.85f * dt;
-        const float dz = std::clamp(clampedTargetZ - state.position.z, -maxStrafeStep, maxStrafeStep);
-        state.position.z = std::clamp(state.position.z + dz, -worldSnapshot.strafeLimit, worldSnapshot.strafeLimit);
+    // Offset each character's clip so a group walking together does not step in lockstep
+    const auto append = [&characters, this](const RemotePlayerState &state)
+    {
+        if (state.bufferedCount > 0)
+        {
+            const auto &newest = state.buffered[(state.bufferedHead + state.bufferedCount - 1) % INTERPOLATION_BUFFER];
+            if (mNetworkTime + state.clockOffset - newest.senderTime > REMOTE_STALE_SECONDS)
+            {
+                return;
+            }
+        }
 
-        state.position.y = 1.0f;
-        state.facing = 0.0f;
-        state.moving = true;
-        state.animState = static_cast<std::uint8_t>(CharacterAnimState::WALK_FORWARD);
+        const float phase = 0.37f * static_cast<float>(characters.size());
+        characters.push_back({state.position, state.facing, state.moving ? mOfflineElapsedSeconds + phase : 0.0f});
+    };
 
-        state.animator.setState(CharacterAnimState::WALK_FORWARD);
-        state.animator.setPosition(state.position);
-        state.animator.setRotation(state.facing);
-        state.animator.update();
+    if (mRollback)
+    {
+        // Remote players stand where the session predicts them, corrected by the next rollback
+        for (std::size_t player = 0; player < mRollback->getPlayerCount(); ++player)
+        {
+            if (player == mRollback->getLocalPlayer())
+            {
+                continue;
+            }
+            const auto &state = mMatchSimulation->getPlayer(player);
+            const float phase = 0.37f * static_cast<float>(characters.size());
+            characters.push_back({state.position, state.facing, state.moving ? mOfflineElapsedSeconds + phase : 0.0f});
+        }
+    }
+    else if (mLobbyReady)
+    {
+        for (const auto &[name, state] : mRemotePlayers)
+        {
+            if (state.initialized)
+            {
+                append(state);
+            }
+        }
     }
-}
 
-void MultiplayerGameState::renderPlayers(const std::unordered_map<std::string, RemotePlayerState> &players) const noexcept
-{
-    if (!mLocalGame)
+    if (mOfflineAIMode)
     {
-        return;
+        // Bots always run straight ahead, so they skip the remote player state and its staleness check
+        for (std::size_t bot = 0; bot < mOfflineBots.size(); ++bot)
+        {
+            const float phase = 0.37f * static_cast<float>(characters.size());
+            characters.push_back({mOfflineBots.getPosition(bot), 0.0f, mOfflineElapsedSeconds + phase});
+        }
     }
 
-    auto &world = mLocalGame->getWorld();
+    mLocalGame->getWorld().setCharacterInstances(characters);
 }
 
 bool MultiplayerGameState::handleEvent(const SDL_Event &event) noexcept
@@ -344,6 +535,46 @@ void MultiplayerGameState::initializeNetwork()
     }
 
     mNetworkReady = true;
+
+    if (const auto relay = getContext().getHttpClient()->getRelayAddress(); !relay.empty())
+    {
+        connectToRelay(relay);
+    }
+}
+
+bool MultiplayerGameState::connectToRelay(const std::string &address)
+{
+    if (!mTransport.isBound())
+    {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "WARN: MultiplayerGameState: Relay needs UDP, staying on the peer mesh");
+        return false;
+    }
+
+    const auto colon = address.rfind(':');
+    unsigned short port = 0;
+    try
+    {
+        port = colon == std::string::npos ? 0 : static_cast<unsigned short>(std::stoul(address.substr(colon + 1)));
+    }
+    catch (const std::exception &)
+    {
+        port = 0;
+    }
+    const auto ip = sf::IpAddress::resolve(address.substr(0, colon));
+    if (port == 0 || !ip)
+    {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "WARN: MultiplayerGameState: Bad relay address '%s'", address.c_str());
+        return false;
+    }
+
+    mRelayMode = true;
+    mRelayKey = NetTransport::makePeerKey(*ip, port);
+    mMaximumPlayers = static_cast<int>(RelayServer::MAX_CLIENTS);
+    mTransport.addPeer(mRelayKey, *ip, port);
+    sendHello();
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MultiplayerGameState: Using relay %s", mRelayKey.c_str());
+    return true;
 }
 
 bool MultiplayerGameState::startListener()
@@ -362,12 +593,18 @@ bool MultiplayerGameState::startListener()
 
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MultiplayerGameState: Listening on port %u", mLocalPort);
 
+    if (!mTransport.bind(mLocalPort))
+    {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "WARN: MultiplayerGameState: UDP port %u unavailable, player state stays on TCP",
+            mLocalPort);
+    }
+
     return true;
 }
 
 void MultiplayerGameState::startRegistration()
 {
-    if (mRegistrationInFlight || mDiscoveryInFlight || !getContext().getHttpClient())
+    if (mRegistrationInFlight || !getContext().getHttpClient())
     {
         return;
     }
@@ -384,48 +621,72 @@ void MultiplayerGameState::startRegistration()
             << ",\"port\":" << playerPort
             << "}";
 
-    mRegistrationFuture = std::async(std::launch::async,
-                                     [client = getContext().getHttpClient(), body = payload.str()]()
-                                     {
-                                         try
-                                         {
-                                             return client ? client->post("/mazes/networks/data", body) : std::string{};
-                                         }
-                                         catch (...)
-                                         {
-                                             return std::string{};
-                                         }
-                                     });
+    mRegistrationRequest = getContext().getHttpClient()->postAsync("/mazes/networks/data", payload.str());
 }
 
-void MultiplayerGameState::pollRegistration()
+void MultiplayerGameState::startDiscovery()
 {
-    if (!mRegistrationInFlight)
+    if (mDiscoveryInFlight || !getContext().getHttpClient())
     {
         return;
     }
 
-    if (mRegistrationFuture.wait_for(std::chrono::milliseconds(0)) != std::future_status::ready)
+    mDiscoveryInFlight = true;
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MultiplayerGameState: Starting discovery GET");
+
+    mDiscoveryRequest = getContext().getHttpClient()->getAsync("/mazes/networks/data");
+}
+
+void MultiplayerGameState::startLobbyWatch()
+{
+    if (mLobbyWatchInFlight || mRelayMode || !getContext().getHttpClient())
     {
         return;
     }
 
-    mRegistrationInFlight = false;
-    std::string response;
-    try
-    {
-        response = mRegistrationFuture.get();
-    }
-    catch (const std::exception &e)
+    // The server holds the request until the roster moves past the version or its own timeout, then
+    // answers {"version": N, "joined": [...], "left": [...]}; an empty 2xx means nothing changed
+    mLobbyWatchInFlight = true;
+    mLobbyWatchRequest = getContext().getHttpClient()->watchAsync(
+        "/mazes/networks/watch?since=" + std::to_string(mLobbyVersion));
+}
+
+void MultiplayerGameState::pollHttp()
+{
+    if ((!mRegistrationInFlight && !mDiscoveryInFlight && !mLobbyWatchInFlight) || !getContext().getHttpClient())
     {
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "WARN: MultiplayerGameState: Registration future error: %s", e.what());
         return;
     }
-    catch (...)
+
+    mHttpCompletions.clear();
+    getContext().getHttpClient()->pollCompletions(mHttpCompletions);
+
+    for (const auto &completion : mHttpCompletions)
     {
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "WARN: MultiplayerGameState: Registration future error (unknown)");
-        return;
+        if (mRegistrationInFlight && completion.id == mRegistrationRequest)
+        {
+            mRegistrationInFlight = false;
+            handleRegistrationResponse(completion.body);
+        }
+        else if (mDiscoveryInFlight && completion.id == mDiscoveryRequest)
+        {
+            mDiscoveryInFlight = false;
+            if (!completion.body.empty())
+            {
+                SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "%s", makeResponseSnippet("Discovery response", completion.body).c_str());
+            }
+            discoverPeers(completion.body);
+        }
+        else if (mLobbyWatchInFlight && completion.id == mLobbyWatchRequest)
+        {
+            mLobbyWatchInFlight = false;
+            handleLobbyDelta(completion);
+        }
     }
+}
+
+void MultiplayerGameState::handleRegistrationResponse(const std::string &response)
+{
     if (response.empty())
     {
         SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "WARN: MultiplayerGameState: Registration POST returned no data");
@@ -436,79 +697,101 @@ void MultiplayerGameState::pollRegistration()
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "%s", makeResponseSnippet("Registration response", response).c_str());
 }
 
-void MultiplayerGameState::startDiscovery()
+void MultiplayerGameState::discoverPeers(const std::string &response)
 {
-    if (mDiscoveryInFlight || mRegistrationInFlight || !getContext().getHttpClient())
+    if (response.empty())
     {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "WARN: MultiplayerGameState: No peer data received");
         return;
     }
 
-    mDiscoveryInFlight = true;
-    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MultiplayerGameState: Starting discovery GET");
+    const auto peers = parseActivePlayers(response);
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MultiplayerGameState: Discovery response %zu bytes, %zu peer(s)",
+        response.size(), peers.size());
+
+    // Through a relay every other player arrives in its snapshots; no direct connections
+    if (mRelayMode)
+    {
+        return;
+    }
 
-    mDiscoveryFuture = std::async(std::launch::async,
-                                  [client = getContext().getHttpClient()]()
-                                  {
-                                      try
-                                      {
-                                          return client ? client->get("/mazes/networks/data") : std::string{};
-                                      }
-                                      catch (...)
-                                      {
-                                          return std::string{};
-                                      }
-                                  });
+    connectToPeers(peers);
 }
 
-void MultiplayerGameState::pollDiscovery()
+void MultiplayerGameState::handleLobbyDelta(const HttpClient::Completion &completion)
 {
-    if (!mDiscoveryInFlight)
+    std::vector<PeerInfo> joined;
+    std::vector<PeerInfo> left;
+    const auto toPeer = [](const JSONUtils::PeerRecord &record)
     {
-        return;
+        PeerInfo peer;
+        peer.name.assign(record.name);
+        peer.ip = sf::IpAddress::resolve(record.ip).value_or(sf::IpAddress::LocalHost);
+        peer.port = record.port;
+        return peer;
+    };
+
+    std::optional<std::uint64_t> version;
+    if (completion.ok && !completion.body.empty())
+    {
+        version = JSONUtils::parseLobbyDelta(
+            completion.body,
+            [&joined, &toPeer](const JSONUtils::PeerRecord &record)
+            { joined.push_back(toPeer(record)); },
+            [&left, &toPeer](const JSONUtils::PeerRecord &record)
+            { left.push_back(toPeer(record)); });
     }
 
-    if (mDiscoveryFuture.wait_for(std::chrono::milliseconds(0)) != std::future_status::ready)
+    // No watch on this server (or it is down): poll now and until the retry
+    if (!completion.ok || (!completion.body.empty() && !version))
     {
+        if (mLobbyPushActive)
+        {
+            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "WARN: MultiplayerGameState: Lobby push lost, polling discovery");
+        }
+        mLobbyPushActive = false;
+        mLobbyWatchRetry = LOBBY_WATCH_RETRY_INTERVAL;
+        mDiscoveryAccumulator = NETWORK_DISCOVERY_INTERVAL;
         return;
     }
 
-    mDiscoveryInFlight = false;
-    std::string response;
-    try
+    mLobbyWatchRetry = LOBBY_WATCH_REARM_INTERVAL;
+
+    // An empty answer proves nothing about the watch, so only a parsed delta turns polling off
+    if (!version)
     {
-        response = mDiscoveryFuture.get();
+        return;
     }
-    catch (const std::exception &e)
+    if (!mLobbyPushActive)
     {
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "WARN: MultiplayerGameState: Discovery future error: %s", e.what());
-        return;
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MultiplayerGameState: Lobby push active, discovery polling off");
+        mLobbyPushActive = true;
     }
-    catch (...)
+
+    mLobbyVersion = *version;
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MultiplayerGameState: Lobby version %llu, %zu joined, %zu left",
+        static_cast<unsigned long long>(mLobbyVersion), joined.size(), left.size());
+
+    // A peer that left may come back on the same address; the closed socket is dropped by pollNetwork
+    for (const auto &peer : left)
     {
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "WARN: MultiplayerGameState: Discovery future error (unknown)");
-        return;
+        mKnownPeers.erase(NetTransport::makePeerKey(peer.ip, peer.port));
     }
-    if (!response.empty())
+    if (!mRelayMode)
     {
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "%s", makeResponseSnippet("Discovery response", response).c_str());
+        connectToPeers(joined);
     }
-
-    discoverPeers(response);
 }
 
-void MultiplayerGameState::discoverPeers(const std::string &response)
+void MultiplayerGameState::connectToPeers(const std::vector<PeerInfo> &peers)
 {
-    if (response.empty())
-    {
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "WARN: MultiplayerGameState: No peer data received");
-        return;
-    }
-
-    const auto peers = parseActivePlayers(response);
-    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MultiplayerGameState: Discovery response %zu bytes, %zu peer(s)",
-        response.size(), peers.size());
     for (const auto &peer : peers)
     {
+        if (1 + static_cast<int>(mPeerConnections.size()) >= mMaximumPlayers)
+        {
+            break;
+        }
+
         if (peer.port == 0)
         {
             continue;
@@ -519,7 +802,7 @@ void MultiplayerGameState::discoverPeers(const std::string &response)
             continue;
         }
 
-        const auto peerKey = makePeerKey(peer.ip, peer.port);
+        const auto peerKey = NetTransport::makePeerKey(peer.ip, peer.port);
         if (mKnownPeers.find(peerKey) != mKnownPeers.end())
         {
             continue;
@@ -550,24 +833,43 @@ void MultiplayerGameState::connectToPeer(const PeerInfo &peer)
 
     socket->setBlocking(false);
     mSelector.add(*socket);
-    mPeerSockets.push_back(std::move(socket));
+    const auto peerKey = NetTransport::makePeerKey(peer.ip, peer.port);
+    mPeerConnections.push_back(PeerConnection{std::move(socket), peerKey, true});
+
+    if (mTransport.isBound())
+    {
+        mTransport.addPeer(peerKey, peer.ip, peer.port);
+    }
+    sendHello();
 
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MultiplayerGameState: Connected to %s:%u",
         peer.ip.toString().c_str(), peer.port);
 }
 
-void MultiplayerGameState::pollNetwork()
+void MultiplayerGameState::pollNetwork(float dt)
 {
+    BW_PROFILE_ZONE("MultiplayerGameState::pollNetwork");
+
     if (!mNetworkReady)
     {
         return;
     }
 
-    if (mListener.getLocalPort() == 0 && mPeerSockets.empty())
+    if (mListener.getLocalPort() == 0 && mPeerConnections.empty())
     {
         return;
     }
 
+    mTransport.update(dt,
+        [this](const std::string &peer, sf::Packet &packet)
+        {
+            handlePacket(peer, packet);
+        },
+        [this](const std::string &peer, std::uint16_t datagram)
+        {
+            onSnapshotAcked(peer, datagram);
+        });
+
     // Accept any pending connections (non-blocking listener)
     while (true)
     {
@@ -576,7 +878,7 @@ void MultiplayerGameState::pollNetwork()
         if (status == sf::Socket::Status::Done)
         {
             socket->setBlocking(false);
-            mPeerSockets.push_back(std::move(socket));
+            mPeerConnections.push_back(PeerConnection{std::move(socket), {}, false});
             SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MultiplayerGameState: Accepted incoming connection");
             continue;
         }
@@ -584,20 +886,81 @@ void MultiplayerGameState::pollNetwork()
         break;
     }
 
-    for (auto it = mPeerSockets.begin(); it != mPeerSockets.end();)
+    for (auto it = mPeerConnections.begin(); it != mPeerConnections.end();)
     {
-        sf::TcpSocket &socket = *(*it);
-        sf::Packet packet;
-        const auto status = socket.receive(packet);
+        PeerConnection &connection = *it;
+        const auto sourceOf = [&connection]()
+        {
+            if (!connection.key.empty())
+            {
+                return connection.key;
+            }
+            // Not introduced yet; PLAYER_HELLO comes first on the stream and names it
+            return "tcp:" + NetTransport::makePeerKey(
+                connection.socket->getRemoteAddress().value_or(sf::IpAddress::LocalHost), connection.socket->getRemotePort());
+        };
+
+        // TCP always carries full snapshots, so of the positions queued up only the newest is applied
+        sf::Packet newestPosition;
+        bool hasPosition = false;
+        const auto dispatch = [&](sf::Packet &message)
+        {
+            if (peekPacketType(message) == static_cast<std::int32_t>(HttpClient::PacketType::POSITION_UPDATE))
+            {
+                newestPosition = message;
+                hasPosition = true;
+                return;
+            }
+            handlePacket(sourceOf(), message, &connection);
+        };
+
+        // Drain until the socket has nothing ready, so a backlog never carries over into later frames
+        auto status = sf::Socket::Status::NotReady;
+        std::size_t received = 0;
+        std::size_t receivedBytes = 0;
+        for (; received < MAX_TCP_PACKETS_PER_FRAME; ++received)
+        {
+            sf::Packet packet;
+            status = connection.socket->receive(packet);
+            if (status != sf::Socket::Status::Done)
+            {
+                break;
+            }
 
-        if (status == sf::Socket::Status::Done)
+            receivedBytes += packet.getDataSize();
+            if (peekPacketType(packet) == static_cast<std::int32_t>(HttpClient::PacketType::MESSAGE_BATCH))
+            {
+                std::int32_t packetType = 0;
+                packet >> packetType;
+                forEachBatched(packet, dispatch);
+            }
+            else
+            {
+                dispatch(packet);
+            }
+        }
+
+        if (hasPosition)
+        {
+            handlePacket(sourceOf(), newestPosition, &connection);
+        }
+
+        if (received > 0)
         {
-            handlePacket(packet);
-            ++mPacketCount;
+            const std::string source = sourceOf();
+            mNetStats.addPacketsIn(source, received, receivedBytes);
+            mNetStats.addReceiveBurst(source, received);
         }
-        else if (status == sf::Socket::Status::Disconnected)
+
+        if (status == sf::Socket::Status::Disconnected)
         {
-            it = mPeerSockets.erase(it);
+            if (it->outgoing)
+            {
+                mTransport.removePeer(it->key);
+                mSnapshotPeers.erase(it->key);
+            }
+            mNetStats.removePeer(it->key);
+            it = mPeerConnections.erase(it);
             continue;
         }
 
@@ -605,8 +968,10 @@ void MultiplayerGameState::pollNetwork()
     }
 }
 
-void MultiplayerGameState::handlePacket(sf::Packet &packet)
+void MultiplayerGameState::handlePacket(const std::string &source, sf::Packet &packet, PeerConnection *connection)
 {
+    BW_PROFILE_ZONE("MultiplayerGameState::handlePacket");
+
     std::int32_t packetType = 0;
     if (!(packet >> packetType))
     {
@@ -615,50 +980,40 @@ void MultiplayerGameState::handlePacket(sf::Packet &packet)
 
     if (packetType == static_cast<std::int32_t>(HttpClient::PacketType::POSITION_UPDATE))
     {
-        std::string name;
-        float x = 0.0f;
-        float y = 0.0f;
-        float z = 0.0f;
-        float facing = 0.0f;
-        std::uint8_t moving = 0;
-        std::uint8_t animState = 0;
-
-        if (packet >> name >> x >> y >> z >> facing >> moving >> animState)
-        {
-            auto &remote = mRemotePlayers[name];
-            remote.position = glm::vec3{x, y, z};
-            remote.facing = facing;
-            remote.moving = (moving != 0);
-            remote.animState = animState;
-
-            // Initialize animator on first packet
-            if (!remote.initialized)
-            {
-                remote.animator.initialize(0); // Character index 0
-                remote.initialized = true;
-            }
+        std::uint8_t playerId = 0;
+        std::uint16_t sequence = 0;
+        std::uint16_t senderMillis = 0;
+        std::uint8_t baselineDistance = 0;
+        if (!(packet >> playerId >> sequence >> senderMillis >> baselineDistance))
+        {
+            return;
+        }
 
-            // Update animator state based on movement
-            if (remote.moving)
+        const auto remoteKey = makeRemoteKey(source, playerId);
+        auto &remote = mRemotePlayers[remoteKey];
+
+        PlayerSnapshot baseline;
+        if (baselineDistance != 0)
+        {
+            const auto baselineSequence = static_cast<std::uint16_t>(sequence - baselineDistance);
+            const auto &record = remote.history[baselineSequence % SNAPSHOT_HISTORY];
+            if (!record.valid || record.sequence != baselineSequence)
             {
-                remote.animator.setState(CharacterAnimState::WALK_FORWARD);
-            }
-            else
-            {
-                remote.animator.setState(CharacterAnimState::IDLE);
+                return;
             }
+            baseline = record.snapshot;
+        }
 
-            // Update animator position and rotation
-            remote.animator.setPosition(remote.position);
-            remote.animator.setRotation(remote.facing);
+        PlayerSnapshot snapshot;
+        if (PlayerSnapshot::read(packet, baseline, snapshot))
+        {
+            remote.history[sequence % SNAPSHOT_HISTORY] = SnapshotRecord{sequence, snapshot, true};
+            acceptSnapshot(remoteKey, remote, sequence, senderMillis, snapshot);
 
-            // Debug SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION for first position update from each player
-            static std::unordered_set<std::string> loggedPlayers;
-            if (loggedPlayers.find(name) == loggedPlayers.end())
+            if (const auto peer = mSnapshotPeers.find(source); peer != mSnapshotPeers.end())
             {
-                loggedPlayers.insert(name);
-                SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MultiplayerGameState: First position update from %s at (%.2f, %.2f, %.2f)",
-                    name.c_str(), x, y, z);
+                peer->second.position = snapshot.getPosition();
+                peer->second.hasPosition = true;
             }
         }
     }
@@ -678,104 +1033,673 @@ void MultiplayerGameState::handlePacket(sf::Packet &packet)
     {
         SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MultiplayerGameState: Received LobbyReady from peer");
     }
+    else if (packetType == static_cast<std::int32_t>(HttpClient::PacketType::RELAY_SNAPSHOT) ||
+             packetType == static_cast<std::int32_t>(HttpClient::PacketType::RELAY_ROSTER))
+    {
+        // Only the relay we chose speaks for other players
+        if (mRelayMode && source == mRelayKey)
+        {
+            handleRelayPacket(packetType, packet);
+        }
+    }
+    else if (packetType == static_cast<std::int32_t>(HttpClient::PacketType::PING))
+    {
+        handlePing(source, packet, connection);
+    }
+    else if (packetType == static_cast<std::int32_t>(HttpClient::PacketType::PONG))
+    {
+        handlePong(source, packet);
+    }
+    else if (packetType == static_cast<std::int32_t>(HttpClient::PacketType::ROLLBACK_INPUT))
+    {
+        std::uint8_t playerIndex = 0;
+        if (mRollback && (packet >> playerIndex))
+        {
+            mRollback->readRemoteInputs(playerIndex, packet);
+        }
+    }
+    else if (packetType == static_cast<std::int32_t>(HttpClient::PacketType::PLAYER_HELLO))
+    {
+        std::uint8_t playerId = 0;
+        std::string name;
+        std::uint16_t listenPort = 0;
+        if (!(packet >> playerId >> name >> listenPort))
+        {
+            return;
+        }
+
+        std::string introduced = source;
+        if (connection && connection->key.empty())
+        {
+            // File this connection's traffic under the same key its UDP datagrams arrive with
+            connection->key = NetTransport::makePeerKey(
+                connection->socket->getRemoteAddress().value_or(sf::IpAddress::LocalHost), listenPort);
+            introduced = connection->key;
+        }
+
+        mRemotePlayers[makeRemoteKey(introduced, playerId)].name = name;
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MultiplayerGameState: %s is player %u from %s",
+            name.c_str(), static_cast<unsigned>(playerId), introduced.c_str());
+
+        if (mGreetedSources.insert(introduced).second)
+        {
+            sendHello();
+        }
+    }
 }
 
-void MultiplayerGameState::sendLocalState(float dt)
+void MultiplayerGameState::acceptSnapshot(const std::string &remoteKey, RemotePlayerState &remote, std::uint16_t sequence,
+                                          std::uint16_t senderMillis, const PlayerSnapshot &snapshot)
 {
-    if (!mNetworkReady || mPeerSockets.empty())
+    // A late snapshot still serves as a baseline, but never moves the player back
+    if (remote.hasLatest && !NetTransport::sequenceGreater(sequence, remote.latestSequence))
     {
         return;
     }
+    TimedSnapshot timed;
+    timed.position = snapshot.getPosition();
+    timed.facing = snapshot.getFacing();
+    timed.moving = snapshot.isMoving();
+    timed.animState = snapshot.getAnimState();
 
-    mSendAccumulator += dt;
-    if (mSendAccumulator < NETWORK_SEND_INTERVAL)
+    if (!remote.hasLatest || remote.bufferedCount == 0)
+    {
+        timed.senderTime = static_cast<double>(senderMillis) / 1000.0;
+        remote.clockOffset = timed.senderTime - mNetworkTime;
+        remote.jitter = 0.0f;
+    }
+    else
+    {
+        // The millisecond stamp wraps every 65 s; it is always read relative to the previous one
+        const auto &previous = remote.buffered[(remote.bufferedHead + remote.bufferedCount - 1) % INTERPOLATION_BUFFER];
+        const auto elapsedMillis = static_cast<std::int16_t>(senderMillis - remote.lastSenderMillis);
+        timed.senderTime = previous.senderTime + static_cast<double>(elapsedMillis) / 1000.0;
+
+        const double deviation = (timed.senderTime - mNetworkTime) - remote.clockOffset;
+        remote.clockOffset += deviation * CLOCK_SMOOTHING;
+        remote.jitter += (static_cast<float>(std::abs(deviation)) - remote.jitter) * JITTER_SMOOTHING;
+        // Idle heartbeats are far apart but say nothing about how fast updates come while moving
+        const float spacing = std::min(static_cast<float>(timed.senderTime - previous.senderTime), SendRateController::ACTIVE_INTERVAL);
+        remote.sendInterval += (spacing - remote.sendInterval) * JITTER_SMOOTHING;
+    }
+    remote.latestSequence = sequence;
+    remote.hasLatest = true;
+    remote.lastSenderMillis = senderMillis;
+
+    if (remote.bufferedCount == INTERPOLATION_BUFFER)
+    {
+        remote.bufferedHead = (remote.bufferedHead + 1) % INTERPOLATION_BUFFER;
+        --remote.bufferedCount;
+    }
+    remote.buffered[(remote.bufferedHead + remote.bufferedCount) % INTERPOLATION_BUFFER] = timed;
+    ++remote.bufferedCount;
+
+    // Initialize animator on first packet
+    if (!remote.initialized)
+    {
+        remote.animator.initialize(0); // Character index 0
+        remote.initialized = true;
+        remote.position = timed.position;
+        remote.facing = timed.facing;
+    }
+
+    // Debug SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION for first position update from each player
+    static std::unordered_set<std::string> loggedPlayers;
+    if (loggedPlayers.find(remoteKey) == loggedPlayers.end())
+    {
+        loggedPlayers.insert(remoteKey);
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MultiplayerGameState: First position update from %s at (%.2f, %.2f, %.2f)",
+            remote.name.empty() ? remoteKey.c_str() : remote.name.c_str(),
+            remote.position.x, remote.position.y, remote.position.z);
+    }
+}
+
+void MultiplayerGameState::handleRelayPacket(std::int32_t packetType, sf::Packet &packet)
+{
+    std::uint8_t count = 0;
+    if (!(packet >> count))
     {
         return;
     }
 
-    mSendAccumulator = 0.0f;
+    if (packetType == static_cast<std::int32_t>(HttpClient::PacketType::RELAY_SNAPSHOT))
+    {
+        // Full snapshots; the relay's own acks and deltas stay between it and each sender
+        for (std::uint8_t i = 0; i < count; ++i)
+        {
+            std::uint8_t slot = 0;
+            std::uint16_t sequence = 0;
+            std::uint16_t senderMillis = 0;
+            PlayerSnapshot snapshot;
+            if (!(packet >> slot >> sequence >> senderMillis) || !PlayerSnapshot::read(packet, PlayerSnapshot{}, snapshot))
+            {
+                return;
+            }
 
-    const auto &player = *getContext().getPlayer();
-    const auto position = player.getPosition();
-    const auto facing = player.getFacingDirection();
-    const auto moving = player.isMoving();
-    const auto animState = static_cast<std::uint8_t>(player.getAnimator().getState());
+            const auto remoteKey = makeRemoteKey(mRelayKey, slot);
+            acceptSnapshot(remoteKey, mRemotePlayers[remoteKey], sequence, senderMillis, snapshot);
+        }
+        return;
+    }
+
+    // Roster: everyone in the room but us; players missing from it left
+    std::unordered_set<std::string> present;
+    for (std::uint8_t i = 0; i < count; ++i)
+    {
+        std::uint8_t slot = 0;
+        std::string name;
+        if (!(packet >> slot >> name))
+        {
+            return;
+        }
+        const auto remoteKey = makeRemoteKey(mRelayKey, slot);
+        if (const auto it = mRemotePlayers.find(remoteKey); it != mRemotePlayers.end() && it->second.name != name)
+        {
+            // A freed slot went to someone new; their sequence numbers start over
+            mRemotePlayers.erase(it);
+        }
+        mRemotePlayers[remoteKey].name = name;
+        present.insert(remoteKey);
+    }
+
+    std::erase_if(mRemotePlayers, [&present](const auto &entry)
+                  { return present.find(entry.first) == present.end(); });
+    mRelayPeerCount = present.size();
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MultiplayerGameState: Relay room has %zu other player(s)", mRelayPeerCount);
+}
+
+void MultiplayerGameState::updateRemoteInterpolation(float dt) noexcept
+{
+    const auto lerpAngle = [](float from, float to, float t)
+    {
+        const float delta = std::fmod(to - from + 540.0f, 360.0f) - 180.0f;
+        return from + delta * t;
+    };
+
+    for (auto &[key, remote] : mRemotePlayers)
+    {
+        if (!remote.initialized || remote.bufferedCount == 0)
+        {
+            continue;
+        }
+
+        const float targetDelay = std::clamp(std::max(mInterpolationDelay, remote.sendInterval + JITTER_DELAY_SCALE * remote.jitter),
+                                             0.0f, MAX_INTERPOLATION_DELAY);
+        const float maxStep = INTERPOLATION_DELAY_RATE * dt;
+        remote.interpolationDelay += std::clamp(targetDelay - remote.interpolationDelay, -maxStep, maxStep);
+
+        const double renderTime = mNetworkTime + remote.clockOffset - static_cast<double>(remote.interpolationDelay);
+        const auto at = [&remote](std::size_t i) -> const TimedSnapshot &
+        {
+            return remote.buffered[(remote.bufferedHead + i) % INTERPOLATION_BUFFER];
+        };
+
+        const TimedSnapshot &oldest = at(0);
+        const TimedSnapshot &newest = at(remote.bufferedCount - 1);
+        TimedSnapshot sample = newest;
+
+        // How far behind the sender's clock the shown state is; NetStats adds the one-way trip
+        const double shownTime = std::min(renderTime, newest.senderTime);
+        mNetStats.addSnapshotAge(std::string_view(key).substr(0, key.rfind('#')),
+                                 static_cast<float>((mNetworkTime + remote.clockOffset - shownTime) * 1000.0));
+
+        if (renderTime <= oldest.senderTime)
+        {
+            sample = oldest;
+        }
+        else if (renderTime >= newest.senderTime)
+        {
+            // Packets are late: dead-reckon along the last segment, but only briefly
+            if (remote.bufferedCount >= 2)
+            {
+                const TimedSnapshot &before = at(remote.bufferedCount - 2);
+                const double span = newest.senderTime - before.senderTime;
+                if (span > 0.0 && newest.moving)
+                {
+                    const float ahead = std::min(static_cast<float>(renderTime - newest.senderTime), MAX_EXTRAPOLATION);
+                    sample.position = newest.position + (newest.position - before.position) * (ahead / static_cast<float>(span));
+                }
+            }
+        }
+        else
+        {
+            for (std::size_t i = remote.bufferedCount - 1; i > 0; --i)
+            {
+                const TimedSnapshot &from = at(i - 1);
+                const TimedSnapshot &to = at(i);
+                if (from.senderTime <= renderTime)
+                {
+                    const double span = to.senderTime - from.senderTime;
+                    const float t = span > 0.0 ? static_cast<float>((renderTime - from.senderTime) / span) : 1.0f;
+                    sample = from;
+                    sample.position = from.position + (to.position - from.position) * t;
+                    sample.facing = lerpAngle(from.facing, to.facing, t);
+                    break;
+                }
+            }
+        }
+
+        remote.position = sample.position;
+        remote.facing = sample.facing;
+        remote.moving = sample.moving;
+        remote.animState = sample.animState;
 
+        remote.animator.setState(remote.moving ? CharacterAnimState::WALK_FORWARD : CharacterAnimState::IDLE);
+        remote.animator.setPosition(remote.position);
+        remote.animator.setRotation(remote.facing);
+        remote.animator.update();
+    }
+}
+
+void MultiplayerGameState::sendHello()
+{
     sf::Packet packet;
-    packet << static_cast<std::int32_t>(HttpClient::PacketType::POSITION_UPDATE)
+    packet << static_cast<std::int32_t>(HttpClient::PacketType::PLAYER_HELLO)
+           << mLocalPlayerId
            << mLocalPlayerName
-           << position.x << position.y << position.z
-           << facing
-           << static_cast<std::uint8_t>(moving ? 1 : 0)
-           << animState;
+           << static_cast<std::uint16_t>(mLocalPort);
+    sendToPeers(packet, NetTransport::Channel::RELIABLE);
+}
 
-    for (auto &socket : mPeerSockets)
+void MultiplayerGameState::sendPing()
+{
+    if (mPeerConnections.empty() && !mRelayMode)
     {
-        const auto status = socket->send(packet);
-        if (status != sf::Socket::Status::Done)
+        return;
+    }
+
+    sf::Packet packet;
+    packet << static_cast<std::int32_t>(HttpClient::PacketType::PING) << static_cast<std::uint32_t>(SDL_GetTicks());
+    sendToPeers(packet, NetTransport::Channel::UNRELIABLE);
+}
+
+void MultiplayerGameState::handlePing(const std::string &source, sf::Packet &packet, PeerConnection *connection)
+{
+    std::uint32_t senderMillis = 0;
+    if (!(packet >> senderMillis))
+    {
+        return;
+    }
+
+    // Answer on the path the ping took, so the round trip measures that path
+    sf::Packet pong;
+    pong << static_cast<std::int32_t>(HttpClient::PacketType::PONG) << senderMillis;
+    if (connection)
+    {
+        queueTcp(*connection, pong);
+    }
+    else
+    {
+        mTransport.send(source, pong, NetTransport::Channel::UNRELIABLE);
+    }
+}
+
+void MultiplayerGameState::handlePong(const std::string &source, sf::Packet &packet)
+{
+    std::uint32_t sentMillis = 0;
+    if (packet >> sentMillis)
+    {
+        // Unsigned subtraction stays right across the tick counter wrapping
+        const auto rttMillis = static_cast<std::uint32_t>(SDL_GetTicks()) - sentMillis;
+        mNetStats.addRttSample(source, static_cast<float>(rttMillis));
+    }
+}
+
+void MultiplayerGameState::publishNetStats(float dt)
+{
+    mNetStatsAccumulator += dt;
+    if (mNetStatsAccumulator < NetStats::WINDOW_SECONDS)
+    {
+        return;
+    }
+
+    if (mTransport.isBound())
+    {
+        for (const auto &key : mTransport.getPeerKeys())
         {
-            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "WARN: MultiplayerGameState: Failed to send packet (status=%d)",
-                static_cast<int>(status));
+            mNetStats.addTransport(key, mTransport.takeCounters(key));
+        }
+    }
+    mNetStats.publish(mNetStatsAccumulator);
+    Telemetry::recordNetwork(mNetStats);
+
+    for (const auto &[key, stats] : mNetStats.getPeers())
+    {
+        if (const auto peer = mSnapshotPeers.find(key); peer != mSnapshotPeers.end())
+        {
+            SendRateController::updateCongestion(peer->second.congestion, stats);
         }
     }
+
+    if (mNetStats.getPacketsIn() > 0)
+    {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MultiplayerGameState: Packets received/s=%.0f",
+                    static_cast<float>(mNetStats.getPacketsIn()) / mNetStatsAccumulator);
+    }
+    mNetStatsAccumulator = 0.0f;
+
+#if defined(BREAKING_WALLS_PROFILE)
+    // Counter tracks need literal names, so the trace gets the worst peer and the totals
+    NetStats::PeerStats worst;
+    float bytesIn = 0.0f;
+    float bytesOut = 0.0f;
+    for (const auto &[key, stats] : mNetStats.getPeers())
+    {
+        worst.rttMs = std::max(worst.rttMs, stats.rttMs);
+        worst.jitterMs = std::max(worst.jitterMs, stats.jitterMs);
+        worst.lossPercent = std::max(worst.lossPercent, stats.lossPercent);
+        worst.receiveQueuePeak = std::max(worst.receiveQueuePeak, stats.receiveQueuePeak);
+        worst.snapshotAgeMs = std::max(worst.snapshotAgeMs, stats.hasSnapshotAge ? stats.snapshotAgeMs : 0.0f);
+        bytesIn += stats.bytesInPerSecond;
+        bytesOut += stats.bytesOutPerSecond;
+    }
+    BW_PROFILE_COUNTER("Net peers", mNetStats.getPeers().size());
+    BW_PROFILE_COUNTER("Net RTT max ms", worst.rttMs);
+    BW_PROFILE_COUNTER("Net jitter max ms", worst.jitterMs);
+    BW_PROFILE_COUNTER("Net loss max %", worst.lossPercent);
+    BW_PROFILE_COUNTER("Net receive queue peak", worst.receiveQueuePeak);
+    BW_PROFILE_COUNTER("Net snapshot age max ms", worst.snapshotAgeMs);
+    BW_PROFILE_COUNTER("Net KB/s in", bytesIn / 1024.0f);
+    BW_PROFILE_COUNTER("Net KB/s out", bytesOut / 1024.0f);
+#endif
 }
 
-std::string MultiplayerGameState::loadNetworkUrl() const
+void MultiplayerGameState::drawNetStats() const noexcept
 {
-    if (!getContext().getHttpClient())
+    const auto &peers = mNetStats.getPeers();
+    if (peers.empty())
     {
-        return {};
+        return;
     }
 
-    const auto hostUrl = getContext().getHttpClient()->getHostURL();
-    return std::string(hostUrl);
+    const auto optional = [](bool has, float value, const char *format)
+    {
+        if (has)
+        {
+            ImGui::Text(format, value);
+        }
+        else
+        {
+            ImGui::TextUnformatted("-");
+        }
+    };
+
+    ImGui::SetNextWindowPos(ImVec2(10, 120), ImGuiCond_FirstUseEver);
+    if (ImGui::Begin("Network", nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing))
+    {
+        if (ImGui::BeginTable("Peers", 9, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_RowBg))
+        {
+            ImGui::TableSetupColumn("Peer");
+            ImGui::TableSetupColumn("RTT ms");
+            ImGui::TableSetupColumn("Jitter ms");
+            ImGui::TableSetupColumn("In KB/s");
+            ImGui::TableSetupColumn("Out KB/s");
+            ImGui::TableSetupColumn("Pkts in/out");
+            ImGui::TableSetupColumn("Loss %");
+            ImGui::TableSetupColumn("Queue");
+            ImGui::TableSetupColumn("Snap age ms");
+            ImGui::TableHeadersRow();
+
+            for (const auto &[key, stats] : peers)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(key.c_str());
+                ImGui::TableNextColumn();
+                optional(stats.hasRtt, stats.rttMs, "%.1f");
+                ImGui::TableNextColumn();
+                optional(stats.hasRtt, stats.jitterMs, "%.1f");
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", stats.bytesInPerSecond / 1024.0f);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", stats.bytesOutPerSecond / 1024.0f);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.0f / %.0f", stats.packetsInPerSecond, stats.packetsOutPerSecond);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", stats.lossPercent);
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu", stats.receiveQueuePeak);
+                ImGui::TableNextColumn();
+                optional(stats.hasSnapshotAge, stats.snapshotAgeMs, "%.0f");
+            }
+            ImGui::EndTable();
+        }
+
+        if (mRollback)
+        {
+            ImGui::Text("Rollback frame %u, confirmed %u, %u rollbacks (%u frames), %u stalls",
+                        mRollback->getFrame(), mRollback->getConfirmedFrame(), mRollback->getRollbackCount(),
+                        mRollback->getResimulatedFrames(), mRollback->getStallCount());
+        }
+    }
+    ImGui::End();
 }
 
-std::vector<MultiplayerGameState::PeerInfo> MultiplayerGameState::parseActivePlayers(
-    const std::string &json) const
+void MultiplayerGameState::onSnapshotAcked(const std::string &peer, std::uint16_t datagram) noexcept
 {
-    std::vector<PeerInfo> peers;
+    const auto it = mSnapshotPeers.find(peer);
+    if (it == mSnapshotPeers.end())
+    {
+        return;
+    }
+
+    auto &state = it->second;
+    auto &flight = state.inFlight[datagram % state.inFlight.size()];
+    if (!flight.valid || flight.datagram != datagram)
+    {
+        return;
+    }
+    flight.valid = false;
 
-    const std::regex objectRegex(R"(\{[^\}]*\})");
-    auto begin = std::sregex_iterator(json.begin(), json.end(), objectRegex);
-    auto end = std::sregex_iterator();
+    if (!state.hasAcked || NetTransport::sequenceGreater(flight.snapshot, state.ackedSnapshot))
+    {
+        state.ackedSnapshot = flight.snapshot;
+        state.hasAcked = true;
+    }
+}
 
-    for (auto it = begin; it != end; ++it)
+void MultiplayerGameState::sendToPeers(sf::Packet &packet, NetTransport::Channel channel)
+{
+    if (mTransport.isBound())
     {
-        const std::string object = it->str();
-        PeerInfo peer;
-        std::string ipStr;
-        unsigned short portValue = 0;
+        mTransport.broadcast(packet, channel);
+    }
+    sendToTcpFallback(packet);
+}
 
-        if (!parseJsonStringField(object, "player_name", peer.name))
+void MultiplayerGameState::sendToTcpFallback(sf::Packet &packet)
+{
+    for (auto &connection : mPeerConnections)
+    {
+        const bool udpCovers = mTransport.isBound() && !connection.key.empty() &&
+                               mTransport.isPeerConfirmed(connection.key);
+        if (udpCovers)
         {
             continue;
         }
 
-        if (!parseJsonStringField(object, "ip", ipStr) || !parseJsonIntField(object, "port", portValue))
+        // An accepted connection only carries data when there is no outgoing one to the same peer
+        if (!connection.outgoing && !connection.key.empty() &&
+            std::any_of(mPeerConnections.begin(), mPeerConnections.end(), [&connection](const PeerConnection &other)
+            {
+                return other.outgoing && other.key == connection.key;
+            }))
+        {
+            continue;
+        }
+
+        queueTcp(connection, packet);
+    }
+}
+
+void MultiplayerGameState::queueTcp(PeerConnection &connection, const sf::Packet &packet)
+{
+    connection.batch << static_cast<std::uint32_t>(packet.getDataSize());
+    connection.batch.append(packet.getData(), packet.getDataSize());
+    ++connection.batchCount;
+}
+
+void MultiplayerGameState::flushTcp()
+{
+    for (auto &connection : mPeerConnections)
+    {
+        if (connection.batchCount == 0)
         {
             continue;
         }
 
-        peer.ip = sf::IpAddress::resolve(ipStr).value_or(sf::IpAddress::LocalHost);
+        sf::Packet frame;
+        frame << static_cast<std::int32_t>(HttpClient::PacketType::MESSAGE_BATCH) << connection.batchCount;
+        frame.append(connection.batch.getData(), connection.batch.getDataSize());
+        connection.batch.clear();
+        connection.batchCount = 0;
+
+        if (!connection.key.empty())
+        {
+            mNetStats.addPacketsOut(connection.key, 1, frame.getDataSize());
+        }
+
+        const auto status = connection.socket->send(frame);
+        if (status != sf::Socket::Status::Done)
+        {
+            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "WARN: MultiplayerGameState: Failed to send packet (status=%d)",
+                static_cast<int>(status));
+        }
+    }
+}
+
+void MultiplayerGameState::sendLocalState(float dt)
+{
+    if (!mNetworkReady || (mPeerConnections.empty() && !mRelayMode))
+    {
+        return;
+    }
+
+    const auto &player = *getContext().getPlayer();
+    const auto position = player.getPosition();
+    const auto facing = player.getFacingDirection();
+    const auto moving = player.isMoving();
+    const auto animState = static_cast<std::uint8_t>(player.getAnimator().getState());
 
-        peer.port = portValue;
+    const auto snapshot = PlayerSnapshot::quantize(position, facing, moving, animState);
 
-        peers.push_back(peer);
+    mSendAccumulator += dt;
+    const float interval = mSendRate.getInterval(position, facing, snapshot);
+    if (mSendAccumulator < interval)
+    {
+        return;
     }
 
+    mSendAccumulator = 0.0f;
+    mSendRate.onSent(position, facing, snapshot);
+
+    const std::uint16_t sequence = mSnapshotSequence++;
+    mSentSnapshots[sequence % SNAPSHOT_HISTORY] = snapshot;
+
+    // [Int32:packetType] [Uint8:playerId] [Uint16:sequence] [Uint16:senderMillis]
+    // [Uint8:baselineDistance, 0 = full] [snapshot]
+    const auto senderMillis = static_cast<std::uint16_t>(SDL_GetTicks() & 0xFFFFu);
+    const auto makePacket = [&](const PlayerSnapshot *baseline, std::uint8_t baselineDistance)
+    {
+        sf::Packet packet;
+        packet << static_cast<std::int32_t>(HttpClient::PacketType::POSITION_UPDATE)
+               << mLocalPlayerId << sequence << senderMillis << baselineDistance;
+        snapshot.write(packet, baseline);
+        return packet;
+    };
+
+    // A lost position is superseded by the next one, so it is never resent; each peer gets a delta
+    // against the newest snapshot it acked, which stays in both histories
+    if (mTransport.isBound())
+    {
+        for (const auto &key : mTransport.getPeerKeys())
+        {
+            auto &peerState = mSnapshotPeers[key];
+            const bool overdue = peerState.hasSent && mNetworkTime - peerState.lastSentTime >= MAX_SNAPSHOT_GAP_SECONDS;
+
+            // A congested path waits out its scaled interval and skips the snapshots in between
+            if (!overdue && peerState.congestion.scale > 1.0f && peerState.hasSent &&
+                mNetworkTime - peerState.lastSentTime < static_cast<double>(interval * peerState.congestion.scale))
+            {
+                continue;
+            }
+
+            // A relay decides relevance for the whole room; a mesh peer far away hears from us less often
+            if (!overdue && !mRelayMode && peerState.hasPosition)
+            {
+                const float weight = RelayServer::interestWeight(RelayServer::chunkRing(position, peerState.position));
+                peerState.priority += std::max(weight, MESH_OUT_OF_RANGE_WEIGHT);
+                if (peerState.priority < 1.0f)
+                {
+                    continue;
+                }
+            }
+            peerState.priority = 0.0f;
+
+            const PlayerSnapshot *baseline = nullptr;
+            std::uint8_t baselineDistance = 0;
+            if (peerState.hasAcked)
+            {
+                const auto age = static_cast<std::uint16_t>(sequence - peerState.ackedSnapshot);
+                if (age > 0 && age < SNAPSHOT_HISTORY)
+                {
+                    baseline = &mSentSnapshots[peerState.ackedSnapshot % SNAPSHOT_HISTORY];
+                    baselineDistance = static_cast<std::uint8_t>(age);
+                }
+            }
+
+            const sf::Packet packet = makePacket(baseline, baselineDistance);
+            std::uint16_t datagram = 0;
+            if (mTransport.send(key, packet, NetTransport::Channel::UNRELIABLE, &datagram))
+            {
+                peerState.inFlight[datagram % peerState.inFlight.size()] = {datagram, sequence, true};
+                peerState.lastSentTime = mNetworkTime;
+                peerState.hasSent = true;
+            }
+        }
+    }
+
+    // TCP carries no acks back to us, so it always gets the full snapshot
+    sf::Packet fullPacket = makePacket(nullptr, 0);
+    sendToTcpFallback(fullPacket);
+}
+
+std::string MultiplayerGameState::loadNetworkUrl() const
+{
+    if (!getContext().getHttpClient())
+    {
+        return {};
+    }
+
+    const auto hostUrl = getContext().getHttpClient()->getHostURL();
+    return std::string(hostUrl);
+}
+
+std::vector<MultiplayerGameState::PeerInfo> MultiplayerGameState::parseActivePlayers(
+    const std::string &json) const
+{
+    std::vector<PeerInfo> peers;
+
+    JSONUtils::parsePeerRecords(json, [&peers](const JSONUtils::PeerRecord &record)
+                                {
+        PeerInfo peer;
+        peer.name.assign(record.name);
+        peer.ip = sf::IpAddress::resolve(record.ip).value_or(sf::IpAddress::LocalHost);
+        peer.port = record.port;
+        peers.push_back(std::move(peer)); });
+
     return peers;
 }
 
 void MultiplayerGameState::sendLobbyStatus()
 {
-    if (!mNetworkReady || mPeerSockets.empty())
+    if (!mNetworkReady || (mPeerConnections.empty() && !mRelayMode))
     {
         return;
     }
 
-    // Count: self + connected peers
-    mConnectedPlayerCount = 1 + static_cast<int>(mPeerSockets.size());
+    // Count: self + connected peers (or the relay's room); to a relay this doubles as a keep-alive
+    mConnectedPlayerCount = 1 + static_cast<int>(mRelayMode ? mRelayPeerCount : mPeerConnections.size());
 
     sf::Packet packet;
     packet << static_cast<std::int32_t>(HttpClient::PacketType::LOBBY_STATUS)
@@ -783,16 +1707,14 @@ void MultiplayerGameState::sendLobbyStatus()
            << static_cast<std::int32_t>(mMinimumPlayers)
            << static_cast<std::int32_t>(mLobbyReady ? 1 : 0);
 
-    for (auto &socket : mPeerSockets)
-    {
-        [[maybe_unused]] auto status = socket->send(packet);
-    }
+    // Resent every second anyway, so a lost one is replaced rather than retried
+    sendToPeers(packet, NetTransport::Channel::UNRELIABLE);
 }
 
 void MultiplayerGameState::checkLobbyReady()
 {
-    // Count: self + connected peers
-    mConnectedPlayerCount = 1 + static_cast<int>(mPeerSockets.size());
+    // Count: self + connected peers (or the relay's room)
+    mConnectedPlayerCount = 1 + static_cast<int>(mRelayMode ? mRelayPeerCount : mPeerConnections.size());
 
     bool wasReady = mLobbyReady;
     mLobbyReady = (mConnectedPlayerCount >= mMinimumPlayers);
@@ -806,15 +1728,13 @@ void MultiplayerGameState::checkLobbyReady()
         // Broadcast ready status
         sf::Packet packet;
         packet << static_cast<std::int32_t>(HttpClient::PacketType::LOBBY_READY);
-        for (auto &socket : mPeerSockets)
-        {
-            [[maybe_unused]] auto status = socket->send(packet);
-        }
+        sendToPeers(packet, NetTransport::Channel::RELIABLE);
     }
     else if (wasReady && !mLobbyReady)
     {
         SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MultiplayerGameState: Lobby not ready (player disconnected). Players: %d/%d",
             mConnectedPlayerCount, mMinimumPlayers);
+        stopRollbackMatch();
     }
     else if (!mLobbyReady)
     {
@@ -823,3 +1743,76 @@ void MultiplayerGameState::checkLobbyReady()
             mConnectedPlayerCount, mMinimumPlayers);
     }
 }
+
+void MultiplayerGameState::startRollbackMatch()
+{
+    if (mRelayMode || !mLocalGame)
+    {
+        return;
+    }
+
+    std::vector<std::string> roster{mLocalPlayerName};
+    for (const auto &[key, remote] : mRemotePlayers)
+    {
+        if (!remote.name.empty())
+        {
+            roster.push_back(remote.name);
+        }
+    }
+    std::ranges::sort(roster);
+    roster.erase(std::unique(roster.begin(), roster.end()), roster.end());
+
+    // A peer whose PLAYER_HELLO has not arrived would leave the numbering short
+    if (roster.size() != static_cast<std::size_t>(mConnectedPlayerCount) || roster.size() > RollbackSession::MAX_PLAYERS)
+    {
+        return;
+    }
+
+    const auto localPlayer = static_cast<std::size_t>(std::ranges::find(roster, mLocalPlayerName) - roster.begin());
+    mMatchSimulation = std::make_unique<MatchSimulation>(*mLocalGame, roster.size(), localPlayer);
+    mRollback = std::make_unique<RollbackSession>(*mMatchSimulation, roster.size(), localPlayer);
+    mLocalGame->setMoveCapture(true);
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MultiplayerGameState: Rollback match started as player %zu of %zu",
+        localPlayer, roster.size());
+}
+
+void MultiplayerGameState::stopRollbackMatch()
+{
+    if (!mRollback)
+    {
+        return;
+    }
+
+    mRollback.reset();
+    mMatchSimulation.reset();
+    if (mLocalGame)
+    {
+        mLocalGame->setMoveCapture(false);
+    }
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "MultiplayerGameState: Rollback match stopped");
+}
+
+void MultiplayerGameState::updateRollback()
+{
+    BW_PROFILE_ZONE("MultiplayerGameState::updateRollback");
+
+    // Local input lands INPUT_DELAY frames ahead; a stalled frame keeps the first input given for it
+    mRollback->setLocalInput(RollbackInput::quantize(mLocalGame->takeMoveIntent()));
+    mRollback->advanceFrame();
+
+    auto &player = *getContext().getPlayer();
+    const auto &local = mMatchSimulation->getPlayer(mRollback->getLocalPlayer());
+    player.setPosition(glm::vec3(local.position.x, player.getPosition().y, local.position.z));
+    if (local.moving)
+    {
+        player.setFacingDirection(local.facing);
+    }
+
+    // Inputs replace position snapshots; each packet repeats whatever a peer has not confirmed
+    sf::Packet packet;
+    packet << static_cast<std::int32_t>(HttpClient::PacketType::ROLLBACK_INPUT)
+           << static_cast<std::uint8_t>(mRollback->getLocalPlayer());
+    mRollback->writeLocalInputs(packet);
+    sendToPeers(packet, NetTransport::Channel::UNRELIABLE);
+}
@@ -4,18 +4,23 @@
 #include "State.hpp"
 #include "Animation.hpp"
 #include "MatchController.hpp"
+#include "NetStats.hpp"
+#include "NetTransport.hpp"
+#include "PlayerSnapshot.hpp"
+#include "RollbackSession.hpp"
+#include "SendRateController.hpp"
 
 #include <SFML/Network.hpp>
 
 #include <glm/glm.hpp>
 
+#include <array>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 #include <cstdint>
-#include <future>
 
 class GameState;
 class MusicPlayer;
@@ -24,6 +29,7 @@ class MultiplayerGameState : public State
 {
 public:
     explicit MultiplayerGameState(StateStack &stack, Context context);
+    ~MultiplayerGameState() override;
 
     void draw() const noexcept override;
     bool update(float dt, unsigned int subSteps) noexcept override;
@@ -37,39 +43,150 @@ private:
         unsigned short port{0};
     };
 
-    struct RemotePlayerState
+    struct PeerConnection
+    {
+        std::unique_ptr<sf::TcpSocket> socket;
+        /// Transport key of the peer's listen address; an accepted connection learns it from PLAYER_HELLO
+        std::string key;
+        /// Accepted connections mirror an outgoing one in the mesh and only carry data without UDP or that outgoing one
+        bool outgoing{false};
+        /// Messages for this tick, sent as one MESSAGE_BATCH frame by flushTcp()
+        sf::Packet batch;
+        std::uint16_t batchCount{0};
+    };
+
+    static constexpr std::size_t SNAPSHOT_HISTORY = 32;
+
+    struct SnapshotRecord
+    {
+        std::uint16_t sequence{0};
+        PlayerSnapshot snapshot;
+        bool valid{false};
+    };
+
+    /// What one UDP peer has confirmed of our snapshots, for delta encoding against it
+    struct SnapshotPeerState
     {
+        struct InFlight
+        {
+            std::uint16_t datagram{0};
+            std::uint16_t snapshot{0};
+            bool valid{false};
+        };
+
+        std::array<InFlight, 64> inFlight{};
+        std::uint16_t ackedSnapshot{0};
+        bool hasAcked{false};
+
+        /// Where the peer last said it was, for relevance; until then it is treated as near
+        glm::vec3 position{0.0f};
+        bool hasPosition{false};
+        float priority{0.0f};
+
+        SendRateController::Congestion congestion;
+        double lastSentTime{0.0};
+        bool hasSent{false};
+    };
+
+    /// One received snapshot on the sender's clock, for interpolation
+    struct TimedSnapshot
+    {
+        double senderTime{0.0};
         glm::vec3 position{0.0f};
         float facing{0.0f};
         bool moving{false};
         std::uint8_t animState{0};
-        CharacterAnimator animator;
-        bool initialized{false};
     };
 
-    struct SimulatedPlayerState
+    static constexpr std::size_t INTERPOLATION_BUFFER = 16;
+
+    /// Every player's movement, the world step and pickups, as the rollback session runs them
+    class MatchSimulation;
+
+    struct RemotePlayerState
     {
-        RemotePlayerState renderState;
-        std::unique_ptr<IPlayerController> controller;
-        bool active{true};
+        std::string name;
+        /// Decoded snapshots by sequence; the sender deltas against ones we acked
+        std::array<SnapshotRecord, SNAPSHOT_HISTORY> history{};
+        std::uint16_t latestSequence{0};
+        bool hasLatest{false};
+
+        /// Ring of in-order snapshots; the displayed state is sampled from it interpolationDelay behind
+        std::array<TimedSnapshot, INTERPOLATION_BUFFER> buffered{};
+        std::size_t bufferedHead{0};
+        std::size_t bufferedCount{0};
+        std::uint16_t lastSenderMillis{0};
+        /// Sender clock minus mNetworkTime, smoothed; packets arrive scattered around it by jitter
+        double clockOffset{0.0};
+        float jitter{0.0f};
+        float sendInterval{0.25f};
+        float interpolationDelay{0.1f};
+
+        glm::vec3 position{0.0f};
+        float facing{0.0f};
+        bool moving{false};
+        std::uint8_t animState{0};
+        CharacterAnimator animator;
+        bool initialized{false};
     };
 
     void initializeNetwork();
+    /// @brief Send everything through one relay instead of connecting to each discovered peer
+    bool connectToRelay(const std::string &address);
     void initializeOfflineBots();
     void updateOfflineBots(float dt) noexcept;
-    void renderPlayers(const std::unordered_map<std::string, RemotePlayerState> &players) const noexcept;
+    /// Hand remote players and offline bots to the world's instanced skinned-model pass
+    void renderPlayers() const noexcept;
     bool startListener();
     void startRegistration();
-    void pollRegistration();
     void startDiscovery();
-    void pollDiscovery();
+    /// @brief Long-poll the server for lobby join and leave deltas past mLobbyVersion
+    /// @details Once the watch has answered with a delta, discovery polling stops; a failed one sends it
+    /// back to polling until LOBBY_WATCH_RETRY_INTERVAL has passed. Watches are at least
+    /// LOBBY_WATCH_REARM_INTERVAL apart.
+    void startLobbyWatch();
+    /// @brief Hand finished registration, discovery and watch requests to their handlers
+    void pollHttp();
+    void handleRegistrationResponse(const std::string &response);
     void discoverPeers(const std::string &response);
+    void handleLobbyDelta(const HttpClient::Completion &completion);
+    /// Connect to the peers not already known, up to the lobby's maximum
+    void connectToPeers(const std::vector<PeerInfo> &peers);
     void connectToPeer(const PeerInfo &peer);
-    void pollNetwork();
-    void handlePacket(sf::Packet &packet);
+    void pollNetwork(float dt);
+    /// Sample each remote player's snapshot buffer at its render time and drive its animator
+    void updateRemoteInterpolation(float dt) noexcept;
+    /// Buffer a decoded snapshot for interpolation; older than the newest one it is dropped
+    void acceptSnapshot(const std::string &remoteKey, RemotePlayerState &remote, std::uint16_t sequence,
+                        std::uint16_t senderMillis, const PlayerSnapshot &snapshot);
+    void handleRelayPacket(std::int32_t packetType, sf::Packet &packet);
+    /// @param source Key remote players are filed under: the UDP peer or the TCP connection's key
+    /// @param connection The TCP connection it came on, so PLAYER_HELLO can name an accepted one
+    void handlePacket(const std::string &source, sf::Packet &packet, PeerConnection *connection = nullptr);
+    /// @brief Send over UDP where the transport is bound, and over TCP to peers UDP has not reached yet
+    void sendToPeers(sf::Packet &packet, NetTransport::Channel channel);
+    /// Queue for every TCP connection UDP does not cover, one per peer; flushTcp() sends them
+    void sendToTcpFallback(sf::Packet &packet);
+    void flushTcp();
+    static void queueTcp(PeerConnection &connection, const sf::Packet &packet);
+    void sendHello();
+    /// PING every peer; the PONGs feed round-trip time and jitter into mNetStats
+    void sendPing();
+    void handlePing(const std::string &source, sf::Packet &packet, PeerConnection *connection);
+    void handlePong(const std::string &source, sf::Packet &packet);
+    /// Close the stats window: pull the transport's counters, log and export to the profiling trace
+    void publishNetStats(float dt);
+    void drawNetStats() const noexcept;
+    void onSnapshotAcked(const std::string &peer, std::uint16_t datagram) noexcept;
     void sendLocalState(float dt);
     void sendLobbyStatus();
     void checkLobbyReady();
+    /// @brief Start the rollback session once every connected peer has introduced itself
+    /// @details Players are numbered by name order, so every peer agrees without negotiating
+    void startRollbackMatch();
+    void stopRollbackMatch();
+    /// Feed the local move to the session, run its frame and place the local player where it says
+    void updateRollback();
     std::string loadNetworkUrl() const;
     std::vector<PeerInfo> parseActivePlayers(const std::string &json) const;
 
@@ -81,30 +198,61 @@ private:
     unsigned short mLocalPort{0};
     bool mNetworkReady{false};
     float mSendAccumulator{0.0f};
+    SendRateController mSendRate;
     float mRegistrationAccumulator{0.0f};
     float mDiscoveryAccumulator{0.0f};
     bool mInitialNetworkSync{true};
     float mDebugAccumulator{0.0f};
-    float mPacketLogAccumulator{0.0f};
-    size_t mPacketCount{0};
+    NetStats mNetStats;
+    float mNetStatsAccumulator{0.0f};
+    float mPingAccumulator{0.0f};
     bool mRegistrationInFlight{false};
     bool mDiscoveryInFlight{false};
     bool mRegistrationCompleteOnce{false};
-    std::future<std::string> mRegistrationFuture;
-    std::future<std::string> mDiscoveryFuture;
+    HttpClient::RequestId mRegistrationRequest{0};
+    HttpClient::RequestId mDiscoveryRequest{0};
+    bool mLobbyWatchInFlight{false};
+    HttpClient::RequestId mLobbyWatchRequest{0};
+    /// Roster version the last delta brought us to; 0 asks the server for everyone
+    std::uint64_t mLobbyVersion{0};
+    /// The watch is answering, so discovery polling is off
+    bool mLobbyPushActive{false};
+    float mLobbyWatchRetry{0.0f};
+    std::vector<HttpClient::Completion> mHttpCompletions;
 
     sf::TcpListener mListener;
     sf::SocketSelector mSelector;
-    std::vector<std::unique_ptr<sf::TcpSocket>> mPeerSockets;
+    std::vector<PeerConnection> mPeerConnections;
+    /// UDP on the same port number as the listener, so a discovered peer's endpoint is known up front
+    NetTransport mTransport;
+    /// Relay mode: the relay is the only transport peer and remote players are its slots
+    bool mRelayMode{false};
+    std::string mRelayKey;
+    std::size_t mRelayPeerCount{0};
+
+    /// Mesh peers file remote players under their source, so the id only has to be unique per sender
+    std::uint8_t mLocalPlayerId{0};
+    std::uint16_t mSnapshotSequence{0};
+    /// Local clock for snapshot arrival and render times
+    double mNetworkTime{0.0};
+    float mInterpolationDelay{0.1f};
+    std::array<PlayerSnapshot, SNAPSHOT_HISTORY> mSentSnapshots{};
+    std::unordered_map<std::string, SnapshotPeerState> mSnapshotPeers;
+    std::unordered_set<std::string> mGreetedSources;
     std::unordered_map<std::string, RemotePlayerState> mRemotePlayers;
-    std::unordered_map<std::string, SimulatedPlayerState> mOfflineBots;
+    BotPopulation mOfflineBots;
     std::unordered_set<std::string> mKnownPeers;
 
+    /// Mesh matches exchange inputs only and roll back instead of sending snapshots
+    bool mRollbackNetcode{false};
+    std::unique_ptr<MatchSimulation> mMatchSimulation;
+    std::unique_ptr<RollbackSession> mRollback;
+
     // Lobby state
     bool mLobbyReady{false};
     int mConnectedPlayerCount{0};
     int mMinimumPlayers{2}; // 2 for debugging, can be changed to 4
-    int mMaximumPlayers{4};
+    int mMaximumPlayers{4}; // full mesh; a relay raises it to RelayServer::MAX_CLIENTS
     float mLobbyStatusAccumulator{0.0f};
 
     // Local AI fallback mode (single-player + bots) before online lobby fills.
@@ -1,114 +1,401 @@
 #include "MusicPlayer.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <SFML/Audio.hpp>
 #include <SFML/Audio/Listener.hpp>
 
 #include <SDL3/SDL.h>
 
+#include "AssetPack.hpp"
+#include "CPUProfiler.hpp"
+
+namespace
+{
+    // How long one track takes to fade in or out; a switch overlaps both
+    constexpr float CROSSFADE_SECONDS = 1.5f;
+    constexpr std::chrono::milliseconds MIXER_TICK{10};
+    // A playing track whose offset has not moved for this long has run out of decoded audio
+    constexpr float STALL_SECONDS = 0.25f;
+
+    std::atomic<std::uint32_t> sUnderruns{0};
+}
+
 class MusicPlayer::Impl
 {
 public:
-    Impl() : mVolume{100.f}, mLoop{false}
+    /// What the game asked for; the mixer thread moves the sf::Music there
+    enum class Target : std::uint8_t
     {
-        // Ensure SFML global volume is at maximum
-        sf::Listener::setGlobalVolume(100.f);
-    }
+        STOPPED,
+        PLAYING,
+        PAUSED,
+        /// Started silently and paused once its buffers are queued, so play() starts instantly
+        PREFETCHED
+    };
 
-    bool openFromFile(std::string_view filename)
-    {        
-        if (auto result = mMusic.openFromFile(std::string(filename)))
-        {            
-            // Make music non-spatialized (always at full volume regardless of listener position)
-            mMusic.setRelativeToListener(true);
-            
-            return true;
-        }
-        else
-        {
-            SDL_LogError(SDL_LOG_CATEGORY_AUDIO,
-                         "MusicPlayer: Failed to open: %s", filename.data());
-            SDL_LogError(SDL_LOG_CATEGORY_AUDIO,
-                         "MusicPlayer: This could mean: file not found, unsupported format, or corrupted file");
-        }
-        return false;
-    }
+    Impl();
+    ~Impl();
 
-    void play() noexcept
-    {        
-        mMusic.play();
+    bool openFromFile(std::string_view filename);
 
-        if (auto status = mMusic.getStatus(); status != sf::Music::Status::Playing)
-        {
-            SDL_LogWarn(SDL_LOG_CATEGORY_AUDIO,
-                        "MusicPlayer: ⚠ Music did not start playing!");
-            SDL_LogWarn(SDL_LOG_CATEGORY_AUDIO,
-                        "  Status: %d (expected 2 for Playing)", static_cast<int>(status));
-            SDL_LogWarn(SDL_LOG_CATEGORY_AUDIO,
-                        "  Possible causes: audio device unavailable, audio system stopped, or file issue");
-        }
-    }
+    void play() noexcept;
 
     void stop() noexcept
     {
-        mMusic.stop();
+        mTarget.store(Target::STOPPED, std::memory_order_release);
+    }
+
+    void prefetch() noexcept
+    {
+        auto expected = Target::STOPPED;
+        mTarget.compare_exchange_strong(expected, Target::PREFETCHED, std::memory_order_acq_rel);
     }
 
     void setVolume(float volume) noexcept
     {
-        mVolume = volume;
-        mMusic.setVolume(volume);
+        mVolume.store(volume, std::memory_order_relaxed);
     }
 
     void setLoop(bool loop) noexcept
     {
-        mLoop = loop;
-        mMusic.setLooping(loop);
+        mLoop.store(loop, std::memory_order_relaxed);
     }
 
     void setPaused(bool paused) noexcept
     {
-        if (paused)
-        {
-            mMusic.pause();
-        }
-        else
-        {
-            mMusic.play();
-        }
+        mTarget.store(paused ? Target::PAUSED : Target::PLAYING, std::memory_order_release);
     }
 
     bool isPlaying() const noexcept
     {
-        auto status = mMusic.getStatus();
-        bool playing = (status == sf::Music::Status::Playing);
-        // Only log on state changes to reduce spam
-        static sf::Music::Status lastLoggedStatus = sf::Music::Status::Stopped;
-        if (status != lastLoggedStatus)
-        {
-            lastLoggedStatus = status;
-        }
-        return playing;
+        return mTarget.load(std::memory_order_acquire) == Target::PLAYING;
     }
 
-    void print() const noexcept {
+    void print() const noexcept
+    {
+        std::lock_guard<std::mutex> lock(mMusicMutex);
         auto status = mMusic.getStatus();
         SDL_Log("MusicPlayer: Status: %s", status == sf::Music::Status::Playing ? "Playing" :
                                     status == sf::Music::Status::Paused ? "Paused" : "Stopped");
-        SDL_Log("MusicPlayer: Looping? %s", mLoop ? "Yes" : "No");
-        SDL_Log("MusicPlayer: Volume: %.2f", mVolume);
+        SDL_Log("MusicPlayer: Looping? %s", mLoop.load() ? "Yes" : "No");
+        SDL_Log("MusicPlayer: Volume: %.2f", mVolume.load());
         SDL_Log("MusicPlayer: Duration: %.2f seconds", mMusic.getDuration().asSeconds());
         SDL_Log("MusicPlayer: Channel count: %u", mMusic.getChannelCount());
         SDL_Log("MusicPlayer: Sample rate: %u Hz", mMusic.getSampleRate());
     }
 
+    /// @brief Advance fades and follow the target; mixer thread only
+    void mix(float dt);
+
+    /// Every other track starts fading out when this one is asked to play
+    void fadeOutOthers() noexcept;
+
 private:
     sf::Music mMusic;
-    float mVolume;
-    bool mLoop;
+    /// Held by the mixer while it touches mMusic and by openFromFile(), which replaces it
+    mutable std::mutex mMusicMutex;
+    bool mOpen{false};
+
+    std::atomic<Target> mTarget{Target::STOPPED};
+    std::atomic<float> mVolume{100.f};
+    std::atomic<bool> mLoop{false};
+
+    // Mixer thread only
+    float mFade{0.f};
+    bool mStarted{false};
+    float mLastOffset{0.f};
+    float mStalledFor{0.f};
+    bool mStallCounted{false};
 };
 
+namespace
+{
+    /// @brief One thread that starts, stops and fades every registered track
+    /// @details sf::Music::stop() joins SFML's streaming thread and play() opens the device, so neither
+    /// runs on the main thread: a state switch only records a target and the mixer does the rest.
+    class MusicMixer
+    {
+    public:
+        static MusicMixer &instance()
+        {
+            static MusicMixer mixer;
+            return mixer;
+        }
+
+        void add(MusicPlayer::Impl *track)
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mTracks.push_back(track);
+            if (!mThread.joinable())
+            {
+                mStopping = false;
+                mThread = std::thread([this]
+                                      { run(); });
+            }
+        }
+
+        void remove(MusicPlayer::Impl *track)
+        {
+            std::thread finished;
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                std::erase(mTracks, track);
+                // A tick already running mixes from its own copy of the list, which may still hold the track
+                const std::uint64_t tick = mTick;
+                mMixed.wait(lock, [this, tick]
+                            { return !mMixing || mTick != tick; });
+                if (mTracks.empty() && mThread.joinable())
+                {
+                    mStopping = true;
+                    finished = std::move(mThread);
+                }
+            }
+            mWake.notify_all();
+            if (finished.joinable())
+            {
+                finished.join();
+            }
+        }
+
+        template <typename Fn>
+        void forEachOther(const MusicPlayer::Impl *track, Fn &&fn)
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            for (MusicPlayer::Impl *other : mTracks)
+            {
+                if (other != track)
+                {
+                    fn(*other);
+                }
+            }
+        }
+
+    private:
+        MusicMixer() = default;
+
+        ~MusicMixer()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mStopping = true;
+            }
+            mWake.notify_all();
+            if (mThread.joinable())
+            {
+                mThread.join();
+            }
+        }
+
+        void run()
+        {
+            BW_PROFILE_THREAD("Music mixer");
+            auto last = std::chrono::steady_clock::now();
+            std::vector<MusicPlayer::Impl *> tracks;
+            std::unique_lock<std::mutex> lock(mMutex);
+            while (!mStopping)
+            {
+                mWake.wait_for(lock, MIXER_TICK, [this]
+                               { return mStopping; });
+                const auto now = std::chrono::steady_clock::now();
+                const float dt = std::chrono::duration<float>(now - last).count();
+                last = now;
+
+                // mix() may open the device or join a stream thread, so the list is not held meanwhile
+                tracks = mTracks;
+                mMixing = true;
+                lock.unlock();
+                for (MusicPlayer::Impl *track : tracks)
+                {
+                    track->mix(dt);
+                }
+                lock.lock();
+                mMixing = false;
+                ++mTick;
+                mMixed.notify_all();
+            }
+        }
+
+        std::mutex mMutex;
+        std::condition_variable mWake;
+        /// Signalled when a tick has finished with its copy of mTracks
+        std::condition_variable mMixed;
+        std::vector<MusicPlayer::Impl *> mTracks;
+        bool mMixing{false};
+        std::uint64_t mTick{0};
+        bool mStopping{false};
+        std::thread mThread;
+    };
+}
+
+MusicPlayer::Impl::Impl()
+{
+    // Ensure SFML global volume is at maximum
+    sf::Listener::setGlobalVolume(100.f);
+    MusicMixer::instance().add(this);
+}
+
+MusicPlayer::Impl::~Impl()
+{
+    // After this the mixer never touches the track again, so mMusic can go
+    MusicMixer::instance().remove(this);
+    std::lock_guard<std::mutex> lock(mMusicMutex);
+    mMusic.stop();
+}
+
+bool MusicPlayer::Impl::openFromFile(std::string_view filename)
+{
+    std::lock_guard<std::mutex> lock(mMusicMutex);
+    mOpen = false;
+    mStarted = false;
+    // A packed track streams from the mapping, which stays mounted for the whole run
+    const auto packed = AssetPack::find(filename);
+    const bool opened = packed.empty() ? mMusic.openFromFile(std::string(filename))
+                                       : mMusic.openFromMemory(packed.data(), packed.size());
+    if (opened)
+    {
+        // Make music non-spatialized (always at full volume regardless of listener position)
+        mMusic.setRelativeToListener(true);
+        mMusic.setVolume(0.f);
+        mOpen = true;
+
+        return true;
+    }
+    else
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_AUDIO,
+                     "MusicPlayer: Failed to open: %s", filename.data());
+        SDL_LogError(SDL_LOG_CATEGORY_AUDIO,
+                     "MusicPlayer: This could mean: file not found, unsupported format, or corrupted file");
+    }
+    return false;
+}
+
+void MusicPlayer::Impl::play() noexcept
+{
+    // SFML restarts a track that is already playing; a repeated request keeps it going instead
+    mTarget.store(Target::PLAYING, std::memory_order_release);
+    fadeOutOthers();
+}
+
+void MusicPlayer::Impl::fadeOutOthers() noexcept
+{
+    MusicMixer::instance().forEachOther(this, [](MusicPlayer::Impl &other)
+                                        {
+        auto expected = Target::PLAYING;
+        other.mTarget.compare_exchange_strong(expected, Target::STOPPED, std::memory_order_acq_rel); });
+}
+
+void MusicPlayer::Impl::mix(float dt)
+{
+    std::lock_guard<std::mutex> lock(mMusicMutex);
+    if (!mOpen)
+    {
+        return;
+    }
+
+    const Target target = mTarget.load(std::memory_order_acquire);
+    const bool loop = mLoop.load(std::memory_order_relaxed);
+    mMusic.setLooping(loop);
+    const auto status = mMusic.getStatus();
+    const float fadeStep = dt / CROSSFADE_SECONDS;
+
+    switch (target)
+    {
+    case Target::PLAYING:
+        if (status != sf::Music::Status::Playing)
+        {
+            if (mStarted && status == sf::Music::Status::Stopped && !loop)
+            {
+                // Reached the end of a one-shot track
+                mStarted = false;
+                mTarget.store(Target::STOPPED, std::memory_order_release);
+                break;
+            }
+            if (mStarted && status == sf::Music::Status::Stopped)
+            {
+                sUnderruns.fetch_add(1, std::memory_order_relaxed);
+                SDL_LogWarn(SDL_LOG_CATEGORY_AUDIO, "MusicPlayer: Stream stopped while playing, restarting");
+            }
+            mMusic.play();
+            mStarted = true;
+            mLastOffset = mMusic.getPlayingOffset().asSeconds();
+            mStalledFor = 0.f;
+        }
+        mFade = std::min(1.f, mFade + fadeStep);
+        break;
+
+    case Target::PREFETCHED:
+        mFade = 0.f;
+        if (status == sf::Music::Status::Stopped)
+        {
+            mMusic.setVolume(0.f);
+            mMusic.play();
+        }
+        else if (status == sf::Music::Status::Playing && mMusic.getPlayingOffset().asSeconds() > 0.f)
+        {
+            // The stream thread has queued its buffers; hold them until play()
+            mMusic.pause();
+        }
+        mStarted = false;
+        break;
+
+    case Target::PAUSED:
+    case Target::STOPPED:
+        mFade = std::max(0.f, mFade - fadeStep);
+        if (mFade <= 0.f && status == sf::Music::Status::Playing)
+        {
+            if (target == Target::PAUSED)
+            {
+                mMusic.pause();
+            }
+            else
+            {
+                mMusic.stop();
+            }
+        }
+        else if (mFade <= 0.f && target == Target::STOPPED && status == sf::Music::Status::Paused)
+        {
+            mMusic.stop();
+        }
+        mStarted = status == sf::Music::Status::Playing;
+        break;
+    }
+
+    mMusic.setVolume(mVolume.load(std::memory_order_relaxed) * mFade);
+
+    // Starved stream: Playing, but the offset stands still
+    if (target == Target::PLAYING && mMusic.getStatus() == sf::Music::Status::Playing)
+    {
+        const float offset = mMusic.getPlayingOffset().asSeconds();
+        if (offset == mLastOffset)
+        {
+            mStalledFor += dt;
+            if (mStalledFor >= STALL_SECONDS && !mStallCounted)
+            {
+                mStallCounted = true;
+                sUnderruns.fetch_add(1, std::memory_order_relaxed);
+                SDL_LogWarn(SDL_LOG_CATEGORY_AUDIO, "MusicPlayer: Buffer underrun, stream stalled %.0f ms", mStalledFor * 1000.f);
+            }
+        }
+        else
+        {
+            mStalledFor = 0.f;
+            mStallCounted = false;
+        }
+        mLastOffset = offset;
+    }
+    BW_PROFILE_COUNTER("Music underruns", sUnderruns.load(std::memory_order_relaxed));
+}
+
 // MusicPlayer public API
 
 MusicPlayer::MusicPlayer()
@@ -131,6 +418,11 @@ void MusicPlayer::play() noexcept
     mImpl->play();
 }
 
+void MusicPlayer::prefetch() noexcept
+{
+    mImpl->prefetch();
+}
+
 void MusicPlayer::stop() noexcept
 {
     mImpl->stop();
@@ -159,4 +451,9 @@ bool MusicPlayer::isPlaying() const noexcept
 void MusicPlayer::print() const noexcept
 {
     mImpl->print();
-}
\ No newline at end of file
+}
+
+std::uint32_t MusicPlayer::getUnderrunCount() noexcept
+{
+    return sUnderruns.load(std::memory_order_relaxed);
+}
@@ -1,11 +1,17 @@
 #ifndef MUSICPLAYER_HPP
 #define MUSICPLAYER_HPP
 
+#include <cstdint>
 #include <memory>
 #include <string_view>
 
 #include "ResourceIdentifiers.hpp"
 
+/// @brief One background music track, streamed by SFML
+/// @details Playback is driven by a shared mixer thread: play(), stop() and setPaused() only set a
+/// target, and the mixer fades the track there. Playing one track fades out every other, so a state
+/// switch is a crossfade with no gap and no stream start or stop on the calling thread. The mixer
+/// also restarts a stream that stopped on its own and counts stalls as underruns.
 class MusicPlayer
 {
 public:
@@ -26,10 +32,13 @@ public:
     /// @return true if the file was loaded successfully
     bool openFromFile(std::string_view filename);
 
-    /// @brief Play the loaded music
+    /// @brief Fade the loaded music in, fading out whichever track was playing
     void play() noexcept;
 
-    /// @brief Stop playing music
+    /// @brief Start streaming silently and hold the queued buffers, so a later play() is instant
+    void prefetch() noexcept;
+
+    /// @brief Fade out, then stop
     void stop() noexcept;
 
     /// @brief Set the music volume
@@ -45,14 +54,18 @@ public:
     void setPaused(bool paused) noexcept;
 
     /// @brief Check if the music is currently playing
-    /// @return true if playing
+    /// @return true if playing or fading in
     bool isPlaying() const noexcept;
 
     /// @brief Print music information for debugging
     void print() const noexcept;
 
-private:
+    /// @brief Times any track ran dry or stopped by itself since startup
+    [[nodiscard]] static std::uint32_t getUnderrunCount() noexcept;
+
     class Impl;
+
+private:
     std::unique_ptr<Impl> mImpl;
 };
 
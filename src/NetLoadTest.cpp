@@ -0,0 +1,520 @@
+#include "NetLoadTest.hpp"
+
+#include "Animation.hpp"
+#include "JSONUtils.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <optional>
+#include <utility>
+
+namespace
+{
+    constexpr float kRegistrationInterval = 15.0f;
+    constexpr float kDiscoveryInterval = 5.0f;
+    constexpr std::size_t kMaxTcpPacketsPerPoll = 256;
+    // A stamp this far off came from a clock outside the harness, i.e. a real client
+    constexpr float kMaxLatencyMs = 5000.0f;
+
+    using Clock = std::chrono::steady_clock;
+
+    double millisSince(Clock::time_point start) noexcept
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    std::string makeRemoteKey(const std::string &source, std::uint8_t playerId)
+    {
+        return source + "#" + std::to_string(playerId);
+    }
+
+    /// Hand each packet of a MESSAGE_BATCH frame (read past its type) to fn, as MultiplayerGameState does
+    template <typename Fn>
+    void forEachBatched(sf::Packet &frame, Fn &&fn)
+    {
+        std::uint16_t count = 0;
+        if (!(frame >> count))
+        {
+            return;
+        }
+
+        const auto *bytes = static_cast<const std::uint8_t *>(frame.getData());
+        std::size_t offset = frame.getReadPosition();
+        const std::size_t end = frame.getDataSize();
+        for (std::uint16_t i = 0; i < count && offset + 4 <= end; ++i)
+        {
+            const std::size_t size = (static_cast<std::size_t>(bytes[offset]) << 24) | (static_cast<std::size_t>(bytes[offset + 1]) << 16) |
+                                     (static_cast<std::size_t>(bytes[offset + 2]) << 8) | bytes[offset + 3];
+            offset += 4;
+            if (offset + size > end)
+            {
+                return;
+            }
+
+            sf::Packet message;
+            message.append(bytes + offset, size);
+            offset += size;
+            fn(message);
+        }
+    }
+
+    float percentile(const std::vector<float> &sorted, float fraction) noexcept
+    {
+        if (sorted.empty())
+        {
+            return 0.0f;
+        }
+        const auto index = static_cast<std::size_t>(fraction * static_cast<float>(sorted.size() - 1) + 0.5f);
+        return sorted[std::min(index, sorted.size() - 1)];
+    }
+} // namespace
+
+NetLoadTest::NetLoadTest(Config config)
+    : mConfig{std::move(config)}
+{
+}
+
+NetLoadTest::~NetLoadTest() = default;
+
+bool NetLoadTest::start()
+{
+    std::optional<sf::IpAddress> relayIp;
+    unsigned short relayPort = 0;
+    if (!mConfig.relayAddress.empty())
+    {
+        const auto colon = mConfig.relayAddress.rfind(':');
+        const int port = colon == std::string::npos ? 0 : std::atoi(mConfig.relayAddress.c_str() + colon + 1);
+        relayIp = sf::IpAddress::resolve(mConfig.relayAddress.substr(0, colon));
+        if (!relayIp || port <= 0 || port > 65535)
+        {
+            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "WARN: NetLoadTest: Bad relay address '%s'", mConfig.relayAddress.c_str());
+            return false;
+        }
+        relayPort = static_cast<unsigned short>(port);
+        mRelayKey = NetTransport::makePeerKey(*relayIp, relayPort);
+    }
+
+    mClients.reserve(mConfig.peers);
+    for (std::size_t i = 0; i < mConfig.peers; ++i)
+    {
+        auto client = std::make_unique<SimulatedClient>(1337u + static_cast<std::uint32_t>(17 * i));
+        if (!startClient(*client))
+        {
+            continue;
+        }
+        // Spread out along the lanes so relevance filtering sees a realistic crowd
+        client->position = glm::vec3(static_cast<float>(i) * 13.0f, 1.0f, ((i % 2 == 0) ? -1.0f : 1.0f) * 5.0f);
+        mClients.push_back(std::move(client));
+    }
+
+    if (mClients.empty())
+    {
+        return false;
+    }
+
+    if (relayIp)
+    {
+        for (auto &client : mClients)
+        {
+            connect(*client, *relayIp, relayPort);
+        }
+    }
+    else if (mConfig.networkUrl.empty())
+    {
+        // No server to discover through: each client meets the next few, and they adopt it back
+        const std::size_t count = mClients.size();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            for (std::size_t k = 1; k <= std::min(mConfig.meshPeers, count - 1); ++k)
+            {
+                connect(*mClients[i], sf::IpAddress::LocalHost, mClients[(i + k) % count]->port);
+            }
+        }
+    }
+
+    SDL_Log("NetLoadTest: %zu simulated clients, %s", mClients.size(),
+            !mRelayKey.empty() ? "through the relay" : (mConfig.networkUrl.empty() ? "local mesh" : "server discovery"));
+    return true;
+}
+
+bool NetLoadTest::startClient(SimulatedClient &client)
+{
+    // Same port for TCP and UDP, as a real client listens
+    if (client.listener.listen(0) != sf::Socket::Status::Done)
+    {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "WARN: NetLoadTest: Failed to start a listener");
+        return false;
+    }
+    client.listener.setBlocking(false);
+    client.port = client.listener.getLocalPort();
+    if (!client.transport.bind(client.port))
+    {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "WARN: NetLoadTest: UDP port %u unavailable", client.port);
+        client.listener.close();
+        return false;
+    }
+    client.name = "loadtest_" + std::to_string(client.port);
+
+    if (!mConfig.networkUrl.empty())
+    {
+        client.http = std::make_unique<HttpClient>();
+        client.http->setServerURL(mConfig.networkUrl);
+        // Register on the first update
+        client.registrationAccumulator = kRegistrationInterval;
+    }
+    return true;
+}
+
+void NetLoadTest::update(float dt)
+{
+    mElapsedSeconds += dt;
+
+    for (auto &client : mClients)
+    {
+        if (client->http)
+        {
+            updateHttp(*client, dt);
+        }
+
+        poll(*client, dt);
+        move(*client, dt);
+        sendState(*client, dt);
+        client->transport.flush();
+
+        std::size_t inFlight = 0;
+        for (const auto &key : client->transport.getPeerKeys())
+        {
+            inFlight += client->transport.getBytesInFlight(key);
+        }
+        client->counters.bytesInFlightSum += inFlight;
+        client->counters.bytesInFlightPeak = std::max(client->counters.bytesInFlightPeak, inFlight);
+    }
+}
+
+void NetLoadTest::updateHttp(SimulatedClient &client, float dt)
+{
+    client.registrationAccumulator += dt;
+    if (client.registrationAccumulator >= kRegistrationInterval && client.registration == 0)
+    {
+        client.registrationAccumulator = 0.0f;
+        const std::string payload = "{\"player_name\":\"" + client.name + "\",\"port\":" + std::to_string(client.port) + "}";
+        client.registration = client.http->postAsync("/mazes/networks/data", payload);
+    }
+
+    client.discoveryAccumulator += dt;
+    if (client.registered && client.discoveryAccumulator >= kDiscoveryInterval && client.discovery == 0)
+    {
+        client.discoveryAccumulator = 0.0f;
+        client.discovery = client.http->getAsync("/mazes/networks/data");
+    }
+
+    std::vector<HttpClient::Completion> completions;
+    client.http->pollCompletions(completions);
+    for (const auto &completion : completions)
+    {
+        if (completion.id == client.registration)
+        {
+            client.registration = 0;
+            client.registered = client.registered || completion.ok;
+        }
+        else if (completion.id == client.discovery)
+        {
+            client.discovery = 0;
+            if (!completion.ok || !mRelayKey.empty())
+            {
+                continue;
+            }
+
+            JSONUtils::parsePeerRecords(completion.body, [this, &client](const JSONUtils::PeerRecord &record)
+                                        {
+                if (record.port == 0 || record.port == client.port || client.transport.getPeerCount() >= mConfig.meshPeers)
+                {
+                    return;
+                }
+                const auto ip = sf::IpAddress::resolve(record.ip).value_or(sf::IpAddress::LocalHost);
+                if (!client.transport.hasPeer(NetTransport::makePeerKey(ip, record.port)))
+                {
+                    connect(client, ip, record.port);
+                } });
+        }
+    }
+}
+
+void NetLoadTest::connect(SimulatedClient &client, const sf::IpAddress &ip, unsigned short port)
+{
+    // UDP only: a real client adopts the first datagram from us and answers on it
+    client.transport.addPeer(NetTransport::makePeerKey(ip, port), ip, port);
+    sendHello(client);
+}
+
+void NetLoadTest::sendHello(SimulatedClient &client)
+{
+    sf::Packet packet;
+    packet << static_cast<std::int32_t>(HttpClient::PacketType::PLAYER_HELLO)
+           << std::uint8_t{0} << client.name << static_cast<std::uint16_t>(client.port);
+    client.transport.broadcast(packet, NetTransport::Channel::RELIABLE);
+}
+
+void NetLoadTest::poll(SimulatedClient &client, float dt)
+{
+    const auto pollStart = Clock::now();
+
+    client.transport.update(dt,
+        [this, &client](const std::string &peer, sf::Packet &message)
+        {
+            handleMessage(client, peer, message);
+        },
+        [&client](const std::string &peer, std::uint16_t datagram)
+        {
+            auto &acks = client.acks[peer];
+            const auto &entry = acks.inFlight[datagram % acks.inFlight.size()];
+            if (entry.valid && entry.datagram == datagram &&
+                (!acks.hasAcked || NetTransport::sequenceGreater(entry.snapshot, acks.ackedSnapshot)))
+            {
+                acks.ackedSnapshot = entry.snapshot;
+                acks.hasAcked = true;
+            }
+        });
+
+    // Real clients connect over TCP first; keep those connections and read whatever they fall back to
+    while (true)
+    {
+        auto socket = std::make_unique<sf::TcpSocket>();
+        if (client.listener.accept(*socket) != sf::Socket::Status::Done)
+        {
+            break;
+        }
+        socket->setBlocking(false);
+        client.connections.push_back(std::move(socket));
+    }
+
+    for (auto it = client.connections.begin(); it != client.connections.end();)
+    {
+        sf::TcpSocket &socket = **it;
+        const std::string source = "tcp:" + NetTransport::makePeerKey(
+            socket.getRemoteAddress().value_or(sf::IpAddress::LocalHost), socket.getRemotePort());
+
+        auto status = sf::Socket::Status::NotReady;
+        for (std::size_t received = 0; received < kMaxTcpPacketsPerPoll; ++received)
+        {
+            sf::Packet packet;
+            status = socket.receive(packet);
+            if (status != sf::Socket::Status::Done)
+            {
+                break;
+            }
+            client.counters.bytesIn += packet.getDataSize();
+
+            std::int32_t packetType = 0;
+            sf::Packet peek = packet;
+            if ((peek >> packetType) && packetType == static_cast<std::int32_t>(HttpClient::PacketType::MESSAGE_BATCH))
+            {
+                forEachBatched(peek, [&](sf::Packet &message)
+                               { handleMessage(client, source, message); });
+            }
+            else
+            {
+                handleMessage(client, source, packet);
+            }
+        }
+
+        if (status == sf::Socket::Status::Disconnected)
+        {
+            it = client.connections.erase(it);
+            continue;
+        }
+        ++it;
+    }
+
+    const double pollMs = millisSince(pollStart);
+    client.counters.pollMs += pollMs;
+    client.counters.worstPollMs = std::max(client.counters.worstPollMs, pollMs);
+    ++client.counters.polls;
+}
+
+void NetLoadTest::handleMessage(SimulatedClient &client, const std::string &source, sf::Packet &message)
+{
+    const auto handleStart = Clock::now();
+    ++client.counters.messages;
+
+    std::int32_t packetType = 0;
+    if (!(message >> packetType))
+    {
+        return;
+    }
+
+    if (packetType == static_cast<std::int32_t>(HttpClient::PacketType::POSITION_UPDATE))
+    {
+        std::uint8_t playerId = 0;
+        std::uint16_t sequence = 0;
+        std::uint16_t senderMillis = 0;
+        std::uint8_t baselineDistance = 0;
+        if (message >> playerId >> sequence >> senderMillis >> baselineDistance)
+        {
+            auto &history = client.received[makeRemoteKey(source, playerId)];
+            PlayerSnapshot baseline;
+            bool usable = true;
+            if (baselineDistance != 0)
+            {
+                const auto baselineSequence = static_cast<std::uint16_t>(sequence - baselineDistance);
+                const auto &record = history[baselineSequence % SNAPSHOT_HISTORY];
+                usable = record.valid && record.sequence == baselineSequence;
+                baseline = record.snapshot;
+            }
+
+            PlayerSnapshot snapshot;
+            if (usable && PlayerSnapshot::read(message, baseline, snapshot))
+            {
+                history[sequence % SNAPSHOT_HISTORY] = SnapshotRecord{sequence, snapshot, true};
+                recordLatency(senderMillis);
+            }
+        }
+    }
+    else if (packetType == static_cast<std::int32_t>(HttpClient::PacketType::RELAY_SNAPSHOT))
+    {
+        std::uint8_t count = 0;
+        message >> count;
+        for (std::uint8_t i = 0; i < count; ++i)
+        {
+            std::uint8_t slot = 0;
+            std::uint16_t sequence = 0;
+            std::uint16_t senderMillis = 0;
+            PlayerSnapshot snapshot;
+            if (!(message >> slot >> sequence >> senderMillis) || !PlayerSnapshot::read(message, PlayerSnapshot{}, snapshot))
+            {
+                break;
+            }
+            recordLatency(senderMillis);
+        }
+    }
+    else if (packetType == static_cast<std::int32_t>(HttpClient::PacketType::PING))
+    {
+        std::uint32_t senderMillis = 0;
+        if (message >> senderMillis)
+        {
+            sf::Packet pong;
+            pong << static_cast<std::int32_t>(HttpClient::PacketType::PONG) << senderMillis;
+            client.transport.send(source, pong, NetTransport::Channel::UNRELIABLE);
+        }
+    }
+
+    client.counters.handleMs += millisSince(handleStart);
+}
+
+void NetLoadTest::recordLatency(std::uint16_t senderMillis)
+{
+    // Every harness client stamps with the same clock; the 16-bit stamp is read relative to now
+    const auto elapsed = static_cast<std::uint16_t>(static_cast<std::uint16_t>(SDL_GetTicks() & 0xFFFFu) - senderMillis);
+    const auto latencyMs = static_cast<float>(elapsed);
+    if (latencyMs <= kMaxLatencyMs)
+    {
+        mLatencies.push_back(latencyMs);
+    }
+    ++mSnapshotsIn;
+}
+
+void NetLoadTest::move(SimulatedClient &client, float dt)
+{
+    MatchWorldSnapshot world;
+    world.localPlayerPosition = client.position;
+    world.runnerSpeed = mConfig.runnerSpeed;
+    world.strafeLimit = mConfig.strafeLimit;
+    world.elapsedSeconds = mElapsedSeconds;
+
+    // Same integration as the offline bots in MultiplayerGameState
+    const PlayerCommand command = client.controller.sample(world, client.position, dt);
+    client.position.x += world.runnerSpeed * std::clamp(command.forwardScale, 0.65f, 1.25f) * dt;
+    const float maxStrafeStep = world.runnerSpeed * 0.85f * dt;
+    const float dz = std::clamp(command.targetZ - client.position.z, -maxStrafeStep, maxStrafeStep);
+    client.position.z = std::clamp(client.position.z + dz, -world.strafeLimit, world.strafeLimit);
+}
+
+void NetLoadTest::sendState(SimulatedClient &client, float dt)
+{
+    if (client.transport.getPeerCount() == 0)
+    {
+        return;
+    }
+
+    const auto snapshot = PlayerSnapshot::quantize(client.position, 0.0f, true,
+                                                   static_cast<std::uint8_t>(CharacterAnimState::WALK_FORWARD));
+    client.sendAccumulator += dt;
+    if (client.sendAccumulator < client.sendRate.getInterval(client.position, 0.0f, snapshot))
+    {
+        return;
+    }
+    client.sendAccumulator = 0.0f;
+    client.sendRate.onSent(client.position, 0.0f, snapshot);
+
+    const std::uint16_t sequence = client.snapshotSequence++;
+    client.sentSnapshots[sequence % SNAPSHOT_HISTORY] = snapshot;
+    const auto senderMillis = static_cast<std::uint16_t>(SDL_GetTicks() & 0xFFFFu);
+
+    for (const auto &key : client.transport.getPeerKeys())
+    {
+        auto &acks = client.acks[key];
+        const PlayerSnapshot *baseline = nullptr;
+        std::uint8_t baselineDistance = 0;
+        if (acks.hasAcked)
+        {
+            const auto age = static_cast<std::uint16_t>(sequence - acks.ackedSnapshot);
+            if (age > 0 && age < SNAPSHOT_HISTORY)
+            {
+                baseline = &client.sentSnapshots[acks.ackedSnapshot % SNAPSHOT_HISTORY];
+                baselineDistance = static_cast<std::uint8_t>(age);
+            }
+        }
+
+        sf::Packet packet;
+        packet << static_cast<std::int32_t>(HttpClient::PacketType::POSITION_UPDATE)
+               << std::uint8_t{0} << sequence << senderMillis << baselineDistance;
+        snapshot.write(packet, baseline);
+
+        std::uint16_t datagram = 0;
+        if (client.transport.send(key, packet, NetTransport::Channel::UNRELIABLE, &datagram))
+        {
+            acks.inFlight[datagram % acks.inFlight.size()] = {datagram, sequence, true};
+        }
+    }
+    ++client.counters.snapshotsOut;
+}
+
+void NetLoadTest::report()
+{
+    std::sort(mLatencies.begin(), mLatencies.end());
+    SDL_Log("NetLoadTest: %.1f s, %zu snapshots in, latency ms p50=%.1f p90=%.1f p99=%.1f max=%.1f",
+            mElapsedSeconds, mSnapshotsIn, percentile(mLatencies, 0.5f), percentile(mLatencies, 0.9f),
+            percentile(mLatencies, 0.99f), mLatencies.empty() ? 0.0f : mLatencies.back());
+    mLatencies.clear();
+    mSnapshotsIn = 0;
+
+    double totalPollMs = 0.0;
+    double worstPollMs = 0.0;
+    for (auto &client : mClients)
+    {
+        for (const auto &key : client->transport.getPeerKeys())
+        {
+            const auto transport = client->transport.takeCounters(key);
+            client->counters.bytesIn += transport.bytesIn;
+            client->counters.bytesOut += transport.bytesOut;
+        }
+
+        const ClientCounters &c = client->counters;
+        const double polls = static_cast<double>(std::max<std::size_t>(c.polls, 1));
+        SDL_Log("NetLoadTest:   %s peers=%zu poll=%.3f ms avg %.3f ms worst handle=%.2f us/msg msgs=%zu "
+                "snapshots out=%zu in=%zu B out=%zu B in flight=%.0f B avg %zu B peak",
+                client->name.c_str(), client->transport.getPeerCount(), c.pollMs / polls, c.worstPollMs,
+                c.messages > 0 ? c.handleMs * 1000.0 / static_cast<double>(c.messages) : 0.0, c.messages,
+                c.snapshotsOut, c.bytesIn, c.bytesOut, static_cast<double>(c.bytesInFlightSum) / polls,
+                c.bytesInFlightPeak);
+
+        totalPollMs += c.pollMs;
+        worstPollMs = std::max(worstPollMs, c.worstPollMs);
+        client->counters = ClientCounters{};
+    }
+    SDL_Log("NetLoadTest: all clients poll=%.1f ms total, %.3f ms worst single poll", totalPollMs, worstPollMs);
+}
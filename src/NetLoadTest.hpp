@@ -0,0 +1,151 @@
+#ifndef NET_LOAD_TEST_HPP
+#define NET_LOAD_TEST_HPP
+
+#include "HttpClient.hpp"
+#include "MatchController.hpp"
+#include "NetTransport.hpp"
+#include "PlayerSnapshot.hpp"
+#include "SendRateController.hpp"
+
+#include <SFML/Network.hpp>
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// @brief Simulated multiplayer clients in one process, for stressing the lobby and POSITION_UPDATE path
+/// @details Each peer is a client as far as the wire is concerned: it listens on TCP and binds UDP on
+/// the same port, registers with the network server and connects to the peers discovery returns (or,
+/// without a server, to its neighbours in the harness; or to a relay). A LaneAIController drives its
+/// runner and SendRateController paces its delta-encoded snapshots, so traffic matches a real client.
+///
+/// Every peer shares SDL_GetTicks(), so the senderMillis stamp in a received snapshot gives its
+/// end-to-end latency directly. The report covers those percentiles, each client's CPU time in its
+/// receive poll and packet handling, and the bytes it had in flight.
+class NetLoadTest
+{
+public:
+    /// Peers a simulated client connects to without a network server, like a full four-player mesh
+    static constexpr std::size_t DEFAULT_MESH_PEERS = 3;
+    static constexpr float REPORT_INTERVAL = 5.0f;
+
+    struct Config
+    {
+        std::size_t peers{8};
+        /// Empty: peers connect to their harness neighbours instead of registering
+        std::string networkUrl;
+        /// "host:port" of a RelayServer; empty keeps the peer mesh
+        std::string relayAddress;
+        std::size_t meshPeers{DEFAULT_MESH_PEERS};
+        float runnerSpeed{30.0f};
+        float strafeLimit{30.0f};
+    };
+
+    explicit NetLoadTest(Config config);
+    ~NetLoadTest();
+
+    NetLoadTest(const NetLoadTest &) = delete;
+    NetLoadTest &operator=(const NetLoadTest &) = delete;
+
+    /// @return false when not one peer could bind its ports
+    bool start();
+    void update(float dt);
+    /// Log latency percentiles and per-client costs since the last report
+    void report();
+
+private:
+    static constexpr std::size_t SNAPSHOT_HISTORY = 32;
+
+    struct SnapshotRecord
+    {
+        std::uint16_t sequence{0};
+        PlayerSnapshot snapshot;
+        bool valid{false};
+    };
+
+    /// What one transport peer has acked of our snapshots, for delta encoding
+    struct AckState
+    {
+        struct InFlight
+        {
+            std::uint16_t datagram{0};
+            std::uint16_t snapshot{0};
+            bool valid{false};
+        };
+
+        std::array<InFlight, 64> inFlight{};
+        std::uint16_t ackedSnapshot{0};
+        bool hasAcked{false};
+    };
+
+    /// Since the last report
+    struct ClientCounters
+    {
+        double pollMs{0.0};
+        double worstPollMs{0.0};
+        double handleMs{0.0};
+        std::size_t polls{0};
+        std::size_t messages{0};
+        std::size_t snapshotsOut{0};
+        std::size_t bytesIn{0};
+        std::size_t bytesOut{0};
+        std::size_t bytesInFlightSum{0};
+        std::size_t bytesInFlightPeak{0};
+    };
+
+    struct SimulatedClient
+    {
+        std::string name;
+        unsigned short port{0};
+        sf::TcpListener listener;
+        std::vector<std::unique_ptr<sf::TcpSocket>> connections;
+        NetTransport transport;
+        std::unique_ptr<HttpClient> http;
+        HttpClient::RequestId registration{0};
+        HttpClient::RequestId discovery{0};
+        float registrationAccumulator{0.0f};
+        float discoveryAccumulator{0.0f};
+        bool registered{false};
+
+        LaneAIController controller;
+        glm::vec3 position{0.0f};
+        SendRateController sendRate;
+        float sendAccumulator{0.0f};
+        std::uint16_t snapshotSequence{0};
+        std::array<PlayerSnapshot, SNAPSHOT_HISTORY> sentSnapshots{};
+        std::unordered_map<std::string, AckState> acks;
+        /// Received baselines by "source#playerId"
+        std::unordered_map<std::string, std::array<SnapshotRecord, SNAPSHOT_HISTORY>> received;
+
+        ClientCounters counters;
+
+        explicit SimulatedClient(std::uint32_t seed) : controller{seed} {}
+    };
+
+    bool startClient(SimulatedClient &client);
+    void updateHttp(SimulatedClient &client, float dt);
+    void connect(SimulatedClient &client, const sf::IpAddress &ip, unsigned short port);
+    /// Everything a client receives this tick: UDP, TCP accepts and TCP frames; timed as its poll
+    void poll(SimulatedClient &client, float dt);
+    void handleMessage(SimulatedClient &client, const std::string &source, sf::Packet &message);
+    void recordLatency(std::uint16_t senderMillis);
+    void move(SimulatedClient &client, float dt);
+    void sendState(SimulatedClient &client, float dt);
+    void sendHello(SimulatedClient &client);
+
+    Config mConfig;
+    std::vector<std::unique_ptr<SimulatedClient>> mClients;
+    std::string mRelayKey;
+    float mElapsedSeconds{0.0f};
+    /// End-to-end snapshot latencies since the last report, in milliseconds
+    std::vector<float> mLatencies;
+    std::size_t mSnapshotsIn{0};
+};
+
+#endif // NET_LOAD_TEST_HPP
@@ -0,0 +1,134 @@
+#include "NetStats.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr float kRttGain = 1.0f / 8.0f;
+    constexpr float kJitterGain = 1.0f / 16.0f;
+} // namespace
+
+NetStats::Peer &NetStats::peerFor(std::string_view key)
+{
+    if (const auto it = mPeers.find(key); it != mPeers.end())
+    {
+        return it->second;
+    }
+    return mPeers.emplace(std::string(key), Peer{}).first->second;
+}
+
+void NetStats::addPacketsIn(std::string_view peer, std::size_t packets, std::size_t bytes)
+{
+    Window &window = peerFor(peer).window;
+    window.packetsIn += packets;
+    window.bytesIn += bytes;
+}
+
+void NetStats::addPacketsOut(std::string_view peer, std::size_t packets, std::size_t bytes)
+{
+    Window &window = peerFor(peer).window;
+    window.packetsOut += packets;
+    window.bytesOut += bytes;
+}
+
+void NetStats::addReceiveBurst(std::string_view peer, std::size_t packets)
+{
+    Window &window = peerFor(peer).window;
+    window.receiveQueuePeak = std::max(window.receiveQueuePeak, packets);
+}
+
+void NetStats::addTransport(std::string_view peer, const NetTransport::PeerCounters &counters)
+{
+    if (counters.datagramsIn == 0 && counters.datagramsOut == 0)
+    {
+        return;
+    }
+
+    Window &window = peerFor(peer).window;
+    window.bytesIn += counters.bytesIn;
+    window.bytesOut += counters.bytesOut;
+    window.packetsIn += counters.datagramsIn;
+    window.packetsOut += counters.datagramsOut;
+    window.delivered += counters.datagramsDelivered;
+    window.lost += counters.datagramsLost;
+    window.receiveQueuePeak = std::max(window.receiveQueuePeak, counters.receiveQueuePeak);
+}
+
+void NetStats::addRttSample(std::string_view key, float rttMs)
+{
+    Peer &peer = peerFor(key);
+    if (!peer.hasRtt)
+    {
+        peer.smoothedRttMs = rttMs;
+        peer.jitterMs = 0.0f;
+        peer.hasRtt = true;
+    }
+    else
+    {
+        peer.smoothedRttMs += (rttMs - peer.smoothedRttMs) * kRttGain;
+        peer.jitterMs += (std::abs(rttMs - peer.lastRttMs) - peer.jitterMs) * kJitterGain;
+    }
+    peer.lastRttMs = rttMs;
+}
+
+void NetStats::addSnapshotAge(std::string_view key, float ageMs)
+{
+    const auto it = mPeers.find(key);
+    if (it == mPeers.end())
+    {
+        return;
+    }
+    Window &window = it->second.window;
+    window.snapshotAgeMs = window.hasSnapshotAge ? std::max(window.snapshotAgeMs, ageMs) : ageMs;
+    window.hasSnapshotAge = true;
+}
+
+void NetStats::removePeer(std::string_view key)
+{
+    if (const auto it = mPeers.find(key); it != mPeers.end())
+    {
+        mPeers.erase(it);
+    }
+    if (const auto it = mPublished.find(key); it != mPublished.end())
+    {
+        mPublished.erase(it);
+    }
+}
+
+void NetStats::publish(float windowSeconds)
+{
+    const float perSecond = windowSeconds > 0.0f ? 1.0f / windowSeconds : 0.0f;
+    mPublished.clear();
+    mPacketsIn = 0;
+
+    for (auto it = mPeers.begin(); it != mPeers.end();)
+    {
+        Peer &peer = it->second;
+        const Window &window = peer.window;
+        if (window.packetsIn == 0 && window.packetsOut == 0)
+        {
+            it = mPeers.erase(it);
+            continue;
+        }
+
+        PeerStats stats;
+        stats.hasRtt = peer.hasRtt;
+        stats.rttMs = peer.smoothedRttMs;
+        stats.jitterMs = peer.jitterMs;
+        stats.bytesInPerSecond = static_cast<float>(window.bytesIn) * perSecond;
+        stats.bytesOutPerSecond = static_cast<float>(window.bytesOut) * perSecond;
+        stats.packetsInPerSecond = static_cast<float>(window.packetsIn) * perSecond;
+        stats.packetsOutPerSecond = static_cast<float>(window.packetsOut) * perSecond;
+        const std::size_t settled = window.delivered + window.lost;
+        stats.lossPercent = settled > 0 ? 100.0f * static_cast<float>(window.lost) / static_cast<float>(settled) : 0.0f;
+        stats.receiveQueuePeak = window.receiveQueuePeak;
+        stats.hasSnapshotAge = window.hasSnapshotAge;
+        stats.snapshotAgeMs = window.snapshotAgeMs + (peer.hasRtt ? 0.5f * peer.smoothedRttMs : 0.0f);
+
+        mPacketsIn += window.packetsIn;
+        mPublished.emplace(it->first, stats);
+        peer.window = Window{};
+        ++it;
+    }
+}
@@ -0,0 +1,89 @@
+#ifndef NET_STATS_HPP
+#define NET_STATS_HPP
+
+#include "NetTransport.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+
+/// @brief Per-peer network metrics, published once per window as rates
+/// @details Traffic, ping samples and snapshot ages accumulate between publish() calls; publish()
+/// turns them into the values the debug panel and the profiling trace show. Round-trip time and
+/// jitter are smoothed across windows (RFC 6298 and RFC 3550 gains), everything else is per window.
+class NetStats
+{
+public:
+    static constexpr float WINDOW_SECONDS = 1.0f;
+
+    struct PeerStats
+    {
+        float rttMs{0.0f};
+        float jitterMs{0.0f};
+        bool hasRtt{false};
+        float bytesInPerSecond{0.0f};
+        float bytesOutPerSecond{0.0f};
+        float packetsInPerSecond{0.0f};
+        float packetsOutPerSecond{0.0f};
+        /// Of the UDP datagrams settled this window; 0 over TCP, which does not lose them
+        float lossPercent{0.0f};
+        /// Most packets from the peer waiting at one drain
+        std::size_t receiveQueuePeak{0};
+        /// Oldest displayed snapshot this window: time behind the sender's clock plus half the round trip
+        float snapshotAgeMs{0.0f};
+        bool hasSnapshotAge{false};
+    };
+
+    using PeerMap = std::map<std::string, PeerStats, std::less<>>;
+
+    void addPacketsIn(std::string_view peer, std::size_t packets, std::size_t bytes);
+    void addPacketsOut(std::string_view peer, std::size_t packets, std::size_t bytes);
+    void addReceiveBurst(std::string_view peer, std::size_t packets);
+    /// Merge what the UDP transport counted for the peer
+    void addTransport(std::string_view peer, const NetTransport::PeerCounters &counters);
+    void addRttSample(std::string_view peer, float rttMs);
+    /// Ignored for peers with no traffic yet, so a stale remote player cannot recreate its source
+    void addSnapshotAge(std::string_view peer, float ageMs);
+    void removePeer(std::string_view peer);
+
+    /// @brief Turn the window's counters into rates; peers silent for the whole window are dropped
+    void publish(float windowSeconds);
+
+    [[nodiscard]] const PeerMap &getPeers() const noexcept { return mPublished; }
+
+    /// Packets received over all peers in the last window
+    [[nodiscard]] std::size_t getPacketsIn() const noexcept { return mPacketsIn; }
+
+private:
+    struct Window
+    {
+        std::size_t bytesIn{0};
+        std::size_t bytesOut{0};
+        std::size_t packetsIn{0};
+        std::size_t packetsOut{0};
+        std::size_t delivered{0};
+        std::size_t lost{0};
+        std::size_t receiveQueuePeak{0};
+        float snapshotAgeMs{0.0f};
+        bool hasSnapshotAge{false};
+    };
+
+    struct Peer
+    {
+        Window window;
+        float smoothedRttMs{0.0f};
+        float jitterMs{0.0f};
+        float lastRttMs{0.0f};
+        bool hasRtt{false};
+    };
+
+    Peer &peerFor(std::string_view key);
+
+    std::map<std::string, Peer, std::less<>> mPeers;
+    PeerMap mPublished;
+    std::size_t mPacketsIn{0};
+};
+
+#endif // NET_STATS_HPP
@@ -0,0 +1,564 @@
+#include "NetTransport.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <utility>
+
+namespace
+{
+    // High bit of the flags byte: the ack fields are meaningful (the sender has heard from us)
+    constexpr std::uint8_t kHasAcksFlag = 0x80u;
+
+    // Record fields are big-endian like the rest of sf::Packet
+    void appendUint16(std::vector<std::uint8_t> &out, std::uint16_t value)
+    {
+        out.push_back(static_cast<std::uint8_t>(value >> 8));
+        out.push_back(static_cast<std::uint8_t>(value & 0xFFu));
+    }
+
+    std::uint16_t readUint16(const std::uint8_t *bytes) noexcept
+    {
+        return static_cast<std::uint16_t>((bytes[0] << 8) | bytes[1]);
+    }
+} // namespace
+
+bool NetTransport::bind(unsigned short port)
+{
+    unbind();
+    if (mSocket.bind(port) != sf::Socket::Status::Done)
+    {
+        return false;
+    }
+
+    mSocket.setBlocking(false);
+    mBound = true;
+    return true;
+}
+
+void NetTransport::unbind()
+{
+    if (mBound)
+    {
+        mSocket.unbind();
+    }
+    mBound = false;
+    mPeers.clear();
+}
+
+unsigned short NetTransport::getLocalPort() const noexcept
+{
+    return mBound ? mSocket.getLocalPort() : 0;
+}
+
+void NetTransport::addPeer(const std::string &key, const sf::IpAddress &ip, unsigned short port)
+{
+    auto [it, inserted] = mPeers.try_emplace(key);
+    if (inserted)
+    {
+        it->second.ip = ip;
+        it->second.port = port;
+    }
+}
+
+void NetTransport::removePeer(const std::string &key)
+{
+    mPeers.erase(key);
+}
+
+bool NetTransport::hasPeer(const std::string &key) const
+{
+    return mPeers.find(key) != mPeers.end();
+}
+
+bool NetTransport::isPeerConfirmed(const std::string &key) const
+{
+    const auto it = mPeers.find(key);
+    return it != mPeers.end() && it->second.receivedAny;
+}
+
+float NetTransport::getSecondsSinceReceived(const std::string &key) const
+{
+    const auto it = mPeers.find(key);
+    return it != mPeers.end() ? it->second.sinceReceived : std::numeric_limits<float>::infinity();
+}
+
+std::vector<std::string> NetTransport::getPeerKeys() const
+{
+    std::vector<std::string> keys;
+    keys.reserve(mPeers.size());
+    for (const auto &[key, peer] : mPeers)
+    {
+        keys.push_back(key);
+    }
+    return keys;
+}
+
+NetTransport::PeerCounters NetTransport::takeCounters(const std::string &key)
+{
+    const auto it = mPeers.find(key);
+    if (it == mPeers.end())
+    {
+        return {};
+    }
+    return std::exchange(it->second.counters, PeerCounters{});
+}
+
+std::size_t NetTransport::getBytesInFlight(const std::string &key) const
+{
+    const auto it = mPeers.find(key);
+    if (it == mPeers.end())
+    {
+        return 0;
+    }
+
+    const Peer &peer = it->second;
+    std::size_t bytes = 0;
+    for (const SentRecord &record : peer.sent)
+    {
+        // Records behind the loss cursor were already counted as delivered or lost
+        const bool settled = peer.lossTracked && sequenceGreater(peer.lossCursor, record.sequence);
+        if (record.valid && record.carriesMessages && !record.acked && !settled)
+        {
+            bytes += record.size;
+        }
+    }
+    return bytes;
+}
+
+bool NetTransport::send(const std::string &peerKey, const sf::Packet &message, Channel channel,
+                        std::uint16_t *outSequence)
+{
+    const auto it = mPeers.find(peerKey);
+    if (!mBound || it == mPeers.end() || channel == Channel::ACK_ONLY)
+    {
+        return false;
+    }
+
+    if (HEADER_SIZE + RELIABLE_RECORD_HEADER_SIZE + message.getDataSize() > MAX_DATAGRAM_SIZE)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "NetTransport: %zu-byte message exceeds the datagram limit",
+                    message.getDataSize());
+        return false;
+    }
+
+    Peer &peer = it->second;
+    if (channel == Channel::UNRELIABLE)
+    {
+        const std::uint16_t sequence = queueRecord(peer, channel, 0, message.getData(), message.getDataSize());
+        if (outSequence)
+        {
+            *outSequence = sequence;
+        }
+        return true;
+    }
+
+    if (peer.pendingReliable.size() >= MAX_PENDING_RELIABLE)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "NetTransport: %s has %zu unacked reliable messages, dropping one",
+                    peerKey.c_str(), peer.pendingReliable.size());
+        return false;
+    }
+
+    // Kept until acked; the resend timer covers both loss and a socket that refused the datagram
+    PendingReliable pending;
+    pending.messageId = peer.nextReliableId++;
+    const auto *bytes = static_cast<const std::uint8_t *>(message.getData());
+    pending.payload.assign(bytes, bytes + message.getDataSize());
+    const std::uint16_t sequence = queueRecord(peer, channel, pending.messageId, pending.payload.data(), pending.payload.size());
+    pending.carriedBy.push_back(sequence);
+    if (outSequence)
+    {
+        *outSequence = sequence;
+    }
+    peer.pendingReliable.push_back(std::move(pending));
+    return true;
+}
+
+void NetTransport::broadcast(const sf::Packet &message, Channel channel)
+{
+    for (auto &[key, peer] : mPeers)
+    {
+        send(key, message, channel);
+    }
+}
+
+void NetTransport::update(float dt, const MessageHandler &onMessage, const AckHandler &onAck)
+{
+    if (!mBound)
+    {
+        return;
+    }
+
+    for (auto &[key, peer] : mPeers)
+    {
+        peer.sinceSent += dt;
+        peer.sinceReceived += dt;
+        peer.receivedThisUpdate = 0;
+        for (PendingReliable &pending : peer.pendingReliable)
+        {
+            pending.sinceSent += dt;
+            pending.age += dt;
+        }
+    }
+
+    // Drain the socket: everything that arrived since the last update is handled now
+    while (true)
+    {
+        sf::Packet datagram;
+        std::optional<sf::IpAddress> sender;
+        unsigned short senderPort = 0;
+        if (mSocket.receive(datagram, sender, senderPort) != sf::Socket::Status::Done)
+        {
+            break;
+        }
+        if (!sender || datagram.getDataSize() < HEADER_SIZE)
+        {
+            continue;
+        }
+
+        const std::string key = makePeerKey(*sender, senderPort);
+        auto it = mPeers.find(key);
+        if (it == mPeers.end())
+        {
+            // Only adopt senders speaking this protocol
+            sf::Packet probe = datagram;
+            std::uint32_t protocol = 0;
+            if (!(probe >> protocol) || protocol != PROTOCOL_ID)
+            {
+                continue;
+            }
+            it = mPeers.try_emplace(key).first;
+            it->second.ip = *sender;
+            it->second.port = senderPort;
+            SDL_Log("NetTransport: new peer %s", key.c_str());
+        }
+
+        Peer &peer = it->second;
+        ++peer.receivedThisUpdate;
+        ++peer.counters.datagramsIn;
+        peer.counters.bytesIn += datagram.getDataSize();
+        receiveDatagram(key, peer, datagram, onMessage, onAck);
+    }
+
+    for (auto &[key, peer] : mPeers)
+    {
+        peer.counters.receiveQueuePeak = std::max(peer.counters.receiveQueuePeak, peer.receivedThisUpdate);
+        for (PendingReliable &pending : peer.pendingReliable)
+        {
+            if (pending.sinceSent < RELIABLE_RESEND_SECONDS)
+            {
+                continue;
+            }
+            pending.carriedBy.push_back(queueRecord(peer, Channel::RELIABLE, pending.messageId,
+                                                    pending.payload.data(), pending.payload.size()));
+            pending.sinceSent = 0.0f;
+        }
+    }
+
+    // Pending messages stay in send order, so the front one is the oldest
+    std::erase_if(mPeers, [](const auto &entry)
+    {
+        const auto &[key, peer] = entry;
+        if (peer.pendingReliable.empty() || peer.pendingReliable.front().age < RELIABLE_TIMEOUT_SECONDS)
+        {
+            return false;
+        }
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "NetTransport: %s stopped acking, dropping it", key.c_str());
+        return true;
+    });
+}
+
+void NetTransport::flush()
+{
+    if (!mBound)
+    {
+        return;
+    }
+
+    for (auto &[key, peer] : mPeers)
+    {
+        if (!peer.outgoing.empty())
+        {
+            flushPeer(peer);
+        }
+        else if (peer.ackPending && peer.sinceSent >= ACK_INTERVAL_SECONDS)
+        {
+            // A peer that only receives still has to tell the sender what arrived
+            sendDatagram(peer, nullptr, 0);
+        }
+    }
+}
+
+std::string NetTransport::makePeerKey(const sf::IpAddress &ip, unsigned short port)
+{
+    return ip.toString() + ":" + std::to_string(port);
+}
+
+bool NetTransport::sequenceGreater(std::uint16_t a, std::uint16_t b) noexcept
+{
+    return ((a > b) && (a - b <= 32768)) || ((a < b) && (b - a > 32768));
+}
+
+std::uint16_t NetTransport::queueRecord(Peer &peer, Channel channel, std::uint16_t messageId,
+                                       const void *payload, std::size_t payloadSize)
+{
+    const std::size_t recordSize =
+        (channel == Channel::RELIABLE ? RELIABLE_RECORD_HEADER_SIZE : RECORD_HEADER_SIZE) + payloadSize;
+    if (!peer.outgoing.empty() && HEADER_SIZE + peer.outgoing.size() + recordSize > MAX_DATAGRAM_SIZE)
+    {
+        flushPeer(peer);
+    }
+
+    peer.outgoing.push_back(static_cast<std::uint8_t>(channel));
+    appendUint16(peer.outgoing, static_cast<std::uint16_t>(payloadSize));
+    if (channel == Channel::RELIABLE)
+    {
+        appendUint16(peer.outgoing, messageId);
+    }
+    if (payload != nullptr && payloadSize > 0)
+    {
+        const auto *bytes = static_cast<const std::uint8_t *>(payload);
+        peer.outgoing.insert(peer.outgoing.end(), bytes, bytes + payloadSize);
+    }
+
+    return peer.localSequence;
+}
+
+void NetTransport::flushPeer(Peer &peer)
+{
+    sendDatagram(peer, peer.outgoing.data(), peer.outgoing.size());
+    peer.outgoing.clear();
+}
+
+bool NetTransport::sendDatagram(Peer &peer, const std::uint8_t *records, std::size_t recordsSize)
+{
+    const std::uint16_t sequence = peer.localSequence++;
+    const std::uint8_t flags = peer.receivedAny ? kHasAcksFlag : 0u;
+
+    sf::Packet datagram;
+    datagram << PROTOCOL_ID << sequence << peer.remoteSequence << peer.receivedBits << flags;
+    if (records != nullptr && recordsSize > 0)
+    {
+        datagram.append(records, recordsSize);
+    }
+
+    peer.sent[sequence % SENT_WINDOW] = SentRecord{sequence, true, false, recordsSize > 0,
+                                                   static_cast<std::uint16_t>(datagram.getDataSize())};
+    peer.sinceSent = 0.0f;
+    peer.ackPending = false;
+    ++peer.counters.datagramsOut;
+    peer.counters.bytesOut += datagram.getDataSize();
+
+    return mSocket.send(datagram, peer.ip, peer.port) == sf::Socket::Status::Done;
+}
+
+void NetTransport::receiveDatagram(const std::string &key, Peer &peer, sf::Packet &datagram,
+                                   const MessageHandler &onMessage, const AckHandler &onAck)
+{
+    std::uint32_t protocol = 0;
+    std::uint16_t sequence = 0;
+    std::uint16_t ack = 0;
+    std::uint32_t ackBits = 0;
+    std::uint8_t flags = 0;
+    if (!(datagram >> protocol >> sequence >> ack >> ackBits >> flags) || protocol != PROTOCOL_ID)
+    {
+        return;
+    }
+
+    peer.sinceReceived = 0.0f;
+    const bool fresh = recordReceived(peer, sequence);
+    if ((flags & kHasAcksFlag) != 0)
+    {
+        processAcks(key, peer, ack, ackBits, onAck);
+    }
+
+    const auto *bytes = static_cast<const std::uint8_t *>(datagram.getData());
+    std::size_t offset = datagram.getReadPosition();
+    const std::size_t end = datagram.getDataSize();
+    if (offset >= end)
+    {
+        // Bare ack
+        return;
+    }
+
+    // Ack duplicates too: the first ack may be the one that was lost
+    peer.ackPending = true;
+    if (!fresh)
+    {
+        return;
+    }
+
+    while (offset + RECORD_HEADER_SIZE <= end)
+    {
+        const auto channel = static_cast<Channel>(bytes[offset]);
+        const std::size_t length = readUint16(bytes + offset + 1);
+        offset += RECORD_HEADER_SIZE;
+
+        std::uint16_t messageId = 0;
+        if (channel == Channel::RELIABLE)
+        {
+            if (offset + 2 > end)
+            {
+                return;
+            }
+            messageId = readUint16(bytes + offset);
+            offset += 2;
+        }
+        if (offset + length > end)
+        {
+            return;
+        }
+
+        const std::uint8_t *payload = bytes + offset;
+        offset += length;
+
+        if (channel == Channel::UNRELIABLE)
+        {
+            sf::Packet message;
+            if (length > 0)
+            {
+                message.append(payload, length);
+            }
+            if (onMessage)
+            {
+                onMessage(key, message);
+            }
+        }
+        else if (channel == Channel::RELIABLE)
+        {
+            deliverReliable(key, peer, messageId, {payload, payload + length}, onMessage);
+        }
+    }
+}
+
+bool NetTransport::recordReceived(Peer &peer, std::uint16_t sequence) noexcept
+{
+    if (!peer.receivedAny)
+    {
+        peer.receivedAny = true;
+        peer.remoteSequence = sequence;
+        peer.receivedBits = 0;
+        return true;
+    }
+
+    if (sequenceGreater(sequence, peer.remoteSequence))
+    {
+        // Bit i stands for remoteSequence - (i + 1); the old newest lands on bit shift - 1
+        const std::uint16_t shift = static_cast<std::uint16_t>(sequence - peer.remoteSequence);
+        if (shift > 32)
+        {
+            peer.receivedBits = 0;
+        }
+        else
+        {
+            const std::uint32_t kept = (shift == 32) ? 0u : (peer.receivedBits << shift);
+            peer.receivedBits = kept | (1u << (shift - 1));
+        }
+        peer.remoteSequence = sequence;
+        return true;
+    }
+
+    const std::uint16_t distance = static_cast<std::uint16_t>(peer.remoteSequence - sequence);
+    if (distance == 0 || distance > 32)
+    {
+        return false;
+    }
+
+    const std::uint32_t bit = 1u << (distance - 1);
+    if ((peer.receivedBits & bit) != 0)
+    {
+        return false;
+    }
+    peer.receivedBits |= bit;
+    return true;
+}
+
+void NetTransport::processAcks(const std::string &key, Peer &peer, std::uint16_t ack, std::uint32_t ackBits,
+                               const AckHandler &onAck)
+{
+    for (std::uint32_t i = 0; i <= 32; ++i)
+    {
+        if (i > 0 && (ackBits & (1u << (i - 1))) == 0)
+        {
+            continue;
+        }
+
+        const auto sequence = static_cast<std::uint16_t>(ack - i);
+        SentRecord &record = peer.sent[sequence % SENT_WINDOW];
+        if (!record.valid || record.acked || record.sequence != sequence)
+        {
+            continue;
+        }
+        record.acked = true;
+
+        std::erase_if(peer.pendingReliable, [sequence](const PendingReliable &pending)
+                      { return std::find(pending.carriedBy.begin(), pending.carriedBy.end(), sequence) != pending.carriedBy.end(); });
+
+        if (onAck)
+        {
+            onAck(key, sequence);
+        }
+    }
+
+    // A datagram older than the ack window can no longer be acked: settle it as delivered or lost
+    const auto windowStart = static_cast<std::uint16_t>(ack - 32);
+    if (!peer.lossTracked)
+    {
+        peer.lossCursor = windowStart;
+        peer.lossTracked = true;
+    }
+    for (std::size_t settled = 0; settled < SENT_WINDOW && sequenceGreater(windowStart, peer.lossCursor); ++settled)
+    {
+        const SentRecord &record = peer.sent[peer.lossCursor % SENT_WINDOW];
+        if (record.valid && record.carriesMessages && record.sequence == peer.lossCursor)
+        {
+            ++(record.acked ? peer.counters.datagramsDelivered : peer.counters.datagramsLost);
+        }
+        ++peer.lossCursor;
+    }
+    if (sequenceGreater(windowStart, peer.lossCursor))
+    {
+        // Fell further behind than the sent window; those records are gone
+        peer.lossCursor = windowStart;
+    }
+}
+
+void NetTransport::deliverReliable(const std::string &key, Peer &peer, std::uint16_t messageId,
+                                   std::vector<std::uint8_t> payload, const MessageHandler &onMessage)
+{
+    if (messageId != peer.nextReliableExpected)
+    {
+        // Ahead of a gap: hold it; behind: a resend of something already delivered
+        if (sequenceGreater(messageId, peer.nextReliableExpected))
+        {
+            peer.reliableHoldback.try_emplace(messageId, std::move(payload));
+        }
+        return;
+    }
+
+    const auto deliver = [&key, &onMessage](const std::vector<std::uint8_t> &bytes)
+    {
+        sf::Packet message;
+        if (!bytes.empty())
+        {
+            message.append(bytes.data(), bytes.size());
+        }
+        if (onMessage)
+        {
+            onMessage(key, message);
+        }
+    };
+
+    deliver(payload);
+    ++peer.nextReliableExpected;
+    for (auto it = peer.reliableHoldback.find(peer.nextReliableExpected); it != peer.reliableHoldback.end();
+         it = peer.reliableHoldback.find(peer.nextReliableExpected))
+    {
+        deliver(it->second);
+        peer.reliableHoldback.erase(it);
+        ++peer.nextReliableExpected;
+    }
+}
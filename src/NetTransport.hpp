@@ -0,0 +1,194 @@
+#ifndef NET_TRANSPORT_HPP
+#define NET_TRANSPORT_HPP
+
+#include <SFML/Network.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// @brief Connectionless UDP transport with per-peer sequence numbers and piggybacked acks
+/// @details Every datagram carries its own sequence number, the newest sequence received from that
+/// peer and a 32-bit field acknowledging the 32 before it, so acks ride on normal traffic and a lost
+/// datagram never holds back the ones after it. Unreliable messages are sent once. Reliable messages
+/// are kept until a datagram that carried them is acked, resent on a timer and delivered in order.
+/// Peers are keyed "ip:port"; a datagram from an unknown address with the right protocol id adds it.
+///
+/// Messages are not sent one datagram each: send() appends them to the peer's outgoing batch and
+/// flush() packs each batch into as few datagrams as fit, once per tick. A datagram with no
+/// messages is a bare ack.
+class NetTransport
+{
+public:
+    static constexpr std::uint32_t PROTOCOL_ID = 0x324E5742u; // "BWN2"
+    /// Stays under the common 1280-byte IPv6 minimum MTU so datagrams are never fragmented
+    static constexpr std::size_t MAX_DATAGRAM_SIZE = 1200;
+    static constexpr float RELIABLE_RESEND_SECONDS = 0.15f;
+    /// Unacked reliable messages one peer may hold; send() refuses more
+    static constexpr std::size_t MAX_PENDING_RELIABLE = 256;
+    /// A peer that leaves a reliable message unacked this long is dropped by update()
+    static constexpr float RELIABLE_TIMEOUT_SECONDS = 10.0f;
+    /// An otherwise silent receiver still sends acks this often
+    static constexpr float ACK_INTERVAL_SECONDS = 0.1f;
+
+    enum class Channel : std::uint8_t
+    {
+        UNRELIABLE = 0,
+        RELIABLE = 1,
+        ACK_ONLY = 2
+    };
+
+    /// Traffic since the last takeCounters() for that peer
+    struct PeerCounters
+    {
+        std::size_t bytesIn{0};
+        std::size_t bytesOut{0};
+        std::size_t datagramsIn{0};
+        std::size_t datagramsOut{0};
+        /// Datagrams with messages that left the ack window, split by whether they were acked
+        std::size_t datagramsDelivered{0};
+        std::size_t datagramsLost{0};
+        /// Most datagrams from the peer waiting in the socket at one update()
+        std::size_t receiveQueuePeak{0};
+    };
+
+    /// Called for each delivered message with the read position at the start of its payload
+    using MessageHandler = std::function<void(const std::string &peer, sf::Packet &message)>;
+    /// Called once for each of our datagram sequences the peer confirmed receiving
+    using AckHandler = std::function<void(const std::string &peer, std::uint16_t sequence)>;
+
+    NetTransport() = default;
+
+    NetTransport(const NetTransport &) = delete;
+    NetTransport &operator=(const NetTransport &) = delete;
+
+    /// @brief Bind a non-blocking UDP socket; port 0 picks any free port
+    bool bind(unsigned short port);
+    void unbind();
+
+    [[nodiscard]] bool isBound() const noexcept { return mBound; }
+    [[nodiscard]] unsigned short getLocalPort() const noexcept;
+
+    /// Register a peer so messages can go out before it has sent anything
+    void addPeer(const std::string &key, const sf::IpAddress &ip, unsigned short port);
+    void removePeer(const std::string &key);
+
+    [[nodiscard]] bool hasPeer(const std::string &key) const;
+    /// True once at least one datagram from the peer arrived, i.e. UDP reaches us from there
+    [[nodiscard]] bool isPeerConfirmed(const std::string &key) const;
+    /// Time since the last datagram from the peer, or since it was added when none arrived yet; infinity for an unknown peer
+    [[nodiscard]] float getSecondsSinceReceived(const std::string &key) const;
+    [[nodiscard]] std::size_t getPeerCount() const noexcept { return mPeers.size(); }
+    [[nodiscard]] std::vector<std::string> getPeerKeys() const;
+    /// Read and reset a peer's traffic counters; zeros for an unknown peer
+    [[nodiscard]] PeerCounters takeCounters(const std::string &key);
+    /// Size of the datagrams with messages sent to the peer that are neither acked nor settled as lost
+    [[nodiscard]] std::size_t getBytesInFlight(const std::string &key) const;
+
+    /// @brief Queue one message to one peer for the next flush()
+    /// @param outSequence Receives the datagram sequence that will carry it (the first one for reliable), as passed to AckHandler
+    /// @return false when the peer is unknown, the message is too large for a datagram or MAX_PENDING_RELIABLE are unacked
+    bool send(const std::string &peer, const sf::Packet &message, Channel channel,
+              std::uint16_t *outSequence = nullptr);
+
+    /// Queue one message to every registered peer
+    void broadcast(const sf::Packet &message, Channel channel);
+
+    /// @brief Read every waiting datagram, deliver its messages and queue overdue reliable resends
+    /// @details Peers that stop acking for RELIABLE_TIMEOUT_SECONDS are removed
+    void update(float dt, const MessageHandler &onMessage, const AckHandler &onAck = {});
+
+    /// @brief Send every peer's queued messages, and a bare ack to peers owed one; call once per tick
+    void flush();
+
+    /// Peer key format shared with the TCP side
+    [[nodiscard]] static std::string makePeerKey(const sf::IpAddress &ip, unsigned short port);
+
+    /// Higher in wrap-around order (RFC 1982 serial number arithmetic)
+    [[nodiscard]] static bool sequenceGreater(std::uint16_t a, std::uint16_t b) noexcept;
+
+private:
+    static constexpr std::size_t SENT_WINDOW = 256;
+    static constexpr std::size_t HEADER_SIZE = 4 + 2 + 2 + 4 + 1;
+    /// Per message: [Uint8:channel] [Uint16:length], then [Uint16:messageId] when reliable
+    static constexpr std::size_t RECORD_HEADER_SIZE = 1 + 2;
+    static constexpr std::size_t RELIABLE_RECORD_HEADER_SIZE = RECORD_HEADER_SIZE + 2;
+
+    struct SentRecord
+    {
+        std::uint16_t sequence{0};
+        bool valid{false};
+        bool acked{false};
+        /// Bare acks are left out of loss: nothing acks them back when traffic is one-way
+        bool carriesMessages{false};
+        std::uint16_t size{0};
+    };
+
+    struct PendingReliable
+    {
+        std::uint16_t messageId{0};
+        std::vector<std::uint8_t> payload;
+        /// Datagrams this message went out in; acking any of them retires it
+        std::vector<std::uint16_t> carriedBy;
+        float sinceSent{0.0f};
+        /// Since the first send, kept across resends
+        float age{0.0f};
+    };
+
+    struct Peer
+    {
+        sf::IpAddress ip{sf::IpAddress::LocalHost};
+        unsigned short port{0};
+
+        std::uint16_t localSequence{0};
+        std::uint16_t remoteSequence{0};
+        std::uint32_t receivedBits{0};
+        bool receivedAny{false};
+        /// Something ackable arrived since our last datagram to this peer
+        bool ackPending{false};
+        float sinceSent{0.0f};
+        float sinceReceived{0.0f};
+
+        std::array<SentRecord, SENT_WINDOW> sent{};
+        /// Sent sequences before this one were already counted as delivered or lost
+        std::uint16_t lossCursor{0};
+        bool lossTracked{false};
+
+        PeerCounters counters;
+        std::size_t receivedThisUpdate{0};
+
+        std::uint16_t nextReliableId{0};
+        std::uint16_t nextReliableExpected{0};
+        std::vector<PendingReliable> pendingReliable;
+        /// Reliable messages that arrived ahead of a missing one, by id
+        std::map<std::uint16_t, std::vector<std::uint8_t>> reliableHoldback;
+
+        /// Message records waiting for the next datagram, which will carry sequence localSequence
+        std::vector<std::uint8_t> outgoing;
+    };
+
+    /// @return The sequence of the datagram that will carry the record
+    std::uint16_t queueRecord(Peer &peer, Channel channel, std::uint16_t messageId,
+                              const void *payload, std::size_t payloadSize);
+    void flushPeer(Peer &peer);
+    bool sendDatagram(Peer &peer, const std::uint8_t *records, std::size_t recordsSize);
+    void receiveDatagram(const std::string &key, Peer &peer, sf::Packet &datagram,
+                         const MessageHandler &onMessage, const AckHandler &onAck);
+    /// @return false when the datagram is a duplicate or too old to track
+    bool recordReceived(Peer &peer, std::uint16_t sequence) noexcept;
+    void processAcks(const std::string &key, Peer &peer, std::uint16_t ack, std::uint32_t ackBits,
+                     const AckHandler &onAck);
+    void deliverReliable(const std::string &key, Peer &peer, std::uint16_t messageId,
+                         std::vector<std::uint8_t> payload, const MessageHandler &onMessage);
+
+    sf::UdpSocket mSocket;
+    bool mBound{false};
+    std::unordered_map<std::string, Peer> mPeers;
+};
+
+#endif // NET_TRANSPORT_HPP
@@ -0,0 +1,278 @@
+#include "OcclusionCuller.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "ChunkGeometryPool.hpp"
+#include "GLStateCache.hpp"
+#include "RenderStats.hpp"
+
+namespace
+{
+    using DrawCommand = ChunkGeometryPool::DrawElementsIndirectCommand;
+
+    constexpr GLuint kPyramidGroupSize = 8;
+    constexpr GLuint kCullGroupSize = 64;
+
+    GLuint groupsFor(int size, GLuint groupSize) noexcept
+    {
+        return (static_cast<GLuint>(std::max(size, 1)) + groupSize - 1) / groupSize;
+    }
+} // namespace
+
+OcclusionCuller::~OcclusionCuller() noexcept
+{
+    destroy();
+}
+
+bool OcclusionCuller::init(Shader &pyramidShader, Shader &cullShader) noexcept
+{
+    destroy();
+
+    if (!pyramidShader.isLinked() || !cullShader.isLinked())
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "OcclusionCuller: compute shaders not linked");
+        return false;
+    }
+
+    mPyramidShader = &pyramidShader;
+    mCullShader = &cullShader;
+    mPyramidUniforms.stage = pyramidShader.getUniformHandle("uStage");
+    mCullUniforms.clusterCount = cullShader.getUniformHandle("uClusterCount");
+    mCullUniforms.indexCount = cullShader.getUniformHandle("uIndexCount");
+    mCullUniforms.minLevel = cullShader.getUniformHandle("uMinLevel");
+    mCullUniforms.levels = cullShader.getUniformHandle("uHiZLevels");
+
+    glGenBuffers(1, &mClusterBuffer);
+    glGenBuffers(2, mCommandBuffers);
+    glGenFramebuffers(1, &mFramebuffer);
+
+    if (const GLenum error = glGetError(); error != GL_NO_ERROR)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_RENDER, "OcclusionCuller: OpenGL error 0x%x during init", error);
+        destroy();
+        return false;
+    }
+    return true;
+}
+
+void OcclusionCuller::destroy() noexcept
+{
+    destroyTargets();
+    if (mFramebuffer != 0)
+    {
+        glDeleteFramebuffers(1, &mFramebuffer);
+        mFramebuffer = 0;
+    }
+    if (mClusterBuffer != 0)
+    {
+        glDeleteBuffers(1, &mClusterBuffer);
+        mClusterBuffer = 0;
+    }
+    if (mCommandBuffers[0] != 0)
+    {
+        glDeleteBuffers(2, mCommandBuffers);
+        mCommandBuffers[0] = 0;
+        mCommandBuffers[1] = 0;
+    }
+    mClusterCount = 0;
+    mCommandCapacity = 0;
+    mCurrent = 0;
+    mClusterBytes.set(0);
+    mCommandBytes.set(0);
+    mPyramidShader = nullptr;
+    mCullShader = nullptr;
+}
+
+void OcclusionCuller::setClusters(std::span<const Cluster> clusters, GLsizei indexCount) noexcept
+{
+    if (!isInitialized())
+    {
+        return;
+    }
+
+    mClusterCount = clusters.size();
+    mIndexCount = indexCount;
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mClusterBuffer);
+    RenderStats::bufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(std::max<std::size_t>(mClusterCount, 1) * sizeof(Cluster)),
+                            clusters.empty() ? nullptr : clusters.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    mClusterBytes.set(std::max<std::size_t>(mClusterCount, 1) * sizeof(Cluster));
+
+    // No occluder walls until the first cull; the floors alone already hide the lower levels
+    const std::vector<DrawCommand> empty(std::max<std::size_t>(mClusterCount, 1),
+                                         DrawCommand{static_cast<GLuint>(indexCount), 0u, 0u, 0, 0u});
+    const auto bytes = static_cast<GLsizeiptr>(empty.size() * sizeof(DrawCommand));
+    for (const GLuint buffer : mCommandBuffers)
+    {
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, buffer);
+        if (mCommandCapacity < empty.size())
+        {
+            RenderStats::bufferData(GL_DRAW_INDIRECT_BUFFER, bytes, empty.data(), GL_DYNAMIC_DRAW);
+        }
+        else
+        {
+            RenderStats::bufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, bytes, empty.data());
+        }
+    }
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    mCommandCapacity = std::max(mCommandCapacity, empty.size());
+    mCommandBytes.set(2 * mCommandCapacity * sizeof(DrawCommand));
+}
+
+void OcclusionCuller::resizeTargets(int width, int height) noexcept
+{
+    destroyTargets();
+
+    mWidth = width;
+    mHeight = height;
+    mLevels = static_cast<int>(std::floor(std::log2(static_cast<float>(std::max(width, height))))) + 1;
+
+    glGenTextures(1, &mDepthTexture);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mDepthTexture);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH_COMPONENT32F, width, height);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_NONE);
+
+    glGenTextures(1, &mPyramidTexture);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mPyramidTexture);
+    glTexStorage2D(GL_TEXTURE_2D, mLevels, GL_R32F, width, height);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, mDepthTexture, 0);
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_RENDER, "OcclusionCuller: depth framebuffer incomplete");
+    }
+
+    // 4-byte depth plus a 4-byte R32F pyramid whose mips add a third
+    const auto texels = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+    mTargetBytes.set(texels * 4 + texels * 4 * 4 / 3);
+
+    SDL_Log("OcclusionCuller: Hi-Z pyramid %d x %d, %d levels", width, height, mLevels);
+}
+
+void OcclusionCuller::destroyTargets() noexcept
+{
+    if (mDepthTexture != 0)
+    {
+        GLStateCache::forgetTexture(mDepthTexture);
+        glDeleteTextures(1, &mDepthTexture);
+        mDepthTexture = 0;
+    }
+    if (mPyramidTexture != 0)
+    {
+        GLStateCache::forgetTexture(mPyramidTexture);
+        glDeleteTextures(1, &mPyramidTexture);
+        mPyramidTexture = 0;
+    }
+    mWidth = 0;
+    mHeight = 0;
+    mLevels = 0;
+    mTargetBytes.set(0);
+}
+
+void OcclusionCuller::beginDepthPass(int viewportWidth, int viewportHeight) noexcept
+{
+    const float aspect = static_cast<float>(std::max(viewportHeight, 1)) / static_cast<float>(std::max(viewportWidth, 1));
+    const int height = std::clamp(static_cast<int>(std::lround(DEPTH_WIDTH * aspect)), 1, DEPTH_WIDTH * 4);
+    if (mWidth != DEPTH_WIDTH || mHeight != height)
+    {
+        resizeTargets(DEPTH_WIDTH, height);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffer);
+    glViewport(0, 0, mWidth, mHeight);
+    GLStateCache::depthMask(true);
+    glClear(GL_DEPTH_BUFFER_BIT);
+}
+
+void OcclusionCuller::multiDraw(GLuint commandBuffer, GLenum indexType) const noexcept
+{
+    if (mClusterCount == 0)
+    {
+        return;
+    }
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+    RenderStats::multiDrawElementsIndirect(GL_TRIANGLES, indexType, nullptr, static_cast<GLsizei>(mClusterCount), 0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+void OcclusionCuller::drawOccluders(GLenum indexType) const noexcept
+{
+    multiDraw(mCommandBuffers[mCurrent], indexType);
+}
+
+void OcclusionCuller::drawVisible(GLenum indexType) const noexcept
+{
+    multiDraw(mCommandBuffers[mCurrent], indexType);
+}
+
+void OcclusionCuller::buildPyramid() noexcept
+{
+    if (mPyramidTexture == 0)
+    {
+        return;
+    }
+
+    mPyramidShader->bind();
+    mPyramidShader->setUniform(mPyramidUniforms.stage, static_cast<GLuint>(Stage::COPY));
+    GLStateCache::activeTexture(GL_TEXTURE0);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mDepthTexture);
+    glBindImageTexture(1, mPyramidTexture, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+    RenderStats::dispatchCompute(groupsFor(mWidth, kPyramidGroupSize), groupsFor(mHeight, kPyramidGroupSize), 1);
+
+    mPyramidShader->setUniform(mPyramidUniforms.stage, static_cast<GLuint>(Stage::REDUCE));
+    for (int level = 1; level < mLevels; ++level)
+    {
+        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+        glBindImageTexture(0, mPyramidTexture, level - 1, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+        glBindImageTexture(1, mPyramidTexture, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+        RenderStats::dispatchCompute(groupsFor(std::max(mWidth >> level, 1), kPyramidGroupSize),
+                                     groupsFor(std::max(mHeight >> level, 1), kPyramidGroupSize), 1);
+    }
+    glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+
+    glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+    glBindImageTexture(1, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, 0);
+}
+
+void OcclusionCuller::cull(unsigned int minLevel) noexcept
+{
+    if (mClusterCount == 0 || mPyramidTexture == 0)
+    {
+        return;
+    }
+
+    const unsigned int target = 1u - mCurrent;
+
+    mCullShader->bind();
+    mCullShader->setUniform(mCullUniforms.clusterCount, static_cast<GLuint>(mClusterCount));
+    mCullShader->setUniform(mCullUniforms.indexCount, static_cast<GLuint>(mIndexCount));
+    mCullShader->setUniform(mCullUniforms.minLevel, static_cast<GLuint>(minLevel));
+    mCullShader->setUniform(mCullUniforms.levels, static_cast<GLint>(mLevels));
+
+    GLStateCache::activeTexture(GL_TEXTURE0);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mPyramidTexture);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, CLUSTER_BINDING, mClusterBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, COMMAND_BINDING, mCommandBuffers[target]);
+    RenderStats::dispatchCompute(groupsFor(static_cast<int>(mClusterCount), kCullGroupSize), 1, 1);
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT);
+
+    GLStateCache::bindTexture(GL_TEXTURE_2D, 0);
+    mCurrent = target;
+}
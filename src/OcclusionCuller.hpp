@@ -0,0 +1,117 @@
+#ifndef OCCLUSION_CULLER_HPP
+#define OCCLUSION_CULLER_HPP
+
+#include <cstddef>
+#include <span>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "MemoryStats.hpp"
+#include "Shader.hpp"
+
+/// @brief GPU occlusion culling of the static maze wall clusters against a hierarchical-Z pyramid
+/// @details Each frame the caller draws occluders into a small depth target (beginDepthPass): the visible
+/// floors plus the walls that passed last frame's test (drawOccluders). Walls never move, so any subset of
+/// them is a correct occluder set. buildPyramid() reduces that depth to a max-depth mip chain with
+/// hiz.cs.glsl, then cull() runs occlusion_cull.cs.glsl once per cluster and writes one indirect draw per
+/// cluster, with zero instances when the cluster is off screen, under a higher floor or hidden. The
+/// commands alternate between two buffers so the occluder draw never reads what the cull is writing, and
+/// the CPU never reads any result back.
+class OcclusionCuller
+{
+public:
+    /// SSBO bindings shared with occlusion_cull.cs.glsl
+    static constexpr GLuint CLUSTER_BINDING = 0;
+    static constexpr GLuint COMMAND_BINDING = 1;
+
+    /// Width of the depth target; the height follows the viewport's aspect ratio
+    static constexpr int DEPTH_WIDTH = 512;
+
+    /// One wall cluster as laid out in the std430 Clusters block
+    struct Cluster
+    {
+        /// w = maze level
+        glm::vec4 aabbMin{0.0f};
+        glm::vec4 aabbMax{0.0f};
+        /// x = first wall instance, y = wall instance count
+        glm::uvec4 draw{0u};
+    };
+    static_assert(sizeof(Cluster) == 48, "Cluster must match the std430 block in occlusion_cull.cs.glsl");
+
+    OcclusionCuller() = default;
+    ~OcclusionCuller() noexcept;
+
+    OcclusionCuller(const OcclusionCuller &) = delete;
+    OcclusionCuller &operator=(const OcclusionCuller &) = delete;
+
+    /// Create the command and cluster buffers; the depth targets follow in beginDepthPass(). Needs the GL context
+    bool init(Shader &pyramidShader, Shader &cullShader) noexcept;
+    void destroy() noexcept;
+
+    /// @brief Replace the cluster list; every cluster draws nothing until the next cull()
+    /// @param indexCount Index count of the wall mesh every command draws
+    void setClusters(std::span<const Cluster> clusters, GLsizei indexCount) noexcept;
+
+    /// Bind and clear the depth target, sized for the viewport's aspect ratio
+    void beginDepthPass(int viewportWidth, int viewportHeight) noexcept;
+    /// Draw the walls visible last frame with the bound program and VAO
+    void drawOccluders(GLenum indexType) const noexcept;
+    /// Reduce the depth pass into the Hi-Z pyramid; leaves the depth target bound
+    void buildPyramid() noexcept;
+    /// @brief Test every cluster against the pyramid with the view-projection of the frame uniforms
+    /// @param minLevel Clusters below this maze level are culled outright
+    void cull(unsigned int minLevel) noexcept;
+    /// Draw the clusters that passed the last cull() with the bound program and VAO
+    void drawVisible(GLenum indexType) const noexcept;
+
+    [[nodiscard]] bool isInitialized() const noexcept { return mClusterBuffer != 0; }
+    [[nodiscard]] std::size_t getClusterCount() const noexcept { return mClusterCount; }
+
+private:
+    enum class Stage : GLuint
+    {
+        COPY = 0,
+        REDUCE = 1
+    };
+
+    struct PyramidUniforms
+    {
+        Shader::UniformHandle stage;
+    };
+
+    struct CullUniforms
+    {
+        Shader::UniformHandle clusterCount, indexCount, minLevel, levels;
+    };
+
+    void resizeTargets(int width, int height) noexcept;
+    void destroyTargets() noexcept;
+    void multiDraw(GLuint commandBuffer, GLenum indexType) const noexcept;
+
+    Shader *mPyramidShader{nullptr};
+    Shader *mCullShader{nullptr};
+    PyramidUniforms mPyramidUniforms;
+    CullUniforms mCullUniforms;
+
+    GLuint mFramebuffer{0};
+    GLuint mDepthTexture{0};
+    GLuint mPyramidTexture{0};
+    int mWidth{0};
+    int mHeight{0};
+    int mLevels{0};
+
+    GLuint mClusterBuffer{0};
+    /// [mCurrent] holds the last cull's commands; cull() writes the other one and flips
+    GLuint mCommandBuffers[2]{0, 0};
+    unsigned int mCurrent{0};
+    std::size_t mClusterCount{0};
+    std::size_t mCommandCapacity{0};
+    GLsizei mIndexCount{0};
+
+    MemoryStats::Allocation mTargetBytes{MemoryStats::Category::GPU_RENDER_TARGETS};
+    MemoryStats::Allocation mClusterBytes{MemoryStats::Category::GPU_STORAGE_BUFFERS};
+    MemoryStats::Allocation mCommandBytes{MemoryStats::Category::GPU_VERTEX_BUFFERS};
+};
+
+#endif // OCCLUSION_CULLER_HPP
@@ -6,25 +6,62 @@
 struct Options final
 {
     // Getter methods with defaults matching initial values
+    /// Swap late frames immediately instead of waiting a whole refresh; only with vsync
+    [[nodiscard]] bool getAdaptiveVsync() const noexcept { return mAdaptiveVsync.value_or(false); }
     [[nodiscard]] bool getAntiAliasing() const noexcept { return mAntiAliasing.value_or(true); }
+    [[nodiscard]] bool getDynamicResolution() const noexcept { return mDynamicResolution.value_or(true); }
     [[nodiscard]] bool getEnableMusic() const noexcept { return mEnableMusic.value_or(true); }
     [[nodiscard]] bool getEnableSound() const noexcept { return mEnableSound.value_or(true); }
     [[nodiscard]] bool getFullscreen() const noexcept { return mFullscreen.value_or(false); }
+    /// Delay input sampling by the predicted slack before vsync; only in low-latency mode
+    [[nodiscard]] bool getJustInTimeInput() const noexcept { return mJustInTimeInput.value_or(false); }
+    /// Cap how many frames the CPU may queue ahead of the GPU
+    [[nodiscard]] bool getLowLatency() const noexcept { return mLowLatency.value_or(false); }
+    /// Render the planar reflection every other frame and reproject it in between
+    [[nodiscard]] bool getReflectionHalfRate() const noexcept { return mReflectionHalfRate.value_or(true); }
+    /// Multiplayer mesh matches exchange only inputs and roll back on mispredictions
+    [[nodiscard]] bool getRollbackNetcode() const noexcept { return mRollbackNetcode.value_or(false); }
     [[nodiscard]] bool getShowDebugOverlay() const noexcept { return mShowDebugOverlay.value_or(true); }
+    /// Post aggregated frame, chunk, GPU and network timings to the network_url server; opt-in
+    [[nodiscard]] bool getTelemetryEnabled() const noexcept { return mTelemetryEnabled.value_or(false); }
+    [[nodiscard]] bool getThreadedSimulation() const noexcept { return mThreadedSimulation.value_or(false); }
     [[nodiscard]] bool getVsync() const noexcept { return mVsync.value_or(true); }
 
+    /// Least time remote players render behind their newest snapshot; jitter raises it further
+    [[nodiscard]] float getInterpolationDelay() const noexcept { return mInterpolationDelay.value_or(0.1f); }
     [[nodiscard]] float getMasterVolume() const noexcept { return mMasterVolume.value_or(25.0f); }
     [[nodiscard]] float getMusicVolume() const noexcept { return mMusicVolume.value_or(100.0f); }
+    /// Planar reflection resolution as a fraction of the window; 0 turns reflections off
+    [[nodiscard]] float getReflectionScale() const noexcept { return mReflectionScale.value_or(0.5f); }
     [[nodiscard]] float getRenderQuality() const noexcept { return mRenderQuality.value_or(1.0f); }
     [[nodiscard]] float getSfxVolume() const noexcept { return mSfxVolume.value_or(10.0f); }
+    /// Seconds of frames aggregated into each telemetry sample
+    [[nodiscard]] float getTelemetryIntervalSeconds() const noexcept { return mTelemetryIntervalSeconds.value_or(1.0f); }
+
+    /// Frames the GPU may still be working on when the next one starts, in low-latency mode
+    [[nodiscard]] int getMaxFramesInFlight() const noexcept { return mMaxFramesInFlight.value_or(1); }
+    /// Transparency (OIT) targets at 1/n of the render resolution per side: 1, 2 or 4
+    [[nodiscard]] int getOITDownscale() const noexcept { return mOITDownscale.value_or(2); }
 
     // Builder methods returning reference for fluent interface
+    Options &withAdaptiveVsync(bool value)
+    {
+        mAdaptiveVsync = value;
+        return *this;
+    }
+
     Options &withAntiAliasing(bool value)
     {
         mAntiAliasing = value;
         return *this;
     }
 
+    Options &withDynamicResolution(bool value)
+    {
+        mDynamicResolution = value;
+        return *this;
+    }
+
     Options &withEnableMusic(bool value)
     {
         mEnableMusic = value;
@@ -43,18 +80,60 @@ struct Options final
         return *this;
     }
 
+    Options &withJustInTimeInput(bool value)
+    {
+        mJustInTimeInput = value;
+        return *this;
+    }
+
+    Options &withLowLatency(bool value)
+    {
+        mLowLatency = value;
+        return *this;
+    }
+
+    Options &withReflectionHalfRate(bool value)
+    {
+        mReflectionHalfRate = value;
+        return *this;
+    }
+
+    Options &withRollbackNetcode(bool value)
+    {
+        mRollbackNetcode = value;
+        return *this;
+    }
+
     Options &withShowDebugOverlay(bool value)
     {
         mShowDebugOverlay = value;
         return *this;
     }
 
+    Options &withTelemetryEnabled(bool value)
+    {
+        mTelemetryEnabled = value;
+        return *this;
+    }
+
+    Options &withThreadedSimulation(bool value)
+    {
+        mThreadedSimulation = value;
+        return *this;
+    }
+
     Options &withVsync(bool value)
     {
         mVsync = value;
         return *this;
     }
 
+    Options &withInterpolationDelay(float value)
+    {
+        mInterpolationDelay = value;
+        return *this;
+    }
+
     Options &withMasterVolume(float value)
     {
         mMasterVolume = value;
@@ -67,6 +146,12 @@ struct Options final
         return *this;
     }
 
+    Options &withReflectionScale(float value)
+    {
+        mReflectionScale = value;
+        return *this;
+    }
+
     Options &withRenderQuality(float value)
     {
         mRenderQuality = value;
@@ -78,18 +163,50 @@ struct Options final
         mSfxVolume = value;
         return *this;
     }
+
+    Options &withTelemetryIntervalSeconds(float value)
+    {
+        mTelemetryIntervalSeconds = value;
+        return *this;
+    }
+
+    Options &withMaxFramesInFlight(int value)
+    {
+        mMaxFramesInFlight = value;
+        return *this;
+    }
+
+    Options &withOITDownscale(int value)
+    {
+        mOITDownscale = value;
+        return *this;
+    }
 private:
+    std::optional<bool> mAdaptiveVsync;
     std::optional<bool> mAntiAliasing;
+    std::optional<bool> mDynamicResolution;
     std::optional<bool> mEnableMusic;
     std::optional<bool> mEnableSound;
     std::optional<bool> mFullscreen;
+    std::optional<bool> mJustInTimeInput;
+    std::optional<bool> mLowLatency;
+    std::optional<bool> mReflectionHalfRate;
+    std::optional<bool> mRollbackNetcode;
     std::optional<bool> mShowDebugOverlay;
+    std::optional<bool> mTelemetryEnabled;
+    std::optional<bool> mThreadedSimulation;
     std::optional<bool> mVsync;
 
+    std::optional<float> mInterpolationDelay;
     std::optional<float> mMasterVolume;
     std::optional<float> mMusicVolume;
+    std::optional<float> mReflectionScale;
     std::optional<float> mRenderQuality;
     std::optional<float> mSfxVolume;
+    std::optional<float> mTelemetryIntervalSeconds;
+
+    std::optional<int> mMaxFramesInFlight;
+    std::optional<int> mOITDownscale;
 }; // Options struct
 
 #endif // OPTIONS_HPP
@@ -0,0 +1,34 @@
+// Asset packer: writes the shipped asset directories into one AssetPack archive
+// Usage: breakingwalls_pack <resource_root> <output.bwpak> [directory...]
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "AssetPack.hpp"
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <resource_root> <output.bwpak> [directory...]" << std::endl;
+
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::string> directories{"audio", "models", "shaders", "textures"};
+    if (argc > 3)
+    {
+        directories.assign(argv + 3, argv + argc);
+    }
+
+    if (AssetPack::write(argv[2], argv[1], directories) == 0)
+    {
+        std::cerr << "Failed to write " << argv[2] << std::endl;
+
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
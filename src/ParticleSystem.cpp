@@ -0,0 +1,369 @@
+#include "ParticleSystem.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <string>
+
+#include "CPUProfiler.hpp"
+#include "GLStateCache.hpp"
+#include "RenderStats.hpp"
+
+namespace
+{
+    constexpr GLintptr kDispatchOffset = 16;
+    constexpr GLintptr kDrawOffset = 32;
+} // namespace
+
+ParticleSystem::~ParticleSystem() noexcept
+{
+    destroy();
+}
+
+bool ParticleSystem::init(Shader &computeShader, Shader &renderShader, GLuint capacity) noexcept
+{
+    BW_PROFILE_ZONE("ParticleSystem::init");
+
+    destroy();
+
+    if (capacity == 0 || !computeShader.isLinked() || !renderShader.isLinked())
+    {
+        return false;
+    }
+
+    ensureGroupSize(computeShader);
+    if (!computeShader.isLinked())
+    {
+        return false;
+    }
+
+    mComputeShader = &computeShader;
+    mRenderShader = &renderShader;
+    mCapacity = capacity;
+
+    mComputeUniforms.stage = computeShader.getUniformHandle("uStage");
+    mComputeUniforms.capacity = computeShader.getUniformHandle("uCapacity");
+    mComputeUniforms.aliveSlot = computeShader.getUniformHandle("uAliveSlot");
+    mComputeUniforms.emitCount = computeShader.getUniformHandle("uEmitCount");
+    mComputeUniforms.emitSeed = computeShader.getUniformHandle("uEmitSeed");
+    mComputeUniforms.emitCenter = computeShader.getUniformHandle("uEmitCenter");
+    mComputeUniforms.emitExtent = computeShader.getUniformHandle("uEmitExtent");
+    mComputeUniforms.emitVelocity = computeShader.getUniformHandle("uEmitVelocity");
+    mComputeUniforms.emitLife = computeShader.getUniformHandle("uEmitLife");
+    mComputeUniforms.attractor1 = computeShader.getUniformHandle("BlackHolePos1");
+    mComputeUniforms.attractor2 = computeShader.getUniformHandle("BlackHolePos2");
+    mComputeUniforms.gravity1 = computeShader.getUniformHandle("Gravity1");
+    mComputeUniforms.gravity2 = computeShader.getUniformHandle("Gravity2");
+    mComputeUniforms.invMass = computeShader.getUniformHandle("ParticleInvMass");
+    mComputeUniforms.maxDist = computeShader.getUniformHandle("MaxDist");
+    mComputeUniforms.deltaT = computeShader.getUniformHandle("DeltaT");
+    mComputeUniforms.lifeStep = computeShader.getUniformHandle("uLifeStep");
+
+    mRenderUniforms.color = renderShader.getUniformHandle("Color");
+    mRenderUniforms.pooled = renderShader.getUniformHandle("uPooled");
+    mRenderUniforms.aliveBase = renderShader.getUniformHandle("uAliveBase");
+    mRenderUniforms.oitPass = renderShader.getUniformHandle("uOITPass");
+    mRenderUniforms.oitWeightScale = renderShader.getUniformHandle("uOITWeightScale");
+
+    const auto vec4Bytes = static_cast<GLsizeiptr>(capacity) * static_cast<GLsizeiptr>(sizeof(glm::vec4));
+    const auto indexBytes = static_cast<GLsizeiptr>(capacity) * static_cast<GLsizeiptr>(sizeof(GLuint));
+
+    glGenBuffers(1, &mPositionBuffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mPositionBuffer);
+    RenderStats::bufferData(GL_SHADER_STORAGE_BUFFER, vec4Bytes, nullptr, GL_DYNAMIC_COPY);
+
+    glGenBuffers(1, &mVelocityBuffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mVelocityBuffer);
+    RenderStats::bufferData(GL_SHADER_STORAGE_BUFFER, vec4Bytes, nullptr, GL_DYNAMIC_COPY);
+
+    glGenBuffers(1, &mAliveBuffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mAliveBuffer);
+    RenderStats::bufferData(GL_SHADER_STORAGE_BUFFER, indexBytes * 2, nullptr, GL_DYNAMIC_COPY);
+
+    glGenBuffers(1, &mDeadBuffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mDeadBuffer);
+    RenderStats::bufferData(GL_SHADER_STORAGE_BUFFER, indexBytes, nullptr, GL_DYNAMIC_COPY);
+
+    glGenBuffers(1, &mCounterBuffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mCounterBuffer);
+    RenderStats::bufferData(GL_SHADER_STORAGE_BUFFER, sizeof(Counters), nullptr, GL_DYNAMIC_COPY);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    mBufferBytes.set(static_cast<std::size_t>(vec4Bytes * 2 + indexBytes * 3) + sizeof(Counters));
+
+    // The vertex shader pulls positions through the alive list; the VAO has no attributes
+    glGenVertexArrays(1, &mVertexArray);
+
+    resetLists(0);
+
+    if (const GLenum error = glGetError(); error != GL_NO_ERROR)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "ParticleSystem: OpenGL error while creating a pool of %u: 0x%x",
+                     capacity, error);
+        destroy();
+        return false;
+    }
+
+    SDL_Log("ParticleSystem: pool of %u particles, work group size %u", capacity, mGroupSize);
+    return true;
+}
+
+void ParticleSystem::destroy() noexcept
+{
+    for (GLuint *buffer : {&mPositionBuffer, &mVelocityBuffer, &mAliveBuffer, &mDeadBuffer, &mCounterBuffer})
+    {
+        if (*buffer != 0)
+        {
+            glDeleteBuffers(1, buffer);
+            *buffer = 0;
+        }
+    }
+    mBufferBytes.set(0);
+
+    if (mVertexArray != 0)
+    {
+        GLStateCache::forgetVertexArray(mVertexArray);
+        glDeleteVertexArrays(1, &mVertexArray);
+        mVertexArray = 0;
+    }
+
+    mComputeShader = nullptr;
+    mRenderShader = nullptr;
+    mCapacity = 0;
+    mAliveSlot = 0;
+    mPendingEmits.clear();
+    mClock = 0.0f;
+    mAliveUntil = 0.0f;
+}
+
+void ParticleSystem::emit(const Emitter &emitter)
+{
+    if (!isInitialized() || emitter.count == 0)
+    {
+        return;
+    }
+
+    mPendingEmits.push_back(emitter);
+
+    if (emitter.lifeSeconds <= 0.0f)
+    {
+        mAliveUntil = -1.0f;
+    }
+    else if (mAliveUntil >= 0.0f)
+    {
+        mAliveUntil = std::max(mAliveUntil, mClock + emitter.lifeSeconds);
+    }
+}
+
+void ParticleSystem::seed(std::span<const glm::vec4> positions, float lifeSeconds) noexcept
+{
+    if (!isInitialized())
+    {
+        return;
+    }
+
+    const auto count = static_cast<GLuint>(std::min<std::size_t>(positions.size(), mCapacity));
+    const std::vector<glm::vec4> velocities(count, glm::vec4(0.0f, 0.0f, 0.0f, std::max(lifeSeconds, 0.0f)));
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mPositionBuffer);
+    RenderStats::bufferSubData(GL_SHADER_STORAGE_BUFFER, 0, static_cast<GLsizeiptr>(count * sizeof(glm::vec4)), positions.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mVelocityBuffer);
+    RenderStats::bufferSubData(GL_SHADER_STORAGE_BUFFER, 0, static_cast<GLsizeiptr>(count * sizeof(glm::vec4)), velocities.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    mPendingEmits.clear();
+    resetLists(count);
+
+    mClock = 0.0f;
+    mAliveUntil = (count == 0) ? 0.0f : (lifeSeconds <= 0.0f ? -1.0f : lifeSeconds);
+}
+
+void ParticleSystem::clear() noexcept
+{
+    if (!isInitialized())
+    {
+        return;
+    }
+
+    mPendingEmits.clear();
+    resetLists(0);
+    mClock = 0.0f;
+    mAliveUntil = 0.0f;
+}
+
+bool ParticleSystem::isActive() const noexcept
+{
+    return isInitialized() && (mAliveUntil < 0.0f || mClock < mAliveUntil);
+}
+
+void ParticleSystem::update(const Forces &forces) noexcept
+{
+    if (!isInitialized() || (!isActive() && mPendingEmits.empty()))
+    {
+        return;
+    }
+
+    BW_PROFILE_ZONE("ParticleSystem::update");
+
+    bindBuffers();
+
+    Shader &shader = *mComputeShader;
+    shader.bind();
+    shader.setUniform(mComputeUniforms.capacity, mCapacity);
+    shader.setUniform(mComputeUniforms.aliveSlot, mAliveSlot);
+
+    // Emits append to the current alive list, so they are simulated (and drawn) this frame
+    if (!mPendingEmits.empty())
+    {
+        shader.setUniform(mComputeUniforms.stage, static_cast<GLuint>(Stage::EMIT));
+        for (const Emitter &emitter : mPendingEmits)
+        {
+            const GLuint count = std::min(emitter.count, mCapacity);
+            shader.setUniform(mComputeUniforms.emitCount, count);
+            shader.setUniform(mComputeUniforms.emitSeed, mEmitSeed);
+            shader.setUniform(mComputeUniforms.emitCenter, emitter.center);
+            shader.setUniform(mComputeUniforms.emitExtent, emitter.extent);
+            shader.setUniform(mComputeUniforms.emitVelocity, emitter.velocity);
+            shader.setUniform(mComputeUniforms.emitLife, std::max(emitter.lifeSeconds, 0.0f));
+            RenderStats::dispatchCompute((count + mGroupSize - 1) / mGroupSize, 1, 1);
+            glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+            mEmitSeed += count;
+        }
+        mPendingEmits.clear();
+    }
+
+    shader.setUniform(mComputeUniforms.stage, static_cast<GLuint>(Stage::PREPARE));
+    RenderStats::dispatchCompute(1, 1, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+
+    shader.setUniform(mComputeUniforms.stage, static_cast<GLuint>(Stage::SIMULATE));
+    shader.setUniform(mComputeUniforms.attractor1, forces.attractor1);
+    shader.setUniform(mComputeUniforms.attractor2, forces.attractor2);
+    shader.setUniform(mComputeUniforms.gravity1, forces.gravity1);
+    shader.setUniform(mComputeUniforms.gravity2, forces.gravity2);
+    shader.setUniform(mComputeUniforms.invMass, forces.invMass);
+    shader.setUniform(mComputeUniforms.maxDist, forces.maxDist);
+    shader.setUniform(mComputeUniforms.deltaT, forces.deltaT);
+    shader.setUniform(mComputeUniforms.lifeStep, forces.lifeStep);
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, mCounterBuffer);
+    RenderStats::dispatchComputeIndirect(kDispatchOffset);
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, 0);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    shader.setUniform(mComputeUniforms.stage, static_cast<GLuint>(Stage::FINISH));
+    RenderStats::dispatchCompute(1, 1, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+
+    // The survivors were compacted into the other half of the alive list
+    mAliveSlot ^= 1u;
+    mClock += forces.lifeStep;
+}
+
+void ParticleSystem::draw(const glm::vec4 &color, float pointSize, bool oitPass) const noexcept
+{
+    if (!isActive())
+    {
+        return;
+    }
+
+    bindBuffers();
+
+    mRenderShader->bind();
+    mRenderShader->setUniform(mRenderUniforms.color, color);
+    mRenderShader->setUniform(mRenderUniforms.pooled, 1);
+    mRenderShader->setUniform(mRenderUniforms.aliveBase, mAliveSlot * mCapacity);
+    mRenderShader->setUniform(mRenderUniforms.oitPass, static_cast<GLint>(oitPass ? 1 : 0));
+    mRenderShader->setUniform(mRenderUniforms.oitWeightScale, 6.0f);
+
+    glPointSize(pointSize);
+    GLStateCache::bindVertexArray(mVertexArray);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, mCounterBuffer);
+    RenderStats::drawArraysIndirect(GL_POINTS, reinterpret_cast<const void *>(kDrawOffset));
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    GLStateCache::bindVertexArray(0);
+
+    // The attribute path stays the default for other users of the render shader
+    mRenderShader->setUniform(mRenderUniforms.pooled, 0);
+    mRenderShader->setUniform(mRenderUniforms.oitPass, 0);
+}
+
+GLuint ParticleSystem::preferredGroupSize() noexcept
+{
+    const auto *vendor = reinterpret_cast<const char *>(glGetString(GL_VENDOR));
+    const std::string name = vendor ? vendor : "";
+
+    // A few waves per group: 32-wide warps on NVIDIA, 64-wide wavefronts on AMD, SIMD8/16 threads on Intel
+    GLuint size = 64;
+    if (name.find("NVIDIA") != std::string::npos)
+    {
+        size = 128;
+    }
+    else if (name.find("AMD") != std::string::npos || name.find("ATI") != std::string::npos)
+    {
+        size = 256;
+    }
+
+    GLint maxSizeX = 0;
+    GLint maxInvocations = 0;
+    glGetIntegeri_v(GL_MAX_COMPUTE_WORK_GROUP_SIZE, 0, &maxSizeX);
+    glGetIntegerv(GL_MAX_COMPUTE_WORK_GROUP_INVOCATIONS, &maxInvocations);
+    const GLint limit = std::min(maxSizeX, maxInvocations);
+    if (limit > 0)
+    {
+        size = std::min(size, static_cast<GLuint>(limit));
+    }
+    return std::max(size, 1u);
+}
+
+void ParticleSystem::ensureGroupSize(Shader &computeShader) noexcept
+{
+    const GLuint preferred = preferredGroupSize();
+
+    GLint compiled[3] = {0, 0, 0};
+    glGetProgramiv(computeShader.getProgramHandle(), GL_COMPUTE_WORK_GROUP_SIZE, compiled);
+
+    // Pools sharing the shader only pay for the rebuild once
+    if (static_cast<GLuint>(compiled[0]) != preferred)
+    {
+        computeShader.recompileWithDefines("#define PARTICLE_GROUP_SIZE " + std::to_string(preferred) + "\n");
+        glGetProgramiv(computeShader.getProgramHandle(), GL_COMPUTE_WORK_GROUP_SIZE, compiled);
+    }
+
+    mGroupSize = static_cast<GLuint>(std::max(compiled[0], 1));
+}
+
+void ParticleSystem::bindBuffers() const noexcept
+{
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, POSITION_BINDING, mPositionBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, VELOCITY_BINDING, mVelocityBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, ALIVE_BINDING, mAliveBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, DEAD_BINDING, mDeadBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, COUNTER_BINDING, mCounterBuffer);
+}
+
+void ParticleSystem::resetLists(GLuint aliveCount) noexcept
+{
+    // Particles [0, aliveCount) are alive in slot 0, the rest are free
+    std::vector<GLuint> indices(mCapacity);
+    std::iota(indices.begin(), indices.end(), 0u);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mAliveBuffer);
+    RenderStats::bufferSubData(GL_SHADER_STORAGE_BUFFER, 0, static_cast<GLsizeiptr>(aliveCount * sizeof(GLuint)), indices.data());
+
+    // Popped from the back, so the lowest free index is handed out first
+    std::reverse(indices.begin(), indices.end());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mDeadBuffer);
+    RenderStats::bufferSubData(GL_SHADER_STORAGE_BUFFER, 0, static_cast<GLsizeiptr>((mCapacity - aliveCount) * sizeof(GLuint)),
+                               indices.data());
+
+    Counters counters;
+    counters.aliveCount[0] = aliveCount;
+    counters.deadCount = static_cast<GLint>(mCapacity - aliveCount);
+    counters.draw[0] = aliveCount;
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mCounterBuffer);
+    RenderStats::bufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(Counters), &counters);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    mAliveSlot = 0;
+}
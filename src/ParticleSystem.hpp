@@ -0,0 +1,154 @@
+#ifndef PARTICLE_SYSTEM_HPP
+#define PARTICLE_SYSTEM_HPP
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "MemoryStats.hpp"
+#include "Shader.hpp"
+
+/// @brief Fixed pool of GPU particles pulled between two attractors
+/// @details Live particle indices are kept in an alive list that the simulate pass compacts into the
+/// other half of the list every frame; expired particles go back on a dead list for later emits. The
+/// simulate dispatch and the point draw read their sizes from a counter buffer on the GPU
+/// (glDispatchComputeIndirect / glDrawArraysIndirect), so only live particles cost anything and the
+/// CPU never reads a count back. All passes are stages of particles.cs.glsl, compiled with a work
+/// group size picked for the GPU vendor.
+class ParticleSystem
+{
+public:
+    /// SSBO bindings shared with particles.cs.glsl and particles.vert.glsl
+    static constexpr GLuint POSITION_BINDING = 0;
+    static constexpr GLuint VELOCITY_BINDING = 1;
+    static constexpr GLuint ALIVE_BINDING = 2;
+    static constexpr GLuint DEAD_BINDING = 3;
+    static constexpr GLuint COUNTER_BINDING = 4;
+
+    /// Spawn request; particles are placed at random inside the box center +- extent / 2
+    struct Emitter
+    {
+        glm::vec3 center{0.0f};
+        glm::vec3 extent{1.0f};
+        glm::vec3 velocity{0.0f};
+        /// Seconds until the particle returns to the pool; 0 keeps it alive until clear()
+        float lifeSeconds{0.0f};
+        GLuint count{0};
+    };
+
+    /// Per-frame simulation parameters
+    struct Forces
+    {
+        glm::vec3 attractor1{5.0f, 0.0f, 0.0f};
+        glm::vec3 attractor2{-5.0f, 0.0f, 0.0f};
+        float gravity1{1000.0f};
+        float gravity2{1000.0f};
+        float invMass{10.0f};
+        /// Particles further than this from the second attractor restart between the two
+        float maxDist{45.0f};
+        /// Integration step (may be scaled or slowed down)
+        float deltaT{0.0005f};
+        /// Wall-clock seconds taken off every particle's life
+        float lifeStep{0.0f};
+    };
+
+    ParticleSystem() = default;
+    ~ParticleSystem() noexcept;
+
+    ParticleSystem(const ParticleSystem &) = delete;
+    ParticleSystem &operator=(const ParticleSystem &) = delete;
+
+    /// @brief Allocate a pool of capacity particles, all dead; needs the GL context
+    /// @details Recompiles computeShader once if its work group size does not match the vendor's preferred one
+    bool init(Shader &computeShader, Shader &renderShader, GLuint capacity) noexcept;
+    void destroy() noexcept;
+
+    /// Queue a spawn for the next update(); spawns beyond the free particles are dropped on the GPU
+    void emit(const Emitter &emitter);
+    /// @brief Replace the whole pool with these positions (zero velocity); the rest of the pool stays dead
+    /// @param lifeSeconds As Emitter::lifeSeconds
+    void seed(std::span<const glm::vec4> positions, float lifeSeconds = 0.0f) noexcept;
+    /// Kill every particle
+    void clear() noexcept;
+
+    /// Run queued emits, then simulate and compact the live particles
+    void update(const Forces &forces) noexcept;
+    /// @brief Draw the live particles as points with the render shader bound by init()
+    /// @param oitPass Write weighted-blended accum and reveal outputs instead of a plain blended color
+    void draw(const glm::vec4 &color, float pointSize, bool oitPass = false) const noexcept;
+
+    /// @brief True while particles may still be alive
+    /// @details A CPU-side upper bound from emit times and lifetimes, so an idle pool skips its passes entirely
+    [[nodiscard]] bool isActive() const noexcept;
+
+    [[nodiscard]] bool isInitialized() const noexcept { return mPositionBuffer != 0; }
+    [[nodiscard]] GLuint getCapacity() const noexcept { return mCapacity; }
+    [[nodiscard]] GLuint getGroupSize() const noexcept { return mGroupSize; }
+
+private:
+    enum class Stage : GLuint
+    {
+        EMIT = 0,
+        PREPARE = 1,
+        SIMULATE = 2,
+        FINISH = 3
+    };
+
+    /// Counter block of particles.cs.glsl (std430); the indirect commands are read straight from it
+    struct Counters
+    {
+        GLuint aliveCount[2]{0, 0};
+        GLint deadCount{0};
+        GLuint padding0{0};
+        GLuint dispatch[3]{0, 1, 1};
+        GLuint padding1{0};
+        GLuint draw[4]{0, 1, 0, 0};
+    };
+    static_assert(sizeof(Counters) == 48, "Counters must match the std430 block in particles.cs.glsl");
+
+    struct ComputeUniforms
+    {
+        Shader::UniformHandle stage, capacity, aliveSlot, emitCount, emitSeed, emitCenter, emitExtent, emitVelocity,
+            emitLife, attractor1, attractor2, gravity1, gravity2, invMass, maxDist, deltaT, lifeStep;
+    };
+
+    struct RenderUniforms
+    {
+        Shader::UniformHandle color, pooled, aliveBase, oitPass, oitWeightScale;
+    };
+
+    /// Work group size for this GPU, within the driver's limits
+    [[nodiscard]] static GLuint preferredGroupSize() noexcept;
+    void ensureGroupSize(Shader &computeShader) noexcept;
+    void bindBuffers() const noexcept;
+    void resetLists(GLuint aliveCount) noexcept;
+
+    Shader *mComputeShader{nullptr};
+    Shader *mRenderShader{nullptr};
+    ComputeUniforms mComputeUniforms;
+    RenderUniforms mRenderUniforms;
+
+    GLuint mPositionBuffer{0};
+    GLuint mVelocityBuffer{0};
+    /// Two halves of capacity entries; mAliveSlot is the one holding this frame's live particles
+    GLuint mAliveBuffer{0};
+    GLuint mDeadBuffer{0};
+    GLuint mCounterBuffer{0};
+    MemoryStats::Allocation mBufferBytes{MemoryStats::Category::GPU_STORAGE_BUFFERS};
+    GLuint mVertexArray{0};
+    GLuint mCapacity{0};
+    GLuint mGroupSize{0};
+    GLuint mAliveSlot{0};
+    GLuint mEmitSeed{0};
+
+    std::vector<Emitter> mPendingEmits;
+    /// Sum of the lifeSteps simulated so far
+    float mClock{0.0f};
+    /// mClock at which every particle has expired; negative while particles without a lifetime exist
+    float mAliveUntil{0.0f};
+};
+
+#endif // PARTICLE_SYSTEM_HPP
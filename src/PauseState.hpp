@@ -15,6 +15,11 @@ public:
     bool update(float dt, unsigned int subSteps) noexcept override;
     bool handleEvent(const SDL_Event &event) noexcept override;
 
+    [[nodiscard]] bool blocksUpdates() const noexcept override { return true; }
+
+    /// Nothing animates; the game underneath is frozen
+    [[nodiscard]] std::uint32_t getIdleTimeoutMs() const noexcept override { return IDLE_REDRAW_MS; }
+
 private:
     Font *mFont;
     MusicPlayer *mMusic;
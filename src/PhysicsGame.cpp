@@ -6,7 +6,9 @@
 
 #include "PhysicsGame.hpp"
 
+#include <chrono>
 #include <cmath>
+#include <cstdint>
 #include <functional>
 #include <future>
 #include <memory>
@@ -23,28 +25,44 @@
 #include <dearimgui/backends/imgui_impl_sdl3.h>
 #include <dearimgui/backends/imgui_impl_opengl3.h>
 
+#include "CPUProfiler.hpp"
+#include "FlyThroughBenchmark.hpp"
 #include "Font.hpp"
+#include "FrameArena.hpp"
+#include "FrameCapture.hpp"
+#include "FramePacer.hpp"
 #include "GameState.hpp"
 #include "GLSDLHelper.hpp"
+#include "GLStateCache.hpp"
+#include "GPUProfiler.hpp"
+#include "HotReload.hpp"
 #include "HttpClient.hpp"
+#include "InputRecorder.hpp"
+#include "JobSystem.hpp"
 #include "JSONUtils.hpp"
 #include "Level.hpp"
 #include "LoadingState.hpp"
+#include "MemoryStats.hpp"
 #include "MenuState.hpp"
 #include "MultiplayerGameState.hpp"
 #include "MusicPlayer.hpp"
 #include "Options.hpp"
 #include "PauseState.hpp"
 #include "Player.hpp"
+#include "RenderStats.hpp"
 #include "RenderWindow.hpp"
+#include "ResourceConfig.hpp"
 #include "ResourceIdentifiers.hpp"
 #include "ResourceManager.hpp"
 #include "Shader.hpp"
 #include "SoundPlayer.hpp"
 #include "SplashState.hpp"
+#include "StartupTimeline.hpp"
 #include "State.hpp"
 #include "StateStack.hpp"
+#include "Telemetry.hpp"
 #include "Texture.hpp"
+#include "TextureAtlas.hpp"
 
 namespace
 {
@@ -60,12 +78,32 @@ namespace
 #endif
                        });
     }
+
+    /// Diagnostic dumps go next to the other per-user data so production captures are easy to collect
+    std::string prefDataPath(const std::string &fileName)
+    {
+        std::string path;
+        if (char *prefPath = SDL_GetPrefPath("Flips And Ale", "Breaking Walls"); prefPath != nullptr)
+        {
+            path = prefPath;
+            SDL_free(prefPath);
+        }
+        return path + fileName;
+    }
+
+#if defined(BREAKING_WALLS_PROFILE)
+    void dumpProfileTrace(const char *tag) noexcept
+    {
+        CPUProfiler::dumpChromeTrace(prefDataPath("trace_" + std::string(tag) + "_" + std::to_string(SDL_GetTicks()) + ".json"));
+    }
+#endif
 }
 
 struct PhysicsGame::PhysicsGameImpl
 {
     Player mPlayer1;
     HttpClient mHttpClient;
+    ResourceConfig mResourceConfig;
 
     std::unique_ptr<RenderWindow> mRenderWindow;
     std::unique_ptr<StateStack> mStateStack;
@@ -80,6 +118,7 @@ struct PhysicsGame::PhysicsGameImpl
     std::unique_ptr<SoundPlayer> mSounds;
     ShaderManager mShaders;
     TextureManager mTextures;
+    TextureAtlas mTextureAtlas;
     VAOManager mVAOs;
     FBOManager mFBOs;
     VBOManager mVBOs;
@@ -90,6 +129,11 @@ struct PhysicsGame::PhysicsGameImpl
     mutable float mSmoothedFrameTime = 0.0f;
     static constexpr double FPS_UPDATE_INTERVAL = 250.0;
 
+    /// Frames drawn at full rate after input or a state change, so ImGui hover and layout settle first
+    static constexpr int IDLE_SETTLE_FRAMES = 3;
+    mutable int mSettleFrames = IDLE_SETTLE_FRAMES;
+    mutable std::uint64_t mSeenStackChanges = 0;
+
     std::string mWindowTitle;
     std::string mResourcePath;
     const int INIT_WINDOW_W, INIT_WINDOW_H;
@@ -123,11 +167,14 @@ struct PhysicsGame::PhysicsGameImpl
                 .withSoundPlayer(*mSounds)
                 .withShaderManager(mShaders)
                 .withTextureManager(mTextures)
+                .withTextureAtlas(mTextureAtlas)
                 .withVAOManager(mVAOs)
                 .withFBOManager(mFBOs)
                 .withVBOManager(mVBOs)
                 .withPlayer(mPlayer1)
-                .withHttpClient(mHttpClient));
+                .withHttpClient(mHttpClient)
+                .withResourceConfig(mResourceConfig));
+        Telemetry::setHttpClient(&mHttpClient);
 
         registerStates();
 
@@ -136,6 +183,9 @@ struct PhysicsGame::PhysicsGameImpl
 
     ~PhysicsGameImpl()
     {
+        // Queues the last samples while mHttpClient is still alive
+        Telemetry::shutdown();
+
         if (auto &&sdl = mGLSDLHelper; sdl.getWindow())
         {
             if (mStateStack)
@@ -143,20 +193,24 @@ struct PhysicsGame::PhysicsGameImpl
                 mStateStack.reset();
             }
 
+            // The ImGui atlas calls back into Font's glyph data when it releases its fonts, so it goes first
+            ImGui_ImplOpenGL3_Shutdown();
+            ImGui_ImplSDL3_Shutdown();
+            ImGui::DestroyContext();
+
             mFonts.clear();
             mLevels.clear();
             mMusic.clear();
             mSoundBuffers.clear();
             mSounds.reset();
+            HotReload::clear();
             mShaders.clear();
+            mTextureAtlas.destroy();
             mTextures.clear();
             mVAOs.clear();
             mFBOs.clear();
             mVBOs.clear();
-
-            ImGui_ImplOpenGL3_Shutdown();
-            ImGui_ImplSDL3_Shutdown();
-            ImGui::DestroyContext();
+            FrameCapture::shutdown();
 
             sdl.destroyAndQuit();
         }
@@ -197,27 +251,121 @@ struct PhysicsGame::PhysicsGameImpl
             return;
         }
 
-        SDL_Event event;
+        BW_PROFILE_ZONE("PhysicsGame::processInput");
+
+        if (!InputRecorder::beginStep())
+        {
+            SDL_Log("Input replay finished - clearing state stack");
+            mStateStack->clearStates();
+            return;
+        }
 
+        SDL_Event event;
         while (SDL_PollEvent(&event))
         {
-            // Let ImGui process the event first
-            ImGui_ImplSDL3_ProcessEvent(&event);
+            // A replay is the only input; quit and window events still come from the live queue
+            if (InputRecorder::isReplaying() && InputRecorder::isReplayedType(event))
+            {
+                continue;
+            }
+            InputRecorder::recordEvent(event);
+            if (!dispatchEvent(event))
+            {
+                return;
+            }
+        }
 
-            if (event.type == SDL_EVENT_QUIT)
+        while (InputRecorder::nextReplayEvent(event))
+        {
+            if (!dispatchEvent(event))
             {
-                SDL_Log("SDL_EVENT_QUIT received - clearing state stack");
-                mStateStack->clearStates();
-                // Don't process any more events after quit
                 return;
             }
+        }
+    }
+
+    /// @return false after a quit, when the rest of the queue is left alone
+    bool dispatchEvent(const SDL_Event &event) const noexcept
+    {
+        mSettleFrames = IDLE_SETTLE_FRAMES;
 
-            // Only handle events if state stack is not empty
-            if (!mStateStack->isEmpty())
+        // Let ImGui process the event first
+        ImGui_ImplSDL3_ProcessEvent(&event);
+
+#if defined(BREAKING_WALLS_PROFILE)
+        if (event.type == SDL_EVENT_KEY_DOWN && !event.key.repeat && event.key.scancode == SDL_SCANCODE_F9)
+        {
+            dumpProfileTrace("hotkey");
+        }
+#endif
+        if (event.type == SDL_EVENT_KEY_DOWN && !event.key.repeat && event.key.scancode == SDL_SCANCODE_F8)
+        {
+            MemoryStats::dump(prefDataPath("memory_" + std::to_string(SDL_GetTicks()) + ".json"));
+        }
+        // F10 records a PNG sequence, Shift+F10 raw video; either key stops a recording
+        if (event.type == SDL_EVENT_KEY_DOWN && !event.key.repeat && event.key.scancode == SDL_SCANCODE_F10)
+        {
+            if (FrameCapture::isRecording())
+            {
+                FrameCapture::stop();
+            }
+            else
             {
-                mStateStack->handleEvent(event);
+                const auto format = (event.key.mod & SDL_KMOD_SHIFT) != 0 ? FrameCapture::Format::RAW_VIDEO
+                                                                          : FrameCapture::Format::PNG_SEQUENCE;
+                FrameCapture::start(prefDataPath("capture_" + std::to_string(SDL_GetTicks())), format);
             }
         }
+
+        if (event.type == SDL_EVENT_QUIT)
+        {
+            SDL_Log("SDL_EVENT_QUIT received - clearing state stack");
+            mStateStack->clearStates();
+            // Don't process any more events after quit
+            return false;
+        }
+
+        // Only handle events if state stack is not empty
+        if (!mStateStack->isEmpty())
+        {
+            mStateStack->handleEvent(event);
+        }
+        return true;
+    }
+
+    /// @brief How long run() may block for events before the next frame; 0 runs the loop at display rate
+    Uint32 idleTimeoutMs() const noexcept
+    {
+        if (const std::uint64_t changes = mStateStack->getChangeCount(); changes != mSeenStackChanges)
+        {
+            mSeenStackChanges = changes;
+            mSettleFrames = IDLE_SETTLE_FRAMES;
+        }
+        if (mSettleFrames > 0)
+        {
+            return 0;
+        }
+
+        // Anything timing, recording or replaying frames needs every one of them
+        if (FrameCapture::isRecording() || StartupTimeline::isRunning() || FlyThroughBenchmark::isRunning() ||
+            InputRecorder::isRecording() || InputRecorder::isReplaying())
+        {
+            return 0;
+        }
+
+        // Cooperative jobs only advance while the loop turns
+        if (JobSystem::instance()->isCooperative() && JobSystem::instance()->getQueuedJobCount() > 0)
+        {
+            return 0;
+        }
+
+        // ImGui cannot ask for a redraw; a held widget or a blinking text caret are what would
+        if (ImGui::IsAnyItemActive() || ImGui::GetIO().WantTextInput)
+        {
+            return 0;
+        }
+
+        return mStateStack->getIdleTimeoutMs();
     }
 
     void update(const float dt, int subSteps = 4) const noexcept
@@ -227,10 +375,13 @@ struct PhysicsGame::PhysicsGameImpl
             return;
         }
 
+        BW_PROFILE_ZONE("PhysicsGame::update");
+
         mStateStack->update(dt, subSteps);
     }
 
-    void render(const double elapsed) const noexcept
+    /// @param alpha Fraction of a fixed step accumulated since the last update
+    void render(const double elapsed, const float alpha) const noexcept
     {
         // Only render if state stack has states
         if (!mRenderWindow || !mStateStack || !mRenderWindow->isOpen() || mStateStack->isEmpty())
@@ -238,25 +389,61 @@ struct PhysicsGame::PhysicsGameImpl
             return;
         }
 
+        BW_PROFILE_ZONE("PhysicsGame::render");
+
         // Clear, draw, and present (like SFML)
+        GLStateCache::resetStats();
+        RenderStats::beginFrame();
         mRenderWindow->clear();
 
+        const auto &frameOptions = mOptions.get(GUIOptions::ID::DE_FACTO);
+        const bool showDebugOverlay = frameOptions.getShowDebugOverlay();
+        // Dynamic resolution steers by the measured pass times, so the queries run for it too
+        GPUProfiler::setEnabled(showDebugOverlay || frameOptions.getDynamicResolution() || FlyThroughBenchmark::isRunning());
+        GPUProfiler::beginFrame();
+        GLSDLHelper::beginStreamingFrame();
+
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplSDL3_NewFrame();
         ImGui::NewFrame();
 
-        mStateStack->draw();
+        mStateStack->draw(alpha);
 
         // Window might be closed during draw calls/events
-        if (mOptions.get(GUIOptions::ID::DE_FACTO).getShowDebugOverlay())
+        if (showDebugOverlay)
         {
             handleFPS(elapsed);
         }
 
-        ImGui::Render();
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        {
+            BW_PROFILE_ZONE("ImGui::Render");
+            ImGui::Render();
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        }
+
+        GLSDLHelper::endStreamingFrame();
+        FlyThroughBenchmark::endFrame();
+
+        // The finished frame, overlays included, goes to the readback ring before the swap
+        {
+            int pixelWidth = 0;
+            int pixelHeight = 0;
+            if (FrameCapture::isRecording())
+            {
+                SDL_GetWindowSizeInPixels(mRenderWindow->getSDLWindow(), &pixelWidth, &pixelHeight);
+            }
+            FrameCapture::captureFrame(pixelWidth, pixelHeight);
+        }
 
+        // Swap (and any vsync wait) gets its own zone so present stalls stand out
+        BW_PROFILE_ZONE("RenderWindow::display");
         mRenderWindow->display();
+        FramePacer::endFrame();
+
+        if (mSettleFrames > 0)
+        {
+            --mSettleFrames;
+        }
     }
 
     void registerStates() noexcept
@@ -313,6 +500,109 @@ struct PhysicsGame::PhysicsGameImpl
         {
             ImGui::Text("FPS: %d", mSmoothedFPS);
             ImGui::Text("Frame Time: %.2f ms", mSmoothedFrameTime);
+            const auto pacing = FramePacer::getStats();
+            if (pacing.samples > 0)
+            {
+                ImGui::Text("Input latency: %.2f ms avg, %.2f ms max", pacing.latencyAverageMs, pacing.latencyMaxMs);
+            }
+            if (const auto &settings = FramePacer::getSettings(); settings.lowLatency)
+            {
+                ImGui::Text("Pacing: %u in flight (cap %u), wait %.2f ms, delay %.2f ms", pacing.framesInFlight,
+                            settings.maxFramesInFlight, pacing.waitAverageMs, pacing.delayAverageMs);
+            }
+            if (const auto capture = FrameCapture::getStats(); FrameCapture::isRecording() || capture.queued > 0)
+            {
+                ImGui::Text("Recording: %llu frames, %llu written, %llu dropped",
+                            static_cast<unsigned long long>(capture.captured),
+                            static_cast<unsigned long long>(capture.written),
+                            static_cast<unsigned long long>(capture.dropped));
+            }
+            const auto &glStats = GLStateCache::getStats();
+            ImGui::Text("GL state: %llu set, %llu skipped, %llu queried",
+                        static_cast<unsigned long long>(glStats.issued),
+                        static_cast<unsigned long long>(glStats.skipped),
+                        static_cast<unsigned long long>(glStats.queries));
+
+            // Last complete frame, ImGui itself excluded
+            const auto &render = RenderStats::getLastFrame();
+            ImGui::Text("Draws: %llu calls (%llu multi/indirect cmds), %llu instances, %llu tris",
+                        static_cast<unsigned long long>(render.drawCalls),
+                        static_cast<unsigned long long>(render.indirectDraws),
+                        static_cast<unsigned long long>(render.instances),
+                        static_cast<unsigned long long>(render.triangles));
+            ImGui::Text("Binds: %llu programs, %llu VAOs, %llu textures; %llu uniforms",
+                        static_cast<unsigned long long>(render.programBinds),
+                        static_cast<unsigned long long>(render.vertexArrayBinds),
+                        static_cast<unsigned long long>(render.textureBinds),
+                        static_cast<unsigned long long>(render.uniformUploads));
+            ImGui::Text("Uploads: %.1f KB, %llu compute dispatches",
+                        static_cast<double>(render.uploadBytes) / 1024.0,
+                        static_cast<unsigned long long>(render.computeDispatches));
+            ImGui::Text("Character anim: %llu full, %llu half, %llu quarter rate, %llu culled",
+                        static_cast<unsigned long long>(render.animationLods[0]),
+                        static_cast<unsigned long long>(render.animationLods[1]),
+                        static_cast<unsigned long long>(render.animationLods[2]),
+                        static_cast<unsigned long long>(render.animationLods[3]));
+            const FrameArena &frameArena = FrameArena::frame();
+            ImGui::Text("Frame arena: %.1f KB peak of %.1f KB, grown %zu times",
+                        static_cast<double>(frameArena.getHighWater()) / 1024.0,
+                        static_cast<double>(frameArena.getCapacity()) / 1024.0, frameArena.getGrowCount());
+            ImGui::Separator();
+
+            // Passes that have not run recently (e.g. motion blur below its speed threshold) are hidden
+            if (ImGui::BeginTable("GPU Passes", 3, ImGuiTableFlags_SizingFixedFit))
+            {
+                ImGui::TableSetupColumn("GPU pass");
+                ImGui::TableSetupColumn("avg ms");
+                ImGui::TableSetupColumn("max ms");
+                ImGui::TableHeadersRow();
+                for (std::size_t i = 0; i < GPUProfiler::PASS_COUNT; ++i)
+                {
+                    const auto pass = static_cast<GPUProfiler::Pass>(i);
+                    const auto stats = GPUProfiler::getPassStats(pass);
+                    if (stats.samples == 0)
+                    {
+                        continue;
+                    }
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(GPUProfiler::getPassName(pass));
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.3f", stats.averageMs);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.3f", stats.maxMs);
+                }
+                ImGui::EndTable();
+            }
+            ImGui::Separator();
+
+            ImGui::Text("Memory: GPU %.1f MB, CPU %.1f MB (F8 dumps)",
+                        static_cast<double>(MemoryStats::getTotalBytes(true)) / (1024.0 * 1024.0),
+                        static_cast<double>(MemoryStats::getTotalBytes(false)) / (1024.0 * 1024.0));
+            if (ImGui::BeginTable("Memory", 3, ImGuiTableFlags_SizingFixedFit))
+            {
+                ImGui::TableSetupColumn("Subsystem");
+                ImGui::TableSetupColumn("MB");
+                ImGui::TableSetupColumn("peak MB");
+                ImGui::TableHeadersRow();
+                for (std::size_t i = 0; i < MemoryStats::CATEGORY_COUNT; ++i)
+                {
+                    const auto category = static_cast<MemoryStats::Category>(i);
+                    const auto totals = MemoryStats::getTotals(category);
+                    if (totals.highWaterBytes == 0)
+                    {
+                        continue;
+                    }
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(MemoryStats::getName(category));
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.2f", static_cast<double>(totals.bytes) / (1024.0 * 1024.0));
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.2f", static_cast<double>(totals.highWaterBytes) / (1024.0 * 1024.0));
+                }
+                ImGui::EndTable();
+            }
             ImGui::Separator();
 
             if (mStateStack && mStateStack->peekState<GameState *>())
@@ -356,32 +646,76 @@ bool PhysicsGame::run([[maybe_unused]] mazes::grid_interface *g, mazes::randomiz
         return false;
     }
 
-    auto previous = static_cast<double>(SDL_GetTicks());
-    double accumulator = 0.0, currentTimeStep = 0.0;
+    // Fixed 60 Hz simulation step in nanoseconds
+    static constexpr Uint64 FIXED_TIME_STEP_NS = 1'000'000'000ull / 60ull;
+    // Catch-up steps allowed per frame; beyond this the backlog is dropped so one hitch cannot cascade
+    static constexpr int MAX_SUBSTEPS_PER_FRAME = 5;
+    // Main-loop time per frame for queued jobs when the job system has no threads (a quarter of 60 Hz)
+    static constexpr std::chrono::microseconds COOPERATIVE_JOB_BUDGET{4000};
+
+    auto &jobs = *JobSystem::instance();
+
+    Uint64 previous = SDL_GetTicksNS();
+    Uint64 accumulator = 0;
 
     SDL_Log("Entering game loop...");
 
     // States already pushed in constructor - no need to push again
 
+    BW_PROFILE_THREAD("Main");
+
     while (gamePtr->mRenderWindow && gamePtr->mRenderWindow->isOpen())
     {
-        // Expected milliseconds per frame (16.67ms)
-        static constexpr auto FIXED_TIME_STEP = 1000.0 / 60.0;
-        const auto current = static_cast<double>(SDL_GetTicks());
-        const auto elapsed = current - previous;
+        if (StartupTimeline::hasTimedOut())
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Startup benchmark timed out");
+            StartupTimeline::finish();
+            gamePtr->mRenderWindow->close();
+            break;
+        }
+        if (FlyThroughBenchmark::hasTimedOut())
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Fly-through benchmark timed out");
+            FlyThroughBenchmark::finish();
+            gamePtr->mRenderWindow->close();
+            break;
+        }
+
+        // Menus with nothing moving block here until input arrives or their next animation frame is due
+        if (const Uint32 idleMs = gamePtr->idleTimeoutMs(); idleMs > 0)
+        {
+            BW_PROFILE_ZONE("PhysicsGame::idle");
+            SDL_WaitEventTimeout(nullptr, static_cast<Sint32>(idleMs));
+            // The blocked time is not simulated: one step handles whatever woke the loop
+            previous = SDL_GetTicksNS() - FIXED_TIME_STEP_NS;
+            accumulator = 0;
+        }
+
+        BW_PROFILE_ZONE("Frame");
+        {
+            // Before input is read, so a capped queue shortens input-to-photon time instead of just idling
+            BW_PROFILE_ZONE("FramePacer::beginFrame");
+            FramePacer::beginFrame();
+        }
+        // After the pacer, so its sleep does not count as frame work
+        FlyThroughBenchmark::beginFrame();
+        FrameArena::beginFrame();
+        const Uint64 current = SDL_GetTicksNS();
+        const Uint64 elapsedNS = current - previous;
         previous = current;
-        accumulator += elapsed;
+        accumulator += elapsedNS;
+        Telemetry::recordFrame(static_cast<float>(static_cast<double>(elapsedNS) * 1e-6));
 
         // Handle events and update physics at a fixed time step
-        while (accumulator >= FIXED_TIME_STEP)
+        int steps = 0;
+        while (accumulator >= FIXED_TIME_STEP_NS && steps < MAX_SUBSTEPS_PER_FRAME)
         {
             gamePtr->processInput();
 
-            accumulator -= FIXED_TIME_STEP;
+            accumulator -= FIXED_TIME_STEP_NS;
+            ++steps;
 
-            currentTimeStep += FIXED_TIME_STEP;
-
-            gamePtr->update(static_cast<float>(FIXED_TIME_STEP) / 1000.f);
+            gamePtr->update(static_cast<float>(static_cast<double>(FIXED_TIME_STEP_NS) * 1e-9));
 
             // Check if state stack became empty during update
             if (gamePtr->mStateStack->isEmpty())
@@ -391,12 +725,36 @@ bool PhysicsGame::run([[maybe_unused]] mazes::grid_interface *g, mazes::randomiz
                 break;
             }
         }
+
+        if (accumulator >= FIXED_TIME_STEP_NS)
+        {
+            // Still behind after the clamp: run slow instead of spiralling
+            accumulator %= FIXED_TIME_STEP_NS;
+        }
+
+        // Chunk generation and asset decoding advance here, a slice per frame, when there are no workers
+        if (jobs.isCooperative())
+        {
+            jobs.runPendingJobs(COOPERATIVE_JOB_BUDGET);
+        }
+
+#if defined(BREAKING_WALLS_DEBUG)
+        // Between update and render so a rebuilt program or texture is used by this frame's draws
+        HotReload::poll(gamePtr->mShaders, gamePtr->mTextures, static_cast<float>(static_cast<double>(elapsedNS) * 1e-9));
+#endif
+
         if (gamePtr->mRenderWindow->isOpen())
         {
-            gamePtr->render(elapsed);
+            const float alpha = static_cast<float>(static_cast<double>(accumulator) /
+                                                   static_cast<double>(FIXED_TIME_STEP_NS));
+            gamePtr->render(static_cast<double>(elapsedNS) * 1e-6, alpha);
         }
     }
 
     SDL_Log("Exiting game loop...");
+
+#if defined(BREAKING_WALLS_PROFILE)
+    dumpProfileTrace("exit");
+#endif
     return true;
 }
@@ -0,0 +1,131 @@
+#include "PhysicsTaskScheduler.hpp"
+
+#include "JobSystem.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <thread>
+
+PhysicsTaskScheduler::PhysicsTaskScheduler(int workerCount) noexcept
+    : mWorkerCount{std::clamp(workerCount, 1, MAX_WORKERS)}
+    , mFreeWorkerSlots{(mWorkerCount == MAX_WORKERS) ? ~0ull : ((1ull << mWorkerCount) - 1ull)}
+{
+}
+
+void PhysicsTaskScheduler::configure(b2WorldDef &worldDef) noexcept
+{
+    if (mWorkerCount <= 1)
+    {
+        worldDef.workerCount = 1;
+        return;
+    }
+
+    worldDef.workerCount = mWorkerCount;
+    worldDef.enqueueTask = &PhysicsTaskScheduler::enqueueTask;
+    worldDef.finishTask = &PhysicsTaskScheduler::finishTask;
+    worldDef.userTaskContext = this;
+}
+
+void PhysicsTaskScheduler::beginStep() noexcept
+{
+    mTasks.clear();
+    mTasksThisStep = 0;
+}
+
+void *PhysicsTaskScheduler::enqueueTask(b2TaskCallback *task, int itemCount, int minRange,
+                                        void *taskContext, void *userContext)
+{
+    auto *self = static_cast<PhysicsTaskScheduler *>(userContext);
+    ++self->mTasksThisStep;
+
+    if (itemCount <= 0)
+    {
+        // A null handle tells Box2D there is nothing to finish
+        return nullptr;
+    }
+
+    // Single-item tasks still go to the pool: the solver enqueues one per worker and expects them to overlap
+    const int range = std::max(1, minRange);
+    const int partitionCount = std::clamp((itemCount + range - 1) / range, 1, self->mWorkerCount);
+
+    auto shared = std::make_shared<Task>();
+    shared->callback = task;
+    shared->context = taskContext;
+    shared->itemCount = itemCount;
+    shared->partitionCount = partitionCount;
+    shared->partitionSize = (itemCount + partitionCount - 1) / partitionCount;
+    shared->remainingPartitions.store(partitionCount, std::memory_order_relaxed);
+    self->mTasks.push_back(shared);
+
+    auto &jobs = *JobSystem::instance();
+    for (int i = 0; i < partitionCount; ++i)
+    {
+        jobs.schedule([self, shared]()
+                      { self->runPartitions(*shared); });
+    }
+
+    return shared.get();
+}
+
+void PhysicsTaskScheduler::finishTask(void *userTask, void *userContext)
+{
+    auto *self = static_cast<PhysicsTaskScheduler *>(userContext);
+    auto &task = *static_cast<Task *>(userTask);
+
+    // Help out with anything the pool has not picked up yet, then wait for the rest
+    self->runPartitions(task);
+    while (task.remainingPartitions.load(std::memory_order_acquire) > 0)
+    {
+        std::this_thread::yield();
+    }
+}
+
+void PhysicsTaskScheduler::runPartitions(Task &task) noexcept
+{
+    int partition = task.nextPartition.fetch_add(1, std::memory_order_relaxed);
+    if (partition >= task.partitionCount)
+    {
+        return;
+    }
+
+    const std::uint32_t slot = acquireWorkerSlot();
+    while (partition < task.partitionCount)
+    {
+        const int start = partition * task.partitionSize;
+        const int end = std::min(task.itemCount, start + task.partitionSize);
+        if (start < end)
+        {
+            task.callback(start, end, slot, task.context);
+        }
+        task.remainingPartitions.fetch_sub(1, std::memory_order_release);
+        partition = task.nextPartition.fetch_add(1, std::memory_order_relaxed);
+    }
+    releaseWorkerSlot(slot);
+}
+
+std::uint32_t PhysicsTaskScheduler::acquireWorkerSlot() noexcept
+{
+    // Box2D keeps per-worker scratch indexed by this value, so two running partitions must never share one
+    std::uint64_t freeSlots = mFreeWorkerSlots.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        if (freeSlots == 0)
+        {
+            std::this_thread::yield();
+            freeSlots = mFreeWorkerSlots.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        const auto slot = static_cast<std::uint32_t>(std::countr_zero(freeSlots));
+        if (mFreeWorkerSlots.compare_exchange_weak(freeSlots, freeSlots & ~(1ull << slot),
+                                                   std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            return slot;
+        }
+    }
+}
+
+void PhysicsTaskScheduler::releaseWorkerSlot(std::uint32_t slot) noexcept
+{
+    mFreeWorkerSlots.fetch_or(1ull << slot, std::memory_order_release);
+}
@@ -0,0 +1,65 @@
+#ifndef PHYSICS_TASK_SCHEDULER_HPP
+#define PHYSICS_TASK_SCHEDULER_HPP
+
+#include <box2d/box2d.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// @brief Runs Box2D's parallel-for tasks on the JobSystem worker pool
+/// @details Installed through b2WorldDef's enqueueTask/finishTask hooks. Partitions are claimed
+/// atomically, so finishTask runs any unclaimed ones inline instead of waiting behind other jobs.
+/// Each running partition holds a distinct Box2D worker index in [0, workerCount).
+class PhysicsTaskScheduler
+{
+public:
+    /// @param workerCount Box2D worker count including the stepping thread, clamped to [1, 64]
+    explicit PhysicsTaskScheduler(int workerCount) noexcept;
+
+    PhysicsTaskScheduler(const PhysicsTaskScheduler &) = delete;
+    PhysicsTaskScheduler &operator=(const PhysicsTaskScheduler &) = delete;
+
+    /// @brief Point the world definition at this scheduler; a single worker leaves Box2D serial
+    void configure(b2WorldDef &worldDef) noexcept;
+
+    /// @brief Release the previous step's finished tasks; call right before b2World_Step
+    void beginStep() noexcept;
+
+    [[nodiscard]] int getWorkerCount() const noexcept { return mWorkerCount; }
+
+    /// @brief Tasks Box2D enqueued since the last beginStep(), i.e. during the latest step
+    [[nodiscard]] std::uint32_t getTasksLastStep() const noexcept { return mTasksThisStep; }
+
+private:
+    static constexpr int MAX_WORKERS = 64;
+
+    struct Task
+    {
+        b2TaskCallback *callback{nullptr};
+        void *context{nullptr};
+        int itemCount{0};
+        int partitionSize{0};
+        int partitionCount{0};
+        std::atomic<int> nextPartition{0};
+        std::atomic<int> remainingPartitions{0};
+    };
+
+    static void *enqueueTask(b2TaskCallback *task, int itemCount, int minRange,
+                             void *taskContext, void *userContext);
+    static void finishTask(void *userTask, void *userContext);
+
+    void runPartitions(Task &task) noexcept;
+    std::uint32_t acquireWorkerSlot() noexcept;
+    void releaseWorkerSlot(std::uint32_t slot) noexcept;
+
+    int mWorkerCount;
+    std::atomic<std::uint64_t> mFreeWorkerSlots;
+
+    // Kept alive until the next step; queued jobs hold their own references
+    std::vector<std::shared_ptr<Task>> mTasks;
+    std::uint32_t mTasksThisStep{0};
+};
+
+#endif // PHYSICS_TASK_SCHEDULER_HPP
@@ -1,12 +1,14 @@
 #include "Player.hpp"
 
 #include "Camera.hpp"
+#include "InputRecorder.hpp"
 
 #include <SDL3/SDL.h>
 
 #include <glm/glm.hpp>
 
 #include <algorithm>
+#include <bitset>
 
 namespace
 {
@@ -15,27 +17,48 @@ namespace
     constexpr float kPlayerJumpVelocity = 14.0f;
     constexpr float kMouseStrafeUnitsPerPixel = 0.09f;
     constexpr float kMouseStrafeDeadzonePixels = 0.5f;
+    constexpr float kCameraMoveSpeed = 50.0f;    // Units per second
+    constexpr float kCameraRotateSpeed = 180.0f; // Degrees per second
 }
 
+static_assert(SDL_SCANCODE_COUNT <= 512, "Player::KEY_COUNT must cover every scancode");
+
+const std::array<Player::ActionHandler, Player::ACTION_SLOTS> Player::sActionHandlers{
+    &Player::moveForward,
+    &Player::moveBackward,
+    &Player::moveLeft,
+    &Player::moveRight,
+    &Player::moveUp,
+    &Player::moveDown,
+    &Player::jumpAction,
+    &Player::rotateLeft,
+    &Player::rotateRight,
+    &Player::rotateUp,
+    &Player::rotateDown,
+    &Player::resetCamera,
+    nullptr, // RESET_ACCUMULATION is handled by the game state
+    &Player::togglePerspective,
+};
+
 Player::Player() : mIsActive(false), mIsOnGround(false)
 {
-    mKeyBinding[SDL_SCANCODE_W] = Action::MOVE_FORWARD;
-    mKeyBinding[SDL_SCANCODE_S] = Action::MOVE_BACKWARD;
-    mKeyBinding[SDL_SCANCODE_A] = Action::MOVE_LEFT;
-    mKeyBinding[SDL_SCANCODE_D] = Action::MOVE_RIGHT;
-    mKeyBinding[SDL_SCANCODE_SPACE] = Action::JUMP;
+    mKeyBinding.fill(Action::ACTION_COUNT);
+
+    assignKey(Action::MOVE_FORWARD, SDL_SCANCODE_W);
+    assignKey(Action::MOVE_BACKWARD, SDL_SCANCODE_S);
+    assignKey(Action::MOVE_LEFT, SDL_SCANCODE_A);
+    assignKey(Action::MOVE_RIGHT, SDL_SCANCODE_D);
+    assignKey(Action::JUMP, SDL_SCANCODE_SPACE);
 
     // Camera rotation controls (Arrow keys)
-    mKeyBinding[SDL_SCANCODE_LEFT] = Action::ROTATE_LEFT;
-    mKeyBinding[SDL_SCANCODE_RIGHT] = Action::ROTATE_RIGHT;
-    mKeyBinding[SDL_SCANCODE_UP] = Action::ROTATE_UP;
-    mKeyBinding[SDL_SCANCODE_DOWN] = Action::ROTATE_DOWN;
+    assignKey(Action::ROTATE_LEFT, SDL_SCANCODE_LEFT);
+    assignKey(Action::ROTATE_RIGHT, SDL_SCANCODE_RIGHT);
+    assignKey(Action::ROTATE_UP, SDL_SCANCODE_UP);
+    assignKey(Action::ROTATE_DOWN, SDL_SCANCODE_DOWN);
 
     // Special actions (discrete events)
-    mKeyBinding[SDL_SCANCODE_R] = Action::RESET_CAMERA;
-    mKeyBinding[SDL_SCANCODE_V] = Action::TOGGLE_PERSPECTIVE;
-
-    initializeActions();
+    assignKey(Action::RESET_CAMERA, SDL_SCANCODE_R);
+    assignKey(Action::TOGGLE_PERSPECTIVE, SDL_SCANCODE_V);
 
     // Initialize animator with default character (index 0)
     initializeAnimator(0);
@@ -45,14 +68,15 @@ void Player::handleEvent(const SDL_Event &event, Camera &camera)
 {
     if (event.type == SDL_EVENT_KEY_DOWN)
     {
-        auto found = mKeyBinding.find(event.key.scancode);
+        const auto scancode = static_cast<std::size_t>(event.key.scancode);
+        const Action action = scancode < KEY_COUNT ? mKeyBinding[scancode] : Action::ACTION_COUNT;
 
-        if (found != mKeyBinding.cend() && !isRealtimeAction(found->second))
+        if (action != Action::ACTION_COUNT && !isRealtimeAction(action))
         {
             // Execute discrete action immediately
-            if (auto actionIt =  mCameraActions.find(found->second); actionIt != mCameraActions.cend())
+            if (const ActionHandler handler = sActionHandlers[static_cast<std::size_t>(action)])
             {
-                actionIt->second(camera, 0.0f);
+                (this->*handler)(camera, 0.0f);
             }
         }
     }
@@ -77,7 +101,7 @@ void Player::handleRealtimeInput(Camera &camera, float dt)
     }
 
     int numKeys = 0;
-    const auto *keyState = SDL_GetKeyboardState(&numKeys);
+    const auto *keyState = InputRecorder::getKeyboardState(&numKeys);
 
     if (!keyState)
         return;
@@ -93,20 +117,29 @@ void Player::handleRealtimeInput(Camera &camera, float dt)
     mIsMoving = false;
     mIsJumping = false;
 
-    for (auto &pair : mKeyBinding)
+    // Snapshot the keyboard once, then walk the actions in enum order: movement before rotation
+    std::bitset<KEY_COUNT> heldKeys;
+    const std::size_t keyCount = std::min(static_cast<std::size_t>(std::max(numKeys, 0)), KEY_COUNT);
+    for (std::size_t key = 0; key < keyCount; ++key)
+    {
+        heldKeys[key] = keyState[key];
+    }
+
+    for (std::size_t slot = 0; slot < ACTION_SLOTS; ++slot)
     {
-        if (isRealtimeAction(pair.second))
+        const auto action = static_cast<Action>(slot);
+        const std::uint32_t key = mActionKeys[slot];
+        if (isRealtimeAction(action) && key != SDL_SCANCODE_UNKNOWN)
         {
-            if (pair.first < static_cast<std::uint32_t>(numKeys) && keyState[pair.first])
+            if (heldKeys[key])
             {
-                auto actionIt = mCameraActions.find(pair.second);
-                if (actionIt != mCameraActions.cend())
+                if (const ActionHandler handler = sActionHandlers[slot])
                 {
-                    actionIt->second(camera, dt);
+                    (this->*handler)(camera, dt);
                 }
 
                 // Track movement for animation
-                switch (pair.second)
+                switch (action)
                 {
                 case Action::MOVE_FORWARD:
                     mMovingForward = true;
@@ -133,12 +166,12 @@ void Player::handleRealtimeInput(Camera &camera, float dt)
 
     // Relative mouse strafing (cursor is hidden/center-locked by GameState)
     // Only apply mouse strafing when right mouse button is NOT held (to avoid conflict with camera rotation)
-    std::uint32_t mouseButtonState = SDL_GetMouseState(nullptr, nullptr);
+    std::uint32_t mouseButtonState = InputRecorder::getMouseButtons();
     bool rightMouseHeld = (mouseButtonState & SDL_BUTTON_RMASK) != 0;
     
     float relMouseX = 0.0f;
     float relMouseY = 0.0f;
-    SDL_GetRelativeMouseState(&relMouseX, &relMouseY);
+    InputRecorder::getRelativeMouseState(&relMouseX, &relMouseY);
     
     if (!rightMouseHeld && std::abs(relMouseX) >= kMouseStrafeDeadzonePixels)
     {
@@ -321,234 +354,159 @@ bool Player::isRealtimeAction(Action action)
     }
 }
 
-void Player::initializeActions()
+glm::vec3 Player::surfaceForward(const Camera &camera) const
 {
-    static constexpr float cameraMoveSpeed = 50.0f;    // Units per second
-    static constexpr float cameraRotateSpeed = 180.0f; // Degrees per second
-
-    // Movement actions (continuous)
-    mCameraActions[Action::MOVE_FORWARD] = [this](Camera &camera, float dt)
-    {
-        glm::vec3 surfaceUp = mUseSphericalGravity
-            ? glm::normalize(mPosition - mPlanetCenter)
-            : glm::vec3(0.0f, 1.0f, 0.0f);
-        glm::vec3 camFwd = camera.getTarget();
-        glm::vec3 tangentFwd = camFwd - glm::dot(camFwd, surfaceUp) * surfaceUp;
-        if (glm::length(tangentFwd) < 0.01f)
-            tangentFwd = glm::normalize(camera.getRight() - glm::dot(camera.getRight(), surfaceUp) * surfaceUp);
-        else
-            tangentFwd = glm::normalize(tangentFwd);
-        glm::vec3 movement = tangentFwd * cameraMoveSpeed * dt;
+    glm::vec3 surfaceUp = mUseSphericalGravity
+        ? glm::normalize(mPosition - mPlanetCenter)
+        : glm::vec3(0.0f, 1.0f, 0.0f);
+    glm::vec3 camFwd = camera.getTarget();
+    glm::vec3 tangentFwd = camFwd - glm::dot(camFwd, surfaceUp) * surfaceUp;
+    if (glm::length(tangentFwd) < 0.01f)
+        return glm::normalize(camera.getRight() - glm::dot(camera.getRight(), surfaceUp) * surfaceUp);
+    return glm::normalize(tangentFwd);
+}
 
-        if (camera.getMode() == CameraMode::THIRD_PERSON)
-        {
-            mPosition += movement;
-            mAnimator.setPosition(mPosition);
-            camera.setFollowTarget(mPosition);
-            camera.updateThirdPersonPosition();
-        }
-        else
-        {
-            camera.setPosition(camera.getPosition() + movement);
-        }
-    };
+glm::vec3 Player::surfaceRight(const Camera &camera) const
+{
+    glm::vec3 surfaceUp = mUseSphericalGravity
+        ? glm::normalize(mPosition - mPlanetCenter)
+        : glm::vec3(0.0f, 1.0f, 0.0f);
+    glm::vec3 camRight = camera.getRight();
+    glm::vec3 tangentRight = camRight - glm::dot(camRight, surfaceUp) * surfaceUp;
+    if (glm::length(tangentRight) < 0.01f)
+        return glm::vec3(1.0f, 0.0f, 0.0f);
+    return glm::normalize(tangentRight);
+}
 
-    mCameraActions[Action::MOVE_BACKWARD] = [this](Camera &camera, float dt)
+void Player::applyMovement(Camera &camera, const glm::vec3 &movement)
+{
+    if (camera.getMode() == CameraMode::THIRD_PERSON)
     {
-        glm::vec3 surfaceUp = mUseSphericalGravity
-            ? glm::normalize(mPosition - mPlanetCenter)
-            : glm::vec3(0.0f, 1.0f, 0.0f);
-        glm::vec3 camFwd = camera.getTarget();
-        glm::vec3 tangentFwd = camFwd - glm::dot(camFwd, surfaceUp) * surfaceUp;
-        if (glm::length(tangentFwd) < 0.01f)
-            tangentFwd = glm::normalize(camera.getRight() - glm::dot(camera.getRight(), surfaceUp) * surfaceUp);
-        else
-            tangentFwd = glm::normalize(tangentFwd);
-        glm::vec3 movement = tangentFwd * cameraMoveSpeed * dt;
-
-        if (camera.getMode() == CameraMode::THIRD_PERSON)
-        {
-            mPosition -= movement;
-            mAnimator.setPosition(mPosition);
-            camera.setFollowTarget(mPosition);
-            camera.updateThirdPersonPosition();
-        }
-        else
-        {
-            camera.setPosition(camera.getPosition() - movement);
-        }
-    };
-
-    mCameraActions[Action::MOVE_LEFT] = [this](Camera &camera, float dt)
+        mPosition += movement;
+        mAnimator.setPosition(mPosition);
+        camera.setFollowTarget(mPosition);
+        camera.updateThirdPersonPosition();
+    }
+    else
     {
-        glm::vec3 surfaceUp = mUseSphericalGravity
-            ? glm::normalize(mPosition - mPlanetCenter)
-            : glm::vec3(0.0f, 1.0f, 0.0f);
-        glm::vec3 camRight = camera.getRight();
-        glm::vec3 tangentRight = camRight - glm::dot(camRight, surfaceUp) * surfaceUp;
-        if (glm::length(tangentRight) < 0.01f)
-            tangentRight = glm::vec3(1.0f, 0.0f, 0.0f);
-        else
-            tangentRight = glm::normalize(tangentRight);
-        glm::vec3 movement = tangentRight * cameraMoveSpeed * dt;
+        camera.setPosition(camera.getPosition() + movement);
+    }
+}
 
-        if (camera.getMode() == CameraMode::THIRD_PERSON)
-        {
-            mPosition -= movement;
-            mAnimator.setPosition(mPosition);
-            camera.setFollowTarget(mPosition);
-            camera.updateThirdPersonPosition();
-        }
-        else
-        {
-            camera.setPosition(camera.getPosition() - movement);
-        }
-    };
+// Movement actions (continuous)
+void Player::moveForward(Camera &camera, float dt)
+{
+    applyMovement(camera, surfaceForward(camera) * kCameraMoveSpeed * dt);
+}
 
-    mCameraActions[Action::MOVE_RIGHT] = [this](Camera &camera, float dt)
-    {
-        glm::vec3 surfaceUp = mUseSphericalGravity
-            ? glm::normalize(mPosition - mPlanetCenter)
-            : glm::vec3(0.0f, 1.0f, 0.0f);
-        glm::vec3 camRight = camera.getRight();
-        glm::vec3 tangentRight = camRight - glm::dot(camRight, surfaceUp) * surfaceUp;
-        if (glm::length(tangentRight) < 0.01f)
-            tangentRight = glm::vec3(1.0f, 0.0f, 0.0f);
-        else
-            tangentRight = glm::normalize(tangentRight);
-        glm::vec3 movement = tangentRight * cameraMoveSpeed * dt;
+void Player::moveBackward(Camera &camera, float dt)
+{
+    applyMovement(camera, -surfaceForward(camera) * kCameraMoveSpeed * dt);
+}
 
-        if (camera.getMode() == CameraMode::THIRD_PERSON)
-        {
-            mPosition += movement;
-            mAnimator.setPosition(mPosition);
-            camera.setFollowTarget(mPosition);
-            camera.updateThirdPersonPosition();
-        }
-        else
-        {
-            camera.setPosition(camera.getPosition() + movement);
-        }
-    };
+void Player::moveLeft(Camera &camera, float dt)
+{
+    applyMovement(camera, -surfaceRight(camera) * kCameraMoveSpeed * dt);
+}
 
-    mCameraActions[Action::MOVE_UP] = [this](Camera &camera, float dt)
-    {
-        if (camera.getMode() == CameraMode::THIRD_PERSON)
-        {
-            mPosition.y += cameraMoveSpeed * dt;
-            mAnimator.setPosition(mPosition);
-            camera.setFollowTarget(mPosition);
-            camera.updateThirdPersonPosition();
-        }
-        else
-        {
-            glm::vec3 newPos = camera.getPosition();
-            newPos.y += cameraMoveSpeed * dt;
-            camera.setPosition(newPos);
-        }
-    };
+void Player::moveRight(Camera &camera, float dt)
+{
+    applyMovement(camera, surfaceRight(camera) * kCameraMoveSpeed * dt);
+}
 
-    mCameraActions[Action::MOVE_DOWN] = [this](Camera &camera, float dt)
-    {
-        if (camera.getMode() == CameraMode::THIRD_PERSON)
-        {
-            mPosition.y -= cameraMoveSpeed * dt;
-            mAnimator.setPosition(mPosition);
-            camera.setFollowTarget(mPosition);
-            camera.updateThirdPersonPosition();
-        }
-        else
-        {
-            glm::vec3 newPos = camera.getPosition();
-            newPos.y -= cameraMoveSpeed * dt;
-            camera.setPosition(newPos);
-        }
-    };
+void Player::moveUp(Camera &camera, float dt)
+{
+    applyMovement(camera, glm::vec3(0.0f, kCameraMoveSpeed * dt, 0.0f));
+}
 
-    // Rotation actions (continuous)
-    // In spherical gravity mode, rotate around the surface normal / camera-right so
-    // the heading stays surface-relative at every latitude.  Flat mode keeps the
-    // existing world-space yaw/pitch behaviour.
-    mCameraActions[Action::ROTATE_LEFT] = [this](Camera &camera, float dt)
-    {
-        if (mUseSphericalGravity && glm::length(mPosition - mPlanetCenter) > 0.01f)
-            camera.rotateAroundAxis(glm::normalize(mPosition - mPlanetCenter), -cameraRotateSpeed * dt);
-        else
-            camera.rotate(-cameraRotateSpeed * dt, 0.0f);
-        if (camera.getMode() == CameraMode::THIRD_PERSON)
-            camera.updateThirdPersonPosition();
-    };
+void Player::moveDown(Camera &camera, float dt)
+{
+    applyMovement(camera, glm::vec3(0.0f, -kCameraMoveSpeed * dt, 0.0f));
+}
 
-    mCameraActions[Action::ROTATE_RIGHT] = [this](Camera &camera, float dt)
-    {
-        if (mUseSphericalGravity && glm::length(mPosition - mPlanetCenter) > 0.01f)
-            camera.rotateAroundAxis(glm::normalize(mPosition - mPlanetCenter), cameraRotateSpeed * dt);
-        else
-            camera.rotate(cameraRotateSpeed * dt, 0.0f);
-        if (camera.getMode() == CameraMode::THIRD_PERSON)
-            camera.updateThirdPersonPosition();
-    };
+// Rotation actions (continuous)
+// In spherical gravity mode, rotate around the surface normal / camera-right so
+// the heading stays surface-relative at every latitude.  Flat mode keeps the
+// existing world-space yaw/pitch behaviour.
+void Player::rotateLeft(Camera &camera, float dt)
+{
+    if (mUseSphericalGravity && glm::length(mPosition - mPlanetCenter) > 0.01f)
+        camera.rotateAroundAxis(glm::normalize(mPosition - mPlanetCenter), -kCameraRotateSpeed * dt);
+    else
+        camera.rotate(-kCameraRotateSpeed * dt, 0.0f);
+    if (camera.getMode() == CameraMode::THIRD_PERSON)
+        camera.updateThirdPersonPosition();
+}
 
-    mCameraActions[Action::ROTATE_UP] = [this](Camera &camera, float dt)
-    {
-        if (mUseSphericalGravity)
-            camera.rotateAroundAxis(camera.getRight(), cameraRotateSpeed * dt);
-        else
-            camera.rotate(0.0f, cameraRotateSpeed * dt);
-        if (camera.getMode() == CameraMode::THIRD_PERSON)
-            camera.updateThirdPersonPosition();
-    };
+void Player::rotateRight(Camera &camera, float dt)
+{
+    if (mUseSphericalGravity && glm::length(mPosition - mPlanetCenter) > 0.01f)
+        camera.rotateAroundAxis(glm::normalize(mPosition - mPlanetCenter), kCameraRotateSpeed * dt);
+    else
+        camera.rotate(kCameraRotateSpeed * dt, 0.0f);
+    if (camera.getMode() == CameraMode::THIRD_PERSON)
+        camera.updateThirdPersonPosition();
+}
 
-    mCameraActions[Action::ROTATE_DOWN] = [this](Camera &camera, float dt)
-    {
-        if (mUseSphericalGravity)
-            camera.rotateAroundAxis(camera.getRight(), -cameraRotateSpeed * dt);
-        else
-            camera.rotate(0.0f, -cameraRotateSpeed * dt);
-        if (camera.getMode() == CameraMode::THIRD_PERSON)
-            camera.updateThirdPersonPosition();
-    };
+void Player::rotateUp(Camera &camera, float dt)
+{
+    if (mUseSphericalGravity)
+        camera.rotateAroundAxis(camera.getRight(), kCameraRotateSpeed * dt);
+    else
+        camera.rotate(0.0f, kCameraRotateSpeed * dt);
+    if (camera.getMode() == CameraMode::THIRD_PERSON)
+        camera.updateThirdPersonPosition();
+}
 
-    // Special actions (discrete events)
-    mCameraActions[Action::RESET_CAMERA] = [this](Camera &camera, float)
-    {
-        glm::vec3 resetPos = glm::vec3(0.0f, 50.0f, 200.0f);
-        camera.setPosition(resetPos);
-        camera.rotate(0.0f, 0.0f); // Reset yaw/pitch to defaults
+void Player::rotateDown(Camera &camera, float dt)
+{
+    if (mUseSphericalGravity)
+        camera.rotateAroundAxis(camera.getRight(), -kCameraRotateSpeed * dt);
+    else
+        camera.rotate(0.0f, -kCameraRotateSpeed * dt);
+    if (camera.getMode() == CameraMode::THIRD_PERSON)
+        camera.updateThirdPersonPosition();
+}
 
-        // Also reset player position
-        mPosition = resetPos;
-        mAnimator.setPosition(mPosition);
+// Special actions (discrete events)
+void Player::resetCamera(Camera &camera, float)
+{
+    glm::vec3 resetPos = glm::vec3(0.0f, 50.0f, 200.0f);
+    camera.setPosition(resetPos);
+    camera.rotate(0.0f, 0.0f); // Reset yaw/pitch to defaults
 
-        if (camera.getMode() == CameraMode::THIRD_PERSON)
-        {
-            camera.setFollowTarget(mPosition);
-            camera.updateThirdPersonPosition();
-        }
-    };
+    // Also reset player position
+    mPosition = resetPos;
+    mAnimator.setPosition(mPosition);
 
-    mCameraActions[Action::TOGGLE_PERSPECTIVE] = [this](Camera &camera, float)
+    if (camera.getMode() == CameraMode::THIRD_PERSON)
     {
-        // Toggle between first and third person
-        if (camera.getMode() == CameraMode::FIRST_PERSON)
-        {
-            camera.setMode(CameraMode::THIRD_PERSON);
-            camera.setFollowTarget(mPosition);
-            camera.setThirdPersonDistance(15.0f); // Set distance behind player
-            camera.setThirdPersonHeight(8.0f);    // Set height above player
-            camera.updateThirdPersonPosition();
-        }
-        else
-        {
-            camera.setMode(CameraMode::FIRST_PERSON);
-            camera.setPosition(mPosition);
-        }
-    };
+        camera.setFollowTarget(mPosition);
+        camera.updateThirdPersonPosition();
+    }
+}
 
-    mCameraActions[Action::JUMP] = [this](Camera &camera, float)
+void Player::togglePerspective(Camera &camera, float)
+{
+    // Toggle between first and third person
+    if (camera.getMode() == CameraMode::FIRST_PERSON)
+    {
+        camera.setMode(CameraMode::THIRD_PERSON);
+        camera.setFollowTarget(mPosition);
+        camera.setThirdPersonDistance(15.0f); // Set distance behind player
+        camera.setThirdPersonHeight(8.0f);    // Set height above player
+        camera.updateThirdPersonPosition();
+    }
+    else
     {
-        jump();
-    };
+        camera.setMode(CameraMode::FIRST_PERSON);
+        camera.setPosition(mPosition);
+    }
+}
+
+void Player::jumpAction(Camera &, float)
+{
+    jump();
 }
 
 void Player::jump() noexcept
@@ -567,28 +525,27 @@ void Player::jump() noexcept
 
 void Player::assignKey(Action action, std::uint32_t key)
 {
-    // Remove all keys that already map to action
-    for (auto it = mKeyBinding.begin(); it != mKeyBinding.end();)
-    {
-        if (it->second == action)
-            it = mKeyBinding.erase(it);
-        else
-            ++it;
-    }
+    const auto slot = static_cast<std::size_t>(action);
+    if (slot >= ACTION_SLOTS || key == SDL_SCANCODE_UNKNOWN || key >= KEY_COUNT)
+        return;
+
+    // Remove the key that already maps to action
+    if (const std::uint32_t oldKey = mActionKeys[slot]; oldKey != SDL_SCANCODE_UNKNOWN)
+        mKeyBinding[oldKey] = Action::ACTION_COUNT;
+
+    // The key leaves whichever action held it before
+    if (const Action previous = mKeyBinding[key]; previous != Action::ACTION_COUNT)
+        mActionKeys[static_cast<std::size_t>(previous)] = SDL_SCANCODE_UNKNOWN;
 
     // Insert new binding
     mKeyBinding[key] = action;
+    mActionKeys[slot] = key;
 }
 
 std::uint32_t Player::getAssignedKey(Action action) const
 {
-    for (auto &pair : mKeyBinding)
-    {
-        if (pair.second == action)
-            return pair.first;
-    }
-
-    return SDL_SCANCODE_UNKNOWN;
+    const auto slot = static_cast<std::size_t>(action);
+    return slot < ACTION_SLOTS ? mActionKeys[slot] : SDL_SCANCODE_UNKNOWN;
 }
 
 void Player::setGroundContact(bool contact)
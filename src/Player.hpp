@@ -1,9 +1,9 @@
 #ifndef PLAYER_HPP
 #define PLAYER_HPP
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
-#include <functional>
-#include <map>
 
 #include "Animation.hpp"
 
@@ -74,6 +74,18 @@ public:
     /// Get player's 3D position
     [[nodiscard]] glm::vec3 getPosition() const noexcept { return mPosition; }
 
+    /// Remember the position at the start of a fixed simulation step for render interpolation
+    void beginFixedStep() noexcept { mStepStartPosition = mPosition; }
+
+    /// Blend factor between the step-start and current positions used by getRenderPosition()
+    void setRenderAlpha(float alpha) noexcept { mRenderAlpha = alpha; }
+
+    /// Position to draw at: blended between the last two simulated states
+    [[nodiscard]] glm::vec3 getRenderPosition() const noexcept
+    {
+        return mStepStartPosition + (mPosition - mStepStartPosition) * mRenderAlpha;
+    }
+
     /// Set player's 3D position
     void setPosition(const glm::vec3 &position) noexcept;
 
@@ -116,14 +128,44 @@ public:
     void triggerCollisionAnimation(bool positiveCollision) noexcept;
 
 private:
-    void initializeActions();
+    /// Scancodes the binding table covers; SDL_SCANCODE_COUNT in SDL3
+    static constexpr std::size_t KEY_COUNT = 512;
+    static constexpr std::size_t ACTION_SLOTS = static_cast<std::size_t>(Action::ACTION_COUNT);
+
+    using ActionHandler = void (Player::*)(Camera &, float);
+    /// Handler per Action, in enum order; nullptr for actions Player leaves to its owner
+    static const std::array<ActionHandler, ACTION_SLOTS> sActionHandlers;
+
     static bool isRealtimeAction(Action action);
 
+    // Action handlers; dt is zero for discrete actions
+    void moveForward(Camera &camera, float dt);
+    void moveBackward(Camera &camera, float dt);
+    void moveLeft(Camera &camera, float dt);
+    void moveRight(Camera &camera, float dt);
+    void moveUp(Camera &camera, float dt);
+    void moveDown(Camera &camera, float dt);
+    void jumpAction(Camera &camera, float dt);
+    void rotateLeft(Camera &camera, float dt);
+    void rotateRight(Camera &camera, float dt);
+    void rotateUp(Camera &camera, float dt);
+    void rotateDown(Camera &camera, float dt);
+    void resetCamera(Camera &camera, float dt);
+    void togglePerspective(Camera &camera, float dt);
+
+    /// Unit forward/right along the ground under the player, from the camera's heading
+    [[nodiscard]] glm::vec3 surfaceForward(const Camera &camera) const;
+    [[nodiscard]] glm::vec3 surfaceRight(const Camera &camera) const;
+    /// Move the player in third person, else the free camera
+    void applyMovement(Camera &camera, const glm::vec3 &movement);
+
     // Update animation state based on current movement flags
     void updateAnimationState();
 
-    std::map<std::uint32_t, Action> mKeyBinding;
-    std::map<Action, std::function<void(Camera &, float)>> mCameraActions;
+    /// Action per scancode, ACTION_COUNT where unbound
+    std::array<Action, KEY_COUNT> mKeyBinding;
+    /// Scancode per action, SDL_SCANCODE_UNKNOWN (0) where unbound
+    std::array<std::uint32_t, ACTION_SLOTS> mActionKeys{};
     bool mIsActive;
     bool mIsOnGround;
     bool mFrozen{false};  ///< When true, handleRealtimeInput is a no-op (Cornell view mode).
@@ -132,6 +174,8 @@ private:
     CharacterAnimator mAnimator;
     glm::vec3 mPosition{0.0f};
     glm::vec3 mPreviousPosition{0.0f};  // For calculating movement direction
+    glm::vec3 mStepStartPosition{0.0f}; // Position when the current fixed step began
+    float mRenderAlpha{1.0f};
     glm::vec3 mSurfaceNormal{0.0f, 1.0f, 0.0f};  // Up direction on spherical surface
     glm::vec3 mForwardTangent{0.0f, 0.0f, 1.0f}; // Forward direction on spherical surface
     float mFacingDirection{0.0f};
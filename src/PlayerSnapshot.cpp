@@ -0,0 +1,166 @@
+#include "PlayerSnapshot.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    enum ChangeBits : std::uint8_t
+    {
+        CHANGED_REGION = 1u << 0,
+        CHANGED_OFFSET_X = 1u << 1,
+        CHANGED_OFFSET_Z = 1u << 2,
+        CHANGED_Y = 1u << 3,
+        CHANGED_FACING = 1u << 4,
+        CHANGED_FLAGS = 1u << 5,
+        CHANGED_ALL = 0x3Fu
+    };
+
+    constexpr float kUnitMax = static_cast<float>(std::numeric_limits<std::uint16_t>::max());
+
+    std::uint16_t quantizeUnit(float t) noexcept
+    {
+        return static_cast<std::uint16_t>(std::lround(std::clamp(t, 0.0f, 1.0f) * kUnitMax));
+    }
+
+    float dequantizeUnit(std::uint16_t q) noexcept
+    {
+        return static_cast<float>(q) / kUnitMax;
+    }
+
+    void splitAxis(float value, std::int16_t &region, std::uint16_t &offset) noexcept
+    {
+        const float cell = std::floor(value / PlayerSnapshot::REGION_SIZE);
+        const float clamped = std::clamp(cell, static_cast<float>(std::numeric_limits<std::int16_t>::min()),
+                                         static_cast<float>(std::numeric_limits<std::int16_t>::max()));
+        region = static_cast<std::int16_t>(clamped);
+        offset = quantizeUnit((value - clamped * PlayerSnapshot::REGION_SIZE) / PlayerSnapshot::REGION_SIZE);
+    }
+} // namespace
+
+PlayerSnapshot PlayerSnapshot::quantize(const glm::vec3 &position, float facingDegrees,
+                                        bool moving, std::uint8_t animState) noexcept
+{
+    PlayerSnapshot snapshot;
+    splitAxis(position.x, snapshot.regionX, snapshot.offsetX);
+    splitAxis(position.z, snapshot.regionZ, snapshot.offsetZ);
+    snapshot.y = quantizeUnit((position.y - MIN_Y) / (MAX_Y - MIN_Y));
+
+    // Full turn onto 65536 steps; wraps instead of clamping
+    float turns = facingDegrees / 360.0f;
+    turns -= std::floor(turns);
+    snapshot.facing = static_cast<std::uint16_t>(static_cast<std::uint32_t>(std::lround(turns * 65536.0f)) & 0xFFFFu);
+
+    snapshot.flags = static_cast<std::uint8_t>((moving ? 0x01u : 0x00u) | ((animState & 0x0Fu) << 4));
+    return snapshot;
+}
+
+glm::vec3 PlayerSnapshot::getPosition() const noexcept
+{
+    return {
+        (static_cast<float>(regionX) + dequantizeUnit(offsetX)) * REGION_SIZE,
+        MIN_Y + dequantizeUnit(y) * (MAX_Y - MIN_Y),
+        (static_cast<float>(regionZ) + dequantizeUnit(offsetZ)) * REGION_SIZE};
+}
+
+float PlayerSnapshot::getFacing() const noexcept
+{
+    return static_cast<float>(facing) * (360.0f / 65536.0f);
+}
+
+void PlayerSnapshot::write(sf::Packet &packet, const PlayerSnapshot *baseline) const
+{
+    std::uint8_t mask = CHANGED_ALL;
+    if (baseline)
+    {
+        mask = 0;
+        if (regionX != baseline->regionX || regionZ != baseline->regionZ)
+        {
+            mask |= CHANGED_REGION;
+        }
+        if (offsetX != baseline->offsetX)
+        {
+            mask |= CHANGED_OFFSET_X;
+        }
+        if (offsetZ != baseline->offsetZ)
+        {
+            mask |= CHANGED_OFFSET_Z;
+        }
+        if (y != baseline->y)
+        {
+            mask |= CHANGED_Y;
+        }
+        if (facing != baseline->facing)
+        {
+            mask |= CHANGED_FACING;
+        }
+        if (flags != baseline->flags)
+        {
+            mask |= CHANGED_FLAGS;
+        }
+    }
+
+    packet << mask;
+    if (mask & CHANGED_REGION)
+    {
+        packet << regionX << regionZ;
+    }
+    if (mask & CHANGED_OFFSET_X)
+    {
+        packet << offsetX;
+    }
+    if (mask & CHANGED_OFFSET_Z)
+    {
+        packet << offsetZ;
+    }
+    if (mask & CHANGED_Y)
+    {
+        packet << y;
+    }
+    if (mask & CHANGED_FACING)
+    {
+        packet << facing;
+    }
+    if (mask & CHANGED_FLAGS)
+    {
+        packet << flags;
+    }
+}
+
+bool PlayerSnapshot::read(sf::Packet &packet, const PlayerSnapshot &baseline, PlayerSnapshot &out)
+{
+    std::uint8_t mask = 0;
+    if (!(packet >> mask))
+    {
+        return false;
+    }
+
+    out = baseline;
+    if (mask & CHANGED_REGION)
+    {
+        packet >> out.regionX >> out.regionZ;
+    }
+    if (mask & CHANGED_OFFSET_X)
+    {
+        packet >> out.offsetX;
+    }
+    if (mask & CHANGED_OFFSET_Z)
+    {
+        packet >> out.offsetZ;
+    }
+    if (mask & CHANGED_Y)
+    {
+        packet >> out.y;
+    }
+    if (mask & CHANGED_FACING)
+    {
+        packet >> out.facing;
+    }
+    if (mask & CHANGED_FLAGS)
+    {
+        packet >> out.flags;
+    }
+
+    return static_cast<bool>(packet);
+}
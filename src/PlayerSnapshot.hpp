@@ -0,0 +1,47 @@
+#ifndef PLAYER_SNAPSHOT_HPP
+#define PLAYER_SNAPSHOT_HPP
+
+#include <SFML/Network/Packet.hpp>
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
+/// @brief Player state as it goes over the wire, quantized to fixed-point fields
+/// @details The runner world is an unbounded grid of maze chunks, so a position is stored as the
+/// region it falls in plus a 16-bit offset inside that region (~2 mm steps). Height is 16 bits over
+/// a fixed band, facing 16 bits over a full turn, and moving + animation state share one flag byte.
+/// write() sends only the fields that differ from a baseline the receiver is known to hold.
+struct PlayerSnapshot
+{
+    static constexpr float REGION_SIZE = 128.0f;
+    static constexpr float MIN_Y = -64.0f;
+    static constexpr float MAX_Y = 192.0f;
+
+    std::int16_t regionX{0};
+    std::int16_t regionZ{0};
+    std::uint16_t offsetX{0};
+    std::uint16_t offsetZ{0};
+    std::uint16_t y{0};
+    std::uint16_t facing{0};
+    /// Bit 0 = moving, bits 4-7 = CharacterAnimState
+    std::uint8_t flags{0};
+
+    [[nodiscard]] static PlayerSnapshot quantize(const glm::vec3 &position, float facingDegrees,
+                                                 bool moving, std::uint8_t animState) noexcept;
+
+    [[nodiscard]] glm::vec3 getPosition() const noexcept;
+    [[nodiscard]] float getFacing() const noexcept;
+    [[nodiscard]] bool isMoving() const noexcept { return (flags & 0x01u) != 0; }
+    [[nodiscard]] std::uint8_t getAnimState() const noexcept { return static_cast<std::uint8_t>(flags >> 4); }
+
+    /// @brief Write a change mask followed by the fields that differ from baseline (all of them without one)
+    void write(sf::Packet &packet, const PlayerSnapshot *baseline) const;
+
+    /// @brief Read what write() produced, taking unchanged fields from baseline
+    [[nodiscard]] static bool read(sf::Packet &packet, const PlayerSnapshot &baseline, PlayerSnapshot &out);
+
+    bool operator==(const PlayerSnapshot &) const = default;
+};
+
+#endif // PLAYER_SNAPSHOT_HPP
@@ -0,0 +1,167 @@
+#include "PostProcess.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <string>
+
+#include "GLStateCache.hpp"
+#include "RenderStats.hpp"
+#include "VertexArrayObject.hpp"
+
+PostProcess::~PostProcess() noexcept
+{
+    destroy();
+}
+
+void PostProcess::init(const Shader &baseShader) noexcept
+{
+    destroy();
+    mBaseShader = &baseShader;
+}
+
+void PostProcess::destroy() noexcept
+{
+    for (auto &variant : mVariants)
+    {
+        if (variant.shader)
+        {
+            variant.shader->cleanUp();
+        }
+        variant = Variant{};
+    }
+    mBaseShader = nullptr;
+}
+
+std::string PostProcess::definesFor(std::uint32_t features)
+{
+    std::string defines;
+    if (features & OIT)
+    {
+        defines += "#define POST_OIT\n";
+    }
+    if (features & MOTION_BLUR)
+    {
+        defines += "#define POST_MOTION_BLUR\n";
+    }
+    if (features & TONEMAP)
+    {
+        defines += "#define POST_TONEMAP\n";
+    }
+    return defines;
+}
+
+std::uint32_t PostProcess::effectiveFeatures(std::uint32_t features, const Inputs &inputs) noexcept
+{
+    features &= (VARIANT_COUNT - 1);
+    if (inputs.oitAccumTexture == 0 || inputs.oitRevealTexture == 0 ||
+        (inputs.oitDownscale > 1 && (inputs.oitDepthTexture == 0 || inputs.sceneDepthTexture == 0)))
+    {
+        features &= ~static_cast<std::uint32_t>(OIT);
+    }
+    if (inputs.blurVelocity == glm::vec2(0.0f))
+    {
+        features &= ~static_cast<std::uint32_t>(MOTION_BLUR);
+    }
+    return features;
+}
+
+bool PostProcess::prepare(std::uint32_t features) const noexcept
+{
+    if (!mBaseShader)
+    {
+        return false;
+    }
+
+    Variant &variant = mVariants[features & (VARIANT_COUNT - 1)];
+    if (!variant.attempted)
+    {
+        variant.attempted = true;
+        try
+        {
+            variant.shader = mBaseShader->createVariant(definesFor(features));
+        }
+        catch (const std::exception &e)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, "PostProcess: variant 0x%x failed: %s", features, e.what());
+            variant.shader.reset();
+        }
+
+        if (variant.shader && variant.shader->isLinked())
+        {
+            variant.sceneUVScale = variant.shader->getUniformHandle("uSceneUVScale");
+            variant.sceneUVMax = variant.shader->getUniformHandle("uSceneUVMax");
+            variant.blurVelocity = variant.shader->getUniformHandle("uBlurVelocity");
+            variant.exposure = variant.shader->getUniformHandle("uExposure");
+            variant.oitDownscale = variant.shader->getUniformHandle("uOITDownscale");
+            variant.oitTexelMax = variant.shader->getUniformHandle("uOITTexelMax");
+            SDL_Log("PostProcess: built variant 0x%x", features);
+        }
+        else
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_RENDER, "PostProcess: variant 0x%x did not link", features);
+            variant.shader.reset();
+        }
+    }
+
+    return variant.shader != nullptr;
+}
+
+bool PostProcess::apply(std::uint32_t features, const Inputs &inputs, const VertexArrayObject &fullscreenQuad) const noexcept
+{
+    if (inputs.sceneTexture == 0 || inputs.targetWidth <= 0 || inputs.targetHeight <= 0)
+    {
+        return false;
+    }
+
+    features = effectiveFeatures(features, inputs);
+    if (!prepare(features))
+    {
+        return false;
+    }
+
+    const Variant &variant = mVariants[features];
+    const glm::vec2 targetSize(static_cast<float>(inputs.targetWidth), static_cast<float>(inputs.targetHeight));
+    const glm::vec2 renderSize(static_cast<float>(std::clamp(inputs.renderWidth, 1, inputs.targetWidth)),
+                               static_cast<float>(std::clamp(inputs.renderHeight, 1, inputs.targetHeight)));
+
+    const GLStateCache::Snapshot savedState = GLStateCache::save();
+    GLStateCache::disable(GL_DEPTH_TEST);
+    GLStateCache::disable(GL_BLEND);
+    GLStateCache::depthMask(false);
+
+    variant.shader->bind();
+    variant.shader->setUniform(variant.sceneUVScale, renderSize / targetSize);
+    variant.shader->setUniform(variant.sceneUVMax, (renderSize - glm::vec2(0.5f)) / targetSize);
+    variant.shader->setUniform(variant.blurVelocity, inputs.blurVelocity);
+    variant.shader->setUniform(variant.exposure, inputs.exposure);
+
+    GLStateCache::activeTexture(GL_TEXTURE0);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, inputs.sceneTexture);
+    if (features & OIT)
+    {
+        const int downscale = std::max(inputs.oitDownscale, 1);
+        const glm::ivec2 oitSize((static_cast<int>(renderSize.x) + downscale - 1) / downscale,
+                                 (static_cast<int>(renderSize.y) + downscale - 1) / downscale);
+        variant.shader->setUniform(variant.oitDownscale, static_cast<GLint>(downscale));
+        variant.shader->setUniform(variant.oitTexelMax, oitSize - glm::ivec2(1));
+
+        GLStateCache::activeTexture(GL_TEXTURE1);
+        GLStateCache::bindTexture(GL_TEXTURE_2D, inputs.oitAccumTexture);
+        GLStateCache::activeTexture(GL_TEXTURE2);
+        GLStateCache::bindTexture(GL_TEXTURE_2D, inputs.oitRevealTexture);
+        if (downscale > 1)
+        {
+            GLStateCache::activeTexture(GL_TEXTURE3);
+            GLStateCache::bindTexture(GL_TEXTURE_2D, inputs.sceneDepthTexture);
+            GLStateCache::activeTexture(GL_TEXTURE4);
+            GLStateCache::bindTexture(GL_TEXTURE_2D, inputs.oitDepthTexture);
+        }
+    }
+
+    fullscreenQuad.bind();
+    RenderStats::drawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+    GLStateCache::restore(savedState);
+    return true;
+}
@@ -0,0 +1,96 @@
+#ifndef POST_PROCESS_HPP
+#define POST_PROCESS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "Shader.hpp"
+
+class VertexArrayObject;
+
+/// @brief The one full-screen pass between the scene target and the window
+/// @details OIT resolve, motion blur and tone mapping run in a single draw of post.frag.glsl that reads
+/// the scene target once per tap and writes the window once, instead of a resolve, blit and copy per
+/// effect. Each combination of enabled effects is its own program built from the base shader with
+/// Shader::createVariant, so disabled effects cost no instructions; variants are compiled on first use
+/// (or ahead of time through prepare()) and go through the program binary cache like any other link.
+/// A reduced-resolution OIT layer is upsampled in the same pass, weighting its four nearest texels by
+/// how close their depth is to the scene depth, so transparent edges stay on the geometry behind them.
+class PostProcess
+{
+public:
+    /// Feature bits; a mask of these selects the variant
+    enum Feature : std::uint32_t
+    {
+        NONE = 0,
+        OIT = 1u << 0,
+        MOTION_BLUR = 1u << 1,
+        TONEMAP = 1u << 2
+    };
+
+    static constexpr std::size_t VARIANT_COUNT = 8;
+
+    struct Inputs
+    {
+        GLuint sceneTexture{0};
+        /// Weighted-blended OIT targets; OIT is dropped from the mask while either is 0
+        GLuint oitAccumTexture{0};
+        GLuint oitRevealTexture{0};
+        /// Scene pixels per OIT texel along each side; above 1 the resolve upsamples against both depths
+        int oitDownscale{1};
+        /// Depth the OIT layer was tested against, and the full-resolution scene depth; only read when downscaled
+        GLuint oitDepthTexture{0};
+        GLuint sceneDepthTexture{0};
+        /// Size drawn this frame and the allocated size of the targets it sits in (bottom-left)
+        int renderWidth{0};
+        int renderHeight{0};
+        int targetWidth{0};
+        int targetHeight{0};
+        /// Window UV the scene moved during the blur interval
+        glm::vec2 blurVelocity{0.0f};
+        float exposure{1.0f};
+    };
+
+    PostProcess() = default;
+    ~PostProcess() noexcept;
+
+    PostProcess(const PostProcess &) = delete;
+    PostProcess &operator=(const PostProcess &) = delete;
+
+    /// Keep the base program whose files the variants are built from (owned by the ShaderManager)
+    void init(const Shader &baseShader) noexcept;
+    void destroy() noexcept;
+
+    /// @brief Build the variant for features now instead of on the first frame that needs it
+    /// @return false if the variant failed to link; apply() then refuses that mask
+    bool prepare(std::uint32_t features) const noexcept;
+
+    /// @brief Draw the post pass into the bound framebuffer and viewport
+    /// @return false without touching GL state when no linked variant exists for features
+    bool apply(std::uint32_t features, const Inputs &inputs, const VertexArrayObject &fullscreenQuad) const noexcept;
+
+    [[nodiscard]] bool isInitialized() const noexcept { return mBaseShader != nullptr; }
+
+    /// Mask actually used for these inputs (effects without their inputs are stripped)
+    [[nodiscard]] static std::uint32_t effectiveFeatures(std::uint32_t features, const Inputs &inputs) noexcept;
+
+private:
+    struct Variant
+    {
+        Shader::Ptr shader;
+        Shader::UniformHandle sceneUVScale, sceneUVMax, blurVelocity, exposure, oitDownscale, oitTexelMax;
+        bool attempted{false};
+    };
+
+    [[nodiscard]] static std::string definesFor(std::uint32_t features);
+
+    const Shader *mBaseShader{nullptr};
+    mutable std::array<Variant, VARIANT_COUNT> mVariants;
+};
+
+#endif // POST_PROCESS_HPP
@@ -0,0 +1,127 @@
+#include "ProceduralTexture.hpp"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+
+#include "RenderStats.hpp"
+#include "Shader.hpp"
+#include "Texture.hpp"
+
+extern "C"
+{
+    float simplex2(float x, float y, int octaves, float persistence, float lacunarity);
+}
+
+namespace
+{
+    constexpr GLuint kGroupSize = 8;
+    /// Seeds move the noise domain by up to this many units on each axis; far enough apart to look unrelated
+    constexpr float kSeedOffsetRange = 1024.0f;
+
+    GLuint groupsFor(int size) noexcept
+    {
+        return (static_cast<GLuint>(std::max(size, 1)) + kGroupSize - 1) / kGroupSize;
+    }
+
+    /// Two seed-derived offsets in [0, kSeedOffsetRange), the same on every platform
+    void seedOffset(std::uint32_t seed, float &x, float &y) noexcept
+    {
+        // splitmix32-style mixing so neighbouring seeds land far apart
+        std::uint32_t h = seed + 0x9E3779B9u;
+        h = (h ^ (h >> 16)) * 0x85EBCA6Bu;
+        h = (h ^ (h >> 13)) * 0xC2B2AE35u;
+        h ^= h >> 16;
+        x = static_cast<float>(h & 0xFFFFu) / 65536.0f * kSeedOffsetRange;
+        y = static_cast<float>(h >> 16) / 65536.0f * kSeedOffsetRange;
+    }
+} // namespace
+
+bool ProceduralTexture::generate(Shader &shader, Texture &texture, int width, int height, const Params &params,
+                                 std::uint32_t channelOffset) noexcept
+{
+    const GLuint program = shader.getProgramHandle();
+    GLint linked = GL_FALSE;
+    if (program != 0)
+    {
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    }
+    if (linked != GL_TRUE)
+    {
+        return false;
+    }
+
+    if (texture.get() == 0 || texture.getWidth() != width || texture.getHeight() != height)
+    {
+        if (!texture.loadProceduralStorage(width, height, channelOffset))
+        {
+            return false;
+        }
+    }
+
+    float offsetX = 0.0f;
+    float offsetY = 0.0f;
+    seedOffset(params.seed, offsetX, offsetY);
+
+    shader.bind();
+    shader.setUniform("uPattern", static_cast<GLuint>(params.pattern));
+    shader.setUniform("uScale", params.scale);
+    shader.setUniform("uOffset", glm::vec2(offsetX, offsetY));
+    shader.setUniform("uOctaves", static_cast<GLint>(params.octaves));
+    shader.setUniform("uPersistence", params.persistence);
+    shader.setUniform("uLacunarity", params.lacunarity);
+
+    glBindImageTexture(0, texture.get(), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R8);
+    RenderStats::dispatchCompute(groupsFor(width), groupsFor(height), 1);
+    // Sampled from here on, and the CPU fallback may glTexSubImage2D over it
+    glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT);
+    glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R8);
+
+    return true;
+}
+
+bool ProceduralTexture::load(Shader *shader, Texture &texture, int width, int height, const Params &params,
+                             std::uint32_t channelOffset) noexcept
+{
+    if (shader != nullptr && generate(*shader, texture, width, height, params, channelOffset))
+    {
+        return true;
+    }
+
+    return texture.loadProceduralTextures(width, height, [&params](std::vector<std::uint8_t> &buffer, int w, int h)
+                                          { fill(buffer, w, h, params); }, channelOffset);
+}
+
+void ProceduralTexture::fill(std::vector<std::uint8_t> &buffer, int width, int height, const Params &params) noexcept
+{
+    float offsetX = 0.0f;
+    float offsetY = 0.0f;
+    seedOffset(params.seed, offsetX, offsetY);
+    const int cell = std::max(static_cast<int>(params.scale), 1);
+
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            float value = 0.0f;
+            switch (params.pattern)
+            {
+            case Pattern::GRADIENT:
+                value = (static_cast<float>(y) + 0.5f) / static_cast<float>(height);
+                break;
+            case Pattern::CHECKER:
+                value = static_cast<float>(((x / cell) + (y / cell)) & 1);
+                break;
+            case Pattern::NOISE:
+            default:
+                // simplex2 already maps its octave sum to [0, 1]
+                value = simplex2(static_cast<float>(x) / params.scale + offsetX,
+                                 static_cast<float>(y) / params.scale + offsetY,
+                                 params.octaves, params.persistence, params.lacunarity);
+                break;
+            }
+            buffer[static_cast<std::size_t>(y) * static_cast<std::size_t>(width) + static_cast<std::size_t>(x)] =
+                static_cast<std::uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+        }
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef PROCEDURAL_TEXTURE_HPP
+#define PROCEDURAL_TEXTURE_HPP
+
+#include <cstdint>
+#include <vector>
+
+class Shader;
+class Texture;
+
+/// @brief Fills R8 procedural textures on the GPU, with a CPU fallback drawing the same patterns
+/// @details generate() dispatches procedural.cs.glsl with the texture bound through glBindImageTexture,
+/// so no texel passes through client memory. Regenerating at the same size reuses the texture's storage,
+/// which makes a re-run per level seed a single dispatch. fill() is the per-texel CPU version, for drivers
+/// where the compute program did not link; its noise comes from deps/noise, so the two paths agree in
+/// range and character but not texel for texel.
+class ProceduralTexture
+{
+public:
+    /// Matches the PATTERN_ constants in procedural.cs.glsl
+    enum class Pattern : std::uint32_t
+    {
+        /// Octaves of simplex noise, centred on 0.5
+        NOISE = 0,
+        /// 0 at the bottom row to 1 at the top
+        GRADIENT = 1,
+        /// Alternating 0/1 cells of scale texels
+        CHECKER = 2
+    };
+
+    struct Params
+    {
+        Pattern pattern{Pattern::NOISE};
+        /// Shifts the noise domain; the same seed always gives the same texture
+        std::uint32_t seed{0};
+        /// Texels per unit of noise space, or per checker cell
+        float scale{64.0f};
+        int octaves{4};
+        float persistence{0.5f};
+        float lacunarity{2.0f};
+    };
+
+    /// @brief Fill texture with params on the GPU, (re)allocating it as R8 if its size differs
+    /// @param shader The linked GLSL_PROCEDURAL_COMPUTE program
+    /// @return false if the program is not linked; texture is then left as it was
+    static bool generate(Shader &shader, Texture &texture, int width, int height, const Params &params,
+                         std::uint32_t channelOffset = 0) noexcept;
+
+    /// @brief CPU fallback: write width x height R8 texels of params into buffer
+    static void fill(std::vector<std::uint8_t> &buffer, int width, int height, const Params &params) noexcept;
+
+    /// @brief generate() when shader is given and linked, else fill() and upload
+    /// @return false only if the texture could not be created either way
+    static bool load(Shader *shader, Texture &texture, int width, int height, const Params &params,
+                     std::uint32_t channelOffset = 0) noexcept;
+};
+
+#endif // PROCEDURAL_TEXTURE_HPP
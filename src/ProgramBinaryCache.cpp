@@ -0,0 +1,204 @@
+#include "ProgramBinaryCache.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+std::string ProgramBinaryCache::sDirectory;
+std::uint64_t ProgramBinaryCache::sDriverHash = 0;
+std::vector<GLint> ProgramBinaryCache::sFormats;
+bool ProgramBinaryCache::sOpen = false;
+
+namespace
+{
+    std::string_view glString(GLenum name) noexcept
+    {
+        const auto *value = reinterpret_cast<const char *>(glGetString(name));
+        return value ? std::string_view{value} : std::string_view{};
+    }
+} // namespace
+
+void ProgramBinaryCache::open(const std::string &directory) noexcept
+{
+    close();
+
+    GLint formatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    if (formatCount <= 0 || directory.empty())
+    {
+        SDL_Log("ProgramBinaryCache: driver exposes no program binary formats, compiling every launch");
+        return;
+    }
+
+    sFormats.resize(static_cast<std::size_t>(formatCount));
+    glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, sFormats.data());
+
+    // GL_VERSION carries the driver build on every desktop vendor we ship to
+    std::uint64_t driverHash = hash(glString(GL_VENDOR));
+    driverHash = hash(glString(GL_RENDERER), driverHash);
+    driverHash = hash(glString(GL_VERSION), driverHash);
+    driverHash = hash(glString(GL_SHADING_LANGUAGE_VERSION), driverHash);
+
+    sDirectory = directory;
+    if (sDirectory.back() != '/' && sDirectory.back() != '\\')
+    {
+        sDirectory += '/';
+    }
+    sDriverHash = driverHash;
+    sOpen = true;
+
+    SDL_Log("ProgramBinaryCache: using %s (%d binary formats)", sDirectory.c_str(), formatCount);
+}
+
+void ProgramBinaryCache::close() noexcept
+{
+    sDirectory.clear();
+    sFormats.clear();
+    sDriverHash = 0;
+    sOpen = false;
+}
+
+std::uint64_t ProgramBinaryCache::hash(std::string_view data, std::uint64_t seed) noexcept
+{
+    std::uint64_t value = seed;
+    for (const char c : data)
+    {
+        value ^= static_cast<std::uint8_t>(c);
+        value *= 0x100000001b3ull;
+    }
+    return value;
+}
+
+std::string ProgramBinaryCache::entryPath(std::uint64_t sourceHash)
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(sourceHash));
+    return sDirectory + name;
+}
+
+bool ProgramBinaryCache::load(GLuint program, std::uint64_t sourceHash) noexcept
+{
+    if (!sOpen || program == 0)
+    {
+        return false;
+    }
+
+    try
+    {
+        const std::string path = entryPath(sourceHash);
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+        {
+            return false;
+        }
+
+        Header header{};
+        in.read(reinterpret_cast<char *>(&header), sizeof(Header));
+        if (!in || header.magic != MAGIC || header.containerVersion != CONTAINER_VERSION ||
+            header.sourceHash != sourceHash || header.driverHash != sDriverHash ||
+            std::find(sFormats.begin(), sFormats.end(), static_cast<GLint>(header.binaryFormat)) == sFormats.end())
+        {
+            SDL_Log("ProgramBinaryCache: %s is stale (driver or format changed), recompiling", path.c_str());
+            return false;
+        }
+
+        std::vector<char> binary(header.binaryLength);
+        in.read(binary.data(), static_cast<std::streamsize>(binary.size()));
+        if (!in)
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "ProgramBinaryCache: %s is truncated, recompiling", path.c_str());
+            return false;
+        }
+        in.close();
+
+        glProgramBinary(program, static_cast<GLenum>(header.binaryFormat), binary.data(),
+                        static_cast<GLsizei>(binary.size()));
+
+        GLint linked = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (linked == GL_FALSE)
+        {
+            // Drivers may refuse their own old binaries; drop it so the next store replaces it
+            SDL_Log("ProgramBinaryCache: driver rejected %s, recompiling", path.c_str());
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+            return false;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "ProgramBinaryCache: load failed: %s", e.what());
+        return false;
+    }
+
+    return true;
+}
+
+void ProgramBinaryCache::store(GLuint program, std::uint64_t sourceHash) noexcept
+{
+    if (!sOpen || program == 0)
+    {
+        return;
+    }
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+    {
+        return;
+    }
+
+    try
+    {
+        std::vector<char> binary(static_cast<std::size_t>(length));
+        GLenum format = 0;
+        GLsizei written = 0;
+        glGetProgramBinary(program, length, &written, &format, binary.data());
+        if (written <= 0)
+        {
+            return;
+        }
+
+        std::error_code ec;
+        std::filesystem::create_directories(sDirectory, ec);
+
+        // Write then rename so a crash mid-write never leaves a half entry behind
+        const std::string path = entryPath(sourceHash);
+        const std::string tempPath = path + ".tmp";
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            if (!out)
+            {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "ProgramBinaryCache: cannot write %s", tempPath.c_str());
+                return;
+            }
+
+            const Header header{MAGIC, CONTAINER_VERSION, static_cast<std::uint32_t>(format),
+                                static_cast<std::uint32_t>(written), sDriverHash, sourceHash};
+            out.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+            out.write(binary.data(), written);
+            out.close();
+            if (!out)
+            {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "ProgramBinaryCache: short write to %s", tempPath.c_str());
+                std::filesystem::remove(tempPath, ec);
+                return;
+            }
+        }
+
+        std::filesystem::rename(tempPath, path, ec);
+        if (ec)
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "ProgramBinaryCache: cannot replace %s: %s",
+                        path.c_str(), ec.message().c_str());
+            std::filesystem::remove(tempPath, ec);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "ProgramBinaryCache: store failed: %s", e.what());
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef PROGRAM_BINARY_CACHE_HPP
+#define PROGRAM_BINARY_CACHE_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <glad/glad.h>
+
+/// @brief On-disk store of linked program binaries so later launches skip GLSL compilation
+/// @details One file per program, named by the hash of its final stage sources (includes resolved,
+/// defines injected). Each file records a hash of GL vendor, renderer and version strings; after a
+/// driver or GPU change that hash differs and the entry is recompiled and overwritten. A binary the
+/// driver rejects (format retired, link fails) is deleted and treated as a miss.
+class ProgramBinaryCache
+{
+public:
+    static constexpr std::uint32_t MAGIC = 0x42505742u; // "BWPB"
+    static constexpr std::uint32_t CONTAINER_VERSION = 1u;
+
+    /// @brief Enable the cache in directory (created on first store); needs a current GL context
+    /// @details Stays disabled if the driver offers no binary formats
+    static void open(const std::string &directory) noexcept;
+    static void close() noexcept;
+
+    [[nodiscard]] static bool isOpen() noexcept { return sOpen; }
+
+    /// Stable 64-bit FNV-1a; pass the previous result as seed to hash several pieces
+    [[nodiscard]] static std::uint64_t hash(std::string_view data, std::uint64_t seed = 0xcbf29ce484222325ull) noexcept;
+
+    /// @brief Load a cached binary into program
+    /// @return true if the program is now linked from the cache
+    static bool load(GLuint program, std::uint64_t sourceHash) noexcept;
+
+    /// @brief Save a linked program; it must have been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+    static void store(GLuint program, std::uint64_t sourceHash) noexcept;
+
+private:
+    struct Header
+    {
+        std::uint32_t magic;
+        std::uint32_t containerVersion;
+        std::uint32_t binaryFormat;
+        std::uint32_t binaryLength;
+        std::uint64_t driverHash;
+        std::uint64_t sourceHash;
+    };
+
+    [[nodiscard]] static std::string entryPath(std::uint64_t sourceHash);
+
+    static std::string sDirectory;
+    static std::uint64_t sDriverHash;
+    static std::vector<GLint> sFormats;
+    static bool sOpen;
+};
+
+#endif // PROGRAM_BINARY_CACHE_HPP
@@ -0,0 +1,345 @@
+#include "RelayServer.hpp"
+
+#include "HttpClient.hpp"
+#include "World.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace
+{
+    // Room left in a datagram for the transport header and the reliable id
+    constexpr std::size_t kMessageBudget = NetTransport::MAX_DATAGRAM_SIZE - 32;
+    // [Uint8:slot] [Uint16:sequence] [Uint16:senderMillis] plus a full snapshot
+    constexpr std::size_t kMaxEntrySize = 1 + 2 + 2 + 1 + 4 + 2 + 2 + 2 + 2 + 1;
+} // namespace
+
+bool RelayServer::start(unsigned short port)
+{
+    stop();
+    if (!mTransport.bind(port))
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "RelayServer: UDP port %u unavailable", port);
+        return false;
+    }
+
+    SDL_Log("RelayServer: listening on UDP port %u for up to %zu clients", mTransport.getLocalPort(), MAX_CLIENTS);
+    return true;
+}
+
+void RelayServer::stop()
+{
+    mTransport.unbind();
+    mClients.clear();
+    mSlotsUsed.fill(false);
+    mBySlot.fill(nullptr);
+    mSendAccumulator = 0.0f;
+    mRosterDirty = false;
+}
+
+void RelayServer::update(float dt)
+{
+    if (!mTransport.isBound())
+    {
+        return;
+    }
+
+    mTransport.update(dt, [this](const std::string &peer, sf::Packet &message)
+                      { handleMessage(peer, message); });
+
+    dropTimedOut();
+
+    if (mRosterDirty)
+    {
+        mRosterDirty = false;
+        broadcastRoster();
+    }
+
+    mSendAccumulator += dt;
+    if (mSendAccumulator >= SEND_INTERVAL)
+    {
+        mSendAccumulator = std::min(mSendAccumulator - SEND_INTERVAL, SEND_INTERVAL);
+        broadcastSnapshots();
+    }
+
+    mTransport.flush();
+}
+
+RelayServer::Stats RelayServer::takeStats() noexcept
+{
+    Stats stats = mStats;
+    stats.clients = mClients.size();
+    mStats = Stats{};
+    return stats;
+}
+
+int RelayServer::chunkRing(const glm::vec3 &a, const glm::vec3 &b) noexcept
+{
+    const glm::ivec2 ca = World::getChunkCell(a);
+    const glm::ivec2 cb = World::getChunkCell(b);
+    return std::max(std::abs(ca.x - cb.x), std::abs(ca.y - cb.y));
+}
+
+float RelayServer::interestWeight(int ring) noexcept
+{
+    if (ring <= 1)
+    {
+        return 1.0f;
+    }
+    if (ring == 2)
+    {
+        return 0.5f;
+    }
+    return ring <= INTEREST_RADIUS ? 0.25f : 0.0f;
+}
+
+RelayServer::Client *RelayServer::admit(const std::string &peer)
+{
+    if (const auto it = mClients.find(peer); it != mClients.end())
+    {
+        return &it->second;
+    }
+
+    const auto freeSlot = std::find(mSlotsUsed.begin(), mSlotsUsed.end(), false);
+    if (freeSlot == mSlotsUsed.end())
+    {
+        // Not removed here: the transport is still delivering this peer's datagram
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "RelayServer: room full, refusing %s", peer.c_str());
+        mRefusedPeers.push_back(peer);
+        return nullptr;
+    }
+
+    *freeSlot = true;
+    Client &client = mClients[peer];
+    client.slot = static_cast<std::uint8_t>(freeSlot - mSlotsUsed.begin());
+    mBySlot[client.slot] = &client;
+    mRosterDirty = true;
+    SDL_Log("RelayServer: %s joined as slot %u (%zu clients)", peer.c_str(), static_cast<unsigned>(client.slot),
+            mClients.size());
+    return &client;
+}
+
+void RelayServer::handleMessage(const std::string &peer, sf::Packet &message)
+{
+    std::int32_t packetType = 0;
+    if (!(message >> packetType))
+    {
+        return;
+    }
+
+    if (packetType == static_cast<std::int32_t>(HttpClient::PacketType::PLAYER_HELLO))
+    {
+        std::uint8_t playerId = 0;
+        std::string name;
+        std::uint16_t listenPort = 0;
+        if (!(message >> playerId >> name >> listenPort))
+        {
+            return;
+        }
+        name.resize(std::min(name.size(), MAX_NAME_LENGTH));
+        if (Client *client = admit(peer); client && client->name != name)
+        {
+            client->name = name;
+            mRosterDirty = true;
+        }
+    }
+    else if (packetType == static_cast<std::int32_t>(HttpClient::PacketType::POSITION_UPDATE))
+    {
+        // Same layout a mesh peer receives: the client cannot tell the relay from one
+        std::uint8_t playerId = 0;
+        std::uint16_t sequence = 0;
+        std::uint16_t senderMillis = 0;
+        std::uint8_t baselineDistance = 0;
+        if (!(message >> playerId >> sequence >> senderMillis >> baselineDistance))
+        {
+            return;
+        }
+
+        Client *client = admit(peer);
+        if (!client)
+        {
+            return;
+        }
+
+        PlayerSnapshot baseline;
+        if (baselineDistance != 0)
+        {
+            const auto baselineSequence = static_cast<std::uint16_t>(sequence - baselineDistance);
+            const auto &record = client->history[baselineSequence % SNAPSHOT_HISTORY];
+            if (!record.valid || record.sequence != baselineSequence)
+            {
+                return;
+            }
+            baseline = record.snapshot;
+        }
+
+        PlayerSnapshot snapshot;
+        if (!PlayerSnapshot::read(message, baseline, snapshot))
+        {
+            return;
+        }
+        client->history[sequence % SNAPSHOT_HISTORY] = SnapshotRecord{sequence, snapshot, true};
+        ++mStats.snapshotsIn;
+
+        if (client->hasLatest && !NetTransport::sequenceGreater(sequence, client->latestSequence))
+        {
+            return;
+        }
+        client->latest = snapshot;
+        client->latestSequence = sequence;
+        client->latestSenderMillis = senderMillis;
+        client->hasLatest = true;
+        client->position = snapshot.getPosition();
+    }
+    else if (packetType == static_cast<std::int32_t>(HttpClient::PacketType::PING))
+    {
+        // A relayed client measures its round trip to the relay, which is the hop it controls
+        std::uint32_t senderMillis = 0;
+        if (message >> senderMillis)
+        {
+            sf::Packet pong;
+            pong << static_cast<std::int32_t>(HttpClient::PacketType::PONG) << senderMillis;
+            mTransport.send(peer, pong, NetTransport::Channel::UNRELIABLE);
+        }
+    }
+}
+
+void RelayServer::dropTimedOut()
+{
+    for (auto it = mClients.begin(); it != mClients.end();)
+    {
+        if (mTransport.getSecondsSinceReceived(it->first) < CLIENT_TIMEOUT_SECONDS)
+        {
+            ++it;
+            continue;
+        }
+
+        SDL_Log("RelayServer: %s timed out", it->first.c_str());
+        const std::uint8_t slot = it->second.slot;
+        mSlotsUsed[slot] = false;
+        mBySlot[slot] = nullptr;
+        for (auto &[key, other] : mClients)
+        {
+            other.priority[slot] = 0.0f;
+            other.sentAny[slot] = false;
+        }
+        mTransport.removePeer(it->first);
+        it = mClients.erase(it);
+        mRosterDirty = true;
+    }
+
+    for (const auto &key : mRefusedPeers)
+    {
+        mTransport.removePeer(key);
+    }
+    mRefusedPeers.clear();
+
+    // Senders the transport adopted that never said hello
+    for (const auto &key : mTransport.getPeerKeys())
+    {
+        if (mClients.find(key) == mClients.end() && mTransport.getSecondsSinceReceived(key) >= CLIENT_TIMEOUT_SECONDS)
+        {
+            mTransport.removePeer(key);
+        }
+    }
+}
+
+void RelayServer::broadcastSnapshots()
+{
+    // A lost fan-out is superseded by the next one, so it goes unreliable and carries full snapshots
+    const auto flush = [this](const std::string &key, const sf::Packet &entries, std::uint8_t count)
+    {
+        sf::Packet message;
+        message << static_cast<std::int32_t>(HttpClient::PacketType::RELAY_SNAPSHOT) << count;
+        message.append(entries.getData(), entries.getDataSize());
+        mTransport.send(key, message, NetTransport::Channel::UNRELIABLE);
+        ++mStats.messagesOut;
+    };
+
+    std::vector<const Client *> due;
+    due.reserve(mClients.size());
+
+    for (auto &[key, recipient] : mClients)
+    {
+        due.clear();
+        for (const Client *source : mBySlot)
+        {
+            if (!source || source == &recipient || !source->hasLatest)
+            {
+                continue;
+            }
+
+            const std::uint8_t slot = source->slot;
+            // Until the recipient's own first snapshot everyone counts as near
+            const int ring = recipient.hasLatest ? chunkRing(recipient.position, source->position) : 0;
+            const float weight = interestWeight(ring);
+            const bool fresh = !recipient.sentAny[slot] || recipient.sentSequence[slot] != source->latestSequence;
+            if (weight <= 0.0f || !fresh)
+            {
+                // Out of range or already up to date: nothing owed
+                recipient.priority[slot] = 0.0f;
+                continue;
+            }
+
+            recipient.priority[slot] += weight;
+            if (recipient.priority[slot] >= 1.0f)
+            {
+                due.push_back(source);
+            }
+        }
+
+        if (due.size() > MAX_ENTRIES_PER_SEND)
+        {
+            std::partial_sort(due.begin(), due.begin() + MAX_ENTRIES_PER_SEND, due.end(),
+                              [&recipient](const Client *a, const Client *b)
+                              { return recipient.priority[a->slot] > recipient.priority[b->slot]; });
+            mStats.entriesDeferred += due.size() - MAX_ENTRIES_PER_SEND;
+            due.resize(MAX_ENTRIES_PER_SEND);
+        }
+
+        sf::Packet entries;
+        std::uint8_t count = 0;
+        for (const Client *source : due)
+        {
+            if (entries.getDataSize() + kMaxEntrySize > kMessageBudget)
+            {
+                flush(key, entries, count);
+                entries.clear();
+                count = 0;
+            }
+            entries << source->slot << source->latestSequence << source->latestSenderMillis;
+            source->latest.write(entries, nullptr);
+            ++count;
+            ++mStats.entriesOut;
+
+            recipient.priority[source->slot] = 0.0f;
+            recipient.sentSequence[source->slot] = source->latestSequence;
+            recipient.sentAny[source->slot] = true;
+        }
+        if (count > 0)
+        {
+            flush(key, entries, count);
+        }
+    }
+}
+
+void RelayServer::broadcastRoster()
+{
+    // Reliable: names only change on join, leave or rename
+    for (const auto &[key, recipient] : mClients)
+    {
+        sf::Packet message;
+        message << static_cast<std::int32_t>(HttpClient::PacketType::RELAY_ROSTER)
+                << static_cast<std::uint8_t>(mClients.size() - 1);
+        for (const auto &[otherKey, other] : mClients)
+        {
+            if (&other != &recipient)
+            {
+                message << other.slot << other.name;
+            }
+        }
+        mTransport.send(key, message, NetTransport::Channel::RELIABLE);
+    }
+}
@@ -0,0 +1,119 @@
+#ifndef RELAY_SERVER_HPP
+#define RELAY_SERVER_HPP
+
+#include "NetTransport.hpp"
+#include "PlayerSnapshot.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// @brief Authoritative relay for rooms larger than the peer mesh can carry
+/// @details Clients send their POSITION_UPDATE stream to the relay alone, delta-encoded against the
+/// snapshots the relay acked exactly as they would to a mesh peer. The relay decodes each one, keeps
+/// the newest per client and on its own tick sends every client one RELAY_SNAPSHOT with the players
+/// relevant to it, split only where a datagram would overflow. So a client's upstream is one stream
+/// and its downstream one aggregated stream, whatever the room size.
+///
+/// Relevance is keyed on World's chunk grid: every tick a recipient's priority for each other player
+/// grows by a weight that falls with the chunk ring between them, and players whose priority reached
+/// one are sent, highest first, up to a per-tick cap. Far players therefore arrive at a reduced rate,
+/// players beyond INTEREST_RADIUS not at all, and an unsent player keeps accumulating so none starves.
+class RelayServer
+{
+public:
+    static constexpr std::size_t MAX_CLIENTS = 64;
+    static constexpr float SEND_INTERVAL = 0.1f;
+    /// A client silent for this long is dropped from the room
+    static constexpr float CLIENT_TIMEOUT_SECONDS = 10.0f;
+    /// Longer names are cut so a full roster still fits one datagram
+    static constexpr std::size_t MAX_NAME_LENGTH = 12;
+    /// Chebyshev chunk distance past which a player is not sent at all
+    static constexpr int INTEREST_RADIUS = 4;
+    /// Entries one recipient gets per tick at most
+    static constexpr std::size_t MAX_ENTRIES_PER_SEND = 24;
+
+    struct Stats
+    {
+        std::size_t clients{0};
+        std::size_t snapshotsIn{0};
+        std::size_t entriesOut{0};
+        /// Entries that were due but left for a later tick by the per-tick cap
+        std::size_t entriesDeferred{0};
+        std::size_t messagesOut{0};
+    };
+
+    RelayServer() = default;
+
+    RelayServer(const RelayServer &) = delete;
+    RelayServer &operator=(const RelayServer &) = delete;
+
+    bool start(unsigned short port);
+    void stop();
+
+    /// @brief Receive, drop timed-out clients and, once per SEND_INTERVAL, fan the room out
+    void update(float dt);
+
+    [[nodiscard]] bool isRunning() const noexcept { return mTransport.isBound(); }
+    [[nodiscard]] unsigned short getLocalPort() const noexcept { return mTransport.getLocalPort(); }
+    [[nodiscard]] std::size_t getClientCount() const noexcept { return mClients.size(); }
+
+    /// Counters since the last call
+    [[nodiscard]] Stats takeStats() noexcept;
+
+    /// Chebyshev distance between the chunk cells of two positions
+    [[nodiscard]] static int chunkRing(const glm::vec3 &a, const glm::vec3 &b) noexcept;
+    /// Priority gained per tick at a chunk ring: 1 for the surrounding ring, falling off, 0 out of range
+    [[nodiscard]] static float interestWeight(int ring) noexcept;
+
+private:
+    static constexpr std::size_t SNAPSHOT_HISTORY = 32;
+
+    struct SnapshotRecord
+    {
+        std::uint16_t sequence{0};
+        PlayerSnapshot snapshot;
+        bool valid{false};
+    };
+
+    struct Client
+    {
+        std::uint8_t slot{0};
+        std::string name;
+        /// Baselines the client deltas against, by its own sequence
+        std::array<SnapshotRecord, SNAPSHOT_HISTORY> history{};
+        PlayerSnapshot latest;
+        std::uint16_t latestSequence{0};
+        std::uint16_t latestSenderMillis{0};
+        bool hasLatest{false};
+        glm::vec3 position{0.0f};
+
+        /// Per source slot, as seen by this client as a recipient
+        std::array<float, MAX_CLIENTS> priority{};
+        std::array<std::uint16_t, MAX_CLIENTS> sentSequence{};
+        std::array<bool, MAX_CLIENTS> sentAny{};
+    };
+
+    void handleMessage(const std::string &peer, sf::Packet &message);
+    Client *admit(const std::string &peer);
+    void dropTimedOut();
+    void broadcastSnapshots();
+    void broadcastRoster();
+
+    NetTransport mTransport;
+    std::unordered_map<std::string, Client> mClients;
+    /// Admitted clients by slot, for the per-recipient relevance pass
+    std::array<Client *, MAX_CLIENTS> mBySlot{};
+    std::vector<std::string> mRefusedPeers;
+    std::array<bool, MAX_CLIENTS> mSlotsUsed{};
+    float mSendAccumulator{0.0f};
+    bool mRosterDirty{false};
+    Stats mStats;
+};
+
+#endif // RELAY_SERVER_HPP
@@ -0,0 +1,24 @@
+#include "RenderStats.hpp"
+
+RenderStats::Counters RenderStats::sCurrent{};
+RenderStats::Counters RenderStats::sLastFrame{};
+
+void RenderStats::beginFrame() noexcept
+{
+    sLastFrame = sCurrent;
+    sCurrent = {};
+}
+
+void RenderStats::multiDrawElements(GLenum mode, const GLsizei *counts, GLenum type, const void *const *indices,
+                                    GLsizei drawCount) noexcept
+{
+    glMultiDrawElements(mode, counts, type, indices, drawCount);
+
+    ++sCurrent.drawCalls;
+    sCurrent.indirectDraws += static_cast<std::uint64_t>(drawCount);
+    sCurrent.instances += static_cast<std::uint64_t>(drawCount);
+    for (GLsizei i = 0; i < drawCount; ++i)
+    {
+        sCurrent.triangles += trianglesOf(mode, counts[i]);
+    }
+}
@@ -0,0 +1,170 @@
+#ifndef RENDER_STATS_HPP
+#define RENDER_STATS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <glad/glad.h>
+
+/// @brief Per-frame counts of the GL work the renderer submits
+/// @details Draws, dispatches and buffer uploads go through the thin wrappers below, which issue the GL
+/// call and bump a counter; program, vertex array and texture binds are counted by GLStateCache when it
+/// actually reaches GL, and uniform sets by Shader. All counting happens on the GL thread, so the counters
+/// are plain integers. beginFrame() latches the previous frame for the debug overlay.
+///
+/// Indirect draws build their commands on the GPU, so they add to drawCalls and indirectDraws but not to
+/// instances or triangles.
+class RenderStats
+{
+public:
+    /// Skinned-character animation tiers: pose every frame, every 2nd, every 4th, or outside the view
+    static constexpr std::size_t ANIMATION_LOD_COUNT = 4;
+
+    struct Counters
+    {
+        std::uint64_t drawCalls{0};
+        /// Commands executed by indirect and multi draws; each call counts once in drawCalls
+        std::uint64_t indirectDraws{0};
+        std::uint64_t instances{0};
+        std::uint64_t triangles{0};
+        std::uint64_t programBinds{0};
+        std::uint64_t vertexArrayBinds{0};
+        std::uint64_t textureBinds{0};
+        std::uint64_t uniformUploads{0};
+        std::uint64_t uploadBytes{0};
+        std::uint64_t computeDispatches{0};
+        /// Characters drawn (or skipped, in the last tier) per animation tier
+        std::array<std::uint64_t, ANIMATION_LOD_COUNT> animationLods{};
+    };
+
+    /// Call once per frame before anything is drawn
+    static void beginFrame() noexcept;
+
+    /// Totals of the last complete frame
+    [[nodiscard]] static const Counters &getLastFrame() noexcept { return sLastFrame; }
+
+    static void drawArrays(GLenum mode, GLint first, GLsizei count) noexcept
+    {
+        glDrawArrays(mode, first, count);
+        countDraw(mode, count, 1);
+    }
+
+    static void drawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances) noexcept
+    {
+        glDrawArraysInstanced(mode, first, count, instances);
+        countDraw(mode, count, instances);
+    }
+
+    static void drawArraysInstancedBaseInstance(GLenum mode, GLint first, GLsizei count, GLsizei instances,
+                                                GLuint baseInstance) noexcept
+    {
+        glDrawArraysInstancedBaseInstance(mode, first, count, instances, baseInstance);
+        countDraw(mode, count, instances);
+    }
+
+    static void drawElements(GLenum mode, GLsizei count, GLenum type, const void *indices) noexcept
+    {
+        glDrawElements(mode, count, type, indices);
+        countDraw(mode, count, 1);
+    }
+
+    static void drawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void *indices,
+                                      GLsizei instances) noexcept
+    {
+        glDrawElementsInstanced(mode, count, type, indices, instances);
+        countDraw(mode, count, instances);
+    }
+
+    static void drawElementsInstancedBaseInstance(GLenum mode, GLsizei count, GLenum type, const void *indices,
+                                                  GLsizei instances, GLuint baseInstance) noexcept
+    {
+        glDrawElementsInstancedBaseInstance(mode, count, type, indices, instances, baseInstance);
+        countDraw(mode, count, instances);
+    }
+
+    static void multiDrawElements(GLenum mode, const GLsizei *counts, GLenum type, const void *const *indices,
+                                  GLsizei drawCount) noexcept;
+
+    static void multiDrawElementsIndirect(GLenum mode, GLenum type, const void *indirect, GLsizei drawCount,
+                                          GLsizei stride) noexcept
+    {
+        glMultiDrawElementsIndirect(mode, type, indirect, drawCount, stride);
+        ++sCurrent.drawCalls;
+        sCurrent.indirectDraws += static_cast<std::uint64_t>(drawCount);
+    }
+
+    static void drawArraysIndirect(GLenum mode, const void *indirect) noexcept
+    {
+        glDrawArraysIndirect(mode, indirect);
+        ++sCurrent.drawCalls;
+        ++sCurrent.indirectDraws;
+    }
+
+    static void dispatchCompute(GLuint groupsX, GLuint groupsY, GLuint groupsZ) noexcept
+    {
+        glDispatchCompute(groupsX, groupsY, groupsZ);
+        ++sCurrent.computeDispatches;
+    }
+
+    static void dispatchComputeIndirect(GLintptr indirect) noexcept
+    {
+        glDispatchComputeIndirect(indirect);
+        ++sCurrent.computeDispatches;
+    }
+
+    /// Only bytes actually sent count; a null data pointer just (re)allocates
+    static void bufferData(GLenum target, GLsizeiptr bytes, const void *data, GLenum usage) noexcept
+    {
+        glBufferData(target, bytes, data, usage);
+        if (data != nullptr)
+        {
+            sCurrent.uploadBytes += static_cast<std::uint64_t>(bytes);
+        }
+    }
+
+    static void bufferSubData(GLenum target, GLintptr offset, GLsizeiptr bytes, const void *data) noexcept
+    {
+        glBufferSubData(target, offset, bytes, data);
+        sCurrent.uploadBytes += static_cast<std::uint64_t>(bytes);
+    }
+
+    /// For writes that bypass glBuffer*Data, such as copies into a persistently mapped buffer
+    static void countUploadBytes(GLsizeiptr bytes) noexcept { sCurrent.uploadBytes += static_cast<std::uint64_t>(bytes); }
+
+    static void countProgramBind() noexcept { ++sCurrent.programBinds; }
+    static void countVertexArrayBind() noexcept { ++sCurrent.vertexArrayBinds; }
+    static void countTextureBind() noexcept { ++sCurrent.textureBinds; }
+    static void countUniformUpload() noexcept { ++sCurrent.uniformUploads; }
+    static void countAnimationLod(std::size_t tier) noexcept
+    {
+        ++sCurrent.animationLods[tier < ANIMATION_LOD_COUNT ? tier : ANIMATION_LOD_COUNT - 1];
+    }
+
+private:
+    static void countDraw(GLenum mode, GLsizei count, GLsizei instances) noexcept
+    {
+        ++sCurrent.drawCalls;
+        sCurrent.instances += static_cast<std::uint64_t>(instances);
+        sCurrent.triangles += trianglesOf(mode, count) * static_cast<std::uint64_t>(instances);
+    }
+
+    [[nodiscard]] static std::uint64_t trianglesOf(GLenum mode, GLsizei count) noexcept
+    {
+        switch (mode)
+        {
+        case GL_TRIANGLES:
+            return static_cast<std::uint64_t>(count / 3);
+        case GL_TRIANGLE_STRIP:
+        case GL_TRIANGLE_FAN:
+            return count > 2 ? static_cast<std::uint64_t>(count - 2) : 0;
+        default:
+            return 0;
+        }
+    }
+
+    static Counters sCurrent;
+    static Counters sLastFrame;
+};
+
+#endif // RENDER_STATS_HPP
@@ -1,5 +1,7 @@
 #include "RenderWindow.hpp"
 
+#include "GLStateCache.hpp"
+
 #include <glad/glad.h>
 
 #include <SDL3/SDL.h>
@@ -17,6 +19,9 @@ void RenderWindow::clear() const noexcept
         return;
     }
 
+    // Re-learn tracked state once per frame in case code outside the cache changed it
+    GLStateCache::invalidate();
+
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
@@ -59,13 +64,21 @@ bool RenderWindow::isFullscreen() const noexcept
     return (flags & SDL_WINDOW_FULLSCREEN) != 0;
 }
 
-void RenderWindow::setVsync(bool enabled) const noexcept
+void RenderWindow::setVsync(bool enabled, bool adaptive) const noexcept
 {
     if (!mWindow)
     {
         return;
     }
-    // SDL3: 1 = vsync enabled, 0 = vsync disabled
+    // SDL3: 1 = vsync enabled, 0 = vsync disabled, -1 = adaptive where the driver supports it
+    if (enabled && adaptive)
+    {
+        if (SDL_GL_SetSwapInterval(-1))
+        {
+            return;
+        }
+        SDL_Log("RenderWindow: adaptive vsync unsupported (%s), using regular vsync", SDL_GetError());
+    }
     SDL_GL_SetSwapInterval(enabled ? 1 : 0);
 }
 
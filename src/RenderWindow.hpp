@@ -34,7 +34,8 @@ public:
 
     [[nodiscard]] bool isFullscreen() const noexcept;
 
-    void setVsync(bool enabled) const noexcept;
+    /// @param adaptive Late frames swap immediately instead of waiting a whole refresh (swap interval -1)
+    void setVsync(bool enabled, bool adaptive = false) const noexcept;
 
     /// @brief Get the SDL window for direct access
     [[nodiscard]] SDL_Window *getSDLWindow() const noexcept;
@@ -0,0 +1,74 @@
+#include "ResourceConfig.hpp"
+
+#include "JSONUtils.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <cctype>
+
+namespace
+{
+    const std::string kEmpty;
+
+    std::string_view trim(std::string_view text) noexcept
+    {
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front())))
+        {
+            text.remove_prefix(1);
+        }
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back())))
+        {
+            text.remove_suffix(1);
+        }
+        return text;
+    }
+}
+
+void ResourceConfig::parse(const std::unordered_map<std::string, std::string> &raw, std::string pathPrefix)
+{
+    mPathPrefix = std::move(pathPrefix);
+    mEntries.clear();
+    mEntries.reserve(raw.size());
+
+    for (const auto &[key, json] : raw)
+    {
+        const std::string_view text = trim(json);
+        Entry entry{key, std::string(JSONUtils::extractJsonView(text)), {}};
+
+        // Only string values name files; numbers, flags and nested arrays have no path
+        if (!text.empty() && text.front() == '"')
+        {
+            entry.path = JSONUtils::resolveResourcePath(mPathPrefix, entry.value);
+        }
+        mEntries.push_back(std::move(entry));
+    }
+
+    std::ranges::sort(mEntries, {}, &Entry::key);
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "ResourceConfig: %zu keys from %s", mEntries.size(), mPathPrefix.c_str());
+}
+
+void ResourceConfig::clear() noexcept
+{
+    mPathPrefix.clear();
+    mEntries.clear();
+}
+
+const std::string &ResourceConfig::getPath(std::string_view key) const noexcept
+{
+    const Entry *entry = find(key);
+    return entry != nullptr ? entry->path : kEmpty;
+}
+
+const std::string &ResourceConfig::getValue(std::string_view key) const noexcept
+{
+    const Entry *entry = find(key);
+    return entry != nullptr ? entry->value : kEmpty;
+}
+
+const ResourceConfig::Entry *ResourceConfig::find(std::string_view key) const noexcept
+{
+    const auto it = std::ranges::lower_bound(mEntries, key, {}, [](const Entry &entry) { return std::string_view{entry.key}; });
+    return it != mEntries.end() && it->key == key ? &*it : nullptr;
+}
@@ -0,0 +1,52 @@
+#ifndef RESOURCE_CONFIG_HPP
+#define RESOURCE_CONFIG_HPP
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/// @brief The resource configuration JSON, parsed once into typed values
+/// @details LoadingState fills it from the raw key/value map after the loader has read the file; every
+/// value is unquoted and every file path joined with the configuration's directory at that point, so
+/// lookups afterwards are a binary search returning a reference, with no string building per access.
+/// Everything else reads it through State::Context and treats it as read-only.
+class ResourceConfig
+{
+public:
+    /// @brief Replace the contents with the given raw JSON fragments
+    /// @param raw Key to JSON value text, as produced by JSONUtils::loadConfiguration
+    /// @param pathPrefix Directory of the configuration file; relative paths resolve against it
+    void parse(const std::unordered_map<std::string, std::string> &raw, std::string pathPrefix);
+
+    void clear() noexcept;
+
+    [[nodiscard]] bool isLoaded() const noexcept { return !mEntries.empty(); }
+
+    /// Directory of the configuration file, with a trailing slash
+    [[nodiscard]] const std::string &getPathPrefix() const noexcept { return mPathPrefix; }
+
+    /// Value of key resolved against the configuration's directory; empty when key is absent
+    [[nodiscard]] const std::string &getPath(std::string_view key) const noexcept;
+
+    /// Value of key with quotes stripped, not treated as a path; empty when key is absent
+    [[nodiscard]] const std::string &getValue(std::string_view key) const noexcept;
+
+    [[nodiscard]] std::size_t size() const noexcept { return mEntries.size(); }
+
+private:
+    struct Entry
+    {
+        std::string key;
+        std::string value;
+        std::string path;
+    };
+
+    [[nodiscard]] const Entry *find(std::string_view key) const noexcept;
+
+    std::string mPathPrefix;
+    /// Sorted by key
+    std::vector<Entry> mEntries;
+};
+
+#endif // RESOURCE_CONFIG_HPP
@@ -63,19 +63,21 @@ namespace Shaders
     enum class ID : unsigned int
     {
         GLSL_BILLBOARD_SPRITE = 0,
-        GLSL_COMPOSITE_SCENE = 1,
+        GLSL_POST_PROCESS = 1,
         GLSL_FULLSCREEN_QUAD = 2,
         GLSL_FULLSCREEN_QUAD_MVP = 3,
         GLSL_GOAL_PATH_STENCIL = 4,
         GLSL_HIGHLIGHT_TILE = 5,
         GLSL_MAZE = 6,
-        GLSL_MOTION_BLUR = 7,
-        GLSL_PARTICLES_COMPUTE = 8,
-        GLSL_SHADOW_VOLUME = 9,
-        GLSL_SKINNED_MODEL = 10,
-        GLSL_SKY = 11,
-        GLSL_OIT_RESOLVE = 12,
-        GLSL_TOTAL_SHADERS = 13
+        GLSL_PARTICLES_COMPUTE = 7,
+        GLSL_SHADOW_VOLUME = 8,
+        GLSL_SKINNED_MODEL = 9,
+        GLSL_SKY = 10,
+        GLSL_SKINNING_COMPUTE = 11,
+        GLSL_HIZ_COMPUTE = 12,
+        GLSL_OCCLUSION_CULL_COMPUTE = 13,
+        GLSL_PROCEDURAL_COMPUTE = 14,
+        GLSL_TOTAL_SHADERS = 15
     };
 }
 
@@ -96,12 +98,13 @@ namespace VAOs
     {
         FULLSCREEN_QUAD = 0,
         SHADOW_QUAD = 1,
-        WALK_PARTICLES = 2,
-        RASTER_MAZE = 3,
-        GOAL_PATH = 4,
-        PLAYER_TILE_HIGHLIGHT = 5,
-        PICKUP_SPHERES = 6,
-        TOTAL_IDS = 7
+        RASTER_MAZE = 2,
+        GOAL_PATH = 3,
+        PLAYER_TILE_HIGHLIGHT = 4,
+        PICKUP_SPHERES = 5,
+        MAZE_WALLS = 6,
+        MAZE_CHUNK_WALLS = 7,
+        TOTAL_IDS = 8
     };
 }
 
@@ -113,7 +116,7 @@ namespace FBOs
         OIT = 1,
         SHADOW = 2,
         REFLECTION = 3,
-        MOTION_BLUR = 4,
+        SKY = 4,
         TOTAL_IDS = 5
     };
 }
@@ -123,12 +126,17 @@ namespace VBOs
     enum class ID : unsigned int
     {
         SHADOW = 0,
-        WALK_PARTICLES_POS_SSBO = 1,
-        WALK_PARTICLES_VEL_SSBO = 2,
-        RASTER_MAZE = 3,
-        GOAL_PATH = 4,
-        PICKUP = 5,
-        TOTAL_IDS = 6
+        RASTER_MAZE = 1,
+        GOAL_PATH = 2,
+        PICKUP = 3,
+        PICKUP_INSTANCES = 4,
+        MAZE_FLOOR_INDICES = 5,
+        MAZE_WALL_CUBE = 6,
+        MAZE_WALL_CUBE_INDICES = 7,
+        MAZE_WALL_INSTANCES = 8,
+        MAZE_CHUNK_WALL_INSTANCES = 9,
+        MAZE_CHUNK_INDIRECT = 10,
+        TOTAL_IDS = 11
     };
 }
 
@@ -158,9 +166,10 @@ namespace Textures
         SHADOW_MAP = 19,
         REFLECTION_COLOR = 20,
         RUNNER_BREAK_PLANE = 21,
-        MOTION_BLUR_COLOR = 22,
-        PREV_FRAME = 23,
-        TOTAL_IDS = 24
+        SCENE_DEPTH = 22,
+        OIT_DEPTH = 23,
+        SKY_CACHE = 24,
+        TOTAL_IDS = 25
     };
 }
 
@@ -4,6 +4,7 @@
 #include <cassert>
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <map>
 #include <memory>
 #include <stdexcept>
@@ -17,8 +18,10 @@
 
 #include <dearimgui/imgui.h>
 
+#include "AssetPack.hpp"
 #include "GLTFModel.hpp"
 #include "FramebufferObject.hpp"
+#include "MemoryStats.hpp"
 #include "VertexArrayObject.hpp"
 #include "VertexBufferObject.hpp"
 
@@ -27,10 +30,91 @@ namespace mazes
     class configurator;
 }
 
+/// @brief Owns resources of one type by identifier
+/// @details Enum identifiers (everything in ResourceIdentifiers.hpp) are dense, so their resources sit in a
+/// vector indexed by the underlying value and get() is a bounds check and a load. Any other identifier
+/// type is kept in a map.
+///
+/// A resource registered with registerLazy() is loaded by the first get() or acquire() instead of up
+/// front. A Handle from acquire() keeps it resident; once no handle is left, a ONE_SHOT resource is freed
+/// immediately and a CACHED one stays until the lazy resources exceed the byte budget, least recently
+/// used first. References from get() are not counted, so hold a Handle across frames.
 template <typename Resource, typename Identifier>
 class ResourceManager
 {
 public:
+    enum class Residency : std::uint8_t
+    {
+        /// Kept after the last handle goes until the budget needs the memory
+        CACHED,
+        /// Freed as soon as the last handle goes, e.g. a splash image shown once
+        ONE_SHOT
+    };
+
+    enum class LoadState : std::uint8_t
+    {
+        UNKNOWN,
+        UNLOADED,
+        LOADED
+    };
+
+    /// Builds a lazy resource on the calling thread; null on failure
+    using Loader = std::function<std::unique_ptr<Resource>()>;
+
+    /// @brief Keeps a resource resident while it lives
+    class Handle
+    {
+    public:
+        Handle() = default;
+        Handle(ResourceManager &owner, Identifier id, Resource &resource) noexcept
+            : mOwner{&owner}, mId{id}, mResource{&resource}
+        {
+        }
+
+        ~Handle() { reset(); }
+
+        Handle(const Handle &) = delete;
+        Handle &operator=(const Handle &) = delete;
+
+        Handle(Handle &&other) noexcept
+            : mOwner{std::exchange(other.mOwner, nullptr)}, mId{other.mId},
+              mResource{std::exchange(other.mResource, nullptr)}
+        {
+        }
+
+        Handle &operator=(Handle &&other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                mOwner = std::exchange(other.mOwner, nullptr);
+                mId = other.mId;
+                mResource = std::exchange(other.mResource, nullptr);
+            }
+            return *this;
+        }
+
+        void reset() noexcept
+        {
+            if (mOwner)
+            {
+                mOwner->release(mId);
+            }
+            mOwner = nullptr;
+            mResource = nullptr;
+        }
+
+        [[nodiscard]] Resource *get() const noexcept { return mResource; }
+        Resource *operator->() const noexcept { return mResource; }
+        Resource &operator*() const noexcept { return *mResource; }
+        explicit operator bool() const noexcept { return mResource != nullptr; }
+
+    private:
+        ResourceManager *mOwner{nullptr};
+        Identifier mId{};
+        Resource *mResource{nullptr};
+    };
+
     // Level loading
     void load(Identifier id, const std::vector<mazes::configurator> &configs, bool appendResults);
 
@@ -50,9 +134,34 @@ public:
     // Font loading
     void load(Identifier id, const void *data, const std::size_t capacity);
 
+    /// Loads a registered lazy resource; the const overload only returns resident ones
     Resource &get(Identifier id);
     const Resource &get(Identifier id) const;
 
+    /// @brief Declare id to be loaded by loader on first use instead of now
+    void registerLazy(Identifier id, Loader loader, Residency residency = Residency::CACHED);
+
+    /// @brief Load id if needed and keep it resident while the handle lives
+    Handle acquire(Identifier id);
+
+    /// Resident lazy resources are evicted above this many bytes; eager ones never count
+    void setBudget(std::size_t bytes) noexcept
+    {
+        mBudget = bytes;
+        evictOverBudget();
+    }
+
+    [[nodiscard]] std::size_t getResidentBytes() const noexcept { return mResidentBytes; }
+
+    [[nodiscard]] LoadState getLoadState(Identifier id) const noexcept
+    {
+        if (find(id) != nullptr)
+        {
+            return LoadState::LOADED;
+        }
+        return mLazy.contains(id) ? LoadState::UNLOADED : LoadState::UNKNOWN;
+    }
+
     /// Insert a pre-constructed resource
     void insert(Identifier id, std::unique_ptr<Resource> resource)
     {
@@ -64,20 +173,69 @@ public:
         if constexpr (std::is_same_v<Resource, Shader> || std::is_same_v<Resource, VertexArrayObject>
                       || std::is_same_v<Resource, FramebufferObject> || std::is_same_v<Resource, VertexBufferObject>)
         {
-            for (auto &[_, res] : mResourceMap)
+            if constexpr (DENSE)
             {
-                res->cleanUp();
+                for (auto &res : mResources)
+                {
+                    if (res)
+                    {
+                        res->cleanUp();
+                    }
+                }
+            }
+            else
+            {
+                for (auto &[_, res] : mResources)
+                {
+                    res->cleanUp();
+                }
             }
         }
     }
 
-    bool isEmpty() const noexcept { return mResourceMap.empty(); }
+    bool isEmpty() const noexcept { return mCount == 0; }
 
 private:
+    static constexpr bool DENSE = std::is_enum_v<Identifier>;
+
+    struct LazyEntry
+    {
+        Loader loader;
+        Residency residency;
+        std::uint32_t references{0};
+        std::uint64_t lastUse{0};
+        std::size_t bytes{0};
+    };
+
     void insertResource(Identifier id, std::unique_ptr<Resource> resource);
 
+    /// Null when id has no resource
+    Resource *find(Identifier id) const noexcept;
+
+    /// Null when id is not lazy; throws when its loader fails
+    Resource *loadLazy(Identifier id);
+    void release(Identifier id) noexcept;
+    void evict(Identifier id, LazyEntry &entry) noexcept;
+    /// Drop unreferenced lazy resources, oldest use first, skipping the one used last
+    void evictOverBudget() noexcept;
+
+    /// Memory estimate counted against the budget
+    [[nodiscard]] static std::size_t residentBytesOf(const Resource &resource) noexcept;
+
+    [[noreturn]] static void throwNotFound(Identifier id);
+
 private:
-    std::map<Identifier, std::unique_ptr<Resource>> mResourceMap;
+    std::conditional_t<DENSE, std::vector<std::unique_ptr<Resource>>, std::map<Identifier, std::unique_ptr<Resource>>> mResources;
+    std::size_t mCount{0};
+
+    // Off the get() fast path: only consulted when a resource is missing, acquired or released
+    std::map<Identifier, LazyEntry> mLazy;
+    std::size_t mBudget{std::numeric_limits<std::size_t>::max()};
+    std::size_t mResidentBytes{0};
+    std::uint64_t mUseClock{0};
+
+    /// Decoded samples of every resident sound buffer; the other resources report themselves
+    MemoryStats::Allocation mSampleBytes{MemoryStats::Category::CPU_AUDIO};
 };
 
 template <typename Resource, typename Identifier>
@@ -108,6 +266,17 @@ void ResourceManager<Resource, Identifier>::load(Identifier id, std::string_view
             throw std::runtime_error("ResourceManager::load - Failed to load " + std::string(filename));
         }
     }
+    else if constexpr (requires(Resource &r, const void *data, std::size_t size) { r.loadFromMemory(data, size); })
+    {
+        // Packed files decode straight out of the mapping (sound buffers)
+        const auto packed = AssetPack::find(filename);
+        const bool loaded = packed.empty() ? resource->loadFromFile(filename)
+                                           : resource->loadFromMemory(packed.data(), packed.size());
+        if (!loaded)
+        {
+            throw std::runtime_error("ResourceManager::load - Failed to load " + std::string(filename));
+        }
+    }
     else
     {
         if (!resource->loadFromFile(filename))
@@ -185,33 +354,227 @@ void ResourceManager<Resource, Identifier>::load(Identifier id, const void *data
 template <typename Resource, typename Identifier>
 Resource &ResourceManager<Resource, Identifier>::get(Identifier id)
 {
-    auto found = mResourceMap.find(id);
-    if (found == mResourceMap.cend()) {
-        throw std::runtime_error("ResourceManager::get - resource id " +
-                                 std::to_string(static_cast<int>(id)) + " not found");
+    if (Resource *resource = find(id))
+    {
+        return *resource;
     }
-
-    return *found->second;
+    if (Resource *resource = loadLazy(id))
+    {
+        return *resource;
+    }
+    throwNotFound(id);
 }
 
 template <typename Resource, typename Identifier>
 const Resource &ResourceManager<Resource, Identifier>::get(Identifier id) const
 {
-    auto found = mResourceMap.find(id);
-    if (found == mResourceMap.cend()) {
+    if (const Resource *resource = find(id))
+    {
+        return *resource;
+    }
+    throwNotFound(id);
+}
+
+template <typename Resource, typename Identifier>
+Resource *ResourceManager<Resource, Identifier>::find(Identifier id) const noexcept
+{
+    if constexpr (DENSE)
+    {
+        const auto index = static_cast<std::size_t>(id);
+        return index < mResources.size() ? mResources[index].get() : nullptr;
+    }
+    else
+    {
+        auto found = mResources.find(id);
+        return found != mResources.cend() ? found->second.get() : nullptr;
+    }
+}
+
+template <typename Resource, typename Identifier>
+void ResourceManager<Resource, Identifier>::registerLazy(Identifier id, Loader loader, Residency residency)
+{
+    // Each id is loaded once, eagerly or lazily
+    assert(find(id) == nullptr && !mLazy.contains(id));
+    mLazy.emplace(id, LazyEntry{std::move(loader), residency});
+}
+
+template <typename Resource, typename Identifier>
+typename ResourceManager<Resource, Identifier>::Handle ResourceManager<Resource, Identifier>::acquire(Identifier id)
+{
+    Resource *resource = find(id);
+    if (!resource)
+    {
+        resource = loadLazy(id);
+    }
+    if (!resource)
+    {
+        throwNotFound(id);
+    }
+
+    if (auto lazy = mLazy.find(id); lazy != mLazy.end())
+    {
+        ++lazy->second.references;
+        lazy->second.lastUse = ++mUseClock;
+    }
+    return Handle{*this, id, *resource};
+}
+
+template <typename Resource, typename Identifier>
+Resource *ResourceManager<Resource, Identifier>::loadLazy(Identifier id)
+{
+    auto lazy = mLazy.find(id);
+    if (lazy == mLazy.end())
+    {
+        return nullptr;
+    }
+
+    auto resource = lazy->second.loader();
+    if (!resource)
+    {
+        throw std::runtime_error("ResourceManager::get - Failed to load lazy resource");
+    }
+
+    Resource *loaded = resource.get();
+    LazyEntry &entry = lazy->second;
+    entry.bytes = residentBytesOf(*loaded);
+    entry.lastUse = ++mUseClock;
+    mResidentBytes += entry.bytes;
+    insertResource(id, std::move(resource));
+
+    evictOverBudget();
+    return loaded;
+}
+
+template <typename Resource, typename Identifier>
+void ResourceManager<Resource, Identifier>::release(Identifier id) noexcept
+{
+    auto lazy = mLazy.find(id);
+    if (lazy == mLazy.end() || lazy->second.references == 0)
+    {
+        return;
+    }
+
+    LazyEntry &entry = lazy->second;
+    if (--entry.references == 0)
+    {
+        if (entry.residency == Residency::ONE_SHOT)
+        {
+            evict(id, entry);
+        }
+        else
+        {
+            evictOverBudget();
+        }
+    }
+}
+
+template <typename Resource, typename Identifier>
+void ResourceManager<Resource, Identifier>::evict(Identifier id, LazyEntry &entry) noexcept
+{
+    if (find(id) == nullptr)
+    {
+        return;
+    }
+
+    if constexpr (DENSE)
+    {
+        mResources[static_cast<std::size_t>(id)].reset();
+    }
+    else
+    {
+        mResources.erase(id);
+    }
+    --mCount;
+    mResidentBytes -= entry.bytes;
+    if constexpr (requires(const Resource &r) { r.getSampleCount(); })
+    {
+        mSampleBytes.set(mSampleBytes.getBytes() - entry.bytes);
+    }
+    entry.bytes = 0;
+}
+
+template <typename Resource, typename Identifier>
+void ResourceManager<Resource, Identifier>::evictOverBudget() noexcept
+{
+    while (mResidentBytes > mBudget)
+    {
+        LazyEntry *oldest = nullptr;
+        Identifier oldestId{};
+        for (auto &[id, entry] : mLazy)
+        {
+            if (entry.references == 0 && entry.lastUse != mUseClock && find(id) != nullptr &&
+                (!oldest || entry.lastUse < oldest->lastUse))
+            {
+                oldest = &entry;
+                oldestId = id;
+            }
+        }
+        if (!oldest)
+        {
+            return;
+        }
+        evict(oldestId, *oldest);
+    }
+}
+
+template <typename Resource, typename Identifier>
+std::size_t ResourceManager<Resource, Identifier>::residentBytesOf(const Resource &resource) noexcept
+{
+    if constexpr (requires { resource.getWidth(); resource.getHeight(); })
+    {
+        // RGBA8 base level
+        return static_cast<std::size_t>(resource.getWidth()) * static_cast<std::size_t>(resource.getHeight()) * 4u;
+    }
+    else if constexpr (requires { resource.getSampleCount(); })
+    {
+        return static_cast<std::size_t>(resource.getSampleCount()) * sizeof(std::int16_t);
+    }
+    else
+    {
+        return sizeof(Resource);
+    }
+}
+
+template <typename Resource, typename Identifier>
+void ResourceManager<Resource, Identifier>::throwNotFound(Identifier id)
+{
+    if constexpr (DENSE)
+    {
         throw std::runtime_error("ResourceManager::get - resource id " +
                                  std::to_string(static_cast<int>(id)) + " not found");
     }
-
-    return *found->second;
+    else
+    {
+        throw std::runtime_error("ResourceManager::get - resource not found");
+    }
 }
 
 template <typename Resource, typename Identifier>
 void ResourceManager<Resource, Identifier>::insertResource(Identifier id, std::unique_ptr<Resource> resource)
 {
-    // Insert and check success
-    auto inserted = mResourceMap.insert(std::make_pair(id, std::move(resource)));
-    assert(inserted.second);
+    if constexpr (requires(const Resource &r) { r.getSampleCount(); })
+    {
+        mSampleBytes.set(mSampleBytes.getBytes() + residentBytesOf(*resource));
+    }
+
+    if constexpr (DENSE)
+    {
+        const auto index = static_cast<std::size_t>(id);
+        if (index >= mResources.size())
+        {
+            mResources.resize(index + 1);
+        }
+        // Each id is loaded once
+        assert(!mResources[index]);
+        mResources[index] = std::move(resource);
+    }
+    else
+    {
+        // Insert and check success
+        auto inserted = mResources.insert(std::make_pair(id, std::move(resource)));
+        assert(inserted.second);
+    }
+    ++mCount;
 }
 
 #endif // RESOURCE_MANAGER_HPP
@@ -0,0 +1,213 @@
+#include "RollbackSession.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    constexpr float kMoveLimit = static_cast<float>(std::numeric_limits<std::int16_t>::max());
+}
+
+RollbackInput RollbackInput::quantize(const glm::vec2 &move) noexcept
+{
+    const auto axis = [](float value)
+    {
+        return static_cast<std::int16_t>(std::clamp(std::round(value * MOVE_UNITS), -kMoveLimit, kMoveLimit));
+    };
+    return RollbackInput{axis(move.x), axis(move.y)};
+}
+
+glm::vec2 RollbackInput::getMove() const noexcept
+{
+    return glm::vec2(static_cast<float>(moveX), static_cast<float>(moveZ)) / MOVE_UNITS;
+}
+
+RollbackSession::RollbackSession(IRollbackSimulation &simulation, std::size_t playerCount, std::size_t localPlayer) noexcept
+    : mSimulation{simulation}, mPlayerCount{std::clamp<std::size_t>(playerCount, 1, MAX_PLAYERS)},
+      mLocalPlayer{std::min(localPlayer, mPlayerCount - 1)}
+{
+    // Nobody has input for the frames inside the delay, so every peer starts them neutral
+    for (std::size_t player = 0; player < mPlayerCount; ++player)
+    {
+        for (std::uint32_t frame = 0; frame < INPUT_DELAY; ++frame)
+        {
+            receive(player, frame, RollbackInput{});
+        }
+    }
+}
+
+void RollbackSession::setLocalInput(const RollbackInput &input) noexcept
+{
+    receive(mLocalPlayer, mFrame + INPUT_DELAY, input);
+}
+
+bool RollbackSession::advanceFrame()
+{
+    if (mRollbackFrame < mFrame)
+    {
+        // The slot still holds that frame: mispredictions are never older than the confirmed frame,
+        // and the stall below keeps the present within STATE_SLOTS of it
+        mSimulation.loadState(mRollbackFrame % STATE_SLOTS);
+        for (std::uint32_t frame = mRollbackFrame; frame < mFrame; ++frame)
+        {
+            if (frame != mRollbackFrame)
+            {
+                mSimulation.saveState(frame % STATE_SLOTS);
+            }
+            simulate(frame);
+            ++mResimulatedFrames;
+        }
+        ++mRollbackCount;
+        mRollbackFrame = mFrame;
+    }
+
+    const std::uint32_t confirmed = getConfirmedFrame();
+    if (mFrame >= confirmed + MAX_PREDICTION)
+    {
+        ++mStallCount;
+        return false;
+    }
+
+    mSimulation.saveState(mFrame % STATE_SLOTS);
+    simulate(mFrame);
+    ++mFrame;
+    mRollbackFrame = mFrame;
+
+    const std::uint32_t oldestNeeded = std::min(confirmed, mFrame - 1);
+    if (oldestNeeded > mLastConfirmedState)
+    {
+        mLastConfirmedState = oldestNeeded;
+        mSimulation.confirmState(oldestNeeded % STATE_SLOTS);
+    }
+    return true;
+}
+
+void RollbackSession::writeLocalInputs(sf::Packet &packet) const
+{
+    packet << static_cast<std::uint8_t>(mPlayerCount);
+    for (std::size_t player = 0; player < mPlayerCount; ++player)
+    {
+        packet << mPlayers[player].confirmed;
+    }
+
+    // From the oldest input a peer lacks; the ring only reaches back so far, and the stall keeps a
+    // connected peer well inside it
+    const std::uint32_t end = mPlayers[mLocalPlayer].confirmed;
+    std::uint32_t first = end;
+    for (std::size_t player = 0; player < mPlayerCount; ++player)
+    {
+        if (player != mLocalPlayer)
+        {
+            first = std::min(first, mPlayers[player].acked);
+        }
+    }
+    first = std::max(first, end > INPUT_RING ? end - INPUT_RING : 0u);
+
+    packet << first << static_cast<std::uint8_t>(end - first);
+    for (std::uint32_t frame = first; frame < end; ++frame)
+    {
+        const RollbackInput &input = mPlayers[mLocalPlayer].received[frame % INPUT_RING].input;
+        packet << input.moveX << input.moveZ;
+    }
+}
+
+bool RollbackSession::readRemoteInputs(std::size_t player, sf::Packet &packet)
+{
+    const bool remote = player < mPlayerCount && player != mLocalPlayer;
+
+    std::uint8_t players = 0;
+    if (!(packet >> players))
+    {
+        return false;
+    }
+    for (std::uint8_t i = 0; i < players; ++i)
+    {
+        std::uint32_t confirmed = 0;
+        if (!(packet >> confirmed))
+        {
+            return false;
+        }
+        if (remote && i == mLocalPlayer)
+        {
+            mPlayers[player].acked = std::max(mPlayers[player].acked, confirmed);
+        }
+    }
+
+    std::uint32_t first = 0;
+    std::uint8_t count = 0;
+    if (!(packet >> first >> count))
+    {
+        return false;
+    }
+
+    for (std::uint8_t i = 0; i < count; ++i)
+    {
+        RollbackInput input;
+        if (!(packet >> input.moveX >> input.moveZ))
+        {
+            return false;
+        }
+        if (remote)
+        {
+            receive(player, first + i, input);
+        }
+    }
+    return true;
+}
+
+std::uint32_t RollbackSession::getConfirmedFrame() const noexcept
+{
+    std::uint32_t confirmed = std::numeric_limits<std::uint32_t>::max();
+    for (std::size_t player = 0; player < mPlayerCount; ++player)
+    {
+        confirmed = std::min(confirmed, mPlayers[player].confirmed);
+    }
+    return confirmed;
+}
+
+RollbackInput RollbackSession::inputFor(std::size_t player, std::uint32_t frame) const noexcept
+{
+    const PlayerInputs &inputs = mPlayers[player];
+    const InputSlot &slot = inputs.received[frame % INPUT_RING];
+    return (slot.known && slot.frame == frame) ? slot.input : inputs.last;
+}
+
+void RollbackSession::receive(std::size_t player, std::uint32_t frame, const RollbackInput &input) noexcept
+{
+    PlayerInputs &inputs = mPlayers[player];
+    // Already confirmed, or so far ahead its ring slot is still in use; a later packet repeats it
+    if (frame < inputs.confirmed || frame >= inputs.confirmed + INPUT_RING)
+    {
+        return;
+    }
+
+    InputSlot &slot = inputs.received[frame % INPUT_RING];
+    if (slot.known && slot.frame == frame)
+    {
+        return;
+    }
+    slot = InputSlot{frame, input, true};
+
+    if (frame < mFrame && !(inputs.used[frame % INPUT_RING] == input))
+    {
+        mRollbackFrame = std::min(mRollbackFrame, frame);
+    }
+
+    while (inputs.received[inputs.confirmed % INPUT_RING].known &&
+           inputs.received[inputs.confirmed % INPUT_RING].frame == inputs.confirmed)
+    {
+        inputs.last = inputs.received[inputs.confirmed % INPUT_RING].input;
+        ++inputs.confirmed;
+    }
+}
+
+void RollbackSession::simulate(std::uint32_t frame)
+{
+    for (std::size_t player = 0; player < mPlayerCount; ++player)
+    {
+        mFrameInputs[player] = inputFor(player, frame);
+        mPlayers[player].used[frame % INPUT_RING] = mFrameInputs[player];
+    }
+    mSimulation.advance(std::span<const RollbackInput>(mFrameInputs.data(), mPlayerCount));
+}
@@ -0,0 +1,139 @@
+#ifndef ROLLBACK_SESSION_HPP
+#define ROLLBACK_SESSION_HPP
+
+#include <SFML/Network/Packet.hpp>
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/// @brief One player's input for one fixed step, as it goes over the wire
+/// @details The planar distance asked for this step, before wall collisions, in 1/MOVE_UNITS
+/// world-unit steps.
+struct RollbackInput
+{
+    static constexpr float MOVE_UNITS = 8192.0f;
+
+    std::int16_t moveX{0};
+    std::int16_t moveZ{0};
+
+    [[nodiscard]] static RollbackInput quantize(const glm::vec2 &move) noexcept;
+    [[nodiscard]] glm::vec2 getMove() const noexcept;
+
+    bool operator==(const RollbackInput &) const = default;
+};
+
+/// @brief The game side of a rollback session: a deterministic fixed step plus state save slots
+class IRollbackSimulation
+{
+public:
+    virtual ~IRollbackSimulation() = default;
+
+    /// Save the state at the start of the current step into slot [0, RollbackSession::STATE_SLOTS)
+    virtual void saveState(std::size_t slot) = 0;
+    virtual void loadState(std::size_t slot) = 0;
+
+    /// No rollback will load a state older than the one in slot; history behind it can go
+    virtual void confirmState(std::size_t /*slot*/) {}
+
+    /// Advance one fixed step; inputs[i] is player i's. The same state and inputs must give the same result
+    virtual void advance(std::span<const RollbackInput> inputs) = 0;
+};
+
+/// @brief Input-based rollback networking over a fixed step
+/// @details Only inputs are exchanged. The local input is scheduled INPUT_DELAY frames ahead, which
+/// hides that much latency outright. Remote inputs that have not arrived are predicted by repeating
+/// the last one received. When a real input differs from what was predicted, the simulation loads
+/// the state saved at that frame and re-simulates up to the present with the corrected inputs.
+///
+/// The session runs at most MAX_PREDICTION frames past the oldest frame with an input still
+/// missing, and advanceFrame() stalls beyond that. So a rollback never needs a state older than the
+/// saved slots. Each packet also says how far every player's inputs have arrived here, and carries
+/// all local inputs some peer still lacks, so a lost datagram is covered by the next one and a peer
+/// that starts late still gets the first frames.
+class RollbackSession
+{
+public:
+    static constexpr std::size_t MAX_PLAYERS = 4;
+    static constexpr std::uint32_t INPUT_DELAY = 2;
+    static constexpr std::uint32_t MAX_PREDICTION = 12;
+    static constexpr std::size_t STATE_SLOTS = MAX_PREDICTION + 1;
+    /// Raster maze every peer of a rollback match builds, so their collision geometry agrees
+    static constexpr std::uint32_t MAZE_SEED = 0x5EEDB00Bu;
+
+    /// @param localPlayer Index of this peer's player; every peer must number players the same way
+    RollbackSession(IRollbackSimulation &simulation, std::size_t playerCount, std::size_t localPlayer) noexcept;
+
+    /// @brief Input for the frame INPUT_DELAY ahead of the current one; call once before each advanceFrame()
+    /// @details While stalled the frame does not move, and the first input given for it is kept
+    void setLocalInput(const RollbackInput &input) noexcept;
+
+    /// @brief Roll back to the oldest mispredicted frame if any, then simulate the current one
+    /// @return false while stalled waiting for remote inputs
+    bool advanceFrame();
+
+    /// @brief Append the local inputs some peer still lacks
+    /// @details [Uint8:players] players x [Uint32:confirmedFrame] [Uint32:firstFrame] [Uint8:count]
+    /// count x ([Int16:moveX] [Int16:moveZ]); confirmedFrame is how far that player's inputs arrived here
+    void writeLocalInputs(sf::Packet &packet) const;
+
+    /// @brief Take a remote player's inputs written by writeLocalInputs(); known and stale frames are skipped
+    bool readRemoteInputs(std::size_t player, sf::Packet &packet);
+
+    [[nodiscard]] std::size_t getPlayerCount() const noexcept { return mPlayerCount; }
+    [[nodiscard]] std::size_t getLocalPlayer() const noexcept { return mLocalPlayer; }
+    /// Next frame advanceFrame() simulates
+    [[nodiscard]] std::uint32_t getFrame() const noexcept { return mFrame; }
+    /// Frames before this have every player's real input
+    [[nodiscard]] std::uint32_t getConfirmedFrame() const noexcept;
+    [[nodiscard]] std::uint32_t getRollbackCount() const noexcept { return mRollbackCount; }
+    [[nodiscard]] std::uint32_t getResimulatedFrames() const noexcept { return mResimulatedFrames; }
+    [[nodiscard]] std::uint32_t getStallCount() const noexcept { return mStallCount; }
+
+private:
+    /// Enough for the prediction window plus a remote peer running that far ahead of us
+    static constexpr std::uint32_t INPUT_RING = 64;
+
+    struct InputSlot
+    {
+        std::uint32_t frame{0};
+        RollbackInput input;
+        bool known{false};
+    };
+
+    struct PlayerInputs
+    {
+        std::array<InputSlot, INPUT_RING> received{};
+        /// What advance() was given for each frame, real or predicted
+        std::array<RollbackInput, INPUT_RING> used{};
+        /// First frame whose input has not arrived; all earlier ones have
+        std::uint32_t confirmed{0};
+        /// How far this player says our local inputs have reached it
+        std::uint32_t acked{0};
+        RollbackInput last;
+    };
+
+    /// Real input for the frame if it arrived, else the prediction
+    [[nodiscard]] RollbackInput inputFor(std::size_t player, std::uint32_t frame) const noexcept;
+    void receive(std::size_t player, std::uint32_t frame, const RollbackInput &input) noexcept;
+    void simulate(std::uint32_t frame);
+
+    IRollbackSimulation &mSimulation;
+    std::size_t mPlayerCount;
+    std::size_t mLocalPlayer;
+    std::array<PlayerInputs, MAX_PLAYERS> mPlayers{};
+    std::array<RollbackInput, MAX_PLAYERS> mFrameInputs{};
+
+    std::uint32_t mFrame{0};
+    /// Oldest frame whose real input differed from the one simulated; mFrame when none did
+    std::uint32_t mRollbackFrame{0};
+    std::uint32_t mRollbackCount{0};
+    std::uint32_t mResimulatedFrames{0};
+    std::uint32_t mStallCount{0};
+    std::uint32_t mLastConfirmedState{0};
+};
+
+#endif // ROLLBACK_SESSION_HPP
@@ -1,8 +1,9 @@
 #include "SDLAudioStream.hpp"
 
 #include <SDL3/SDL.h>
-#include <cmath>
 #include <algorithm>
+#include <array>
+#include <cmath>
 
 // Extern declarations for Simplex noise functions from noise.c
 extern "C"
@@ -11,6 +12,39 @@ extern "C"
     float simplex3(float x, float y, float z, int octaves, float persistence, float lacunarity);
 }
 
+namespace
+{
+    // One sine turn; the guard entry lets interpolation read index + 1 without wrapping
+    constexpr std::uint32_t WAVETABLE_BITS = 11;
+    constexpr std::uint32_t WAVETABLE_SIZE = 1u << WAVETABLE_BITS;
+    constexpr std::uint32_t PHASE_FRACTION_BITS = 32 - WAVETABLE_BITS;
+
+    const std::array<float, WAVETABLE_SIZE + 1> &sineTable() noexcept
+    {
+        static const auto table = []
+        {
+            std::array<float, WAVETABLE_SIZE + 1> values{};
+            for (std::uint32_t i = 0; i <= WAVETABLE_SIZE; ++i)
+            {
+                values[i] = static_cast<float>(std::sin(6.283185307179586 * i / WAVETABLE_SIZE));
+            }
+            return values;
+        }();
+        return table;
+    }
+
+    /// Per-sample integer hash, so noise samples do not depend on each other and the loop vectorizes
+    inline std::uint32_t hashNoise(std::uint32_t x) noexcept
+    {
+        x ^= x >> 16;
+        x *= 0x7FEB352Du;
+        x ^= x >> 15;
+        x *= 0x846CA68Bu;
+        x ^= x >> 16;
+        return x;
+    }
+}
+
 SDLAudioStream::SDLAudioStream() = default;
 
 SDLAudioStream::~SDLAudioStream()
@@ -19,8 +53,9 @@ SDLAudioStream::~SDLAudioStream()
 }
 
 SDLAudioStream::SDLAudioStream(SDLAudioStream &&other) noexcept
-    : mStream(other.mStream), mSpec(other.mSpec), mCallback(std::move(other.mCallback)), mIsPlaying(other.mIsPlaying), mCurrentSineSample(other.mCurrentSineSample), mSineFrequency(other.mSineFrequency), mSineVolume(other.mSineVolume), mSineDuration(other.mSineDuration), mSineElapsed(other.mSineElapsed), mCurrentNoiseSample(other.mCurrentNoiseSample), mNoiseVolume(other.mNoiseVolume), mNoiseDuration(other.mNoiseDuration), mNoiseScale(other.mNoiseScale), mNoiseSeed(other.mNoiseSeed)
+    : mStream(other.mStream), mSpec(other.mSpec), mCallback(std::move(other.mCallback)), mIsPlaying(other.mIsPlaying)
 {
+    moveGeneratorFrom(other);
     other.mStream = nullptr;
     other.mIsPlaying = false;
 }
@@ -35,16 +70,7 @@ SDLAudioStream &SDLAudioStream::operator=(SDLAudioStream &&other) noexcept
         mSpec = other.mSpec;
         mCallback = std::move(other.mCallback);
         mIsPlaying = other.mIsPlaying;
-        mCurrentSineSample = other.mCurrentSineSample;
-        mSineFrequency = other.mSineFrequency;
-        mSineVolume = other.mSineVolume;
-        mSineDuration = other.mSineDuration;
-        mSineElapsed = other.mSineElapsed;
-        mCurrentNoiseSample = other.mCurrentNoiseSample;
-        mNoiseVolume = other.mNoiseVolume;
-        mNoiseDuration = other.mNoiseDuration;
-        mNoiseScale = other.mNoiseScale;
-        mNoiseSeed = other.mNoiseSeed;
+        moveGeneratorFrom(other);
 
         other.mStream = nullptr;
         other.mIsPlaying = false;
@@ -52,6 +78,24 @@ SDLAudioStream &SDLAudioStream::operator=(SDLAudioStream &&other) noexcept
     return *this;
 }
 
+void SDLAudioStream::moveGeneratorFrom(SDLAudioStream &other) noexcept
+{
+    // Atomics do not move; a stream is only moved while its callback is not running
+    mGenerator.store(other.mGenerator.load());
+    mFrequency.store(other.mFrequency.load());
+    mVolume.store(other.mVolume.load());
+    mDuration.store(other.mDuration.load());
+    mRestartRequest.store(other.mRestartRequest.load());
+    mRestartSeen = other.mRestartSeen;
+    mPhase = other.mPhase;
+    mFramesLeft = other.mFramesLeft;
+    mGain = other.mGain;
+    mNoiseCounter = other.mNoiseCounter;
+    mNoiseSeed = other.mNoiseSeed;
+    mBlock = std::move(other.mBlock);
+    mInterleaved = std::move(other.mInterleaved);
+}
+
 bool SDLAudioStream::initialize(int freq, int channels, AudioCallback callback)
 {
     // Store the spec first (needed for generateSineWave if callback is nullptr)
@@ -60,17 +104,22 @@ bool SDLAudioStream::initialize(int freq, int channels, AudioCallback callback)
     mSpec.channels = channels;
 
     // If no callback provided, check if we have one from generateSineWave()
-    if (!callback && !mCallback)
+    if (!callback && !mCallback && mGenerator.load(std::memory_order_relaxed) == Generator::CALLBACK)
     {
         SDL_LogError(SDL_LOG_CATEGORY_AUDIO, "SDLAudioStream: No audio callback provided");
         return false;
     }
 
-    // Use provided callback or keep existing one (from generateSineWave)
+    // Use provided callback or keep the generator set up by generateSineWave() / generateWhiteNoise()
     if (callback)
     {
         mCallback = callback;
+        mGenerator.store(Generator::CALLBACK, std::memory_order_release);
     }
+    // Generator scratch space, so the audio callback never allocates
+    mBlock.assign(BLOCK_FRAMES, 0.0f);
+    mInterleaved.assign(static_cast<std::size_t>(BLOCK_FRAMES) * static_cast<std::size_t>(std::max(1, channels)), 0.0f);
+
     // Open the audio device stream (combines device opening + stream creation + binding)
     // This is the modern SDL3 API as shown in the official example
     mStream = SDL_OpenAudioDeviceStream(
@@ -148,141 +197,162 @@ void SDLAudioStream::stop()
 void SDLCALL SDLAudioStream::sdlAudioCallbackWrapper(void *userdata, SDL_AudioStream *stream, int additional_amount, int total_amount)
 {
     auto *audioStream = static_cast<SDLAudioStream *>(userdata);
-    if (!audioStream || !audioStream->mCallback)
+    if (!audioStream)
     {
         return;
     }
 
-    // Call the user callback with the SDL3 signature
-    audioStream->mCallback(stream, additional_amount, total_amount);
+    if (audioStream->mGenerator.load(std::memory_order_acquire) != Generator::CALLBACK)
+    {
+        audioStream->renderGenerator(stream, additional_amount);
+        return;
+    }
+
+    if (audioStream->mCallback)
+    {
+        // Call the user callback with the SDL3 signature
+        audioStream->mCallback(stream, additional_amount, total_amount);
+    }
 }
 
 void SDLAudioStream::generateSineWave(float frequency, float duration, float volume)
 {
-    mSineFrequency = frequency;
-    mSineDuration = duration;
-    mSineVolume = std::clamp(volume, 0.0f, 1.0f);
-    mCurrentSineSample = 0;
-    mSineElapsed = 0.0f;
+    // Build the table here rather than on the audio thread's first block
+    sineTable();
+
+    mFrequency.store(std::max(0.0f, frequency), std::memory_order_relaxed);
+    mDuration.store(duration, std::memory_order_relaxed);
+    mVolume.store(std::clamp(volume, 0.0f, 1.0f), std::memory_order_relaxed);
+    mGenerator.store(Generator::SINE, std::memory_order_relaxed);
+    mRestartRequest.fetch_add(1, std::memory_order_release);
 
     SDL_Log("SDLAudioStream: Configuring sine wave - %.2f Hz, %.2f seconds, %.2f%% volume",
             frequency, duration, volume * 100.0f);
+}
 
-    // Set up callback to generate sine wave (following the official SDL3 example pattern)
-    // Note: mSpec.freq might not be set yet if this is called before initialize()
-    mCallback = [this](SDL_AudioStream *stream, int additional_amount, int total_amount)
-    {
-        // Use mSpec.freq which will be set by initialize()
-        const int sample_rate = mSpec.freq;
-
-        // Convert from bytes to samples (each sample is a float)
-        additional_amount /= sizeof(float);
-
-        while (additional_amount > 0)
-        {
-            // Feed 128 samples at a time (matches official example)
-            float samples[128];
-            const int total = SDL_min(additional_amount, static_cast<int>(SDL_arraysize(samples)));
-
-            // Calculate how many samples we've generated in total
-            const float total_seconds = static_cast<float>(mCurrentSineSample) / static_cast<float>(sample_rate);
-
-            // Generate the sine wave samples
-            for (int i = 0; i < total; i++)
-            {
-                // Check if we've exceeded the duration
-                if (total_seconds + (static_cast<float>(i) / static_cast<float>(sample_rate)) >= mSineDuration)
-                {
-                    // Fill rest with silence
-                    for (int j = i; j < total; j++)
-                    {
-                        samples[j] = 0.0f;
-                    }
-                    break;
-                }
-
-                // Generate sine wave (following official example pattern)
-                const float phase = static_cast<float>(mCurrentSineSample + i) * mSineFrequency / static_cast<float>(sample_rate);
-                samples[i] = SDL_sinf(phase * 2.0f * SDL_PI_F) * mSineVolume;
-            }
+void SDLAudioStream::generateWhiteNoise(float duration, float volume, float scale)
+{
+    static_cast<void>(scale); // Reserved for future shaping filters
 
-            mCurrentSineSample += total;
+    mDuration.store(duration, std::memory_order_relaxed);
+    mVolume.store(std::clamp(volume, 0.0f, 1.0f), std::memory_order_relaxed);
+    mGenerator.store(Generator::NOISE, std::memory_order_relaxed);
+    mRestartRequest.fetch_add(1, std::memory_order_release);
+}
 
-            // Wrap around to avoid floating-point errors (following official example)
-            mCurrentSineSample %= sample_rate;
+void SDLAudioStream::setVolume(float volume) noexcept
+{
+    mVolume.store(std::clamp(volume, 0.0f, 1.0f), std::memory_order_relaxed);
+}
 
-            // Feed the new data to the stream
-            SDL_PutAudioStreamData(stream, samples, total * sizeof(float));
-            additional_amount -= total;
-        }
-    };
+void SDLAudioStream::setFrequency(float frequency) noexcept
+{
+    mFrequency.store(std::max(0.0f, frequency), std::memory_order_relaxed);
 }
 
-void SDLAudioStream::generateWhiteNoise(float duration, float volume, float scale)
+void SDLAudioStream::renderGenerator(SDL_AudioStream *stream, int additionalBytes) noexcept
 {
-    mNoiseVolume = std::clamp(volume, 0.0f, 1.0f);
-    mNoiseDuration = duration;
-    mNoiseScale = std::max(0.1f, scale); // Reserved for future shaping filters
-    mCurrentNoiseSample = 0;
-    if (mNoiseSeed == 0u)
+    const int channels = std::max(1, mSpec.channels);
+    const float sampleRate = static_cast<float>(std::max(1, mSpec.freq));
+    if (mBlock.empty())
     {
-        mNoiseSeed = 0xA341316Cu;
+        return;
     }
 
-    // Set up callback to generate white noise using Simplex noise
-    mCallback = [this](SDL_AudioStream *stream, int additional_amount, int total_amount)
+    // Parameters are sampled once per callback, so every block is computed from one consistent set
+    if (const auto request = mRestartRequest.load(std::memory_order_acquire); request != mRestartSeen)
     {
-        const int sample_rate = mSpec.freq;
-
-        // Convert from bytes to samples (each sample is a float)
-        additional_amount /= sizeof(float);
+        mRestartSeen = request;
+        mPhase = 0;
+        mNoiseCounter = 0;
+        mGain = 0.0f;
+        const float duration = mDuration.load(std::memory_order_relaxed);
+        mFramesLeft = duration > 0.0f ? static_cast<std::int64_t>(duration * sampleRate) : -1;
+    }
+    const Generator generator = mGenerator.load(std::memory_order_relaxed);
+    const float volume = mVolume.load(std::memory_order_relaxed);
+    // Turns per frame in 32-bit fixed point; frequencies past Nyquist alias, as they would anyway
+    const auto increment = static_cast<std::uint32_t>(
+        std::min(static_cast<double>(mFrequency.load(std::memory_order_relaxed)) / sampleRate, 0.5) * 4294967296.0);
+
+    int framesNeeded = additionalBytes / static_cast<int>(sizeof(float)) / channels;
+    while (framesNeeded > 0)
+    {
+        const int frames = std::min(framesNeeded, BLOCK_FRAMES);
+        const int audible = mFramesLeft < 0 ? frames : static_cast<int>(std::min<std::int64_t>(frames, mFramesLeft));
+        float *block = mBlock.data();
 
-        while (additional_amount > 0)
+        if (generator == Generator::SINE)
         {
-            // Feed 128 samples at a time
-            float samples[128];
-            const int total = SDL_min(additional_amount, static_cast<int>(SDL_arraysize(samples)));
+            fillSine(block, audible, increment);
+        }
+        else
+        {
+            fillNoise(block, audible);
+        }
+        std::fill(block + audible, block + frames, 0.0f);
+        if (mFramesLeft > 0)
+        {
+            mFramesLeft -= audible;
+        }
 
-            // Calculate current time in seconds
-            const float current_time = static_cast<float>(mCurrentNoiseSample) / static_cast<float>(sample_rate);
+        // Ramp to the target volume across the block so a change never steps
+        const float target = volume;
+        const float step = (target - mGain) / static_cast<float>(frames);
+        const float start = mGain;
+        for (int i = 0; i < frames; ++i)
+        {
+            block[i] *= start + step * static_cast<float>(i + 1);
+        }
+        mGain = target;
 
-            // Generate white noise samples using Simplex noise
-            for (int i = 0; i < total; i++)
+        if (channels == 1)
+        {
+            SDL_PutAudioStreamData(stream, block, frames * static_cast<int>(sizeof(float)));
+        }
+        else
+        {
+            float *interleaved = mInterleaved.data();
+            for (int i = 0; i < frames; ++i)
             {
-                // duration <= 0 means continuous noise (no cutoff)
-                if (mNoiseDuration > 0.0f)
+                for (int c = 0; c < channels; ++c)
                 {
-                    // Check if we've exceeded the duration
-                    const float sample_time = current_time + (static_cast<float>(i) / static_cast<float>(sample_rate));
-                    if (sample_time >= mNoiseDuration)
-                    {
-                        // Fill rest with silence
-                        for (int j = i; j < total; j++)
-                        {
-                            samples[j] = 0.0f;
-                        }
-                        break;
-                    }
+                    interleaved[i * channels + c] = block[i];
                 }
-
-                // Fast LCG PRNG, mapped to [-1, 1] for true white noise
-                mNoiseSeed = (1664525u * mNoiseSeed) + 1013904223u;
-                const float unit = static_cast<float>((mNoiseSeed >> 8) & 0x00FFFFFFu) / 16777215.0f;
-                const float noise_value = (unit * 2.0f) - 1.0f;
-                samples[i] = noise_value * mNoiseVolume;
             }
+            SDL_PutAudioStreamData(stream, interleaved, frames * channels * static_cast<int>(sizeof(float)));
+        }
+        framesNeeded -= frames;
+    }
+}
 
-            mCurrentNoiseSample += total;
+void SDLAudioStream::fillSine(float *frames, int count, std::uint32_t increment) noexcept
+{
+    const auto &table = sineTable();
+    constexpr float fractionScale = 1.0f / static_cast<float>(1u << PHASE_FRACTION_BITS);
+    const std::uint32_t phase = mPhase;
 
-            // Wrap around to avoid integer overflow
-            if (mCurrentNoiseSample > sample_rate * 10)
-            {
-                mCurrentNoiseSample = 0;
-            }
+    // Each frame's phase comes straight from its index, so there is no serial dependency between them
+    for (int i = 0; i < count; ++i)
+    {
+        const std::uint32_t p = phase + increment * static_cast<std::uint32_t>(i);
+        const std::uint32_t index = p >> PHASE_FRACTION_BITS;
+        const float fraction = static_cast<float>(p & ((1u << PHASE_FRACTION_BITS) - 1u)) * fractionScale;
+        frames[i] = table[index] + (table[index + 1] - table[index]) * fraction;
+    }
+    mPhase = phase + increment * static_cast<std::uint32_t>(count);
+}
 
-            // Feed the new data to the stream
-            SDL_PutAudioStreamData(stream, samples, total * sizeof(float));
-            additional_amount -= total;
-        }
-    };
+void SDLAudioStream::fillNoise(float *frames, int count) noexcept
+{
+    constexpr float unitScale = 2.0f / 16777215.0f;
+    const std::uint32_t base = mNoiseSeed + mNoiseCounter;
+
+    for (int i = 0; i < count; ++i)
+    {
+        // Top 24 bits mapped to [-1, 1] for true white noise
+        const std::uint32_t bits = hashNoise(base + static_cast<std::uint32_t>(i)) >> 8;
+        frames[i] = static_cast<float>(bits) * unitScale - 1.0f;
+    }
+    mNoiseCounter += static_cast<std::uint32_t>(count);
 }
@@ -3,6 +3,7 @@
 
 #include <SDL3/SDL.h>
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -11,6 +12,10 @@
 /// @brief SDL3 audio streaming wrapper for procedural audio and real-time effects
 /// @details This class provides a modern C++ wrapper around SDL3's audio streaming API.
 /// It can be used alongside SFML audio for scenarios requiring real-time audio processing.
+///
+/// The built-in sine and noise generators run without std::function or locks: the game thread
+/// publishes their parameters through atomics, and the audio thread reads them once per block.
+/// Volume and frequency changes are ramped across a block so they never click.
 class SDLAudioStream final
 {
 public:
@@ -66,34 +71,63 @@ public:
     /// @param volume Volume (0.0 to 1.0)
     void generateSineWave(float frequency, float duration, float volume = 0.5f);
 
-    /// @brief Generate white noise using Simplex noise (procedural)
-    /// @param duration Duration in seconds
+    /// @brief Generate white noise
+    /// @param duration Duration in seconds; 0 or less plays until paused
     /// @param volume Volume (0.0 to 1.0)
-    /// @param scale Noise scale/frequency (higher = more variation)
+    /// @param scale Noise scale/frequency (reserved for shaping filters)
     void generateWhiteNoise(float duration, float volume = 0.5f, float scale = 1.0f);
 
+    /// @brief Change the generator's volume while it plays, without restarting it
+    void setVolume(float volume) noexcept;
+
+    /// @brief Change the sine generator's frequency while it plays, keeping its phase
+    void setFrequency(float frequency) noexcept;
+
 private:
+    enum class Generator : std::uint8_t
+    {
+        CALLBACK,
+        SINE,
+        NOISE
+    };
+
+    /// Frames generated per SDL_PutAudioStreamData call
+    static constexpr int BLOCK_FRAMES = 1024;
+
     /// @brief Internal SDL audio callback (static wrapper)
     static void SDLCALL sdlAudioCallbackWrapper(void *userdata, SDL_AudioStream *stream, int additional_amount, int total_amount);
 
+    /// @brief Feed a built-in generator's output; runs on the audio thread
+    void renderGenerator(SDL_AudioStream *stream, int additionalBytes) noexcept;
+    void fillSine(float *frames, int count, std::uint32_t increment) noexcept;
+    void fillNoise(float *frames, int count) noexcept;
+    void moveGeneratorFrom(SDLAudioStream &other) noexcept;
+
     SDL_AudioStream *mStream{nullptr};
     SDL_AudioSpec mSpec{};
     AudioCallback mCallback;
     bool mIsPlaying{false};
 
-    // For sine wave generation (example/testing)
-    int mCurrentSineSample{0};
-    float mSineFrequency{440.0f};
-    float mSineVolume{0.5f};
-    float mSineDuration{0.0f};
-    float mSineElapsed{0.0f};
-
-    // For white noise generation
-    int mCurrentNoiseSample{0};
-    float mNoiseVolume{0.5f};
-    float mNoiseDuration{0.0f};
-    float mNoiseScale{1.0f};
+    // Written by the game thread, read once per block by the audio thread
+    std::atomic<Generator> mGenerator{Generator::CALLBACK};
+    std::atomic<float> mFrequency{440.0f};
+    std::atomic<float> mVolume{0.5f};
+    std::atomic<float> mDuration{0.0f};
+    /// Bumped after the fields above are set for a new sound; the audio thread then starts over
+    std::atomic<std::uint32_t> mRestartRequest{0};
+
+    // Audio thread only
+    std::uint32_t mRestartSeen{0};
+    /// Sine phase as a fraction of a turn in 32-bit fixed point, so it wraps for free
+    std::uint32_t mPhase{0};
+    /// Frames until the sound ends; negative plays forever
+    std::int64_t mFramesLeft{-1};
+    float mGain{0.0f};
+    std::uint32_t mNoiseCounter{0};
     std::uint32_t mNoiseSeed{0xA341316Cu};
+    /// Mono block and its interleaved copy, sized in initialize() so the callback never allocates
+    std::vector<float> mBlock;
+    std::vector<float> mInterleaved;
 };
 
 #endif // SDL_AUDIO_STREAM_HPP
@@ -0,0 +1,95 @@
+#include "SendRateController.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr float kLossThresholdPercent = 5.0f;
+    /// Round trip this far above the best seen means queues are building
+    constexpr float kRttInflation = 1.5f;
+    constexpr float kRttSlackMs = 30.0f;
+    /// Round trip rising this much within one window
+    constexpr float kRttGrowthMs = 40.0f;
+    constexpr float kBackoffFactor = 1.5f;
+    constexpr float kRecoveryStep = 0.25f;
+    /// Lets the best round trip drift up after a route change instead of reading congestion forever
+    constexpr float kBaseRttDrift = 0.05f;
+
+    float facingDelta(float a, float b) noexcept
+    {
+        return std::abs(std::fmod(a - b + 540.0f, 360.0f) - 180.0f);
+    }
+} // namespace
+
+float SendRateController::getInterval(const glm::vec3 &position, float facingDegrees,
+                                      const PlayerSnapshot &snapshot) const noexcept
+{
+    if (!mHasSent)
+    {
+        return 0.0f;
+    }
+
+    // Moving/stopping, jumps and other animation changes are visible at once on the remote side
+    if (snapshot.flags != mSentSnapshot.flags || facingDelta(facingDegrees, mSentFacing) >= SHARP_TURN_DEGREES)
+    {
+        return BURST_INTERVAL;
+    }
+
+    const glm::vec2 travelled{position.x - mSentPosition.x, position.z - mSentPosition.z};
+    const float distance = glm::length(travelled);
+    if (distance < POSITION_THRESHOLD && std::abs(position.y - mSentPosition.y) < POSITION_THRESHOLD &&
+        facingDelta(facingDegrees, mSentFacing) < FACING_THRESHOLD_DEGREES)
+    {
+        return IDLE_INTERVAL;
+    }
+
+    if (glm::length(mSentDirection) > 0.0f && distance >= POSITION_THRESHOLD)
+    {
+        const float cosine = glm::dot(travelled / distance, mSentDirection);
+        if (cosine < std::cos(glm::radians(SHARP_TURN_DEGREES)))
+        {
+            return BURST_INTERVAL;
+        }
+    }
+
+    return ACTIVE_INTERVAL;
+}
+
+void SendRateController::onSent(const glm::vec3 &position, float facingDegrees, const PlayerSnapshot &snapshot) noexcept
+{
+    const glm::vec2 travelled{position.x - mSentPosition.x, position.z - mSentPosition.z};
+    const float distance = glm::length(travelled);
+    mSentDirection = (mHasSent && distance >= POSITION_THRESHOLD) ? travelled / distance : glm::vec2{0.0f};
+    mSentPosition = position;
+    mSentFacing = facingDegrees;
+    mSentSnapshot = snapshot;
+    mHasSent = true;
+}
+
+void SendRateController::updateCongestion(Congestion &congestion, const NetStats::PeerStats &stats) noexcept
+{
+    bool congested = stats.lossPercent > kLossThresholdPercent;
+
+    if (stats.hasRtt)
+    {
+        if (!congestion.hasRtt)
+        {
+            congestion.baseRttMs = stats.rttMs;
+            congestion.lastRttMs = stats.rttMs;
+            congestion.hasRtt = true;
+        }
+
+        congested = congested ||
+                    stats.rttMs > congestion.baseRttMs * kRttInflation + kRttSlackMs ||
+                    stats.rttMs - congestion.lastRttMs > kRttGrowthMs;
+
+        congestion.baseRttMs = stats.rttMs < congestion.baseRttMs
+                                   ? stats.rttMs
+                                   : congestion.baseRttMs + (stats.rttMs - congestion.baseRttMs) * kBaseRttDrift;
+        congestion.lastRttMs = stats.rttMs;
+    }
+
+    congestion.scale = congested ? std::min(congestion.scale * kBackoffFactor, MAX_CONGESTION_SCALE)
+                                 : std::max(congestion.scale - kRecoveryStep, 1.0f);
+}
@@ -0,0 +1,60 @@
+#ifndef SEND_RATE_CONTROLLER_HPP
+#define SEND_RATE_CONTROLLER_HPP
+
+#include "NetStats.hpp"
+#include "PlayerSnapshot.hpp"
+
+#include <glm/glm.hpp>
+
+/// @brief Picks how long to wait between position snapshots, and how much slower each peer gets them
+/// @details The interval follows the local player: a heartbeat while nothing changed beyond the
+/// quantization threshold, the steady rate while moving, and a burst rate right after a sharp turn,
+/// a jump or any other animation change, so remote interpolation does not cut the corner.
+///
+/// Each peer also carries a congestion scale on top of that interval: it grows multiplicatively when
+/// the published NetStats show loss, a round trip well above the best one seen, or a round trip
+/// rising quickly, and shrinks back slowly while the path is healthy (AIMD, like TCP).
+class SendRateController
+{
+public:
+    /// Right after a sharp turn or a state change
+    static constexpr float BURST_INTERVAL = 0.05f;
+    /// Moving in a steady direction
+    static constexpr float ACTIVE_INTERVAL = 0.25f;
+    /// Nothing changed; still sent so remote players do not go stale
+    static constexpr float IDLE_INTERVAL = 1.0f;
+
+    static constexpr float SHARP_TURN_DEGREES = 25.0f;
+    /// Changes below these count as standing still
+    static constexpr float POSITION_THRESHOLD = 0.05f;
+    static constexpr float FACING_THRESHOLD_DEGREES = 2.0f;
+
+    static constexpr float MAX_CONGESTION_SCALE = 4.0f;
+
+    struct Congestion
+    {
+        float scale{1.0f};
+        float baseRttMs{0.0f};
+        float lastRttMs{0.0f};
+        bool hasRtt{false};
+    };
+
+    /// @brief Seconds to wait after the last sent snapshot before sending this state
+    [[nodiscard]] float getInterval(const glm::vec3 &position, float facingDegrees,
+                                    const PlayerSnapshot &snapshot) const noexcept;
+
+    void onSent(const glm::vec3 &position, float facingDegrees, const PlayerSnapshot &snapshot) noexcept;
+
+    /// @brief Fold one published stats window into a peer's congestion scale
+    static void updateCongestion(Congestion &congestion, const NetStats::PeerStats &stats) noexcept;
+
+private:
+    glm::vec3 mSentPosition{0.0f};
+    /// Unit XZ direction of travel between the last two sends; zero when there was none
+    glm::vec2 mSentDirection{0.0f};
+    float mSentFacing{0.0f};
+    PlayerSnapshot mSentSnapshot;
+    bool mHasSent{false};
+};
+
+#endif // SEND_RATE_CONTROLLER_HPP
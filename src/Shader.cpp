@@ -1,36 +1,65 @@
 #include "Shader.hpp"
 
+#include "AssetPack.hpp"
+#include "GLStateCache.hpp"
+#include "ProgramBinaryCache.hpp"
+#include "RenderStats.hpp"
+
 #include <SDL3/SDL_log.h>
+#include <SDL3/SDL_video.h>
 
-#include <cstring>
+#include <algorithm>
 #include <fstream>
 #include <sstream>
-#include <unordered_set>
 
 #include <glm/gtc/type_ptr.hpp>
 
 using ShaderType = Shader::ShaderType;
 
+namespace
+{
+    // From GL_KHR_parallel_shader_compile; the bundled glad loader predates the extension
+    constexpr GLenum kCompletionStatusKHR = 0x91B1;
+
+    /// Stage or include source from the mounted asset pack, else from the loose file
+    bool readShaderFile(const std::string &filename, std::string &out)
+    {
+        if (const auto packed = AssetPack::find(filename); !packed.empty())
+        {
+            out.assign(reinterpret_cast<const char *>(packed.data()), packed.size());
+            return true;
+        }
+
+        std::ifstream shaderFileStream;
+        shaderFileStream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+        try
+        {
+            shaderFileStream.open(filename);
+            std::stringstream shaderStrStream;
+            shaderStrStream << shaderFileStream.rdbuf();
+            out = shaderStrStream.str();
+            return true;
+        }
+        catch (const std::ifstream::failure &)
+        {
+            return false;
+        }
+    }
+}
+
+bool Shader::sParallelCompile = false;
+
 void Shader::compileAndAttachShader(ShaderType shaderType, const std::string &filename)
 {
     createProgram();
 
     std::string shaderCode = "";
-    std::ifstream shaderFileStream;
-    shaderFileStream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    try
-    {
-        shaderFileStream.open(filename);
-        std::stringstream shaderStrStream;
-        shaderStrStream << shaderFileStream.rdbuf();
-        shaderFileStream.close();
-        shaderCode = shaderStrStream.str();
-    }
-    catch (const std::ifstream::failure &e)
+    if (!readShaderFile(filename, shaderCode))
     {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: %s", filename.c_str());
         return;
     }
+    mSourceFiles.push_back(filename);
 
     // Resolve #include directives relative to the shader file's directory
     std::string directory;
@@ -40,13 +69,7 @@ void Shader::compileAndAttachShader(ShaderType shaderType, const std::string &fi
     shaderCode = resolveIncludes(shaderCode, directory);
 
     mFileNames.emplace(shaderType, filename);
-    GLuint shaderId = compile(shaderType, shaderCode);
-
-    if (shaderId != 0)
-    {
-        attach(shaderId);
-        deleteShader(shaderId);
-    }
+    mPendingSources.emplace_back(shaderType, std::move(shaderCode));
 }
 
 void Shader::compileAndAttachShader(ShaderType shaderType, const std::string &codeId, const GLchar *code)
@@ -54,13 +77,7 @@ void Shader::compileAndAttachShader(ShaderType shaderType, const std::string &co
     createProgram();
 
     mFileNames.emplace(shaderType, codeId);
-    GLuint shaderId = compile(shaderType, code);
-
-    if (shaderId != 0)
-    {
-        attach(shaderId);
-        deleteShader(shaderId);
-    }
+    mPendingSources.emplace_back(shaderType, std::string(code ? code : ""));
 }
 
 void Shader::recompileWithDefines(const std::string &defines)
@@ -70,32 +87,27 @@ void Shader::recompileWithDefines(const std::string &defines)
     // Tear down old program
     if (mProgram)
     {
+        GLStateCache::forgetProgram(mProgram);
         glDeleteProgram(mProgram);
         mProgram = 0;
     }
     mGLSLLocations.clear();
     mFileNames.clear();
+    mSourceFiles.clear();
+    mPendingSources.clear();
+    mDefines = defines;
 
     for (const auto &[type, filename] : savedFiles)
     {
         createProgram();
 
         std::string shaderCode;
-        std::ifstream shaderFileStream;
-        shaderFileStream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-        try
-        {
-            shaderFileStream.open(filename);
-            std::stringstream ss;
-            ss << shaderFileStream.rdbuf();
-            shaderFileStream.close();
-            shaderCode = ss.str();
-        }
-        catch (const std::ifstream::failure &e)
+        if (!readShaderFile(filename, shaderCode))
         {
             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "ERROR::SHADER::RECOMPILE_READ: %s", filename.c_str());
             continue;
         }
+        mSourceFiles.push_back(filename);
 
         // Resolve includes
         std::string directory;
@@ -116,40 +128,200 @@ void Shader::recompileWithDefines(const std::string &defines)
         }
 
         mFileNames.emplace(type, filename);
-        GLuint shaderId = compile(type, shaderCode);
-        if (shaderId != 0)
-        {
-            attach(shaderId);
-            deleteShader(shaderId);
-        }
+        mPendingSources.emplace_back(type, std::move(shaderCode));
     }
 
     linkProgram();
 }
 
+bool Shader::reload()
+{
+    Shader rebuilt;
+    rebuilt.mFileNames = mFileNames;
+    rebuilt.recompileWithDefines(mDefines);
+
+    // A stage that failed to read is skipped by recompileWithDefines, which could still link
+    if (rebuilt.mFileNames.size() != mFileNames.size() || !rebuilt.isLinked())
+    {
+        rebuilt.cleanUp();
+        return false;
+    }
+
+    if (mProgram)
+    {
+        deleteProgram(mProgram);
+    }
+    mProgram = std::exchange(rebuilt.mProgram, 0);
+    mSourceFiles = std::move(rebuilt.mSourceFiles);
+
+    // Same slots, locations from the new program
+    cacheActiveUniforms();
+    for (std::size_t slot = 0; slot < mHandleNames.size(); ++slot)
+    {
+        mHandleLocations[slot] = getUniformLocation(mHandleNames[slot]);
+    }
+    return true;
+}
+
+Shader::Ptr Shader::createVariant(const std::string &defines) const
+{
+    auto variant = std::make_unique<Shader>();
+    variant->mFileNames = mFileNames;
+    variant->recompileWithDefines(defines);
+    return variant;
+}
+
 void Shader::linkProgram()
 {
-    glLinkProgram(mProgram);
+    submitLink();
+    finishLink();
+}
+
+void Shader::submitLink()
+{
+    createProgram();
+
+    // The key covers every stage's final text, so changed sources, includes or defines all miss
+    mLinkSourceHash = ProgramBinaryCache::hash(std::string_view{});
+    mLinkFromCache = false;
+    mLinkCacheable = !mPendingSources.empty() && ProgramBinaryCache::isOpen();
+    if (!mPendingSources.empty())
+    {
+        for (const auto &[type, code] : mPendingSources)
+        {
+            const char stage = static_cast<char>(type);
+            mLinkSourceHash = ProgramBinaryCache::hash(std::string_view{&stage, 1}, mLinkSourceHash);
+            mLinkSourceHash = ProgramBinaryCache::hash(code, mLinkSourceHash);
+        }
+
+        mLinkFromCache = mLinkCacheable && ProgramBinaryCache::load(static_cast<GLuint>(mProgram), mLinkSourceHash);
+        if (!mLinkFromCache)
+        {
+            for (const auto &[type, code] : mPendingSources)
+            {
+                const GLuint shaderId = compile(type, code);
+                attach(shaderId);
+                mCompiledShaders.emplace_back(type, shaderId);
+            }
+
+            if (mLinkCacheable)
+            {
+                glProgramParameteri(mProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+            }
+        }
+        mPendingSources.clear();
+    }
+
+    if (!mLinkFromCache)
+    {
+        glLinkProgram(mProgram);
+    }
+    mLinkPending = true;
+}
+
+bool Shader::isLinkComplete() const
+{
+    if (!mLinkPending || !sParallelCompile)
+    {
+        return true;
+    }
+
+    GLint complete = GL_TRUE;
+    glGetProgramiv(mProgram, kCompletionStatusKHR, &complete);
+    return complete != GL_FALSE;
+}
+
+void Shader::finishLink()
+{
+    if (!mLinkPending)
+    {
+        return;
+    }
+    mLinkPending = false;
 
     GLint success;
     GLchar infoLog[512];
 
     glGetProgramiv(mProgram, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        // Compile status is only read here so a parallel-compiling driver never blocks in submitLink()
+        for (const auto &[type, shaderId] : mCompiledShaders)
+        {
+            GLint compiled = GL_FALSE;
+            glGetShaderiv(shaderId, GL_COMPILE_STATUS, &compiled);
+            if (!compiled)
+            {
+                glGetShaderInfoLog(shaderId, 512, nullptr, infoLog);
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s -- Shader Compilation Failed: %s", mFileNames.at(type).c_str(), infoLog);
+            }
+        }
+    }
+
+    for (const auto &[type, shaderId] : mCompiledShaders)
+    {
+        deleteShader(shaderId);
+    }
+    mCompiledShaders.clear();
+
     if (!success)
     {
         glGetProgramInfoLog(mProgram, 512, nullptr, infoLog);
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Program link failed: %s\n", infoLog);
+        mGLSLLocations.clear();
+        std::fill(mHandleLocations.begin(), mHandleLocations.end(), -1);
+        return;
+    }
+
+    if (mLinkCacheable && !mLinkFromCache)
+    {
+        ProgramBinaryCache::store(static_cast<GLuint>(mProgram), mLinkSourceHash);
+    }
+
+    // Locations change with every link: rebuild the name cache and re-resolve existing handles
+    cacheActiveUniforms();
+    for (std::size_t slot = 0; slot < mHandleNames.size(); ++slot)
+    {
+        mHandleLocations[slot] = getUniformLocation(mHandleNames[slot]);
+    }
+}
+
+bool Shader::enableParallelCompile() noexcept
+{
+    sParallelCompile = false;
+
+    using MaxShaderCompilerThreadsProc = void(APIENTRYP)(GLuint count);
+    MaxShaderCompilerThreadsProc maxThreads = nullptr;
+    if (SDL_GL_ExtensionSupported("GL_KHR_parallel_shader_compile"))
+    {
+        maxThreads = reinterpret_cast<MaxShaderCompilerThreadsProc>(SDL_GL_GetProcAddress("glMaxShaderCompilerThreadsKHR"));
+    }
+    else if (SDL_GL_ExtensionSupported("GL_ARB_parallel_shader_compile"))
+    {
+        maxThreads = reinterpret_cast<MaxShaderCompilerThreadsProc>(SDL_GL_GetProcAddress("glMaxShaderCompilerThreadsARB"));
+    }
+
+    if (!maxThreads)
+    {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Shader: parallel shader compile unavailable, links block");
+        return false;
     }
+
+    // 0xFFFFFFFF lets the driver pick its own thread count
+    maxThreads(0xFFFFFFFFu);
+    sParallelCompile = true;
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Shader: parallel shader compile enabled");
+    return true;
 }
 
 void Shader::bind() const
 {
-    glUseProgram(mProgram);
+    GLStateCache::useProgram(mProgram);
 }
 
 void Shader::release() const
 {
-    glUseProgram(0);
+    GLStateCache::useProgram(0);
 }
 
 void Shader::cleanUp()
@@ -158,8 +330,17 @@ void Shader::cleanUp()
     {
         deleteProgram(mProgram);
     }
+    for (const auto &[type, shaderId] : mCompiledShaders)
+    {
+        deleteShader(shaderId);
+    }
+    mCompiledShaders.clear();
+    mLinkPending = false;
     mGLSLLocations.clear();
     mFileNames.clear();
+    mSourceFiles.clear();
+    mPendingSources.clear();
+    std::fill(mHandleLocations.begin(), mHandleLocations.end(), -1);
 }
 
 std::string Shader::getGLSLUniforms() const
@@ -216,39 +397,132 @@ std::string Shader::getGLSLAttribs() const
     return retString;
 }
 
+Shader::UniformHandle Shader::getUniformHandle(const std::string &name)
+{
+    for (std::uint32_t slot = 0; slot < static_cast<std::uint32_t>(mHandleNames.size()); ++slot)
+    {
+        if (mHandleNames[slot] == name)
+        {
+            return UniformHandle{slot};
+        }
+    }
+
+    mHandleNames.push_back(name);
+    mHandleLocations.push_back(isLinked() ? getUniformLocation(name) : -1);
+    return UniformHandle{static_cast<std::uint32_t>(mHandleNames.size() - 1)};
+}
+
+void Shader::setUniform(UniformHandle handle, const glm::mat3 &matrix) const noexcept
+{
+    glUniformMatrix3fv(getHandleLocation(handle), 1, GL_FALSE, glm::value_ptr(matrix));
+    RenderStats::countUniformUpload();
+}
+
+void Shader::setUniform(UniformHandle handle, const glm::mat4 &matrix) const noexcept
+{
+    glUniformMatrix4fv(getHandleLocation(handle), 1, GL_FALSE, glm::value_ptr(matrix));
+    RenderStats::countUniformUpload();
+}
+
+void Shader::setUniform(UniformHandle handle, const glm::vec2 &vec) const noexcept
+{
+    glUniform2f(getHandleLocation(handle), vec.x, vec.y);
+    RenderStats::countUniformUpload();
+}
+
+void Shader::setUniform(UniformHandle handle, const glm::ivec2 &vec) const noexcept
+{
+    glUniform2i(getHandleLocation(handle), vec.x, vec.y);
+    RenderStats::countUniformUpload();
+}
+
+void Shader::setUniform(UniformHandle handle, const glm::uvec2 &vec) const noexcept
+{
+    glUniform2ui(getHandleLocation(handle), vec.x, vec.y);
+    RenderStats::countUniformUpload();
+}
+
+void Shader::setUniform(UniformHandle handle, const glm::vec3 &vec) const noexcept
+{
+    glUniform3f(getHandleLocation(handle), vec.x, vec.y, vec.z);
+    RenderStats::countUniformUpload();
+}
+
+void Shader::setUniform(UniformHandle handle, const glm::vec4 &vec) const noexcept
+{
+    glUniform4f(getHandleLocation(handle), vec.x, vec.y, vec.z, vec.w);
+    RenderStats::countUniformUpload();
+}
+
+void Shader::setUniform(UniformHandle handle, const glm::mat4 *matrices, unsigned int count) const noexcept
+{
+    if (!matrices || count == 0)
+    {
+        return;
+    }
+
+    glUniformMatrix4fv(getHandleLocation(handle), count, GL_FALSE, glm::value_ptr(matrices[0]));
+    RenderStats::countUniformUpload();
+}
+
+void Shader::setUniform(UniformHandle handle, GLfloat value) const noexcept
+{
+    glUniform1f(getHandleLocation(handle), value);
+    RenderStats::countUniformUpload();
+}
+
+void Shader::setUniform(UniformHandle handle, GLint value) const noexcept
+{
+    glUniform1i(getHandleLocation(handle), value);
+    RenderStats::countUniformUpload();
+}
+
+void Shader::setUniform(UniformHandle handle, GLuint value) const noexcept
+{
+    glUniform1ui(getHandleLocation(handle), value);
+    RenderStats::countUniformUpload();
+}
+
 void Shader::setUniform(const std::string &str, const glm::mat3 &matrix)
 {
     glUniformMatrix3fv(getUniformLocation(str), 1, GL_FALSE, glm::value_ptr(matrix));
+    RenderStats::countUniformUpload();
 }
 
 void Shader::setUniform(const std::string &str, const glm::mat4 &matrix)
 {
     glUniformMatrix4fv(getUniformLocation(str), 1, GL_FALSE, glm::value_ptr(matrix));
+    RenderStats::countUniformUpload();
 }
 
 void Shader::setUniform(const std::string &str, const glm::vec2 &vec)
 {
     glUniform2f(getUniformLocation(str), vec.x, vec.y);
+    RenderStats::countUniformUpload();
 }
 
 void Shader::setUniform(const std::string &str, const glm::ivec2 &vec)
 {
     glUniform2i(getUniformLocation(str), vec.x, vec.y);
+    RenderStats::countUniformUpload();
 }
 
 void Shader::setUniform(const std::string &str, const glm::uvec2 &vec)
 {
     glUniform2ui(getUniformLocation(str), vec.x, vec.y);
+    RenderStats::countUniformUpload();
 }
 
 void Shader::setUniform(const std::string &str, const glm::vec3 &vec)
 {
     glUniform3f(getUniformLocation(str), vec.x, vec.y, vec.z);
+    RenderStats::countUniformUpload();
 }
 
 void Shader::setUniform(const std::string &str, const glm::vec4 &vec)
 {
     glUniform4f(getUniformLocation(str), vec.x, vec.y, vec.z, vec.w);
+    RenderStats::countUniformUpload();
 }
 
 void Shader::setUniform(const std::string &str, const glm::mat4 *matrices, unsigned int count)
@@ -259,52 +533,62 @@ void Shader::setUniform(const std::string &str, const glm::mat4 *matrices, unsig
     }
 
     glUniformMatrix4fv(getUniformLocation(str), count, GL_FALSE, glm::value_ptr(matrices[0]));
+    RenderStats::countUniformUpload();
 }
 
 void Shader::setUniform(const std::string &str, GLfloat arr[][2], unsigned int count)
 {
     glUniform2fv(getUniformLocation(str), count, arr[0]);
+    RenderStats::countUniformUpload();
 }
 
 void Shader::setUniform(const std::string &str, GLint arr[], const unsigned int count)
 {
     glUniform1iv(getUniformLocation(str), count, arr);
+    RenderStats::countUniformUpload();
 }
 
 void Shader::setUniform(const std::string &str, GLfloat arr[], unsigned int count)
 {
     glUniform1fv(getUniformLocation(str), count, arr);
+    RenderStats::countUniformUpload();
 }
 
 void Shader::setUniform(const std::string &str, GLfloat value)
 {
     glUniform1f(getUniformLocation(str), value);
+    RenderStats::countUniformUpload();
 }
 
 void Shader::setUniform(const std::string &str, GLdouble value)
 {
     glUniform1d(getUniformLocation(str), value);
+    RenderStats::countUniformUpload();
 }
 
 void Shader::setUniform(const std::string &str, GLint value)
 {
     glUniform1i(getUniformLocation(str), value);
+    RenderStats::countUniformUpload();
 }
 
 void Shader::setUniform(const std::string &str, GLuint value)
 {
     glUniform1ui(getUniformLocation(str), value);
+    RenderStats::countUniformUpload();
 }
 
 void Shader::setSubroutine(GLenum shaderType, GLuint count, const std::string &name)
 {
     GLuint loc = getSubroutineLocation(shaderType, name);
     glUniformSubroutinesuiv(shaderType, count, &loc);
+    RenderStats::countUniformUpload();
 }
 
 void Shader::setSubroutine(GLenum shaderType, GLuint count, GLuint index)
 {
     glUniformSubroutinesuiv(shaderType, count, &index);
+    RenderStats::countUniformUpload();
 }
 
 void Shader::bindFragDataLocation(const std::string &str, GLuint loc)
@@ -386,19 +670,16 @@ std::string Shader::resolveIncludes(const std::string &source, const std::string
                 includePath.pop_back();
 
             std::string fullPath = directory + includePath;
-            std::ifstream includeFile(fullPath);
-            if (includeFile.is_open())
+            if (std::string included; readShaderFile(fullPath, included))
             {
-                std::stringstream buf;
-                buf << includeFile.rdbuf();
-                includeFile.close();
+                mSourceFiles.push_back(fullPath);
 
                 // Resolve nested includes relative to the included file's directory
                 std::string includeDir;
                 size_t lastSlash = fullPath.find_last_of("/\\");
                 if (lastSlash != std::string::npos)
                     includeDir = fullPath.substr(0, lastSlash + 1);
-                result += resolveIncludes(buf.str(), includeDir);
+                result += resolveIncludes(included, includeDir);
             }
             else
             {
@@ -419,48 +700,10 @@ GLuint Shader::compile(ShaderType shaderType, const std::string &shaderCode)
 
     GLenum glShaderType = getShaderType(shaderType);
 
-    GLint success;
-    GLchar infoLog[512];
-
     GLuint shaderId = glCreateShader(glShaderType);
 
     glShaderSource(shaderId, 1, &glShaderString, &length);
     glCompileShader(shaderId);
-    glGetShaderiv(shaderId, GL_INFO_LOG_LENGTH, &length);
-    glGetShaderiv(shaderId, GL_COMPILE_STATUS, &success);
-
-    if (!success)
-    {
-        glGetShaderInfoLog(shaderId, 512, nullptr, infoLog);
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s -- Shader Compilation Failed: %s", mFileNames.at(shaderType).c_str(), infoLog);
-        return 0;
-    }
-
-    return shaderId;
-}
-
-GLuint Shader::compile(ShaderType shaderType, const GLchar *shaderCode)
-{
-    GLint length = static_cast<GLint>(std::strlen(shaderCode));
-
-    GLenum glShaderType = getShaderType(shaderType);
-
-    GLint success;
-    GLchar infoLog[512];
-
-    GLuint shaderId = glCreateShader(glShaderType);
-
-    glShaderSource(shaderId, 1, &shaderCode, &length);
-    glCompileShader(shaderId);
-    glGetShaderiv(shaderId, GL_INFO_LOG_LENGTH, &length);
-    glGetShaderiv(shaderId, GL_COMPILE_STATUS, &success);
-
-    if (!success)
-    {
-        glGetShaderInfoLog(shaderId, 512, nullptr, infoLog);
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s -- Shader Compilation Failed: %s", mFileNames.at(shaderType).c_str(), infoLog);
-        return 0;
-    }
 
     return shaderId;
 }
@@ -482,36 +725,61 @@ void Shader::deleteShader(GLuint shaderId)
 
 void Shader::deleteProgram(GLint shaderId)
 {
+    GLStateCache::forgetProgram(static_cast<GLuint>(shaderId));
     glDeleteProgram(shaderId);
 }
 
 GLint Shader::getUniformLocation(const std::string &str)
 {
-    auto iter = mGLSLLocations.find(str);
-    if (iter == mGLSLLocations.end())
+    if (const auto iter = mGLSLLocations.find(str); iter != mGLSLLocations.end())
     {
-        GLint loc = glGetUniformLocation(mProgram, str.c_str());
-        if (loc == -1)
-        {
-            // Only warn once per uniform name per shader program
-            static std::unordered_set<std::string> warnedUniforms;
-            std::string key = std::to_string(mProgram) + ":" + str;
-            if (warnedUniforms.find(key) == warnedUniforms.end())
-            {
-                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "%s does not exist in the shader (program %d)", str.c_str(), mProgram);
-                warnedUniforms.insert(key);
-            }
-        }
-        else
-        {
-            mGLSLLocations.emplace(str, loc);
-        }
+        return iter->second;
+    }
 
-        return loc;
+    // Not an active uniform after link (or a name spelled differently); cache misses too so they warn once
+    const GLint loc = glGetUniformLocation(mProgram, str.c_str());
+    if (loc == -1)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "%s does not exist in the shader (program %d)", str.c_str(), mProgram);
     }
-    else
+    mGLSLLocations.emplace(str, loc);
+
+    return loc;
+}
+
+GLint Shader::getHandleLocation(UniformHandle handle) const noexcept
+{
+    return (handle.mSlot < mHandleLocations.size()) ? mHandleLocations[handle.mSlot] : -1;
+}
+
+void Shader::cacheActiveUniforms()
+{
+    mGLSLLocations.clear();
+
+    GLint numUniforms = 0;
+    glGetProgramInterfaceiv(mProgram, GL_UNIFORM, GL_ACTIVE_RESOURCES, &numUniforms);
+    const GLenum properties[] = {GL_NAME_LENGTH, GL_LOCATION, GL_BLOCK_INDEX};
+
+    std::string name;
+    for (GLint i = 0; i < numUniforms; ++i)
     {
-        return mGLSLLocations.at(str);
+        GLint results[3];
+        glGetProgramResourceiv(mProgram, GL_UNIFORM, i, 3, properties, 3, nullptr, results);
+
+        if (results[2] != -1 || results[0] <= 1)
+            continue; // block members have no location
+
+        name.resize(static_cast<std::size_t>(results[0]));
+        glGetProgramResourceName(mProgram, GL_UNIFORM, i, results[0], nullptr, name.data());
+        name.resize(static_cast<std::size_t>(results[0] - 1));
+
+        mGLSLLocations.emplace(name, results[1]);
+
+        // Arrays are reported as "name[0]"; accept the bare name as well
+        if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0)
+        {
+            mGLSLLocations.emplace(name.substr(0, name.size() - 3), results[1]);
+        }
     }
 }
 
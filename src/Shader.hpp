@@ -1,9 +1,12 @@
 #ifndef SHADER_HPP
 #define SHADER_HPP
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
@@ -27,20 +30,65 @@ public:
 
     typedef std::unique_ptr<Shader> Ptr;
 
+    /// @brief Precompiled reference to a uniform of one Shader, resolved once by name
+    /// @details Survives relinking (recompileWithDefines); a handle to a missing uniform is a no-op
+    class UniformHandle
+    {
+    public:
+        UniformHandle() = default;
+
+        [[nodiscard]] bool isValid() const noexcept { return mSlot != INVALID_SLOT; }
+
+    private:
+        friend class Shader;
+
+        static constexpr std::uint32_t INVALID_SLOT = 0xFFFFFFFFu;
+
+        explicit UniformHandle(std::uint32_t slot) noexcept : mSlot{slot} {}
+
+        std::uint32_t mSlot{INVALID_SLOT};
+    };
+
 public:
-    /// Compile and attach a shader from file
+    /// Add a shader stage from file; compilation is deferred to linkProgram()
     void compileAndAttachShader(ShaderType shaderType, const std::string &filename);
 
-    /// Compile and attach a shader from memory
+    /// Add a shader stage from memory; compilation is deferred to linkProgram()
     void compileAndAttachShader(ShaderType shaderType, const std::string &codeId, const GLchar *code);
 
     /// Rebuild all attached shaders with preprocessor defines injected after #version.
     /// Re-reads source from stored filenames, resolves includes, injects defines, recompiles, and relinks.
     void recompileWithDefines(const std::string &defines);
 
-    /// Link the shader program
+    /// @brief Rebuild from the stage files with the last defines, for hot reload
+    /// @details The new program replaces the current one only if every file reads and it links, so a
+    /// broken edit keeps the old program running. UniformHandles stay valid; values set once at init
+    /// (not per draw) have to be set again.
+    /// @return false if the program was left unchanged
+    bool reload();
+
+    /// Build and link a separate program from this shader's files with defines injected; this one is left untouched
+    [[nodiscard]] Ptr createVariant(const std::string &defines) const;
+
+    /// Link the shader program, loading it from ProgramBinaryCache when the stage sources match
+    /// a cached binary and compiling the pending stages otherwise
+    /// @details Same as submitLink() followed by finishLink()
     void linkProgram();
 
+    /// Issue compile and link without reading any status back, so the driver may work in the background
+    void submitLink();
+
+    /// True once a submitted link can be finished without blocking (always true without parallel compile)
+    [[nodiscard]] bool isLinkComplete() const;
+
+    /// Read link status back, report errors, and resolve uniforms; blocks if the link is still running
+    void finishLink();
+
+    /// @brief Let the driver compile on its own threads (GL_KHR/ARB_parallel_shader_compile)
+    /// @return false if neither extension is present; submitted links then complete synchronously
+    static bool enableParallelCompile() noexcept;
+
+
     /// Bind this shader program for use
     void bind() const;
 
@@ -56,7 +104,23 @@ public:
     /// Get introspection info about active attributes
     std::string getGLSLAttribs() const;
 
-    // Type-safe uniform setters
+    /// Resolve a uniform name once (at init, not per draw) for the handle-based setters
+    [[nodiscard]] UniformHandle getUniformHandle(const std::string &name);
+
+    // Handle-based uniform setters: plain integer lookups for hot draw loops
+    void setUniform(UniformHandle handle, const glm::mat3 &matrix) const noexcept;
+    void setUniform(UniformHandle handle, const glm::mat4 &matrix) const noexcept;
+    void setUniform(UniformHandle handle, const glm::vec2 &vec) const noexcept;
+    void setUniform(UniformHandle handle, const glm::ivec2 &vec) const noexcept;
+    void setUniform(UniformHandle handle, const glm::uvec2 &vec) const noexcept;
+    void setUniform(UniformHandle handle, const glm::vec3 &vec) const noexcept;
+    void setUniform(UniformHandle handle, const glm::vec4 &vec) const noexcept;
+    void setUniform(UniformHandle handle, const glm::mat4 *matrices, unsigned int count) const noexcept;
+    void setUniform(UniformHandle handle, GLfloat value) const noexcept;
+    void setUniform(UniformHandle handle, GLint value) const noexcept;
+    void setUniform(UniformHandle handle, GLuint value) const noexcept;
+
+    // Type-safe uniform setters (string-keyed slow path)
     void setUniform(const std::string &str, const glm::mat3 &matrix);
     void setUniform(const std::string &str, const glm::mat4 &matrix);
     void setUniform(const std::string &str, const glm::vec2 &vec);
@@ -84,20 +148,42 @@ public:
     [[nodiscard]] GLenum getShaderType(ShaderType shaderType) const;
     [[nodiscard]] std::unordered_map<std::string, GLint> getGLSLLocations() const;
     [[nodiscard]] std::unordered_map<ShaderType, std::string> getFileNames() const;
+    /// Stage files and every file they include, as read by the last build
+    [[nodiscard]] const std::vector<std::string> &getSourceFiles() const noexcept { return mSourceFiles; }
 
 private:
     GLint mProgram{0};
     std::unordered_map<std::string, GLint> mGLSLLocations;
     std::unordered_map<ShaderType, std::string> mFileNames;
+    std::vector<std::string> mSourceFiles;
+    // Last recompileWithDefines() argument, reapplied by reload()
+    std::string mDefines;
+
+    // Final stage sources (includes resolved, defines injected) waiting for linkProgram
+    std::vector<std::pair<ShaderType, std::string>> mPendingSources;
+
+    // State carried from submitLink() to finishLink()
+    std::vector<std::pair<ShaderType, GLuint>> mCompiledShaders;
+    std::uint64_t mLinkSourceHash{0};
+    bool mLinkPending{false};
+    bool mLinkFromCache{false};
+    bool mLinkCacheable{false};
+
+    static bool sParallelCompile;
+
+    // Indexed by UniformHandle slot; locations are re-resolved after every link
+    std::vector<std::string> mHandleNames;
+    std::vector<GLint> mHandleLocations;
 
     std::string resolveIncludes(const std::string &source, const std::string &directory);
     GLuint compile(ShaderType shaderType, const std::string &shaderCode);
-    GLuint compile(ShaderType shaderType, const GLchar *shaderCode);
     void attach(GLuint shaderId);
     void createProgram();
     void deleteShader(GLuint shaderId);
     void deleteProgram(GLint shaderId);
     GLint getUniformLocation(const std::string &str);
+    [[nodiscard]] GLint getHandleLocation(UniformHandle handle) const noexcept;
+    void cacheActiveUniforms();
     GLint getAttribLocation(const std::string &str);
     GLuint getSubroutineLocation(GLenum shaderType, const std::string &name);
     std::string getStringFromType(GLenum shaderType) const;
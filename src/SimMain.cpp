@@ -0,0 +1,263 @@
+// Headless simulation runner: World physics, chunk streaming and pickups without a window or GL context
+// Used by dedicated servers and CI benchmarks where no GPU is available
+// With --relay it runs the multiplayer relay instead (RelayServer.hpp)
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <SDL3/SDL.h>
+
+#include <MazeBuilder/maze_builder.h>
+
+#include "JobSystem.hpp"
+#include "Level.hpp"
+#include "RelayServer.hpp"
+#include "RenderWindow.hpp"
+#include "ResourceIdentifiers.hpp"
+#include "ResourceManager.hpp"
+#include "World.hpp"
+
+namespace
+{
+    constexpr float kFixedTimeStep = 1.0f / 60.0f;
+    constexpr int kDefaultTicks = 3600;
+    constexpr int kDefaultBots = 8;
+    constexpr float kPlayerSpeed = 12.0f;
+    constexpr float kBotOrbitRadius = 18.0f;
+    constexpr float kBotCollectRadius = 3.0f;
+    constexpr unsigned short kDefaultRelayPort = 7777;
+    constexpr float kRelayStatsInterval = 5.0f;
+
+    struct SimArgs
+    {
+        int ticks{kDefaultTicks};
+        int bots{kDefaultBots};
+        std::string chunkCachePath{};
+    };
+
+    bool parseArgs(int argc, char *argv[], SimArgs &out)
+    {
+        try
+        {
+            if (argc > 1)
+            {
+                out.ticks = std::max(1, std::stoi(argv[1]));
+            }
+            if (argc > 2)
+            {
+                out.bots = std::max(0, std::stoi(argv[2]));
+            }
+            if (argc > 3)
+            {
+                out.chunkCachePath = argv[3];
+            }
+        }
+        catch (const std::exception &)
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    /// @brief Serve one relay room at the simulation tick rate until the duration runs out (0 = forever)
+    int runRelay(unsigned short port, float durationSeconds)
+    {
+        RelayServer relay;
+        if (!relay.start(port))
+        {
+            return EXIT_FAILURE;
+        }
+
+        const auto tickLength = std::chrono::duration<double>(kFixedTimeStep);
+        auto nextTick = std::chrono::steady_clock::now();
+        float elapsed = 0.0f;
+        float statsAccumulator = 0.0f;
+
+        while (durationSeconds <= 0.0f || elapsed < durationSeconds)
+        {
+            relay.update(kFixedTimeStep);
+            elapsed += kFixedTimeStep;
+
+            statsAccumulator += kFixedTimeStep;
+            if (statsAccumulator >= kRelayStatsInterval)
+            {
+                statsAccumulator = 0.0f;
+                const auto stats = relay.takeStats();
+                SDL_Log("breakingwalls_sim relay: clients=%zu snapshots in=%zu entries out=%zu deferred=%zu messages out=%zu",
+                        stats.clients, stats.snapshotsIn, stats.entriesOut, stats.entriesDeferred, stats.messagesOut);
+            }
+
+            nextTick += std::chrono::duration_cast<std::chrono::steady_clock::duration>(tickLength);
+            const auto now = std::chrono::steady_clock::now();
+            if (nextTick > now)
+            {
+                SDL_DelayNS(static_cast<Uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(nextTick - now).count()));
+            }
+            else
+            {
+                nextTick = now;
+            }
+        }
+
+        relay.stop();
+        return EXIT_SUCCESS;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1 && std::string{argv[1]} == "--relay")
+    {
+        unsigned short port = kDefaultRelayPort;
+        float duration = 0.0f;
+        try
+        {
+            if (argc > 2)
+            {
+                port = static_cast<unsigned short>(std::stoul(argv[2]));
+            }
+            if (argc > 3)
+            {
+                duration = std::stof(argv[3]);
+            }
+        }
+        catch (const std::exception &)
+        {
+            std::cerr << "Usage: " << argv[0] << " --relay [port] [seconds]" << std::endl;
+
+            return EXIT_FAILURE;
+        }
+
+        if (!SDL_Init(SDL_INIT_EVENTS))
+        {
+            std::cerr << "SDL_Init failed: " << SDL_GetError() << std::endl;
+
+            return EXIT_FAILURE;
+        }
+        const int result = runRelay(port, duration);
+        SDL_Quit();
+
+        return result;
+    }
+
+    SimArgs args;
+    if (!parseArgs(argc, argv, args))
+    {
+        std::cerr << "Usage: " << argv[0] << " [ticks] [bots] [chunk_cache_path] | --relay [port] [seconds]" << std::endl;
+
+        return EXIT_FAILURE;
+    }
+
+    // Only events and timers: no video subsystem, so no window or GL context is ever created
+    if (!SDL_Init(SDL_INIT_EVENTS))
+    {
+        std::cerr << "SDL_Init failed: " << SDL_GetError() << std::endl;
+
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        // World keeps references to the render-side managers but only touches them from rendering paths
+        RenderWindow window{nullptr};
+        FontManager fonts;
+        TextureManager textures;
+        ShaderManager shaders;
+        LevelsManager levels;
+
+        // Same level as LoadingState so chunk seeds (and cached chunks) match the game
+        std::vector<mazes::configurator> levelConfigs;
+        levelConfigs.push_back(mazes::configurator().rows(20).columns(20));
+        levels.load(Levels::ID::LEVEL_ONE, std::cref(levelConfigs), false);
+
+        World world{window, fonts, textures, shaders, levels};
+        world.init();
+        if (!args.chunkCachePath.empty())
+        {
+            world.enableChunkDiskCache(args.chunkCachePath);
+        }
+
+        glm::vec3 playerPosition = world.getMazeSpawnPosition();
+        world.createPlayerBody(playerPosition);
+
+        std::vector<World::PickupQuery> botQueries(static_cast<std::size_t>(args.bots));
+        std::vector<int> botPoints(botQueries.size(), 0);
+        long long botScore = 0;
+
+        SDL_Log("breakingwalls_sim: %d ticks, %d bots, %u job workers", args.ticks, args.bots,
+                JobSystem::instance()->getWorkerCount());
+
+        double totalTickMs = 0.0;
+        double worstTickMs = 0.0;
+        const auto runStart = std::chrono::steady_clock::now();
+
+        for (int tick = 0; tick < args.ticks; ++tick)
+        {
+            const auto tickStart = std::chrono::steady_clock::now();
+            const float simTime = static_cast<float>(tick) * kFixedTimeStep;
+
+            // Walk the player in a straight line so chunks keep streaming in and out
+            playerPosition.x += kPlayerSpeed * kFixedTimeStep;
+            world.updateSphereChunks(playerPosition, glm::vec3(kPlayerSpeed, 0.0f, 0.0f));
+            world.update(kFixedTimeStep);
+            world.collectNearbyPickups(playerPosition);
+
+            // Synthetic bots orbit the player and collect through the batched query
+            for (std::size_t i = 0; i < botQueries.size(); ++i)
+            {
+                const float phase = simTime + static_cast<float>(i) * (6.2831853f / static_cast<float>(botQueries.size()));
+                botQueries[i].position = playerPosition + glm::vec3(std::cos(phase) * kBotOrbitRadius, 0.0f,
+                                                                    std::sin(phase) * kBotOrbitRadius);
+                botQueries[i].radius = kBotCollectRadius;
+            }
+            if (!botQueries.empty())
+            {
+                world.collectNearbyPickups(botQueries, botPoints);
+                for (const int points : botPoints)
+                {
+                    botScore += points;
+                }
+            }
+
+            const double tickMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tickStart).count();
+            totalTickMs += tickMs;
+            worstTickMs = std::max(worstTickMs, tickMs);
+        }
+
+        const double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - runStart).count();
+        const auto physics = world.getPhysicsStats();
+        const auto cache = world.getMazeCacheStats();
+        const auto streaming = world.getChunkStreamStats();
+
+        SDL_Log("breakingwalls_sim: %.1f ms total, %.3f ms/tick avg, %.3f ms worst", wallMs,
+                totalTickMs / static_cast<double>(args.ticks), worstTickMs);
+        SDL_Log("breakingwalls_sim: physics workers=%d tasks/step=%u step=%.3f collide=%.3f solve=%.3f ms",
+                physics.workerCount, physics.tasksPerStep, physics.stepMs, physics.collideMs, physics.solveMs);
+        SDL_Log("breakingwalls_sim: chunks entered=%u late=%u last late=%.1f ms worst late=%.1f ms",
+                streaming.chunksEntered, streaming.lateChunks, streaming.lastLateMs, streaming.worstLateMs);
+        SDL_Log("breakingwalls_sim: maze cache hits=%llu misses=%llu evictions=%llu entries=%zu",
+                static_cast<unsigned long long>(cache.hits), static_cast<unsigned long long>(cache.misses),
+                static_cast<unsigned long long>(cache.evictions), cache.entries);
+        SDL_Log("breakingwalls_sim: spheres=%zu pickups=%zu score=%d bots=%lld", world.getSpheres().size(),
+                world.getPickupSpheres().size(), world.getScore(), botScore);
+
+        world.destroyWorld();
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        SDL_Quit();
+
+        return EXIT_FAILURE;
+    }
+
+    SDL_Quit();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,203 @@
+#ifndef SLOT_MAP_HPP
+#define SLOT_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/// @brief Stable reference into a SlotMap; stale handles fail lookups once their slot is reused
+struct SlotHandle
+{
+    static constexpr std::uint32_t INVALID_INDEX = std::numeric_limits<std::uint32_t>::max();
+
+    std::uint32_t index{INVALID_INDEX};
+    std::uint32_t generation{0};
+
+    [[nodiscard]] bool isValid() const noexcept { return index != INVALID_INDEX; }
+
+    bool operator==(const SlotHandle &other) const noexcept
+    {
+        return index == other.index && generation == other.generation;
+    }
+};
+
+/// @brief Generational slot map storing each column as its own packed array (structure of arrays)
+/// @details Insert and erase are O(1). Erase swaps the last dense element into the hole,
+/// so dense iteration over column<I>() stays contiguous but order is not preserved.
+template <typename... Columns>
+class SlotMap
+{
+public:
+    static constexpr std::size_t NPOS = std::numeric_limits<std::size_t>::max();
+
+    void reserve(std::size_t capacity)
+    {
+        mSlots.reserve(capacity);
+        mDenseToSlot.reserve(capacity);
+        std::apply([capacity](auto &...column)
+                   { (column.reserve(capacity), ...); },
+                   mColumns);
+    }
+
+    template <typename... Args>
+    SlotHandle insert(Args &&...values)
+    {
+        static_assert(sizeof...(Args) == sizeof...(Columns), "SlotMap::insert needs one value per column");
+
+        std::uint32_t slotIndex = 0;
+        if (!mFreeSlots.empty())
+        {
+            slotIndex = mFreeSlots.back();
+            mFreeSlots.pop_back();
+        }
+        else
+        {
+            slotIndex = static_cast<std::uint32_t>(mSlots.size());
+            mSlots.push_back(Slot{});
+        }
+
+        Slot &slot = mSlots[slotIndex];
+        slot.dense = static_cast<std::uint32_t>(mDenseToSlot.size());
+        mDenseToSlot.push_back(slotIndex);
+
+        pushValues(std::index_sequence_for<Columns...>{}, std::forward<Args>(values)...);
+
+        return SlotHandle{slotIndex, slot.generation};
+    }
+
+    /// @return false if the handle was stale or invalid
+    bool erase(const SlotHandle &handle) noexcept
+    {
+        const std::size_t dense = denseIndex(handle);
+        if (dense == NPOS)
+        {
+            return false;
+        }
+
+        const std::size_t last = mDenseToSlot.size() - 1;
+        if (dense != last)
+        {
+            std::apply([dense, last](auto &...column)
+                       { ((column[dense] = std::move(column[last])), ...); },
+                       mColumns);
+            mDenseToSlot[dense] = mDenseToSlot[last];
+            mSlots[mDenseToSlot[dense]].dense = static_cast<std::uint32_t>(dense);
+        }
+
+        std::apply([](auto &...column)
+                   { (column.pop_back(), ...); },
+                   mColumns);
+        mDenseToSlot.pop_back();
+
+        Slot &slot = mSlots[handle.index];
+        ++slot.generation;
+        slot.dense = SlotHandle::INVALID_INDEX;
+        mFreeSlots.push_back(handle.index);
+        return true;
+    }
+
+    [[nodiscard]] bool contains(const SlotHandle &handle) const noexcept
+    {
+        return denseIndex(handle) != NPOS;
+    }
+
+    /// @return Position of the handle's element in the packed columns, or NPOS
+    [[nodiscard]] std::size_t denseIndex(const SlotHandle &handle) const noexcept
+    {
+        if (handle.index >= mSlots.size())
+        {
+            return NPOS;
+        }
+
+        const Slot &slot = mSlots[handle.index];
+        if (slot.generation != handle.generation || slot.dense == SlotHandle::INVALID_INDEX)
+        {
+            return NPOS;
+        }
+
+        return slot.dense;
+    }
+
+    [[nodiscard]] SlotHandle handleAt(std::size_t dense) const noexcept
+    {
+        const std::uint32_t slotIndex = mDenseToSlot[dense];
+        return SlotHandle{slotIndex, mSlots[slotIndex].generation};
+    }
+
+    /// @brief Current handle of a slot index stored elsewhere; contains() is false if the slot is free
+    /// @details The generation is the slot's latest, so the caller must know which element it expects
+    [[nodiscard]] SlotHandle handleForSlot(std::uint32_t slotIndex) const noexcept
+    {
+        if (slotIndex >= mSlots.size())
+        {
+            return SlotHandle{};
+        }
+        return SlotHandle{slotIndex, mSlots[slotIndex].generation};
+    }
+
+    template <std::size_t I>
+    [[nodiscard]] auto &column() noexcept { return std::get<I>(mColumns); }
+
+    template <std::size_t I>
+    [[nodiscard]] const auto &column() const noexcept { return std::get<I>(mColumns); }
+
+    /// @brief Direct access to one field of a live element; the handle must be valid
+    template <std::size_t I>
+    [[nodiscard]] auto &get(const SlotHandle &handle) noexcept
+    {
+        return std::get<I>(mColumns)[mSlots[handle.index].dense];
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return mDenseToSlot.size(); }
+    [[nodiscard]] bool empty() const noexcept { return mDenseToSlot.empty(); }
+
+    /// Bytes reserved by the columns and the slot bookkeeping, for memory accounting
+    [[nodiscard]] std::size_t getCapacityBytes() const noexcept
+    {
+        std::size_t bytes = mSlots.capacity() * sizeof(Slot) +
+                            (mDenseToSlot.capacity() + mFreeSlots.capacity()) * sizeof(std::uint32_t);
+        std::apply([&bytes](const auto &...column)
+                   { ((bytes += column.capacity() * sizeof(column[0])), ...); },
+                   mColumns);
+        return bytes;
+    }
+
+    void clear() noexcept
+    {
+        // Bump every live slot so outstanding handles go stale
+        for (std::uint32_t slotIndex : mDenseToSlot)
+        {
+            ++mSlots[slotIndex].generation;
+            mSlots[slotIndex].dense = SlotHandle::INVALID_INDEX;
+            mFreeSlots.push_back(slotIndex);
+        }
+
+        mDenseToSlot.clear();
+        std::apply([](auto &...column)
+                   { (column.clear(), ...); },
+                   mColumns);
+    }
+
+private:
+    struct Slot
+    {
+        std::uint32_t dense{SlotHandle::INVALID_INDEX};
+        std::uint32_t generation{0};
+    };
+
+    template <std::size_t... Is, typename... Args>
+    void pushValues(std::index_sequence<Is...>, Args &&...values)
+    {
+        (std::get<Is>(mColumns).push_back(std::forward<Args>(values)), ...);
+    }
+
+    std::vector<Slot> mSlots;
+    std::vector<std::uint32_t> mFreeSlots;
+    std::vector<std::uint32_t> mDenseToSlot;
+    std::tuple<std::vector<Columns>...> mColumns;
+};
+
+#endif // SLOT_MAP_HPP
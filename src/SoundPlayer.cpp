@@ -1,10 +1,11 @@
 #include "SoundPlayer.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
-#include <list>
-#include <ranges>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include <SFML/Audio/Listener.hpp>
 #include <SFML/Audio/Sound.hpp>
@@ -24,14 +25,53 @@ namespace
     const float MIN_DISTANCE_2D = 200.f;
     // MIN_DISTANCE_3D: Actual 3D minimum distance calculated with Pythagorean theorem
     const float MIN_DISTANCE_3D = std::sqrt(MIN_DISTANCE_2D * MIN_DISTANCE_2D + LISTENER_Z * LISTENER_Z);
+
+    // Voices created up front; well under the OpenAL source limit, leaving room for music streams
+    constexpr std::size_t MAX_VOICES = 24;
+    // Below this gain (after distance attenuation and volume) an effect is not worth a voice
+    constexpr float MIN_AUDIBLE_GAIN = 0.02f;
+
+    struct EffectPolicy
+    {
+        /// A new effect may take the voice of one with the same or a lower priority
+        std::uint8_t priority;
+        /// More of the same effect restart its oldest voice instead of taking another
+        std::uint8_t maxVoices;
+    };
+
+    // Indexed by SoundEffect::ID; WHITE_NOISE plays on the SDL stream, not a voice
+    constexpr std::array<EffectPolicy, 4> EFFECT_POLICIES{{
+        {2, 2}, // GENERATE
+        {0, 0}, // WHITE_NOISE
+        {1, 6}, // SELECT
+        {1, 4}, // THROW
+    }};
+
+    /// OpenAL's inverse distance clamped model, which sf::Sound uses
+    float attenuatedGain(const sf::Vector3f &listener, const sf::Vector3f &source) noexcept
+    {
+        const float dx = listener.x - source.x;
+        const float dy = listener.y - source.y;
+        const float dz = listener.z - source.z;
+        const float distance = std::max(std::sqrt(dx * dx + dy * dy + dz * dz), MIN_DISTANCE_3D);
+        return MIN_DISTANCE_3D / (MIN_DISTANCE_3D + ATTENUATION * (distance - MIN_DISTANCE_3D));
+    }
 }
 
 class SoundPlayer::Impl
 {
 public:
     explicit Impl(SoundBufferManager &soundBuffers)
-        : mSoundBuffers{soundBuffers}, mSounds{}, mVolume{100.0f}, mEnabled{true}, mStream{}, mStreamInitialized{false}
+        : mSoundBuffers{soundBuffers}, mSilence{}, mSounds{}, mVoices{}, mVolume{100.0f}, mEnabled{true}, mStream{}, mStreamInitialized{false}
     {
+        // Every sf::Sound (and its OpenAL source) exists from here on; play() only rebinds buffers
+        mSounds.reserve(MAX_VOICES);
+        for (std::size_t i = 0; i < MAX_VOICES; ++i)
+        {
+            mSounds.emplace_back(mSilence);
+            mSounds.back().setAttenuation(ATTENUATION);
+            mSounds.back().setMinDistance(MIN_DISTANCE_3D);
+        }
     }
 
     ~Impl() = default;
@@ -56,22 +96,40 @@ public:
             return;
         }
 
-        mSounds.emplace_back(sf::Sound{mSoundBuffers.get(effect)});
-        sf::Sound &sound = mSounds.back();
-
         // Set 3D position: X same, Y negated (audio Y is up), Z=0 (sound in 2D plane)
-        sound.setPosition(sf::Vector3f{position.x, -position.y, 0.f});
-        sound.setAttenuation(ATTENUATION);
-        sound.setMinDistance(MIN_DISTANCE_3D);
-        sound.setVolume(mVolume);
+        const sf::Vector3f sourcePosition{position.x, -position.y, 0.f};
+        const float gain = attenuatedGain(sf::Listener::getPosition(), sourcePosition);
+        if (gain * mVolume / 100.0f < MIN_AUDIBLE_GAIN)
+        {
+            return;
+        }
 
+        const EffectPolicy policy = getPolicy(effect);
+        const std::size_t voice = acquireVoice(effect, policy, gain);
+        if (voice == MAX_VOICES)
+        {
+            return;
+        }
+
+        sf::Sound &sound = mSounds[voice];
+        sound.stop();
+        sound.setBuffer(mSoundBuffers.get(effect));
+        sound.setPosition(sourcePosition);
+        sound.setVolume(mVolume);
         sound.play();
+
+        mVoices[voice] = VoiceState{effect, policy.priority, gain, mNextStartOrder++, true};
     }
 
     void removeStoppedSounds()
     {
-        std::erase_if(mSounds, [](const sf::Sound &sound)
-                      { return sound.getStatus() == sf::Sound::Status::Stopped; });
+        for (std::size_t i = 0; i < MAX_VOICES; ++i)
+        {
+            if (mVoices[i].active && mSounds[i].getStatus() == sf::Sound::Status::Stopped)
+            {
+                mVoices[i].active = false;
+            }
+        }
     }
 
     void stop(SoundEffect::ID effect)
@@ -84,6 +142,15 @@ public:
             }
             return;
         }
+
+        for (std::size_t i = 0; i < MAX_VOICES; ++i)
+        {
+            if (mVoices[i].active && mVoices[i].effect == effect)
+            {
+                mSounds[i].stop();
+                mVoices[i].active = false;
+            }
+        }
     }
 
     // Set listener position in 2D game coordinates
@@ -105,10 +172,13 @@ public:
     void setVolume(float volume)
     {
         mVolume = std::clamp(volume, 0.0f, 100.0f);
-        // Update volume for all currently playing sounds
-        for (auto &sound : mSounds)
+        // Idle voices pick the volume up when they are next played
+        for (std::size_t i = 0; i < MAX_VOICES; ++i)
         {
-            sound.setVolume(mVolume);
+            if (mVoices[i].active)
+            {
+                mSounds[i].setVolume(mVolume);
+            }
         }
     }
 
@@ -123,9 +193,10 @@ public:
         if (!mEnabled)
         {
             // Stop all currently playing sounds when disabled
-            for (auto &sound : mSounds)
+            for (std::size_t i = 0; i < MAX_VOICES; ++i)
             {
-                sound.stop();
+                mSounds[i].stop();
+                mVoices[i].active = false;
             }
 
             if (mStreamInitialized)
@@ -141,6 +212,85 @@ public:
     }
 
 private:
+    struct VoiceState
+    {
+        SoundEffect::ID effect{SoundEffect::ID::GENERATE};
+        std::uint8_t priority{0};
+        /// Distance attenuation when it started; the listener moving since is ignored
+        float gain{0.0f};
+        std::uint64_t startOrder{0};
+        bool active{false};
+    };
+
+    static EffectPolicy getPolicy(SoundEffect::ID effect) noexcept
+    {
+        const auto index = static_cast<std::size_t>(effect);
+        return index < EFFECT_POLICIES.size() ? EFFECT_POLICIES[index] : EffectPolicy{0, 1};
+    }
+
+    /// @brief Pick the voice a new effect plays on: a free one, the effect's own oldest once it is at
+    /// its limit, or else the quietest and then oldest voice of no higher priority
+    /// @return MAX_VOICES when every voice is busy with something more important
+    std::size_t acquireVoice(SoundEffect::ID effect, const EffectPolicy &policy, float gain)
+    {
+        removeStoppedSounds();
+
+        std::size_t sameEffect = 0;
+        std::size_t oldestSame = MAX_VOICES;
+        std::size_t freeVoice = MAX_VOICES;
+        std::size_t victim = MAX_VOICES;
+        for (std::size_t i = 0; i < MAX_VOICES; ++i)
+        {
+            const VoiceState &voice = mVoices[i];
+            if (!voice.active)
+            {
+                freeVoice = std::min(freeVoice, i);
+                continue;
+            }
+
+            if (voice.effect == effect)
+            {
+                ++sameEffect;
+                if (oldestSame == MAX_VOICES || voice.startOrder < mVoices[oldestSame].startOrder)
+                {
+                    oldestSame = i;
+                }
+            }
+
+            if (voice.priority > policy.priority)
+            {
+                continue;
+            }
+            if (victim == MAX_VOICES)
+            {
+                victim = i;
+                continue;
+            }
+            const VoiceState &current = mVoices[victim];
+            if (voice.priority != current.priority ? voice.priority < current.priority
+                : voice.gain != current.gain      ? voice.gain < current.gain
+                                                  : voice.startOrder < current.startOrder)
+            {
+                victim = i;
+            }
+        }
+
+        if (sameEffect >= policy.maxVoices)
+        {
+            return oldestSame;
+        }
+        if (freeVoice != MAX_VOICES)
+        {
+            return freeVoice;
+        }
+        // Never steal a louder voice of the same priority for a quieter effect
+        if (victim != MAX_VOICES && mVoices[victim].priority == policy.priority && mVoices[victim].gain > gain)
+        {
+            return MAX_VOICES;
+        }
+        return victim;
+    }
+
     void playStreamEffect()
     {
         constexpr int STREAM_SAMPLE_RATE = 48000;
@@ -165,7 +315,12 @@ private:
     }
 
     SoundBufferManager &mSoundBuffers;
-    std::list<sf::Sound> mSounds;
+    /// Bound to idle voices, which sf::Sound cannot be without a buffer
+    sf::SoundBuffer mSilence;
+    /// The voice pool; never resized after construction
+    std::vector<sf::Sound> mSounds;
+    std::array<VoiceState, MAX_VOICES> mVoices;
+    std::uint64_t mNextStartOrder{0};
     float mVolume;
     bool mEnabled;
     SDLAudioStream mStream;
@@ -8,6 +8,9 @@
 
 #include <SFML/System/Vector2.hpp>
 
+/// @brief Plays sound effects on a fixed pool of voices created up front
+/// @details Each effect has a priority and a voice limit. When the pool is full a new effect takes
+/// the quietest, then oldest, voice of no higher priority, and effects too far away to hear are dropped.
 class SoundPlayer
 {
 public:
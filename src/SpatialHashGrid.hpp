@@ -0,0 +1,127 @@
+#ifndef SPATIAL_HASH_GRID_HPP
+#define SPATIAL_HASH_GRID_HPP
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/// @brief Uniform 2D grid of point entries bucketed by cell, for radius queries over sparse worlds
+/// @details Only occupied cells are stored. Ids must be equality comparable.
+template <typename Id>
+class SpatialHashGrid
+{
+public:
+    explicit SpatialHashGrid(float cellSize)
+        : mCellSize{cellSize}, mInvCellSize{1.0f / cellSize}
+    {
+    }
+
+    void insert(const glm::vec2 &position, const Id &id)
+    {
+        mCells[keyFor(position)].push_back(Entry{position, id});
+        ++mCount;
+    }
+
+    /// @return false when no entry with this id lives in the position's cell
+    bool remove(const glm::vec2 &position, const Id &id)
+    {
+        auto it = mCells.find(keyFor(position));
+        if (it == mCells.end())
+        {
+            return false;
+        }
+
+        auto &bucket = it->second;
+        auto entryIt = std::find_if(bucket.begin(), bucket.end(),
+                                    [&id](const Entry &entry)
+                                    { return entry.id == id; });
+        if (entryIt == bucket.end())
+        {
+            return false;
+        }
+
+        *entryIt = bucket.back();
+        bucket.pop_back();
+        if (bucket.empty())
+        {
+            mCells.erase(it);
+        }
+        --mCount;
+        return true;
+    }
+
+    /// @brief Call visit(id, position) for every entry within radius of center
+    template <typename Visitor>
+    void queryRadius(const glm::vec2 &center, float radius, Visitor &&visit) const
+    {
+        const float radiusSq = radius * radius;
+        const int minX = cellCoord(center.x - radius);
+        const int maxX = cellCoord(center.x + radius);
+        const int minY = cellCoord(center.y - radius);
+        const int maxY = cellCoord(center.y + radius);
+
+        for (int cy = minY; cy <= maxY; ++cy)
+        {
+            for (int cx = minX; cx <= maxX; ++cx)
+            {
+                auto it = mCells.find(packKey(cx, cy));
+                if (it == mCells.end())
+                {
+                    continue;
+                }
+
+                for (const Entry &entry : it->second)
+                {
+                    const glm::vec2 diff = entry.position - center;
+                    if (glm::dot(diff, diff) < radiusSq)
+                    {
+                        visit(entry.id, entry.position);
+                    }
+                }
+            }
+        }
+    }
+
+    void clear() noexcept
+    {
+        mCells.clear();
+        mCount = 0;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return mCount; }
+    [[nodiscard]] float getCellSize() const noexcept { return mCellSize; }
+
+private:
+    struct Entry
+    {
+        glm::vec2 position;
+        Id id;
+    };
+
+    [[nodiscard]] int cellCoord(float value) const noexcept
+    {
+        return static_cast<int>(std::floor(value * mInvCellSize));
+    }
+
+    [[nodiscard]] std::uint64_t keyFor(const glm::vec2 &position) const noexcept
+    {
+        return packKey(cellCoord(position.x), cellCoord(position.y));
+    }
+
+    static std::uint64_t packKey(int x, int y) noexcept
+    {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) |
+               static_cast<std::uint64_t>(static_cast<std::uint32_t>(y));
+    }
+
+    float mCellSize;
+    float mInvCellSize;
+    std::size_t mCount{0};
+    std::unordered_map<std::uint64_t, std::vector<Entry>> mCells;
+};
+
+#endif // SPATIAL_HASH_GRID_HPP
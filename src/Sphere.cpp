@@ -28,6 +28,11 @@ glm::vec3 Sphere::getCenter() const noexcept
     return glm::vec3(mCenter);
 }
 
+glm::vec3 Sphere::getAlbedo() const noexcept
+{
+    return glm::vec3(mAlbedo);
+}
+
 void Sphere::setMaterialType(Material::MaterialType type) noexcept
 {
     mMaterialType = static_cast<std::uint32_t>(type);
@@ -20,6 +20,7 @@ public:
 
     void setCenter(const glm::vec3 &cent) noexcept;
     glm::vec3 getCenter() const noexcept;
+    glm::vec3 getAlbedo() const noexcept;
     void setMaterialType(Material::MaterialType type) noexcept;
     Material::MaterialType getMaterialType() const noexcept;
     void setRadius(float rad) noexcept;
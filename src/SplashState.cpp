@@ -9,17 +9,28 @@
 #include <glm/glm.hpp>
 #include <glad/glad.h>
 
+#include "FlyThroughBenchmark.hpp"
 #include "Font.hpp"
+#include "InputRecorder.hpp"
 #include "LoadingState.hpp"
 #include "Options.hpp"
 #include "ResourceIdentifiers.hpp"
 #include "ResourceManager.hpp"
+#include "StartupTimeline.hpp"
 #include "StateStack.hpp"
 #include "Texture.hpp"
 
+namespace
+{
+    /// The prompt's slow pulse looks the same at 30 Hz as at display rate
+    constexpr std::uint32_t kPromptFrameMs = 33;
+} // namespace
+
 SplashState::SplashState(StateStack &stack, Context context)
-    : State(stack, context), mSplashTexture{}
+    : State(stack, context)
 {
+    StartupTimeline::mark("SplashState");
+
     try
     {
         mWhiteNoise = getContext().getSoundPlayer();
@@ -32,12 +43,12 @@ SplashState::SplashState(StateStack &stack, Context context)
     
     try
     {
-        mSplashTexture = &getContext().getTextureManager()->get(Textures::ID::FAA_LOGO);
+        mSplashTexture = getContext().getTextureManager()->acquire(Textures::ID::FAA_LOGO);
     }
     catch (const std::exception &e)
     {
         SDL_LogError(SDL_LOG_CATEGORY_ERROR, "SplashState: Failed to load splash texture: %s", e.what());
-        mSplashTexture = nullptr;
+        mSplashTexture.reset();
     }
 
     if (mWhiteNoise && mWhiteNoise->isEnabled())
@@ -89,7 +100,9 @@ void SplashState::draw() const noexcept
                      ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoSavedSettings |
                      ImGuiWindowFlags_NoBringToFrontOnFocus | ImGuiWindowFlags_NoBackground);
     ImGui::SetCursorPos(ImVec2(0, 0));
-    // Flip horizontally: swap uv0 and uv1 x values
+
+    // The logo is loaded on demand and kept out of the atlas, so it draws from its own texture
+    // Flip vertically: stb loads rows bottom-up, ImGui expects top-down
     ImGui::Image(
         static_cast<ImTextureID>(static_cast<intptr_t>(mSplashTexture->get())),
         screenSize,
@@ -131,6 +144,12 @@ void SplashState::draw() const noexcept
 
 bool SplashState::update(float dt, unsigned int subSteps) noexcept
 {
+    // Benchmarks and input replays do not wait for a key press
+    if ((StartupTimeline::isRunning() || FlyThroughBenchmark::isRunning() || InputRecorder::isReplaying()) &&
+        isLoadingComplete())
+    {
+        advanceToMenu();
+    }
     return true;
 }
 
@@ -147,19 +166,29 @@ bool SplashState::handleEvent(const SDL_Event &event) noexcept
         }
 
         SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "SplashState: Input received, transitioning to MenuState...");
-        if (mWhiteNoise && mWhiteNoise->isEnabled())
-        {
-            mWhiteNoise->stop(SoundEffect::ID::WHITE_NOISE);
-        }
-        // Pop SplashState only, keeping LoadingState and its loaded resources below
-        requestStackPop();
-        // Push MenuState on top of LoadingState
-        requestStackPush(States::ID::MENU);
+        advanceToMenu();
     }
 
     return true;
 }
 
+std::uint32_t SplashState::getIdleTimeoutMs() const noexcept
+{
+    return isLoadingComplete() ? kPromptFrameMs : 0;
+}
+
+void SplashState::advanceToMenu() noexcept
+{
+    if (mWhiteNoise && mWhiteNoise->isEnabled())
+    {
+        mWhiteNoise->stop(SoundEffect::ID::WHITE_NOISE);
+    }
+    // Pop SplashState only, keeping LoadingState and its loaded resources below
+    requestStackPop();
+    // Push MenuState on top of LoadingState
+    requestStackPush(States::ID::MENU);
+}
+
 bool SplashState::isLoadingComplete() const noexcept
 {
     // Check if the state below us (LoadingState) is finished
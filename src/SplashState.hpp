@@ -22,10 +22,15 @@ public:
     bool update(float dt, unsigned int subSteps) noexcept override;
     bool handleEvent(const SDL_Event &event) noexcept override;
 
+    /// Full rate while LoadingState below is still loading, then only as fast as the prompt pulses
+    [[nodiscard]] std::uint32_t getIdleTimeoutMs() const noexcept override;
+
 private:
     bool isLoadingComplete() const noexcept;
+    void advanceToMenu() noexcept;
     SoundPlayer *mWhiteNoise;
-    Texture *mSplashTexture;
+    /// Released with the state, which frees the one-shot logo
+    TextureManager::Handle mSplashTexture;
     Font *mFont;
 };
 
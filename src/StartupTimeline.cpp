@@ -0,0 +1,145 @@
+#include "StartupTimeline.hpp"
+
+#include "buildinfo.h"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <fstream>
+
+std::mutex StartupTimeline::sMutex;
+std::vector<StartupTimeline::Milestone> StartupTimeline::sMilestones;
+std::string StartupTimeline::sReportPath;
+std::chrono::steady_clock::time_point StartupTimeline::sOrigin;
+std::atomic<bool> StartupTimeline::sRunning{false};
+bool StartupTimeline::sFinished = false;
+bool StartupTimeline::sResult = false;
+
+namespace
+{
+    double toMilliseconds(std::chrono::steady_clock::duration duration) noexcept
+    {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    /// Milestone names are ours, but task names come from call sites; keep the JSON valid regardless
+    std::string escapeJson(std::string_view text)
+    {
+        std::string escaped;
+        escaped.reserve(text.size());
+        for (const char c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                escaped += '\\';
+            }
+            escaped += c;
+        }
+        return escaped;
+    }
+}
+
+void StartupTimeline::start(std::string reportPath)
+{
+    std::lock_guard<std::mutex> lock(sMutex);
+    sOrigin = std::chrono::steady_clock::now();
+    sReportPath = std::move(reportPath);
+    sMilestones.clear();
+    sMilestones.push_back(Milestone{"main", std::chrono::steady_clock::duration::zero()});
+    sFinished = false;
+    sResult = false;
+    sRunning.store(true, std::memory_order_release);
+}
+
+bool StartupTimeline::isRunning() noexcept
+{
+    return sRunning.load(std::memory_order_acquire);
+}
+
+void StartupTimeline::mark(std::string_view milestone)
+{
+    if (!isRunning())
+    {
+        return;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(sMutex);
+    if (std::ranges::none_of(sMilestones, [milestone](const Milestone &m) { return m.name == milestone; }))
+    {
+        sMilestones.push_back(Milestone{std::string(milestone), now - sOrigin});
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "StartupTimeline: %8.1f ms  %.*s", toMilliseconds(now - sOrigin),
+                    static_cast<int>(milestone.size()), milestone.data());
+    }
+}
+
+bool StartupTimeline::reached(std::string_view milestone)
+{
+    std::lock_guard<std::mutex> lock(sMutex);
+    return std::ranges::any_of(sMilestones, [milestone](const Milestone &m) { return m.name == milestone; });
+}
+
+bool StartupTimeline::hasTimedOut() noexcept
+{
+    return isRunning() && std::chrono::steady_clock::now() - sOrigin >= TIMEOUT;
+}
+
+bool StartupTimeline::finish()
+{
+    if (!isRunning())
+    {
+        return sResult;
+    }
+    sRunning.store(false, std::memory_order_release);
+
+    std::lock_guard<std::mutex> lock(sMutex);
+    if (sFinished)
+    {
+        return sResult;
+    }
+    sFinished = true;
+
+    const bool complete = std::ranges::any_of(sMilestones, [](const Milestone &m) { return m.name == FIRST_GAME_FRAME; });
+    if (!complete)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "StartupTimeline: ended before the first game frame");
+    }
+
+    sResult = writeReport(complete) && complete;
+    return sResult;
+}
+
+bool StartupTimeline::writeReport(bool complete)
+{
+    // Worker tasks can stamp out of order; the report reads as a timeline
+    std::ranges::stable_sort(sMilestones, {}, &Milestone::time);
+
+    std::ofstream out(sReportPath, std::ios::trunc);
+    if (!out)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "StartupTimeline: cannot write %s", sReportPath.c_str());
+        return false;
+    }
+
+    out << "{\n";
+    out << "  \"version\": \"" << escapeJson(bw::buildinfo::Version) << "\",\n";
+    out << "  \"complete\": " << (complete ? "true" : "false") << ",\n";
+    out << "  \"totalMs\": " << toMilliseconds(sMilestones.back().time) << ",\n";
+    out << "  \"milestones\": [\n";
+
+    auto previous = std::chrono::steady_clock::duration::zero();
+    for (std::size_t i = 0; i < sMilestones.size(); ++i)
+    {
+        const Milestone &milestone = sMilestones[i];
+        out << "    {\"name\": \"" << escapeJson(milestone.name) << "\", \"ms\": " << toMilliseconds(milestone.time)
+            << ", \"deltaMs\": " << toMilliseconds(milestone.time - previous) << "}"
+            << (i + 1 < sMilestones.size() ? ",\n" : "\n");
+        previous = milestone.time;
+    }
+
+    out << "  ]\n}\n";
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "StartupTimeline: %zu milestones, %.1f ms, report in %s",
+                sMilestones.size(), toMilliseconds(sMilestones.back().time), sReportPath.c_str());
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,62 @@
+#ifndef STARTUP_TIMELINE_HPP
+#define STARTUP_TIMELINE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// @brief Cold-start benchmark: milestone times from main() to the first game frame
+/// @details Started by `breakingwalls <config.json> --startup-benchmark[=report.json]`. While it runs,
+/// code along the startup path stamps milestones (each name once), SplashState and MenuState advance
+/// on their own instead of waiting for input, and GameState calls finish() after its first frame,
+/// which writes the JSON report and ends the run. Every call is a cheap no-op when not running.
+///
+/// Shader binaries, the chunk disk cache and the OS file cache persist between runs; clear the
+/// preference directory first for a truly cold number.
+class StartupTimeline
+{
+public:
+    static constexpr std::string_view FLAG = "--startup-benchmark";
+    static constexpr std::string_view DEFAULT_REPORT = "startup_benchmark.json";
+    /// The last milestone; a report without it is marked incomplete
+    static constexpr std::string_view FIRST_GAME_FRAME = "GameState first frame";
+    /// A run that has not finished by then writes what it has and quits
+    static constexpr std::chrono::seconds TIMEOUT{120};
+
+    /// Start timing now; call first thing in main()
+    static void start(std::string reportPath);
+
+    [[nodiscard]] static bool isRunning() noexcept;
+
+    /// Record milestone at the current time unless it was already recorded; any thread
+    static void mark(std::string_view milestone);
+    [[nodiscard]] static bool reached(std::string_view milestone);
+    [[nodiscard]] static bool hasTimedOut() noexcept;
+
+    /// @brief Stop the run and write the report; later calls return the first result
+    /// @return true if FIRST_GAME_FRAME was reached and the report was written
+    static bool finish();
+
+private:
+    struct Milestone
+    {
+        std::string name;
+        std::chrono::steady_clock::duration time;
+    };
+
+    [[nodiscard]] static bool writeReport(bool complete);
+
+    static std::mutex sMutex;
+    static std::vector<Milestone> sMilestones;
+    static std::string sReportPath;
+    static std::chrono::steady_clock::time_point sOrigin;
+    // Read by worker threads stamping load tasks
+    static std::atomic<bool> sRunning;
+    static bool sFinished;
+    static bool sResult;
+};
+
+#endif // STARTUP_TIMELINE_HPP
@@ -1,6 +1,7 @@
 #ifndef STATE_HPP
 #define STATE_HPP
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -10,6 +11,7 @@
 #include "HttpClient.hpp"
 #include "Player.hpp"
 #include "RenderWindow.hpp"
+#include "ResourceConfig.hpp"
 #include "ResourceIdentifiers.hpp"
 #include "ResourceManager.hpp"
 #include "SoundPlayer.hpp"
@@ -18,6 +20,7 @@
 #include <MazeBuilder/configurator.h>
 
 class StateStack;
+class TextureAtlas;
 
 union SDL_Event;
 
@@ -39,11 +42,13 @@ public:
         [[nodiscard]] SoundPlayer *getSoundPlayer() const noexcept { return mSounds.value_or(nullptr); }
         [[nodiscard]] ShaderManager *getShaderManager() const noexcept { return mShaders.value_or(nullptr); }
         [[nodiscard]] TextureManager *getTextureManager() const noexcept { return mTextures.value_or(nullptr); }
+        [[nodiscard]] TextureAtlas *getTextureAtlas() const noexcept { return mTextureAtlas.value_or(nullptr); }
         [[nodiscard]] VAOManager *getVAOManager() const noexcept { return mVAOs.value_or(nullptr); }
         [[nodiscard]] FBOManager *getFBOManager() const noexcept { return mFBOs.value_or(nullptr); }
         [[nodiscard]] VBOManager *getVBOManager() const noexcept { return mVBOs.value_or(nullptr); }
         [[nodiscard]] Player *getPlayer() const noexcept { return mPlayer.value_or(nullptr); }
         [[nodiscard]] HttpClient *getHttpClient() const noexcept { return mHttpClient.value_or(nullptr); }
+        [[nodiscard]] ResourceConfig *getResourceConfig() const noexcept { return mResourceConfig.value_or(nullptr); }
 
         Context &withRenderWindow(RenderWindow &window)
         {
@@ -105,6 +110,12 @@ public:
             return *this;
         }
 
+        Context &withTextureAtlas(TextureAtlas &atlas)
+        {
+            mTextureAtlas = &atlas;
+            return *this;
+        }
+
         Context &withVAOManager(VAOManager &vaos)
         {
             mVAOs = &vaos;
@@ -135,6 +146,13 @@ public:
             return *this;
         }
 
+        /// Filled once by LoadingState; read-only for every other state
+        Context &withResourceConfig(ResourceConfig &config)
+        {
+            mResourceConfig = &config;
+            return *this;
+        }
+
     private:
         std::optional<RenderWindow *> mWindow;
         std::optional<FontManager *> mFonts;
@@ -146,11 +164,13 @@ public:
         std::optional<SoundPlayer *> mSounds;
         std::optional<ShaderManager *> mShaders;
         std::optional<TextureManager *> mTextures;
+        std::optional<TextureAtlas *> mTextureAtlas;
         std::optional<VAOManager *> mVAOs;
         std::optional<FBOManager *> mFBOs;
         std::optional<VBOManager *> mVBOs;
         std::optional<Player *> mPlayer;
         std::optional<HttpClient *> mHttpClient;
+        std::optional<ResourceConfig *> mResourceConfig;
     }; // Context struct
 
     explicit State(StateStack &stack, Context context);
@@ -167,6 +187,26 @@ public:
     virtual void draw() const noexcept = 0;
     virtual bool update(float dt, unsigned int subSteps) noexcept = 0;
     virtual bool handleEvent(const SDL_Event &event) noexcept = 0;
+
+    /// Set by StateStack::draw: fraction of a fixed step elapsed since the last update
+    void setInterpolationAlpha(float alpha) noexcept { mInterpolationAlpha = alpha; }
+
+    /// Covers every pixel of the window, so StateStack::draw skips all states below it
+    [[nodiscard]] virtual bool isOpaque() const noexcept { return false; }
+
+    /// States below get no update() while this one is on the stack, and are drawn as covered
+    [[nodiscard]] virtual bool blocksUpdates() const noexcept { return false; }
+
+    /// Set by StateStack::draw: a state above blocks updates, so this one's frame cannot change
+    void setCovered(bool covered) noexcept { mCovered = covered; }
+
+    /// Redraw interval of a top state with nothing moving, so whatever update() polls still shows up
+    static constexpr std::uint32_t IDLE_REDRAW_MS = 500;
+
+    /// @brief How long the main loop may block waiting for input before this state needs another frame
+    /// @details Asked of the top state between frames. 0, the default, runs the loop at display rate;
+    /// gameplay states keep it. Menus return the time to their next animation frame, or IDLE_REDRAW_MS.
+    [[nodiscard]] virtual std::uint32_t getIdleTimeoutMs() const noexcept { return 0; }
 protected:
     void requestStackPush(States::ID stateID);
     void requestStackPop();
@@ -175,8 +215,15 @@ protected:
     Context getContext() const noexcept;
 
     StateStack &getStack() const noexcept;
+
+    [[nodiscard]] float getInterpolationAlpha() const noexcept { return mInterpolationAlpha; }
+
+    /// True while frozen under an update-blocking state; a cached copy of the last frame may be drawn instead
+    [[nodiscard]] bool isCovered() const noexcept { return mCovered; }
 private:
     StateStack *mStack;
     Context mContext;
+    float mInterpolationAlpha{1.0f};
+    bool mCovered{false};
 };
 #endif // STATE_HPP
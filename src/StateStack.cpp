@@ -1,5 +1,7 @@
 #include "StateStack.hpp"
 
+#include "CPUProfiler.hpp"
+
 #include <glad/glad.h>
 
 #include <SDL3/SDL.h>
@@ -7,18 +9,19 @@
 #include <stdexcept>
 
 StateStack::StateStack(State::Context context)
-    : mStack(), mPendingList(), mContext(context), mFactories()
+    : mStack(), mPendingList(), mContext(context), mFactories(), mPrewarmers()
 {
 }
 
 void StateStack::update(float dt, unsigned int subSteps) noexcept
 {
+    BW_PROFILE_ZONE("StateStack::update");
     // Process existing states (skip if empty)
     if (!mStack.empty())
     {
         for (auto it = mStack.rbegin(); it != mStack.rend(); ++it)
         {
-            if (!(*it)->update(dt, subSteps))
+            if (!(*it)->update(dt, subSteps) || (*it)->blocksUpdates())
             {
                 break;
             }
@@ -28,17 +31,35 @@ void StateStack::update(float dt, unsigned int subSteps) noexcept
     applyPendingChanges();
 }
 
-void StateStack::draw() const noexcept
+void StateStack::draw(float alpha) const noexcept
 {
+    BW_PROFILE_ZONE("StateStack::draw");
     if (mStack.empty())
     {
         SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "StateStack::draw called on empty stack");
         return;
     }
 
+    // Top down: nothing under the topmost opaque state shows through, and everything under an
+    // update-blocking state is frozen
+    auto first = mStack.cbegin();
+    bool blockedAbove = false;
+    for (auto it = mStack.cend(); it != mStack.cbegin();)
+    {
+        --it;
+        (*it)->setCovered(blockedAbove);
+        blockedAbove = blockedAbove || (*it)->blocksUpdates();
+        if ((*it)->isOpaque())
+        {
+            first = it;
+            break;
+        }
+    }
+
     // Draw from bottom to top so overlay states (pause/menu) render last
-    for (auto it = mStack.cbegin(); it != mStack.cend(); ++it)
+    for (auto it = first; it != mStack.cend(); ++it)
     {
+        (*it)->setInterpolationAlpha(alpha);
         (*it)->draw();
     }
 }
@@ -67,6 +88,14 @@ void StateStack::pushState(States::ID stateID)
     mPendingList.emplace_back(Action::PUSH, stateID);
 }
 
+void StateStack::prewarmState(States::ID stateID) noexcept
+{
+    if (auto found = mPrewarmers.find(stateID); found != mPrewarmers.cend())
+    {
+        found->second();
+    }
+}
+
 void StateStack::popState()
 {
     mPendingList.emplace_back(Action::POP);
@@ -82,6 +111,15 @@ bool StateStack::isEmpty() const noexcept
     return mStack.empty();
 }
 
+std::uint32_t StateStack::getIdleTimeoutMs() const noexcept
+{
+    if (mStack.empty() || !mPendingList.empty())
+    {
+        return 0;
+    }
+    return mStack.back()->getIdleTimeoutMs();
+}
+
 State::Ptr StateStack::createState(States::ID stateID)
 {
     if (auto found = mFactories.find(stateID); found != mFactories.cend())
@@ -94,6 +132,11 @@ State::Ptr StateStack::createState(States::ID stateID)
 
 void StateStack::applyPendingChanges()
 {
+    if (!mPendingList.empty())
+    {
+        ++mChangeCount;
+    }
+
     for (const PendingChange &change : mPendingList)
     {
         switch (change.action)
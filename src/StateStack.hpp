@@ -1,6 +1,7 @@
 #ifndef STATE_STACK_HPP
 #define STATE_STACK_HPP
 
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
@@ -42,12 +43,18 @@ public:
 
     void update(float dt, unsigned int subSteps) noexcept;
 
-    void draw() const noexcept;
+    /// @param alpha Fraction of a fixed step since the last update, forwarded to every state
+    void draw(float alpha = 1.0f) const noexcept;
 
     void handleEvent(const SDL_Event &event) noexcept;
 
     void pushState(States::ID stateID);
 
+    /// @brief Start the CPU-side construction work of a state that is likely to be pushed next
+    /// @details Forwards to the state's static prewarm(Context) when its type has one, so a later
+    /// push only finishes the GL side on the main thread. Unknown IDs and states without one are ignored.
+    void prewarmState(States::ID stateID) noexcept;
+
     void popState();
 
     void clearStates();
@@ -57,6 +64,12 @@ public:
 
     bool isEmpty() const noexcept;
 
+    /// @brief The top state's State::getIdleTimeoutMs(); 0 while the stack is empty or a change is pending
+    [[nodiscard]] std::uint32_t getIdleTimeoutMs() const noexcept;
+
+    /// Counts applied batches of pushes, pops and clears, so a caller can tell the top state may have changed
+    [[nodiscard]] std::uint64_t getChangeCount() const noexcept { return mChangeCount; }
+
 private:
     State::Ptr createState(States::ID stateID);
     void applyPendingChanges();
@@ -75,6 +88,8 @@ private:
     std::vector<PendingChange> mPendingList;
     State::Context mContext;
     std::map<States::ID, std::function<State::Ptr()>> mFactories;
+    std::map<States::ID, std::function<void()>> mPrewarmers;
+    std::uint64_t mChangeCount{0};
 };
 
 template <typename T>
@@ -82,6 +97,12 @@ void StateStack::registerState(States::ID stateID)
 {
     mFactories.insert_or_assign(stateID, [this]()
                                 { return State::Ptr(std::make_unique<T>(*this, mContext)); });
+
+    if constexpr (requires(State::Context context) { T::prewarm(context); })
+    {
+        mPrewarmers.insert_or_assign(stateID, [this]()
+                                     { T::prewarm(mContext); });
+    }
 }
 
 template <typename T, typename ResourcePath>
@@ -0,0 +1,183 @@
+#include "StreamingBuffer.hpp"
+
+#include <cstring>
+
+#include <SDL3/SDL.h>
+
+#include "RenderStats.hpp"
+
+namespace
+{
+    // One second; a fence older than REGION_COUNT frames that still is not signalled means a hung GPU
+    constexpr GLuint64 kFenceTimeoutNs = 1000000000ull;
+} // namespace
+
+bool StreamingBuffer::init(GLsizeiptr regionBytes) noexcept
+{
+    destroy();
+
+    if (regionBytes <= 0)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "StreamingBuffer::init called with non-positive size: %lld",
+                     static_cast<long long>(regionBytes));
+        return false;
+    }
+
+    const auto totalBytes = static_cast<GLsizeiptr>(regionBytes * static_cast<GLsizeiptr>(REGION_COUNT));
+
+    glGenBuffers(1, &mBuffer);
+    // The copy-write target keeps this from disturbing whatever array/uniform buffer callers have bound
+    glBindBuffer(GL_COPY_WRITE_BUFFER, mBuffer);
+
+    if (GLAD_GL_VERSION_4_4 && glBufferStorage)
+    {
+        constexpr GLbitfield kFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_COPY_WRITE_BUFFER, totalBytes, nullptr, kFlags);
+        mMapped = static_cast<unsigned char *>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, totalBytes, kFlags));
+        if (!mMapped)
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                        "StreamingBuffer: persistent map failed (err=0x%x), using glBufferSubData", glGetError());
+            // Immutable storage cannot be respecified, so start over with a mutable buffer
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            glDeleteBuffers(1, &mBuffer);
+            glGenBuffers(1, &mBuffer);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, mBuffer);
+        }
+    }
+
+    if (!mMapped)
+    {
+        RenderStats::bufferData(GL_COPY_WRITE_BUFFER, totalBytes, nullptr, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    mRegionBytes = regionBytes;
+    mRegion = 0;
+    mCursor = 0;
+    mOverflowWarned = false;
+
+    SDL_Log("StreamingBuffer: %d x %lld bytes (%s)", static_cast<int>(REGION_COUNT),
+            static_cast<long long>(regionBytes), mMapped ? "persistent map" : "glBufferSubData");
+    return true;
+}
+
+void StreamingBuffer::destroy() noexcept
+{
+    for (GLsync &fence : mFences)
+    {
+        if (fence)
+        {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+
+    if (mBuffer != 0)
+    {
+        if (mMapped)
+        {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, mBuffer);
+            glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        }
+        glDeleteBuffers(1, &mBuffer);
+        mBuffer = 0;
+    }
+
+    mMapped = nullptr;
+    mRegionBytes = 0;
+    mCursor = 0;
+}
+
+void StreamingBuffer::beginFrame() noexcept
+{
+    if (mBuffer == 0)
+    {
+        return;
+    }
+
+    mRegion = (mRegion + 1) % REGION_COUNT;
+    mCursor = 0;
+
+    GLsync &fence = mFences[mRegion];
+    if (!fence)
+    {
+        return;
+    }
+
+    GLbitfield flags = 0;
+    for (;;)
+    {
+        const GLenum status = glClientWaitSync(fence, flags, kFenceTimeoutNs);
+        if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+        {
+            break;
+        }
+        if (status == GL_WAIT_FAILED)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "StreamingBuffer: glClientWaitSync failed (err=0x%x)", glGetError());
+            break;
+        }
+        // Timed out: make sure the fence was actually submitted before waiting again
+        flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    }
+
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+void StreamingBuffer::endFrame() noexcept
+{
+    if (mBuffer == 0 || mCursor == 0)
+    {
+        return;
+    }
+
+    GLsync &fence = mFences[mRegion];
+    if (fence)
+    {
+        glDeleteSync(fence);
+    }
+    fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+GLintptr StreamingBuffer::write(const void *data, GLsizeiptr bytes, GLsizeiptr alignment) noexcept
+{
+    if (mBuffer == 0 || data == nullptr || bytes <= 0)
+    {
+        return INVALID_OFFSET;
+    }
+
+    // Align the absolute offset, not the region-relative one, so strides that are not powers of two work
+    const auto regionBase = static_cast<GLintptr>(mRegion) * mRegionBytes;
+    const GLsizeiptr step = (alignment > 0) ? alignment : 1;
+    const GLintptr offset = ((regionBase + mCursor + step - 1) / step) * step;
+
+    if (offset + bytes > regionBase + mRegionBytes)
+    {
+        if (!mOverflowWarned)
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                        "StreamingBuffer: frame region of %lld bytes is full, dropping a %lld byte write",
+                        static_cast<long long>(mRegionBytes), static_cast<long long>(bytes));
+            mOverflowWarned = true;
+        }
+        return INVALID_OFFSET;
+    }
+
+    if (mMapped)
+    {
+        std::memcpy(mMapped + offset, data, static_cast<std::size_t>(bytes));
+        RenderStats::countUploadBytes(bytes);
+    }
+    else
+    {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, mBuffer);
+        RenderStats::bufferSubData(GL_COPY_WRITE_BUFFER, offset, bytes, data);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+
+    mCursor = (offset + bytes) - regionBase;
+    return offset;
+}
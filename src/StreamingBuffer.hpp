@@ -0,0 +1,53 @@
+#ifndef STREAMING_BUFFER_HPP
+#define STREAMING_BUFFER_HPP
+
+#include <array>
+#include <cstddef>
+
+#include <glad/glad.h>
+
+/// @brief Ring of per-frame regions in one GPU buffer for data rewritten every frame
+/// @details With GL 4.4 the buffer is created with glBufferStorage and stays persistently mapped
+/// (coherent), so write() is a memcpy into GPU-visible memory. The buffer is split into REGION_COUNT
+/// regions; each frame sub-allocates linearly from one region and endFrame() fences it. beginFrame()
+/// waits on the fence of the region it is about to reuse, which the GPU finished frames ago in practice.
+/// On a 4.3 context the same ring is filled with glBufferSubData instead of a mapping.
+class StreamingBuffer
+{
+public:
+    static constexpr std::size_t REGION_COUNT = 3;
+    static constexpr GLintptr INVALID_OFFSET = -1;
+
+    /// @param regionBytes Bytes one frame may write before write() starts failing
+    /// @return false if the buffer could not be created or mapped
+    bool init(GLsizeiptr regionBytes) noexcept;
+    void destroy() noexcept;
+
+    /// Move to the next region, waiting until the GPU has stopped reading it
+    void beginFrame() noexcept;
+    /// Fence everything written this frame
+    void endFrame() noexcept;
+
+    /// @brief Copy data into this frame's region
+    /// @param alignment Byte multiple the returned offset must be (any positive value, e.g. a vertex stride)
+    /// @return Absolute offset into getBuffer(), or INVALID_OFFSET if the region is full
+    [[nodiscard]] GLintptr write(const void *data, GLsizeiptr bytes, GLsizeiptr alignment = 1) noexcept;
+
+    [[nodiscard]] GLuint getBuffer() const noexcept { return mBuffer; }
+    [[nodiscard]] bool isInitialized() const noexcept { return mBuffer != 0; }
+    [[nodiscard]] bool isPersistent() const noexcept { return mMapped != nullptr; }
+    [[nodiscard]] GLsizeiptr getRegionBytes() const noexcept { return mRegionBytes; }
+    /// Bytes written so far this frame
+    [[nodiscard]] GLsizeiptr getFrameBytes() const noexcept { return mCursor; }
+
+private:
+    GLuint mBuffer{0};
+    unsigned char *mMapped{nullptr};
+    GLsizeiptr mRegionBytes{0};
+    std::size_t mRegion{0};
+    GLsizeiptr mCursor{0};
+    std::array<GLsync, REGION_COUNT> mFences{};
+    bool mOverflowWarned{false};
+};
+
+#endif // STREAMING_BUFFER_HPP
@@ -0,0 +1,417 @@
+#include "Telemetry.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+#include "HttpClient.hpp"
+#include "JobSystem.hpp"
+#include "NetStats.hpp"
+
+extern "C"
+{
+    // Defined with the rest of stb_image_write in FrameCapture.cpp; returns a malloc'd zlib stream
+    unsigned char *stbi_zlib_compress(unsigned char *data, int data_len, int *out_len, int quality);
+}
+
+Telemetry::Settings Telemetry::sSettings{};
+HttpClient *Telemetry::sHttpClient = nullptr;
+std::string Telemetry::sSession;
+std::array<float, Telemetry::FRAME_WINDOW> Telemetry::sFrameMs{};
+std::size_t Telemetry::sFrameNext = 0;
+std::uint32_t Telemetry::sFrames = 0;
+std::uint32_t Telemetry::sHitches = 0;
+float Telemetry::sFrameMaxMs = 0.0f;
+float Telemetry::sElapsedMs = 0.0f;
+float Telemetry::sGpuFrameTotalMs = 0.0f;
+std::uint32_t Telemetry::sGpuFrames = 0;
+std::array<float, GPUProfiler::PASS_COUNT> Telemetry::sGpuPassTotalMs{};
+bool Telemetry::sHasNetwork = false;
+Telemetry::NetworkSample Telemetry::sNetwork{};
+std::array<Telemetry::Sample, Telemetry::RING_CAPACITY> Telemetry::sRing{};
+std::size_t Telemetry::sRingStart = 0;
+std::size_t Telemetry::sRingCount = 0;
+std::uint64_t Telemetry::sNextSequence = 0;
+std::future<std::uint32_t> Telemetry::sBatch;
+std::uint32_t Telemetry::sBatchRequest = 0;
+Telemetry::Stats Telemetry::sStats{};
+std::mutex Telemetry::sChunkMutex;
+Telemetry::ChunkCounters Telemetry::sChunks{};
+
+namespace
+{
+    /// stb raises anything lower to 5; the batches are a few kilobytes of repetitive JSON either way
+    constexpr int kZlibQuality = 5;
+
+    /// Value at fraction of the way through sorted, nearest rank
+    float percentile(const float *sorted, std::size_t count, float fraction) noexcept
+    {
+        const auto rank = static_cast<std::size_t>(fraction * static_cast<float>(count - 1) + 0.5f);
+        return sorted[std::min(rank, count - 1)];
+    }
+} // namespace
+
+void Telemetry::configure(const Settings &settings) noexcept
+{
+    const bool wasEnabled = sSettings.enabled;
+    sSettings = settings;
+    sSettings.intervalSeconds = std::clamp(settings.intervalSeconds, MIN_INTERVAL_SECONDS, MAX_INTERVAL_SECONDS);
+
+    if (sSettings.enabled && !wasEnabled)
+    {
+        // A new random id each time sharing is switched on, so batches group by run without naming the player
+        std::random_device device;
+        std::ostringstream session;
+        session << std::hex << std::setfill('0') << std::setw(8) << device() << std::setw(8) << device();
+        sSession = session.str();
+
+        sFrameNext = 0;
+        sFrames = 0;
+        sHitches = 0;
+        sFrameMaxMs = 0.0f;
+        sElapsedMs = 0.0f;
+        sGpuFrameTotalMs = 0.0f;
+        sGpuFrames = 0;
+        sGpuPassTotalMs.fill(0.0f);
+        sHasNetwork = false;
+        std::lock_guard<std::mutex> lock(sChunkMutex);
+        sChunks = ChunkCounters{};
+    }
+    else if (!sSettings.enabled)
+    {
+        // Nothing recorded before the player opted out is sent after it
+        sRingStart = 0;
+        sRingCount = 0;
+    }
+}
+
+void Telemetry::setHttpClient(HttpClient *httpClient) noexcept
+{
+    sHttpClient = httpClient;
+    // Ids are per client
+    sBatchRequest = 0;
+}
+
+void Telemetry::recordFrame(float frameMs) noexcept
+{
+    if (!sSettings.enabled)
+    {
+        return;
+    }
+
+    sFrameMs[sFrameNext] = frameMs;
+    sFrameNext = (sFrameNext + 1) % FRAME_WINDOW;
+    ++sFrames;
+    if (frameMs > HITCH_MS)
+    {
+        ++sHitches;
+    }
+    sFrameMaxMs = std::max(sFrameMaxMs, frameMs);
+    sElapsedMs += frameMs;
+
+    if (GPUProfiler::isEnabled())
+    {
+        if (const auto gpuMs = GPUProfiler::getLastFrameMs())
+        {
+            sGpuFrameTotalMs += *gpuMs;
+            ++sGpuFrames;
+            for (std::size_t pass = 0; pass < GPUProfiler::PASS_COUNT; ++pass)
+            {
+                sGpuPassTotalMs[pass] += GPUProfiler::getLastPassMs(static_cast<GPUProfiler::Pass>(pass)).value_or(0.0f);
+            }
+        }
+    }
+
+    if (sElapsedMs >= sSettings.intervalSeconds * 1000.0f)
+    {
+        takeSample();
+        postBatch(BATCH_SAMPLES, true);
+    }
+}
+
+void Telemetry::recordChunkArrival(float ms) noexcept
+{
+    // sSettings belongs to the main thread; configure() clears what gathers here while disabled
+    std::lock_guard<std::mutex> lock(sChunkMutex);
+    ++sChunks.arrived;
+    sChunks.totalMs += ms;
+    sChunks.maxMs = std::max(sChunks.maxMs, ms);
+}
+
+void Telemetry::recordLateChunk(float ms) noexcept
+{
+    std::lock_guard<std::mutex> lock(sChunkMutex);
+    sChunks.lateMs = std::max(sChunks.lateMs, ms);
+}
+
+void Telemetry::recordNetwork(const NetStats &stats) noexcept
+{
+    if (!sSettings.enabled)
+    {
+        return;
+    }
+
+    NetworkSample network;
+    std::uint32_t rttPeers = 0;
+    for (const auto &[key, peer] : stats.getPeers())
+    {
+        ++network.peers;
+        if (peer.hasRtt)
+        {
+            network.rttMs += peer.rttMs;
+            network.jitterMs += peer.jitterMs;
+            ++rttPeers;
+        }
+        network.lossPercent = std::max(network.lossPercent, peer.lossPercent);
+        network.bytesInPerSecond += peer.bytesInPerSecond;
+        network.bytesOutPerSecond += peer.bytesOutPerSecond;
+    }
+    if (rttPeers > 0)
+    {
+        network.rttMs /= static_cast<float>(rttPeers);
+        network.jitterMs /= static_cast<float>(rttPeers);
+    }
+    sNetwork = network;
+    sHasNetwork = network.peers > 0;
+}
+
+Telemetry::Stats Telemetry::getStats() noexcept
+{
+    return sStats;
+}
+
+void Telemetry::takeSample() noexcept
+{
+    Sample sample;
+    sample.sequence = sNextSequence++;
+    sample.seconds = sElapsedMs * 0.001f;
+    sample.frames = sFrames;
+    sample.hitches = sHitches;
+    sample.frameMaxMs = sFrameMaxMs;
+
+    // Percentiles over this interval's frames, or the last FRAME_WINDOW of them on a long interval
+    const std::size_t count = std::min<std::size_t>(sFrames, FRAME_WINDOW);
+    if (count > 0)
+    {
+        std::array<float, FRAME_WINDOW> sorted;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            sorted[i] = sFrameMs[(sFrameNext + FRAME_WINDOW - count + i) % FRAME_WINDOW];
+        }
+        std::sort(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(count));
+        sample.frameP50Ms = percentile(sorted.data(), count, 0.50f);
+        sample.frameP95Ms = percentile(sorted.data(), count, 0.95f);
+        sample.frameP99Ms = percentile(sorted.data(), count, 0.99f);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(sChunkMutex);
+        sample.chunksArrived = sChunks.arrived;
+        sample.chunkAverageMs = sChunks.arrived > 0 ? sChunks.totalMs / static_cast<float>(sChunks.arrived) : 0.0f;
+        sample.chunkMaxMs = sChunks.maxMs;
+        sample.lateChunkMs = sChunks.lateMs;
+        sChunks = ChunkCounters{};
+    }
+
+    if (sGpuFrames > 0)
+    {
+        const float frames = static_cast<float>(sGpuFrames);
+        sample.gpuFrameMs = sGpuFrameTotalMs / frames;
+        for (std::size_t pass = 0; pass < GPUProfiler::PASS_COUNT; ++pass)
+        {
+            sample.gpuPassMs[pass] = sGpuPassTotalMs[pass] / frames;
+        }
+    }
+
+    // NetStats publishes about once a second; a window with no publish leaves the network out
+    sample.hasNetwork = sHasNetwork;
+    sample.network = sNetwork;
+    sHasNetwork = false;
+
+    sFrames = 0;
+    sHitches = 0;
+    sFrameMaxMs = 0.0f;
+    sElapsedMs = 0.0f;
+    sGpuFrameTotalMs = 0.0f;
+    sGpuFrames = 0;
+    sGpuPassTotalMs.fill(0.0f);
+
+    if (sRingCount == RING_CAPACITY)
+    {
+        sRingStart = (sRingStart + 1) % RING_CAPACITY;
+        --sRingCount;
+        ++sStats.samplesDropped;
+    }
+    sRing[(sRingStart + sRingCount) % RING_CAPACITY] = sample;
+    ++sRingCount;
+    ++sStats.samples;
+}
+
+void Telemetry::postBatch(std::size_t minimumSamples, bool waitForServer) noexcept
+{
+    if (sHttpClient == nullptr || sRingCount < std::max<std::size_t>(minimumSamples, 1))
+    {
+        return;
+    }
+    if (sBatch.valid() && sBatch.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+        // The ring keeps filling meanwhile; a slow server costs the oldest samples, never a frame
+        return;
+    }
+
+    try
+    {
+        if (sBatch.valid())
+        {
+            sBatchRequest = sBatch.get();
+        }
+        if (waitForServer && sBatchRequest != 0 && sHttpClient->isPending(sBatchRequest))
+        {
+            return;
+        }
+
+        const std::size_t count = std::min(sRingCount, BATCH_SAMPLES);
+        std::vector<Sample> samples;
+        samples.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            samples.push_back(sRing[(sRingStart + i) % RING_CAPACITY]);
+        }
+
+        sBatch = JobSystem::instance()->submit(
+            [httpClient = sHttpClient, session = sSession, interval = sSettings.intervalSeconds,
+             dropped = sStats.samplesDropped, samples = std::move(samples)]()
+            { return send(*httpClient, serialize(session, interval, dropped, samples)); });
+
+        sRingStart = (sRingStart + count) % RING_CAPACITY;
+        sRingCount -= count;
+        ++sStats.batchesPosted;
+    }
+    catch (const std::exception &e)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Telemetry: Cannot queue batch: %s", e.what());
+    }
+}
+
+std::string Telemetry::serialize(const std::string &session, float intervalSeconds, std::uint64_t dropped,
+                                 const std::vector<Sample> &samples)
+{
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(2);
+    json << "{\"session\":\"" << session << "\""
+         << ",\"interval_s\":" << intervalSeconds
+         << ",\"dropped\":" << dropped
+         << ",\"samples\":[";
+    for (std::size_t i = 0; i < samples.size(); ++i)
+    {
+        const Sample &sample = samples[i];
+        json << (i == 0 ? "" : ",")
+             << "{\"seq\":" << sample.sequence
+             << ",\"seconds\":" << sample.seconds
+             << ",\"frames\":" << sample.frames
+             << ",\"hitches\":" << sample.hitches
+             << ",\"frame_ms\":{\"p50\":" << sample.frameP50Ms
+             << ",\"p95\":" << sample.frameP95Ms
+             << ",\"p99\":" << sample.frameP99Ms
+             << ",\"max\":" << sample.frameMaxMs << "}"
+             << ",\"chunks\":{\"arrived\":" << sample.chunksArrived
+             << ",\"avg_ms\":" << sample.chunkAverageMs
+             << ",\"max_ms\":" << sample.chunkMaxMs
+             << ",\"late_ms\":" << sample.lateChunkMs << "}"
+             << ",\"gpu_ms\":{\"frame\":" << sample.gpuFrameMs;
+        for (std::size_t pass = 0; pass < GPUProfiler::PASS_COUNT; ++pass)
+        {
+            json << ",\"" << GPUProfiler::getPassName(static_cast<GPUProfiler::Pass>(pass)) << "\":"
+                 << sample.gpuPassMs[pass];
+        }
+        json << "}";
+        if (sample.hasNetwork)
+        {
+            json << ",\"net\":{\"peers\":" << sample.network.peers
+                 << ",\"rtt_ms\":" << sample.network.rttMs
+                 << ",\"jitter_ms\":" << sample.network.jitterMs
+                 << ",\"loss_pct\":" << sample.network.lossPercent
+                 << ",\"bytes_in_s\":" << sample.network.bytesInPerSecond
+                 << ",\"bytes_out_s\":" << sample.network.bytesOutPerSecond << "}";
+        }
+        json << "}";
+    }
+    json << "]}";
+    return json.str();
+}
+
+std::uint32_t Telemetry::send(HttpClient &httpClient, const std::string &json) noexcept
+{
+    try
+    {
+        int compressedLength = 0;
+        // stb only reads the input, but takes it as non-const
+        unsigned char *compressed = stbi_zlib_compress(
+            reinterpret_cast<unsigned char *>(const_cast<char *>(json.data())), static_cast<int>(json.size()),
+            &compressedLength, kZlibQuality);
+        if (compressed == nullptr)
+        {
+            return httpClient.postAndForget(BATCH_PATH, json, "application/json");
+        }
+
+        std::string body(reinterpret_cast<const char *>(compressed), static_cast<std::size_t>(compressedLength));
+        std::free(compressed);
+        // A zlib stream is what HTTP calls deflate
+        return httpClient.postAndForget(BATCH_PATH, std::move(body), "application/json", "deflate");
+    }
+    catch (const std::exception &e)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Telemetry: Cannot send batch: %s", e.what());
+    }
+    return 0;
+}
+
+void Telemetry::waitForBatch() noexcept
+{
+    if (!sBatch.valid())
+    {
+        return;
+    }
+
+    // Without worker threads nothing else will ever run the job
+    auto &jobs = *JobSystem::instance();
+    if (jobs.isCooperative())
+    {
+        while (sBatch.wait_for(std::chrono::seconds(0)) != std::future_status::ready && jobs.runPendingJob())
+        {
+        }
+    }
+    try
+    {
+        sBatchRequest = sBatch.get();
+    }
+    catch (const std::exception &e)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Telemetry: Batch job failed: %s", e.what());
+        sBatchRequest = 0;
+    }
+}
+
+void Telemetry::shutdown() noexcept
+{
+    waitForBatch();
+
+    // A partial last batch, then whatever a slow server left behind
+    while (sSettings.enabled && sHttpClient != nullptr && sRingCount > 0)
+    {
+        const std::size_t before = sRingCount;
+        // Queued behind the last post; the HttpClient destructor drains them for a while
+        postBatch(1, false);
+        waitForBatch();
+        if (sRingCount == before)
+        {
+            break;
+        }
+    }
+    sHttpClient = nullptr;
+}
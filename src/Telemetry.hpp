@@ -0,0 +1,163 @@
+#ifndef TELEMETRY_HPP
+#define TELEMETRY_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "GPUProfiler.hpp"
+
+class HttpClient;
+class NetStats;
+
+/// @brief Opt-in performance telemetry, aggregated in-process and posted in compressed batches
+/// @details recordFrame() keeps the last FRAME_WINDOW frame times; every intervalSeconds of frame time
+/// they are reduced to one Sample of percentiles and hitch counts, together with the chunk arrivals,
+/// GPU pass timings and network stats gathered over the same interval. Samples go into a ring of
+/// RING_CAPACITY, which overwrites the oldest when the server falls behind. Once BATCH_SAMPLES are
+/// waiting a job serializes them to JSON, zlib-compresses them and hands the body to HttpClient, whose
+/// I/O thread posts it to BATCH_PATH on the network_url server. The next batch waits until that post got
+/// a response or failed, so a slow server costs samples in the ring rather than a growing send queue.
+/// The main thread never serializes, compresses or touches a socket.
+class Telemetry
+{
+public:
+    static constexpr std::size_t FRAME_WINDOW = 1024;
+    /// Five minutes of samples at the default one-second interval
+    static constexpr std::size_t RING_CAPACITY = 300;
+    static constexpr std::size_t BATCH_SAMPLES = 30;
+    static constexpr float HITCH_MS = 50.0f;
+    static constexpr float MIN_INTERVAL_SECONDS = 1.0f;
+    static constexpr float MAX_INTERVAL_SECONDS = 10.0f;
+    static constexpr const char *BATCH_PATH = "/telemetry/batches";
+
+    struct Settings
+    {
+        bool enabled{false};
+        /// Frame time between samples; clamped to [MIN_INTERVAL_SECONDS, MAX_INTERVAL_SECONDS]
+        float intervalSeconds{1.0f};
+    };
+
+    /// Peers averaged, except loss which is the worst peer's and traffic which is summed
+    struct NetworkSample
+    {
+        std::uint32_t peers{0};
+        float rttMs{0.0f};
+        float jitterMs{0.0f};
+        float lossPercent{0.0f};
+        float bytesInPerSecond{0.0f};
+        float bytesOutPerSecond{0.0f};
+    };
+
+    struct Sample
+    {
+        std::uint64_t sequence{0};
+        float seconds{0.0f};
+        std::uint32_t frames{0};
+        /// Frames slower than HITCH_MS
+        std::uint32_t hitches{0};
+        float frameP50Ms{0.0f};
+        float frameP95Ms{0.0f};
+        float frameP99Ms{0.0f};
+        float frameMaxMs{0.0f};
+        std::uint32_t chunksArrived{0};
+        float chunkAverageMs{0.0f};
+        float chunkMaxMs{0.0f};
+        /// Worst wait for a chunk the player was standing on, 0 if none was late
+        float lateChunkMs{0.0f};
+        /// Averages over the interval; all 0 while GPUProfiler is disabled
+        float gpuFrameMs{0.0f};
+        std::array<float, GPUProfiler::PASS_COUNT> gpuPassMs{};
+        bool hasNetwork{false};
+        NetworkSample network;
+    };
+
+    struct Stats
+    {
+        std::uint64_t samples{0};
+        /// Batches handed to HttpClient; whether the server took them is not tracked
+        std::uint64_t batchesPosted{0};
+        /// Overwritten in the ring before they could be posted
+        std::uint64_t samplesDropped{0};
+    };
+
+    static void configure(const Settings &settings) noexcept;
+    [[nodiscard]] static const Settings &getSettings() noexcept { return sSettings; }
+
+    /// @brief Where batches are posted; nothing is sent while it is null
+    static void setHttpClient(HttpClient *httpClient) noexcept;
+
+    /// @brief Add one frame's wall time; call once per frame on the main thread
+    static void recordFrame(float frameMs) noexcept;
+
+    /// @brief A generated chunk was collected ms after it was requested; any thread
+    static void recordChunkArrival(float ms) noexcept;
+
+    /// @brief The player waited ms for the chunk under them; any thread
+    static void recordLateChunk(float ms) noexcept;
+
+    /// @brief Take the peers from the window stats just published; main thread
+    static void recordNetwork(const NetStats &stats) noexcept;
+
+    [[nodiscard]] static Stats getStats() noexcept;
+
+    /// @brief Wait for the batch in flight and queue what is left in the ring
+    /// @details Call before the HttpClient is destroyed; it keeps sending queued batches for up to
+    /// HttpClient::SHUTDOWN_DRAIN_SECONDS, so the last one is lost only if the server is down or slow
+    static void shutdown() noexcept;
+
+private:
+    /// Filled off the main thread by chunk jobs and the simulation thread, taken under sChunkMutex
+    struct ChunkCounters
+    {
+        std::uint32_t arrived{0};
+        float totalMs{0.0f};
+        float maxMs{0.0f};
+        float lateMs{0.0f};
+    };
+
+    static void takeSample() noexcept;
+    /// @brief Move up to BATCH_SAMPLES out of the ring into a posting job, once the previous job has run
+    /// @param waitForServer Also hold the batch back while HttpClient still has the previous post queued or running
+    static void postBatch(std::size_t minimumSamples, bool waitForServer) noexcept;
+    /// Block until the posting job has run; it reads sHttpClient's pointee
+    static void waitForBatch() noexcept;
+    [[nodiscard]] static std::string serialize(const std::string &session, float intervalSeconds,
+                                               std::uint64_t dropped, const std::vector<Sample> &samples);
+    /// @return The post's HttpClient::RequestId, 0 if nothing was queued
+    [[nodiscard]] static std::uint32_t send(HttpClient &httpClient, const std::string &json) noexcept;
+
+    static Settings sSettings;
+    static HttpClient *sHttpClient;
+    static std::string sSession;
+
+    // Main thread
+    static std::array<float, FRAME_WINDOW> sFrameMs;
+    static std::size_t sFrameNext;
+    static std::uint32_t sFrames;
+    static std::uint32_t sHitches;
+    static float sFrameMaxMs;
+    static float sElapsedMs;
+    static float sGpuFrameTotalMs;
+    static std::uint32_t sGpuFrames;
+    static std::array<float, GPUProfiler::PASS_COUNT> sGpuPassTotalMs;
+    static bool sHasNetwork;
+    static NetworkSample sNetwork;
+    static std::array<Sample, RING_CAPACITY> sRing;
+    static std::size_t sRingStart;
+    static std::size_t sRingCount;
+    static std::uint64_t sNextSequence;
+    /// Yields the HttpClient::RequestId of the post, kept in sBatchRequest once the job has run
+    static std::future<std::uint32_t> sBatch;
+    static std::uint32_t sBatchRequest;
+    static Stats sStats;
+
+    static std::mutex sChunkMutex;
+    static ChunkCounters sChunks;
+};
+
+#endif // TELEMETRY_HPP
@@ -1,5 +1,9 @@
 #include "Texture.hpp"
 
+#include "AssetPack.hpp"
+#include "GLStateCache.hpp"
+#include "MemoryStats.hpp"
+
 #include <glad/glad.h>
 
 #include <SDL3/SDL.h>
@@ -10,10 +14,32 @@
 #include <stb/stb_image.h>
 
 #include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
 #include <vector>
 
 namespace
 {
+    /// Base level plus the mip chain glGenerateMipmap adds (a third of the base)
+    constexpr std::size_t withMips(std::size_t baseBytes) noexcept
+    {
+        return baseBytes + baseBytes / 3;
+    }
+
+    /// Decode to RGBA from the mounted asset pack when the file is packed, else from disk
+    stbi_uc *loadImage(const std::string &path, int &width, int &height, int &components) noexcept
+    {
+        if (const auto packed = AssetPack::find(path); !packed.empty())
+        {
+            return stbi_load_from_memory(packed.data(), static_cast<int>(packed.size()), &width, &height, &components, 4);
+        }
+        return stbi_load(path.c_str(), &width, &height, &components, 4);
+    }
+
     /// Create a rotated copy of RGBA texture data (180 degrees)
     std::vector<std::uint8_t> rotate180(const std::uint8_t *data, int width, int height) noexcept
     {
@@ -41,10 +67,78 @@ namespace
 
         return rotated;
     }
+
+    // Compressed formats the bundled glad loader does not define (S3TC and ASTC are extensions)
+    constexpr std::uint32_t kCompressedRgbS3tcDxt1 = 0x83F0;
+    constexpr std::uint32_t kCompressedRgbaS3tcDxt1 = 0x83F1;
+    constexpr std::uint32_t kCompressedRgbaS3tcDxt5 = 0x83F3;
+    constexpr std::uint32_t kCompressedSrgbAlphaBptc = 0x8E8D;
+    constexpr std::uint32_t kCompressedRgbaAstc4x4 = 0x93B0;
+    constexpr std::uint32_t kCompressedRgbaAstc8x8 = 0x93B7;
+    constexpr std::uint32_t kCompressedSrgbAlphaAstc4x4 = 0x93D0;
+    constexpr std::uint32_t kCompressedSrgbAlphaAstc8x8 = 0x93D7;
+
+    struct KTX2Format
+    {
+        std::uint32_t vkFormat;
+        std::uint32_t glFormat;
+        int blockWidth;
+        int blockHeight;
+        int blockBytes;
+    };
+
+    // vkFormat values from the Vulkan spec, as written by KTX-Software
+    constexpr std::array<KTX2Format, 9> kKTX2Formats{{
+        {131, kCompressedRgbS3tcDxt1, 4, 4, 8},                 // BC1_RGB_UNORM
+        {133, kCompressedRgbaS3tcDxt1, 4, 4, 8},                // BC1_RGBA_UNORM
+        {137, kCompressedRgbaS3tcDxt5, 4, 4, 16},               // BC3_UNORM
+        {145, GL_COMPRESSED_RGBA_BPTC_UNORM, 4, 4, 16},         // BC7_UNORM
+        {146, kCompressedSrgbAlphaBptc, 4, 4, 16},              // BC7_SRGB
+        {157, kCompressedRgbaAstc4x4, 4, 4, 16},                // ASTC_4x4_UNORM
+        {158, kCompressedSrgbAlphaAstc4x4, 4, 4, 16},           // ASTC_4x4_SRGB
+        {171, kCompressedRgbaAstc8x8, 8, 8, 16},                // ASTC_8x8_UNORM
+        {172, kCompressedSrgbAlphaAstc8x8, 8, 8, 16},           // ASTC_8x8_SRGB
+    }};
+
+    constexpr std::array<std::uint8_t, 12> kKTX2Identifier{
+        0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+    struct KTX2Header
+    {
+        std::uint32_t vkFormat;
+        std::uint32_t typeSize;
+        std::uint32_t pixelWidth;
+        std::uint32_t pixelHeight;
+        std::uint32_t pixelDepth;
+        std::uint32_t layerCount;
+        std::uint32_t faceCount;
+        std::uint32_t levelCount;
+        std::uint32_t supercompressionScheme;
+        std::uint32_t dfdByteOffset;
+        std::uint32_t dfdByteLength;
+        std::uint32_t kvdByteOffset;
+        std::uint32_t kvdByteLength;
+        // sgdByteOffset and sgdByteLength are uint64 at a 4-byte struct offset; unused without supercompression
+        std::uint32_t sgdByteRange[4];
+    };
+
+    struct KTX2LevelIndex
+    {
+        std::uint64_t byteOffset;
+        std::uint64_t byteLength;
+        std::uint64_t uncompressedByteLength;
+    };
+
+    static_assert(sizeof(KTX2Header) == 68, "KTX2 header must be tightly packed");
+    static_assert(sizeof(KTX2LevelIndex) == 24, "KTX2 level index must be tightly packed");
+
+    std::once_flag sCompressedFormatsOnce;
+    std::vector<GLint> sCompressedFormats;
 } // anonymous namespace
 
 Texture::Texture(Texture &&other) noexcept
-    : mTextureId(other.mTextureId), mWidth(other.mWidth), mHeight(other.mHeight), mBytes(other.mBytes)
+    : mTextureId(other.mTextureId), mWidth(other.mWidth), mHeight(other.mHeight), mBytes(other.mBytes),
+      mGpuBytes(std::move(other.mGpuBytes))
 {
     other.mTextureId = 0;
     other.mWidth = 0;
@@ -67,6 +161,7 @@ Texture &Texture::operator=(Texture &&other) noexcept
         mWidth = other.mWidth;
         mHeight = other.mHeight;
         mBytes = other.mBytes;
+        mGpuBytes = std::move(other.mGpuBytes);
 
         other.mTextureId = 0;
         other.mWidth = 0;
@@ -80,11 +175,13 @@ void Texture::free() noexcept
 {
     if (mTextureId != 0)
     {
+        GLStateCache::forgetTexture(mTextureId);
         glDeleteTextures(1, &mTextureId);
         mTextureId = 0;
         mWidth = 0;
         mHeight = 0;
         mBytes = nullptr;
+        mGpuBytes.set(0);
     }
 }
 
@@ -130,6 +227,10 @@ bool Texture::loadRenderTarget(const int width, const int height,
 
     GLenum internalFormat = GL_RGBA32F;
     GLenum uploadFormat = GL_RGBA;
+    GLenum uploadType = GL_FLOAT;
+    std::size_t texelBytes = 16;
+    bool depth = false;
+    bool nearest = false;
 
     switch (format)
     {
@@ -140,22 +241,51 @@ bool Texture::loadRenderTarget(const int width, const int height,
     case RenderTargetFormat::RGBA16F:
         internalFormat = GL_RGBA16F;
         uploadFormat = GL_RGBA;
+        texelBytes = 8;
         break;
     case RenderTargetFormat::R16F:
         internalFormat = GL_R16F;
         uploadFormat = GL_RED;
+        texelBytes = 2;
+        break;
+    case RenderTargetFormat::R8:
+        internalFormat = GL_R8;
+        uploadFormat = GL_RED;
+        uploadType = GL_UNSIGNED_BYTE;
+        texelBytes = 1;
+        break;
+    case RenderTargetFormat::DEPTH24:
+        internalFormat = GL_DEPTH_COMPONENT24;
+        uploadFormat = GL_DEPTH_COMPONENT;
+        texelBytes = 4;
+        depth = true;
+        break;
+    case RenderTargetFormat::DEPTH24_STENCIL8:
+        internalFormat = GL_DEPTH24_STENCIL8;
+        uploadFormat = GL_DEPTH_STENCIL;
+        uploadType = GL_UNSIGNED_INT_24_8;
+        texelBytes = 4;
+        nearest = true;
         break;
     }
 
     glGenTextures(1, &mTextureId);
-    glActiveTexture(GL_TEXTURE0 + channelOffset);
-    glBindTexture(GL_TEXTURE_2D, mTextureId);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    GLStateCache::activeTexture(GL_TEXTURE0 + channelOffset);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mTextureId);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, nearest ? GL_NEAREST : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, nearest ? GL_NEAREST : GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, uploadFormat, GL_FLOAT, nullptr);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    if (depth)
+    {
+        // Linear filtering on a compare texture gives 2x2 PCF for free
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+    }
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, uploadFormat, uploadType, nullptr);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, 0);
+    mGpuBytes.set(MemoryStats::Category::GPU_RENDER_TARGETS,
+                  static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * texelBytes);
 
     return true;
 }
@@ -164,13 +294,22 @@ bool Texture::loadFromFile(const std::string_view filepath, const std::uint32_t
 {
     this->free();
 
+    // Prefer the offline-compressed copy; anything the driver cannot sample falls through to the image file
+    queryCompressedFormats();
+    if (CompressedImage compressed; readKTX2(compressedPathFor(filepath), compressed) &&
+                                    isCompressedFormatSupported(compressed.internalFormat) &&
+                                    loadCompressed(compressed, channelOffset))
+    {
+        return true;
+    }
+
     stbi_set_flip_vertically_on_load(true);
 
     int width, height;
     int components;
 
     // Force RGBA (4 components) for consistency
-    auto *data = stbi_load(filepath.data(), &width, &height, &components, 4);
+    auto *data = loadImage(std::string(filepath), width, height, components);
 
     if (data == nullptr)
     {
@@ -180,8 +319,8 @@ bool Texture::loadFromFile(const std::string_view filepath, const std::uint32_t
     }
 
     glGenTextures(1, &mTextureId);
-    glActiveTexture(GL_TEXTURE0 + channelOffset);
-    glBindTexture(GL_TEXTURE_2D, mTextureId);
+    GLStateCache::activeTexture(GL_TEXTURE0 + channelOffset);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mTextureId);
 
     // Set texture parameters
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -209,6 +348,259 @@ bool Texture::loadFromFile(const std::string_view filepath, const std::uint32_t
     mHeight = height;
     mBytes = data;
     stbi_image_free(data);
+    mGpuBytes.set(MemoryStats::Category::GPU_TEXTURES,
+                  withMips(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4));
+
+    return true;
+}
+
+std::string Texture::compressedPathFor(const std::string_view filepath)
+{
+    return std::filesystem::path(filepath).replace_extension(".ktx2").string();
+}
+
+bool Texture::readKTX2(const std::string_view filepath, CompressedImage &out) noexcept
+{
+    const std::string path{filepath};
+
+    try
+    {
+        std::vector<std::uint8_t> bytes;
+        if (const auto packed = AssetPack::find(path); !packed.empty())
+        {
+            // Copied all the same: the image owns its blocks after this returns
+            bytes.assign(packed.begin(), packed.end());
+        }
+        else
+        {
+            std::error_code ec;
+            if (!std::filesystem::exists(path, ec))
+            {
+                return false;
+            }
+
+            std::ifstream in(path, std::ios::binary | std::ios::ate);
+            if (!in)
+            {
+                return false;
+            }
+            bytes.resize(static_cast<std::size_t>(in.tellg()));
+            in.seekg(0);
+
+            in.read(reinterpret_cast<char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            if (!in)
+            {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "KTX2 %s: short read", path.c_str());
+                return false;
+            }
+        }
+        const std::size_t fileSize = bytes.size();
+
+        const std::size_t headerEnd = kKTX2Identifier.size() + sizeof(KTX2Header);
+        if (fileSize < headerEnd ||
+            std::memcmp(bytes.data(), kKTX2Identifier.data(), kKTX2Identifier.size()) != 0)
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "KTX2 %s: not a KTX2 file", path.c_str());
+            return false;
+        }
+
+        KTX2Header header{};
+        std::memcpy(&header, bytes.data() + kKTX2Identifier.size(), sizeof(KTX2Header));
+
+        // Basis supercompression would need a transcoder; the offline step writes raw blocks instead
+        if (header.supercompressionScheme != 0 || header.pixelDepth > 1 || header.layerCount > 1 ||
+            header.faceCount != 1 || header.pixelWidth == 0 || header.pixelHeight == 0)
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                        "KTX2 %s: only single 2D images without supercompression are supported", path.c_str());
+            return false;
+        }
+
+        const auto format = std::find_if(kKTX2Formats.begin(), kKTX2Formats.end(),
+                                         [&header](const KTX2Format &f)
+                                         { return f.vkFormat == header.vkFormat; });
+        if (format == kKTX2Formats.end())
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "KTX2 %s: unsupported vkFormat %u", path.c_str(), header.vkFormat);
+            return false;
+        }
+
+        const std::uint32_t levelCount = std::max(header.levelCount, 1u);
+        if (fileSize < headerEnd + levelCount * sizeof(KTX2LevelIndex))
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "KTX2 %s: level index is truncated", path.c_str());
+            return false;
+        }
+
+        out.levels.clear();
+        out.levels.reserve(levelCount);
+        for (std::uint32_t level = 0; level < levelCount; ++level)
+        {
+            KTX2LevelIndex index{};
+            std::memcpy(&index, bytes.data() + headerEnd + level * sizeof(KTX2LevelIndex), sizeof(KTX2LevelIndex));
+
+            const int width = std::max(1, static_cast<int>(header.pixelWidth >> level));
+            const int height = std::max(1, static_cast<int>(header.pixelHeight >> level));
+            const auto blocks = static_cast<std::uint64_t>((width + format->blockWidth - 1) / format->blockWidth) *
+                                static_cast<std::uint64_t>((height + format->blockHeight - 1) / format->blockHeight);
+
+            if (index.byteOffset > fileSize || index.byteLength > fileSize - index.byteOffset ||
+                index.byteLength < blocks * static_cast<std::uint64_t>(format->blockBytes))
+            {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "KTX2 %s: level %u is out of range", path.c_str(), level);
+                return false;
+            }
+
+            out.levels.push_back(CompressedImage::Level{static_cast<std::size_t>(index.byteOffset),
+                                                        static_cast<std::size_t>(index.byteLength), width, height});
+        }
+
+        out.data = std::move(bytes);
+        out.internalFormat = format->glFormat;
+        out.width = static_cast<int>(header.pixelWidth);
+        out.height = static_cast<int>(header.pixelHeight);
+    }
+    catch (const std::exception &e)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "KTX2 %s: %s", path.c_str(), e.what());
+        return false;
+    }
+
+    return true;
+}
+
+void Texture::queryCompressedFormats() noexcept
+{
+    std::call_once(sCompressedFormatsOnce, []()
+                   {
+                       GLint count = 0;
+                       glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &count);
+                       if (count > 0)
+                       {
+                           sCompressedFormats.resize(static_cast<std::size_t>(count));
+                           glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, sCompressedFormats.data());
+                       }
+                       SDL_Log("Texture: driver lists %d compressed formats", count); });
+}
+
+bool Texture::isCompressedFormatSupported(const std::uint32_t internalFormat) noexcept
+{
+    return std::find(sCompressedFormats.begin(), sCompressedFormats.end(),
+                     static_cast<GLint>(internalFormat)) != sCompressedFormats.end();
+}
+
+bool Texture::loadCompressed(const CompressedImage &image, const std::uint32_t channelOffset) noexcept
+{
+    if (image.levels.empty() || image.width <= 0 || image.height <= 0)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Invalid parameters for loadCompressed\n");
+        return false;
+    }
+
+    this->free();
+
+    glGenTextures(1, &mTextureId);
+    GLStateCache::activeTexture(GL_TEXTURE0 + channelOffset);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mTextureId);
+
+    // Same sampling as loadFromFile; the mip chain comes from the file instead of glGenerateMipmap
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(image.levels.size() - 1));
+
+    for (std::size_t level = 0; level < image.levels.size(); ++level)
+    {
+        const auto &mip = image.levels[level];
+        glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), static_cast<GLenum>(image.internalFormat),
+                               mip.width, mip.height, 0, static_cast<GLsizei>(mip.size), image.data.data() + mip.offset);
+    }
+
+    if (const GLenum error = glGetError(); error != GL_NO_ERROR)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "OpenGL error after compressed upload (format 0x%x): 0x%x\n",
+                     image.internalFormat, error);
+        this->free();
+        return false;
+    }
+
+    mWidth = image.width;
+    mHeight = image.height;
+    mBytes = nullptr;
+
+    std::size_t compressedBytes = 0;
+    for (const auto &mip : image.levels)
+    {
+        compressedBytes += mip.size;
+    }
+    mGpuBytes.set(MemoryStats::Category::GPU_TEXTURES, compressedBytes);
+
+    return true;
+}
+
+void Texture::PixelDeleter::operator()(std::uint8_t *pixels) const noexcept
+{
+    stbi_image_free(pixels);
+}
+
+bool Texture::decodeFile(const std::string_view filepath, DecodedImage &out) noexcept
+{
+    // The flip flag is per thread here, so concurrent decodes on job workers do not race on it
+    stbi_set_flip_vertically_on_load_thread(true);
+
+    int width, height;
+    int components;
+
+    const std::string path{filepath};
+    auto *data = loadImage(path, width, height, components);
+    if (data == nullptr)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "stbi_load %s failed: %s\n",
+                     path.c_str(), stbi_failure_reason());
+        return false;
+    }
+
+    out.pixels.reset(data);
+    out.width = width;
+    out.height = height;
+    return true;
+}
+
+bool Texture::loadFromUnpackBuffer(const int width, const int height, const std::uint32_t channelOffset) noexcept
+{
+    if (width <= 0 || height <= 0)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Invalid parameters for loadFromUnpackBuffer\n");
+        return false;
+    }
+
+    this->free();
+
+    glGenTextures(1, &mTextureId);
+    GLStateCache::activeTexture(GL_TEXTURE0 + channelOffset);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mTextureId);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    // With an unpack buffer bound the pointer argument is an offset into it
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glGenerateMipmap(GL_TEXTURE_2D);
+
+    if (const GLenum error = glGetError(); error != GL_NO_ERROR)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "OpenGL error after unpack-buffer upload: 0x%x\n", error);
+        return false;
+    }
+
+    mWidth = width;
+    mHeight = height;
+    mBytes = nullptr;
+    mGpuBytes.set(MemoryStats::Category::GPU_TEXTURES,
+                  withMips(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4));
 
     return true;
 }
@@ -229,19 +621,46 @@ bool Texture::loadProceduralTextures(int width, int height,
     std::vector<unsigned char> data(static_cast<size_t>(width) * static_cast<size_t>(height));
     generator(data, width, height);
 
+    if (!loadProceduralStorage(width, height, channelOffset))
+    {
+        return false;
+    }
+
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mTextureId);
+    // R8 rows are not 4-byte aligned for odd widths
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RED, GL_UNSIGNED_BYTE, data.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, 0);
+
+    return true;
+}
+
+bool Texture::loadProceduralStorage(int width, int height, const std::uint32_t channelOffset) noexcept
+{
+    if (width <= 0 || height <= 0 || width > MAX_TEXTURE_WIDTH || height > MAX_TEXTURE_HEIGHT)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Invalid procedural texture size %dx%d\n", width, height);
+        return false;
+    }
+
+    this->free();
+
     glGenTextures(1, &mTextureId);
-    glActiveTexture(GL_TEXTURE0 + channelOffset);
-    glBindTexture(GL_TEXTURE_2D, mTextureId);
+    GLStateCache::activeTexture(GL_TEXTURE0 + channelOffset);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mTextureId);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width, height, 0, GL_RED, GL_UNSIGNED_BYTE, data.data());
-    glBindTexture(GL_TEXTURE_2D, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_R8, width, height);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, 0);
 
     mWidth = width;
     mHeight = height;
-    mBytes = nullptr; // Do not store pointer to local vector data
+    mBytes = nullptr;
+    mGpuBytes.set(MemoryStats::Category::GPU_TEXTURES, static_cast<std::size_t>(width) * static_cast<std::size_t>(height));
 
     return true;
 }
@@ -275,8 +694,8 @@ bool Texture::loadFromMemory(const std::uint8_t *data, const int width, const in
     mBytes = const_cast<std::uint8_t *>(data);
 
     glGenTextures(1, &mTextureId);
-    glActiveTexture(GL_TEXTURE0 + channelOffset);
-    glBindTexture(GL_TEXTURE_2D, mTextureId);
+    GLStateCache::activeTexture(GL_TEXTURE0 + channelOffset);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mTextureId);
 
     // Set texture parameters
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -300,6 +719,8 @@ bool Texture::loadFromMemory(const std::uint8_t *data, const int width, const in
 
     mWidth = width;
     mHeight = height;
+    mGpuBytes.set(MemoryStats::Category::GPU_TEXTURES,
+                  withMips(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4));
 
     return true;
 }
@@ -346,8 +767,8 @@ bool Texture::updateFromMemory(const std::uint8_t *data, const int width, const
     }
 
     // Efficient update using glTexSubImage2D (reuses existing texture)
-    glActiveTexture(GL_TEXTURE0 + channelOffset);
-    glBindTexture(GL_TEXTURE_2D, mTextureId);
+    GLStateCache::activeTexture(GL_TEXTURE0 + channelOffset);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, mTextureId);
     glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA,
                     GL_UNSIGNED_BYTE, upload_data);
     glGenerateMipmap(GL_TEXTURE_2D);
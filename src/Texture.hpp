@@ -1,9 +1,15 @@
 #ifndef TEXTURE_HPP
 #define TEXTURE_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <memory>
+#include <string>
 #include <string_view>
+#include <vector>
+
+#include "MemoryStats.hpp"
 
 struct SDL_Window;
 
@@ -17,7 +23,44 @@ public:
     {
         RGBA32F,
         RGBA16F,
-        R16F
+        R16F,
+        R8,
+        /// Depth-only, sampled through a sampler2DShadow (compare mode set)
+        DEPTH24,
+        /// Depth-stencil attachment whose depth is also read back with texelFetch (no compare mode)
+        DEPTH24_STENCIL8
+    };
+
+    /// Frees stb_image allocations
+    struct PixelDeleter
+    {
+        void operator()(std::uint8_t *pixels) const noexcept;
+    };
+
+    /// @brief RGBA8 pixels decoded off the GL thread, flipped for GL like loadFromFile
+    struct DecodedImage
+    {
+        std::unique_ptr<std::uint8_t, PixelDeleter> pixels;
+        int width{0};
+        int height{0};
+    };
+
+    /// @brief Pre-mipped block-compressed image read from a KTX2 file, level 0 largest
+    struct CompressedImage
+    {
+        struct Level
+        {
+            std::size_t offset{0};
+            std::size_t size{0};
+            int width{0};
+            int height{0};
+        };
+
+        std::vector<std::uint8_t> data;
+        std::vector<Level> levels;
+        std::uint32_t internalFormat{0};
+        int width{0};
+        int height{0};
     };
 
     Texture() = default;
@@ -53,6 +96,33 @@ public:
     /// Load texture from file using stb_image
     bool loadFromFile(std::string_view filepath, std::uint32_t channelOffset = 0) noexcept;
 
+    /// @brief Decode an image file to RGBA8 without touching GL; safe on any thread
+    [[nodiscard]] static bool decodeFile(std::string_view filepath, DecodedImage &out) noexcept;
+
+    /// @brief KTX2 file produced for filepath by the compress_textures target (same name, .ktx2)
+    [[nodiscard]] static std::string compressedPathFor(std::string_view filepath);
+
+    /// @brief Parse an uncompressed-container KTX2 holding BC1/BC3/BC7 or ASTC blocks; safe on any thread
+    /// @return false if the file is missing, supercompressed, or not a 2D format we map to GL
+    [[nodiscard]] static bool readKTX2(std::string_view filepath, CompressedImage &out) noexcept;
+
+    /// @brief Cache the driver's compressed format list; call once on the GL thread before any lookups
+    static void queryCompressedFormats() noexcept;
+
+    /// True if queryCompressedFormats() found internalFormat
+    [[nodiscard]] static bool isCompressedFormatSupported(std::uint32_t internalFormat) noexcept;
+
+    /// @brief Upload every mip level of a compressed image with glCompressedTexImage2D
+    bool loadCompressed(const CompressedImage &image, std::uint32_t channelOffset = 0) noexcept;
+
+    /// @brief Create the texture from RGBA8 pixels in the bound GL_PIXEL_UNPACK_BUFFER at offset 0
+    /// @details Same sampling setup as loadFromFile; the driver copies out of the buffer asynchronously
+    bool loadFromUnpackBuffer(int width, int height, std::uint32_t channelOffset = 0) noexcept;
+
+    /// @brief Create an empty R8 texture with the procedural sampling setup (repeat, nearest)
+    /// @details Immutable storage, so a compute shader can write it through glBindImageTexture
+    bool loadProceduralStorage(int width, int height, std::uint32_t channelOffset = 0) noexcept;
+
     bool loadProceduralTextures(int width, int height,
         const std::function<void(std::vector<std::uint8_t>&, int, int)> &generator,
         std::uint32_t channelOffset = 0) noexcept;
@@ -73,6 +143,8 @@ private:
     int mWidth{0};
     int mHeight{0};
     std::uint8_t *mBytes{nullptr};
+    /// Texel bytes of every level, for the debug overlay's memory breakdown
+    MemoryStats::Allocation mGpuBytes{MemoryStats::Category::GPU_TEXTURES};
 }; // Texture class
 
 #endif // TEXTURE_HPP
@@ -0,0 +1,219 @@
+#include "TextureAtlas.hpp"
+
+#include <SDL3/SDL.h>
+
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include <dearimgui/imstb_rectpack.h>
+
+#include <algorithm>
+
+#include "CPUProfiler.hpp"
+#include "GLStateCache.hpp"
+#include "ResourceManager.hpp"
+#include "Texture.hpp"
+
+namespace
+{
+    struct AtlasSource
+    {
+        Textures::ID id;
+        GLuint texture;
+        int width;
+        int height;
+    };
+
+    /// Fill a fresh page with transparent black so the padding texels are defined
+    void clearPage(GLuint page) noexcept
+    {
+        GLint previousFramebuffer = 0;
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+        const GLboolean scissor = glIsEnabled(GL_SCISSOR_TEST);
+
+        GLuint framebuffer = 0;
+        glGenFramebuffers(1, &framebuffer);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer);
+        glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, page, 0);
+        glDisable(GL_SCISSOR_TEST);
+
+        constexpr GLfloat kTransparent[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        glClearBufferfv(GL_COLOR, 0, kTransparent);
+
+        if (scissor == GL_TRUE)
+        {
+            glEnable(GL_SCISSOR_TEST);
+        }
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+        glDeleteFramebuffers(1, &framebuffer);
+    }
+} // namespace
+
+TextureAtlas::~TextureAtlas() noexcept
+{
+    destroy();
+}
+
+std::size_t TextureAtlas::build(const TextureManager &textures, std::span<const Textures::ID> ids) noexcept
+{
+    BW_PROFILE_ZONE("TextureAtlas::build");
+
+    destroy();
+
+    GLint maxTextureSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    const int pageLimit = std::clamp(static_cast<int>(maxTextureSize), 1, MAX_PAGE_SIZE);
+
+    std::vector<AtlasSource> sources;
+    sources.reserve(ids.size());
+    for (const Textures::ID id : ids)
+    {
+        const Texture *texture = nullptr;
+        try
+        {
+            texture = &textures.get(id);
+        }
+        catch (const std::exception &)
+        {
+            continue;
+        }
+
+        if (texture->get() == 0 || texture->getWidth() <= 0 || texture->getHeight() <= 0)
+        {
+            continue;
+        }
+
+        // glCopyImageSubData needs matching texel layouts; KTX2-loaded textures keep their own object
+        GLint internalFormat = 0;
+        GLStateCache::bindTexture(GL_TEXTURE_2D, texture->get());
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+        if (internalFormat != GL_RGBA8 && internalFormat != GL_RGBA)
+        {
+            SDL_Log("TextureAtlas: leaving texture id=%d out (internal format 0x%x)", static_cast<int>(id), internalFormat);
+            continue;
+        }
+
+        if (texture->getWidth() + 2 * PADDING > pageLimit || texture->getHeight() + 2 * PADDING > pageLimit)
+        {
+            SDL_Log("TextureAtlas: leaving texture id=%d out (%dx%d exceeds the page)", static_cast<int>(id),
+                    texture->getWidth(), texture->getHeight());
+            continue;
+        }
+
+        sources.push_back({id, texture->get(), texture->getWidth(), texture->getHeight()});
+    }
+    GLStateCache::bindTexture(GL_TEXTURE_2D, 0);
+
+    std::vector<stbrp_rect> rects;
+    std::vector<stbrp_node> nodes(static_cast<std::size_t>(pageLimit));
+    std::size_t packed = 0;
+
+    while (!sources.empty())
+    {
+        rects.clear();
+        for (std::size_t i = 0; i < sources.size(); ++i)
+        {
+            rects.push_back({static_cast<int>(i), sources[i].width + 2 * PADDING, sources[i].height + 2 * PADDING, 0, 0, 0});
+        }
+
+        stbrp_context context;
+        stbrp_init_target(&context, pageLimit, pageLimit, nodes.data(), static_cast<int>(nodes.size()));
+        stbrp_pack_rects(&context, rects.data(), static_cast<int>(rects.size()));
+
+        // Shrink the page to what was used so a handful of logos does not cost a full 4096^2
+        int pageWidth = 0;
+        int pageHeight = 0;
+        for (const auto &rect : rects)
+        {
+            if (rect.was_packed)
+            {
+                pageWidth = std::max(pageWidth, rect.x + rect.w);
+                pageHeight = std::max(pageHeight, rect.y + rect.h);
+            }
+        }
+        if (pageWidth == 0 || pageHeight == 0)
+        {
+            break;
+        }
+
+        GLuint page = 0;
+        glGenTextures(1, &page);
+        GLStateCache::bindTexture(GL_TEXTURE_2D, page);
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, pageWidth, pageHeight);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        GLStateCache::bindTexture(GL_TEXTURE_2D, 0);
+        clearPage(page);
+
+        const auto layer = static_cast<std::uint32_t>(mPages.size());
+        mPages.push_back(page);
+
+        std::vector<AtlasSource> remaining;
+        for (const auto &rect : rects)
+        {
+            const AtlasSource &source = sources[static_cast<std::size_t>(rect.id)];
+            if (!rect.was_packed)
+            {
+                remaining.push_back(source);
+                continue;
+            }
+
+            const int x = rect.x + PADDING;
+            const int y = rect.y + PADDING;
+            glCopyImageSubData(source.texture, GL_TEXTURE_2D, 0, 0, 0, 0,
+                               page, GL_TEXTURE_2D, 0, x, y, 0,
+                               source.width, source.height, 1);
+
+            Region &region = mRegions[static_cast<std::size_t>(source.id)];
+            region.texture = page;
+            region.layer = layer;
+            region.width = source.width;
+            region.height = source.height;
+            region.uvRect = glm::vec4(static_cast<float>(x) / static_cast<float>(pageWidth),
+                                      static_cast<float>(y) / static_cast<float>(pageHeight),
+                                      static_cast<float>(x + source.width) / static_cast<float>(pageWidth),
+                                      static_cast<float>(y + source.height) / static_cast<float>(pageHeight));
+            ++packed;
+        }
+
+        SDL_Log("TextureAtlas: page %u is %dx%d with %zu images", layer, pageWidth, pageHeight,
+                sources.size() - remaining.size());
+        sources = std::move(remaining);
+    }
+
+    if (const GLenum error = glGetError(); error != GL_NO_ERROR)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "TextureAtlas: OpenGL error while packing: 0x%x", error);
+        destroy();
+        return 0;
+    }
+
+    return packed;
+}
+
+void TextureAtlas::destroy() noexcept
+{
+    for (GLuint &page : mPages)
+    {
+        GLStateCache::forgetTexture(page);
+        glDeleteTextures(1, &page);
+    }
+    mPages.clear();
+    mRegions.fill(Region{});
+}
+
+const TextureAtlas::Region *TextureAtlas::find(Textures::ID id) const noexcept
+{
+    const auto index = static_cast<std::size_t>(id);
+    if (index >= mRegions.size() || mRegions[index].texture == 0)
+    {
+        return nullptr;
+    }
+    return &mRegions[index];
+}
+
+GLuint TextureAtlas::getPage(std::uint32_t layer) const noexcept
+{
+    return (layer < mPages.size()) ? mPages[layer] : 0;
+}
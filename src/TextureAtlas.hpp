@@ -0,0 +1,71 @@
+#ifndef TEXTURE_ATLAS_HPP
+#define TEXTURE_ATLAS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "ResourceIdentifiers.hpp"
+
+/// @brief Packs already-loaded RGBA8 textures into a few shared pages at load time
+/// @details Each page is a plain GL_TEXTURE_2D so Dear ImGui can draw from it as well as the billboard
+/// shader. Rectangles are placed with stb_rect_pack and copied texel-for-texel with glCopyImageSubData,
+/// so the source orientation (stb flips rows on load) is preserved. The source textures stay in the
+/// TextureManager for code that samples them with wrapping or mipmaps.
+class TextureAtlas
+{
+public:
+    static constexpr int MAX_PAGE_SIZE = 4096;
+    /// Empty texels around each image so NEAREST sampling at a rect edge never picks up a neighbour
+    static constexpr int PADDING = 1;
+
+    struct Region
+    {
+        GLuint texture{0};
+        std::uint32_t layer{0};
+        /// u0, v0, u1, v1 of the whole source image inside the page
+        glm::vec4 uvRect{0.0f, 0.0f, 1.0f, 1.0f};
+        int width{0};
+        int height{0};
+
+        /// Map a rect given in the source texture's UV space into the page
+        [[nodiscard]] glm::vec4 map(const glm::vec4 &localRect) const noexcept
+        {
+            const glm::vec2 origin(uvRect.x, uvRect.y);
+            const glm::vec2 extent(uvRect.z - uvRect.x, uvRect.w - uvRect.y);
+            return glm::vec4(origin + glm::vec2(localRect.x, localRect.y) * extent,
+                             origin + glm::vec2(localRect.z, localRect.w) * extent);
+        }
+    };
+
+    TextureAtlas() = default;
+    ~TextureAtlas() noexcept;
+
+    TextureAtlas(const TextureAtlas &) = delete;
+    TextureAtlas &operator=(const TextureAtlas &) = delete;
+
+    /// @brief Replace the atlas with the listed textures; needs the GL context
+    /// @details Missing textures, compressed textures and images larger than a page are left out and
+    /// callers keep drawing them from their own texture
+    /// @return Number of textures that were packed
+    std::size_t build(const TextureManager &textures, std::span<const Textures::ID> ids) noexcept;
+
+    void destroy() noexcept;
+
+    /// @return The packed region for id, or nullptr if it is not in the atlas
+    [[nodiscard]] const Region *find(Textures::ID id) const noexcept;
+
+    [[nodiscard]] std::size_t getPageCount() const noexcept { return mPages.size(); }
+    [[nodiscard]] GLuint getPage(std::uint32_t layer) const noexcept;
+
+private:
+    std::vector<GLuint> mPages;
+    std::array<Region, static_cast<std::size_t>(Textures::ID::TOTAL_IDS)> mRegions{};
+};
+
+#endif // TEXTURE_ATLAS_HPP
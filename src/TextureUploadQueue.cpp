@@ -0,0 +1,217 @@
+#include "TextureUploadQueue.hpp"
+
+#include "CPUProfiler.hpp"
+#include "JobSystem.hpp"
+#include "RenderStats.hpp"
+#include "ResourceManager.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <cstring>
+#include <memory>
+
+TextureUploadQueue::~TextureUploadQueue()
+{
+    waitForJobs();
+}
+
+void TextureUploadQueue::submit(Textures::ID id, std::string path, std::uint32_t channelOffset)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        ++mDecoding;
+    }
+    ++mSubmitted;
+
+    // Workers only read the format list, so it has to be filled here on the GL thread
+    Texture::queryCompressedFormats();
+
+    auto &jobs = *mazes::singleton_base<JobSystem>::instance();
+    mJobs.push_back(jobs.submit([this, id, path = std::move(path), channelOffset]() mutable
+                                {
+                                    BW_PROFILE_ZONE("TextureUploadQueue::decode");
+
+                                    DecodedTexture decoded{id, std::move(path), channelOffset, {}, {}, false, false};
+                                    decoded.isCompressed =
+                                        Texture::readKTX2(Texture::compressedPathFor(decoded.path), decoded.compressed) &&
+                                        Texture::isCompressedFormatSupported(decoded.compressed.internalFormat);
+                                    decoded.ok = decoded.isCompressed || Texture::decodeFile(decoded.path, decoded.image);
+
+                                    std::lock_guard<std::mutex> lock(mMutex);
+                                    mReady.push_back(std::move(decoded));
+                                    --mDecoding; }));
+}
+
+std::size_t TextureUploadQueue::pump(TextureManager &textures, std::chrono::microseconds budget) noexcept
+{
+    BW_PROFILE_ZONE("TextureUploadQueue::pump");
+
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t uploaded = 0;
+
+    for (;;)
+    {
+        DecodedTexture decoded;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mReady.empty())
+            {
+                break;
+            }
+            decoded = std::move(mReady.front());
+            mReady.pop_front();
+        }
+
+        ++mCompleted;
+        if (!decoded.ok)
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                        "LoadingState: Skipping texture (file unavailable) id=%d path=%s",
+                        static_cast<int>(decoded.id), decoded.path.c_str());
+        }
+        else if (upload(textures, decoded))
+        {
+            ++uploaded;
+            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Loaded texture: %s for ID: %d",
+                        decoded.path.c_str(), static_cast<int>(decoded.id));
+        }
+
+        if (std::chrono::steady_clock::now() - start >= budget)
+        {
+            break;
+        }
+    }
+
+    return uploaded;
+}
+
+bool TextureUploadQueue::upload(TextureManager &textures, DecodedTexture &decoded) noexcept
+{
+    if (decoded.isCompressed)
+    {
+        auto texture = std::make_unique<Texture>();
+        if (texture->loadCompressed(decoded.compressed, decoded.channelOffset))
+        {
+            return insert(textures, decoded, std::move(texture));
+        }
+
+        // The driver listed the format but refused the data; decode the source image instead
+        if (!Texture::decodeFile(decoded.path, decoded.image))
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Skipping texture (upload failed) id=%d path=%s",
+                        static_cast<int>(decoded.id), decoded.path.c_str());
+            return false;
+        }
+    }
+
+    const int width = decoded.image.width;
+    const int height = decoded.image.height;
+    const auto bytes = static_cast<GLsizeiptr>(width) * static_cast<GLsizeiptr>(height) * 4;
+
+    if (mUnpackBuffers[0] == 0)
+    {
+        glGenBuffers(static_cast<GLsizei>(mUnpackBuffers.size()), mUnpackBuffers.data());
+    }
+
+    auto texture = std::make_unique<Texture>();
+    bool loaded = false;
+
+    // Respecifying the store orphans whatever the previous upload from this buffer still references
+    const GLuint unpackBuffer = mUnpackBuffers[mNextBuffer];
+    mNextBuffer = (mNextBuffer + 1) % mUnpackBuffers.size();
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, unpackBuffer);
+    RenderStats::bufferData(GL_PIXEL_UNPACK_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
+    if (void *mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, bytes,
+                                        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        mapped != nullptr)
+    {
+        std::memcpy(mapped, decoded.image.pixels.get(), static_cast<std::size_t>(bytes));
+        if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE)
+        {
+            loaded = texture->loadFromUnpackBuffer(width, height, decoded.channelOffset);
+        }
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    // A failed map (or a store corrupted while mapped) falls back to a direct upload
+    if (!loaded)
+    {
+        loaded = texture->loadFromMemory(decoded.image.pixels.get(), width, height, decoded.channelOffset);
+    }
+
+    if (!loaded)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Skipping texture (upload failed) id=%d path=%s",
+                    static_cast<int>(decoded.id), decoded.path.c_str());
+        return false;
+    }
+
+    return insert(textures, decoded, std::move(texture));
+}
+
+bool TextureUploadQueue::insert(TextureManager &textures, const DecodedTexture &decoded,
+                                std::unique_ptr<Texture> texture) noexcept
+{
+    try
+    {
+        textures.insert(decoded.id, std::move(texture));
+    }
+    catch (const std::exception &e)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "LoadingState: Skipping texture id=%d: %s",
+                    static_cast<int>(decoded.id), e.what());
+        return false;
+    }
+    return true;
+}
+
+bool TextureUploadQueue::isIdle() const noexcept
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mDecoding == 0 && mReady.empty();
+}
+
+void TextureUploadQueue::release() noexcept
+{
+    waitForJobs();
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mReady.clear();
+    }
+
+    if (mUnpackBuffers[0] != 0)
+    {
+        glDeleteBuffers(static_cast<GLsizei>(mUnpackBuffers.size()), mUnpackBuffers.data());
+        mUnpackBuffers.fill(0);
+    }
+}
+
+void TextureUploadQueue::waitForJobs() noexcept
+{
+    auto &jobs = *mazes::singleton_base<JobSystem>::instance();
+    for (auto &job : mJobs)
+    {
+        if (!job.valid())
+        {
+            continue;
+        }
+
+        try
+        {
+            // Without worker threads nothing else will ever run the decode
+            if (jobs.isCooperative())
+            {
+                while (job.wait_for(std::chrono::seconds(0)) != std::future_status::ready && jobs.runPendingJob())
+                {
+                }
+            }
+            job.get();
+        }
+        catch (const std::exception &e)
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "TextureUploadQueue: decode job abandoned: %s", e.what());
+        }
+    }
+    mJobs.clear();
+}
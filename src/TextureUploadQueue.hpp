@@ -0,0 +1,80 @@
+#ifndef TEXTURE_UPLOAD_QUEUE_HPP
+#define TEXTURE_UPLOAD_QUEUE_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "ResourceIdentifiers.hpp"
+#include "Texture.hpp"
+
+/// @brief Decodes image files on the job system and uploads them on the GL thread within a time budget
+/// @details submit() queues a decode job that reads the KTX2 sibling when the driver can sample its
+/// block format, or decodes the image with stb_image otherwise. pump(), called once per frame on the GL
+/// thread, uploads finished images (compressed blocks directly, RGBA through a pixel unpack buffer),
+/// stopping once the budget is spent. Two unpack buffers alternate so one upload can be in flight while
+/// the next is written.
+class TextureUploadQueue
+{
+public:
+    TextureUploadQueue() = default;
+    ~TextureUploadQueue();
+
+    TextureUploadQueue(const TextureUploadQueue &) = delete;
+    TextureUploadQueue &operator=(const TextureUploadQueue &) = delete;
+
+    /// Start decoding path on a job worker; call on the GL thread
+    void submit(Textures::ID id, std::string path, std::uint32_t channelOffset = 0);
+
+    /// @brief Upload decoded images into textures until budget runs out (at least one per call)
+    /// @return Number of textures inserted into the manager
+    std::size_t pump(TextureManager &textures, std::chrono::microseconds budget) noexcept;
+
+    /// True when nothing is decoding and nothing is waiting for upload
+    [[nodiscard]] bool isIdle() const noexcept;
+
+    [[nodiscard]] std::size_t getSubmittedCount() const noexcept { return mSubmitted; }
+    [[nodiscard]] std::size_t getCompletedCount() const noexcept { return mCompleted; }
+
+    /// Wait for outstanding decodes and delete the unpack buffers; needs the GL context
+    void release() noexcept;
+
+private:
+    struct DecodedTexture
+    {
+        Textures::ID id;
+        std::string path;
+        std::uint32_t channelOffset;
+        Texture::DecodedImage image;
+        Texture::CompressedImage compressed;
+        bool isCompressed;
+        bool ok;
+    };
+
+    void waitForJobs() noexcept;
+    [[nodiscard]] bool upload(TextureManager &textures, DecodedTexture &decoded) noexcept;
+    [[nodiscard]] bool insert(TextureManager &textures, const DecodedTexture &decoded,
+                              std::unique_ptr<Texture> texture) noexcept;
+
+    mutable std::mutex mMutex;
+    std::deque<DecodedTexture> mReady;
+    std::size_t mDecoding{0};
+
+    std::vector<std::future<void>> mJobs;
+    std::array<GLuint, 2> mUnpackBuffers{};
+    std::size_t mNextBuffer{0};
+
+    std::size_t mSubmitted{0};
+    std::size_t mCompleted{0};
+};
+
+#endif // TEXTURE_UPLOAD_QUEUE_HPP
@@ -0,0 +1,54 @@
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/// @brief Lock-free single-producer/single-consumer handoff of the newest value
+/// @details The writer fills the back slot and swaps it with the middle one; the reader swaps
+/// the middle slot into the front when it holds something new. Neither side ever waits,
+/// and values the reader did not get to in time are overwritten.
+template <typename T>
+class TripleBuffer
+{
+public:
+    /// @brief Slot the producer may fill; only valid until the next publish()
+    [[nodiscard]] T &back() noexcept { return mSlots[mBack]; }
+
+    /// @brief Hand the back slot to the reader
+    void publish() noexcept
+    {
+        const std::uint8_t previous = mMiddle.exchange(static_cast<std::uint8_t>(mBack | FRESH_BIT),
+                                                       std::memory_order_acq_rel);
+        mBack = previous & INDEX_MASK;
+    }
+
+    /// @brief Make the newest published value current on the reader side
+    /// @return true if a value newer than the current front arrived
+    bool consume() noexcept
+    {
+        if ((mMiddle.load(std::memory_order_relaxed) & FRESH_BIT) == 0)
+        {
+            return false;
+        }
+
+        const std::uint8_t previous = mMiddle.exchange(mFront, std::memory_order_acq_rel);
+        mFront = previous & INDEX_MASK;
+        return true;
+    }
+
+    /// @brief Reader's current value; stable until the next consume()
+    [[nodiscard]] const T &front() const noexcept { return mSlots[mFront]; }
+
+private:
+    static constexpr std::uint8_t FRESH_BIT = 0x4u;
+    static constexpr std::uint8_t INDEX_MASK = 0x3u;
+
+    std::array<T, 3> mSlots{};
+    std::uint8_t mBack{0};
+    std::atomic<std::uint8_t> mMiddle{1};
+    std::uint8_t mFront{2};
+};
+
+#endif // TRIPLE_BUFFER_HPP
@@ -1,5 +1,7 @@
 #include "VertexArrayObject.hpp"
 
+#include "GLStateCache.hpp"
+
 #include <SDL3/SDL.h>
 
 VertexArrayObject::VertexArrayObject() = default;
@@ -44,18 +46,19 @@ bool VertexArrayObject::loadFromFile(std::string_view /*unused*/)
 
 void VertexArrayObject::bind() const noexcept
 {
-    glBindVertexArray(mVAO);
+    GLStateCache::bindVertexArray(mVAO);
 }
 
 void VertexArrayObject::unbind() noexcept
 {
-    glBindVertexArray(0);
+    GLStateCache::bindVertexArray(0);
 }
 
 void VertexArrayObject::cleanUp() noexcept
 {
     if (mVAO != 0)
     {
+        GLStateCache::forgetVertexArray(mVAO);
         glDeleteVertexArrays(1, &mVAO);
         mVAO = 0;
     }
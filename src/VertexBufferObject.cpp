@@ -2,6 +2,10 @@
 
 #include <SDL3/SDL.h>
 
+#include <utility>
+
+#include "RenderStats.hpp"
+
 VertexBufferObject::VertexBufferObject() = default;
 
 VertexBufferObject::~VertexBufferObject() noexcept
@@ -10,7 +14,7 @@ VertexBufferObject::~VertexBufferObject() noexcept
 }
 
 VertexBufferObject::VertexBufferObject(VertexBufferObject &&other) noexcept
-    : mVBO{other.mVBO}
+    : mVBO{other.mVBO}, mGpuBytes{std::move(other.mGpuBytes)}
 {
     other.mVBO = 0;
 }
@@ -21,6 +25,7 @@ VertexBufferObject &VertexBufferObject::operator=(VertexBufferObject &&other) no
     {
         cleanUp();
         mVBO = other.mVBO;
+        mGpuBytes = std::move(other.mGpuBytes);
         other.mVBO = 0;
     }
     return *this;
@@ -52,6 +57,15 @@ void VertexBufferObject::unbind(GLenum target) noexcept
     glBindBuffer(target, 0);
 }
 
+void VertexBufferObject::allocate(GLenum target, GLsizeiptr bytes, const void *data, GLenum usage) noexcept
+{
+    glBindBuffer(target, mVBO);
+    RenderStats::bufferData(target, bytes, data, usage);
+    mGpuBytes.set(target == GL_SHADER_STORAGE_BUFFER ? MemoryStats::Category::GPU_STORAGE_BUFFERS
+                                                     : MemoryStats::Category::GPU_VERTEX_BUFFERS,
+                  static_cast<std::size_t>(bytes));
+}
+
 void VertexBufferObject::cleanUp() noexcept
 {
     if (mVBO != 0)
@@ -59,4 +73,5 @@ void VertexBufferObject::cleanUp() noexcept
         glDeleteBuffers(1, &mVBO);
         mVBO = 0;
     }
+    mGpuBytes.set(0);
 }
@@ -4,6 +4,8 @@
 #include <glad/glad.h>
 #include <string_view>
 
+#include "MemoryStats.hpp"
+
 /// @brief RAII wrapper for an OpenGL Buffer Object (VBO, SSBO, etc.).
 /// Manages the lifetime of a single buffer, deleting it on destruction.
 class VertexBufferObject
@@ -29,6 +31,10 @@ public:
     /// @brief Unbind the given target (bind 0).
     static void unbind(GLenum target = GL_ARRAY_BUFFER) noexcept;
 
+    /// @brief Bind to target and (re)allocate the store with glBufferData, recording its size
+    /// @details Leaves the buffer bound to target. Shader storage counts as storage, anything else as vertex data
+    void allocate(GLenum target, GLsizeiptr bytes, const void *data, GLenum usage) noexcept;
+
     /// @brief Get the raw OpenGL buffer name.
     [[nodiscard]] GLuint get() const noexcept { return mVBO; }
 
@@ -40,6 +46,7 @@ public:
 
 private:
     GLuint mVBO{0};
+    MemoryStats::Allocation mGpuBytes{MemoryStats::Category::GPU_VERTEX_BUFFERS};
 };
 
 #endif // VERTEX_BUFFER_OBJECT_HPP
@@ -0,0 +1,199 @@
+#include "WallBroadphase.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void WallBroadphase::build(std::span<const glm::vec4> aabbs, float cellSize)
+{
+    clear();
+    if (aabbs.empty() || cellSize <= 0.0f)
+    {
+        return;
+    }
+
+    mWalls.assign(aabbs.begin(), aabbs.end());
+
+    glm::vec2 boundsMin{aabbs.front().x, aabbs.front().y};
+    glm::vec2 boundsMax{aabbs.front().z, aabbs.front().w};
+    for (const auto &wall : mWalls)
+    {
+        boundsMin = glm::min(boundsMin, glm::vec2(wall.x, wall.y));
+        boundsMax = glm::max(boundsMax, glm::vec2(wall.z, wall.w));
+    }
+
+    mOrigin = boundsMin;
+    mInvCellSize = 1.0f / cellSize;
+    mCellsX = std::max(1, static_cast<int>(std::ceil((boundsMax.x - boundsMin.x) * mInvCellSize)) + 1);
+    mCellsZ = std::max(1, static_cast<int>(std::ceil((boundsMax.y - boundsMin.y) * mInvCellSize)) + 1);
+
+    const std::size_t cellCount = static_cast<std::size_t>(mCellsX) * static_cast<std::size_t>(mCellsZ);
+
+    // Count per cell, prefix-sum into offsets, then scatter
+    std::vector<std::uint32_t> counts(cellCount, 0u);
+    for (const auto &wall : mWalls)
+    {
+        for (int z = cellZ(wall.y); z <= cellZ(wall.w); ++z)
+        {
+            for (int x = cellX(wall.x); x <= cellX(wall.z); ++x)
+            {
+                ++counts[static_cast<std::size_t>(z) * mCellsX + x];
+            }
+        }
+    }
+
+    mCellStart.resize(cellCount + 1);
+    mCellStart[0] = 0u;
+    for (std::size_t i = 0; i < cellCount; ++i)
+    {
+        mCellStart[i + 1] = mCellStart[i] + counts[i];
+    }
+
+    mCellWalls.resize(mCellStart.back());
+    std::fill(counts.begin(), counts.end(), 0u);
+    for (std::uint32_t wallIndex = 0; wallIndex < mWalls.size(); ++wallIndex)
+    {
+        const auto &wall = mWalls[wallIndex];
+        for (int z = cellZ(wall.y); z <= cellZ(wall.w); ++z)
+        {
+            for (int x = cellX(wall.x); x <= cellX(wall.z); ++x)
+            {
+                const std::size_t cell = static_cast<std::size_t>(z) * mCellsX + x;
+                mCellWalls[mCellStart[cell] + counts[cell]++] = wallIndex;
+            }
+        }
+    }
+}
+
+void WallBroadphase::clear() noexcept
+{
+    mWalls.clear();
+    mCellStart.clear();
+    mCellWalls.clear();
+    mCellsX = 0;
+    mCellsZ = 0;
+}
+
+void WallBroadphase::query(const glm::vec2 &boundsMin, const glm::vec2 &boundsMax,
+                           std::vector<std::uint32_t> &indexScratch, WallCandidates &out) const
+{
+    if (mWalls.empty())
+    {
+        return;
+    }
+
+    indexScratch.clear();
+    const int minX = cellX(boundsMin.x);
+    const int maxX = cellX(boundsMax.x);
+    const int minZ = cellZ(boundsMin.y);
+    const int maxZ = cellZ(boundsMax.y);
+
+    for (int z = minZ; z <= maxZ; ++z)
+    {
+        for (int x = minX; x <= maxX; ++x)
+        {
+            const std::size_t cell = static_cast<std::size_t>(z) * mCellsX + x;
+            indexScratch.insert(indexScratch.end(),
+                                mCellWalls.begin() + mCellStart[cell],
+                                mCellWalls.begin() + mCellStart[cell + 1]);
+        }
+    }
+
+    // Walls straddling cell borders appear more than once
+    std::sort(indexScratch.begin(), indexScratch.end());
+    indexScratch.erase(std::unique(indexScratch.begin(), indexScratch.end()), indexScratch.end());
+
+    for (const std::uint32_t wallIndex : indexScratch)
+    {
+        const auto &wall = mWalls[wallIndex];
+        if (wall.z < boundsMin.x || wall.x > boundsMax.x || wall.w < boundsMin.y || wall.y > boundsMax.y)
+        {
+            continue;
+        }
+
+        out.minX.push_back(wall.x);
+        out.minZ.push_back(wall.y);
+        out.maxX.push_back(wall.z);
+        out.maxZ.push_back(wall.w);
+    }
+}
+
+void WallBroadphase::resolveCircle(glm::vec3 &position, float radius, int iterations, ResolveScratch &scratch) const noexcept
+{
+    for (int iter = 0; iter < iterations; ++iter)
+    {
+        // Broadphase: only walls overlapping the circle's bounds at the start of this pass
+        scratch.candidates.clear();
+        query(glm::vec2(position.x - radius, position.z - radius),
+              glm::vec2(position.x + radius, position.z + radius),
+              scratch.indices, scratch.candidates);
+
+        const std::size_t count = scratch.candidates.size();
+        if (count == 0)
+            break;
+
+        // Narrowphase distances over packed arrays; branch-free so the compiler can vectorise it
+        const float *minX = scratch.candidates.minX.data();
+        const float *minZ = scratch.candidates.minZ.data();
+        const float *maxX = scratch.candidates.maxX.data();
+        const float *maxZ = scratch.candidates.maxZ.data();
+        scratch.distSq.resize(count);
+        float *distSqOut = scratch.distSq.data();
+        const float px = position.x;
+        const float pz = position.z;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const float dx = px - std::clamp(px, minX[i], maxX[i]);
+            const float dz = pz - std::clamp(pz, minZ[i], maxZ[i]);
+            distSqOut[i] = dx * dx + dz * dz;
+        }
+
+        bool anyOverlap = false;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (distSqOut[i] >= radius * radius)
+                continue; // no overlap at pass start
+
+            // Earlier pushes in this pass move the circle, so resolve against the current position
+            const float closestX = std::clamp(position.x, minX[i], maxX[i]);
+            const float closestZ = std::clamp(position.z, minZ[i], maxZ[i]);
+            const float dx = position.x - closestX;
+            const float dz = position.z - closestZ;
+            const float distSq = dx * dx + dz * dz;
+
+            if (distSq >= radius * radius)
+                continue;
+
+            anyOverlap = true;
+            if (distSq > 0.0f)
+            {
+                const float dist = std::sqrt(distSq);
+                const float push = radius - dist;
+                position.x += (dx / dist) * push;
+                position.z += (dz / dist) * push;
+            }
+            else
+            {
+                // Centre inside the AABB — push along the axis of least penetration
+                const float ox = std::min(position.x - minX[i], maxX[i] - position.x);
+                const float oz = std::min(position.z - minZ[i], maxZ[i] - position.z);
+                if (ox < oz)
+                    position.x += (position.x < (minX[i] + maxX[i]) * 0.5f) ? -(ox + radius) : (ox + radius);
+                else
+                    position.z += (position.z < (minZ[i] + maxZ[i]) * 0.5f) ? -(oz + radius) : (oz + radius);
+            }
+        }
+
+        if (!anyOverlap)
+            break; // converged
+    }
+}
+
+int WallBroadphase::cellX(float x) const noexcept
+{
+    return std::clamp(static_cast<int>(std::floor((x - mOrigin.x) * mInvCellSize)), 0, mCellsX - 1);
+}
+
+int WallBroadphase::cellZ(float z) const noexcept
+{
+    return std::clamp(static_cast<int>(std::floor((z - mOrigin.y) * mInvCellSize)), 0, mCellsZ - 1);
+}
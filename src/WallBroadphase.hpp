@@ -0,0 +1,75 @@
+#ifndef WALL_BROADPHASE_HPP
+#define WALL_BROADPHASE_HPP
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/// @brief Structure-of-arrays copy of wall AABBs gathered for a narrowphase pass
+struct WallCandidates
+{
+    std::vector<float> minX;
+    std::vector<float> minZ;
+    std::vector<float> maxX;
+    std::vector<float> maxZ;
+
+    void clear() noexcept
+    {
+        minX.clear();
+        minZ.clear();
+        maxX.clear();
+        maxZ.clear();
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return minX.size(); }
+};
+
+/// @brief Static uniform grid over XZ wall AABBs packed as glm::vec4(minX, minZ, maxX, maxZ)
+/// @details Built once per maze. Cells store wall indices in one flat array (CSR layout),
+/// and a wall spanning several cells is listed in each of them.
+class WallBroadphase
+{
+public:
+    void build(std::span<const glm::vec4> aabbs, float cellSize);
+
+    void clear() noexcept;
+
+    /// @brief Append every wall overlapping the XZ box [boundsMin, boundsMax] to out, once each
+    /// @details indexScratch is caller-owned so concurrent queries stay independent
+    void query(const glm::vec2 &boundsMin, const glm::vec2 &boundsMax,
+               std::vector<std::uint32_t> &indexScratch, WallCandidates &out) const;
+
+    /// Caller-owned buffers for resolveCircle, reused between calls
+    struct ResolveScratch
+    {
+        std::vector<std::uint32_t> indices;
+        WallCandidates candidates;
+        std::vector<float> distSq;
+    };
+
+    /// @brief Push a circle at position.xz out of every wall it overlaps
+    /// @details Each pass queries the walls under the circle's current bounds and resolves them in order;
+    /// stops early once a pass finds no overlap. position.y is left alone.
+    void resolveCircle(glm::vec3 &position, float radius, int iterations, ResolveScratch &scratch) const noexcept;
+
+    [[nodiscard]] bool empty() const noexcept { return mWalls.empty(); }
+    [[nodiscard]] std::size_t getWallCount() const noexcept { return mWalls.size(); }
+
+private:
+    [[nodiscard]] int cellX(float x) const noexcept;
+    [[nodiscard]] int cellZ(float z) const noexcept;
+
+    std::vector<glm::vec4> mWalls;
+    std::vector<std::uint32_t> mCellStart; // mCellsX * mCellsZ + 1 offsets into mCellWalls
+    std::vector<std::uint32_t> mCellWalls;
+
+    glm::vec2 mOrigin{0.0f};
+    float mInvCellSize{1.0f};
+    int mCellsX{0};
+    int mCellsZ{0};
+};
+
+#endif // WALL_BROADPHASE_HPP
@@ -2,17 +2,27 @@
 
 #include "Animation.hpp"
 #include "Camera.hpp"
+#include "CPUProfiler.hpp"
+#include "FrameArena.hpp"
 #include "GLSDLHelper.hpp"
+#include "Frustum.hpp"
+#include "GLStateCache.hpp"
+#include "GPUProfiler.hpp"
 #include "GLTFModel.hpp"
+#include "JobSystem.hpp"
 #include "JSONUtils.hpp"
 #include "Level.hpp"
 #include "Material.hpp"
+#include "PhysicsTaskScheduler.hpp"
 #include "Player.hpp"
+#include "RenderStats.hpp"
 #include "RenderWindow.hpp"
 #include "ResourceManager.hpp"
 #include "Shader.hpp"
 #include "Sphere.hpp"
+#include "Telemetry.hpp"
 #include "Texture.hpp"
+#include "TextureAtlas.hpp"
 #include "VertexArrayObject.hpp"
 #include "FramebufferObject.hpp"
 #include "VertexBufferObject.hpp"
@@ -31,6 +41,8 @@
 #include <SFML/Network.hpp>
 
 #include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
 #include <glad/glad.h>
 
 #include <random>
@@ -41,15 +53,49 @@
 #include <cmath>
 #include <cstdint>
 #include <array>
+#include <cstring>
+#include <string_view>
+
+thread_local bool World::sOnSimulationThread = false;
 
 namespace
 {
-    constexpr std::uintptr_t kBodyTagSphereBase = 10;
     constexpr std::uintptr_t kBodyTagMazeWall = 4;
+    // Wall shapes carry their sphere slot above the tag bits, so a contact resolves without a lookup
+    constexpr unsigned int kUserDataTagBits = 3;
+    constexpr std::uintptr_t kUserDataTagMask = (std::uintptr_t{1} << kUserDataTagBits) - 1u;
+    // Impacts slower than this leave the wall standing; resting and sliding contacts never break it
+    constexpr float kWallBreakApproachSpeed = 2.0f;
+    // Streamed chunk walls get a collision sphere at least this often along each segment
+    constexpr float kChunkWallSphereSpacing = 2.2f;
+
+    void *wallShapeUserData(std::uint32_t sphereSlot) noexcept
+    {
+        return reinterpret_cast<void *>((static_cast<std::uintptr_t>(sphereSlot) << kUserDataTagBits) | kBodyTagMazeWall);
+    }
 
     // Raster maze geometry constants
     constexpr float kPlayerShadowCenterYOffset = 1.4175f;
     constexpr float kCharacterModelYOffset = 0.25f;
+    /// Animation tiers, counted per frame in RenderStats::Counters::animationLods
+    constexpr std::uint32_t kAnimationLodCulled = 3u;
+    /// Screen height in pixels under which a character's pose drops to half and then quarter rate
+    constexpr std::array<float, 2> kAnimationLodPixelHeights{120.0f, 48.0f};
+    constexpr float kAnimationLodHysteresis = 0.15f;
+    /// Pose updates per second of the half-rate tier; the quarter tier gets half of that
+    constexpr float kAnimationHalfRateHz = 30.0f;
+    /// The culling sphere is the bind pose's; swinging limbs reach past it
+    constexpr float kAnimationCullRadiusScale = 1.25f;
+    constexpr float kWalkParticleLifeSeconds = 1.0f;
+    // Cached wall shadow map: texels over the streamed chunk area, and the top of the casters it must hold
+    constexpr int kStaticShadowMapSize = 2048;
+    constexpr float kStaticShadowMaxY = 16.0f;
+    // Blob shadows: the geometry shader projects onto a sphere, and one this large is flat over the streamed area
+    constexpr float kFlatShadowGroundRadius = 1.0e4f;
+    constexpr float kDynamicShadowStrength = 0.4f;
+    constexpr float kPickupShadowHalfSize = 0.5f;
+    /// The sky is a few smooth gradients and a soft sun, so 1/8 resolution with bilinear filtering loses nothing visible
+    constexpr int kSkyCacheDivisor = 8;
 
     constexpr unsigned int kSimpleMazeRows = 20u;
     constexpr unsigned int kSimpleMazeCols = 20u;
@@ -66,6 +112,10 @@ namespace
     constexpr float kBoundaryAnimFps = 10.0f;
     constexpr int kBoundaryFloatingSpriteCount = 5;
     constexpr float kGoalPathLineYOffset = 0.045f;
+    // Maze geometry is culled in square tile regions of this many cells, per level
+    constexpr unsigned int kMazeClusterCells = 5u;
+    constexpr unsigned int kMazeClustersX = (kSimpleMazeCols + kMazeClusterCells - 1u) / kMazeClusterCells;
+    constexpr unsigned int kMazeClustersZ = (kSimpleMazeRows + kMazeClusterCells - 1u) / kMazeClusterCells;
 
     struct RasterVertex
     {
@@ -73,11 +123,42 @@ namespace
         glm::vec3 color;
     };
 
+    // Quantized floor vertex: half-float position (w unused) plus RGBA8 color, 12 bytes instead of 24
+    struct MazeFloorVertex
+    {
+        std::array<std::uint16_t, 4> position;
+        std::array<std::uint8_t, 4> color;
+    };
+
+    std::array<std::uint8_t, 4> packUnorm8(const glm::vec3 &color) noexcept
+    {
+        const glm::vec3 c = glm::clamp(color, glm::vec3(0.0f), glm::vec3(1.0f)) * 255.0f + 0.5f;
+        return {static_cast<std::uint8_t>(c.x), static_cast<std::uint8_t>(c.y), static_cast<std::uint8_t>(c.z), 255u};
+    }
+
     glm::vec3 computeSunDirection(float /*timeSeconds*/) noexcept
     {
         return glm::normalize(glm::vec3(-1.0f, -0.125f, 0.0f));
     }
 
+    GLTFModel::LodView characterLodView(const FrameUniforms &frame) noexcept
+    {
+        return GLTFModel::LodView{frame.viewProjection, frame.projection[1][1], frame.viewportSize.y};
+    }
+
+    /// @brief Snap the animation time to the tier's update rate, so a throttled pose repeats between updates
+    /// @details Repeated times hit GLTFModel's pose cache, skipping the joint hierarchy and the skinning
+    /// dispatch. Characters on the same tier and clip land on the same times and share the cached pose.
+    float throttleAnimationTime(float timeSeconds, std::uint32_t tier) noexcept
+    {
+        if (tier == 0u || tier >= kAnimationLodCulled)
+        {
+            return timeSeconds;
+        }
+        const float rate = kAnimationHalfRateHz / static_cast<float>(1u << (tier - 1u));
+        return std::floor(timeSeconds * rate) / rate;
+    }
+
     glm::vec3 packedRGBToLinear(std::uint32_t packed)
     {
         const float r = static_cast<float>((packed >> 16) & 0xFFu) / 255.0f;
@@ -87,12 +168,107 @@ namespace
         return glm::pow(srgb, glm::vec3(2.2f));
     }
 
+    /// @brief Stable 64-bit FNV-1a, used where std::hash may differ between builds
+    std::uint64_t fnv1a64(std::string_view data) noexcept
+    {
+        std::uint64_t hash = 0xcbf29ce484222325ull;
+        for (const char c : data)
+        {
+            hash ^= static_cast<std::uint8_t>(c);
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    template <typename T>
+    void appendPod(std::vector<std::uint8_t> &out, const T &value)
+    {
+        const auto *bytes = reinterpret_cast<const std::uint8_t *>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    template <typename T>
+    bool readPod(std::span<const std::uint8_t> &in, T &value) noexcept
+    {
+        if (in.size() < sizeof(T))
+        {
+            return false;
+        }
+        std::memcpy(&value, in.data(), sizeof(T));
+        in = in.subspan(sizeof(T));
+        return true;
+    }
+
+    void appendVec3(std::vector<std::uint8_t> &out, const glm::vec3 &v)
+    {
+        appendPod(out, v.x);
+        appendPod(out, v.y);
+        appendPod(out, v.z);
+    }
+
+    bool readVec3(std::span<const std::uint8_t> &in, glm::vec3 &v) noexcept
+    {
+        return readPod(in, v.x) && readPod(in, v.y) && readPod(in, v.z);
+    }
+
     float randomFloat(float low, float high)
     {
         static thread_local std::mt19937 rng{13371337u};
         std::uniform_real_distribution<float> distribution(low, high);
         return distribution(rng);
     }
+
+    // Node-based: one allocation per element (value plus next pointer and cached hash) and the bucket array
+    template <typename Map>
+    std::size_t hashMapBytes(const Map &map) noexcept
+    {
+        return map.size() * (sizeof(typename Map::value_type) + 2 * sizeof(void *)) + map.bucket_count() * sizeof(void *);
+    }
+}
+
+/// CPU half of the raster maze: everything buildMazeGeometry() needs short of the GL uploads
+struct World::PreparedMaze
+{
+    std::vector<MazeFloorVertex> floorVertices;
+    std::vector<GLuint> floorIndices;
+    std::vector<GLushort> shortIndices; // Filled instead of used when every vertex fits 16-bit indices
+    std::vector<MazeWallInstance> wallInstances;
+    std::vector<glm::vec3> goalPathLines;
+    std::vector<MazeCluster> clusters;
+    std::vector<glm::vec4> wallAABBs;
+    std::vector<glm::vec3> cellGradientColors;
+    std::vector<BoundarySpriteData> boundarySprites;
+    WallBroadphase wallBroadphase;
+    /// sRasterMazeSeed the maze was generated with
+    std::optional<std::uint32_t> seed;
+    GLuint groundFirstIndex{0};
+    GLsizei groundIndexCount{0};
+    glm::vec3 center{0.0f};
+    float width{0.0f};
+    float depth{0.0f};
+    float topY{0.0f};
+};
+
+std::future<std::unique_ptr<World::PreparedMaze>> World::sPrewarmedMaze;
+std::optional<std::uint32_t> World::sRasterMazeSeed;
+
+void World::prewarmMazeGeometry() noexcept
+{
+    if (sPrewarmedMaze.valid())
+    {
+        return;
+    }
+
+    try
+    {
+        sPrewarmedMaze = JobSystem::instance()->submit([seed = sRasterMazeSeed]()
+                                                       { return prepareMazeGeometry(seed); });
+        SDL_Log("World: raster maze generation started ahead of the game");
+    }
+    catch (const std::exception &e)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "World: maze prewarm unavailable: %s", e.what());
+    }
 }
 
 World::World(RenderWindow &window, FontManager &fonts, TextureManager &textures, ShaderManager &shaders, LevelsManager &levels)
@@ -124,7 +300,14 @@ void World::init() noexcept
     b2WorldDef worldDef = b2DefaultWorldDef();
     worldDef.gravity = {0.0f, 0.0f};
 
+    // The stepping thread counts as one Box2D worker on top of the pool threads
+    const int poolWorkers = static_cast<int>(JobSystem::instance()->getWorkerCount()) + 1;
+    const int physicsWorkers = (mPhysicsWorkerCount > 0) ? std::min(mPhysicsWorkerCount, poolWorkers) : poolWorkers;
+    mPhysicsScheduler = std::make_unique<PhysicsTaskScheduler>(physicsWorkers);
+    mPhysicsScheduler->configure(worldDef);
+
     mWorldId = b2CreateWorld(&worldDef);
+    SDL_Log("World: Box2D stepping with %d workers", mPhysicsScheduler->getWorkerCount());
 
     // Spawn in positive X/Z for grid shader visibility
     mPlayerSpawnPosition = glm::vec3(100.0f, 1.0f, 0.0f);
@@ -132,8 +315,20 @@ void World::init() noexcept
     initPathTracerScene();
 
     mSpheres.reserve(TOTAL_SPHERES * 4);
-    mSphereBodyIds.reserve(TOTAL_SPHERES * 4);
     mWallBreakQueue.reserve(16);
+    mContactBreakSlots.reserve(16);
+
+    // Shared by every wall shape; finalizeChunkIntegration only adds the sphere slot to the user data
+    mWallShapeDef = b2DefaultShapeDef();
+    mWallShapeDef.density = 0.0f;
+    mWallShapeDef.enableContactEvents = true;
+    // Hits report impacts on walls already touching, which begin events miss
+    mWallShapeDef.enableHitEvents = true;
+    mWallShapeDef.material.friction = 0.9f;
+    mWallShapeDef.material.restitution = 0.0f;
+    mWallShapeDef.filter.categoryBits = 0x0004;
+    mWallShapeDef.filter.maskBits = 0xFFFF;
+    mWallShapeDef.userData = reinterpret_cast<void *>(kBodyTagMazeWall);
 
     mLastChunkUpdatePosition = glm::vec3(std::numeric_limits<float>::max());
 
@@ -145,424 +340,1447 @@ void World::initWorkerPool() noexcept
 {
     mWorkersShouldStop = false;
 
-    // Create worker threads
-    for (size_t i = 0; i < NUM_WORKER_THREADS; ++i)
-    {
-        mWorkerThreads.push_back(std::async(std::launch::async, [this, i]()
-                                            {
-                while (!mWorkersShouldStop.load(std::memory_order_acquire))
-                {
-                    std::packaged_task<ChunkWorkItem()> task;
-
-                    {
-                        std::unique_lock<std::mutex> lock(mWorkQueueMutex);
-
-                        // Wait for work or shutdown signal
-                        mWorkAvailable.wait(lock, [this]() {
-                            return !mWorkQueue.empty() || mWorkersShouldStop.load(std::memory_order_acquire);
-                            });
-
-                        if (mWorkersShouldStop.load(std::memory_order_acquire) && mWorkQueue.empty())
-                        {
-                            break;
-                        }
-
-                        if (!mWorkQueue.empty())
-                        {
-                            task = std::move(mWorkQueue.front());
-                            mWorkQueue.pop();
-                        }
-                    }
-
-                    // Execute task outside the lock
-                    if (task.valid())
-                    {
-                        task();
-                    }
-                } }));
-    }
+    // Touch the shared pool so its threads are running before the first chunk request
+    const auto &jobs = *mazes::singleton_base<JobSystem>::instance();
+    mMaxInFlightChunks = std::max<size_t>(1, jobs.getWorkerCount());
+    SDL_Log("World: chunk generation using %u shared job workers", jobs.getWorkerCount());
 }
 
 void World::shutdownWorkerPool() noexcept
 {
-    // Signal stop FIRST
+    // Signal stop FIRST so queued chunk jobs bail out early
     mWorkersShouldStop.store(true, std::memory_order_release);
 
-    // Clear pending work to prevent new tasks
-    {
-        std::lock_guard<std::mutex> lock(mWorkQueueMutex);
-        // Empty the queue by popping all items
-        std::queue<std::packaged_task<ChunkWorkItem()>> empty;
-        std::swap(mWorkQueue, empty);
-    }
-
-    // Wake all workers so they can see the stop signal
-    mWorkAvailable.notify_all();
-
-    // Clear pending chunks to abandon futures
+    // The pool is shared, so wait for this World's outstanding jobs instead of joining threads
+    std::vector<PendingChunk> pending;
     {
         std::lock_guard<std::mutex> lock(mCompletedChunksMutex);
+        pending.reserve(mPendingChunks.size() + mCancelledChunks.size());
+        for (auto &[coord, chunk] : mPendingChunks)
+        {
+            pending.push_back(std::move(chunk));
+        }
+        for (auto &chunk : mCancelledChunks)
+        {
+            pending.push_back(std::move(chunk));
+        }
         mPendingChunks.clear();
+        mCancelledChunks.clear();
+        mChunkRequestQueue.clear();
+        mQueuedChunks.clear();
     }
 
-    // Wait for all workers with timeout
-    for (size_t i = 0; i < mWorkerThreads.size(); ++i)
+    auto &jobs = *mazes::singleton_base<JobSystem>::instance();
+    bool jobTimedOut = false;
+    for (auto &chunk : pending)
     {
-        auto &worker = mWorkerThreads[i];
-        if (worker.valid())
+        chunk.cancelled->store(true, std::memory_order_release);
+
+        if (!chunk.future.valid())
         {
-            try
+            continue;
+        }
+
+        try
+        {
+            // Without worker threads nothing else will ever run the job; cancelled, it returns at once
+            if (jobs.isCooperative())
             {
-                // Wait with timeout
-                auto status = worker.wait_for(std::chrono::seconds(5));
-                if (status == std::future_status::timeout)
+                while (chunk.future.wait_for(std::chrono::seconds(0)) != std::future_status::ready && jobs.runPendingJob())
                 {
-                    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
-                                "Worker thread %zu timed out waiting for shutdown", i);
                 }
             }
-            catch (const std::exception &e)
+
+            auto status = chunk.future.wait_for(std::chrono::seconds(5));
+            if (status == std::future_status::timeout)
             {
-                SDL_LogError(SDL_LOG_CATEGORY_ERROR,
-                             "Worker thread %zu shutdown exception: %s", i, e.what());
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Chunk job timed out waiting for shutdown");
+                jobTimedOut = true;
             }
         }
+        catch (const std::exception &e)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Chunk job shutdown exception: %s", e.what());
+        }
     }
 
-    mWorkerThreads.clear();
+    // Persist chunks generated this session now that no job can still be writing; a job that timed out
+    // may yet read the mapping or store a blob, so the cache is left as it is rather than unmapped under it
+    if (jobTimedOut)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "World: Chunk job still running, chunk disk cache not flushed");
+    }
+    else if (mChunkDiskCache.isOpen())
+    {
+        mChunkDiskCache.flush();
+        mChunkDiskCache.close();
+    }
 
-    // Clear maze cache AFTER all workers stopped
+    // Clear maze cache AFTER all chunk jobs finished
     {
         std::lock_guard<std::mutex> lock(mMazeCacheMutex);
+        const auto stats = mChunkMazes.getStats();
+        SDL_Log("World: maze cache hits=%llu misses=%llu evictions=%llu entries=%zu bytes=%zu/%zu",
+                static_cast<unsigned long long>(stats.hits),
+                static_cast<unsigned long long>(stats.misses),
+                static_cast<unsigned long long>(stats.evictions),
+                stats.entries, stats.bytes, stats.budgetBytes);
         mChunkMazes.clear();
     }
 }
 
-void World::submitChunkForGeneration(const ChunkCoord &coord) noexcept
+void World::setMazeCacheBudget(std::size_t budgetBytes) noexcept
 {
-    // Create packaged task for chunk generation
-    std::packaged_task<ChunkWorkItem()> task(
-        [this, coord]() -> ChunkWorkItem
-        {
-            return generateChunkAsync(coord);
-        });
+    std::lock_guard<std::mutex> lock(mMazeCacheMutex);
+    mChunkMazes.setBudget(budgetBytes);
+}
 
-    // Get future before moving task
-    auto future = task.get_future();
+LRUCacheStats World::getMazeCacheStats() const noexcept
+{
+    std::lock_guard<std::mutex> lock(mMazeCacheMutex);
+    return mChunkMazes.getStats();
+}
 
-    // Add to work queue
+void World::enableChunkDiskCache(const std::string &path) noexcept
+{
+    // Chunk content depends on the level data through the maze seed
+    std::uint64_t levelHash = 0;
+    try
     {
-        std::lock_guard<std::mutex> lock(mWorkQueueMutex);
-        mWorkQueue.push(std::move(task));
+        levelHash = fnv1a64(mLevels.get(Levels::ID::LEVEL_ONE).getData());
     }
-
-    // Store future for later retrieval
+    catch (const std::exception &)
     {
-        std::lock_guard<std::mutex> lock(mCompletedChunksMutex);
-        mPendingChunks.emplace_back(coord, std::move(future));
+        // No level data: cache entries are keyed on the base seed alone
     }
 
-    // Notify one worker
-    mWorkAvailable.notify_one();
+    mChunkDiskCache.open(path, CHUNK_PAYLOAD_VERSION, levelHash);
 }
 
-World::ChunkWorkItem World::generateChunkAsync(const ChunkCoord &coord) const noexcept
+std::vector<std::uint8_t> World::serializeChunk(const ChunkWorkItem &item) noexcept
 {
-    using MaterialType = Material::MaterialType;
-
-    ChunkWorkItem result;
-    result.coord = coord;
-    result.hasSpawnPosition = false;
+    std::vector<std::uint8_t> out;
 
     try
     {
-        // Generate maze (thread-safe with mutex)
-        std::string mazeStr = generateMazeForChunk(coord);
-        if (mazeStr.empty())
+        out.reserve(item.grid.walls.size() + item.spheres.size() * 48 + item.pickupSpheres.size() * 16 + 32);
+
+        out.insert(out.end(), item.grid.walls.begin(), item.grid.walls.end());
+
+        appendPod(out, static_cast<std::uint32_t>(item.spheres.size()));
+        for (const auto &sphere : item.spheres)
         {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
-                        "Worker: Empty maze for chunk (%d, %d)", coord.x, coord.z);
-            return result;
+            appendVec3(out, sphere.getCenter());
+            appendPod(out, sphere.getRadius());
+            appendVec3(out, sphere.getAlbedo());
+            appendPod(out, static_cast<std::uint32_t>(sphere.getMaterialType()));
+            appendPod(out, sphere.getFuzz());
+            appendPod(out, sphere.getRefractiveIndex());
+            appendPod(out, sphere.getTextureBlend());
         }
 
-        // Parse maze cells - now returns spawn position in work item
-        result.cells = parseMazeCells(mazeStr, coord, result.spawnPosition, result.hasSpawnPosition);
-
-        buildMazeWallSpheres(result.cells, result.spheres);
+        appendPod(out, static_cast<std::uint32_t>(item.pickupSpheres.size()));
+        for (const auto &pickup : item.pickupSpheres)
+        {
+            appendVec3(out, pickup.position);
+            appendPod(out, static_cast<std::int32_t>(pickup.value));
+        }
 
-        // Generate pickup spheres at cells where distance % 5 == 0
-        buildPickupSpheres(result.cells, result.pickupSpheres, coord);
+        appendPod(out, static_cast<std::uint8_t>(item.hasSpawnPosition ? 1 : 0));
+        appendVec3(out, item.spawnPosition);
     }
-    catch (const std::exception &e)
+    catch (const std::exception &)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_ERROR,
-                     "Worker: Exception generating chunk (%d, %d): %s",
-                     coord.x, coord.z, e.what());
+        out.clear();
     }
 
-    return result;
+    return out;
 }
 
-void World::processCompletedChunks() noexcept
+bool World::deserializeChunk(std::span<const std::uint8_t> bytes, ChunkWorkItem &item) noexcept
 {
-    using MaterialType = Material::MaterialType;
-
-    std::lock_guard<std::mutex> lock(mCompletedChunksMutex);
-
-    auto it = mPendingChunks.begin();
-    while (it != mPendingChunks.end())
+    try
     {
-        auto &[coord, future] = *it;
-
-        if (future.wait_for(std::chrono::milliseconds(0)) == std::future_status::ready)
+        if (bytes.size() < item.grid.walls.size())
         {
-            try
-            {
-                ChunkWorkItem workItem = future.get();
-
-                // Update spawn position if found
-                if (workItem.hasSpawnPosition)
-                {
-                    mPlayerSpawnPosition = workItem.spawnPosition;
-                }
-
-                std::vector<size_t> sphereIndices;
-
-                // Create physics bodies for chunk-generated maze walls
-                for (const auto &sphere : workItem.spheres)
-                {
-                    size_t sphereIndex = mSpheres.size();
-                    sphereIndices.push_back(sphereIndex);
-
-                    mSpheres.push_back(sphere);
-
-                    if (b2World_IsValid(mWorldId))
-                    {
-                        b2BodyDef bodyDef = b2DefaultBodyDef();
-                        bodyDef.type = b2_staticBody;
-                        bodyDef.position = {sphere.getCenter().x, sphere.getCenter().z};
-
-                        b2BodyId bodyId = b2CreateBody(mWorldId, &bodyDef);
-
-                        if (b2Body_IsValid(bodyId))
-                        {
-                            b2ShapeDef shapeDef = b2DefaultShapeDef();
-                            shapeDef.density = 0.0f;
-                            shapeDef.enableContactEvents = true;
-                            shapeDef.enableHitEvents = false;
-
-                            b2Circle circle = {{0.0f, 0.0f}, sphere.getRadius()};
-                            b2ShapeId shapeId = b2CreateCircleShape(bodyId, &shapeDef, &circle);
+            return false;
+        }
+        std::memcpy(item.grid.walls.data(), bytes.data(), item.grid.walls.size());
+        bytes = bytes.subspan(item.grid.walls.size());
+        item.grid.valid = true;
 
-                            b2Shape_SetFriction(shapeId, 0.9f);
-                            b2Shape_SetRestitution(shapeId, 0.0f);
-                            b2Body_SetAwake(bodyId, false);
+        std::uint32_t sphereCount = 0;
+        if (!readPod(bytes, sphereCount))
+        {
+            return false;
+        }
 
-                            b2Filter filter = b2Shape_GetFilter(shapeId);
-                            filter.categoryBits = 0x0004;
-                            filter.maskBits = 0xFFFF;
-                            b2Shape_SetFilter(shapeId, filter);
+        item.spheres.reserve(sphereCount);
+        for (std::uint32_t i = 0; i < sphereCount; ++i)
+        {
+            glm::vec3 center{}, albedo{};
+            float radius = 0.0f, fuzz = 0.0f, ior = 1.5f, textureBlend = 0.0f;
+            std::uint32_t matType = 0;
 
-                            b2Body_SetUserData(bodyId, reinterpret_cast<void *>(kBodyTagMazeWall));
-                            b2Shape_SetUserData(shapeId, reinterpret_cast<void *>(kBodyTagMazeWall));
-                        }
+            if (!readVec3(bytes, center) || !readPod(bytes, radius) || !readVec3(bytes, albedo) ||
+                !readPod(bytes, matType) || !readPod(bytes, fuzz) || !readPod(bytes, ior) ||
+                !readPod(bytes, textureBlend))
+            {
+                return false;
+            }
 
-                        mSphereBodyIds.push_back(bodyId);
-                    }
-                    else
-                    {
-                        mSphereBodyIds.push_back(b2_nullBodyId);
-                    }
-                }
+            item.spheres.emplace_back(center, radius, albedo, static_cast<Material::MaterialType>(matType), fuzz, ior);
+            item.spheres.back().setTextureBlend(textureBlend);
+        }
 
-                // IMPORTANT: Mark chunk as loaded BEFORE updating indices
-                // This prevents race condition where unloadChunk is called before we're done
-                mLoadedChunks.insert(coord);
-                mChunkSphereIndices[coord] = sphereIndices;
-                mPersistentSphereCount += sphereIndices.size();
+        std::uint32_t pickupCount = 0;
+        if (!readPod(bytes, pickupCount))
+        {
+            return false;
+        }
 
-                // Integrate pickup spheres from the work item
-                for (auto &pickup : workItem.pickupSpheres)
-                {
-                    mPickupSpheres.push_back(pickup);
-                }
-            }
-            catch (const std::exception &e)
+        item.pickupSpheres.reserve(pickupCount);
+        for (std::uint32_t i = 0; i < pickupCount; ++i)
+        {
+            PickupSphere pickup;
+            std::int32_t value = 0;
+            if (!readVec3(bytes, pickup.position) || !readPod(bytes, value))
             {
-                SDL_LogError(SDL_LOG_CATEGORY_ERROR,
-                             "World: Exception integrating chunk (%d, %d): %s",
-                             coord.x, coord.z, e.what());
+                return false;
             }
-
-            it = mPendingChunks.erase(it);
+            pickup.value = value;
+            pickup.collected = false;
+            item.pickupSpheres.push_back(pickup);
         }
-        else
+
+        std::uint8_t hasSpawn = 0;
+        if (!readPod(bytes, hasSpawn) || !readVec3(bytes, item.spawnPosition))
         {
-            ++it;
+            return false;
         }
+        item.hasSpawnPosition = hasSpawn != 0;
+        return true;
     }
-}
-
-void World::update(float dt)
-{
-    // Process any completed chunk generation work
-    processCompletedChunks();
-
-    if (b2World_IsValid(mWorldId))
+    catch (const std::exception &)
     {
-        b2World_Step(mWorldId, dt, 4);
-        breakQueuedWalls();
-
-        // Sync physics body positions to 3D sphere positions for path tracer
-        syncPhysicsToSpheres();
+        return false;
     }
 }
 
-void World::draw() const noexcept
+void World::ChunkWorkItem::clear() noexcept
 {
-
+    grid = ChunkMazeGrid{};
+    spheres.clear();
+    pickupSpheres.clear();
+    wallInstances.clear();
+    sphereWalls.clear();
+    shapes.clear();
+    spawnPosition = glm::vec3(0.0f);
+    hasSpawnPosition = false;
 }
 
-// ============================================================================
-// Scene rendering implementation (moved from GameState)
-// ============================================================================
-
-void World::initRendering(VAOManager *vaos, FBOManager *fbos, VBOManager *vbos,
-                          ModelsManager *models, int windowWidth, int windowHeight,
-                          const Player &player) noexcept
+World::ChunkSlab World::acquireChunkSlab() const
 {
-    mVAOManager = vaos;
-    mFBOManager = fbos;
-    mVBOManager = vbos;
-    mModelsManager = models;
-
-    try
     {
-        mMazeShader = &mShaders.get(Shaders::ID::GLSL_MAZE);
-        mSkyShader = &mShaders.get(Shaders::ID::GLSL_SKY);
-        mGoalPathStencilShader = &mShaders.get(Shaders::ID::GLSL_GOAL_PATH_STENCIL);
-        mBoundarySpriteShader = &mShaders.get(Shaders::ID::GLSL_BILLBOARD_SPRITE);
-        mShadowShader = &mShaders.get(Shaders::ID::GLSL_SHADOW_VOLUME);
-        mSkinnedCharacterShader = &mShaders.get(Shaders::ID::GLSL_SKINNED_MODEL);
-        mWalkParticlesComputeShader = &mShaders.get(Shaders::ID::GLSL_PARTICLES_COMPUTE);
-        mWalkParticlesRenderShader = &mShaders.get(Shaders::ID::GLSL_FULLSCREEN_QUAD_MVP);
+        std::lock_guard<std::mutex> lock(mChunkSlabMutex);
+        if (!mFreeChunkSlabs.empty())
+        {
+            ChunkSlab slab = std::move(mFreeChunkSlabs.back());
+            mFreeChunkSlabs.pop_back();
+            return slab;
+        }
     }
-    catch (const std::exception &e)
+
+    auto slab = std::make_unique<ChunkWorkItem>();
+    slab->spheres.reserve(CHUNK_WALL_SPHERE_CAPACITY);
+    slab->shapes.reserve(CHUNK_WALL_SPHERE_CAPACITY);
+    slab->pickupSpheres.reserve(CHUNK_PICKUP_RESERVE);
+    slab->wallInstances.reserve(CHUNK_WALL_INSTANCE_CAPACITY);
+    return slab;
+}
+
+void World::releaseChunkSlab(ChunkSlab slab) const noexcept
+{
+    if (!slab)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "World::initRendering: Failed to get shaders: %s", e.what());
         return;
     }
+    slab->clear();
 
-    try
-    {
-        mBillboardColorTex = &mTextures.get(Textures::ID::BILLBOARD_COLOR);
-        mOITAccumTex = &mTextures.get(Textures::ID::OIT_ACCUM);
-        mOITRevealTex = &mTextures.get(Textures::ID::OIT_REVEAL);
-        mShadowTexture = &mTextures.get(Textures::ID::SHADOW_MAP);
-        mReflectionColorTex = &mTextures.get(Textures::ID::REFLECTION_COLOR);
-    }
-    catch (const std::exception &e)
+    // More than a full load radius of spare slabs only happens after a burst; let those go
+    std::lock_guard<std::mutex> lock(mChunkSlabMutex);
+    if (mFreeChunkSlabs.size() < CHUNK_GEOMETRY_SLOTS)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "World::initRendering: Failed to get textures: %s", e.what());
-        return;
+        mFreeChunkSlabs.push_back(std::move(slab));
     }
-
-    initializeWalkParticles(player);
-    mRenderInitialized = true;
 }
 
-void World::drawScene(const Camera &camera, const Player &player,
-                      int windowWidth, int windowHeight,
-                      float modelAnimTime, float playerPlanarSpeed) const noexcept
+void World::submitChunkForGeneration(const ChunkCoord &coord) noexcept
 {
-    if (!mRenderInitialized)
-        return;
+    auto cancelled = std::allocate_shared<std::atomic<bool>>(
+        std::pmr::polymorphic_allocator<std::atomic<bool>>{JobSystem::getTaskResource()}, false);
+
+    // The worker writes into the slab in place; only the pointer comes back through the future
+    ChunkSlab slab = acquireChunkSlab();
+    slab->coord = coord;
+    auto future = mazes::singleton_base<JobSystem>::instance()->submit(
+        [this, coord, cancelled, slab = std::move(slab)]() mutable -> ChunkSlab
+        {
+            generateChunkAsync(coord, *cancelled, *slab);
+            return std::move(slab);
+        });
 
-    renderRasterMaze(camera, player, windowWidth, windowHeight);
-    renderGoalPathStencil(camera, windowWidth, windowHeight);
-    renderBoundaryCharacterBillboards(camera, windowWidth, windowHeight);
-    renderPickupSpheres(camera, windowWidth, windowHeight);
-    renderPlayerCharacterModel(camera, player, windowWidth, windowHeight, modelAnimTime);
-    renderWalkParticles(camera, player, windowWidth, windowHeight, playerPlanarSpeed);
+    // Store future for later retrieval
+    std::lock_guard<std::mutex> lock(mCompletedChunksMutex);
+    mPendingChunks.emplace(coord, PendingChunk{std::move(future), std::move(cancelled), std::chrono::steady_clock::now()});
 }
 
-void World::createCompositeTargets(int windowWidth, int windowHeight) noexcept
+void World::dispatchChunkRequests() noexcept
 {
-    if (windowWidth <= 0 || windowHeight <= 0)
-        return;
-
-    if (!mBillboardColorTex || !mOITAccumTex || !mOITRevealTex)
+    // Keep at most one chunk per worker in flight so a camera move can still reorder the rest
+    while (!mChunkRequestQueue.empty() && mPendingChunks.size() < mMaxInFlightChunks)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "World: Composite textures not initialized in manager");
-        return;
+        std::pop_heap(mChunkRequestQueue.begin(), mChunkRequestQueue.end(), ChunkRequestCompare{});
+        const ChunkCoord coord = mChunkRequestQueue.back().coord;
+        mChunkRequestQueue.pop_back();
+        mQueuedChunks.erase(coord);
+
+        submitChunkForGeneration(coord);
     }
+}
 
-    if (!mBillboardColorTex->loadRenderTarget(windowWidth, windowHeight, Texture::RenderTargetFormat::RGBA16F, 0))
+void World::cancelStaleChunkWork(const std::pmr::unordered_map<ChunkCoord, int, ChunkCoordHash> &desiredChunks) noexcept
+{
+    // Drop queued requests that are no longer wanted and re-key the rest for the new center and path
+    auto staleBegin = std::remove_if(mChunkRequestQueue.begin(), mChunkRequestQueue.end(),
+                                     [&desiredChunks](const ChunkRequest &request)
+                                     { return desiredChunks.find(request.coord) == desiredChunks.end(); });
+    for (auto it = staleBegin; it != mChunkRequestQueue.end(); ++it)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "World: Failed to allocate billboard texture");
-        return;
+        mQueuedChunks.erase(it->coord);
     }
+    mChunkRequestQueue.erase(staleBegin, mChunkRequestQueue.end());
 
-    auto &billboardFBO = mFBOManager->get(FBOs::ID::BILLBOARD);
-    billboardFBO.bindRenderbuffer();
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, windowWidth, windowHeight);
-
-    billboardFBO.bind();
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mBillboardColorTex->get(), 0);
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, billboardFBO.getRenderbuffer());
-    glDrawBuffer(GL_COLOR_ATTACHMENT0);
-    glReadBuffer(GL_COLOR_ATTACHMENT0);
-
-    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
-        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "World: Billboard framebuffer incomplete");
-
-    if (!mOITAccumTex->loadRenderTarget(windowWidth, windowHeight, Texture::RenderTargetFormat::RGBA16F, 0))
+    for (auto &request : mChunkRequestQueue)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "World: Failed to allocate OIT accum texture");
-        return;
+        request.priority = desiredChunks.at(request.coord);
     }
+    std::make_heap(mChunkRequestQueue.begin(), mChunkRequestQueue.end(), ChunkRequestCompare{});
 
-    if (!mOITRevealTex->loadRenderTarget(windowWidth, windowHeight, Texture::RenderTargetFormat::R16F, 0))
+    // Started work inside the load radius is kept: the path may swing back before it would be wasted
+    const auto isStale = [this, &desiredChunks](const ChunkCoord &coord)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "World: Failed to allocate OIT reveal texture");
+        return desiredChunks.find(coord) == desiredChunks.end() && !isWithinLoadRadius(coord);
+    };
+
+    // Chunks still being integrated are not visible yet, so dropping them is just freeing the staging body
+    for (auto it = mIntegrationQueue.begin(); it != mIntegrationQueue.end();)
+    {
+        if (isStale(it->item->coord))
+        {
+            if (b2Body_IsValid(it->bodyId))
+            {
+                b2DestroyBody(it->bodyId);
+            }
+            mIntegratingChunks.erase(it->item->coord);
+            releaseChunkSlab(std::move(it->item));
+            it = mIntegrationQueue.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    // Flag in-flight jobs that are no longer wanted; their results are discarded on completion
+    std::lock_guard<std::mutex> lock(mCompletedChunksMutex);
+    for (auto it = mPendingChunks.begin(); it != mPendingChunks.end();)
+    {
+        if (isStale(it->first))
+        {
+            it->second.cancelled->store(true, std::memory_order_release);
+            mCancelledChunks.push_back(std::move(it->second));
+            it = mPendingChunks.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+int World::chunkPriority(const ChunkCoord &coord, const ChunkCoord &center) noexcept
+{
+    const int dx = coord.x - center.x;
+    const int dz = coord.z - center.z;
+    return dx * dx + dz * dz;
+}
+
+bool World::isWithinLoadRadius(const ChunkCoord &coord) const noexcept
+{
+    return std::abs(coord.x - mCenterChunk.x) <= CHUNK_LOAD_RADIUS &&
+           std::abs(coord.z - mCenterChunk.z) <= CHUNK_LOAD_RADIUS;
+}
+
+glm::vec3 World::projectStreamTarget(const glm::vec3 &position, const glm::vec3 &velocity) const noexcept
+{
+    const glm::vec2 planar(velocity.x, velocity.z);
+    const float speed = glm::length(planar);
+    if (speed < CHUNK_PREFETCH_MIN_SPEED)
+    {
+        return position;
+    }
+
+    const float reach = std::min(speed * mChunkPrefetchSeconds, static_cast<float>(CHUNK_PREFETCH_MAX_CHUNKS) * CHUNK_SIZE);
+    const glm::vec2 offset = planar * (reach / speed);
+    return position + glm::vec3(offset.x, 0.0f, offset.y);
+}
+
+World::ChunkStreamStats World::getChunkStreamStats() const noexcept
+{
+    if (forwardsToSimulation())
+    {
+        return mSnapshots.front().streaming;
+    }
+    return mStreamStats;
+}
+
+void World::generateChunkAsync(const ChunkCoord &coord, const std::atomic<bool> &cancelled, ChunkWorkItem &result) const noexcept
+{
+    BW_PROFILE_ZONE("World::generateChunk");
+    using MaterialType = Material::MaterialType;
+
+    result.coord = coord;
+    result.hasSpawnPosition = false;
+
+    auto shouldAbandon = [this, &cancelled]()
+    {
+        return cancelled.load(std::memory_order_acquire) || mWorkersShouldStop.load(std::memory_order_acquire);
+    };
+
+    if (shouldAbandon())
+    {
+        return;
+    }
+
+    // Chunks from a previous run come straight out of the mapped disk cache
+    if (mChunkDiskCache.isOpen())
+    {
+        if (auto blob = mChunkDiskCache.find(coord.x, coord.z); !blob.empty())
+        {
+            if (deserializeChunk(blob, result))
+            {
+                // Wall boxes are cheap to derive from the grid, so they are not part of the payload
+                buildChunkWallInstances(result.grid, coord, result.wallInstances, result.sphereWalls);
+                return;
+            }
+            // A truncated payload may have filled part of the slab
+            result.clear();
+        }
+    }
+
+    try
+    {
+        // Generate maze (thread-safe with mutex)
+        result.grid = generateMazeForChunk(coord);
+        if (shouldAbandon())
+        {
+            return;
+        }
+
+        if (!result.grid.valid)
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                        "Worker: Empty maze for chunk (%d, %d)", coord.x, coord.z);
+            return;
+        }
+
+        // Spawn position travels in the work item
+        findChunkSpawn(coord, result.spawnPosition, result.hasSpawnPosition);
+
+        buildMazeWallSpheres(result.grid, coord, result.spheres);
+        buildChunkWallInstances(result.grid, coord, result.wallInstances, result.sphereWalls);
+
+        // Generate pickup spheres at cells where distance % 5 == 0
+        buildPickupSpheres(result.grid, result.pickupSpheres, coord);
+
+        if (mChunkDiskCache.isOpen())
+        {
+            mChunkDiskCache.store(coord.x, coord.z, serializeChunk(result));
+        }
+    }
+    catch (const std::exception &e)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR,
+                     "Worker: Exception generating chunk (%d, %d): %s",
+                     coord.x, coord.z, e.what());
+    }
+}
+
+void World::processCompletedChunks() noexcept
+{
+    BW_PROFILE_ZONE("World::processCompletedChunks");
+    {
+        std::lock_guard<std::mutex> lock(mCompletedChunksMutex);
+
+        // Reap cancelled jobs once they finish; their results are thrown away and the slabs reused
+        for (auto it = mCancelledChunks.begin(); it != mCancelledChunks.end();)
+        {
+            if (it->future.valid() && it->future.wait_for(std::chrono::milliseconds(0)) != std::future_status::ready)
+            {
+                ++it;
+                continue;
+            }
+            if (it->future.valid())
+            {
+                try
+                {
+                    releaseChunkSlab(it->future.get());
+                }
+                catch (const std::exception &)
+                {
+                }
+            }
+            it = mCancelledChunks.erase(it);
+        }
+
+        // Move finished jobs into the integration queue; the real work is time-sliced below
+        auto it = mPendingChunks.begin();
+        while (it != mPendingChunks.end())
+        {
+            const ChunkCoord coord = it->first;
+            auto &future = it->second.future;
+
+            if (future.wait_for(std::chrono::milliseconds(0)) != std::future_status::ready)
+            {
+                ++it;
+                continue;
+            }
+
+            try
+            {
+                ChunkIntegration integration;
+                integration.item = future.get();
+                integration.item->coord = coord;
+                Telemetry::recordChunkArrival(
+                    std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - it->second.requestedAt).count());
+                integration.handles.reserve(integration.item->spheres.size());
+                mIntegratingChunks.insert(coord);
+                mIntegrationQueue.push_back(std::move(integration));
+            }
+            catch (const std::exception &e)
+            {
+                SDL_LogError(SDL_LOG_CATEGORY_ERROR,
+                             "World: Exception collecting chunk (%d, %d): %s",
+                             coord.x, coord.z, e.what());
+            }
+
+            it = mPendingChunks.erase(it);
+        }
+    }
+
+    // Completed jobs freed worker slots; hand out the next closest chunks
+    dispatchChunkRequests();
+
+    integrateChunks(std::chrono::steady_clock::now() + mIntegrationBudget);
+    updateMemoryStats();
+}
+
+void World::updateMemoryStats() noexcept
+{
+    mSphereBytes.set(mSpheres.getCapacityBytes());
+
+    std::size_t bodyBytes = hashMapBytes(mChunkBodies) + hashMapBytes(mBodyToChunk) + hashMapBytes(mChunkSphereHandles) +
+                            hashMapBytes(mChunkSphereWalls);
+    for (const auto &[coord, handles] : mChunkSphereHandles)
+    {
+        bodyBytes += handles.capacity() * sizeof(SlotHandle);
+    }
+    for (const auto &[coord, walls] : mChunkSphereWalls)
+    {
+        bodyBytes += walls.capacity() * sizeof(std::int16_t);
+    }
+    mBodyBytes.set(bodyBytes);
+
+    mMazeBytes.set(getMazeCacheStats().bytes);
+
+    std::size_t pickupBytes = mPickups.getCapacityBytes() + hashMapBytes(mChunkPickupHandles) +
+                              mPickupGrid.size() * (sizeof(glm::vec2) + sizeof(SlotHandle));
+    for (const auto &[coord, handles] : mChunkPickupHandles)
+    {
+        pickupBytes += handles.capacity() * sizeof(SlotHandle);
+    }
+    mPickupBytes.set(pickupBytes);
+}
+
+void World::integrateChunks(std::chrono::steady_clock::time_point deadline) noexcept
+{
+    BW_PROFILE_ZONE("World::integrateChunks");
+    // Checking the clock per shape would cost more than the shapes themselves
+    constexpr std::size_t kShapesPerClockCheck = 16;
+
+    while (!mIntegrationQueue.empty())
+    {
+        ChunkIntegration &integration = mIntegrationQueue.front();
+        ChunkWorkItem &workItem = *integration.item;
+
+        // Stage walls on a disabled body so half-built chunks never show up in physics queries
+        if (!b2Body_IsValid(integration.bodyId) && b2World_IsValid(mWorldId) && !workItem.spheres.empty())
+        {
+            b2BodyDef bodyDef = b2DefaultBodyDef();
+            bodyDef.type = b2_staticBody;
+            bodyDef.position = {0.0f, 0.0f};
+            bodyDef.isEnabled = false;
+            bodyDef.userData = reinterpret_cast<void *>(kBodyTagMazeWall);
+            integration.bodyId = b2CreateBody(mWorldId, &bodyDef);
+        }
+
+        while (integration.nextSphere < workItem.spheres.size())
+        {
+            const Sphere &sphere = workItem.spheres[integration.nextSphere];
+
+            b2ShapeId shapeId = b2_nullShapeId;
+            if (b2Body_IsValid(integration.bodyId))
+            {
+                const b2Circle circle = {{sphere.getCenter().x, sphere.getCenter().z}, sphere.getRadius()};
+                shapeId = b2CreateCircleShape(integration.bodyId, &mWallShapeDef, &circle);
+            }
+            workItem.shapes.push_back(shapeId);
+            ++integration.nextSphere;
+
+            if (integration.nextSphere % kShapesPerClockCheck == 0 &&
+                std::chrono::steady_clock::now() >= deadline)
+            {
+                // Resume this chunk next frame
+                return;
+            }
+        }
+
+        const ChunkCoord coord = workItem.coord;
+        finalizeChunkIntegration(integration);
+        // Normally the slab went on to the render thread; after a failed integration it comes back here
+        releaseChunkSlab(std::move(integration.item));
+        mIntegratingChunks.erase(coord);
+        mIntegrationQueue.pop_front();
+
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            return;
+        }
+    }
+}
+
+void World::finalizeChunkIntegration(ChunkIntegration &integration) noexcept
+{
+    ChunkWorkItem &workItem = *integration.item;
+    const ChunkCoord coord = workItem.coord;
+
+    try
+    {
+        // Update spawn position if found
+        if (workItem.hasSpawnPosition)
+        {
+            mPlayerSpawnPosition = workItem.spawnPosition;
+        }
+
+        // Publish spheres, body and pickups together so queries see the whole chunk or none of it
+        for (std::size_t i = 0; i < workItem.spheres.size(); ++i)
+        {
+            const Sphere &sphere = workItem.spheres[i];
+            const b2ShapeId shapeId = workItem.shapes[i];
+
+            const SlotHandle handle = mSpheres.insert(sphere.getCenter(), sphere.getRadius(), shapeId, sphere,
+                                                      static_cast<std::uint16_t>(i));
+            integration.handles.push_back(handle);
+
+            if (b2Shape_IsValid(shapeId))
+            {
+                b2Shape_SetUserData(shapeId, wallShapeUserData(handle.index));
+            }
+        }
+
+        if (b2Body_IsValid(integration.bodyId))
+        {
+            b2Body_Enable(integration.bodyId);
+            mChunkBodies[coord] = integration.bodyId;
+            mBodyToChunk[b2StoreBodyId(integration.bodyId)] = coord;
+        }
+
+        // Static bodies never report move events, so place the new walls on the planet now
+        syncSphereHandles(integration.handles);
+
+        mLoadedChunks.insert(coord);
+        if (mAwaitedChunk == coord)
+        {
+            const float lateMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - mAwaitedSince).count();
+            mStreamStats.lastLateMs = lateMs;
+            mStreamStats.worstLateMs = std::max(mStreamStats.worstLateMs, lateMs);
+            Telemetry::recordLateChunk(lateMs);
+            mAwaitedChunk.reset();
+        }
+        mChunkSphereHandles[coord] = std::move(integration.handles);
+        // A cached payload from another sphere layout gets no wall table; its walls then break one sphere at a time
+        auto &sphereWalls = mChunkSphereWalls[coord];
+        if (workItem.sphereWalls.size() == workItem.spheres.size())
+        {
+            sphereWalls.assign(workItem.sphereWalls.begin(), workItem.sphereWalls.end());
+        }
+        else
+        {
+            sphereWalls.clear();
+        }
+
+        // Integrate pickup spheres from the work item
+        auto &pickupHandles = mChunkPickupHandles[coord];
+        pickupHandles.reserve(workItem.pickupSpheres.size());
+        for (const auto &pickup : workItem.pickupSpheres)
+        {
+            const SlotHandle handle = mPickups.insert(pickup);
+            mPickupGrid.insert(glm::vec2(pickup.position.x, pickup.position.z), handle);
+            pickupHandles.push_back(handle);
+        }
+        markPickupsChanged();
+
+        // The slab itself carries the wall boxes to the render thread, which returns it after the upload;
+        // without one (headless runs) nothing would drain the queue, so the slab goes straight back
+        if (mRenderInitialized)
+        {
+            std::lock_guard<std::mutex> lock(mChunkGeometryMutex);
+            mChunkGeometryUpdates.push_back({coord, std::move(integration.item), false});
+        }
+        else
+        {
+            releaseChunkSlab(std::move(integration.item));
+        }
+    }
+    catch (const std::exception &e)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR,
+                     "World: Exception integrating chunk (%d, %d): %s",
+                     coord.x, coord.z, e.what());
+    }
+}
+
+void World::setChunkIntegrationBudget(std::chrono::microseconds budget) noexcept
+{
+    mIntegrationBudget = budget;
+}
+
+World::PhysicsStats World::getPhysicsStats() const noexcept
+{
+    if (forwardsToSimulation())
+    {
+        return mSnapshots.front().physics;
+    }
+
+    PhysicsStats stats;
+    if (mPhysicsScheduler)
+    {
+        stats.workerCount = mPhysicsScheduler->getWorkerCount();
+        stats.tasksPerStep = mPhysicsScheduler->getTasksLastStep();
+    }
+
+    if (b2World_IsValid(mWorldId))
+    {
+        const b2Profile profile = b2World_GetProfile(mWorldId);
+        stats.stepMs = profile.step;
+        stats.collideMs = profile.collide;
+        stats.solveMs = profile.solve;
+    }
+    return stats;
+}
+
+void World::update(float dt)
+{
+    BW_PROFILE_ZONE("World::update");
+    if (!forwardsToSimulation())
+    {
+        stepSimulation(dt);
+        return;
+    }
+
+    postSimulationCommand([this, dt]()
+                          {
+                              stepSimulation(dt);
+                              publishSimulationSnapshot();
+                          });
+
+    // Present whatever the simulation finished most recently; never wait for this step
+    if (mSnapshots.consume() && mSnapshots.front().pickups.get() != mPresentedPickups)
+    {
+        mPresentedPickups = mSnapshots.front().pickups.get();
+        mPickupsDirty = true;
+    }
+}
+
+void World::stepSimulation(float dt) noexcept
+{
+    BW_PROFILE_ZONE("World::stepSimulation");
+    // Process any completed chunk generation work
+    processCompletedChunks();
+
+    if (b2World_IsValid(mWorldId))
+    {
+        if (mPhysicsScheduler)
+        {
+            mPhysicsScheduler->beginStep();
+        }
+        b2World_Step(mWorldId, dt, 4);
+        breakQueuedWalls();
+        queueContactWallBreaks();
+
+        // Sync physics body positions to 3D sphere positions for path tracer
+        syncPhysicsToSpheres();
+    }
+}
+
+void World::startSimulationThread()
+{
+    if (isSimulationThreaded())
+    {
+        return;
+    }
+
+    // The simulation thread has to coexist with the pool; where the pool found no threads, neither will it
+    if (mazes::singleton_base<JobSystem>::instance()->isCooperative())
+    {
+        SDL_Log("World: no threads available, simulation stays on the main thread");
+        return;
+    }
+
+    // Seed the reader side so the first frames have a valid snapshot before the thread publishes
+    mSnapshotPickupsStale = true;
+    publishSimulationSnapshot();
+    mSnapshots.consume();
+    mPresentedPickups = mSnapshots.front().pickups.get();
+    mPickupsDirty = true;
+
+    {
+        std::lock_guard<std::mutex> lock(mSimMutex);
+        mSimStopRequested = false;
+    }
+    mSimThreaded.store(true, std::memory_order_release);
+    mSimThread = std::thread([this]()
+                             { simulationLoop(); });
+
+    SDL_Log("World: simulation running on its own thread");
+}
+
+void World::stopSimulationThread() noexcept
+{
+    if (!mSimThread.joinable())
+    {
+        mSimThreaded.store(false, std::memory_order_release);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mSimMutex);
+        mSimStopRequested = true;
+    }
+    mSimCondition.notify_one();
+    mSimThread.join();
+
+    // Back to single-threaded: everything is owned by the caller again
+    mSimThreaded.store(false, std::memory_order_release);
+    mSimCommands.clear();
+    mSimCollectedPoints.store(0, std::memory_order_relaxed);
+    mPickupsDirty = true;
+}
+
+void World::simulationLoop() noexcept
+{
+    sOnSimulationThread = true;
+    BW_PROFILE_THREAD("Simulation");
+    std::vector<std::function<void()>> commands;
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mSimMutex);
+            mSimCondition.wait(lock, [this]()
+                               { return mSimStopRequested || !mSimCommands.empty(); });
+
+            // Finish what was already queued before honouring a stop
+            if (mSimCommands.empty() && mSimStopRequested)
+            {
+                return;
+            }
+            commands.swap(mSimCommands);
+        }
+
+        for (auto &command : commands)
+        {
+            try
+            {
+                command();
+            }
+            catch (const std::exception &e)
+            {
+                SDL_LogError(SDL_LOG_CATEGORY_ERROR, "World: simulation command failed: %s", e.what());
+            }
+        }
+        commands.clear();
+    }
+}
+
+void World::postSimulationCommand(std::function<void()> command)
+{
+    {
+        std::lock_guard<std::mutex> lock(mSimMutex);
+        mSimCommands.push_back(std::move(command));
+    }
+    mSimCondition.notify_one();
+}
+
+void World::runOnSimulation(const std::function<void()> &work)
+{
+    if (!forwardsToSimulation())
+    {
+        work();
+        return;
+    }
+
+    auto done = std::make_shared<std::promise<void>>();
+    std::future<void> finished = done->get_future();
+    postSimulationCommand([&work, done]()
+                          {
+                              work();
+                              done->set_value();
+                          });
+    // The simulation thread finishes queued commands before it stops, so this always returns
+    finished.wait();
+}
+
+void World::publishSimulationSnapshot() noexcept
+{
+    SimulationSnapshot &snapshot = mSnapshots.back();
+    snapshot.tick = ++mSimTick;
+    snapshot.score = mScore;
+    snapshot.playerVelocity = glm::vec2(0.0f);
+    if (b2Body_IsValid(mPlayerBodyId))
+    {
+        const b2Vec2 velocity = b2Body_GetLinearVelocity(mPlayerBodyId);
+        snapshot.playerVelocity = glm::vec2(velocity.x, velocity.y);
+    }
+
+    snapshot.streaming = mStreamStats;
+    snapshot.physics = PhysicsStats{};
+    if (mPhysicsScheduler)
+    {
+        snapshot.physics.workerCount = mPhysicsScheduler->getWorkerCount();
+        snapshot.physics.tasksPerStep = mPhysicsScheduler->getTasksLastStep();
+    }
+    if (b2World_IsValid(mWorldId))
+    {
+        const b2Profile profile = b2World_GetProfile(mWorldId);
+        snapshot.physics.stepMs = profile.step;
+        snapshot.physics.collideMs = profile.collide;
+        snapshot.physics.solveMs = profile.solve;
+    }
+
+    // Copy the pickup set only when it changed; unchanged snapshots share the previous copy
+    if (mSnapshotPickupsStale || !mPublishedPickups)
+    {
+        mPublishedPickups = std::make_shared<const std::vector<PickupSphere>>(mPickups.column<0>());
+        mSnapshotPickupsStale = false;
+    }
+    snapshot.pickups = mPublishedPickups;
+
+    mSnapshots.publish();
+}
+
+void World::markPickupsChanged() noexcept
+{
+    // With a simulation thread the render side learns about changes through the next snapshot
+    if (isSimulationThreaded())
+    {
+        mSnapshotPickupsStale = true;
+    }
+    else
+    {
+        mPickupsDirty = true;
+    }
+}
+
+bool World::forwardsToSimulation() const noexcept
+{
+    return isSimulationThreaded() && !sOnSimulationThread;
+}
+
+const std::vector<World::PickupSphere> &World::getPickupSpheres() const noexcept
+{
+    if (forwardsToSimulation() && mSnapshots.front().pickups)
+    {
+        return *mSnapshots.front().pickups;
+    }
+    return mPickups.column<0>();
+}
+
+int World::getScore() const noexcept
+{
+    return forwardsToSimulation() ? mSnapshots.front().score : mScore;
+}
+
+void World::addScore(int points) noexcept
+{
+    if (forwardsToSimulation())
+    {
+        postSimulationCommand([this, points]()
+                              { mScore += points; });
+        return;
+    }
+    mScore += points;
+}
+
+void World::draw() const noexcept
+{
+
+}
+
+// ============================================================================
+// Scene rendering implementation (moved from GameState)
+// ============================================================================
+
+void World::initRendering(VAOManager *vaos, FBOManager *fbos, VBOManager *vbos,
+                          ModelsManager *models, int windowWidth, int windowHeight,
+                          const Player &player) noexcept
+{
+    mVAOManager = vaos;
+    mFBOManager = fbos;
+    mVBOManager = vbos;
+    mModelsManager = models;
+
+    try
+    {
+        mMazeShader = &mShaders.get(Shaders::ID::GLSL_MAZE);
+        mSkyShader = &mShaders.get(Shaders::ID::GLSL_SKY);
+        mGoalPathStencilShader = &mShaders.get(Shaders::ID::GLSL_GOAL_PATH_STENCIL);
+        mBoundarySpriteShader = &mShaders.get(Shaders::ID::GLSL_BILLBOARD_SPRITE);
+        mShadowShader = &mShaders.get(Shaders::ID::GLSL_SHADOW_VOLUME);
+        mSkinnedCharacterShader = &mShaders.get(Shaders::ID::GLSL_SKINNED_MODEL);
+        mWalkParticlesComputeShader = &mShaders.get(Shaders::ID::GLSL_PARTICLES_COMPUTE);
+        mWalkParticlesRenderShader = &mShaders.get(Shaders::ID::GLSL_FULLSCREEN_QUAD_MVP);
+        mSkyCacheShader = &mShaders.get(Shaders::ID::GLSL_FULLSCREEN_QUAD);
+    }
+    catch (const std::exception &e)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "World::initRendering: Failed to get shaders: %s", e.what());
+        return;
+    }
+
+    // Optional: without it the skinned vertex shader blends bones itself
+    try
+    {
+        mSkinningComputeShader = &mShaders.get(Shaders::ID::GLSL_SKINNING_COMPUTE);
+    }
+    catch (const std::exception &)
+    {
+        mSkinningComputeShader = nullptr;
+    }
+
+    // Optional: without them every frustum-visible wall cluster is drawn
+    try
+    {
+        mHiZComputeShader = &mShaders.get(Shaders::ID::GLSL_HIZ_COMPUTE);
+        mOcclusionCullComputeShader = &mShaders.get(Shaders::ID::GLSL_OCCLUSION_CULL_COMPUTE);
+    }
+    catch (const std::exception &)
+    {
+        mHiZComputeShader = nullptr;
+        mOcclusionCullComputeShader = nullptr;
+    }
+
+    mMazeUniforms.playerXZ = mMazeShader->getUniformHandle("uPlayerXZ");
+    mMazeUniforms.mazeOriginXZ = mMazeShader->getUniformHandle("uMazeOriginXZ");
+    mMazeUniforms.cellSize = mMazeShader->getUniformHandle("uCellSize");
+    mMazeUniforms.highlightEnabled = mMazeShader->getUniformHandle("uHighlightEnabled");
+    mMazeUniforms.spriteSheet = mMazeShader->getUniformHandle("uSpriteSheet");
+    mMazeUniforms.hasTexture = mMazeShader->getUniformHandle("uHasTexture");
+    mMazeUniforms.instanced = mMazeShader->getUniformHandle("uInstanced");
+    mMazeUniforms.lightPass = mMazeShader->getUniformHandle("uLightPass");
+    mMazeUniforms.lightViewProjection = mMazeShader->getUniformHandle("uLightViewProjection");
+    mMazeUniforms.staticShadows = mMazeShader->getUniformHandle("uStaticShadows");
+    mMazeUniforms.reflections = mMazeShader->getUniformHandle("uReflections");
+    mMazeUniforms.reflectionViewProjection = mMazeShader->getUniformHandle("uReflectionViewProjection");
+
+    mGoalPathUniforms.color = mGoalPathStencilShader->getUniformHandle("uColor");
+    mGoalPathUniforms.intensity = mGoalPathStencilShader->getUniformHandle("uIntensity");
+
+    mShadowUniforms.lightDir = mShadowShader->getUniformHandle("uLightDir");
+    mShadowUniforms.groundY = mShadowShader->getUniformHandle("uGroundY");
+    mShadowUniforms.sphereCenter = mShadowShader->getUniformHandle("uSphereCenter");
+    mShadowUniforms.sphereRadius = mShadowShader->getUniformHandle("uSphereRadius");
+    mShadowUniforms.spritePos = mShadowShader->getUniformHandle("uSpritePos");
+    mShadowUniforms.spriteHalfSize = mShadowShader->getUniformHandle("uSpriteHalfSize");
+    mShadowUniforms.instanced = mShadowShader->getUniformHandle("uInstanced");
+    mShadowUniforms.shadowStrength = mShadowShader->getUniformHandle("uShadowStrength");
+
+    mSkinnedShadowPassUniform = mSkinnedCharacterShader->getUniformHandle("uShadowPass");
+
+    try
+    {
+        mBillboardColorTex = &mTextures.get(Textures::ID::BILLBOARD_COLOR);
+        mOITAccumTex = &mTextures.get(Textures::ID::OIT_ACCUM);
+        mOITRevealTex = &mTextures.get(Textures::ID::OIT_REVEAL);
+        mSceneDepthTex = &mTextures.get(Textures::ID::SCENE_DEPTH);
+        mOITDepthTex = &mTextures.get(Textures::ID::OIT_DEPTH);
+        mShadowTexture = &mTextures.get(Textures::ID::SHADOW_MAP);
+        mReflectionColorTex = &mTextures.get(Textures::ID::REFLECTION_COLOR);
+        mSkyCacheTex = &mTextures.get(Textures::ID::SKY_CACHE);
+    }
+    catch (const std::exception &e)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "World::initRendering: Failed to get textures: %s", e.what());
         return;
     }
 
-    auto &oitFBO = mFBOManager->get(FBOs::ID::OIT);
-    oitFBO.bindRenderbuffer();
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, windowWidth, windowHeight);
+    initializeShadowResources();
+    initializeWalkParticles();
+    initializeOcclusionCulling();
+    mRenderInitialized = true;
+}
+
+void World::drawScene(const Camera &camera, const Player &player,
+                      int windowWidth, int windowHeight,
+                      float modelAnimTime, float playerPlanarSpeed) const noexcept
+{
+    if (!mRenderInitialized)
+        return;
+
+    updateFrameUniforms(camera, windowWidth, windowHeight);
+    // Once per frame: the reflection and the main draw must agree on the pose time, or each evicts the other's pose
+    const float playerAnimTime = updatePlayerAnimationLod(player, modelAnimTime);
+    renderStaticShadowLayer(player);
+    renderPlayerReflection(player, playerAnimTime);
+
+    collectVisibleMazeRanges();
+    {
+        GPUProfiler::Scope timer{GPUProfiler::Pass::OCCLUSION};
+        renderOcclusionCulling(windowWidth, windowHeight);
+    }
+    {
+        GPUProfiler::Scope timer{GPUProfiler::Pass::MAZE};
+        renderRasterMaze(player, windowWidth, windowHeight);
+    }
+    {
+        GPUProfiler::Scope timer{GPUProfiler::Pass::GOAL_PATH};
+        renderGoalPathStencil();
+    }
+    {
+        GPUProfiler::Scope timer{GPUProfiler::Pass::PICKUPS};
+        renderPickupSpheres();
+    }
+    // Before the character so its own blob does not darken it
+    renderDynamicShadows(camera, player);
+    {
+        GPUProfiler::Scope timer{GPUProfiler::Pass::SKINNED_MODEL};
+        renderPlayerCharacterModel(player, playerAnimTime);
+        renderCharacterInstances();
+    }
+
+    // Sprites and particles come last, tested against the finished opaque depth. In the OIT layer
+    // they need no sorting and cost 1/downscale^2 of the blending; without it they blend into the scene
+    mTransparentLayerWritten = beginTransparentTarget(windowWidth, windowHeight);
+    if (mTransparentLayerWritten)
+    {
+        GLStateCache::enable(GL_BLEND);
+        GLStateCache::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        // Accumulate premultiplied color and weight; multiply revealage down by each coverage
+        glBlendFunci(0, GL_ONE, GL_ONE);
+        glBlendFunci(1, GL_ZERO, GL_ONE_MINUS_SRC_COLOR);
+        GLStateCache::depthMask(false);
+        GLSDLHelper::setBillboardOITPass(true);
+    }
+    {
+        GPUProfiler::Scope timer{GPUProfiler::Pass::BILLBOARDS};
+        renderBoundaryCharacterBillboards();
+    }
+    {
+        GPUProfiler::Scope timer{GPUProfiler::Pass::PARTICLES};
+        renderWalkParticles(player, playerPlanarSpeed, mTransparentLayerWritten);
+    }
+    if (mTransparentLayerWritten)
+    {
+        GLSDLHelper::setBillboardOITPass(false);
+        // Back to the factors the state cache recorded above
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        GLStateCache::depthMask(true);
+        endTransparentTarget(windowWidth, windowHeight);
+    }
+}
+
+void World::createCompositeTargets(int width, int height) noexcept
+{
+    if (width <= 0 || height <= 0)
+        return;
+
+    if (!mBillboardColorTex || !mOITAccumTex || !mOITRevealTex || !mSceneDepthTex || !mOITDepthTex)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "World: Composite textures not initialized in manager");
+        return;
+    }
+
+    mCompositeWidth = 0;
+    mCompositeHeight = 0;
+
+    if (!mBillboardColorTex->loadRenderTarget(width, height, Texture::RenderTargetFormat::RGBA16F, 0))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "World: Failed to allocate billboard texture");
+        return;
+    }
+
+    // A texture rather than a renderbuffer so the OIT resolve can read the opaque depth
+    if (!mSceneDepthTex->loadRenderTarget(width, height, Texture::RenderTargetFormat::DEPTH24_STENCIL8, 0))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "World: Failed to allocate scene depth texture");
+        return;
+    }
+
+    auto &billboardFBO = mFBOManager->get(FBOs::ID::BILLBOARD);
+    billboardFBO.bind();
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mBillboardColorTex->get(), 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, mSceneDepthTex->get(), 0);
+    glDrawBuffer(GL_COLOR_ATTACHMENT0);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+
+    const bool sceneTargetComplete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    if (!sceneTargetComplete)
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "World: Billboard framebuffer incomplete");
+
+    FramebufferObject::unbind();
+    glDrawBuffer(GL_BACK);
+    glReadBuffer(GL_BACK);
+
+    createOITTargets(width, height);
+
+    if (sceneTargetComplete)
+    {
+        mCompositeWidth = width;
+        mCompositeHeight = height;
+    }
+}
+
+void World::createOITTargets(int width, int height) noexcept
+{
+    mOITInitialized = false;
+    mOITWidth = (width + mOITDownscale - 1) / mOITDownscale;
+    mOITHeight = (height + mOITDownscale - 1) / mOITDownscale;
+
+    // Accumulation needs half floats: weighted sums of premultiplied colour run far past 1. Revealage
+    // is a product of (1 - alpha) terms in [0, 1], which 8-bit UNORM holds well
+    if (!mOITAccumTex->loadRenderTarget(mOITWidth, mOITHeight, Texture::RenderTargetFormat::RGBA16F, 0))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "World: Failed to allocate OIT accum texture");
+        return;
+    }
+
+    if (!mOITRevealTex->loadRenderTarget(mOITWidth, mOITHeight, Texture::RenderTargetFormat::R8, 0))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "World: Failed to allocate OIT reveal texture");
+        return;
+    }
+
+    // At full resolution the transparents test against the scene depth directly; below it, against a copy
+    GLuint depthTexture = mSceneDepthTex->get();
+    if (mOITDownscale > 1)
+    {
+        if (!mOITDepthTex->loadRenderTarget(mOITWidth, mOITHeight, Texture::RenderTargetFormat::DEPTH24_STENCIL8, 0))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "World: Failed to allocate OIT depth texture");
+            return;
+        }
+        depthTexture = mOITDepthTex->get();
+    }
+    else
+    {
+        // Unused at full resolution; keep a placeholder rather than a full-size copy
+        mOITDepthTex->loadRenderTarget(1, 1, Texture::RenderTargetFormat::DEPTH24_STENCIL8, 0);
+    }
 
+    auto &oitFBO = mFBOManager->get(FBOs::ID::OIT);
     oitFBO.bind();
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mOITAccumTex->get(), 0);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, mOITRevealTex->get(), 0);
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, oitFBO.getRenderbuffer());
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, depthTexture, 0);
     constexpr GLenum oitDrawBuffers[2] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1};
     glDrawBuffers(2, oitDrawBuffers);
 
-    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
-        mOITInitialized = false;
-    else
-        mOITInitialized = true;
+    mOITInitialized = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    if (!mOITInitialized)
+        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "World: OIT framebuffer incomplete");
 
     FramebufferObject::unbind();
     glDrawBuffer(GL_BACK);
     glReadBuffer(GL_BACK);
-    glBindTexture(GL_TEXTURE_2D, 0);
-    FramebufferObject::unbindRenderbuffer();
+    GLStateCache::bindTexture(GL_TEXTURE_2D, 0);
+}
+
+void World::configureOIT(int downscale) noexcept
+{
+    // Powers of two only, so OIT texels line up with whole blocks of scene pixels
+    const int clamped = downscale >= OIT_MAX_DOWNSCALE ? OIT_MAX_DOWNSCALE : (downscale >= 2 ? 2 : 1);
+    if (clamped == mOITDownscale)
+        return;
+
+    mOITDownscale = clamped;
+    if (mRenderInitialized && mCompositeWidth > 0 && mCompositeHeight > 0)
+    {
+        createOITTargets(mCompositeWidth, mCompositeHeight);
+        SDL_Log("World: OIT targets %d x %d (1/%d)", mOITWidth, mOITHeight, mOITDownscale);
+    }
+}
+
+bool World::beginTransparentTarget(int renderWidth, int renderHeight) const noexcept
+{
+    if (!mOITInitialized || !mSceneTargetActive || renderWidth <= 0 || renderHeight <= 0)
+        return false;
+
+    const int oitWidth = std::min((renderWidth + mOITDownscale - 1) / mOITDownscale, mOITWidth);
+    const int oitHeight = std::min((renderHeight + mOITDownscale - 1) / mOITDownscale, mOITHeight);
+    auto &oitFBO = mFBOManager->get(FBOs::ID::OIT);
+
+    if (mOITDownscale > 1)
+    {
+        // One scene sample per OIT texel; the resolve compares against exactly this depth
+        mFBOManager->get(FBOs::ID::BILLBOARD).bind(GL_READ_FRAMEBUFFER);
+        oitFBO.bind(GL_DRAW_FRAMEBUFFER);
+        glBlitFramebuffer(0, 0, renderWidth, renderHeight, 0, 0, oitWidth, oitHeight,
+                          GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+    }
+
+    oitFBO.bind();
+    constexpr GLenum oitDrawBuffers[2] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1};
+    glDrawBuffers(2, oitDrawBuffers);
+    glViewport(0, 0, oitWidth, oitHeight);
+
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(0, 0, oitWidth, oitHeight);
+    constexpr GLfloat kAccumClear[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    constexpr GLfloat kRevealClear[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    glClearBufferfv(GL_COLOR, 0, kAccumClear);
+    glClearBufferfv(GL_COLOR, 1, kRevealClear);
+    glDisable(GL_SCISSOR_TEST);
+    return true;
+}
+
+void World::endTransparentTarget(int renderWidth, int renderHeight) const noexcept
+{
+    mFBOManager->get(FBOs::ID::BILLBOARD).bind();
+    glDrawBuffer(GL_COLOR_ATTACHMENT0);
+    glViewport(0, 0, renderWidth, renderHeight);
+}
+
+World::OITTargets World::getOITTargets() const noexcept
+{
+    OITTargets targets;
+    if (!mOITInitialized || mCompositeWidth <= 0)
+        return targets;
+
+    targets.accum = mOITAccumTex->get();
+    targets.reveal = mOITRevealTex->get();
+    targets.sceneDepth = mSceneDepthTex->get();
+    targets.depth = mOITDownscale > 1 ? mOITDepthTex->get() : targets.sceneDepth;
+    targets.downscale = mOITDownscale;
+    return targets;
+}
+
+void World::ensureSceneTargets(int maxWidth, int maxHeight) noexcept
+{
+    if (!mRenderInitialized || maxWidth <= 0 || maxHeight <= 0)
+        return;
+
+    if (maxWidth <= mCompositeWidth && maxHeight <= mCompositeHeight)
+        return;
+
+    // Grow both axes together so alternating portrait/landscape resizes settle after one reallocation
+    createCompositeTargets(std::max(maxWidth, mCompositeWidth), std::max(maxHeight, mCompositeHeight));
+    SDL_Log("World: composite targets allocated at %d x %d", mCompositeWidth, mCompositeHeight);
+}
+
+bool World::beginSceneTarget(int renderWidth, int renderHeight) const noexcept
+{
+    mSceneTargetActive = false;
+    if (!mFBOManager || renderWidth <= 0 || renderHeight <= 0 ||
+        renderWidth > mCompositeWidth || renderHeight > mCompositeHeight)
+        return false;
+
+    mFBOManager->get(FBOs::ID::BILLBOARD).bind();
+    glDrawBuffer(GL_COLOR_ATTACHMENT0);
+    glViewport(0, 0, renderWidth, renderHeight);
+
+    // Clear only the part in use; the rest of the target is never sampled
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(0, 0, renderWidth, renderHeight);
+    GLStateCache::depthMask(true);
+    glStencilMask(0xFF);
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+    glDisable(GL_SCISSOR_TEST);
+
+    mSceneTargetActive = true;
+    return true;
+}
+
+void World::resolveSceneTarget(int renderWidth, int renderHeight, int windowWidth, int windowHeight) const noexcept
+{
+    if (!mSceneTargetActive)
+        return;
+
+    mFBOManager->get(FBOs::ID::BILLBOARD).bind(GL_READ_FRAMEBUFFER);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    FramebufferObject::unbind(GL_DRAW_FRAMEBUFFER);
+    glDrawBuffer(GL_BACK);
+    glBlitFramebuffer(0, 0, renderWidth, renderHeight, 0, 0, windowWidth, windowHeight,
+                      GL_COLOR_BUFFER_BIT, GL_LINEAR);
+
+    FramebufferObject::unbind();
+    glReadBuffer(GL_BACK);
+    glViewport(0, 0, windowWidth, windowHeight);
+    mSceneTargetActive = false;
 }
 
-void World::initializeShadowResources(int windowWidth, int windowHeight) noexcept
+void World::endSceneTarget(int windowWidth, int windowHeight) const noexcept
 {
-    if (windowWidth <= 0 || windowHeight <= 0)
+    if (!mSceneTargetActive)
         return;
 
-    if (!mShadowTexture)
+    FramebufferObject::unbind();
+    glDrawBuffer(GL_BACK);
+    glViewport(0, 0, windowWidth, windowHeight);
+    mSceneTargetActive = false;
+}
+
+GLuint World::getSceneColorTexture() const noexcept
+{
+    return (mBillboardColorTex && mCompositeWidth > 0) ? mBillboardColorTex->get() : 0;
+}
+
+void World::bindSceneFramebuffer() const noexcept
+{
+    if (mSceneTargetActive)
+    {
+        mFBOManager->get(FBOs::ID::BILLBOARD).bind();
+        glDrawBuffer(GL_COLOR_ATTACHMENT0);
+    }
+    else
+    {
+        FramebufferObject::unbind();
+        glDrawBuffer(GL_BACK);
+    }
+}
+
+void World::initializeShadowResources() noexcept
+{
+    mShadowsInitialized = false;
+    if (!mShadowTexture || !mFBOManager)
     {
         SDL_LogError(SDL_LOG_CATEGORY_RENDER, "World: Shadow texture not initialized in manager");
         return;
     }
 
-    if (!mShadowTexture->loadRenderTarget(windowWidth, windowHeight, Texture::RenderTargetFormat::RGBA16F, 0))
+    // Light-space, so the size is independent of the window and survives resizes
+    if (!mShadowTexture->loadRenderTarget(kStaticShadowMapSize, kStaticShadowMapSize, Texture::RenderTargetFormat::DEPTH24, 0))
     {
         SDL_LogError(SDL_LOG_CATEGORY_ERROR, "World: Failed to allocate shadow texture");
         return;
@@ -570,24 +1788,20 @@ void World::initializeShadowResources(int windowWidth, int windowHeight) noexcep
 
     auto &shadowFBO = mFBOManager->get(FBOs::ID::SHADOW);
     shadowFBO.bind();
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mShadowTexture->get(), 0);
-    glDrawBuffer(GL_COLOR_ATTACHMENT0);
-    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, mShadowTexture->get(), 0);
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
 
-    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    if (!complete)
         SDL_LogError(SDL_LOG_CATEGORY_ERROR, "World: Shadow framebuffer incomplete");
 
-    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-    glClear(GL_COLOR_BUFFER_BIT);
-
     if (mVAOManager && mVBOManager)
     {
         auto &shadowVBO = mVBOManager->get(VBOs::ID::SHADOW);
         mVAOManager->get(VAOs::ID::SHADOW_QUAD).bind();
-        shadowVBO.bind(GL_ARRAY_BUFFER);
-
         float point = 0.0f;
-        glBufferData(GL_ARRAY_BUFFER, sizeof(float), &point, GL_STATIC_DRAW);
+        shadowVBO.allocate(GL_ARRAY_BUFFER, sizeof(float), &point, GL_STATIC_DRAW);
 
         VertexBufferObject::unbind(GL_ARRAY_BUFFER);
         VertexArrayObject::unbind();
@@ -596,18 +1810,46 @@ void World::initializeShadowResources(int windowWidth, int windowHeight) noexcep
     FramebufferObject::unbind();
     glDrawBuffer(GL_BACK);
     glReadBuffer(GL_BACK);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, 0);
+
+    mShadowsInitialized = complete;
+    mStaticShadowValid = false;
+    mStaticShadowsDirty.store(true, std::memory_order_release);
+}
+
+void World::configureReflections(float scale, bool halfRate, int windowWidth, int windowHeight) noexcept
+{
+    mReflectionScale = std::clamp(scale, 0.0f, 1.0f);
+    mReflectionHalfRate = halfRate;
+    if (!mRenderInitialized || windowWidth <= 0 || windowHeight <= 0)
+        return;
+
+    if (mReflectionScale <= 0.0f)
+    {
+        mReflectionsInitialized = false;
+        mReflectionValid = false;
+        return;
+    }
 
-    mShadowsInitialized = true;
+    const int width = std::max(1, static_cast<int>(std::lround(static_cast<float>(windowWidth) * mReflectionScale)));
+    const int height = std::max(1, static_cast<int>(std::lround(static_cast<float>(windowHeight) * mReflectionScale)));
+    if (mReflectionsInitialized && width == mReflectionWidth && height == mReflectionHeight)
+        return;
+
+    initializeReflectionResources(width, height);
+    SDL_Log("World: reflection target %d x %d (%.2fx%s)", width, height, mReflectionScale,
+            mReflectionHalfRate ? ", half rate" : "");
 }
 
-void World::initializeReflectionResources(int windowWidth, int windowHeight) noexcept
+void World::initializeReflectionResources(int width, int height) noexcept
 {
-    if (windowWidth <= 0 || windowHeight <= 0)
+    mReflectionsInitialized = false;
+    mReflectionValid = false;
+    if (width <= 0 || height <= 0)
         return;
 
     FramebufferObject::unbind();
-    glBindTexture(GL_TEXTURE_2D, 0);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, 0);
     FramebufferObject::unbindRenderbuffer();
 
     if (!mReflectionColorTex)
@@ -616,15 +1858,14 @@ void World::initializeReflectionResources(int windowWidth, int windowHeight) noe
         return;
     }
 
-    if (!mReflectionColorTex->loadRenderTarget(windowWidth, windowHeight, Texture::RenderTargetFormat::RGBA16F, 0))
+    if (!mReflectionColorTex->loadRenderTarget(width, height, Texture::RenderTargetFormat::RGBA16F, 0))
     {
         SDL_LogError(SDL_LOG_CATEGORY_ERROR, "World: Failed to allocate reflection texture");
         return;
     }
 
     auto &reflectionFBO = mFBOManager->get(FBOs::ID::REFLECTION);
-    reflectionFBO.bindRenderbuffer();
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, windowWidth, windowHeight);
+    reflectionFBO.allocateRenderbuffer(GL_DEPTH_COMPONENT24, width, height);
 
     reflectionFBO.bind();
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mReflectionColorTex->get(), 0);
@@ -645,118 +1886,80 @@ void World::initializeReflectionResources(int windowWidth, int windowHeight) noe
     FramebufferObject::unbind();
     glDrawBuffer(GL_BACK);
     glReadBuffer(GL_BACK);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, 0);
     FramebufferObject::unbindRenderbuffer();
 
+    mReflectionWidth = width;
+    mReflectionHeight = height;
     mReflectionsInitialized = true;
 }
 
-void World::initializeWalkParticles(const Player &player) noexcept
+void World::initializeWalkParticles() noexcept
 {
-    if (mWalkParticlesInitialized)
+    if (mWalkParticles.isInitialized())
         return;
 
     if (!mWalkParticlesComputeShader || !mWalkParticlesRenderShader || mWalkParticleCount == 0)
         return;
 
-    std::vector<GLfloat> initPos;
-    std::vector<GLfloat> initVel;
-    initPos.reserve(static_cast<std::size_t>(mWalkParticleCount) * 4u);
-    initVel.reserve(static_cast<std::size_t>(mWalkParticleCount) * 4u);
-
-    const glm::vec3 playerPos = player.getPosition();
-    const glm::vec3 anchor = playerPos + glm::vec3(0.0f, 1.0f, 0.0f);
-
-    for (GLuint i = 0; i < mWalkParticleCount; ++i)
+    // Particles are emitted while the player walks; the pool starts empty
+    if (!mWalkParticles.init(*mWalkParticlesComputeShader, *mWalkParticlesRenderShader, mWalkParticleCount))
     {
-        const float t = static_cast<float>(i) * 0.0618f;
-        const float u = static_cast<float>(i % 37u) / 37.0f;
-        const float radius = 0.15f + 0.95f * u;
-        const float x = anchor.x + std::cos(t * 6.28318f) * radius;
-        const float z = anchor.z + std::sin(t * 6.28318f) * radius;
-        const float y = anchor.y + (static_cast<float>(i % 17u) / 17.0f) * 0.75f;
-
-        initPos.push_back(x);
-        initPos.push_back(y);
-        initPos.push_back(z);
-        initPos.push_back(1.0f);
-
-        initVel.push_back(0.0f);
-        initVel.push_back(0.0f);
-        initVel.push_back(0.0f);
-        initVel.push_back(0.0f);
+        SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "World: walk particles unavailable");
     }
+}
 
-    const GLsizeiptr bufferSize = static_cast<GLsizeiptr>(static_cast<std::size_t>(mWalkParticleCount) * 4u * sizeof(GLfloat));
-
-    auto &posSSBO = mVBOManager->get(VBOs::ID::WALK_PARTICLES_POS_SSBO);
-    posSSBO.bind(GL_SHADER_STORAGE_BUFFER);
-    glBufferData(GL_SHADER_STORAGE_BUFFER, bufferSize, initPos.data(), GL_DYNAMIC_DRAW);
-
-    auto &velSSBO = mVBOManager->get(VBOs::ID::WALK_PARTICLES_VEL_SSBO);
-    velSSBO.bind(GL_SHADER_STORAGE_BUFFER);
-    glBufferData(GL_SHADER_STORAGE_BUFFER, bufferSize, initVel.data(), GL_DYNAMIC_DRAW);
+void World::initializeOcclusionCulling() noexcept
+{
+    if (mOcclusionCuller.isInitialized() || !mHiZComputeShader || !mOcclusionCullComputeShader)
+        return;
 
-    if (mVAOManager)
+    if (!mOcclusionCuller.init(*mHiZComputeShader, *mOcclusionCullComputeShader))
     {
-        mVAOManager->get(VAOs::ID::WALK_PARTICLES).bind();
-        posSSBO.bind(GL_ARRAY_BUFFER);
-        glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
-        glEnableVertexAttribArray(0);
-        VertexArrayObject::unbind();
+        SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "World: occlusion culling unavailable");
     }
-
-    VertexBufferObject::unbind(GL_ARRAY_BUFFER);
-    VertexBufferObject::unbind(GL_SHADER_STORAGE_BUFFER);
-
-    mWalkParticlesInitialized = true;
 }
 
-void World::buildMazeGeometry(const Player & /*player*/) noexcept
+std::unique_ptr<World::PreparedMaze> World::prepareMazeGeometry(std::optional<std::uint32_t> seed) noexcept
 {
-    std::vector<RasterVertex> vertices;
-    vertices.reserve(50000);
-    std::vector<glm::vec3> goalPathLines;
-    goalPathLines.reserve(4000);
-    mMazeWallAABBs.clear();
-    mMazeCellGradientColors.assign(static_cast<std::size_t>(kSimpleMazeRows) * static_cast<std::size_t>(kSimpleMazeCols), glm::vec3(0.5f, 0.8f, 0.6f));
+    auto maze = std::make_unique<PreparedMaze>();
+    maze->seed = seed;
+    const std::size_t tileCount = static_cast<std::size_t>(kSimpleMazeRows) * kSimpleMazeCols * kSimpleMazeLevels;
 
-    auto pushTri = [&vertices](const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c, const glm::vec3 &color)
+    // Cells push into the bucket of their level/tile region; buckets are concatenated after the
+    // loop so every cluster owns one contiguous floor-index range and one wall-instance range
+    struct ClusterBuild
     {
-        vertices.push_back({a, color});
-        vertices.push_back({b, color});
-        vertices.push_back({c, color});
+        std::vector<MazeFloorVertex> floorQuads; // 4 corners per quad
+        std::vector<MazeWallInstance> walls;
     };
+    std::vector<ClusterBuild> clusterBuilds(static_cast<std::size_t>(kMazeClustersX) * kMazeClustersZ * kSimpleMazeLevels);
+    std::vector<MazeFloorVertex> groundQuad;
+    std::vector<MazeFloorVertex> *quadTarget = &groundQuad;
+    std::vector<MazeWallInstance> *wallTarget = nullptr;
+    std::vector<glm::vec3> &goalPathLines = maze->goalPathLines;
+    goalPathLines.reserve(4000);
+    maze->cellGradientColors.assign(static_cast<std::size_t>(kSimpleMazeRows) * static_cast<std::size_t>(kSimpleMazeCols), glm::vec3(0.5f, 0.8f, 0.6f));
 
-    auto pushQuad = [&pushTri](const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c, const glm::vec3 &d, const glm::vec3 &color)
+    // Flat-colored quads keep their own 4 corners (colors differ per tile) but share them across both triangles
+    auto pushQuad = [&quadTarget](const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c,
+                                  const glm::vec3 &d, const glm::vec3 &color)
     {
-        pushTri(a, b, c, color);
-        pushTri(a, c, d, color);
+        const auto packed = packUnorm8(color);
+        for (const glm::vec3 &p : {a, b, c, d})
+        {
+            quadTarget->push_back({{glm::packHalf1x16(p.x), glm::packHalf1x16(p.y), glm::packHalf1x16(p.z), 0u}, packed});
+        }
     };
 
-    auto pushBox = [&pushQuad](const glm::vec3 &center, const glm::vec3 &size, const glm::vec3 &color)
-    {
-        const glm::vec3 h = 0.5f * size;
-        const glm::vec3 p000 = center + glm::vec3(-h.x, -h.y, -h.z);
-        const glm::vec3 p001 = center + glm::vec3(-h.x, -h.y, h.z);
-        const glm::vec3 p010 = center + glm::vec3(-h.x, h.y, -h.z);
-        const glm::vec3 p011 = center + glm::vec3(-h.x, h.y, h.z);
-        const glm::vec3 p100 = center + glm::vec3(h.x, -h.y, -h.z);
-        const glm::vec3 p101 = center + glm::vec3(h.x, -h.y, h.z);
-        const glm::vec3 p110 = center + glm::vec3(h.x, h.y, -h.z);
-        const glm::vec3 p111 = center + glm::vec3(h.x, h.y, h.z);
-
-        pushQuad(p001, p101, p111, p011, color);
-        pushQuad(p100, p000, p010, p110, color);
-        pushQuad(p000, p001, p011, p010, color);
-        pushQuad(p101, p100, p110, p111, color);
-        pushQuad(p010, p011, p111, p110, color);
-        pushQuad(p000, p100, p101, p001, color);
+    auto pushBox = [&wallTarget](const glm::vec3 &center, const glm::vec3 &size, const glm::vec3 &color)
+    {
+        wallTarget->push_back({glm::vec4(center, 0.0f), size, packUnorm8(color)});
     };
 
     auto mazeGrid = std::make_unique<mazes::colored_grid>(kSimpleMazeRows, kSimpleMazeCols, 1u);
     mazes::randomizer rng{};
-    rng.seed(rng(0u, 4'200'000u));
+    rng.seed(seed.value_or(static_cast<std::uint32_t>(rng(0u, 4'200'000u))));
     mazes::dfs dfsAlgo{};
     dfsAlgo.run(mazeGrid.get(), rng);
     mazeGrid->initialize_distance_coloring(0, mazeGrid->operations().num_cells() - 1);
@@ -781,11 +1984,16 @@ void World::buildMazeGeometry(const Player & /*player*/) noexcept
                 if (!cellPtr)
                     continue;
 
+                ClusterBuild &cluster = clusterBuilds[(static_cast<std::size_t>(level) * kMazeClustersZ + row / kMazeClusterCells) * kMazeClustersX +
+                                                      col / kMazeClusterCells];
+                quadTarget = &cluster.floorQuads;
+                wallTarget = &cluster.walls;
+
                 const float cx = mazeOrigin.x + (static_cast<float>(col) + 0.5f) * kSimpleCellSize;
                 const float cz = mazeOrigin.z + (static_cast<float>(row) + 0.5f) * kSimpleCellSize;
 
                 glm::vec3 tileColor = packedRGBToLinear(mazeGrid->background_color_for(cellPtr));
-                mMazeCellGradientColors[static_cast<std::size_t>(idx)] = tileColor;
+                maze->cellGradientColors[static_cast<std::size_t>(idx)] = tileColor;
                 const float levelTint = 0.88f + 0.12f *
                                                     (kSimpleMazeLevels > 1u ? static_cast<float>(level) / static_cast<float>(kSimpleMazeLevels - 1u) : 0.0f);
                 tileColor *= levelTint;
@@ -857,7 +2065,7 @@ void World::buildMazeGeometry(const Player & /*player*/) noexcept
                     {
                         const float hw = kSimpleWallThickness * 0.5f;
                         const float hz = (kSimpleCellSize + kSimpleWallThickness) * 0.5f;
-                        mMazeWallAABBs.emplace_back(cx + 0.5f * kSimpleCellSize - hw, cz - hz,
+                        maze->wallAABBs.emplace_back(cx + 0.5f * kSimpleCellSize - hw, cz - hz,
                                                     cx + 0.5f * kSimpleCellSize + hw, cz + hz);
                     }
                 }
@@ -872,7 +2080,7 @@ void World::buildMazeGeometry(const Player & /*player*/) noexcept
                     {
                         const float hx = (kSimpleCellSize + kSimpleWallThickness) * 0.5f;
                         const float hw = kSimpleWallThickness * 0.5f;
-                        mMazeWallAABBs.emplace_back(cx - hx, cz + 0.5f * kSimpleCellSize - hw,
+                        maze->wallAABBs.emplace_back(cx - hx, cz + 0.5f * kSimpleCellSize - hw,
                                                     cx + hx, cz + 0.5f * kSimpleCellSize + hw);
                     }
                 }
@@ -886,7 +2094,7 @@ void World::buildMazeGeometry(const Player & /*player*/) noexcept
                     {
                         const float hw = kSimpleWallThickness * 0.5f;
                         const float hz = (kSimpleCellSize + kSimpleWallThickness) * 0.5f;
-                        mMazeWallAABBs.emplace_back(cx - 0.5f * kSimpleCellSize - hw, cz - hz,
+                        maze->wallAABBs.emplace_back(cx - 0.5f * kSimpleCellSize - hw, cz - hz,
                                                     cx - 0.5f * kSimpleCellSize + hw, cz + hz);
                     }
                 }
@@ -900,7 +2108,7 @@ void World::buildMazeGeometry(const Player & /*player*/) noexcept
                     {
                         const float hx = (kSimpleCellSize + kSimpleWallThickness) * 0.5f;
                         const float hw = kSimpleWallThickness * 0.5f;
-                        mMazeWallAABBs.emplace_back(cx - hx, cz - 0.5f * kSimpleCellSize - hw,
+                        maze->wallAABBs.emplace_back(cx - hx, cz - 0.5f * kSimpleCellSize - hw,
                                                     cx + hx, cz - 0.5f * kSimpleCellSize + hw);
                     }
                 }
@@ -908,12 +2116,15 @@ void World::buildMazeGeometry(const Player & /*player*/) noexcept
         }
     }
 
+    // One cell per maze cell keeps a player-sized query to a 2x2 block of cells
+    maze->wallBroadphase.build(maze->wallAABBs, kSimpleCellSize);
+
     // Floating boundary sprite anchors
     {
-        mBoundarySprites.clear();
-        mBoundarySprites.reserve(static_cast<std::size_t>(kBoundaryFloatingSpriteCount));
+        maze->boundarySprites.reserve(static_cast<std::size_t>(kBoundaryFloatingSpriteCount));
 
-        std::mt19937 spriteRng{std::random_device{}()};
+        // A pinned maze also pins its sprites, so benchmark and replay frames draw the same scene
+        std::mt19937 spriteRng{seed ? *seed : std::random_device{}()};
         std::uniform_real_distribution<float> xDist(mazeOrigin.x - 6.0f, mazeOrigin.x + mazeWidth + 6.0f);
         std::uniform_real_distribution<float> zDist(mazeOrigin.z - 10.0f, mazeOrigin.z + mazeDepth + 10.0f);
         std::uniform_real_distribution<float> yDist(mazeTopY + 5.0f, mazeTopY + 16.0f);
@@ -922,7 +2133,7 @@ void World::buildMazeGeometry(const Player & /*player*/) noexcept
 
         for (int i = 0; i < kBoundaryFloatingSpriteCount; ++i)
         {
-            mBoundarySprites.push_back(BoundarySpriteData{
+            maze->boundarySprites.push_back(BoundarySpriteData{
                 glm::vec3(xDist(spriteRng), yDist(spriteRng), zDist(spriteRng)),
                 phaseDist(spriteRng),
                 scaleDist(spriteRng)});
@@ -931,168 +2142,657 @@ void World::buildMazeGeometry(const Player & /*player*/) noexcept
 
     const glm::vec3 floorCol(0.18f, 0.13f, 0.28f);
     const float floorY = kSimpleFloorY;
+    quadTarget = &groundQuad;
     pushQuad(glm::vec3(-2400.0f, floorY, -2400.0f),
              glm::vec3(2400.0f, floorY, -2400.0f),
              glm::vec3(2400.0f, floorY, 2400.0f),
              glm::vec3(-2400.0f, floorY, 2400.0f),
              floorCol);
 
-    mVAOManager->get(VAOs::ID::RASTER_MAZE).bind();
-    mVBOManager->get(VBOs::ID::RASTER_MAZE).bind(GL_ARRAY_BUFFER);
-    glBufferData(GL_ARRAY_BUFFER,
-                 static_cast<GLsizeiptr>(vertices.size() * sizeof(RasterVertex)),
-                 vertices.data(),
-                 GL_STATIC_DRAW);
+    // Concatenate the buckets; the ground quad goes last and is never culled
+    std::vector<MazeFloorVertex> &floorVertices = maze->floorVertices;
+    floorVertices.reserve(tileCount * 4u + groundQuad.size());
+    std::vector<GLuint> &floorIndices = maze->floorIndices;
+    floorIndices.reserve(tileCount * 6u + 6u);
+    std::vector<MazeWallInstance> &wallInstances = maze->wallInstances;
+    wallInstances.reserve(tileCount * 2u + (kSimpleMazeRows + kSimpleMazeCols) * kSimpleMazeLevels);
+
+    auto appendQuads = [&floorVertices, &floorIndices](const std::vector<MazeFloorVertex> &quads)
+    {
+        for (std::size_t q = 0; q + 3 < quads.size(); q += 4)
+        {
+            const auto base = static_cast<GLuint>(floorVertices.size());
+            floorVertices.insert(floorVertices.end(), quads.begin() + static_cast<std::ptrdiff_t>(q),
+                                 quads.begin() + static_cast<std::ptrdiff_t>(q + 4));
+            for (const GLuint corner : {0u, 1u, 2u, 0u, 2u, 3u})
+            {
+                floorIndices.push_back(base + corner);
+            }
+        }
+    };
+
+    maze->clusters.reserve(clusterBuilds.size());
+    for (unsigned int level = 0u; level < kSimpleMazeLevels; ++level)
+    {
+        const float levelBaseY = kSimpleFloorY + static_cast<float>(level) * kSimpleLevelSpacing;
+        for (unsigned int cz = 0u; cz < kMazeClustersZ; ++cz)
+        {
+            for (unsigned int cx = 0u; cx < kMazeClustersX; ++cx)
+            {
+                const ClusterBuild &build = clusterBuilds[(static_cast<std::size_t>(level) * kMazeClustersZ + cz) * kMazeClustersX + cx];
+
+                MazeCluster cluster;
+                cluster.level = level;
+                cluster.firstFloorIndex = static_cast<GLuint>(floorIndices.size());
+                cluster.firstWallInstance = static_cast<GLuint>(wallInstances.size());
+                appendQuads(build.floorQuads);
+                wallInstances.insert(wallInstances.end(), build.walls.begin(), build.walls.end());
+                cluster.floorIndexCount = static_cast<GLsizei>(floorIndices.size() - cluster.firstFloorIndex);
+                cluster.wallInstanceCount = static_cast<GLsizei>(wallInstances.size() - cluster.firstWallInstance);
+
+                // Region bounds padded by the wall thickness so border walls stay inside
+                const unsigned int colEnd = std::min(kSimpleMazeCols, (cx + 1u) * kMazeClusterCells);
+                const unsigned int rowEnd = std::min(kSimpleMazeRows, (cz + 1u) * kMazeClusterCells);
+                cluster.aabbMin = glm::vec3(mazeOrigin.x + static_cast<float>(cx * kMazeClusterCells) * kSimpleCellSize - kSimpleWallThickness,
+                                            levelBaseY,
+                                            mazeOrigin.z + static_cast<float>(cz * kMazeClusterCells) * kSimpleCellSize - kSimpleWallThickness);
+                cluster.aabbMax = glm::vec3(mazeOrigin.x + static_cast<float>(colEnd) * kSimpleCellSize + kSimpleWallThickness,
+                                            levelBaseY + kSimpleWallHeight,
+                                            mazeOrigin.z + static_cast<float>(rowEnd) * kSimpleCellSize + kSimpleWallThickness);
+                maze->clusters.push_back(cluster);
+            }
+        }
+    }
+    maze->groundFirstIndex = static_cast<GLuint>(floorIndices.size());
+    appendQuads(groundQuad);
+    maze->groundIndexCount = static_cast<GLsizei>(floorIndices.size() - maze->groundFirstIndex);
+
+    // 16-bit indices whenever the vertex count allows
+    if (floorVertices.size() <= 0xFFFFu)
+    {
+        maze->shortIndices.assign(floorIndices.begin(), floorIndices.end());
+    }
+
+    maze->center = mazeCenter;
+    maze->width = mazeWidth;
+    maze->depth = mazeDepth;
+    maze->topY = mazeTopY;
+    return maze;
+}
+
+void World::buildMazeGeometry(const Player & /*player*/) noexcept
+{
+    // Generation and vertex building are CPU only; use the copy a prewarm already made if there is one
+    std::unique_ptr<PreparedMaze> maze;
+    if (sPrewarmedMaze.valid())
+    {
+        // Without worker threads nothing else will ever run the prewarm
+        if (auto &jobs = *JobSystem::instance(); jobs.isCooperative())
+        {
+            while (sPrewarmedMaze.wait_for(std::chrono::seconds(0)) != std::future_status::ready && jobs.runPendingJob())
+            {
+            }
+        }
+        maze = sPrewarmedMaze.get();
+        // The seed can change after the prewarm, e.g. when rollback netcode is switched on in the menu
+        if (maze && maze->seed != sRasterMazeSeed)
+        {
+            SDL_Log("World: prewarmed raster maze was for another seed, generating again");
+            maze.reset();
+        }
+    }
+    if (!maze)
+    {
+        maze = prepareMazeGeometry(sRasterMazeSeed);
+    }
+
+    mMazeWallAABBs = std::move(maze->wallAABBs);
+    mMazeCellGradientColors = std::move(maze->cellGradientColors);
+    mMazeWallBroadphase = std::move(maze->wallBroadphase);
+    mBoundarySprites = std::move(maze->boundarySprites);
+    mMazeClusters = std::move(maze->clusters);
+    mMazeGroundFirstIndex = maze->groundFirstIndex;
+    mMazeGroundIndexCount = maze->groundIndexCount;
+
+    const std::vector<MazeFloorVertex> &floorVertices = maze->floorVertices;
+    const std::vector<GLuint> &floorIndices = maze->floorIndices;
+    const std::vector<MazeWallInstance> &wallInstances = maze->wallInstances;
+    const std::vector<glm::vec3> &goalPathLines = maze->goalPathLines;
+
+    // Floor: indexed quantized quads
+    mVAOManager->get(VAOs::ID::RASTER_MAZE).bind();
+    mVBOManager->get(VBOs::ID::RASTER_MAZE).allocate(GL_ARRAY_BUFFER,
+                                                     static_cast<GLsizeiptr>(floorVertices.size() * sizeof(MazeFloorVertex)),
+                                                     floorVertices.data(),
+                                                     GL_STATIC_DRAW);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, GL_HALF_FLOAT, GL_FALSE, sizeof(MazeFloorVertex), reinterpret_cast<void *>(offsetof(MazeFloorVertex, position)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(MazeFloorVertex), reinterpret_cast<void *>(offsetof(MazeFloorVertex, color)));
+
+    auto &floorIndexBuffer = mVBOManager->get(VBOs::ID::MAZE_FLOOR_INDICES);
+    if (!maze->shortIndices.empty())
+    {
+        floorIndexBuffer.allocate(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(maze->shortIndices.size() * sizeof(GLushort)),
+                                  maze->shortIndices.data(), GL_STATIC_DRAW);
+        mMazeFloorIndexType = GL_UNSIGNED_SHORT;
+    }
+    else
+    {
+        floorIndexBuffer.allocate(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(floorIndices.size() * sizeof(GLuint)),
+                                  floorIndices.data(), GL_STATIC_DRAW);
+        mMazeFloorIndexType = GL_UNSIGNED_INT;
+    }
+    VertexArrayObject::unbind();
+    mMazeFloorIndexCount = static_cast<GLsizei>(floorIndices.size());
+
+    // Walls: one indexed unit cube, scaled and placed per instance
+    {
+        static const std::array<glm::vec3, 8> kCubeCorners{{
+            {-0.5f, -0.5f, -0.5f}, {-0.5f, -0.5f, 0.5f}, {-0.5f, 0.5f, -0.5f}, {-0.5f, 0.5f, 0.5f},
+            {0.5f, -0.5f, -0.5f}, {0.5f, -0.5f, 0.5f}, {0.5f, 0.5f, -0.5f}, {0.5f, 0.5f, 0.5f}}};
+        // Same face winding as the old per-box quads (corner index = x*4 + y*2 + z)
+        static constexpr std::array<GLubyte, 36> kCubeIndices{{
+            1, 5, 7, 1, 7, 3,
+            4, 0, 2, 4, 2, 6,
+            0, 1, 3, 0, 3, 2,
+            5, 4, 6, 5, 6, 7,
+            2, 3, 7, 2, 7, 6,
+            0, 4, 5, 0, 5, 1}};
+
+        std::array<RasterVertex, 8> cubeVertices{};
+        for (std::size_t i = 0; i < kCubeCorners.size(); ++i)
+        {
+            cubeVertices[i] = {kCubeCorners[i], glm::vec3(1.0f)};
+        }
+
+        mVAOManager->get(VAOs::ID::MAZE_WALLS).bind();
+        mVBOManager->get(VBOs::ID::MAZE_WALL_CUBE).allocate(GL_ARRAY_BUFFER, sizeof(cubeVertices), cubeVertices.data(), GL_STATIC_DRAW);
+        mVBOManager->get(VBOs::ID::MAZE_WALL_CUBE_INDICES).allocate(GL_ELEMENT_ARRAY_BUFFER, sizeof(kCubeIndices), kCubeIndices.data(), GL_STATIC_DRAW);
+
+        // Cube corners on attributes 0/1 and wall instances on 2-4, for the bound VAO
+        auto setupWallAttributes = [this](VBOs::ID instanceBuffer)
+        {
+            mVBOManager->get(VBOs::ID::MAZE_WALL_CUBE).bind(GL_ARRAY_BUFFER);
+            glEnableVertexAttribArray(0);
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(RasterVertex), reinterpret_cast<void *>(offsetof(RasterVertex, position)));
+            glEnableVertexAttribArray(1);
+            glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(RasterVertex), reinterpret_cast<void *>(offsetof(RasterVertex, color)));
+            mVBOManager->get(VBOs::ID::MAZE_WALL_CUBE_INDICES).bind(GL_ELEMENT_ARRAY_BUFFER);
+
+            mVBOManager->get(instanceBuffer).bind(GL_ARRAY_BUFFER);
+            glEnableVertexAttribArray(2);
+            glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(MazeWallInstance), reinterpret_cast<void *>(offsetof(MazeWallInstance, centerHidden)));
+            glVertexAttribDivisor(2, 1);
+            glEnableVertexAttribArray(3);
+            glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(MazeWallInstance), reinterpret_cast<void *>(offsetof(MazeWallInstance, color)));
+            glVertexAttribDivisor(3, 1);
+            glEnableVertexAttribArray(4);
+            glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(MazeWallInstance), reinterpret_cast<void *>(offsetof(MazeWallInstance, size)));
+            glVertexAttribDivisor(4, 1);
+        };
+
+        mVBOManager->get(VBOs::ID::MAZE_WALL_INSTANCES).allocate(GL_ARRAY_BUFFER,
+                                                                 static_cast<GLsizeiptr>(wallInstances.size() * sizeof(MazeWallInstance)),
+                                                                 wallInstances.data(),
+                                                                 GL_STATIC_DRAW);
+        setupWallAttributes(VBOs::ID::MAZE_WALL_INSTANCES);
+        VertexArrayObject::unbind();
 
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(RasterVertex), reinterpret_cast<void *>(offsetof(RasterVertex, position)));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(RasterVertex), reinterpret_cast<void *>(offsetof(RasterVertex, color)));
-    VertexArrayObject::unbind();
+        mMazeWallCubeIndexCount = static_cast<GLsizei>(kCubeIndices.size());
+        mMazeWallInstanceCount = static_cast<GLsizei>(wallInstances.size());
+
+        if (mOcclusionCuller.isInitialized())
+        {
+            std::vector<OcclusionCuller::Cluster> cullClusters;
+            cullClusters.reserve(mMazeClusters.size());
+            for (const MazeCluster &cluster : mMazeClusters)
+            {
+                cullClusters.push_back({glm::vec4(cluster.aabbMin, static_cast<float>(cluster.level)),
+                                        glm::vec4(cluster.aabbMax, 0.0f),
+                                        glm::uvec4(cluster.firstWallInstance, static_cast<GLuint>(cluster.wallInstanceCount), 0u, 0u)});
+            }
+            mOcclusionCuller.setClusters(cullClusters, mMazeWallCubeIndexCount);
+        }
 
-    mRasterMazeVertexCount = static_cast<GLsizei>(vertices.size());
+        // Streamed chunks: same cube, instances from the fixed-slot pool
+        mChunkGeometryPool.init(mVBOManager->get(VBOs::ID::MAZE_CHUNK_WALL_INSTANCES).get(),
+                                mVBOManager->get(VBOs::ID::MAZE_CHUNK_INDIRECT).get(),
+                                CHUNK_GEOMETRY_SLOTS, CHUNK_WALL_INSTANCE_CAPACITY, sizeof(MazeWallInstance));
+        mChunkGeometrySlots.clear();
+        mVAOManager->get(VAOs::ID::MAZE_CHUNK_WALLS).bind();
+        setupWallAttributes(VBOs::ID::MAZE_CHUNK_WALL_INSTANCES);
+        VertexArrayObject::unbind();
+    }
 
     mVAOManager->get(VAOs::ID::GOAL_PATH).bind();
-    mVBOManager->get(VBOs::ID::GOAL_PATH).bind(GL_ARRAY_BUFFER);
-    glBufferData(GL_ARRAY_BUFFER,
-                 static_cast<GLsizeiptr>(goalPathLines.size() * sizeof(glm::vec3)),
-                 goalPathLines.data(),
-                 GL_STATIC_DRAW);
+    mVBOManager->get(VBOs::ID::GOAL_PATH).allocate(GL_ARRAY_BUFFER,
+                                                   static_cast<GLsizeiptr>(goalPathLines.size() * sizeof(glm::vec3)),
+                                                   goalPathLines.data(),
+                                                   GL_STATIC_DRAW);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), reinterpret_cast<void *>(0));
     VertexArrayObject::unbind();
     VertexBufferObject::unbind(GL_ARRAY_BUFFER);
     mGoalPathVertexCount = static_cast<GLsizei>(goalPathLines.size());
 
-    mRasterMazeCenter = mazeCenter;
-    mRasterMazeWidth = mazeWidth;
-    mRasterMazeDepth = mazeDepth;
-    mRasterMazeTopY = mazeTopY;
+    mRasterMazeCenter = maze->center;
+    mRasterMazeWidth = maze->width;
+    mRasterMazeDepth = maze->depth;
+    mRasterMazeTopY = maze->topY;
+    mStaticShadowsDirty.store(true, std::memory_order_release);
 
     SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION,
-                "World: Raster maze built - rows=%u cols=%u levels=%u vertices=%d",
-                kSimpleMazeRows, kSimpleMazeCols, kSimpleMazeLevels, mRasterMazeVertexCount);
+                "World: Raster maze built - rows=%u cols=%u levels=%u floor vertices=%zu indices=%d wall instances=%d (%zu KB)",
+                kSimpleMazeRows, kSimpleMazeCols, kSimpleMazeLevels, floorVertices.size(), mMazeFloorIndexCount,
+                mMazeWallInstanceCount,
+                (floorVertices.size() * sizeof(MazeFloorVertex) + floorIndices.size() * sizeof(GLuint) +
+                 wallInstances.size() * sizeof(MazeWallInstance)) / 1024u);
 }
 
-void World::renderRasterMaze(const Camera &camera, const Player &player,
-                             int windowWidth, int windowHeight) const noexcept
+void World::updateFrameUniforms(const Camera &camera, int windowWidth, int windowHeight) const noexcept
 {
-    FramebufferObject::unbind();
-    glViewport(0, 0, windowWidth, windowHeight);
+    const float aspectRatio = static_cast<float>(std::max(1, windowWidth)) / static_cast<float>(std::max(1, windowHeight));
+    mFrameUniforms = GLSDLHelper::makeFrameUniforms(camera.getLookAt(), camera.getPerspective(aspectRatio),
+                                                    camera.getPosition(), static_cast<float>(SDL_GetTicks()) * 0.001f,
+                                                    windowWidth, windowHeight);
+    // Cached by the camera, so the planes are only re-extracted after its pose or projection changes
+    mFrameFrustum = camera.getFrustum(aspectRatio);
+    GLSDLHelper::updateFrameUniforms(mFrameUniforms);
+}
+
+bool World::refreshSkyCache(int windowWidth, int windowHeight) const noexcept
+{
+    if (!mSkyCacheTex || !mSkyCacheShader || !mFBOManager)
+        return false;
+
+    const int width = std::max(1, (windowWidth + kSkyCacheDivisor - 1) / kSkyCacheDivisor);
+    const int height = std::max(1, (windowHeight + kSkyCacheDivisor - 1) / kSkyCacheDivisor);
+    if (!mSkyCacheDirty && width == mSkyCacheWidth && height == mSkyCacheHeight)
+        return true;
+
+    auto &skyFBO = mFBOManager->get(FBOs::ID::SKY);
+    if (width != mSkyCacheWidth || height != mSkyCacheHeight)
+    {
+        mSkyCacheWidth = 0;
+        mSkyCacheHeight = 0;
+        // Half floats like the scene target, so the sun keeps its over-1 highlight for the tonemapper
+        if (!mSkyCacheTex->loadRenderTarget(width, height, Texture::RenderTargetFormat::RGBA16F, 0))
+            return false;
+
+        skyFBO.bind();
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mSkyCacheTex->get(), 0);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "World: Sky cache framebuffer incomplete");
+            FramebufferObject::unbind();
+            return false;
+        }
+    }
+    else
+    {
+        skyFBO.bind();
+    }
 
-    glDisable(GL_DEPTH_TEST);
-    glDepthMask(GL_FALSE);
+    // sky.frag.glsl works in NDC, so the cache covers the screen exactly and needs no camera
+    glDrawBuffer(GL_COLOR_ATTACHMENT0);
+    glViewport(0, 0, width, height);
+    GLStateCache::disable(GL_DEPTH_TEST);
+    GLStateCache::depthMask(false);
     mSkyShader->bind();
     mVAOManager->get(VAOs::ID::FULLSCREEN_QUAD).bind();
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    RenderStats::drawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+    mSkyCacheWidth = width;
+    mSkyCacheHeight = height;
+    mSkyCacheDirty = false;
+    return true;
+}
+
+void World::renderSky(int windowWidth, int windowHeight) const noexcept
+{
+    const bool cached = refreshSkyCache(windowWidth, windowHeight);
+
+    bindSceneFramebuffer();
+    glViewport(0, 0, windowWidth, windowHeight);
+
+    GLStateCache::disable(GL_DEPTH_TEST);
+    GLStateCache::depthMask(false);
+    if (cached)
+    {
+        // One bilinear fetch per pixel instead of evaluating the sky shader at full resolution
+        mSkyCacheShader->bind();
+        GLStateCache::activeTexture(GL_TEXTURE0);
+        GLStateCache::bindTexture(GL_TEXTURE_2D, mSkyCacheTex->get());
+    }
+    else
+    {
+        mSkyShader->bind();
+    }
+    mVAOManager->get(VAOs::ID::FULLSCREEN_QUAD).bind();
+    RenderStats::drawArrays(GL_TRIANGLE_STRIP, 0, 4);
+}
 
-    glEnable(GL_DEPTH_TEST);
-    glDepthMask(GL_TRUE);
-    glDepthFunc(GL_LESS);
+void World::renderRasterMaze(const Player &player,
+                             int windowWidth, int windowHeight) const noexcept
+{
+    renderSky(windowWidth, windowHeight);
+
+    GLStateCache::enable(GL_DEPTH_TEST);
+    GLStateCache::depthMask(true);
+    GLStateCache::depthFunc(GL_LESS);
 
-    const float aspectRatio = static_cast<float>(std::max(1, windowWidth)) / static_cast<float>(std::max(1, windowHeight));
-    const glm::mat4 mvp = camera.getPerspective(aspectRatio) * camera.getLookAt();
     mMazeShader->bind();
-    mMazeShader->setUniform("uMVP", mvp);
-    mMazeShader->setUniform("uTime", static_cast<float>(SDL_GetTicks()) * 0.001f);
+    mMazeShader->setUniform(mMazeUniforms.instanced, 0);
 
     const float mazeOriginX = mRasterMazeCenter.x - 0.5f * mRasterMazeWidth;
     const float mazeOriginZ = mRasterMazeCenter.z - 0.5f * mRasterMazeDepth;
-    const glm::vec3 playerPos = player.getPosition();
+    const glm::vec3 playerPos = player.getRenderPosition();
     const int highlightCol = static_cast<int>(std::floor((playerPos.x - mazeOriginX) / kSimpleCellSize));
     const int highlightRow = static_cast<int>(std::floor((playerPos.z - mazeOriginZ) / kSimpleCellSize));
-    mMazeShader->setUniform("uPlayerXZ", glm::vec2(playerPos.x, playerPos.z));
-    mMazeShader->setUniform("uMazeOriginXZ", glm::vec2(mazeOriginX, mazeOriginZ));
-    mMazeShader->setUniform("uCellSize", kSimpleCellSize);
+    mMazeShader->setUniform(mMazeUniforms.playerXZ, glm::vec2(playerPos.x, playerPos.z));
+    mMazeShader->setUniform(mMazeUniforms.mazeOriginXZ, glm::vec2(mazeOriginX, mazeOriginZ));
+    mMazeShader->setUniform(mMazeUniforms.cellSize, kSimpleCellSize);
     if (highlightRow >= 0 && highlightRow < static_cast<int>(kSimpleMazeRows) &&
         highlightCol >= 0 && highlightCol < static_cast<int>(kSimpleMazeCols))
     {
-        mMazeShader->setUniform("uHighlightEnabled", 1);
+        mMazeShader->setUniform(mMazeUniforms.highlightEnabled, 1);
     }
     else
     {
-        mMazeShader->setUniform("uHighlightEnabled", 0);
+        mMazeShader->setUniform(mMazeUniforms.highlightEnabled, 0);
     }
 
     const Texture *spriteSheet = getCharacterSpriteSheet();
     if (spriteSheet && spriteSheet->get() != 0)
     {
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, spriteSheet->get());
-        mMazeShader->setUniform("uSpriteSheet", 0);
-        mMazeShader->setUniform("uHasTexture", 1);
+        GLStateCache::activeTexture(GL_TEXTURE0);
+        GLStateCache::bindTexture(GL_TEXTURE_2D, spriteSheet->get());
+        mMazeShader->setUniform(mMazeUniforms.spriteSheet, 0);
+        mMazeShader->setUniform(mMazeUniforms.hasTexture, 1);
     }
     else
     {
-        mMazeShader->setUniform("uHasTexture", 0);
+        mMazeShader->setUniform(mMazeUniforms.hasTexture, 0);
+    }
+
+    if (mStaticShadowValid)
+    {
+        GLStateCache::activeTexture(GL_TEXTURE1);
+        GLStateCache::bindTexture(GL_TEXTURE_2D, mShadowTexture->get());
+        GLStateCache::activeTexture(GL_TEXTURE0);
+        mMazeShader->setUniform(mMazeUniforms.lightViewProjection, mStaticShadowViewProjection);
     }
+    mMazeShader->setUniform(mMazeUniforms.staticShadows, mStaticShadowValid ? 1 : 0);
+
+    if (mReflectionValid)
+    {
+        GLStateCache::activeTexture(GL_TEXTURE2);
+        GLStateCache::bindTexture(GL_TEXTURE_2D, mReflectionColorTex->get());
+        GLStateCache::activeTexture(GL_TEXTURE0);
+        mMazeShader->setUniform(mMazeUniforms.reflectionViewProjection, mReflectionViewProjection);
+    }
+    mMazeShader->setUniform(mMazeUniforms.reflections, mReflectionValid ? 1 : 0);
 
     mVAOManager->get(VAOs::ID::RASTER_MAZE).bind();
-    glDrawArrays(GL_TRIANGLES, 0, mRasterMazeVertexCount);
+    if (!mVisibleFloorCounts.empty())
+    {
+        RenderStats::multiDrawElements(GL_TRIANGLES, mVisibleFloorCounts.data(), mMazeFloorIndexType,
+                                       mVisibleFloorOffsets.data(), static_cast<GLsizei>(mVisibleFloorCounts.size()));
+    }
+
+    if (mOcclusionCullingActive)
+    {
+        mMazeShader->setUniform(mMazeUniforms.instanced, 2);
+        mVAOManager->get(VAOs::ID::MAZE_WALLS).bind();
+        mOcclusionCuller.drawVisible(GL_UNSIGNED_BYTE);
+        mMazeShader->setUniform(mMazeUniforms.instanced, 0);
+    }
+    else if (!mVisibleWallRuns.empty())
+    {
+        mMazeShader->setUniform(mMazeUniforms.instanced, 2);
+        mVAOManager->get(VAOs::ID::MAZE_WALLS).bind();
+        for (const glm::uvec2 &run : mVisibleWallRuns)
+        {
+            RenderStats::drawElementsInstancedBaseInstance(GL_TRIANGLES, mMazeWallCubeIndexCount, GL_UNSIGNED_BYTE, nullptr,
+                                                           static_cast<GLsizei>(run.y), run.x);
+        }
+        mMazeShader->setUniform(mMazeUniforms.instanced, 0);
+    }
+
+    applyChunkGeometryUpdates();
+    if (mChunkGeometryPool.getResidentCount() > 0)
+    {
+        mMazeShader->setUniform(mMazeUniforms.instanced, 2);
+        mVAOManager->get(VAOs::ID::MAZE_CHUNK_WALLS).bind();
+        mChunkGeometryPool.draw(mMazeWallCubeIndexCount, GL_UNSIGNED_BYTE);
+        mMazeShader->setUniform(mMazeUniforms.instanced, 0);
+    }
+}
+
+void World::collectVisibleMazeRanges() const noexcept
+{
+    cullMazeClusters();
+
+    // Visible clusters are sequential in the buffers, so adjacent ones merge into one range
+    const std::size_t indexSize = (mMazeFloorIndexType == GL_UNSIGNED_INT) ? sizeof(GLuint) : sizeof(GLushort);
+    mVisibleFloorCounts.clear();
+    mVisibleFloorOffsets.clear();
+    mVisibleWallRuns.clear();
+    GLuint floorRunEnd = std::numeric_limits<GLuint>::max();
+    GLuint wallRunEnd = std::numeric_limits<GLuint>::max();
+    for (const std::uint32_t clusterIndex : mVisibleMazeClusters)
+    {
+        const MazeCluster &cluster = mMazeClusters[clusterIndex];
+        if (cluster.floorIndexCount > 0)
+        {
+            if (cluster.firstFloorIndex == floorRunEnd)
+            {
+                mVisibleFloorCounts.back() += cluster.floorIndexCount;
+            }
+            else
+            {
+                mVisibleFloorCounts.push_back(cluster.floorIndexCount);
+                mVisibleFloorOffsets.push_back(reinterpret_cast<const void *>(cluster.firstFloorIndex * indexSize));
+            }
+            floorRunEnd = cluster.firstFloorIndex + static_cast<GLuint>(cluster.floorIndexCount);
+        }
+        if (cluster.wallInstanceCount > 0)
+        {
+            if (cluster.firstWallInstance == wallRunEnd)
+            {
+                mVisibleWallRuns.back().y += static_cast<GLuint>(cluster.wallInstanceCount);
+            }
+            else
+            {
+                mVisibleWallRuns.emplace_back(cluster.firstWallInstance, static_cast<GLuint>(cluster.wallInstanceCount));
+            }
+            wallRunEnd = cluster.firstWallInstance + static_cast<GLuint>(cluster.wallInstanceCount);
+        }
+    }
+    if (mMazeGroundIndexCount > 0)
+    {
+        mVisibleFloorCounts.push_back(mMazeGroundIndexCount);
+        mVisibleFloorOffsets.push_back(reinterpret_cast<const void *>(mMazeGroundFirstIndex * indexSize));
+    }
+}
+
+void World::renderOcclusionCulling(int windowWidth, int windowHeight) const noexcept
+{
+    mOcclusionCullingActive = false;
+    if (!mOcclusionCuller.isInitialized() || mOcclusionCuller.getClusterCount() == 0)
+        return;
+
+    // Occluders: the visible floors and last frame's visible walls, depth only through the light-pass path
+    mOcclusionCuller.beginDepthPass(windowWidth, windowHeight);
+    GLStateCache::enable(GL_DEPTH_TEST);
+    GLStateCache::depthFunc(GL_LESS);
+
+    mMazeShader->bind();
+    mMazeShader->setUniform(mMazeUniforms.lightPass, 1);
+    mMazeShader->setUniform(mMazeUniforms.lightViewProjection, mFrameUniforms.viewProjection);
+    mMazeShader->setUniform(mMazeUniforms.instanced, 0);
+    if (!mVisibleFloorCounts.empty())
+    {
+        mVAOManager->get(VAOs::ID::RASTER_MAZE).bind();
+        RenderStats::multiDrawElements(GL_TRIANGLES, mVisibleFloorCounts.data(), mMazeFloorIndexType,
+                                       mVisibleFloorOffsets.data(), static_cast<GLsizei>(mVisibleFloorCounts.size()));
+    }
+    mMazeShader->setUniform(mMazeUniforms.instanced, 2);
+    mVAOManager->get(VAOs::ID::MAZE_WALLS).bind();
+    mOcclusionCuller.drawOccluders(GL_UNSIGNED_BYTE);
+    mMazeShader->setUniform(mMazeUniforms.instanced, 0);
+    mMazeShader->setUniform(mMazeUniforms.lightPass, 0);
+    VertexArrayObject::unbind();
+
+    mOcclusionCuller.buildPyramid();
+    mOcclusionCuller.cull(mLowestVisibleMazeLevel);
+    mOcclusionCullingActive = true;
+
+    bindSceneFramebuffer();
+    glViewport(0, 0, windowWidth, windowHeight);
+}
+
+void World::cullMazeClusters() const noexcept
+{
+    mVisibleMazeClusters.clear();
+    if (mMazeClusters.empty())
+    {
+        return;
+    }
+
+    // Every level has a floor tile on every cell, so from above the maze footprint the floor of
+    // the highest level under the camera hides all levels below it
+    unsigned int &lowestVisibleLevel = mLowestVisibleMazeLevel;
+    lowestVisibleLevel = 0u;
+    const glm::vec3 &eye = mFrameUniforms.cameraPosition;
+    const float footprintHalfWidth = 0.5f * mRasterMazeWidth - kSimpleCellSize;
+    const float footprintHalfDepth = 0.5f * mRasterMazeDepth - kSimpleCellSize;
+    if (std::abs(eye.x - mRasterMazeCenter.x) < footprintHalfWidth &&
+        std::abs(eye.z - mRasterMazeCenter.z) < footprintHalfDepth)
+    {
+        for (unsigned int level = kSimpleMazeLevels; level-- > 0u;)
+        {
+            if (eye.y > kSimpleFloorY + static_cast<float>(level) * kSimpleLevelSpacing + 0.01f)
+            {
+                lowestVisibleLevel = level;
+                break;
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < mMazeClusters.size(); ++i)
+    {
+        const MazeCluster &cluster = mMazeClusters[i];
+        if (cluster.level >= lowestVisibleLevel && mFrameFrustum.intersects(cluster.aabbMin, cluster.aabbMax))
+        {
+            mVisibleMazeClusters.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
 }
 
-void World::renderGoalPathStencil(const Camera &camera,
-                                  int windowWidth, int windowHeight) const noexcept
+void World::applyChunkGeometryUpdates() const noexcept
 {
-    const float aspectRatio = static_cast<float>(std::max(1, windowWidth)) /
-                              static_cast<float>(std::max(1, windowHeight));
-    const glm::mat4 mvp = camera.getPerspective(aspectRatio) * camera.getLookAt();
-    const float now = static_cast<float>(SDL_GetTicks()) * 0.001f;
+    if (!mChunkGeometryPool.isInitialized())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mChunkGeometryMutex);
+        if (mChunkGeometryUpdates.empty())
+        {
+            return;
+        }
+        mChunkGeometryApplying.swap(mChunkGeometryUpdates);
+    }
 
-    GLboolean stencilWasEnabled = glIsEnabled(GL_STENCIL_TEST);
-    GLboolean blendWasEnabled = glIsEnabled(GL_BLEND);
-    GLboolean depthWasEnabled = glIsEnabled(GL_DEPTH_TEST);
+    // Applied in order, so a chunk that unloads and reloads in one batch ends up resident once
+    for (auto &update : mChunkGeometryApplying)
+    {
+        if (update.instance >= 0)
+        {
+            // A wall broke or came back: only the hidden flag of its box changes, in place
+            if (auto it = mChunkGeometrySlots.find(update.coord); it != mChunkGeometrySlots.end())
+            {
+                const float hidden = update.hidden ? 1.0f : 0.0f;
+                mChunkGeometryPool.updateInstance(it->second, static_cast<std::size_t>(update.instance),
+                                                  offsetof(MazeWallInstance, centerHidden) + 3u * sizeof(float),
+                                                  &hidden, sizeof(hidden));
+            }
+            continue;
+        }
+
+        if (auto it = mChunkGeometrySlots.find(update.coord); it != mChunkGeometrySlots.end())
+        {
+            mChunkGeometryPool.detach(it->second);
+            mChunkGeometrySlots.erase(it);
+        }
+
+        if (update.detach || !update.slab || update.slab->wallInstances.empty())
+        {
+            releaseChunkSlab(std::move(update.slab));
+            continue;
+        }
+
+        const auto &instances = update.slab->wallInstances;
+        const int slot = mChunkGeometryPool.attach(instances.data(), instances.size());
+        releaseChunkSlab(std::move(update.slab));
+        if (slot == ChunkGeometryPool::INVALID_SLOT)
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "World: No free chunk geometry slot for chunk (%d, %d)",
+                        update.coord.x, update.coord.z);
+            continue;
+        }
+        mChunkGeometrySlots[update.coord] = slot;
+    }
+    mChunkGeometryApplying.clear();
+    mStaticShadowsDirty.store(true, std::memory_order_release);
+}
+
+void World::renderGoalPathStencil() const noexcept
+{
+    const GLStateCache::Snapshot savedState = GLStateCache::save();
     GLfloat prevLineWidth = 1.0f;
     glGetFloatv(GL_LINE_WIDTH, &prevLineWidth);
 
-    glEnable(GL_STENCIL_TEST);
+    GLStateCache::enable(GL_STENCIL_TEST);
     glClear(GL_STENCIL_BUFFER_BIT);
 
-    glEnable(GL_DEPTH_TEST);
-    glDepthMask(GL_FALSE);
-    glDisable(GL_BLEND);
+    GLStateCache::enable(GL_DEPTH_TEST);
+    GLStateCache::depthMask(false);
+    GLStateCache::disable(GL_BLEND);
 
     glStencilMask(0xFF);
     glStencilFunc(GL_ALWAYS, 1, 0xFF);
     glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
 
     mGoalPathStencilShader->bind();
-    mGoalPathStencilShader->setUniform("uMVP", mvp);
-    mGoalPathStencilShader->setUniform("uColor", glm::vec3(0.72f, 1.0f, 0.84f));
-    mGoalPathStencilShader->setUniform("uIntensity", 1.0f);
-    mGoalPathStencilShader->setUniform("uTime", now);
+    mGoalPathStencilShader->setUniform(mGoalPathUniforms.color, glm::vec3(0.72f, 1.0f, 0.84f));
+    mGoalPathStencilShader->setUniform(mGoalPathUniforms.intensity, 1.0f);
     mVAOManager->get(VAOs::ID::GOAL_PATH).bind();
     glLineWidth(3.0f);
-    glDrawArrays(GL_LINES, 0, mGoalPathVertexCount);
+    RenderStats::drawArrays(GL_LINES, 0, mGoalPathVertexCount);
 
     glStencilMask(0x00);
     glStencilFunc(GL_NOTEQUAL, 1, 0xFF);
-    glDisable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-    mGoalPathStencilShader->setUniform("uColor", glm::vec3(0.70f, 1.0f, 0.90f));
-    mGoalPathStencilShader->setUniform("uIntensity", 0.52f);
+    GLStateCache::disable(GL_DEPTH_TEST);
+    GLStateCache::enable(GL_BLEND);
+    GLStateCache::blendFunc(GL_SRC_ALPHA, GL_ONE);
+    mGoalPathStencilShader->setUniform(mGoalPathUniforms.color, glm::vec3(0.70f, 1.0f, 0.90f));
+    mGoalPathStencilShader->setUniform(mGoalPathUniforms.intensity, 0.52f);
     glLineWidth(7.0f);
-    glDrawArrays(GL_LINES, 0, mGoalPathVertexCount);
+    RenderStats::drawArrays(GL_LINES, 0, mGoalPathVertexCount);
 
     VertexArrayObject::unbind();
     glLineWidth(prevLineWidth);
     glStencilMask(0xFF);
     glStencilFunc(GL_ALWAYS, 0, 0xFF);
-    glDepthMask(GL_TRUE);
-
-    if (!stencilWasEnabled)
-        glDisable(GL_STENCIL_TEST);
-    if (!blendWasEnabled)
-        glDisable(GL_BLEND);
-    if (depthWasEnabled)
-        glEnable(GL_DEPTH_TEST);
-    else
-        glDisable(GL_DEPTH_TEST);
+    GLStateCache::restore(savedState);
 }
 
-void World::renderBoundaryCharacterBillboards(const Camera &camera,
-                                              int windowWidth, int windowHeight) const noexcept
+void World::renderBoundaryCharacterBillboards() const noexcept
 {
     if (!mBoundarySpriteShader || !mBoundarySpriteShader->isLinked() ||
         mBoundarySprites.empty())
@@ -1106,24 +2806,18 @@ void World::renderBoundaryCharacterBillboards(const Camera &camera,
     const int texH = std::max(1, spriteSheet->getHeight());
     const int rows = std::max(1, texH / kBoundaryTileSizePx);
 
-    const float aspectRatio = static_cast<float>(std::max(1, windowWidth)) /
-                              static_cast<float>(std::max(1, windowHeight));
-    const glm::mat4 view = camera.getLookAt();
-    const glm::mat4 proj = camera.getPerspective(aspectRatio);
-
-    GLboolean wasBlendEnabled = GL_FALSE;
-    GLboolean wasCullEnabled = GL_FALSE;
-    glGetBooleanv(GL_BLEND, &wasBlendEnabled);
-    glGetBooleanv(GL_CULL_FACE, &wasCullEnabled);
-
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDisable(GL_CULL_FACE);
-    glEnable(GL_DEPTH_TEST);
+    // The OIT pass already has its own target bound
+    if (!GLSDLHelper::isBillboardOITPass())
+    {
+        bindSceneFramebuffer();
+    }
 
-    glDrawBuffer(GL_BACK);
+    // Same UVs either way; the atlas only moves the sheet into a page shared with the other sprites
+    const TextureAtlas::Region *region =
+        mTextureAtlas ? mTextureAtlas->find(Textures::ID::CHARACTER_SPRITE_SHEET) : nullptr;
+    const BillboardBatch::Key key{region ? region->texture : spriteSheet->get()};
 
-    const float now = static_cast<float>(SDL_GetTicks()) * 0.001f;
+    const float now = mFrameUniforms.timeSeconds;
 
     for (const auto &sprite : mBoundarySprites)
     {
@@ -1135,134 +2829,307 @@ void World::renderBoundaryCharacterBillboards(const Camera &camera,
         const float tileV = static_cast<float>(kBoundaryTileSizePx) / static_cast<float>(texH);
         const float vMin = static_cast<float>(rowFromBottom) * tileV;
 
-        const glm::vec4 uvRect(0.0f, vMin, tileU, vMin + tileV);
+        const glm::vec4 tileRect(0.0f, vMin, tileU, vMin + tileV);
+        const glm::vec4 uvRect = region ? region->map(tileRect) : tileRect;
         const float effectiveScale = std::max(sprite.scale, 0.1f);
         const glm::vec2 halfSizeXY(kBoundarySpriteWidth * effectiveScale * 0.5f,
                                    kBoundarySpriteHeight * effectiveScale * 0.5f);
 
-        GLSDLHelper::renderBillboardSpriteUV(
-            *mBoundarySpriteShader,
-            spriteSheet->get(),
-            uvRect,
-            sprite.center,
-            0.0f,
-            view,
-            proj,
-            glm::vec4(1.0f),
-            false,
-            false,
-            false,
-            halfSizeXY);
+        mBillboardBatch.add(key, {sprite.center, halfSizeXY, uvRect, glm::vec4(1.0f)});
     }
 
-    if (!wasBlendEnabled)
-        glDisable(GL_BLEND);
-    if (wasCullEnabled)
-        glEnable(GL_CULL_FACE);
+    // One instanced draw for every boundary sprite
+    mBillboardBatch.flush(*mBoundarySpriteShader, mFrameUniforms.view);
 }
 
-void World::renderPickupSpheres(const Camera &camera,
-                                int windowWidth, int windowHeight) const noexcept
+void World::renderPickupSpheres() const noexcept
 {
-    if (mPickupSpheres.empty())
+    if (!mVAOManager || !mVBOManager)
         return;
 
-    // Configure pickup VAO vertex attributes on first use
-    if (mPickupVertexCount == 0 && mVAOManager && mVBOManager)
+    // Build the shared cube and the instanced VAO layout on first use
+    if (mPickupCubeVertexCount == 0)
     {
+        std::vector<RasterVertex> cubeVerts;
+        cubeVerts.reserve(36);
+
+        // Vertex color carries the per-face shade; the instance tint multiplies it
+        auto pushQuad = [&cubeVerts](const glm::vec3 &a, const glm::vec3 &b,
+                                     const glm::vec3 &c, const glm::vec3 &d, float shade)
+        {
+            const glm::vec3 color(shade);
+            cubeVerts.push_back({a, color});
+            cubeVerts.push_back({b, color});
+            cubeVerts.push_back({c, color});
+            cubeVerts.push_back({a, color});
+            cubeVerts.push_back({c, color});
+            cubeVerts.push_back({d, color});
+        };
+
+        const float h = 0.4f;
+        const glm::vec3 p000(-h, -h, -h);
+        const glm::vec3 p001(-h, -h, h);
+        const glm::vec3 p010(-h, h, -h);
+        const glm::vec3 p011(-h, h, h);
+        const glm::vec3 p100(h, -h, -h);
+        const glm::vec3 p101(h, -h, h);
+        const glm::vec3 p110(h, h, -h);
+        const glm::vec3 p111(h, h, h);
+
+        pushQuad(p001, p101, p111, p011, 1.0f);
+        pushQuad(p100, p000, p010, p110, 0.8f);
+        pushQuad(p000, p001, p011, p010, 0.9f);
+        pushQuad(p101, p100, p110, p111, 0.85f);
+        pushQuad(p010, p011, p111, p110, 1.1f);
+        pushQuad(p000, p100, p101, p001, 0.7f);
+
         mVAOManager->get(VAOs::ID::PICKUP_SPHERES).bind();
-        mVBOManager->get(VBOs::ID::PICKUP).bind(GL_ARRAY_BUFFER);
+        mVBOManager->get(VBOs::ID::PICKUP).allocate(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(cubeVerts.size() * sizeof(RasterVertex)),
+                                                    cubeVerts.data(), GL_STATIC_DRAW);
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(RasterVertex),
                               reinterpret_cast<void *>(offsetof(RasterVertex, position)));
         glEnableVertexAttribArray(1);
         glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(RasterVertex),
                               reinterpret_cast<void *>(offsetof(RasterVertex, color)));
+
+        mVBOManager->get(VBOs::ID::PICKUP_INSTANCES).bind(GL_ARRAY_BUFFER);
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(PickupInstance),
+                              reinterpret_cast<void *>(offsetof(PickupInstance, offsetCollected)));
+        glVertexAttribDivisor(2, 1);
+        glEnableVertexAttribArray(3);
+        glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(PickupInstance),
+                              reinterpret_cast<void *>(offsetof(PickupInstance, tint)));
+        glVertexAttribDivisor(3, 1);
         VertexArrayObject::unbind();
+
+        const_cast<World *>(this)->mPickupCubeVertexCount = static_cast<GLsizei>(cubeVerts.size());
+        mPickupInstances.clear();
+        mPickupInstanceCapacity = 0;
         mPickupsDirty = true;
     }
 
     if (mPickupsDirty)
     {
-        std::vector<RasterVertex> pickupVerts;
-        pickupVerts.reserve(mPickupSpheres.size() * 36);
+        updatePickupInstances();
+        mPickupsDirty = false;
+    }
+
+    if (mPickupInstances.empty())
+        return;
+
+    GLStateCache::enable(GL_DEPTH_TEST);
+    mMazeShader->bind();
+    mMazeShader->setUniform(mMazeUniforms.hasTexture, 0);
+    mMazeShader->setUniform(mMazeUniforms.instanced, 1);
+    mVAOManager->get(VAOs::ID::PICKUP_SPHERES).bind();
+    RenderStats::drawArraysInstanced(GL_TRIANGLES, 0, mPickupCubeVertexCount, static_cast<GLsizei>(mPickupInstances.size()));
+    mMazeShader->setUniform(mMazeUniforms.instanced, 0);
+}
+
+void World::updatePickupInstances() const noexcept
+{
+    const auto &pickups = getPickupSpheres();
+
+    mPickupInstanceScratch.clear();
+    mPickupInstanceScratch.reserve(pickups.size());
+    for (const auto &pickup : pickups)
+    {
+        PickupInstance instance;
+        instance.offsetCollected = glm::vec4(pickup.position, pickup.collected ? 1.0f : 0.0f);
+        if (pickup.value > 0)
+            instance.tint = glm::vec3(0.15f, 0.85f, 0.25f);
+        else if (pickup.value < 0)
+            instance.tint = glm::vec3(0.90f, 0.15f, 0.15f);
+        else
+            instance.tint = glm::vec3(0.90f, 0.85f, 0.15f);
+        mPickupInstanceScratch.push_back(instance);
+    }
+
+    auto &instanceBuffer = mVBOManager->get(VBOs::ID::PICKUP_INSTANCES);
+    instanceBuffer.bind(GL_ARRAY_BUFFER);
+
+    // Growth reallocates geometrically and uploads everything once
+    if (mPickupInstanceScratch.size() > mPickupInstanceCapacity)
+    {
+        mPickupInstanceCapacity = std::max<std::size_t>({mPickupInstanceScratch.size(), mPickupInstanceCapacity * 2, 64});
+        instanceBuffer.allocate(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(mPickupInstanceCapacity * sizeof(PickupInstance)),
+                                nullptr, GL_DYNAMIC_DRAW);
+        RenderStats::bufferSubData(GL_ARRAY_BUFFER, 0,
+                                   static_cast<GLsizeiptr>(mPickupInstanceScratch.size() * sizeof(PickupInstance)),
+                                   mPickupInstanceScratch.data());
+        mPickupInstances.swap(mPickupInstanceScratch);
+        return;
+    }
+
+    // Otherwise upload only what changed: a collection swaps the last pickup into the hole
+    // (one or two instances) and a new chunk appends a tail range. Nearby changes share one call.
+    constexpr std::size_t kMergeGap = 16;
+    const auto unchanged = [this](std::size_t index)
+    {
+        return index < mPickupInstances.size() &&
+               mPickupInstances[index].offsetCollected == mPickupInstanceScratch[index].offsetCollected &&
+               mPickupInstances[index].tint == mPickupInstanceScratch[index].tint;
+    };
 
-        auto pushQuad = [&pickupVerts](const glm::vec3 &a, const glm::vec3 &b,
-                                       const glm::vec3 &c, const glm::vec3 &d,
-                                       const glm::vec3 &color)
+    const std::size_t count = mPickupInstanceScratch.size();
+    std::size_t i = 0;
+    while (i < count)
+    {
+        if (unchanged(i))
         {
-            pickupVerts.push_back({a, color});
-            pickupVerts.push_back({b, color});
-            pickupVerts.push_back({c, color});
-            pickupVerts.push_back({a, color});
-            pickupVerts.push_back({c, color});
-            pickupVerts.push_back({d, color});
-        };
+            ++i;
+            continue;
+        }
 
-        for (const auto &pickup : mPickupSpheres)
+        const std::size_t runStart = i;
+        std::size_t runEnd = i + 1;
+        for (std::size_t j = runEnd; j < count && j - runEnd <= kMergeGap; ++j)
         {
-            if (pickup.collected)
-                continue;
+            if (!unchanged(j))
+            {
+                runEnd = j + 1;
+            }
+        }
 
-            const glm::vec3 &pos = pickup.position;
+        RenderStats::bufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(runStart * sizeof(PickupInstance)),
+                                   static_cast<GLsizeiptr>((runEnd - runStart) * sizeof(PickupInstance)),
+                                   mPickupInstanceScratch.data() + runStart);
+        i = runEnd;
+    }
 
-            glm::vec3 color;
-            if (pickup.value > 0)
-                color = glm::vec3(0.15f, 0.85f, 0.25f);
-            else if (pickup.value < 0)
-                color = glm::vec3(0.90f, 0.15f, 0.15f);
-            else
-                color = glm::vec3(0.90f, 0.85f, 0.15f);
-
-            const float h = 0.4f;
-            const glm::vec3 p000 = pos + glm::vec3(-h, -h, -h);
-            const glm::vec3 p001 = pos + glm::vec3(-h, -h, h);
-            const glm::vec3 p010 = pos + glm::vec3(-h, h, -h);
-            const glm::vec3 p011 = pos + glm::vec3(-h, h, h);
-            const glm::vec3 p100 = pos + glm::vec3(h, -h, -h);
-            const glm::vec3 p101 = pos + glm::vec3(h, -h, h);
-            const glm::vec3 p110 = pos + glm::vec3(h, h, -h);
-            const glm::vec3 p111 = pos + glm::vec3(h, h, h);
-
-            pushQuad(p001, p101, p111, p011, color);
-            pushQuad(p100, p000, p010, p110, color * 0.8f);
-            pushQuad(p000, p001, p011, p010, color * 0.9f);
-            pushQuad(p101, p100, p110, p111, color * 0.85f);
-            pushQuad(p010, p011, p111, p110, color * 1.1f);
-            pushQuad(p000, p100, p101, p001, color * 0.7f);
-        }
-
-        mVBOManager->get(VBOs::ID::PICKUP).bind(GL_ARRAY_BUFFER);
-        glBufferData(GL_ARRAY_BUFFER,
-                     static_cast<GLsizeiptr>(pickupVerts.size() * sizeof(RasterVertex)),
-                     pickupVerts.data(), GL_DYNAMIC_DRAW);
-        const_cast<World *>(this)->mPickupVertexCount = static_cast<GLsizei>(pickupVerts.size());
-        mPickupsDirty = false;
+    // Shrinking needs no upload; the instance count just drops
+    mPickupInstances.swap(mPickupInstanceScratch);
+}
+
+float World::updatePlayerAnimationLod(const Player &player, float modelAnimTime) const noexcept
+{
+    if (!mModelsManager)
+        return modelAnimTime;
+
+    const GLTFModel *model = nullptr;
+    try
+    {
+        model = &mModelsManager->get(Models::ID::STYLIZED_CHARACTER);
+    }
+    catch (const std::exception &)
+    {
+        return modelAnimTime;
     }
 
-    if (mPickupVertexCount == 0)
+    if (!model || !model->isLoaded())
+        return modelAnimTime;
+
+    glm::mat4 modelMat = glm::translate(glm::mat4(1.0f), player.getRenderPosition() + glm::vec3(0.0f, kCharacterModelYOffset, 0.0f));
+    modelMat = glm::rotate(modelMat, glm::radians(player.getFacingDirection()), glm::vec3(0.0f, 1.0f, 0.0f));
+    mPlayerAnimationLod = selectAnimationLod(*model, modelMat, mPlayerAnimationLod);
+    RenderStats::countAnimationLod(mPlayerAnimationLod);
+    return throttleAnimationTime(modelAnimTime, mPlayerAnimationLod);
+}
+
+std::uint32_t World::selectAnimationLod(const GLTFModel &model, const glm::mat4 &modelMat,
+                                        std::uint32_t previousTier) const noexcept
+{
+    const glm::vec4 sphere = model.getBoundingSphere(modelMat);
+    if (sphere.w > 0.0f && !mFrameFrustum.intersectsSphere(glm::vec3(sphere), sphere.w * kAnimationCullRadiusScale))
+        return kAnimationLodCulled;
+
+    const float pixels = model.getProjectedHeight(modelMat, characterLodView(mFrameUniforms));
+    if (pixels <= 0.0f)
+        return 0u;
+
+    // Same hysteresis as GLTFModel::selectLod, so a character near a threshold does not alternate rates
+    std::uint32_t tier = std::min(previousTier, kAnimationLodCulled - 1u);
+    while (tier + 1u < kAnimationLodCulled && pixels < kAnimationLodPixelHeights[tier] * (1.0f - kAnimationLodHysteresis))
+        ++tier;
+    while (tier > 0u && pixels > kAnimationLodPixelHeights[tier - 1u] * (1.0f + kAnimationLodHysteresis))
+        --tier;
+    return tier;
+}
+
+void World::renderPlayerCharacterModel(const Player &player, float modelAnimTime) const noexcept
+{
+    if (!mSkinnedCharacterShader || !mSkinnedCharacterShader->isLinked())
+        return;
+
+    // Outside the view: no pose, no skinning pass and no draw
+    if (mPlayerAnimationLod == kAnimationLodCulled)
         return;
 
-    const float aspectRatio = static_cast<float>(std::max(1, windowWidth)) /
-                              static_cast<float>(std::max(1, windowHeight));
-    const glm::mat4 mvp = camera.getPerspective(aspectRatio) * camera.getLookAt();
+    if (!mModelsManager)
+        return;
 
-    glEnable(GL_DEPTH_TEST);
-    mMazeShader->bind();
-    mMazeShader->setUniform("uMVP", mvp);
-    mMazeShader->setUniform("uHasTexture", 0);
-    mVAOManager->get(VAOs::ID::PICKUP_SPHERES).bind();
-    glDrawArrays(GL_TRIANGLES, 0, mPickupVertexCount);
+    GLTFModel *model = nullptr;
+    try
+    {
+        model = &mModelsManager->get(Models::ID::STYLIZED_CHARACTER);
+    }
+    catch (const std::exception &)
+    {
+        return;
+    }
+
+    if (!model || !model->isLoaded())
+        return;
+
+    const glm::vec3 playerPos = player.getRenderPosition() + glm::vec3(0.0f, kCharacterModelYOffset, 0.0f);
+    const float facingDeg = player.getFacingDirection();
+
+    glm::mat4 modelMat = glm::translate(glm::mat4(1.0f), playerPos);
+    modelMat = glm::rotate(modelMat, glm::radians(facingDeg), glm::vec3(0.0f, 1.0f, 0.0f));
+    modelMat = glm::scale(modelMat, glm::vec3(1.0f));
+
+    const GLStateCache::Snapshot savedState = GLStateCache::save();
+
+    GLStateCache::enable(GL_DEPTH_TEST);
+    GLStateCache::depthFunc(GL_LESS);
+    GLStateCache::depthMask(true);
+    GLStateCache::enable(GL_CULL_FACE);
+    glCullFace(GL_BACK);
+
+    // Both draws below share one skinned pose and detail level
+    model->updateSkinning(mSkinningComputeShader, modelAnimTime);
+    mPlayerModelLod = model->selectLod(modelMat, characterLodView(mFrameUniforms), mPlayerModelLod);
+
+    mSkinnedCharacterShader->bind();
+
+    // Contact shadow
+    {
+        glm::mat4 shadowMat = glm::translate(glm::mat4(1.0f), glm::vec3(playerPos.x, kSimpleFloorY + 0.03f, playerPos.z));
+        shadowMat = glm::rotate(shadowMat, glm::radians(facingDeg), glm::vec3(0.0f, 1.0f, 0.0f));
+        shadowMat = glm::scale(shadowMat, glm::vec3(1.03f, 0.02f, 1.03f));
+
+        GLStateCache::enable(GL_BLEND);
+        GLStateCache::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        GLStateCache::depthMask(false);
+        GLStateCache::disable(GL_CULL_FACE);
+
+        mSkinnedCharacterShader->setUniform(mSkinnedShadowPassUniform, 1);
+        model->render(*mSkinnedCharacterShader, shadowMat, modelAnimTime, mPlayerModelLod);
+
+        GLStateCache::depthMask(true);
+        GLStateCache::setEnabled(GL_CULL_FACE, savedState.cullFace);
+    }
+
+    mSkinnedCharacterShader->setUniform(mSkinnedShadowPassUniform, 0);
+    model->render(*mSkinnedCharacterShader, modelMat, modelAnimTime, mPlayerModelLod);
+
+    GLStateCache::restore(savedState);
 }
 
-void World::renderPlayerCharacterModel(const Camera &camera, const Player &player,
-                                       int windowWidth, int windowHeight,
-                                       float modelAnimTime) const noexcept
+void World::setCharacterInstances(std::span<const CharacterInstance> characters)
 {
-    if (!mSkinnedCharacterShader || !mSkinnedCharacterShader->isLinked())
-        return;
+    mCharacterInstances.assign(characters.begin(), characters.end());
+    // Levels carry over by slot; a character that changes slot only loses one frame of hysteresis
+    mCharacterLodLevels.resize(mCharacterInstances.size(), 0u);
+    mCharacterAnimationLods.resize(mCharacterInstances.size(), 0u);
+}
 
-    if (!mModelsManager)
+void World::renderCharacterInstances() const noexcept
+{
+    if (mCharacterInstances.empty() || !mSkinnedCharacterShader || !mSkinnedCharacterShader->isLinked() ||
+        !mModelsManager)
         return;
 
     GLTFModel *model = nullptr;
@@ -1278,231 +3145,342 @@ void World::renderPlayerCharacterModel(const Camera &camera, const Player &playe
     if (!model || !model->isLoaded())
         return;
 
-    const float aspectRatio = static_cast<float>(std::max(1, windowWidth)) /
-                              static_cast<float>(std::max(1, windowHeight));
-    const glm::mat4 view = camera.getLookAt();
-    const glm::mat4 proj = camera.getPerspective(aspectRatio);
-
-    const glm::vec3 playerPos = player.getPosition() + glm::vec3(0.0f, kCharacterModelYOffset, 0.0f);
-    const float facingDeg = player.getFacingDirection();
+    // Same placement and contact shadow as renderPlayerCharacterModel, one instance per character
+    std::pmr::vector<GLTFModel::Instance> bodies{&FrameArena::frame()};
+    std::pmr::vector<GLTFModel::Instance> shadows{&FrameArena::frame()};
+    bodies.reserve(mCharacterInstances.size());
+    shadows.reserve(mCharacterInstances.size());
+    const GLTFModel::LodView lodView = characterLodView(mFrameUniforms);
+    for (std::size_t i = 0; i < mCharacterInstances.size(); ++i)
+    {
+        const CharacterInstance &character = mCharacterInstances[i];
+        const glm::vec3 position = character.position + glm::vec3(0.0f, kCharacterModelYOffset, 0.0f);
+        const float facing = glm::radians(character.facingDegrees);
+
+        glm::mat4 bodyMat = glm::translate(glm::mat4(1.0f), position);
+        bodyMat = glm::rotate(bodyMat, facing, glm::vec3(0.0f, 1.0f, 0.0f));
+        const std::uint32_t tier = selectAnimationLod(*model, bodyMat, mCharacterAnimationLods[i]);
+        mCharacterAnimationLods[i] = tier;
+        RenderStats::countAnimationLod(tier);
+        if (tier == kAnimationLodCulled)
+            continue;
 
-    glm::mat4 modelMat = glm::translate(glm::mat4(1.0f), playerPos);
-    modelMat = glm::rotate(modelMat, glm::radians(facingDeg), glm::vec3(0.0f, 1.0f, 0.0f));
-    modelMat = glm::scale(modelMat, glm::vec3(1.0f));
+        const float animationTime = throttleAnimationTime(character.animationTimeSeconds, tier);
+        const std::uint32_t lod = model->selectLod(bodyMat, lodView, mCharacterLodLevels[i]);
+        mCharacterLodLevels[i] = lod;
+        bodies.push_back({bodyMat, animationTime, lod});
 
-    GLboolean prevDepthTest = GL_FALSE;
-    GLboolean prevCullFace = GL_FALSE;
-    GLboolean prevBlend = GL_FALSE;
-    GLint prevDepthFunc = GL_LESS;
-    glGetBooleanv(GL_DEPTH_TEST, &prevDepthTest);
-    glGetBooleanv(GL_CULL_FACE, &prevCullFace);
-    glGetBooleanv(GL_BLEND, &prevBlend);
-    glGetIntegerv(GL_DEPTH_FUNC, &prevDepthFunc);
-
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LESS);
-    glDepthMask(GL_TRUE);
-    glEnable(GL_CULL_FACE);
-    glCullFace(GL_BACK);
+        glm::mat4 shadowMat = glm::translate(glm::mat4(1.0f), glm::vec3(position.x, kSimpleFloorY + 0.03f, position.z));
+        shadowMat = glm::rotate(shadowMat, facing, glm::vec3(0.0f, 1.0f, 0.0f));
+        shadowMat = glm::scale(shadowMat, glm::vec3(1.03f, 0.02f, 1.03f));
+        shadows.push_back({shadowMat, animationTime, lod});
+    }
 
-    mSkinnedCharacterShader->bind();
-    mSkinnedCharacterShader->setUniform("uCameraPos", camera.getPosition());
-    mSkinnedCharacterShader->setUniform("uTime", static_cast<float>(SDL_GetTicks()) * 0.001f);
+    if (bodies.empty())
+        return;
 
-    // Contact shadow
-    {
-        glm::mat4 shadowMat = glm::translate(glm::mat4(1.0f), glm::vec3(playerPos.x, kSimpleFloorY + 0.03f, playerPos.z));
-        shadowMat = glm::rotate(shadowMat, glm::radians(facingDeg), glm::vec3(0.0f, 1.0f, 0.0f));
-        shadowMat = glm::scale(shadowMat, glm::vec3(1.03f, 0.02f, 1.03f));
+    const GLStateCache::Snapshot savedState = GLStateCache::save();
 
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glDepthMask(GL_FALSE);
-        glDisable(GL_CULL_FACE);
+    GLStateCache::enable(GL_DEPTH_TEST);
+    GLStateCache::depthFunc(GL_LESS);
+    GLStateCache::depthMask(true);
 
-        mSkinnedCharacterShader->setUniform("uShadowPass", 1);
-        model->render(*mSkinnedCharacterShader, shadowMat, view, proj, modelAnimTime);
+    mSkinnedCharacterShader->bind();
 
-        glDepthMask(GL_TRUE);
-        if (prevCullFace)
-            glEnable(GL_CULL_FACE);
-        else
-            glDisable(GL_CULL_FACE);
-    }
+    GLStateCache::enable(GL_BLEND);
+    GLStateCache::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLStateCache::depthMask(false);
+    GLStateCache::disable(GL_CULL_FACE);
+    mSkinnedCharacterShader->setUniform(mSkinnedShadowPassUniform, 1);
+    model->renderInstanced(*mSkinnedCharacterShader, shadows);
 
-    mSkinnedCharacterShader->setUniform("uShadowPass", 0);
-    model->render(*mSkinnedCharacterShader, modelMat, view, proj, modelAnimTime);
+    GLStateCache::setEnabled(GL_BLEND, savedState.blend);
+    GLStateCache::depthMask(true);
+    GLStateCache::enable(GL_CULL_FACE);
+    glCullFace(GL_BACK);
+    mSkinnedCharacterShader->setUniform(mSkinnedShadowPassUniform, 0);
+    model->renderInstanced(*mSkinnedCharacterShader, bodies);
 
-    if (!prevDepthTest)
-        glDisable(GL_DEPTH_TEST);
-    else
-        glDepthFunc(static_cast<GLenum>(prevDepthFunc));
-    if (!prevCullFace)
-        glDisable(GL_CULL_FACE);
-    if (!prevBlend)
-        glDisable(GL_BLEND);
+    GLStateCache::restore(savedState);
 }
 
-void World::renderWalkParticles(const Camera &camera, const Player &player,
-                                int windowWidth, int windowHeight,
-                                float playerPlanarSpeed) const noexcept
+void World::renderWalkParticles(const Player &player, float playerPlanarSpeed, bool oitPass) const noexcept
 {
-    if (!mWalkParticlesInitialized || !mWalkParticlesComputeShader || !mWalkParticlesRenderShader || mWalkParticleCount == 0)
-        return;
-
-    if (!mWalkParticlesComputeShader->isLinked())
-        return;
-
-    if (playerPlanarSpeed < 1.0f)
+    if (!mWalkParticles.isInitialized())
         return;
 
-    const float now = static_cast<float>(SDL_GetTicks()) * 0.001f;
+    const float now = mFrameUniforms.timeSeconds;
     const float dt = (mWalkParticlesTime <= 0.0f) ? 0.0f : std::min(0.03f, now - mWalkParticlesTime);
     mWalkParticlesTime = now;
 
-    const glm::vec3 playerPos = player.getPosition();
+    const glm::vec3 playerPos = player.getRenderPosition();
     const glm::vec3 footCenter = playerPos + glm::vec3(0.0f, 1.0f, 0.0f);
-    const glm::vec3 attractor1 = footCenter + glm::vec3(-0.65f, 0.1f, 0.0f);
-    const glm::vec3 attractor2 = footCenter + glm::vec3(0.65f, 0.1f, 0.0f);
+
+    // Walking turns the whole pool over once per lifetime; standing still lets the cloud die out
+    if (playerPlanarSpeed >= 1.0f && dt > 0.0f)
+    {
+        ParticleSystem::Emitter emitter;
+        emitter.center = footCenter + glm::vec3(0.0f, 0.375f, 0.0f);
+        emitter.extent = glm::vec3(2.2f, 0.75f, 2.2f);
+        emitter.lifeSeconds = kWalkParticleLifeSeconds;
+        emitter.count = static_cast<GLuint>(std::ceil(static_cast<float>(mWalkParticleCount) * dt / kWalkParticleLifeSeconds));
+        mWalkParticles.emit(emitter);
+    }
+
+    if (!mWalkParticles.isActive())
+        return;
 
     const float particleMass = 0.35f;
     const float gravityScale = 1.0f;
     const float pointSize = 2.6f;
     const float particleAlpha = 0.22f;
 
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, mVBOManager->get(VBOs::ID::WALK_PARTICLES_POS_SSBO).get());
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, mVBOManager->get(VBOs::ID::WALK_PARTICLES_VEL_SSBO).get());
-
-    mWalkParticlesComputeShader->bind();
-    mWalkParticlesComputeShader->setUniform("BlackHolePos1", attractor1);
-    mWalkParticlesComputeShader->setUniform("BlackHolePos2", attractor2);
-    mWalkParticlesComputeShader->setUniform("Gravity1", 210.0f * gravityScale);
-    mWalkParticlesComputeShader->setUniform("Gravity2", 210.0f * gravityScale);
-    mWalkParticlesComputeShader->setUniform("ParticleInvMass", 1.0f / std::max(0.05f, particleMass));
-    mWalkParticlesComputeShader->setUniform("DeltaT", std::max(0.0001f, dt * 0.8f));
-    mWalkParticlesComputeShader->setUniform("MaxDist", 4.5f);
-    mWalkParticlesComputeShader->setUniform("ParticleCount", mWalkParticleCount);
-
-    const GLuint groupsX = (mWalkParticleCount + 999u) / 1000u;
-    glDispatchCompute(groupsX, 1, 1);
-    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
-
-    const int safeHeight = std::max(1, windowHeight);
-    const float aspectRatio = static_cast<float>(windowWidth) / static_cast<float>(safeHeight);
-    const glm::mat4 mvp = camera.getPerspective(aspectRatio) * camera.getLookAt();
-
-    GLboolean blendEnabled = GL_FALSE;
-    glGetBooleanv(GL_BLEND, &blendEnabled);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    glEnable(GL_DEPTH_TEST);
-    glDepthMask(GL_FALSE);
-    glPointSize(pointSize);
-
-    mWalkParticlesRenderShader->bind();
-    mWalkParticlesRenderShader->setUniform("MVP", mvp);
-    mWalkParticlesRenderShader->setUniform("Color", glm::vec4(0.46f, 0.30f, 0.17f, std::clamp(particleAlpha, 0.0f, 1.0f)));
-    mVAOManager->get(VAOs::ID::WALK_PARTICLES).bind();
-    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(mWalkParticleCount));
+    ParticleSystem::Forces forces;
+    forces.attractor1 = footCenter + glm::vec3(-0.65f, 0.1f, 0.0f);
+    forces.attractor2 = footCenter + glm::vec3(0.65f, 0.1f, 0.0f);
+    forces.gravity1 = 210.0f * gravityScale;
+    forces.gravity2 = 210.0f * gravityScale;
+    forces.invMass = 1.0f / std::max(0.05f, particleMass);
+    forces.deltaT = std::max(0.0001f, dt * 0.8f);
+    forces.maxDist = 4.5f;
+    forces.lifeStep = dt;
+    mWalkParticles.update(forces);
+
+    const glm::vec4 color(0.46f, 0.30f, 0.17f, std::clamp(particleAlpha, 0.0f, 1.0f));
+    GLStateCache::enable(GL_DEPTH_TEST);
+    if (oitPass)
+    {
+        // Blend and depth state belong to the OIT pass; points are sized in its smaller texels
+        mWalkParticles.draw(color, std::max(1.0f, pointSize / static_cast<float>(mOITDownscale)), true);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        return;
+    }
+
+    const bool blendEnabled = GLStateCache::isEnabled(GL_BLEND);
+    GLStateCache::enable(GL_BLEND);
+    GLStateCache::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLStateCache::depthMask(false);
+
+    mWalkParticles.draw(color, pointSize);
 
-    VertexArrayObject::unbind();
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
-    glDepthMask(GL_TRUE);
+    GLStateCache::depthMask(true);
     if (!blendEnabled)
-        glDisable(GL_BLEND);
+        GLStateCache::disable(GL_BLEND);
 }
 
-void World::renderCharacterShadow(const Camera &camera, const Player &player,
-                                  int windowWidth, int windowHeight) const noexcept
+void World::renderStaticShadowLayer(const Player &player) const noexcept
 {
-    if (!mShadowsInitialized || !mShadowShader || !mFBOManager || !mShadowTexture || mShadowTexture->get() == 0)
+    if (!mShadowsInitialized || !mMazeShader || !mFBOManager || !mVAOManager)
         return;
 
-    if (camera.getMode() != CameraMode::THIRD_PERSON)
+    // Chunk attach/detach events land here first so a streamed chunk dirties this frame's map
+    applyChunkGeometryUpdates();
+
+    const ChunkCoord center = getChunkCoord(player.getRenderPosition());
+    const bool dirty = mStaticShadowsDirty.exchange(false, std::memory_order_acq_rel);
+    if (!dirty && mStaticShadowValid && center == mStaticShadowCenter)
         return;
 
+    GPUProfiler::Scope timer{GPUProfiler::Pass::SHADOW};
+
+    // Orthographic sun view fitted around the resident chunks (same square the streamer keeps loaded)
+    const float groundY = mGroundPlane.getPoint().y;
+    const float halfExtent = (static_cast<float>(CHUNK_LOAD_RADIUS) + 0.5f) * CHUNK_SIZE;
+    const glm::vec3 focus((static_cast<float>(center.x) + 0.5f) * CHUNK_SIZE, groundY,
+                          (static_cast<float>(center.z) + 0.5f) * CHUNK_SIZE);
+    const glm::vec3 lightDir = computeSunDirection(mFrameUniforms.timeSeconds);
+    const glm::vec3 up = (std::abs(lightDir.y) > 0.99f) ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+    const glm::mat4 lightView = glm::lookAt(focus - lightDir * (2.0f * halfExtent), focus, up);
+
+    glm::vec3 boundsMin(std::numeric_limits<float>::max());
+    glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+    for (int corner = 0; corner < 8; ++corner)
+    {
+        const glm::vec3 world(focus.x + ((corner & 1) ? halfExtent : -halfExtent),
+                              (corner & 2) ? kStaticShadowMaxY : groundY - 1.0f,
+                              focus.z + ((corner & 4) ? halfExtent : -halfExtent));
+        const glm::vec3 view(lightView * glm::vec4(world, 1.0f));
+        boundsMin = glm::min(boundsMin, view);
+        boundsMax = glm::max(boundsMax, view);
+    }
+    mStaticShadowViewProjection = glm::ortho(boundsMin.x, boundsMax.x, boundsMin.y, boundsMax.y,
+                                             -boundsMax.z - 1.0f, -boundsMin.z + 1.0f) * lightView;
+
     mFBOManager->get(FBOs::ID::SHADOW).bind();
-    glViewport(0, 0, windowWidth, windowHeight);
-    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-    glClear(GL_COLOR_BUFFER_BIT);
+    glViewport(0, 0, kStaticShadowMapSize, kStaticShadowMapSize);
+
+    const GLStateCache::Snapshot savedState = GLStateCache::save();
+    GLStateCache::disable(GL_BLEND);
+    GLStateCache::enable(GL_DEPTH_TEST);
+    GLStateCache::depthMask(true);
+    GLStateCache::depthFunc(GL_LESS);
+    glClear(GL_DEPTH_BUFFER_BIT);
+
+    // The low sun grazes the wall faces; slope-scaled offset keeps them from shadowing themselves
+    GLStateCache::enable(GL_POLYGON_OFFSET_FILL);
+    glPolygonOffset(1.5f, 4.0f);
+
+    // The map is the attachment now; keep it off the unit the maze shader samples it from
+    GLStateCache::activeTexture(GL_TEXTURE1);
+    GLStateCache::bindTexture(GL_TEXTURE_2D, 0);
+    GLStateCache::activeTexture(GL_TEXTURE0);
+
+    // Walls are the only static casters; floors are lit from the side and would only add acne
+    mMazeShader->bind();
+    mMazeShader->setUniform(mMazeUniforms.lightPass, 1);
+    mMazeShader->setUniform(mMazeUniforms.staticShadows, 0);
+    mMazeShader->setUniform(mMazeUniforms.lightViewProjection, mStaticShadowViewProjection);
+    mMazeShader->setUniform(mMazeUniforms.instanced, 2);
+    if (mMazeWallInstanceCount > 0)
+    {
+        mVAOManager->get(VAOs::ID::MAZE_WALLS).bind();
+        RenderStats::drawElementsInstanced(GL_TRIANGLES, mMazeWallCubeIndexCount, GL_UNSIGNED_BYTE, nullptr, mMazeWallInstanceCount);
+    }
+    if (mChunkGeometryPool.getResidentCount() > 0)
+    {
+        mVAOManager->get(VAOs::ID::MAZE_CHUNK_WALLS).bind();
+        mChunkGeometryPool.draw(mMazeWallCubeIndexCount, GL_UNSIGNED_BYTE);
+    }
+    mMazeShader->setUniform(mMazeUniforms.instanced, 0);
+    mMazeShader->setUniform(mMazeUniforms.lightPass, 0);
+
+    VertexArrayObject::unbind();
+    glPolygonOffset(0.0f, 0.0f);
+    GLStateCache::disable(GL_POLYGON_OFFSET_FILL);
+    GLStateCache::restore(savedState);
+    FramebufferObject::unbind();
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    mStaticShadowCenter = center;
+    mStaticShadowValid = true;
+}
+
+void World::renderDynamicShadows(const Camera &camera, const Player &player) const noexcept
+{
+    GPUProfiler::Scope timer{GPUProfiler::Pass::SHADOW};
+    if (!mShadowShader || !mShadowShader->isLinked() || !mVAOManager)
+        return;
+
+    const bool drawCharacter = camera.getMode() == CameraMode::THIRD_PERSON;
+    const bool drawPickups = mPickupCubeVertexCount > 0 && !mPickupInstances.empty();
+    if (!drawCharacter && !drawPickups)
+        return;
+
+    bindSceneFramebuffer();
+
+    // Depth-tested against the floor already drawn; dst *= 1 - alpha darkens without touching depth
+    const GLStateCache::Snapshot savedState = GLStateCache::save();
+    GLStateCache::enable(GL_DEPTH_TEST);
+    GLStateCache::depthMask(false);
+    GLStateCache::depthFunc(GL_LEQUAL);
+    GLStateCache::enable(GL_BLEND);
+    GLStateCache::blendFunc(GL_ZERO, GL_ONE_MINUS_SRC_ALPHA);
 
-    float aspectRatio = static_cast<float>(windowWidth) / static_cast<float>(windowHeight);
-    glm::mat4 view = camera.getLookAt();
-    glm::mat4 projection = camera.getPerspective(aspectRatio);
-    const float timeSeconds = static_cast<float>(SDL_GetTicks()) / 1000.0f;
-    const glm::vec3 lightDir = computeSunDirection(timeSeconds);
+    const glm::vec3 lightDir = computeSunDirection(mFrameUniforms.timeSeconds);
     const float groundY = mGroundPlane.getPoint().y;
 
     mShadowShader->bind();
-    mShadowShader->setUniform("uViewMatrix", view);
-    mShadowShader->setUniform("uProjectionMatrix", projection);
-    mShadowShader->setUniform("uLightDir", lightDir);
-    mShadowShader->setUniform("uGroundY", groundY);
-    mShadowShader->setUniform("uSphereCenter", glm::vec3(0.0f, 0.0f, 0.0f));
-    mShadowShader->setUniform("uSphereRadius", 50.0f);
+    mShadowShader->setUniform(mShadowUniforms.lightDir, lightDir);
+    mShadowShader->setUniform(mShadowUniforms.groundY, groundY);
+    mShadowShader->setUniform(mShadowUniforms.sphereCenter, glm::vec3(0.0f, groundY - kFlatShadowGroundRadius, 0.0f));
+    mShadowShader->setUniform(mShadowUniforms.sphereRadius, kFlatShadowGroundRadius);
+    mShadowShader->setUniform(mShadowUniforms.shadowStrength, kDynamicShadowStrength);
 
-    mVAOManager->get(VAOs::ID::SHADOW_QUAD).bind();
-
-    auto drawBillboardShadow = [this](const glm::vec3 &spritePos, float billboardHalfSize)
+    if (drawCharacter)
     {
-        mShadowShader->setUniform("uSpritePos", spritePos);
-        mShadowShader->setUniform("uSpriteHalfSize", billboardHalfSize);
-        glDrawArrays(GL_POINTS, 0, 1);
-    };
+        mShadowShader->setUniform(mShadowUniforms.instanced, 0);
+        mShadowShader->setUniform(mShadowUniforms.spritePos,
+                                  player.getRenderPosition() + glm::vec3(0.0f, kPlayerShadowCenterYOffset, 0.0f));
+        mShadowShader->setUniform(mShadowUniforms.spriteHalfSize, 3.0f);
+        mVAOManager->get(VAOs::ID::SHADOW_QUAD).bind();
+        RenderStats::drawArrays(GL_POINTS, 0, 1);
+    }
 
-    drawBillboardShadow(player.getPosition() + glm::vec3(0.0f, kPlayerShadowCenterYOffset, 0.0f), 3.0f);
+    // One point per pickup instance; collected ones are dropped in the geometry shader
+    if (drawPickups)
+    {
+        mShadowShader->setUniform(mShadowUniforms.instanced, 1);
+        mShadowShader->setUniform(mShadowUniforms.spriteHalfSize, kPickupShadowHalfSize);
+        mVAOManager->get(VAOs::ID::PICKUP_SPHERES).bind();
+        RenderStats::drawArraysInstanced(GL_POINTS, 0, 1, static_cast<GLsizei>(mPickupInstances.size()));
+        mShadowShader->setUniform(mShadowUniforms.instanced, 0);
+    }
 
     VertexArrayObject::unbind();
-    glDisable(GL_BLEND);
-    FramebufferObject::unbind();
+    GLStateCache::restore(savedState);
 }
 
-void World::renderPlayerReflection(const Camera &camera, const Player &player,
-                                   int windowWidth, int windowHeight) const noexcept
+void World::renderPlayerReflection(const Player &player, float modelAnimTime) const noexcept
 {
-    if (!mReflectionsInitialized || !mFBOManager || !mReflectionColorTex || mReflectionColorTex->get() == 0)
+    if (!mReflectionsInitialized || !mFBOManager || !mReflectionColorTex || mReflectionColorTex->get() == 0 ||
+        !mSkinnedCharacterShader || !mSkinnedCharacterShader->isLinked() || !mModelsManager)
+    {
+        mReflectionValid = false;
         return;
+    }
 
-    auto &reflFBO = mFBOManager->get(FBOs::ID::REFLECTION);
-    reflFBO.bind();
-    GLenum fboStatus = glCheckFramebufferStatus(GL_FRAMEBUFFER);
-    FramebufferObject::unbind();
+    // Odd frames keep last frame's image; the maze floor reprojects it through mReflectionViewProjection
+    const std::uint32_t frame = mReflectionFrame++;
+    if (mReflectionHalfRate && mReflectionValid && (frame & 1u) != 0u)
+        return;
 
-    if (fboStatus != GL_FRAMEBUFFER_COMPLETE)
+    GLTFModel *model = nullptr;
+    try
+    {
+        model = &mModelsManager->get(Models::ID::STYLIZED_CHARACTER);
+    }
+    catch (const std::exception &)
+    {
+        mReflectionValid = false;
         return;
+    }
 
-    glBindTexture(GL_TEXTURE_2D, mReflectionColorTex->get());
-    GLint texWidth = 0, texHeight = 0;
-    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &texWidth);
-    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &texHeight);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    if (!model || !model->isLoaded())
+    {
+        mReflectionValid = false;
+        return;
+    }
 
-    glFlush();
+    GPUProfiler::Scope timer{GPUProfiler::Pass::REFLECTION};
 
-    reflFBO.bind();
-    glViewport(0, 0, windowWidth, windowHeight);
+    const float groundY = mGroundPlane.getPoint().y;
+    const glm::vec3 modelPos = player.getRenderPosition() + glm::vec3(0.0f, kCharacterModelYOffset, 0.0f);
+    glm::mat4 modelMat = glm::translate(glm::mat4(1.0f), modelPos);
+    modelMat = glm::rotate(modelMat, glm::radians(player.getFacingDirection()), glm::vec3(0.0f, 1.0f, 0.0f));
+
+    // Mirroring the model about the ground (y -> 2 * groundY - y) under the real camera is the planar reflection
+    const glm::mat4 mirror = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 2.0f * groundY, 0.0f)) *
+                             glm::scale(glm::mat4(1.0f), glm::vec3(1.0f, -1.0f, 1.0f));
+
+    mFBOManager->get(FBOs::ID::REFLECTION).bind();
+    glViewport(0, 0, mReflectionWidth, mReflectionHeight);
+
+    const GLStateCache::Snapshot savedState = GLStateCache::save();
+    GLStateCache::disable(GL_BLEND);
+    GLStateCache::enable(GL_DEPTH_TEST);
+    GLStateCache::depthFunc(GL_LESS);
+    GLStateCache::depthMask(true);
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LESS);
-    glDepthMask(GL_TRUE);
+    // The mirror flips handedness, so outward faces wind clockwise on screen
+    GLStateCache::enable(GL_CULL_FACE);
+    glCullFace(GL_BACK);
+    glFrontFace(GL_CW);
 
-    const int safeHeight = std::max(windowHeight, 1);
-    const float aspectRatio = static_cast<float>(windowWidth) / static_cast<float>(safeHeight);
-    const float groundY = mGroundPlane.getPoint().y;
-    const glm::vec3 modelPos = player.getPosition() + glm::vec3(0.0f, kCharacterModelYOffset, 0.0f);
-    glm::vec3 reflectedModelPos = modelPos;
-    reflectedModelPos.y = (2.0f * groundY) - modelPos.y;
-    (void)reflectedModelPos;
-    (void)aspectRatio;
+    // Shares the pose the main character pass uses later this frame
+    model->updateSkinning(mSkinningComputeShader, modelAnimTime);
+    mSkinnedCharacterShader->bind();
+    mSkinnedCharacterShader->setUniform(mSkinnedShadowPassUniform, 0);
+    mPlayerModelLod = model->selectLod(modelMat, characterLodView(mFrameUniforms), mPlayerModelLod);
+    model->render(*mSkinnedCharacterShader, mirror * modelMat, modelAnimTime, mPlayerModelLod);
 
-    glFlush();
+    glFrontFace(GL_CCW);
+    GLStateCache::restore(savedState);
     FramebufferObject::unbind();
+
+    mReflectionViewProjection = mFrameUniforms.viewProjection;
+    mReflectionValid = true;
 }
 
 void World::handleEvent(const SDL_Event &event)
@@ -1512,6 +3490,9 @@ void World::handleEvent(const SDL_Event &event)
 
 void World::destroyWorld()
 {
+    // The simulation thread owns physics and chunk state while it runs
+    stopSimulationThread();
+
     // Shutdown worker pool FIRST - this clears all pending work
     shutdownWorkerPool();
 
@@ -1522,15 +3503,25 @@ void World::destroyWorld()
         mPlayerBodyId = b2_nullBodyId;
     }
 
-    // Destroy all physics bodies BEFORE destroying world
-    // Do this in reverse order to be safe
-    for (auto it = mSphereBodyIds.rbegin(); it != mSphereBodyIds.rend(); ++it)
+    // Drop half-integrated chunks along with their staging bodies
+    for (auto &integration : mIntegrationQueue)
+    {
+        if (b2Body_IsValid(integration.bodyId))
+        {
+            b2DestroyBody(integration.bodyId);
+        }
+    }
+    mIntegrationQueue.clear();
+    mIntegratingChunks.clear();
+
+    // Destroy all chunk bodies (and their wall shapes) BEFORE destroying world
+    for (auto &[coord, bodyId] : mChunkBodies)
     {
-        if (b2Body_IsValid(*it))
+        if (b2Body_IsValid(bodyId))
         {
             try
             {
-                b2DestroyBody(*it);
+                b2DestroyBody(bodyId);
             }
             catch (const std::exception &e)
             {
@@ -1542,7 +3533,8 @@ void World::destroyWorld()
             }
         }
     }
-    mSphereBodyIds.clear();
+    mChunkBodies.clear();
+    mBodyToChunk.clear();
 
     // Destroy physics world
     if (b2World_IsValid(mWorldId))
@@ -1561,25 +3553,38 @@ void World::destroyWorld()
         }
         mWorldId = b2_nullWorldId;
     }
+    mPhysicsScheduler.reset();
 
     // Clear all data structures
     mSpheres.clear();
-    mChunkSphereIndices.clear();
+    mChunkSphereHandles.clear();
+    mChunkSphereWalls.clear();
     mLoadedChunks.clear();
     mWallBreakQueue.clear();
-    mPickupSpheres.clear();
-    mPersistentSphereCount = 0;
+    mPickups.clear();
+    mPickupGrid.clear();
+    mChunkPickupHandles.clear();
+    {
+        std::lock_guard<std::mutex> lock(mChunkGeometryMutex);
+        mChunkGeometryUpdates.clear();
+    }
+    mChunkGeometryPool.clear();
+    mChunkGeometrySlots.clear();
+    mHasForwardedChunk = false;
+    mAwaitedChunk.reset();
+    mStreamStats = ChunkStreamStats{};
     mScore = 0;
 }
 
 void World::initPathTracerScene() noexcept
 {
     mSpheres.clear();
-    mSphereBodyIds.clear();
+    mChunkBodies.clear();
+    mBodyToChunk.clear();
     mWallBreakQueue.clear();
     mLoadedChunks.clear();
-    mChunkSphereIndices.clear();
-    mPersistentSphereCount = 0;
+    mChunkSphereHandles.clear();
+    mChunkSphereWalls.clear();
 
     if (!b2World_IsValid(mWorldId))
     {
@@ -1590,292 +3595,480 @@ void World::initPathTracerScene() noexcept
 
 void World::syncPhysicsToSpheres() noexcept
 {
-    // Sync physics body positions (in 2D theta-phi space) back to 3D sphere positions on planet surface
-    for (size_t i = 0; i < mSpheres.size() && i < mSphereBodyIds.size(); ++i)
+    // Only bodies that moved this step; sleeping and static walls cost nothing
+    const b2BodyEvents events = b2World_GetBodyEvents(mWorldId);
+    for (int i = 0; i < events.moveCount; ++i)
     {
-        b2BodyId bodyId = mSphereBodyIds[i];
-        if (b2Body_IsValid(bodyId))
+        const b2BodyMoveEvent &move = events.moveEvents[i];
+        auto chunkIt = mBodyToChunk.find(b2StoreBodyId(move.bodyId));
+        if (chunkIt == mBodyToChunk.end())
+        {
+            continue;
+        }
+
+        if (auto handlesIt = mChunkSphereHandles.find(chunkIt->second); handlesIt != mChunkSphereHandles.end())
+        {
+            syncSphereHandles(handlesIt->second);
+        }
+    }
+}
+
+void World::syncSphereHandles(std::span<const SlotHandle> handles) noexcept
+{
+    const auto &shapes = mSpheres.column<SPHERE_SHAPE>();
+    const auto &radii = mSpheres.column<SPHERE_RADIUS>();
+    auto &centers = mSpheres.column<SPHERE_CENTER>();
+    auto &spheres = mSpheres.column<SPHERE_DATA>();
+
+    mSyncDense.clear();
+    mSyncArcX.clear();
+    mSyncArcZ.clear();
+    mSyncRadii.clear();
+
+    // Gather physics positions (in 2D theta-phi space) into packed arrays
+    for (const SlotHandle &handle : handles)
+    {
+        const std::size_t dense = mSpheres.denseIndex(handle);
+        if (dense == decltype(mSpheres)::NPOS || !b2Shape_IsValid(shapes[dense]))
         {
-            b2Vec2 pos = b2Body_GetPosition(bodyId);
-            
-            // pos.x = theta * radius (arc length around planet)
-            // pos.y = lateral arc offset
-            const float theta = pos.x / mPlanetRadius;
-            const float lateralArc = pos.y;
-            const float phi = lateralArc / mPlanetRadius;
-            
-            const float sphereRadius = mSpheres[i].getRadius();
-            const float r = mPlanetRadius + sphereRadius;
-            
-            const float cosPhi = std::cos(phi);
-            const float sinPhi = std::sin(phi);
-            const float cosTheta = std::cos(theta);
-            const float sinTheta = std::sin(theta);
-            
-            // Calculate 3D position on planet surface
-            glm::vec3 newCenter = mPlanetCenter + glm::vec3(
-                r * cosPhi * cosTheta,
-                r * sinPhi,
-                r * cosPhi * sinTheta
-            );
-            
-            mSpheres[i].setCenter(newCenter);
+            continue;
         }
+
+        const b2ShapeId shapeId = shapes[dense];
+        const b2Vec2 pos = b2Body_GetWorldPoint(b2Shape_GetBody(shapeId), b2Shape_GetCircle(shapeId).center);
+        mSyncDense.push_back(dense);
+        mSyncArcX.push_back(pos.x);
+        mSyncArcZ.push_back(pos.y);
+        mSyncRadii.push_back(radii[dense]);
+    }
+
+    mSyncCenters.resize(mSyncDense.size());
+    projectOntoSphere(mSyncArcX, mSyncArcZ, mSyncRadii, mSyncCenters);
+
+    for (std::size_t i = 0; i < mSyncDense.size(); ++i)
+    {
+        centers[mSyncDense[i]] = mSyncCenters[i];
+        spheres[mSyncDense[i]].setCenter(mSyncCenters[i]);
+    }
+}
+
+std::size_t World::findWallSphere(b2ShapeId shapeId) const noexcept
+{
+    if (!b2Shape_IsValid(shapeId))
+    {
+        return decltype(mSpheres)::NPOS;
     }
+
+    const auto userData = reinterpret_cast<std::uintptr_t>(b2Shape_GetUserData(shapeId));
+    if ((userData & kUserDataTagMask) != kBodyTagMazeWall)
+    {
+        return decltype(mSpheres)::NPOS;
+    }
+
+    // A reused slot holds another wall, so the stored shape must match too
+    const auto slot = static_cast<std::uint32_t>(userData >> kUserDataTagBits);
+    const std::size_t dense = mSpheres.denseIndex(mSpheres.handleForSlot(slot));
+    if (dense == decltype(mSpheres)::NPOS || !B2_ID_EQUALS(mSpheres.column<SPHERE_SHAPE>()[dense], shapeId))
+    {
+        return decltype(mSpheres)::NPOS;
+    }
+    return dense;
 }
 
 void World::breakQueuedWalls() noexcept
 {
-    for (const b2BodyId &bodyToRemove : mWallBreakQueue)
+    for (const b2ShapeId &shapeToRemove : mWallBreakQueue)
     {
-        // Find this body in the persistent wall zone [0, mPersistentSphereCount)
-        size_t wallIdx = SIZE_MAX;
-        for (size_t i = 0; i < mPersistentSphereCount; ++i)
+        // Walls queued twice or unloaded since resolve to nothing
+        const std::size_t dense = findWallSphere(shapeToRemove);
+        if (dense == decltype(mSpheres)::NPOS)
         {
-            if (B2_ID_EQUALS(mSphereBodyIds[i], bodyToRemove))
-            {
-                wallIdx = i;
-                break;
-            }
+            continue;
+        }
+
+        const auto chunk = mBodyToChunk.find(b2StoreBodyId(b2Shape_GetBody(shapeToRemove)));
+        if (chunk == mBodyToChunk.end())
+        {
+            removeWallSphere(nullptr, dense);
+            continue;
         }
-        if (wallIdx == SIZE_MAX || mPersistentSphereCount == 0)
+        const ChunkCoord coord = chunk->second;
+
+        const std::size_t index = mSpheres.column<SPHERE_CHUNK_INDEX>()[dense];
+        const auto walls = mChunkSphereWalls.find(coord);
+        const auto handles = mChunkSphereHandles.find(coord);
+        if (walls == mChunkSphereWalls.end() || index >= walls->second.size() || walls->second[index] < 0 ||
+            handles == mChunkSphereHandles.end())
+        {
+            removeWallSphere(&coord, dense);
             continue;
+        }
 
-        // Destroy the physics body
-        if (b2Body_IsValid(mSphereBodyIds[wallIdx]))
-            b2DestroyBody(mSphereBodyIds[wallIdx]);
+        // A wall box stands on the run of spheres laid along it; breaking one takes the whole wall
+        const std::vector<std::int16_t> &sphereWalls = walls->second;
+        const std::int16_t wall = sphereWalls[index];
+        std::size_t first = index;
+        while (first > 0 && sphereWalls[first - 1] == wall)
+        {
+            --first;
+        }
+        for (std::size_t i = first; i < sphereWalls.size() && i < handles->second.size() && sphereWalls[i] == wall; ++i)
+        {
+            // Siblings broken earlier have stale handles
+            if (const std::size_t sibling = mSpheres.denseIndex(handles->second[i]); sibling != decltype(mSpheres)::NPOS)
+            {
+                removeWallSphere(&coord, sibling);
+            }
+        }
 
-        const size_t lastPersistent = mPersistentSphereCount - 1;
+        // The box keeps its place in the chunk's slot; the render thread only flips its hidden flag
+        if (mRenderInitialized)
+        {
+            std::lock_guard<std::mutex> lock(mChunkGeometryMutex);
+            mChunkGeometryUpdates.push_back({coord, nullptr, false, wall, true});
+        }
+    }
+    mWallBreakQueue.clear();
+}
 
-        // Swap the hit wall with the last persistent (wall) sphere so the dead
-        // body ends up at index lastPersistent, just past the new boundary.
-        if (wallIdx != lastPersistent)
+void World::removeWallSphere(const ChunkCoord *coord, std::size_t dense) noexcept
+{
+    const b2ShapeId shapeId = mSpheres.column<SPHERE_SHAPE>()[dense];
+    if (b2Shape_IsValid(shapeId))
+    {
+        if (mMatchHistoryEnabled && coord)
         {
-            std::swap(mSpheres[wallIdx], mSpheres[lastPersistent]);
-            std::swap(mSphereBodyIds[wallIdx], mSphereBodyIds[lastPersistent]);
+            mRemovedWalls.push_back({*coord, b2Shape_GetCircle(shapeId), mSpheres.column<SPHERE_DATA>()[dense],
+                                     mSpheres.column<SPHERE_CHUNK_INDEX>()[dense]});
         }
 
-        // Update chunk sphere index lists:
-        //   - remove wallIdx (broken wall leaves the chunk)
-        //   - remap lastPersistent â†’ wallIdx (the wall that moved to fill the gap)
-        for (auto &[coord, indices] : mChunkSphereIndices)
+        // Only this shape goes; the chunk body and its other walls stay
+        b2DestroyShape(shapeId, false);
+    }
+
+    // The owning chunk keeps a stale handle, which unloadChunk ignores
+    mSpheres.erase(mSpheres.handleAt(dense));
+    mStaticShadowsDirty.store(true, std::memory_order_release);
+}
+
+void World::queueContactWallBreaks() noexcept
+{
+    // Walls broken by breakQueuedWalls() this step are already invalid and drop out in findWallSphere
+    mContactBreakSlots.clear();
+    auto collect = [this](b2ShapeId shapeA, b2ShapeId shapeB, float approachSpeed)
+    {
+        if (approachSpeed < kWallBreakApproachSpeed)
         {
-            for (size_t &sidx : indices)
+            return;
+        }
+        for (const b2ShapeId shapeId : {shapeA, shapeB})
+        {
+            if (const std::size_t dense = findWallSphere(shapeId); dense != decltype(mSpheres)::NPOS)
             {
-                if (sidx == wallIdx)
-                    sidx = SIZE_MAX; // mark for erasure
-                else if (sidx == lastPersistent && wallIdx != lastPersistent)
-                    sidx = wallIdx;  // sphere moved here
+                mContactBreakSlots.push_back(mSpheres.handleAt(dense).index);
             }
-            auto eraseIt = std::remove(indices.begin(), indices.end(), SIZE_MAX);
-            indices.erase(eraseIt, indices.end());
         }
+    };
+
+    const b2ContactEvents events = b2World_GetContactEvents(mWorldId);
+    for (int i = 0; i < events.beginCount; ++i)
+    {
+        const b2ContactBeginTouchEvent &event = events.beginEvents[i];
+        // Negative normal velocity means the shapes were closing when they touched
+        float approachSpeed = 0.0f;
+        for (int p = 0; p < event.manifold.pointCount; ++p)
+        {
+            approachSpeed = std::max(approachSpeed, -event.manifold.points[p].normalVelocity);
+        }
+        collect(event.shapeIdA, event.shapeIdB, approachSpeed);
+    }
+    for (int i = 0; i < events.hitCount; ++i)
+    {
+        const b2ContactHitEvent &event = events.hitEvents[i];
+        collect(event.shapeIdA, event.shapeIdB, event.approachSpeed);
+    }
 
-        // Shrink persistent zone; dead body at lastPersistent will be cleaned
-        // up by a subsequent cleanup pass (invalid body check).
-        --mPersistentSphereCount;
+    // A wall can begin touching and report a hit in one step, or be struck by several bodies
+    std::ranges::sort(mContactBreakSlots);
+    const auto duplicates = std::ranges::unique(mContactBreakSlots);
+    mContactBreakSlots.erase(duplicates.begin(), duplicates.end());
+    for (const std::uint32_t slot : mContactBreakSlots)
+    {
+        mWallBreakQueue.push_back(mSpheres.get<SPHERE_SHAPE>(mSpheres.handleForSlot(slot)));
     }
-    mWallBreakQueue.clear();
+}
+
+std::size_t World::breakChunkWalls(const glm::vec3 &position, std::size_t count) noexcept
+{
+    if (forwardsToSimulation())
+    {
+        postSimulationCommand([this, position, count]()
+                              { breakChunkWalls(position, count); });
+        return 0;
+    }
+
+    const auto handlesIt = mChunkSphereHandles.find(getChunkCoord(position));
+    if (handlesIt == mChunkSphereHandles.end())
+    {
+        return 0;
+    }
+
+    // Handles of walls broken earlier are stale and skipped, so repeated calls eat into the chunk
+    const auto &shapes = mSpheres.column<SPHERE_SHAPE>();
+    std::size_t queued = 0;
+    for (const SlotHandle &handle : handlesIt->second)
+    {
+        if (queued == count)
+        {
+            break;
+        }
+        const std::size_t dense = mSpheres.denseIndex(handle);
+        if (dense == decltype(mSpheres)::NPOS || !b2Shape_IsValid(shapes[dense]))
+        {
+            continue;
+        }
+        mWallBreakQueue.push_back(shapes[dense]);
+        ++queued;
+    }
+    return queued;
+}
+
+glm::ivec2 World::getChunkCell(const glm::vec3 &position) noexcept
+{
+    return {static_cast<int>(std::floor(position.x / CHUNK_SIZE)),
+            static_cast<int>(std::floor(position.z / CHUNK_SIZE))};
 }
 
 World::ChunkCoord World::getChunkCoord(const glm::vec3 &position) const noexcept
 {
-    return ChunkCoord{
-        static_cast<int>(std::floor(position.x / CHUNK_SIZE)),
-        static_cast<int>(std::floor(position.z / CHUNK_SIZE))};
+    const glm::ivec2 cell = getChunkCell(position);
+    return ChunkCoord{cell.x, cell.y};
 }
 
-void World::updateSphereChunks(const glm::vec3 &cameraPosition) noexcept
+void World::updateSphereChunks(const glm::vec3 &cameraPosition, const glm::vec3 &velocity) noexcept
 {
+    const glm::vec3 target = projectStreamTarget(cameraPosition, velocity);
+
+    if (forwardsToSimulation())
+    {
+        // Only chunk changes matter, so per-frame calls stay off the command queue
+        const ChunkCoord chunk = getChunkCoord(cameraPosition);
+        const ChunkCoord aheadChunk = getChunkCoord(target);
+        if (mHasForwardedChunk && chunk == mLastForwardedChunk && aheadChunk == mLastForwardedAheadChunk)
+        {
+            return;
+        }
+        mLastForwardedChunk = chunk;
+        mLastForwardedAheadChunk = aheadChunk;
+        mHasForwardedChunk = true;
+
+        postSimulationCommand([this, cameraPosition, velocity]()
+                              { updateSphereChunks(cameraPosition, velocity); });
+        return;
+    }
+
     ChunkCoord currentChunk = getChunkCoord(cameraPosition);
-    ChunkCoord lastChunk = getChunkCoord(mLastChunkUpdatePosition);
+    ChunkCoord aheadChunk = getChunkCoord(target);
 
-    // Update if camera moved to a different chunk OR this is the first call
+    // Update if the camera or its projected path moved to a different chunk OR this is the first call
     bool firstCall = (mLastChunkUpdatePosition.x == std::numeric_limits<float>::max());
-    bool chunkChanged = (currentChunk.x != lastChunk.x || currentChunk.z != lastChunk.z);
+    bool chunkChanged = currentChunk != mCenterChunk;
 
-    if (!firstCall && !chunkChanged)
+    if (!firstCall && !chunkChanged && aheadChunk == mAheadChunk)
     {
-        return; // Still in same chunk, no update needed
+        return; // Same chunk, same path, no update needed
+    }
+
+    if (!firstCall && chunkChanged)
+    {
+        ++mStreamStats.chunksEntered;
+        if (mLoadedChunks.find(currentChunk) == mLoadedChunks.end())
+        {
+            ++mStreamStats.lateChunks;
+            mAwaitedChunk = currentChunk;
+            mAwaitedSince = std::chrono::steady_clock::now();
+        }
     }
 
     mLastChunkUpdatePosition = cameraPosition;
+    mCenterChunk = currentChunk;
+    mAheadChunk = aheadChunk;
+
+    // Both containers live only for this call; this may run on the simulation thread, so they use its scratch arena
+    FrameArena::Scope scratch;
 
-    // Determine chunks that should be loaded
-    std::unordered_set<ChunkCoord, ChunkCoordHash> desiredChunks;
-    for (int dx = -CHUNK_LOAD_RADIUS; dx <= CHUNK_LOAD_RADIUS; ++dx)
+    // Determine chunks that should be loaded, each with the priority it is requested at
+    std::pmr::unordered_map<ChunkCoord, int, ChunkCoordHash> desiredChunks{scratch.resource()};
+    if (aheadChunk == currentChunk)
+    {
+        for (int dx = -CHUNK_LOAD_RADIUS; dx <= CHUNK_LOAD_RADIUS; ++dx)
+        {
+            for (int dz = -CHUNK_LOAD_RADIUS; dz <= CHUNK_LOAD_RADIUS; ++dz)
+            {
+                const ChunkCoord chunk{currentChunk.x + dx, currentChunk.z + dz};
+                desiredChunks.emplace(chunk, chunkPriority(chunk, currentChunk));
+            }
+        }
+    }
+    else
     {
-        for (int dz = -CHUNK_LOAD_RADIUS; dz <= CHUNK_LOAD_RADIUS; ++dz)
+        // March the path in half-chunk steps; a chunk's priority is the steps until the path passes
+        // it plus its squared distance from there, so the corridor ahead wins over the sides
+        const int steps = static_cast<int>(std::ceil(glm::distance(cameraPosition, target) / (0.5f * CHUNK_SIZE)));
+        for (int step = 0; step <= steps; ++step)
         {
-            desiredChunks.insert(ChunkCoord{currentChunk.x + dx, currentChunk.z + dz});
+            const float t = static_cast<float>(step) / static_cast<float>(steps);
+            const ChunkCoord sample = getChunkCoord(glm::mix(cameraPosition, target, t));
+            for (int dx = -CHUNK_NEAR_RADIUS; dx <= CHUNK_NEAR_RADIUS; ++dx)
+            {
+                for (int dz = -CHUNK_NEAR_RADIUS; dz <= CHUNK_NEAR_RADIUS; ++dz)
+                {
+                    const ChunkCoord chunk{sample.x + dx, sample.z + dz};
+                    const int priority = step + 2 * chunkPriority(chunk, sample);
+                    auto [it, inserted] = desiredChunks.emplace(chunk, priority);
+                    if (!inserted)
+                    {
+                        it->second = std::min(it->second, priority);
+                    }
+                }
+            }
         }
     }
 
-    // Unload chunks that are out of range
-    std::vector<ChunkCoord> chunksToUnload;
+    // Unload chunks that are out of range; resident chunks inside the load square stay until they leave it
+    std::pmr::vector<ChunkCoord> chunksToUnload{scratch.resource()};
     for (const auto &chunk : mLoadedChunks)
     {
-        if (desiredChunks.find(chunk) == desiredChunks.end())
+        if (desiredChunks.find(chunk) == desiredChunks.end() && !isWithinLoadRadius(chunk))
         {
             chunksToUnload.push_back(chunk);
         }
     }
 
-    int unloadedCount = 0;
     for (const auto &chunk : chunksToUnload)
     {
         unloadChunk(chunk);
-        unloadedCount++;
     }
 
-    // Load new chunks
-    int loadedCount = 0;
-    for (const auto &chunk : desiredChunks)
+    cancelStaleChunkWork(desiredChunks);
+
+    // Queue new chunks; the heap hands them out soonest needed first
+    for (const auto &[chunk, priority] : desiredChunks)
     {
-        if (mLoadedChunks.find(chunk) == mLoadedChunks.end())
-        {
-            loadChunk(chunk);
-            loadedCount++;
-        }
+        loadChunk(chunk, priority);
     }
+
+    dispatchChunkRequests();
 }
 
-void World::loadChunk(const ChunkCoord &coord) noexcept
+void World::loadChunk(const ChunkCoord &coord, int priority) noexcept
 {
-    // Don't submit if already loaded or pending
-    if (mLoadedChunks.find(coord) != mLoadedChunks.end())
+    // Don't queue if already loaded, queued or pending
+    if (mLoadedChunks.find(coord) != mLoadedChunks.end() ||
+        mQueuedChunks.find(coord) != mQueuedChunks.end() ||
+        mIntegratingChunks.find(coord) != mIntegratingChunks.end())
     {
         return;
     }
 
-    // Check if already pending
     {
         std::lock_guard<std::mutex> lock(mCompletedChunksMutex);
-        for (const auto &[pendingCoord, _] : mPendingChunks)
+        if (mPendingChunks.find(coord) != mPendingChunks.end())
         {
-            if (pendingCoord == coord)
-            {
-                return; // Already pending generation
-            }
+            return;
         }
     }
 
-    // Submit chunk for async generation
-    submitChunkForGeneration(coord);
+    mQueuedChunks.insert(coord);
+    mChunkRequestQueue.push_back(ChunkRequest{coord, priority});
+    std::push_heap(mChunkRequestQueue.begin(), mChunkRequestQueue.end(), ChunkRequestCompare{});
 }
 
 void World::unloadChunk(const ChunkCoord &coord) noexcept
 {
-    auto it = mChunkSphereIndices.find(coord);
-    if (it == mChunkSphereIndices.end())
-    {
-        return;
-    }
-
-    // Get indices to remove
-    std::vector<size_t> indicesToRemove = it->second;
-
-    // CRITICAL FIX: Track which indices get remapped during swap-and-pop
-    std::unordered_map<size_t, size_t> indexRemapping;
-
-    // Sort in reverse to remove from back to front
-    std::sort(indicesToRemove.rbegin(), indicesToRemove.rend());
-
-    size_t removedCount = 0;
-
-    for (size_t idx : indicesToRemove)
-    {
-        if (idx >= mSpheres.size() || idx >= mSphereBodyIds.size())
-        {
-            continue;
-        }
-
-        ++removedCount;
-
-        // Destroy physics body if valid
-        b2BodyId bodyId = mSphereBodyIds[idx];
-        if (b2Body_IsValid(bodyId))
-        {
-            b2DestroyBody(bodyId);
-        }
+    auto it = mChunkSphereHandles.find(coord);
+    if (it == mChunkSphereHandles.end())
+    {
+        return;
+    }
 
-        // Swap with last element
-        size_t lastIdx = mSpheres.size() - 1;
-        if (idx < lastIdx)
+    for (const SlotHandle &handle : it->second)
+    {
+        if (!mSpheres.contains(handle))
         {
-            // Remember that the element at lastIdx is now at idx
-            indexRemapping[lastIdx] = idx;
-
-            mSpheres[idx] = mSpheres[lastIdx];
-            mSphereBodyIds[idx] = mSphereBodyIds[lastIdx];
-
-            if (b2Body_IsValid(mSphereBodyIds[idx]))
-            {
-                const std::uintptr_t prevTag = reinterpret_cast<std::uintptr_t>(b2Body_GetUserData(mSphereBodyIds[idx]));
-                if (prevTag != kBodyTagMazeWall)
-                {
-                    b2Body_SetUserData(mSphereBodyIds[idx], reinterpret_cast<void *>(kBodyTagSphereBase + idx));
-                }
-            }
+            continue;
         }
 
-        // Remove last element
-        mSpheres.pop_back();
-        mSphereBodyIds.pop_back();
+        mSpheres.erase(handle);
     }
 
-    // Update ALL chunk indices based on remapping
-    for (auto &[chunkCoord, indices] : mChunkSphereIndices)
+    // A single destroy releases every remaining wall shape of the chunk
+    if (auto bodyIt = mChunkBodies.find(coord); bodyIt != mChunkBodies.end())
     {
-        if (chunkCoord == coord)
+        mBodyToChunk.erase(b2StoreBodyId(bodyIt->second));
+        if (b2Body_IsValid(bodyIt->second))
         {
-            continue;
+            b2DestroyBody(bodyIt->second);
         }
+        mChunkBodies.erase(bodyIt);
+    }
 
-        for (size_t &sphereIdx : indices)
+    if (auto pickupIt = mChunkPickupHandles.find(coord); pickupIt != mChunkPickupHandles.end())
+    {
+        for (const SlotHandle &handle : pickupIt->second)
         {
-            // If this index was remapped, update it
-            auto remapIt = indexRemapping.find(sphereIdx);
-            if (remapIt != indexRemapping.end())
+            const std::size_t dense = mPickups.denseIndex(handle);
+            if (dense == decltype(mPickups)::NPOS)
             {
-                sphereIdx = remapIt->second;
+                continue;
             }
+
+            const glm::vec3 &position = mPickups.column<0>()[dense].position;
+            mPickupGrid.remove(glm::vec2(position.x, position.z), handle);
+            mPickups.erase(handle);
         }
+        mChunkPickupHandles.erase(pickupIt);
+        markPickupsChanged();
+    }
+
+    if (mRenderInitialized)
+    {
+        std::lock_guard<std::mutex> lock(mChunkGeometryMutex);
+        mChunkGeometryUpdates.push_back({coord, nullptr, true});
     }
 
     // Remove this chunk's entry
-    mChunkSphereIndices.erase(it);
+    mChunkSphereHandles.erase(it);
+    mChunkSphereWalls.erase(coord);
     mLoadedChunks.erase(coord);
-    mPersistentSphereCount = (removedCount >= mPersistentSphereCount) ? 0 : (mPersistentSphereCount - removedCount);
 }
 
-std::string World::generateMazeForChunk(const ChunkCoord &coord) const noexcept
+World::ChunkMazeGrid World::generateMazeForChunk(const ChunkCoord &coord) const noexcept
 {
     try
     {
         // Thread-safe cache access
         {
             std::lock_guard<std::mutex> lock(mMazeCacheMutex);
-            auto it = mChunkMazes.find(coord);
-            if (it != mChunkMazes.end())
+            if (auto cached = mChunkMazes.get(coord))
             {
-                return it->second;
+                return *cached;
             }
         }
 
         std::size_t baseSeed = 0x9E3779B97F4A7C15ull;
-        std::string levelData;
         try
         {
-            levelData = mLevels.get(Levels::ID::LEVEL_ONE).getData();
-            if (!levelData.empty())
+            // Hashed once at load, not per chunk; equal to std::hash of the data string
+            const Level &level = mLevels.get(Levels::ID::LEVEL_ONE);
+            if (!level.getData().empty())
             {
-                baseSeed ^= std::hash<std::string>{}(levelData);
+                baseSeed ^= level.getDataHash();
             }
         }
         catch (const std::exception &)
         {
-            // Fall back to generated maze text when level resources are unavailable.
+            // Fall back to the base seed when level resources are unavailable.
         }
 
         const std::size_t chunkHash =
@@ -1883,232 +4076,117 @@ std::string World::generateMazeForChunk(const ChunkCoord &coord) const noexcept
             (static_cast<std::size_t>(coord.z) * 19349663u);
         const unsigned int seed = static_cast<unsigned int>(baseSeed ^ chunkHash);
 
-        auto mazeStr = (coord.x == 0 && coord.z == 0 && !levelData.empty())
-            ? levelData
-            : mazes::create(
-                  mazes::configurator()
-                      .rows(MAZE_ROWS)
-                      .columns(MAZE_COLS)
-                      .distances(false)
-                      .seed(seed));
+        // Carve straight into a MazeBuilder grid and read the links back as wall bits
+        auto mazeGrid = std::make_unique<mazes::colored_grid>(
+            static_cast<unsigned int>(MAZE_ROWS), static_cast<unsigned int>(MAZE_COLS), 1u);
+        mazes::randomizer rng{};
+        rng.seed(seed);
+        mazes::dfs dfsAlgo{};
+        dfsAlgo.run(mazeGrid.get(), rng);
+
+        ChunkMazeGrid grid;
+        auto &&gridOps = mazeGrid->operations();
+        for (int idx = 0; idx < MAZE_ROWS * MAZE_COLS; ++idx)
+        {
+            const auto cellPtr = gridOps.search(idx);
+            if (!cellPtr)
+            {
+                continue;
+            }
+
+            const auto northCell = gridOps.get_north(cellPtr);
+            const auto southCell = gridOps.get_south(cellPtr);
+            const auto eastCell = gridOps.get_east(cellPtr);
+            const auto westCell = gridOps.get_west(cellPtr);
+
+            std::uint8_t walls = 0;
+            if (!northCell || !cellPtr->is_linked(northCell))
+                walls |= ChunkMazeGrid::WALL_NORTH;
+            if (!southCell || !cellPtr->is_linked(southCell))
+                walls |= ChunkMazeGrid::WALL_SOUTH;
+            if (!eastCell || !cellPtr->is_linked(eastCell))
+                walls |= ChunkMazeGrid::WALL_EAST;
+            if (!westCell || !cellPtr->is_linked(westCell))
+                walls |= ChunkMazeGrid::WALL_WEST;
+
+            grid.walls[static_cast<std::size_t>(idx)] = walls;
+        }
+        grid.valid = true;
 
         // Cache the result (thread-safe)
         {
             std::lock_guard<std::mutex> lock(mMazeCacheMutex);
-            mChunkMazes[coord] = mazeStr;
+            mChunkMazes.put(coord, grid);
         }
 
-        return mazeStr;
+        return grid;
     }
     catch (const std::exception &e)
     {
         SDL_LogError(SDL_LOG_CATEGORY_ERROR, "World: Failed to generate maze: %s", e.what());
-        return "";
+        return ChunkMazeGrid{};
     }
 }
 
-std::vector<World::MazeCell> World::parseMazeCells(const std::string &mazeStr, const ChunkCoord &coord,
-                                                   glm::vec3 &outSpawnPosition, bool &outHasSpawn) const noexcept
+void World::findChunkSpawn(const ChunkCoord &coord, glm::vec3 &outSpawnPosition, bool &outHasSpawn) const noexcept
 {
-    std::vector<MazeCell> cells;
     outHasSpawn = false;
 
-    if (mazeStr.empty())
-    {
-        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "World: Empty maze string for chunk (%d, %d)", coord.x, coord.z);
-        return cells;
-    }
-
-    float chunkWorldX = coord.x * CHUNK_SIZE;
-    float chunkWorldZ = coord.z * CHUNK_SIZE;
-
-    const int cellCount = MAZE_ROWS * MAZE_COLS;
-    std::vector<bool> visited(static_cast<std::size_t>(cellCount), false);
-    std::vector<bool> wallNorth(static_cast<std::size_t>(cellCount), true);
-    std::vector<bool> wallSouth(static_cast<std::size_t>(cellCount), true);
-    std::vector<bool> wallEast(static_cast<std::size_t>(cellCount), true);
-    std::vector<bool> wallWest(static_cast<std::size_t>(cellCount), true);
-
-    auto cellIndex = [](int row, int col) noexcept
-    {
-        return row * MAZE_COLS + col;
-    };
-
-    const std::size_t coordHash =
-        (static_cast<std::size_t>(coord.x) * 73856093u) ^
-        (static_cast<std::size_t>(coord.z) * 19349663u);
-    const std::size_t mazeHash = std::hash<std::string>{}(mazeStr);
-    std::mt19937 rng(static_cast<uint32_t>(mazeHash ^ coordHash));
-
-    std::vector<int> stack;
-    stack.reserve(static_cast<std::size_t>(cellCount));
-    const int start = static_cast<int>((mazeHash ^ coordHash) % static_cast<std::size_t>(cellCount));
-    stack.push_back(start);
-    visited[static_cast<std::size_t>(start)] = true;
-
-    while (!stack.empty())
+    // Only the origin chunk carries the player spawn, at its center cell
+    if (coord.x == 0 && coord.z == 0)
     {
-        const int current = stack.back();
-        const int row = current / MAZE_COLS;
-        const int col = current % MAZE_COLS;
-
-        std::array<int, 4> dirs{-1, -1, -1, -1};
-        int count = 0;
-
-        if (row > 0)
-        {
-            const int idx = cellIndex(row - 1, col);
-            if (!visited[static_cast<std::size_t>(idx)])
-            {
-                dirs[count++] = 0; // north
-            }
-        }
-        if (row < MAZE_ROWS - 1)
-        {
-            const int idx = cellIndex(row + 1, col);
-            if (!visited[static_cast<std::size_t>(idx)])
-            {
-                dirs[count++] = 1; // south
-            }
-        }
-        if (col < MAZE_COLS - 1)
-        {
-            const int idx = cellIndex(row, col + 1);
-            if (!visited[static_cast<std::size_t>(idx)])
-            {
-                dirs[count++] = 2; // east
-            }
-        }
-        if (col > 0)
-        {
-            const int idx = cellIndex(row, col - 1);
-            if (!visited[static_cast<std::size_t>(idx)])
-            {
-                dirs[count++] = 3; // west
-            }
-        }
-
-        if (count == 0)
-        {
-            stack.pop_back();
-            continue;
-        }
-
-        std::uniform_int_distribution<int> pick(0, count - 1);
-        const int dir = dirs[pick(rng)];
-
-        int nextRow = row;
-        int nextCol = col;
-        if (dir == 0)
-        {
-            nextRow -= 1;
-        }
-        else if (dir == 1)
-        {
-            nextRow += 1;
-        }
-        else if (dir == 2)
-        {
-            nextCol += 1;
-        }
-        else
-        {
-            nextCol -= 1;
-        }
-
-        const int next = cellIndex(nextRow, nextCol);
-        if (dir == 0)
-        {
-            wallNorth[static_cast<std::size_t>(current)] = false;
-            wallSouth[static_cast<std::size_t>(next)] = false;
-        }
-        else if (dir == 1)
-        {
-            wallSouth[static_cast<std::size_t>(current)] = false;
-            wallNorth[static_cast<std::size_t>(next)] = false;
-        }
-        else if (dir == 2)
-        {
-            wallEast[static_cast<std::size_t>(current)] = false;
-            wallWest[static_cast<std::size_t>(next)] = false;
-        }
-        else
-        {
-            wallWest[static_cast<std::size_t>(current)] = false;
-            wallEast[static_cast<std::size_t>(next)] = false;
-        }
-
-        visited[static_cast<std::size_t>(next)] = true;
-        stack.push_back(next);
+        const glm::vec2 center = cellWorldCenter(coord, MAZE_ROWS / 2, MAZE_COLS / 2);
+        outSpawnPosition = glm::vec3(center.x, 10.0f, center.y);
+        outHasSpawn = true;
     }
+}
 
-    for (int row = 0; row < MAZE_ROWS; ++row)
-    {
-        for (int col = 0; col < MAZE_COLS; ++col)
-        {
-            int centerRow = MAZE_ROWS / 2;
-            int centerCol = MAZE_COLS / 2;
-            int distance = std::abs(row - centerRow) + std::abs(col - centerCol);
-            const int idx = cellIndex(row, col);
-
-            float worldX = chunkWorldX + (col * CELL_SIZE) + (CELL_SIZE * 0.5f);
-            float worldZ = chunkWorldZ + (row * CELL_SIZE) + (CELL_SIZE * 0.5f);
-
-            cells.push_back(MazeCell{row, col, distance, worldX, worldZ,
-                                     wallNorth[static_cast<std::size_t>(idx)],
-                                     wallSouth[static_cast<std::size_t>(idx)],
-                                     wallEast[static_cast<std::size_t>(idx)],
-                                     wallWest[static_cast<std::size_t>(idx)]});
+glm::vec2 World::cellWorldCenter(const ChunkCoord &coord, int row, int col) noexcept
+{
+    return glm::vec2(
+        coord.x * CHUNK_SIZE + (col * CELL_SIZE) + (CELL_SIZE * 0.5f),
+        coord.z * CHUNK_SIZE + (row * CELL_SIZE) + (CELL_SIZE * 0.5f));
+}
 
-            // Track spawn in work item instead of const_cast
-            if (row == centerRow && col == centerCol && coord.x == 0 && coord.z == 0)
-            {
-                outSpawnPosition = glm::vec3(worldX, 10.0f, worldZ);
-                outHasSpawn = true;
-            }
-        }
-    }
+glm::vec2 World::toRunnerArc(float x, float z) noexcept
+{
+    const float forwardArc = x + 60.0f;
+    const float centeredZ = z - (CHUNK_SIZE * 0.5f);
+    const float lateralScale = (2.0f * std::max(8.0f, 35.0f)) / CHUNK_SIZE;
+    return glm::vec2(forwardArc, centeredZ * lateralScale);
+}
 
-    return cells;
+int World::cellDistanceFromCenter(int row, int col) noexcept
+{
+    return std::abs(row - MAZE_ROWS / 2) + std::abs(col - MAZE_COLS / 2);
 }
 
-void World::buildMazeWallSpheres(const std::vector<MazeCell> &cells, std::vector<Sphere> &outSpheres) const noexcept
+void World::buildMazeWallSpheres(const ChunkMazeGrid &grid, const ChunkCoord &coord, std::vector<Sphere> &outSpheres) const noexcept
 {
     using MaterialType = Material::MaterialType;
 
-    if (cells.empty())
+    if (!grid.valid)
     {
         return;
     }
 
-    constexpr std::size_t kMaxMazeWallSpheres = 260;
     constexpr float kWallRadius = 1.45f;
-    constexpr float kWallSpacing = 2.2f;
 
     auto appendSegment = [&](float x0, float z0, float x1, float z1, const glm::vec3 &baseColor,
                              Material::MaterialType matType = MaterialType::LAMBERTIAN,
                              float fuzz = 0.0f, float ior = 1.5f)
     {
-        auto toRunnerArc = [this](float x, float z) noexcept -> glm::vec2
-        {
-            const float forwardArc = x + 60.0f;
-            const float centeredZ = z - (CHUNK_SIZE * 0.5f);
-            const float lateralScale = (2.0f * std::max(8.0f, 35.0f)) / CHUNK_SIZE;
-            const float lateralArc = centeredZ * lateralScale;
-            return glm::vec2(forwardArc, lateralArc);
-        };
-
         const glm::vec2 arc0 = toRunnerArc(x0, z0);
         const glm::vec2 arc1 = toRunnerArc(x1, z1);
 
         const float dx = arc1.x - arc0.x;
         const float dz = arc1.y - arc0.y;
         const float length = std::sqrt(dx * dx + dz * dz);
-        const int steps = std::max(1, static_cast<int>(std::ceil(length / kWallSpacing)));
+        const int steps = std::max(1, static_cast<int>(std::ceil(length / kChunkWallSphereSpacing)));
 
         for (int step = 0; step <= steps; ++step)
         {
-            if (outSpheres.size() >= kMaxMazeWallSpheres)
+            if (outSpheres.size() >= CHUNK_WALL_SPHERE_CAPACITY)
             {
                 return;
             }
@@ -2127,50 +4205,132 @@ void World::buildMazeWallSpheres(const std::vector<MazeCell> &cells, std::vector
         }
     };
 
-    for (const MazeCell &cell : cells)
+    const float halfCell = CELL_SIZE * 0.5f;
+
+    for (int row = 0; row < MAZE_ROWS; ++row)
     {
-        if (outSpheres.size() >= kMaxMazeWallSpheres)
+        for (int col = 0; col < MAZE_COLS; ++col)
         {
-            break;
-        }
+            if (outSpheres.size() >= CHUNK_WALL_SPHERE_CAPACITY)
+            {
+                return;
+            }
 
-        const float halfCell = CELL_SIZE * 0.5f;
-        const bool checkerCell = ((cell.row + cell.col) % 2 == 0);
-        const glm::vec3 wallColor = checkerCell
-            ? glm::vec3(0.14f, 0.16f, 0.20f)
-            : glm::vec3(0.23f, 0.25f, 0.30f);
+            const glm::vec2 center = cellWorldCenter(coord, row, col);
+            const bool checkerCell = ((row + col) % 2 == 0);
+            const glm::vec3 wallColor = checkerCell
+                ? glm::vec3(0.14f, 0.16f, 0.20f)
+                : glm::vec3(0.23f, 0.25f, 0.30f);
 
-        // Assign material type based on distance for reflection/refraction
-        const Material::MaterialType matType = getMaterialForDistance(cell.distance);
-        const float fuzz = (matType == Material::MaterialType::METAL) ? 0.1f : 0.0f;
-        const float ior = (matType == Material::MaterialType::DIELECTRIC) ? 1.52f : 1.5f;
+            // Assign material type based on distance for reflection/refraction
+            const Material::MaterialType matType = getMaterialForDistance(cellDistanceFromCenter(row, col));
+            const float fuzz = (matType == Material::MaterialType::METAL) ? 0.1f : 0.0f;
+            const float ior = (matType == Material::MaterialType::DIELECTRIC) ? 1.52f : 1.5f;
 
-        if (cell.wallNorth)
-        {
-            appendSegment(cell.worldX - halfCell, cell.worldZ - halfCell,
-                          cell.worldX + halfCell, cell.worldZ - halfCell,
-                          wallColor, matType, fuzz, ior);
+            if (grid.hasWall(row, col, ChunkMazeGrid::WALL_NORTH))
+            {
+                appendSegment(center.x - halfCell, center.y - halfCell,
+                              center.x + halfCell, center.y - halfCell,
+                              wallColor, matType, fuzz, ior);
+            }
+
+            if (grid.hasWall(row, col, ChunkMazeGrid::WALL_WEST))
+            {
+                appendSegment(center.x - halfCell, center.y - halfCell,
+                              center.x - halfCell, center.y + halfCell,
+                              wallColor, matType, fuzz, ior);
+            }
+
+            if (col == (MAZE_COLS - 1) && grid.hasWall(row, col, ChunkMazeGrid::WALL_EAST))
+            {
+                appendSegment(center.x + halfCell, center.y - halfCell,
+                              center.x + halfCell, center.y + halfCell,
+                              wallColor, matType, fuzz, ior);
+            }
+
+            if (row == (MAZE_ROWS - 1) && grid.hasWall(row, col, ChunkMazeGrid::WALL_SOUTH))
+            {
+                appendSegment(center.x - halfCell, center.y + halfCell,
+                              center.x + halfCell, center.y + halfCell,
+                              wallColor, matType, fuzz, ior);
+            }
         }
+    }
+}
+
+void World::buildChunkWallInstances(const ChunkMazeGrid &grid, const ChunkCoord &coord,
+                                    std::vector<MazeWallInstance> &outInstances,
+                                    std::vector<std::int16_t> &outSphereWalls) noexcept
+{
+    outInstances.clear();
+    outSphereWalls.clear();
+    if (!grid.valid)
+    {
+        return;
+    }
+    outInstances.reserve(CHUNK_WALL_INSTANCE_CAPACITY);
 
-        if (cell.wallWest)
+    // Leave the hand-built raster maze (centered on the origin) to its own geometry
+    const float staticHalfWidth = 0.5f * static_cast<float>(kSimpleMazeCols) * kSimpleCellSize + kSimpleCellSize;
+    const float staticHalfDepth = 0.5f * static_cast<float>(kSimpleMazeRows) * kSimpleCellSize + kSimpleCellSize;
+    const float wallY = kSimpleFloorY + 0.5f * kSimpleWallHeight;
+
+    auto appendWall = [&](float x0, float z0, float x1, float z1, const glm::vec3 &color)
+    {
+        const glm::vec2 arc0 = toRunnerArc(x0, z0);
+        const glm::vec2 arc1 = toRunnerArc(x1, z1);
+        const glm::vec2 center = 0.5f * (arc0 + arc1);
+        const glm::vec2 extent = glm::abs(arc1 - arc0);
+        const bool boxed = std::abs(center.x) >= staticHalfWidth || std::abs(center.y) >= staticHalfDepth;
+
+        // Walks the segments in buildMazeWallSpheres' order and spacing, so sphere i lines wall outSphereWalls[i]
+        const float dx = arc1.x - arc0.x;
+        const float dz = arc1.y - arc0.y;
+        const int steps = std::max(1, static_cast<int>(std::ceil(std::sqrt(dx * dx + dz * dz) / kChunkWallSphereSpacing)));
+        const auto wall = boxed ? static_cast<std::int16_t>(outInstances.size()) : std::int16_t{-1};
+        for (int step = 0; step <= steps && outSphereWalls.size() < CHUNK_WALL_SPHERE_CAPACITY; ++step)
         {
-            appendSegment(cell.worldX - halfCell, cell.worldZ - halfCell,
-                          cell.worldX - halfCell, cell.worldZ + halfCell,
-                          wallColor, matType, fuzz, ior);
+            outSphereWalls.push_back(wall);
         }
 
-        if (cell.col == (MAZE_COLS - 1) && cell.wallEast)
+        if (!boxed)
         {
-            appendSegment(cell.worldX + halfCell, cell.worldZ - halfCell,
-                          cell.worldX + halfCell, cell.worldZ + halfCell,
-                          wallColor, matType, fuzz, ior);
+            return;
         }
 
-        if (cell.row == (MAZE_ROWS - 1) && cell.wallSouth)
+        // Segments are axis aligned; thicken the degenerate axis and overlap the corners
+        const glm::vec3 size(std::max(extent.x, kSimpleWallThickness) + kSimpleWallThickness,
+                             kSimpleWallHeight,
+                             std::max(extent.y, kSimpleWallThickness) + kSimpleWallThickness);
+        outInstances.push_back({glm::vec4(center.x, wallY, center.y, 0.0f), size, packUnorm8(color)});
+    };
+
+    const float halfCell = CELL_SIZE * 0.5f;
+    for (int row = 0; row < MAZE_ROWS; ++row)
+    {
+        for (int col = 0; col < MAZE_COLS; ++col)
         {
-            appendSegment(cell.worldX - halfCell, cell.worldZ + halfCell,
-                          cell.worldX + halfCell, cell.worldZ + halfCell,
-                          wallColor, matType, fuzz, ior);
+            const glm::vec2 center = cellWorldCenter(coord, row, col);
+            const glm::vec3 wallColor = ((row + col) % 2 == 0)
+                ? glm::vec3(0.14f, 0.16f, 0.20f)
+                : glm::vec3(0.23f, 0.25f, 0.30f);
+
+            if (grid.hasWall(row, col, ChunkMazeGrid::WALL_NORTH))
+            {
+                appendWall(center.x - halfCell, center.y - halfCell, center.x + halfCell, center.y - halfCell, wallColor);
+            }
+            if (grid.hasWall(row, col, ChunkMazeGrid::WALL_WEST))
+            {
+                appendWall(center.x - halfCell, center.y - halfCell, center.x - halfCell, center.y + halfCell, wallColor);
+            }
+            if (col == (MAZE_COLS - 1) && grid.hasWall(row, col, ChunkMazeGrid::WALL_EAST))
+            {
+                appendWall(center.x + halfCell, center.y - halfCell, center.x + halfCell, center.y + halfCell, wallColor);
+            }
+            if (row == (MAZE_ROWS - 1) && grid.hasWall(row, col, ChunkMazeGrid::WALL_SOUTH))
+            {
+                appendWall(center.x - halfCell, center.y + halfCell, center.x + halfCell, center.y + halfCell, wallColor);
+            }
         }
     }
 }
@@ -2224,6 +4384,37 @@ glm::vec3 World::projectOntoSphere(glm::vec2 flatPos) const noexcept
     return glm::vec3(x, y, z);
 }
 
+void World::projectOntoSphere(std::span<const float> arcX, std::span<const float> arcZ,
+                              std::span<const float> radii, std::span<glm::vec3> out) const noexcept
+{
+    // arcX = theta * radius (arc length around planet), arcZ = lateral arc offset.
+    // Straight-line body over raw pointers so the compiler can vectorise it (and sincos with libmvec).
+    const std::size_t count = out.size();
+    const float invRadius = 1.0f / mPlanetRadius;
+    const float *xs = arcX.data();
+    const float *zs = arcZ.data();
+    const float *rs = radii.data();
+    glm::vec3 *dst = out.data();
+    const glm::vec3 center = mPlanetCenter;
+    const float planetRadius = mPlanetRadius;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const float theta = xs[i] * invRadius;
+        const float phi = zs[i] * invRadius;
+        const float r = planetRadius + rs[i];
+
+        const float cosPhi = std::cos(phi);
+        const float sinPhi = std::sin(phi);
+        const float cosTheta = std::cos(theta);
+        const float sinTheta = std::sin(theta);
+
+        dst[i] = center + glm::vec3(r * cosPhi * cosTheta,
+                                    r * sinPhi,
+                                    r * cosPhi * sinTheta);
+    }
+}
+
 glm::vec2 World::projectFromSphere(const glm::vec3 &spherePos) const noexcept
 {
     // Extract angle from sphere position
@@ -2235,8 +4426,13 @@ glm::vec2 World::projectFromSphere(const glm::vec3 &spherePos) const noexcept
     return glm::vec2(arcLength, spherePos.z);
 }
 
-void World::buildPickupSpheres(const std::vector<MazeCell> &cells, std::vector<PickupSphere> &outPickups, const ChunkCoord &coord) const noexcept
+void World::buildPickupSpheres(const ChunkMazeGrid &grid, std::vector<PickupSphere> &outPickups, const ChunkCoord &coord) const noexcept
 {
+    if (!grid.valid)
+    {
+        return;
+    }
+
     // Seed RNG deterministically per chunk
     const std::size_t coordHash =
         (static_cast<std::size_t>(coord.x) * 73856093u) ^
@@ -2244,53 +4440,263 @@ void World::buildPickupSpheres(const std::vector<MazeCell> &cells, std::vector<P
     std::mt19937 rng(static_cast<uint32_t>(coordHash ^ 0xDEADBEEFu));
     std::uniform_int_distribution<int> valueDist(-25, 40);
 
-    for (const MazeCell &cell : cells)
+    for (int row = 0; row < MAZE_ROWS; ++row)
     {
-        // Use the distance map: cells with distance divisible by 5 get a pickup sphere
-        if (cell.distance > 0 && cell.distance % 5 == 0)
+        for (int col = 0; col < MAZE_COLS; ++col)
         {
-            // Use the sphere center position as the pickup location
-            // Convert from maze 2D coordinates to world position
-            float toRunnerArcX = cell.worldX + 60.0f;
-            float centeredZ = cell.worldZ - (CHUNK_SIZE * 0.5f);
-            float lateralScale = (2.0f * std::max(8.0f, 35.0f)) / CHUNK_SIZE;
-            float lateralArc = centeredZ * lateralScale;
-
-            PickupSphere pickup;
-            pickup.position = glm::vec3(toRunnerArcX, 1.5f, lateralArc);
-            pickup.value = valueDist(rng);
-            pickup.collected = false;
-            outPickups.push_back(pickup);
+            // Use the distance map: cells with distance divisible by 5 get a pickup sphere
+            const int distance = cellDistanceFromCenter(row, col);
+            if (distance > 0 && distance % 5 == 0)
+            {
+                // Convert from maze 2D coordinates to world position
+                const glm::vec2 center = cellWorldCenter(coord, row, col);
+                const glm::vec2 arc = toRunnerArc(center.x, center.y);
+
+                PickupSphere pickup;
+                pickup.position = glm::vec3(arc.x, 1.5f, arc.y);
+                pickup.value = valueDist(rng);
+                pickup.collected = false;
+                outPickups.push_back(pickup);
+            }
         }
     }
 }
 
 int World::collectNearbyPickups(const glm::vec3 &playerPos, float collectRadius) noexcept
 {
+    if (forwardsToSimulation())
+    {
+        // Collected on the simulation thread; report what earlier queries picked up
+        postSimulationCommand([this, playerPos, collectRadius]()
+                              {
+                                  const PickupQuery query{playerPos, collectRadius};
+                                  int points = 0;
+                                  collectNearbyPickups(std::span<const PickupQuery>(&query, 1), std::span<int>(&points, 1));
+                                  mScore += points;
+                                  mSimCollectedPoints.fetch_add(points, std::memory_order_relaxed);
+                              });
+        return mSimCollectedPoints.exchange(0, std::memory_order_relaxed);
+    }
+
+    const PickupQuery query{playerPos, collectRadius};
     int totalPoints = 0;
-    const float radiusSq = collectRadius * collectRadius;
+    collectNearbyPickups(std::span<const PickupQuery>(&query, 1), std::span<int>(&totalPoints, 1));
+    mScore += totalPoints;
+    return totalPoints;
+}
+
+void World::collectNearbyPickups(std::span<const PickupQuery> queries, std::span<int> outPoints) noexcept
+{
+    if (forwardsToSimulation())
+    {
+        runOnSimulation([this, queries, outPoints]()
+                        { collectNearbyPickups(queries, outPoints); });
+        return;
+    }
+
+    mCollectedPickupScratch.clear();
+    auto &pickups = mPickups.column<0>();
+
+    for (std::size_t i = 0; i < queries.size(); ++i)
+    {
+        int points = 0;
+        const glm::vec3 &center = queries[i].position;
+
+        mPickupGrid.queryRadius(glm::vec2(center.x, center.z), queries[i].radius,
+                                [&](const SlotHandle &handle, const glm::vec2 &)
+                                {
+                                    PickupSphere &pickup = pickups[mPickups.denseIndex(handle)];
+                                    if (pickup.collected)
+                                    {
+                                        return;
+                                    }
+
+                                    // The grid is planar; keep the old spherical test along Y
+                                    const glm::vec3 diff = pickup.position - center;
+                                    if (glm::dot(diff, diff) >= queries[i].radius * queries[i].radius)
+                                    {
+                                        return;
+                                    }
+
+                                    pickup.collected = true;
+                                    points += pickup.value;
+                                    mCollectedPickupScratch.push_back(handle);
+                                });
+
+        if (i < outPoints.size())
+        {
+            outPoints[i] = points;
+        }
+    }
+
+    if (mCollectedPickupScratch.empty())
+    {
+        return;
+    }
+
+    // Collected pickups leave the index and the dense array; the chunk's handle list just goes stale
+    for (const SlotHandle &handle : mCollectedPickupScratch)
+    {
+        const PickupSphere &pickup = pickups[mPickups.denseIndex(handle)];
+        const glm::vec3 &position = pickup.position;
+        if (mMatchHistoryEnabled)
+        {
+            mRemovedPickups.push_back({getChunkCoord(position), pickup});
+        }
+        mPickupGrid.remove(glm::vec2(position.x, position.z), handle);
+        mPickups.erase(handle);
+    }
+    mCollectedPickupScratch.clear();
+    markPickupsChanged();
+}
+
+void World::setMatchHistoryEnabled(bool enabled) noexcept
+{
+    if (forwardsToSimulation())
+    {
+        postSimulationCommand([this, enabled]()
+                              { setMatchHistoryEnabled(enabled); });
+        return;
+    }
+
+    mMatchHistoryEnabled = enabled;
+    if (!enabled)
+    {
+        mRemovedWallBase += mRemovedWalls.size();
+        mRemovedWalls.clear();
+        mRemovedPickupBase += mRemovedPickups.size();
+        mRemovedPickups.clear();
+    }
+}
+
+World::MatchSnapshot World::saveMatchSnapshot() noexcept
+{
+    MatchSnapshot snapshot;
+    if (forwardsToSimulation())
+    {
+        runOnSimulation([this, &snapshot]()
+                        { snapshot = saveMatchSnapshot(); });
+        return snapshot;
+    }
+
+    if (b2Body_IsValid(mPlayerBodyId))
+    {
+        const b2Vec2 position = b2Body_GetPosition(mPlayerBodyId);
+        const b2Vec2 velocity = b2Body_GetLinearVelocity(mPlayerBodyId);
+        snapshot.playerPosition = glm::vec2(position.x, position.y);
+        snapshot.playerVelocity = glm::vec2(velocity.x, velocity.y);
+    }
+    snapshot.score = mScore;
+    snapshot.pickupMark = mRemovedPickupBase + mRemovedPickups.size();
+    snapshot.wallMark = mRemovedWallBase + mRemovedWalls.size();
+    return snapshot;
+}
+
+void World::restoreMatchSnapshot(const MatchSnapshot &snapshot) noexcept
+{
+    if (forwardsToSimulation())
+    {
+        postSimulationCommand([this, snapshot]()
+                              { restoreMatchSnapshot(snapshot); });
+        return;
+    }
+
+    if (b2Body_IsValid(mPlayerBodyId))
+    {
+        b2Body_SetTransform(mPlayerBodyId, {snapshot.playerPosition.x, snapshot.playerPosition.y}, b2Body_GetRotation(mPlayerBodyId));
+        b2Body_SetLinearVelocity(mPlayerBodyId, {snapshot.playerVelocity.x, snapshot.playerVelocity.y});
+    }
+    mScore = snapshot.score;
 
-    for (auto &pickup : mPickupSpheres)
+    // Newest first, the reverse of the order they went in
+    while (mRemovedWallBase + mRemovedWalls.size() > snapshot.wallMark && !mRemovedWalls.empty())
     {
-        if (pickup.collected)
+        const RemovedWall removed = mRemovedWalls.back();
+        mRemovedWalls.pop_back();
+
+        const auto body = mChunkBodies.find(removed.coord);
+        if (body == mChunkBodies.end() || !b2Body_IsValid(body->second))
+        {
             continue;
+        }
+        const b2ShapeId shapeId = b2CreateCircleShape(body->second, &mWallShapeDef, &removed.circle);
+        const SlotHandle handle = mSpheres.insert(removed.sphere.getCenter(), removed.sphere.getRadius(), shapeId,
+                                                  removed.sphere, removed.chunkIndex);
+        b2Shape_SetUserData(shapeId, wallShapeUserData(handle.index));
+        // Back in its old place, so the wall table still finds it with its siblings
+        auto &handles = mChunkSphereHandles[removed.coord];
+        if (removed.chunkIndex < handles.size())
+        {
+            handles[removed.chunkIndex] = handle;
+        }
+        else
+        {
+            handles.push_back(handle);
+        }
+        syncSphereHandles(std::span<const SlotHandle>(&handle, 1));
+        mStaticShadowsDirty.store(true, std::memory_order_release);
+
+        if (const auto walls = mChunkSphereWalls.find(removed.coord);
+            mRenderInitialized && walls != mChunkSphereWalls.end() && removed.chunkIndex < walls->second.size() &&
+            walls->second[removed.chunkIndex] >= 0)
+        {
+            std::lock_guard<std::mutex> lock(mChunkGeometryMutex);
+            mChunkGeometryUpdates.push_back({removed.coord, nullptr, false, walls->second[removed.chunkIndex], false});
+        }
+    }
 
-        const glm::vec3 diff = pickup.position - playerPos;
-        const float distSq = glm::dot(diff, diff);
+    bool pickupsRestored = false;
+    while (mRemovedPickupBase + mRemovedPickups.size() > snapshot.pickupMark && !mRemovedPickups.empty())
+    {
+        RemovedPickup removed = mRemovedPickups.back();
+        mRemovedPickups.pop_back();
 
-        if (distSq < radiusSq)
+        if (!mLoadedChunks.contains(removed.coord))
         {
-            pickup.collected = true;
-            totalPoints += pickup.value;
-            mScore += pickup.value;
+            continue;
         }
+        removed.pickup.collected = false;
+        const SlotHandle handle = mPickups.insert(removed.pickup);
+        mPickupGrid.insert(glm::vec2(removed.pickup.position.x, removed.pickup.position.z), handle);
+        mChunkPickupHandles[removed.coord].push_back(handle);
+        pickupsRestored = true;
     }
+    if (pickupsRestored)
+    {
+        markPickupsChanged();
+    }
+}
 
-    return totalPoints;
+void World::confirmMatchSnapshot(const MatchSnapshot &snapshot) noexcept
+{
+    if (forwardsToSimulation())
+    {
+        postSimulationCommand([this, snapshot]()
+                              { confirmMatchSnapshot(snapshot); });
+        return;
+    }
+
+    while (mRemovedWallBase < snapshot.wallMark && !mRemovedWalls.empty())
+    {
+        mRemovedWalls.pop_front();
+        ++mRemovedWallBase;
+    }
+    while (mRemovedPickupBase < snapshot.pickupMark && !mRemovedPickups.empty())
+    {
+        mRemovedPickups.pop_front();
+        ++mRemovedPickupBase;
+    }
 }
 
 void World::createPlayerBody(const glm::vec3 &position) noexcept
 {
+    if (forwardsToSimulation())
+    {
+        postSimulationCommand([this, position]()
+                              { createPlayerBody(position); });
+        return;
+    }
+
     if (!b2World_IsValid(mWorldId))
         return;
 
@@ -2322,6 +4728,13 @@ void World::createPlayerBody(const glm::vec3 &position) noexcept
 
 void World::applyPlayerJumpImpulse(float impulse) noexcept
 {
+    if (forwardsToSimulation())
+    {
+        postSimulationCommand([this, impulse]()
+                              { applyPlayerJumpImpulse(impulse); });
+        return;
+    }
+
     if (b2Body_IsValid(mPlayerBodyId))
     {
         // Apply upward impulse in 2D (mapped to forward in the game)
@@ -2332,6 +4745,11 @@ void World::applyPlayerJumpImpulse(float impulse) noexcept
 
 glm::vec2 World::getPlayerVelocity() const noexcept
 {
+    if (forwardsToSimulation())
+    {
+        return mSnapshots.front().playerVelocity;
+    }
+
     if (b2Body_IsValid(mPlayerBodyId))
     {
         b2Vec2 vel = b2Body_GetLinearVelocity(mPlayerBodyId);
@@ -5,32 +5,58 @@
 
 #include <SDL3/SDL_rect.h>
 
+#include <array>
+#include <deque>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
 #include <string>
 #include <future>
 #include <atomic>
-#include <queue>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
 #include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
 #include <glm/glm.hpp>
 
 #include "RenderWindow.hpp"
 #include "ResourceIdentifiers.hpp"
+#include "BillboardBatch.hpp"
+#include "ChunkDiskCache.hpp"
+#include "ChunkGeometryPool.hpp"
+#include "Frustum.hpp"
+#include "GLSDLHelper.hpp"
+#include "LRUCache.hpp"
 #include "Material.hpp"
+#include "MemoryStats.hpp"
+#include "OcclusionCuller.hpp"
+#include "ParticleSystem.hpp"
 #include "Animation.hpp"
 #include "Plane.hpp"
+#include "Shader.hpp"
+#include "SlotMap.hpp"
+#include "SpatialHashGrid.hpp"
+#include "Sphere.hpp"
+#include "TripleBuffer.hpp"
+#include "WallBroadphase.hpp"
 
 #include <glad/glad.h>
 
 class Camera;
 class FramebufferObject;
+class PhysicsTaskScheduler;
 class GLTFModel;
 class Player;
 class RenderWindow;
-class Shader;
 class Sphere;
 class Texture;
+class TextureAtlas;
 class VertexArrayObject;
 class VertexBufferObject;
 
@@ -40,6 +66,8 @@ class World final
 {
     // Allow Player to access World internals for animation rendering
     friend class Player;
+    // Microbenchmarks (BenchMain.cpp) drive the chunk pipeline stages one at a time
+    friend class WorldBench;
 
 public:
     // NOTE: World's primary responsibility is physics simulation/state.
@@ -53,12 +81,70 @@ public:
     void destroyWorld();
     void handleEvent(const SDL_Event &event);
 
-    const std::vector<Sphere> &getSpheres() const noexcept { return mSpheres; }
-    std::vector<Sphere> &getSpheres() noexcept { return mSpheres; }
+    /// @brief Packed wall spheres; order changes when walls are removed
+    const std::vector<Sphere> &getSpheres() const noexcept { return mSpheres.column<SPHERE_DATA>(); }
     const Plane &getGroundPlane() const noexcept { return mGroundPlane; }
-    void updateSphereChunks(const glm::vec3 &cameraPosition) noexcept;
+    /// @brief Stream maze chunks around a position, reaching ahead along its planar velocity
+    /// @details While the projected path stays in the current chunk, the full CHUNK_LOAD_RADIUS square
+    /// is requested. Once it leaves, only the ring next to the current chunk plus a corridor along the
+    /// path is, soonest reached first; chunks already resident inside the square stay until they leave it.
+    void updateSphereChunks(const glm::vec3 &cameraPosition, const glm::vec3 &velocity = glm::vec3(0.0f)) noexcept;
     glm::vec3 getMazeSpawnPosition() const noexcept { return mPlayerSpawnPosition; }
 
+    /// @brief Chunk grid cell (x, z) containing a world position; multiplayer interest is keyed on it
+    [[nodiscard]] static glm::ivec2 getChunkCell(const glm::vec3 &position) noexcept;
+
+    /// @brief Byte budget for cached chunk mazes; evicted chunks are regenerated on demand
+    void setMazeCacheBudget(std::size_t budgetBytes) noexcept;
+    [[nodiscard]] LRUCacheStats getMazeCacheStats() const noexcept;
+
+    /// @brief Load previously generated chunks from (and later save new ones to) a mapped file
+    /// @details Call after init() and before the first updateSphereChunks()
+    void enableChunkDiskCache(const std::string &path) noexcept;
+
+    /// @brief Main-thread time allowed per update for turning finished chunks into physics shapes
+    void setChunkIntegrationBudget(std::chrono::microseconds budget) noexcept;
+
+    /// @brief Seconds of travel the chunk streamer looks ahead; raise it when workers fall behind
+    /// @details The reach is capped at CHUNK_PREFETCH_MAX_CHUNKS either way
+    void setChunkPrefetchSeconds(float seconds) noexcept { mChunkPrefetchSeconds = seconds; }
+
+    /// How well chunk streaming keeps ahead of the player
+    struct ChunkStreamStats
+    {
+        std::uint32_t chunksEntered{0};
+        /// Chunks the player entered before they were integrated
+        std::uint32_t lateChunks{0};
+        /// Time from entering a late chunk to it arriving, in milliseconds
+        float lastLateMs{0.0f};
+        float worstLateMs{0.0f};
+    };
+
+    [[nodiscard]] ChunkStreamStats getChunkStreamStats() const noexcept;
+
+    /// Timings of the most recent b2World_Step, in milliseconds
+    struct PhysicsStats
+    {
+        int workerCount{1};
+        std::uint32_t tasksPerStep{0};
+        float stepMs{0.0f};
+        float collideMs{0.0f};
+        float solveMs{0.0f};
+    };
+
+    /// @brief Box2D worker count (including the stepping thread); 0 uses every JobSystem worker
+    /// @details Takes effect at the next init()
+    void setPhysicsWorkerCount(int workerCount) noexcept { mPhysicsWorkerCount = workerCount; }
+    [[nodiscard]] PhysicsStats getPhysicsStats() const noexcept;
+
+    /// @brief Run physics, chunk streaming and pickups on a dedicated thread
+    /// @details Call after init(). The calling thread keeps rendering and talks to the simulation
+    /// through queued commands; it reads player, score and pickup state from the newest published
+    /// SimulationSnapshot, so those values lag the simulation by up to one step.
+    void startSimulationThread();
+    void stopSimulationThread() noexcept;
+    [[nodiscard]] bool isSimulationThreaded() const noexcept { return mSimThreaded.load(std::memory_order_acquire); }
+
     // ========================================================================
     // Character rendering for third-person mode
     // ========================================================================
@@ -68,6 +154,18 @@ public:
     /// @param camera Camera for view/projection matrices
     void renderPlayerCharacter(const Player &player, const Camera &camera) const noexcept;
 
+    /// Another character drawn with the skinned model, e.g. a remote player or a bot
+    struct CharacterInstance
+    {
+        glm::vec3 position{0.0f};
+        float facingDegrees{0.0f};
+        float animationTimeSeconds{0.0f};
+    };
+
+    /// @brief Replace the characters drawn next to the local player in the skinned-model pass
+    /// @details All of them share one instanced draw per mesh; pass an empty span to stop drawing them
+    void setCharacterInstances(std::span<const CharacterInstance> characters);
+
     /// Render a textured billboard quad from a full texture
     /// @param position World position of billboard center
     /// @param halfSize Billboard half-size fallback used by shader path
@@ -87,15 +185,18 @@ public:
     /// Get the character sprite sheet texture (for external rendering)
     [[nodiscard]] const Texture *getCharacterSpriteSheet() const noexcept;
 
+    /// Billboards draw from the atlas page for any texture it packed; nullptr keeps per-texture binds
+    void setTextureAtlas(const TextureAtlas *atlas) noexcept { mTextureAtlas = atlas; }
+
     // ========================================================================
     // Scoring system
     // ========================================================================
 
     /// Get current player score
-    [[nodiscard]] int getScore() const noexcept { return mScore; }
+    [[nodiscard]] int getScore() const noexcept;
 
-    /// Add points to score (can be negative)
-    void addScore(int points) noexcept { mScore += points; }
+    /// Add points to score (can be negative); queued behind pending steps with a simulation thread
+    void addScore(int points) noexcept;
 
     /// Get pickup sphere positions and values for rendering score billboards
     struct PickupSphere
@@ -105,11 +206,72 @@ public:
         bool collected{false};
     };
 
-    [[nodiscard]] const std::vector<PickupSphere> &getPickupSpheres() const noexcept { return mPickupSpheres; }
+    /// Live (uncollected) pickups of all loaded chunks, densely packed
+    [[nodiscard]] const std::vector<PickupSphere> &getPickupSpheres() const noexcept;
 
-    /// Check and collect pickups near a position, returns points gained
+    /// Immutable view of simulation state handed from the simulation thread to the render thread
+    struct SimulationSnapshot
+    {
+        std::uint64_t tick{0};
+        int score{0};
+        glm::vec2 playerVelocity{0.0f};
+        PhysicsStats physics;
+        ChunkStreamStats streaming;
+        // Shared between snapshots until the pickup set changes
+        std::shared_ptr<const std::vector<PickupSphere>> pickups;
+    };
+
+    /// One collector (local, bot or remote player) in a batched pickup query
+    struct PickupQuery
+    {
+        glm::vec3 position;
+        float radius;
+    };
+
+    /// Check and collect pickups near a position, returns points gained and adds them to the score
     int collectNearbyPickups(const glm::vec3 &playerPos, float collectRadius = 3.0f) noexcept;
 
+    /// @brief Collect pickups for several players in one pass over the spatial index
+    /// @details Earlier queries win contested pickups. Points go to outPoints[i], not to the score.
+    /// With a simulation thread running, the caller blocks until the thread has run the query.
+    void collectNearbyPickups(std::span<const PickupQuery> queries, std::span<int> outPoints) noexcept;
+
+    /// @brief Queue up to count walls of the chunk containing position for breaking on the next step
+    /// @return Walls queued; 0 when the chunk is not loaded or, with a simulation thread, always (queued there)
+    std::size_t breakChunkWalls(const glm::vec3 &position, std::size_t count) noexcept;
+
+    // ========================================================================
+    // Match snapshots (rollback)
+    // ========================================================================
+
+    /// @brief Match state at one step: player body, score and how far the removal logs reached
+    /// @details Broken walls and collected pickups are not copied. While history is on, each removal
+    /// logs what it took away, and a restore puts back everything logged after the snapshot, so saving
+    /// is a few loads and restoring costs only the removals it undoes.
+    struct MatchSnapshot
+    {
+        glm::vec2 playerPosition{0.0f};
+        glm::vec2 playerVelocity{0.0f};
+        int score{0};
+        std::uint64_t pickupMark{0};
+        std::uint64_t wallMark{0};
+    };
+
+    /// Start or stop logging removals for restoreMatchSnapshot(); stopping drops the logs
+    void setMatchHistoryEnabled(bool enabled) noexcept;
+
+    /// @brief Capture the match state; with a simulation thread, waits until it has run the queued steps
+    /// @details Restore and confirm are queued behind the steps instead. Rollback keeps the simulation
+    /// on the main thread, so the wait is only a safety net for other callers.
+    [[nodiscard]] MatchSnapshot saveMatchSnapshot() noexcept;
+
+    /// @brief Go back to a snapshot taken since history was enabled and not confirmed away since
+    /// @details Walls and pickups of chunks unloaded in between stay gone
+    void restoreMatchSnapshot(const MatchSnapshot &snapshot) noexcept;
+
+    /// Drop the removal logs before a snapshot that no restore will go behind
+    void confirmMatchSnapshot(const MatchSnapshot &snapshot) noexcept;
+
     // ========================================================================
     // Physics player body
     // ========================================================================
@@ -140,14 +302,85 @@ public:
                    int windowWidth, int windowHeight,
                    float modelAnimTime, float playerPlanarSpeed) const noexcept;
 
+    /// @brief Make sure the composite targets hold at least maxWidth x maxHeight
+    /// @details Targets only grow, so render-scale changes below that size never reallocate
+    void ensureSceneTargets(int maxWidth, int maxHeight) noexcept;
+
+    /// @brief Redirect drawScene into the top-left renderWidth x renderHeight of the composite target
+    /// @return false (and the scene keeps drawing to the window) if the target is missing or too small
+    bool beginSceneTarget(int renderWidth, int renderHeight) const noexcept;
+
+    /// Upscale the scene target to the window with a linear blit and go back to the default framebuffer
+    void resolveSceneTarget(int renderWidth, int renderHeight, int windowWidth, int windowHeight) const noexcept;
+
+    /// Go back to the window without copying; the post pass samples the scene target itself
+    void endSceneTarget(int windowWidth, int windowHeight) const noexcept;
+
+    /// Color of the scene target (0 before the targets exist) and its allocated size
+    [[nodiscard]] GLuint getSceneColorTexture() const noexcept;
+    [[nodiscard]] glm::ivec2 getSceneTargetSize() const noexcept { return {mCompositeWidth, mCompositeHeight}; }
+
+    /// Weighted-blended OIT targets as the post pass reads them; all 0 before the targets exist
+    struct OITTargets
+    {
+        GLuint accum{0};
+        GLuint reveal{0};
+        /// Depth the transparents were tested against; the scene depth itself at full resolution
+        GLuint depth{0};
+        GLuint sceneDepth{0};
+        /// Scene pixels per OIT texel along each side
+        int downscale{1};
+    };
+
+    static constexpr int OIT_MAX_DOWNSCALE = 4;
+
+    /// @brief Render the OIT layer at 1/downscale of the scene per side: 1, 2 or 4
+    /// @details Every transparent draw blends into both OIT targets, so halving them quarters that
+    /// bandwidth. Reallocates only the OIT targets, and only once they exist.
+    void configureOIT(int downscale) noexcept;
+
+    /// @brief Redirect transparent draws into the OIT targets for a renderWidth x renderHeight scene
+    /// @details Clears accumulation to 0 and revealage to 1. Below full resolution the opaque depth is
+    /// first copied down with a nearest blit, so transparents are still hidden behind walls; the resolve
+    /// then upsamples by comparing that depth with the scene's. Blend state is the caller's: ONE, ONE on
+    /// draw buffer 0 and ZERO, ONE_MINUS_SRC_COLOR on draw buffer 1.
+    /// @return false if the targets are missing, with the scene target still bound
+    bool beginTransparentTarget(int renderWidth, int renderHeight) const noexcept;
+
+    /// Back to the scene target after beginTransparentTarget()
+    void endTransparentTarget(int renderWidth, int renderHeight) const noexcept;
+
+    [[nodiscard]] OITTargets getOITTargets() const noexcept;
+    /// True when the last drawScene() drew its sprites and particles into the OIT layer, which the
+    /// post pass must then resolve over the scene
+    [[nodiscard]] bool hasTransparentLayer() const noexcept { return mTransparentLayerWritten; }
+
+    /// @brief Size the planar player reflection from the quality options
+    /// @param scale Fraction of the window resolution; 0 turns reflections off
+    /// @param halfRate Render the reflection every other frame and reproject the last one in between
+    void configureReflections(float scale, bool halfRate, int windowWidth, int windowHeight) noexcept;
+
     /// Build static maze geometry and upload to GPU
+    /// @details Takes the geometry prepared by prewarmMazeGeometry() when there is one for the current
+    /// seed, so only the buffer uploads run here
     void buildMazeGeometry(const Player &player) noexcept;
 
-    /// Mark pickup vertex buffer as dirty (needs rebuild)
+    /// @brief Generate the next raster maze and its vertex data on a job worker
+    /// @details Main thread only. A no-op while an earlier prewarm is still unclaimed
+    static void prewarmMazeGeometry() noexcept;
+
+    /// @brief Seed for raster mazes generated from now on; nullopt picks a random maze each time
+    /// @details Main thread only, before prewarmMazeGeometry() or buildMazeGeometry()
+    static void setRasterMazeSeed(std::optional<std::uint32_t> seed) noexcept { sRasterMazeSeed = seed; }
+
+    /// Mark pickup instances as dirty (re-diffed against the GPU buffer on next draw)
     void markPickupsDirty() noexcept { mPickupsDirty = true; }
+    /// Redraw the cached sky on the next frame; call after changing anything sky.frag.glsl reads
+    void invalidateSkyCache() noexcept { mSkyCacheDirty = true; }
 
     // Getters for data that GameState still needs
     [[nodiscard]] const std::vector<glm::vec4> &getMazeWallAABBs() const noexcept { return mMazeWallAABBs; }
+    [[nodiscard]] const WallBroadphase &getMazeWallBroadphase() const noexcept { return mMazeWallBroadphase; }
     [[nodiscard]] const std::vector<glm::vec3> &getMazeCellGradientColors() const noexcept { return mMazeCellGradientColors; }
     [[nodiscard]] glm::vec3 getRasterMazeCenter() const noexcept { return mRasterMazeCenter; }
     [[nodiscard]] float getRasterMazeWidth() const noexcept { return mRasterMazeWidth; }
@@ -160,35 +393,117 @@ private:
     // ========================================================================
     // Scene rendering helpers (moved from GameState)
     // ========================================================================
-    void createCompositeTargets(int windowWidth, int windowHeight) noexcept;
-    void initializeShadowResources(int windowWidth, int windowHeight) noexcept;
-    void initializeReflectionResources(int windowWidth, int windowHeight) noexcept;
-    void initializeWalkParticles(const Player &player) noexcept;
-
-    void renderRasterMaze(const Camera &camera, const Player &player,
+    void createCompositeTargets(int width, int height) noexcept;
+    /// (Re)allocate the OIT targets for a scene target of width x height
+    void createOITTargets(int width, int height) noexcept;
+    /// Bind wherever drawScene is currently rendering (the scene target or the window)
+    void bindSceneFramebuffer() const noexcept;
+    /// Allocate the light-space depth map that caches the maze wall shadows
+    void initializeShadowResources() noexcept;
+    void initializeReflectionResources(int width, int height) noexcept;
+    void initializeWalkParticles() noexcept;
+    void initializeOcclusionCulling() noexcept;
+
+    /// Upload this frame's camera data once; passes read CPU-side matrices from mFrameUniforms
+    void updateFrameUniforms(const Camera &camera, int windowWidth, int windowHeight) const noexcept;
+
+    void renderRasterMaze(const Player &player,
                           int windowWidth, int windowHeight) const noexcept;
-    void renderGoalPathStencil(const Camera &camera,
-                               int windowWidth, int windowHeight) const noexcept;
-    void renderBoundaryCharacterBillboards(const Camera &camera,
-                                           int windowWidth, int windowHeight) const noexcept;
-    void renderPickupSpheres(const Camera &camera,
-                             int windowWidth, int windowHeight) const noexcept;
-    void renderPlayerCharacterModel(const Camera &camera, const Player &player,
-                                    int windowWidth, int windowHeight,
-                                    float modelAnimTime) const noexcept;
-    void renderWalkParticles(const Camera &camera, const Player &player,
-                             int windowWidth, int windowHeight,
-                             float playerPlanarSpeed) const noexcept;
-    void renderCharacterShadow(const Camera &camera, const Player &player,
-                               int windowWidth, int windowHeight) const noexcept;
-    void renderPlayerReflection(const Camera &camera, const Player &player,
-                                int windowWidth, int windowHeight) const noexcept;
+    /// Fill the bound target with the sky, from the cache when it is usable
+    void renderSky(int windowWidth, int windowHeight) const noexcept;
+    /// Redraw the sky cache if it is dirty or sized for another resolution; false if it cannot be used
+    bool refreshSkyCache(int windowWidth, int windowHeight) const noexcept;
+    void renderGoalPathStencil() const noexcept;
+    void renderBoundaryCharacterBillboards() const noexcept;
+    /// Collect the maze clusters inside the camera frustum and not hidden under a higher level
+    void cullMazeClusters() const noexcept;
+    /// Cull on the CPU and merge the visible clusters into floor ranges and wall instance runs
+    void collectVisibleMazeRanges() const noexcept;
+    /// Depth pre-pass into the Hi-Z pyramid, then the GPU wall cluster test that feeds renderRasterMaze
+    void renderOcclusionCulling(int windowWidth, int windowHeight) const noexcept;
+    void renderPickupSpheres() const noexcept;
+    /// Move queued chunk attach/detach events into the GPU slot pool (render thread only)
+    void applyChunkGeometryUpdates() const noexcept;
+    /// Diff the live pickups against the GPU instance buffer and upload only changed ranges
+    void updatePickupInstances() const noexcept;
+    void renderPlayerCharacterModel(const Player &player, float modelAnimTime) const noexcept;
+    /// @brief Pick the player's animation tier for this frame and return the pose time it draws with
+    float updatePlayerAnimationLod(const Player &player, float modelAnimTime) const noexcept;
+    /// @brief Animation tier from the character's screen size, or kAnimationLodCulled outside the frustum
+    std::uint32_t selectAnimationLod(const GLTFModel &model, const glm::mat4 &modelMat,
+                                     std::uint32_t previousTier) const noexcept;
+    void renderCharacterInstances() const noexcept;
+    /// @param oitPass Draw into the OIT layer bound by beginTransparentTarget(), keeping its blend state
+    void renderWalkParticles(const Player &player, float playerPlanarSpeed, bool oitPass) const noexcept;
+    /// @brief Re-render the cached wall shadow map, but only when walls changed or the streamed area moved
+    /// @details Dirtied by maze rebuilds, chunk geometry attach/detach and wall breaks; on a static scene
+    /// the pass costs nothing. The maze shader samples the map while drawing floors and walls.
+    void renderStaticShadowLayer(const Player &player) const noexcept;
+    /// Blend the blob shadows of the moving casters (character and pickups) over the scene
+    void renderDynamicShadows(const Camera &camera, const Player &player) const noexcept;
+    /// @brief Draw the player mirrored under the ground plane into the reflection target
+    /// @details Skipped on alternate frames in half-rate mode; the maze floor then reprojects the last
+    /// result with the view-projection it was rendered with.
+    void renderPlayerReflection(const Player &player, float modelAnimTime) const noexcept;
     
     // Sphere physics coordinate transformation
     glm::vec3 projectOntoSphere(glm::vec2 flatPos) const noexcept;
     glm::vec2 projectFromSphere(const glm::vec3 &spherePos) const noexcept;
+    void stepSimulation(float dt) noexcept;
+    void simulationLoop() noexcept;
+    void postSimulationCommand(std::function<void()> command);
+    /// Post work to the simulation thread and block until it has run, or run it here without one
+    void runOnSimulation(const std::function<void()> &work);
+    void publishSimulationSnapshot() noexcept;
+    void markPickupsChanged() noexcept;
+    /// True on any thread other than the simulation thread while one is running
+    [[nodiscard]] bool forwardsToSimulation() const noexcept;
     void syncPhysicsToSpheres() noexcept;
+    void syncSphereHandles(std::span<const SlotHandle> handles) noexcept;
+
+    /// @brief Batched arc-space to planet-surface projection over packed arrays
+    /// @details out[i] = planet point at (arcX[i], arcZ[i]) lifted by radii[i]; all spans share one length
+    void projectOntoSphere(std::span<const float> arcX, std::span<const float> arcZ,
+                           std::span<const float> radii, std::span<glm::vec3> out) const noexcept;
+    /// @return Dense sphere index of a live wall shape, through the slot in its user data; NPOS otherwise
+    [[nodiscard]] std::size_t findWallSphere(b2ShapeId shapeId) const noexcept;
     void breakQueuedWalls() noexcept;
+    /// @brief Queue every wall struck hard enough during the last step, once each, for the next step
+    /// @details One pass over the step's begin-touch and hit events; shapes are classified by the tag
+    /// in their user data, so other bodies' contacts cost a load and a compare.
+    void queueContactWallBreaks() noexcept;
+
+    // Chunk management
+    static constexpr float CHUNK_SIZE = 100.0f;
+    static constexpr int CHUNK_LOAD_RADIUS = 2;
+    // Predictive streaming: below the speed the full square loads, above it the near ring plus the path
+    static constexpr float CHUNK_PREFETCH_MIN_SPEED = 5.0f;
+    static constexpr float DEFAULT_CHUNK_PREFETCH_SECONDS = 4.0f;
+    static constexpr int CHUNK_PREFETCH_MAX_CHUNKS = 2;
+    static constexpr int CHUNK_NEAR_RADIUS = 1;
+    static_assert(CHUNK_PREFETCH_MAX_CHUNKS + CHUNK_NEAR_RADIUS <= CHUNK_LOAD_RADIUS + 1,
+                  "the look-ahead corridor may reach only one ring past the load square");
+    static constexpr int MAZE_ROWS = 20;
+    static constexpr int MAZE_COLS = 20;
+    static constexpr float CELL_SIZE = CHUNK_SIZE / static_cast<float>(MAZE_COLS);
+    // North/west wall per cell plus the east and south borders
+    static constexpr std::size_t CHUNK_WALL_INSTANCE_CAPACITY = MAZE_ROWS * MAZE_COLS * 2 + MAZE_ROWS + MAZE_COLS;
+    // Collision spheres per chunk; buildMazeWallSpheres stops at this many
+    static constexpr std::size_t CHUNK_WALL_SPHERE_CAPACITY = 260;
+    // Pickups sit on every fifth distance ring, so a quarter of the cells is a generous first reserve
+    static constexpr std::size_t CHUNK_PICKUP_RESERVE = MAZE_ROWS * MAZE_COLS / 4;
+    // Every chunk in load radius, the two sides of the next ring the look-ahead heads into, and slack
+    // for chunks still integrating while others unload
+    static constexpr std::size_t CHUNK_GEOMETRY_SLOTS = (2 * CHUNK_LOAD_RADIUS + 1) * (2 * CHUNK_LOAD_RADIUS + 1) +
+                                                        (2 * (2 * CHUNK_LOAD_RADIUS + 3) - 1) + 8;
+
+    /// @brief One wall box drawn as a scaled instance of the unit cube
+    struct MazeWallInstance
+    {
+        glm::vec4 centerHidden; // xyz = box center, w = hidden flag
+        glm::vec3 size;
+        std::array<std::uint8_t, 4> color;
+    };
 
     struct ChunkCoord
     {
@@ -208,44 +523,124 @@ private:
         }
     };
 
-    struct MazeCell
+    /// @brief Compact per-chunk maze: one wall bitmask per cell, row-major
+    struct ChunkMazeGrid
     {
-        int row, col;
-        int distance;
-        float worldX, worldZ;
-        bool wallNorth{false};
-        bool wallSouth{false};
-        bool wallEast{false};
-        bool wallWest{false};
+        static constexpr std::uint8_t WALL_NORTH = 1u << 0;
+        static constexpr std::uint8_t WALL_SOUTH = 1u << 1;
+        static constexpr std::uint8_t WALL_EAST = 1u << 2;
+        static constexpr std::uint8_t WALL_WEST = 1u << 3;
+
+        std::array<std::uint8_t, MAZE_ROWS * MAZE_COLS> walls{};
+        bool valid{false};
+
+        [[nodiscard]] bool hasWall(int row, int col, std::uint8_t wall) const noexcept
+        {
+            return (walls[static_cast<std::size_t>(row * MAZE_COLS + col)] & wall) != 0;
+        }
     };
 
+    /// @brief Staging slab a worker fills in place for one chunk
+    /// @details Slabs are recycled through acquireChunkSlab()/releaseChunkSlab(), so the vectors keep
+    /// their capacity and only the slab pointer moves between the worker, the integration queue and
+    /// the render thread.
     struct ChunkWorkItem
     {
         ChunkCoord coord;
-        std::vector<MazeCell> cells;
+        ChunkMazeGrid grid;
         std::vector<Sphere> spheres;
         std::vector<PickupSphere> pickupSpheres;
+        // Raster wall boxes, built on the worker and uploaded to a chunk slot by the render thread
+        std::vector<MazeWallInstance> wallInstances;
+        // Index into wallInstances of the wall spheres[i] lines; -1 where the wall has no box
+        std::vector<std::int16_t> sphereWalls;
+        // Wall shapes created for spheres[i] while the chunk integrates on the main thread
+        std::vector<b2ShapeId> shapes;
         glm::vec3 spawnPosition;
         bool hasSpawnPosition{false};
+
+        /// Empty the slab for reuse; capacity is kept
+        void clear() noexcept;
     };
+    using ChunkSlab = std::unique_ptr<ChunkWorkItem>;
 
-    // Worker management
+    /// @brief A chunk job handed to the JobSystem, with a flag to abandon it once out of range
+    struct PendingChunk
+    {
+        std::future<ChunkSlab> future;
+        std::shared_ptr<std::atomic<bool>> cancelled;
+        /// For the chunk-arrival latency reported to Telemetry
+        std::chrono::steady_clock::time_point requestedAt;
+    };
+
+    /// @brief A generated chunk whose wall shapes are being created across several frames
+    struct ChunkIntegration
+    {
+        ChunkSlab item;
+        std::size_t nextSphere{0};
+        b2BodyId bodyId{b2_nullBodyId};
+        std::vector<SlotHandle> handles;
+    };
+
+    /// @brief A chunk waiting for a worker, ordered by squared chunk distance to the camera
+    struct ChunkRequest
+    {
+        ChunkCoord coord;
+        int priority;
+    };
+
+    struct ChunkRequestCompare
+    {
+        // Inverted so the std heap algorithms keep the closest chunk at the front
+        bool operator()(const ChunkRequest &a, const ChunkRequest &b) const noexcept
+        {
+            return a.priority > b.priority;
+        }
+    };
+
+    // Chunk generation jobs run on the shared JobSystem
     void initWorkerPool() noexcept;
     void shutdownWorkerPool() noexcept;
     void submitChunkForGeneration(const ChunkCoord &coord) noexcept;
+    void dispatchChunkRequests() noexcept;
+    /// @brief Drop queued requests outside desiredChunks and re-key the rest with its priorities
+    /// @details Work already running or integrating is kept while it is still inside the load radius
+    void cancelStaleChunkWork(const std::pmr::unordered_map<ChunkCoord, int, ChunkCoordHash> &desiredChunks) noexcept;
     void processCompletedChunks() noexcept;
-    ChunkWorkItem generateChunkAsync(const ChunkCoord &coord) const noexcept;
+    void integrateChunks(std::chrono::steady_clock::time_point deadline) noexcept;
+    /// Refresh the CPU memory counters from the current container sizes
+    void updateMemoryStats() noexcept;
+    void finalizeChunkIntegration(ChunkIntegration &integration) noexcept;
+    void generateChunkAsync(const ChunkCoord &coord, const std::atomic<bool> &cancelled, ChunkWorkItem &result) const noexcept;
+    /// Thread-safe; a free slab when one is pooled, otherwise a new one sized for a full chunk
+    [[nodiscard]] ChunkSlab acquireChunkSlab() const;
+    void releaseChunkSlab(ChunkSlab slab) const noexcept;
+    static int chunkPriority(const ChunkCoord &coord, const ChunkCoord &center) noexcept;
+    [[nodiscard]] bool isWithinLoadRadius(const ChunkCoord &coord) const noexcept;
+    /// Where the player is expected after the look-ahead time; the position itself when nearly still
+    [[nodiscard]] glm::vec3 projectStreamTarget(const glm::vec3 &position, const glm::vec3 &velocity) const noexcept;
 
     ChunkCoord getChunkCoord(const glm::vec3 &position) const noexcept;
-    void loadChunk(const ChunkCoord &coord) noexcept;
+    void loadChunk(const ChunkCoord &coord, int priority) noexcept;
     void unloadChunk(const ChunkCoord &coord) noexcept;
+    /// @brief Destroy one live wall sphere, logging it for rollback when it belongs to a chunk
+    void removeWallSphere(const ChunkCoord *coord, std::size_t dense) noexcept;
 
     // Thread-safe maze generation helpers
-    std::string generateMazeForChunk(const ChunkCoord &coord) const noexcept;
-    std::vector<MazeCell> parseMazeCells(const std::string &mazeStr, const ChunkCoord &coord,
-                                         glm::vec3 &outSpawnPosition, bool &outHasSpawn) const noexcept;
-    void buildMazeWallSpheres(const std::vector<MazeCell> &cells, std::vector<Sphere> &outSpheres) const noexcept;
-    void buildPickupSpheres(const std::vector<MazeCell> &cells, std::vector<PickupSphere> &outPickups, const ChunkCoord &coord) const noexcept;
+    ChunkMazeGrid generateMazeForChunk(const ChunkCoord &coord) const noexcept;
+    void findChunkSpawn(const ChunkCoord &coord, glm::vec3 &outSpawnPosition, bool &outHasSpawn) const noexcept;
+    void buildMazeWallSpheres(const ChunkMazeGrid &grid, const ChunkCoord &coord, std::vector<Sphere> &outSpheres) const noexcept;
+    void buildPickupSpheres(const ChunkMazeGrid &grid, std::vector<PickupSphere> &outPickups, const ChunkCoord &coord) const noexcept;
+    /// @brief Wall boxes of a chunk, and for each sphere buildMazeWallSpheres lays the box it belongs to
+    static void buildChunkWallInstances(const ChunkMazeGrid &grid, const ChunkCoord &coord,
+                                        std::vector<MazeWallInstance> &outInstances,
+                                        std::vector<std::int16_t> &outSphereWalls) noexcept;
+    static std::vector<std::uint8_t> serializeChunk(const ChunkWorkItem &item) noexcept;
+    static bool deserializeChunk(std::span<const std::uint8_t> bytes, ChunkWorkItem &outItem) noexcept;
+    static glm::vec2 cellWorldCenter(const ChunkCoord &coord, int row, int col) noexcept;
+    /// Chunk-grid XZ to the flat runner layout shared by walls and pickups
+    static glm::vec2 toRunnerArc(float x, float z) noexcept;
+    static int cellDistanceFromCenter(int row, int col) noexcept;
     Material::MaterialType getMaterialForDistance(int distance) const noexcept;
 
     static constexpr auto FORCE_DUE_TO_GRAVITY = 9.8f;
@@ -255,47 +650,111 @@ private:
     TextureManager &mTextures;
     ShaderManager &mShaders; // Added for billboard shader access
     LevelsManager &mLevels;
+    const TextureAtlas *mTextureAtlas{nullptr};
 
     b2WorldId mWorldId;
     b2BodyId mMazeWallsBodyId;
     bool mIsPanning;
     SDL_FPoint mLastMousePosition;
 
-    std::vector<Sphere> mSpheres;
-    std::vector<b2BodyId> mSphereBodyIds;
-    std::vector<b2BodyId> mWallBreakQueue;
+    // Wall sphere columns: physics center, radius, circle shape, the full GPU sphere record and the
+    // sphere's index in its chunk's handle list and wall table
+    static constexpr std::size_t SPHERE_CENTER = 0;
+    static constexpr std::size_t SPHERE_RADIUS = 1;
+    static constexpr std::size_t SPHERE_SHAPE = 2;
+    static constexpr std::size_t SPHERE_DATA = 3;
+    static constexpr std::size_t SPHERE_CHUNK_INDEX = 4;
+    // Wall shapes find their element here through the slot index packed into their user data
+    SlotMap<glm::vec3, float, b2ShapeId, Sphere, std::uint16_t> mSpheres;
+    std::vector<b2ShapeId> mWallBreakQueue;
+    /// Slots struck during the current step, deduplicated before they join mWallBreakQueue
+    std::vector<std::uint32_t> mContactBreakSlots;
+    b2ShapeDef mWallShapeDef{};
     Plane mGroundPlane;
 
-    // Modern C++ worker pool
-    static constexpr size_t NUM_WORKER_THREADS = 4;
     static constexpr float SPHERE_SPAWN_RATE = 0.01f;
     std::atomic<bool> mWorkersShouldStop{false};
-    std::vector<std::future<void>> mWorkerThreads;
-
-    mutable std::mutex mWorkQueueMutex;
-    std::queue<std::packaged_task<ChunkWorkItem()>> mWorkQueue;
-    std::condition_variable mWorkAvailable;
 
     mutable std::mutex mCompletedChunksMutex;
-    std::vector<std::pair<ChunkCoord, std::future<ChunkWorkItem>>> mPendingChunks;
-
-    // Chunk management
-    static constexpr float CHUNK_SIZE = 100.0f;
-    static constexpr int CHUNK_LOAD_RADIUS = 2;
-    static constexpr int MAZE_ROWS = 20;
-    static constexpr int MAZE_COLS = 20;
-    static constexpr float CELL_SIZE = CHUNK_SIZE / static_cast<float>(MAZE_COLS);
+    std::unordered_map<ChunkCoord, PendingChunk, ChunkCoordHash> mPendingChunks;
+    // Cancelled jobs still reference this World, so keep their futures until they finish
+    std::vector<PendingChunk> mCancelledChunks;
+    // Free staging slabs; taken on the streaming thread, returned from it and from the render thread
+    mutable std::mutex mChunkSlabMutex;
+    mutable std::vector<ChunkSlab> mFreeChunkSlabs;
+
+    // Binary heap (ChunkRequestCompare) of chunks not yet handed to a worker
+    std::vector<ChunkRequest> mChunkRequestQueue;
+    std::unordered_set<ChunkCoord, ChunkCoordHash> mQueuedChunks;
+    ChunkCoord mCenterChunk{0, 0};
+    // Chunk holding the projected look-ahead point; a change re-plans the corridor
+    ChunkCoord mAheadChunk{0, 0};
+    float mChunkPrefetchSeconds{DEFAULT_CHUNK_PREFETCH_SECONDS};
+    ChunkStreamStats mStreamStats;
+    // Chunk the player entered before it arrived, timed until it integrates
+    std::optional<ChunkCoord> mAwaitedChunk;
+    std::chrono::steady_clock::time_point mAwaitedSince;
+    size_t mMaxInFlightChunks{1};
+
+    // Finished chunks are integrated front to back within mIntegrationBudget per update
+    static constexpr std::chrono::microseconds DEFAULT_CHUNK_INTEGRATION_BUDGET{2000};
+    std::deque<ChunkIntegration> mIntegrationQueue;
+    std::unordered_set<ChunkCoord, ChunkCoordHash> mIntegratingChunks;
+    std::chrono::microseconds mIntegrationBudget{DEFAULT_CHUNK_INTEGRATION_BUDGET};
 
     std::unordered_set<ChunkCoord, ChunkCoordHash> mLoadedChunks;
-    std::unordered_map<ChunkCoord, std::vector<size_t>, ChunkCoordHash> mChunkSphereIndices;
-
-    // Thread-safe maze cache with mutex
+    // Handles go stale when a wall breaks; unloadChunk skips them
+    std::unordered_map<ChunkCoord, std::vector<SlotHandle>, ChunkCoordHash> mChunkSphereHandles;
+    // Wall box of each sphere in the chunk's handle list, from ChunkWorkItem::sphereWalls
+    std::unordered_map<ChunkCoord, std::vector<std::int16_t>, ChunkCoordHash> mChunkSphereWalls;
+    std::unordered_map<ChunkCoord, std::vector<SlotHandle>, ChunkCoordHash> mChunkPickupHandles;
+    // One compound static body per loaded chunk
+    std::unordered_map<ChunkCoord, b2BodyId, ChunkCoordHash> mChunkBodies;
+    // b2StoreBodyId(body) -> chunk, so body move events find the spheres to resync
+    std::unordered_map<std::uint64_t, ChunkCoord> mBodyToChunk;
+
+    /// What a broken wall or collected pickup needs to come back on restoreMatchSnapshot()
+    struct RemovedWall
+    {
+        ChunkCoord coord;
+        b2Circle circle;
+        Sphere sphere;
+        std::uint16_t chunkIndex;
+    };
+    struct RemovedPickup
+    {
+        ChunkCoord coord;
+        PickupSphere pickup;
+    };
+    bool mMatchHistoryEnabled{false};
+    /// Removal logs; the front entry's mark is the base, so marks stay valid as confirmed entries go
+    std::deque<RemovedWall> mRemovedWalls;
+    std::uint64_t mRemovedWallBase{0};
+    std::deque<RemovedPickup> mRemovedPickups;
+    std::uint64_t mRemovedPickupBase{0};
+
+    // Packed gather buffers for syncSphereHandles
+    std::vector<std::size_t> mSyncDense;
+    std::vector<float> mSyncArcX;
+    std::vector<float> mSyncArcZ;
+    std::vector<float> mSyncRadii;
+    std::vector<glm::vec3> mSyncCenters;
+
+    // Thread-safe maze cache with mutex; evicted chunks regenerate from their seed
+    static constexpr std::size_t DEFAULT_MAZE_CACHE_BUDGET_BYTES = 512u * 1024u;
     mutable std::mutex mMazeCacheMutex;
-    mutable std::unordered_map<ChunkCoord, std::string, ChunkCoordHash> mChunkMazes;
+    mutable LRUCache<ChunkCoord, ChunkMazeGrid, ChunkCoordHash> mChunkMazes{DEFAULT_MAZE_CACHE_BUDGET_BYTES};
+
+    // Bump when the serialized ChunkWorkItem layout changes
+    static constexpr std::uint32_t CHUNK_PAYLOAD_VERSION = 1u;
+    mutable ChunkDiskCache mChunkDiskCache;
 
     glm::vec3 mLastChunkUpdatePosition;
+    // Render-thread side: last chunk forwarded to the simulation thread, so unchanged chunks post nothing
+    ChunkCoord mLastForwardedChunk{0, 0};
+    ChunkCoord mLastForwardedAheadChunk{0, 0};
+    bool mHasForwardedChunk{false};
     glm::vec3 mPlayerSpawnPosition;
-    size_t mPersistentSphereCount{0};
 
     static constexpr int TOTAL_SPHERES = 200;
     
@@ -310,11 +769,43 @@ private:
 
     // Scoring system
     int mScore{0};
-    std::vector<PickupSphere> mPickupSpheres;
+    SlotMap<PickupSphere> mPickups;
+
+    // XZ-plane index over mPickups; cells a bit larger than the usual collect radius
+    static constexpr float PICKUP_GRID_CELL_SIZE = 8.0f;
+    SpatialHashGrid<SlotHandle> mPickupGrid{PICKUP_GRID_CELL_SIZE};
+    std::vector<SlotHandle> mCollectedPickupScratch;
 
     // Player physics body
     b2BodyId mPlayerBodyId{b2_nullBodyId};
 
+    // Threaded simulation: commands flow in under mSimMutex, snapshots flow out through mSnapshots
+    std::thread mSimThread;
+    std::mutex mSimMutex;
+    std::condition_variable mSimCondition;
+    std::vector<std::function<void()>> mSimCommands;
+    bool mSimStopRequested{false};
+    std::atomic<bool> mSimThreaded{false};
+    static thread_local bool sOnSimulationThread;
+    std::atomic<int> mSimCollectedPoints{0};
+    TripleBuffer<SimulationSnapshot> mSnapshots;
+    std::uint64_t mSimTick{0};
+    // Simulation-thread side: set when mPickups changed since the last published copy
+    bool mSnapshotPickupsStale{true};
+    std::shared_ptr<const std::vector<PickupSphere>> mPublishedPickups;
+    // Render-thread side: pickup list of the snapshot the GPU buffer was last built from
+    const std::vector<PickupSphere> *mPresentedPickups{nullptr};
+
+    // Container capacities, refreshed once per simulation step; Box2D's own pools are not included
+    MemoryStats::Allocation mSphereBytes{MemoryStats::Category::CPU_WORLD_SPHERES};
+    MemoryStats::Allocation mBodyBytes{MemoryStats::Category::CPU_WORLD_BODIES};
+    MemoryStats::Allocation mMazeBytes{MemoryStats::Category::CPU_CHUNK_MAZES};
+    MemoryStats::Allocation mPickupBytes{MemoryStats::Category::CPU_PICKUPS};
+
+    // Box2D parallel-for hooks; must outlive mWorldId
+    int mPhysicsWorkerCount{0};
+    std::unique_ptr<PhysicsTaskScheduler> mPhysicsScheduler;
+
     // ========================================================================
     // Scene rendering state (moved from GameState)
     // ========================================================================
@@ -325,34 +816,131 @@ private:
 
     Shader *mMazeShader{nullptr};
     Shader *mSkyShader{nullptr};
+    /// Plain textured quad that stretches the sky cache over the scene
+    Shader *mSkyCacheShader{nullptr};
     Shader *mGoalPathStencilShader{nullptr};
     Shader *mBoundarySpriteShader{nullptr};
     Shader *mShadowShader{nullptr};
     Shader *mSkinnedCharacterShader{nullptr};
+    Shader *mSkinningComputeShader{nullptr};
+    Shader *mHiZComputeShader{nullptr};
+    Shader *mOcclusionCullComputeShader{nullptr};
     Shader *mWalkParticlesComputeShader{nullptr};
     Shader *mWalkParticlesRenderShader{nullptr};
 
+    // Uniform handles resolved once in initRendering so draw passes skip string lookups
+    struct MazeUniforms
+    {
+        Shader::UniformHandle playerXZ, mazeOriginXZ, cellSize, highlightEnabled, spriteSheet, hasTexture, instanced,
+            lightPass, lightViewProjection, staticShadows, reflections, reflectionViewProjection;
+    } mMazeUniforms;
+    struct GoalPathUniforms
+    {
+        Shader::UniformHandle color, intensity;
+    } mGoalPathUniforms;
+    struct ShadowUniforms
+    {
+        Shader::UniformHandle lightDir, groundY, sphereCenter, sphereRadius, spritePos, spriteHalfSize, instanced,
+            shadowStrength;
+    } mShadowUniforms;
+    Shader::UniformHandle mSkinnedShadowPassUniform;
+
     Texture *mBillboardColorTex{nullptr};
     Texture *mOITAccumTex{nullptr};
     Texture *mOITRevealTex{nullptr};
+    Texture *mSceneDepthTex{nullptr};
+    /// Only allocated below full resolution; at downscale 1 the OIT target shares mSceneDepthTex
+    Texture *mOITDepthTex{nullptr};
     Texture *mShadowTexture{nullptr};
     Texture *mReflectionColorTex{nullptr};
+    Texture *mSkyCacheTex{nullptr};
 
     bool mShadowsInitialized{false};
+    /// Set from any thread when the wall shadow casters change; cleared by renderStaticShadowLayer
+    mutable std::atomic<bool> mStaticShadowsDirty{true};
+    mutable bool mStaticShadowValid{false};
+    /// Chunk the cached shadow map is centered on; moving to another one re-renders it
+    mutable ChunkCoord mStaticShadowCenter{0, 0};
+    mutable glm::mat4 mStaticShadowViewProjection{1.0f};
     bool mReflectionsInitialized{false};
+    float mReflectionScale{0.0f};
+    bool mReflectionHalfRate{true};
+    int mReflectionWidth{0};
+    int mReflectionHeight{0};
+    mutable std::uint32_t mReflectionFrame{0};
+    /// True once the target holds an image; mReflectionViewProjection is the camera it was drawn with
+    mutable bool mReflectionValid{false};
+    mutable glm::mat4 mReflectionViewProjection{1.0f};
+    /// Sky cache size; 0 until the first successful refresh, and again if its framebuffer is incomplete
+    mutable int mSkyCacheWidth{0};
+    mutable int mSkyCacheHeight{0};
+    mutable bool mSkyCacheDirty{true};
     bool mOITInitialized{false};
+    int mOITDownscale{2};
+    /// OIT target size; the scene's composite size divided by mOITDownscale, rounded up
+    int mOITWidth{0};
+    int mOITHeight{0};
+    mutable bool mTransparentLayerWritten{false};
+    /// Also whether a render thread drains mChunkGeometryUpdates; set before any chunk is integrated
     bool mRenderInitialized{false};
 
-    GLsizei mRasterMazeVertexCount{0};
+    /// Allocated size of the composite targets; the scene uses a viewport inside it
+    int mCompositeWidth{0};
+    int mCompositeHeight{0};
+    mutable bool mSceneTargetActive{false};
+
+    GLsizei mMazeFloorIndexCount{0};
+    GLenum mMazeFloorIndexType{GL_UNSIGNED_SHORT};
+    GLsizei mMazeWallCubeIndexCount{0};
+    GLsizei mMazeWallInstanceCount{0};
+
+    /// @brief One level/tile region of the static maze: a contiguous floor-index and wall-instance range
+    struct MazeCluster
+    {
+        glm::vec3 aabbMin{0.0f};
+        glm::vec3 aabbMax{0.0f};
+        unsigned int level{0};
+        GLuint firstFloorIndex{0};
+        GLsizei floorIndexCount{0};
+        GLuint firstWallInstance{0};
+        GLsizei wallInstanceCount{0};
+    };
+    std::vector<MazeCluster> mMazeClusters;
+    GLuint mMazeGroundFirstIndex{0};
+    GLsizei mMazeGroundIndexCount{0};
+    // Per-frame culling output and draw-range scratch
+    mutable std::vector<std::uint32_t> mVisibleMazeClusters;
+    mutable std::vector<GLsizei> mVisibleFloorCounts;
+    mutable std::vector<const void *> mVisibleFloorOffsets;
+    mutable std::vector<glm::uvec2> mVisibleWallRuns; // x = first instance, y = count
+    mutable unsigned int mLowestVisibleMazeLevel{0};
     glm::vec3 mRasterMazeCenter{0.0f};
     float mRasterMazeWidth{1.0f};
     float mRasterMazeDepth{1.0f};
     float mRasterMazeTopY{1.0f};
     GLsizei mGoalPathVertexCount{0};
-    GLsizei mPickupVertexCount{0};
+    // Pickups draw as instances of one cube; the instance buffer mirrors getPickupSpheres() index for index
+    struct PickupInstance
+    {
+        glm::vec4 offsetCollected{0.0f}; // xyz = position, w = collected flag
+        glm::vec3 tint{1.0f};
+    };
+    GLsizei mPickupCubeVertexCount{0};
+    mutable std::vector<PickupInstance> mPickupInstances;   // contents of the GPU instance buffer
+    mutable std::vector<PickupInstance> mPickupInstanceScratch;
+
+    std::vector<CharacterInstance> mCharacterInstances;
+    /// GLTFModel detail level each character and the player drew with last frame, for LOD hysteresis
+    mutable std::vector<std::uint32_t> mCharacterLodLevels;
+    mutable std::uint32_t mPlayerModelLod{0};
+    /// Animation tier of each character and the player last frame, for hysteresis like the mesh levels
+    mutable std::vector<std::uint32_t> mCharacterAnimationLods;
+    mutable std::uint32_t mPlayerAnimationLod{0};
+    mutable std::size_t mPickupInstanceCapacity{0};
     mutable bool mPickupsDirty{true};
 
     std::vector<glm::vec4> mMazeWallAABBs;
+    WallBroadphase mMazeWallBroadphase;
     std::vector<glm::vec3> mMazeCellGradientColors;
 
     struct BoundarySpriteData
@@ -363,8 +951,38 @@ private:
     };
     std::vector<BoundarySpriteData> mBoundarySprites;
 
+    struct PreparedMaze;
+    [[nodiscard]] static std::unique_ptr<PreparedMaze> prepareMazeGeometry(std::optional<std::uint32_t> seed) noexcept;
+    static std::optional<std::uint32_t> sRasterMazeSeed;
+    /// Claimed by the next buildMazeGeometry() of any World
+    static std::future<std::unique_ptr<PreparedMaze>> sPrewarmedMaze;
+
+    // Streamed chunk walls: the simulation side queues updates, the render thread owns the GPU pool
+    struct ChunkGeometryUpdate
+    {
+        ChunkCoord coord;
+        // Uploaded from its wallInstances, then returned to the slab pool
+        ChunkSlab slab;
+        bool detach{false};
+        /// Wall box whose hidden flag is set to hidden; slab and detach are unused then
+        std::int32_t instance{-1};
+        bool hidden{false};
+    };
+    mutable std::mutex mChunkGeometryMutex;
+    mutable std::vector<ChunkGeometryUpdate> mChunkGeometryUpdates;
+    mutable std::vector<ChunkGeometryUpdate> mChunkGeometryApplying;
+    mutable ChunkGeometryPool mChunkGeometryPool;
+    mutable OcclusionCuller mOcclusionCuller;
+    /// Set per frame once the GPU cull ran; the static walls then draw from its indirect commands
+    mutable bool mOcclusionCullingActive{false};
+    mutable std::unordered_map<ChunkCoord, int, ChunkCoordHash> mChunkGeometrySlots;
+    mutable BillboardBatch mBillboardBatch;
+
+    mutable FrameUniforms mFrameUniforms;
+    mutable Frustum mFrameFrustum;
+
     mutable float mWalkParticlesTime{0.0f};
-    mutable bool mWalkParticlesInitialized{false};
+    mutable ParticleSystem mWalkParticles;
     mutable GLuint mWalkParticleCount{1600};
 };
 